@@ -1,112 +1,279 @@
-/*
- * -------------------------------------------------------------------------
- * FreeRTOS Kernel Configuration File V1.0.0
- * -------------------------------------------------------------------------
- * Application specific definitions.
- *
- * These definitions should be adjusted for your particular hardware and
- * application requirements.
- *
- * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
- * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
- *
- * See http://www.freertos.org/a00110.html.
- * -------------------------------------------------------------------------
- */
-
-#ifndef FREERTOS_CONFIG_H
-#define FREERTOS_CONFIG_H
-
-/******************************************************************************/
-/* Scheduling behavior related definitions. **********************************/
-/******************************************************************************/
-
-/* configCPU_CLOCK_HZ must be set to the frequency of the clock that drives 
- * the peripheral used to generate the kernels periodic tick interrupt.
- * This is very often, but not always, equal to the main system clock frequency.
- * Default frequency in Tiva-C Micro-controllers is 16Mhz */
-#define configCPU_CLOCK_HZ                    (( unsigned long )16000000)
-
-/* configTICK_RATE_HZ sets frequency of the tick interrupt in Hz, so
- * in our case Tick time will be 10ms */
-#define configTICK_RATE_HZ                    ((TickType_t)100)
-
-/* Size of the stack allocated to the Idle task. 128 Words = 512 Bytes */
-#define configMINIMAL_STACK_SIZE              (128)
-
-/* configMAX_PRIORITIES Sets the number of available task priorities.  Tasks can
- * be assigned priorities of 0 to (configMAX_PRIORITIES - 1).  Zero is the lowest
- * priority. */
-#define configMAX_PRIORITIES                  (10)
-
-/* Set configUSE_PREEMPTION to 1 to use pre-emptive scheduling. Set
- * configUSE_PREEMPTION to 0 to use co-operative scheduling. */
-#define configUSE_PREEMPTION                  (1)                
-
-/* When configUSE_16_BIT_TICKS is set to 1, TickType_t is defined
- * to be an unsigned 16-bit type. When configUSE_16_BIT_TICKS is set to 0, 
- * TickType_t is defined to be an unsigned 32-bit type. */
-#define configUSE_16_BIT_TICKS                0
-
-/******************************************************************************/
-/* Memory allocation related definitions. *************************************/
-/******************************************************************************/
-
-/* Sets the total size of the FreeRTOS heap, in bytes, when heap_1.c, heap_2.c
- * or heap_4.c are included in the build. This value is defaulted to 4096 bytes but
- * it must be tailored to each application. Note the heap will appear in the .bss
- * section. */
-#define configTOTAL_HEAP_SIZE                 ((size_t)(16384))
-
-/******************************************************************************/
-/* Hook and callback function related definitions. ****************************/
-/******************************************************************************/
-
-/* Set the following configUSE_* constants to 1 to include the named hook
- * functionality in the build.  Set to 0 to exclude the hook functionality from the
- * build.  The application writer is responsible for providing the hook function
- * for any set to 1. */
-#define configUSE_IDLE_HOOK                   0
-#define configUSE_TICK_HOOK                   1
-
-/******************************************************************************/
-/* ARM Cortex-M Specific Definitions. *****************************************/
-/******************************************************************************/
-
-/* Tiva-C Micro-controllers use 3-bits as priority bits for each interrupt in NVIC PRI registers - 8 priority levels */
-#define configPRIO_BITS                               3
-
-/* The lowest interrupt priority that can be used */
-#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY       7
-
-/* The highest interrupt priority that can be used by any interrupt service
-routine that makes calls to interrupt safe FreeRTOS API functions.  DO NOT CALL
-INTERRUPT SAFE FREERTOS API FUNCTIONS FROM ANY INTERRUPT THAT HAS A HIGHER
-PRIORITY THAN THIS! (higher priorities are lower numeric values. */
-#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY  5
-
-/* Interrupt priorities used by the kernel port layer itself (the tick and context switch performing interrupts).
- * This implementation is generic to all Cortex-M ports, and do not rely on any particular library functions. */
-#define configKERNEL_INTERRUPT_PRIORITY               (configLIBRARY_LOWEST_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
-
-/* It sets the interrupt priority above which FreeRTOS API calls must not be made.  
- * Interrupts above this priority are never disabled, so never delayed by RTOS activity. 
- * This implementation is generic to all Cortex-M ports, and do not rely on any particular library functions. */
-#define configMAX_SYSCALL_INTERRUPT_PRIORITY          (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
-
-/******************************************************************************/
-/* Debugging assistance. ******************************************************/
-/******************************************************************************/
-
-/* Normal assert() semantics without relying on the provision of an assert.h header file. */
-#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
-
-/******************************************************************************/
-/* Function includes. ******************************************************/
-/******************************************************************************/
-#define INCLUDE_vTaskDelay          1
-#define INCLUDE_vTaskPrioritySet    1
-
-
-#endif /* FREERTOS_CONFIG_H */
-
+/*
+ * -------------------------------------------------------------------------
+ * FreeRTOS Kernel Configuration File V1.0.0
+ * -------------------------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html.
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* MLFQ_BOARD: the board and drivers backend this build targets */
+#include "board.h"
+
+/******************************************************************************/
+/* Scheduling behavior related definitions. **********************************/
+/******************************************************************************/
+
+/* configCPU_CLOCK_HZ must be set to the frequency of the clock that drives 
+ * the peripheral used to generate the kernels periodic tick interrupt.
+ * This is very often, but not always, equal to the main system clock frequency.
+ * Tiva-C Micro-controllers boot from the 16Mhz PIOSC; initClock() (drivers.c)
+ * moves the core to the PLL and stores SysCtlClockGet() here, so SysTick, the
+ * UART baud divisor and every cycle conversion follow the real clock.
+ * On MLFQ_BOARD_CORTEX_M7 the board's SystemInit() sets the PLL and
+ * initClock() (drivers_cm7.c) stores CM7_CPU_CLOCK_HZ.
+ * initClock() must run before anything else reads it. */
+extern unsigned long g_systemClockHz;
+#define configCPU_CLOCK_HZ                    ( g_systemClockHz )
+
+/* configTICK_RATE_HZ sets frequency of the tick interrupt in Hz, so
+ * in our case Tick time will be 10ms. Build with -DMLFQ_TICK_RATE_HZ=n
+ * to try another rate (the tick-rate benchmark, test/test_config.h);
+ * the quanta are set in milliseconds and keep their length. The rate
+ * must divide 1000000, so a tick is a whole number of microseconds */
+#ifndef MLFQ_TICK_RATE_HZ
+#define MLFQ_TICK_RATE_HZ                     100U
+#endif
+
+#if ((1000000U % MLFQ_TICK_RATE_HZ) != 0U) || (MLFQ_TICK_RATE_HZ > 10000U)
+#error "MLFQ_TICK_RATE_HZ must divide 1000000 and be at most 10000"
+#endif
+
+#define configTICK_RATE_HZ                    ((TickType_t)MLFQ_TICK_RATE_HZ)
+
+/* Size of the stack allocated to the Idle task. 128 Words = 512 Bytes */
+#define configMINIMAL_STACK_SIZE              (128)
+
+/* configMAX_PRIORITIES Sets the number of available task priorities.  Tasks can
+ * be assigned priorities of 0 to (configMAX_PRIORITIES - 1).  Zero is the lowest
+ * priority. */
+#define configMAX_PRIORITIES                  (11)
+
+/* configNUMBER_OF_CORES sets how many cores the kernel schedules across.
+ * The TM4C123 has one.  Above 1 needs a FreeRTOS SMP kernel and port (V11
+ * onwards) with configRUN_MULTIPLE_PRIORITIES 1, so tasks of different
+ * MLFQ levels can run side by side; the profiler then charges the task
+ * running on every core (tick_profiler.h). */
+#ifndef configNUMBER_OF_CORES
+#define configNUMBER_OF_CORES                 (1)
+#endif
+
+/* Select the next task with CLZ on a ready-priority bitmap instead of walking
+ * the ready lists from the top.  The ARM_CM4F port limits this to 32
+ * priorities, which covers the MLFQ band, the supervisor and the RT band.
+ * The scheduler also reads the bitmap (uxTaskGetReadyPriorities()). */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
+#endif
+
+/* Set configUSE_PREEMPTION to 1 to use pre-emptive scheduling. Set
+ * configUSE_PREEMPTION to 0 to use co-operative scheduling. */
+#define configUSE_PREEMPTION                  (1)                
+
+/* Set configUSE_MUTEXES to 1 to include mutexes with priority inheritance.
+ * The kernel then keeps a base priority separate from the inherited one, and
+ * vTaskPrioritySet() (used for every MLFQ level change) only moves the base
+ * while a task holds an inherited priority. */
+#define configUSE_MUTEXES                     (1)
+
+/* Set configUSE_MLFQ_NATIVE to 1 to keep the MLFQ level and quantum in the
+ * TCB and demote the running task from xTaskIncrementTick() itself, through
+ * xApplicationMlfqQuantumExpired().  The supervisor task is then only needed
+ * for the periodic boost and reporting. */
+#ifndef configUSE_MLFQ_NATIVE
+#define configUSE_MLFQ_NATIVE                 0
+#endif
+
+/* Set configUSE_MLFQ_TIMER_SUPERVISOR to 1 to run the supervisor work in the
+ * timer service task instead of a task of its own.  The tick hook defers each
+ * quantum expiry with xTimerPendFunctionCallFromISR() and the periodic boost
+ * and reports run from a software timer, so schedulerTask() is never created.
+ * The service task takes the supervisor's place, so configTIMER_TASK_PRIORITY
+ * must equal MLFQ_SUPERVISOR_PRIORITY (scheduler.h checks it). */
+#ifndef configUSE_MLFQ_TIMER_SUPERVISOR
+#define configUSE_MLFQ_TIMER_SUPERVISOR       0
+#endif
+
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+#define configUSE_TIMERS                      1
+#endif
+
+/* The timer service task, for the supervisor above or for an application
+ * that sets configUSE_TIMERS to 1 for its own software timers */
+#if defined(configUSE_TIMERS) && (configUSE_TIMERS == 1)
+#ifndef configTIMER_TASK_PRIORITY
+#define configTIMER_TASK_PRIORITY             6
+#endif
+#define configTIMER_QUEUE_LENGTH              8
+#define configTIMER_TASK_STACK_DEPTH          256
+#define INCLUDE_xTimerPendFunctionCall        1
+#endif
+
+/* Set configUSE_MLFQ_EDF to 1 to run the tasks given a deadline with
+ * schedulerSetDeadline() earliest deadline first within the High level.
+ * The other High tasks keep their round robin behind them. */
+#ifndef configUSE_MLFQ_EDF
+#define configUSE_MLFQ_EDF                    0
+#endif
+
+/* Set configUSE_MLFQ_SLICE_CONTROL to 1 to let the scheduler turn off the
+ * tick's round robin per priority with vTaskMlfqSetTimeSlicing().  Levels
+ * marked quantum_round_robin in the level table (Low by default) then only
+ * rotate between their ready tasks at quantum ends. */
+#ifndef configUSE_MLFQ_SLICE_CONTROL
+#define configUSE_MLFQ_SLICE_CONTROL          1
+#endif
+
+/* Set configUSE_TICKLESS_IDLE to 1 to stop the SysTick while the idle task
+ * runs and sleep until the next task wakes (the supervisor's next boost,
+ * scan or report deadline at the latest).  The ticks skipped this way are
+ * replayed into the profiler by traceINCREASE_TICK_COUNT (trace_hooks.h). */
+#ifndef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE               0
+#endif
+
+/* Shortest idle period, in ticks, worth stopping the tick for */
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
+
+/* When configUSE_16_BIT_TICKS is set to 1, TickType_t is defined
+ * to be an unsigned 16-bit type. When configUSE_16_BIT_TICKS is set to 0, 
+ * TickType_t is defined to be an unsigned 32-bit type. */
+#define configUSE_16_BIT_TICKS                0
+
+/* Number of thread local storage pointers held in each TCB. Slot 0 is used by
+ * the tick profiler to map a task handle to its accounting record in O(1). */
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS   (1)
+
+/* Keeps the high end of every stack in its TCB (one word per task), from
+ * which the stack statistics learn each task's depth */
+#define configRECORD_STACK_HIGH_ADDRESS       1
+
+/******************************************************************************/
+/* Memory allocation related definitions. *************************************/
+/******************************************************************************/
+
+/* Set configSUPPORT_STATIC_ALLOCATION to 1 to build the expired queue, the
+ * UART TX semaphore, the idle task and every task main.c creates from
+ * storage sized at link time. Start-up then takes nothing from the heap,
+ * which only serves tasks created at run time (test mixes, dynamic
+ * workers) and can be shrunk with configTOTAL_HEAP_SIZE. */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+#define configSUPPORT_STATIC_ALLOCATION       0
+#endif
+#define configSUPPORT_DYNAMIC_ALLOCATION      1
+
+/* Sets the total size of the FreeRTOS heap, in bytes, when heap_1.c, heap_2.c
+ * or heap_4.c are included in the build. This value is defaulted to 4096 bytes but
+ * it must be tailored to each application. Note the heap will appear in the .bss
+ * section. */
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE                 ((size_t)(16384))
+#endif
+
+/******************************************************************************/
+/* Hook and callback function related definitions. ****************************/
+/******************************************************************************/
+
+/* Set the following configUSE_* constants to 1 to include the named hook
+ * functionality in the build.  Set to 0 to exclude the hook functionality from the
+ * build.  The application writer is responsible for providing the hook function
+ * for any set to 1. */
+/* The idle hook (drivers.c) sleeps the core until the next interrupt and
+ * reports the time asleep to the profiler. Tickless idle sleeps on its own
+ * and would be cut short at every tick by the hook, so it leaves it out */
+#ifndef configUSE_IDLE_HOOK
+#if (configUSE_TICKLESS_IDLE == 1)
+#define configUSE_IDLE_HOOK                   0
+#else
+#define configUSE_IDLE_HOOK                   1
+#endif
+#endif
+#define configUSE_TICK_HOOK                   1
+
+/******************************************************************************/
+/* ARM Cortex-M Specific Definitions. *****************************************/
+/******************************************************************************/
+
+/* Tiva-C Micro-controllers use 3-bits as priority bits for each interrupt in NVIC PRI registers - 8 priority levels.
+ * The STM32F7 of MLFQ_BOARD_CORTEX_M7 uses 4 - 16 priority levels */
+#define configPRIO_BITS                               MLFQ_BOARD_PRIO_BITS
+
+/* The lowest interrupt priority that can be used */
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY       ((1 << configPRIO_BITS) - 1)
+
+/* The highest interrupt priority that can be used by any interrupt service
+routine that makes calls to interrupt safe FreeRTOS API functions.  DO NOT CALL
+INTERRUPT SAFE FREERTOS API FUNCTIONS FROM ANY INTERRUPT THAT HAS A HIGHER
+PRIORITY THAN THIS! (higher priorities are lower numeric values. */
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY  5
+
+/* Interrupt priorities used by the kernel port layer itself (the tick and context switch performing interrupts).
+ * This implementation is generic to all Cortex-M ports, and do not rely on any particular library functions. */
+#define configKERNEL_INTERRUPT_PRIORITY               (configLIBRARY_LOWEST_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+
+/* It sets the interrupt priority above which FreeRTOS API calls must not be made.  
+ * Interrupts above this priority are never disabled, so never delayed by RTOS activity. 
+ * This implementation is generic to all Cortex-M ports, and do not rely on any particular library functions. */
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY          (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+
+/******************************************************************************/
+/* Debugging assistance. ******************************************************/
+/******************************************************************************/
+
+/* Normal assert() semantics without relying on the provision of an assert.h header file. */
+#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
+
+/* Set configGENERATE_RUN_TIME_STATS to 1 to have the kernel time every task
+ * in core cycles, read at each context switch from Timer 2 counting up at the
+ * CPU clock (initRunTimeTimer(), drivers.c; TIM5 scaled to core cycles in
+ * drivers_cm7.c).  The counter is extended to
+ * 64 bits so the totals never wrap.  The tick profiler then takes its
+ * lifetime per-task totals from ulTaskGetRunTimeCounter(), and the standard
+ * uxTaskGetSystemState() / vTaskGetRunTimeStats() tooling sees the same data. */
+#ifndef configGENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS         0
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+extern void initRunTimeTimer(void);
+extern uint64_t getRunTimeCounter(void);
+#define configRUN_TIME_COUNTER_TYPE           uint64_t
+#define configUSE_TRACE_FACILITY              1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()  initRunTimeTimer()
+#define portGET_RUN_TIME_COUNTER_VALUE()      getRunTimeCounter()
+#endif
+
+/******************************************************************************/
+/* Function includes. ******************************************************/
+/******************************************************************************/
+#define INCLUDE_vTaskDelay          1
+#define INCLUDE_xTaskDelayUntil     1
+#define INCLUDE_vTaskPrioritySet    1
+#define INCLUDE_eTaskGetState       1
+#define INCLUDE_vTaskSuspend        1
+#define INCLUDE_vTaskDelete         1
+#define INCLUDE_xTaskGetSchedulerState 1
+#define INCLUDE_xTaskGetIdleTaskHandle 1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+
+/******************************************************************************/
+/* Trace hook definitions. ****************************************************/
+/******************************************************************************/
+
+/* Maps the kernel trace macros (traceTASK_SWITCHED_IN etc.) onto the MLFQ
+ * profiling modules. Each hook is compiled in only when its feature is enabled. */
+#include "trace_hooks.h"
+
+
+#endif /* FREERTOS_CONFIG_H */
+
@@ -659,6 +659,16 @@
     #define traceTIMER_EXPIRED( pxTimer )
 #endif
 
+/* Around every timer callback and pended function the timer service task
+ * runs; xPended is pdTRUE for a pended function. */
+#ifndef traceTIMER_CALLBACK_START
+    #define traceTIMER_CALLBACK_START()
+#endif
+
+#ifndef traceTIMER_CALLBACK_END
+    #define traceTIMER_CALLBACK_END( pxCallbackFunction, xPended )
+#endif
+
 #ifndef traceTIMER_COMMAND_RECEIVED
     #define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
@@ -190,10 +190,21 @@ typedef enum
  *
  * Macro for forcing a context switch.
  *
+ * traceTASK_YIELD() runs first, in the yielding task, so a trace can tell
+ * the switch that follows from a preemption.
+ *
  * \defgroup taskYIELD taskYIELD
  * \ingroup SchedulerControl
  */
-#define taskYIELD()                        portYIELD()
+#ifndef traceTASK_YIELD
+    #define traceTASK_YIELD()
+#endif
+
+#define taskYIELD()                        \
+    do {                                   \
+        traceTASK_YIELD();                 \
+        portYIELD();                       \
+    } while( 0 )
 
 /**
  * task. h
@@ -1957,6 +1968,25 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available (backported from FreeRTOS V11).
+ *
+ * Returns the total execution time of xTask, or of the calling task if xTask
+ * is NULL, up to its last switch-out.  The running task's current slice is
+ * not included.  The unit of time is that of
+ * portGET_RUN_TIME_COUNTER_VALUE().
+ *
+ * \defgroup ulTaskGetRunTimeCounter ulTaskGetRunTimeCounter
+ * \ingroup TaskUtils
+ */
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -2901,6 +2931,113 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
  */
 BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MLFQ_NATIVE == 1 )
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskMlfqSetLevel( TaskHandle_t xTask, UBaseType_t uxLevel, UBaseType_t uxQuantumTicks );
+ * @endcode
+ *
+ * Places xTask under kernel-native MLFQ control at uxLevel with a quantum of
+ * uxQuantumTicks ticks, and restarts its quantum.  The priority itself is not
+ * changed; use vTaskPrioritySet() for that.  A quantum of 0 releases the task,
+ * after which the tick no longer charges it.
+ *
+ * Once a managed task has run for its quantum, xTaskIncrementTick() calls
+ * xApplicationMlfqQuantumExpired() from the tick interrupt.  The callback may
+ * update the level, the (lower or equal) base priority and the quantum in
+ * place; the kernel then moves the task to the new ready list.
+ */
+    void vTaskMlfqSetLevel( TaskHandle_t xTask,
+                            UBaseType_t uxLevel,
+                            UBaseType_t uxQuantumTicks ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskMlfqGetLevel( TaskHandle_t xTask );
+ * @endcode
+ *
+ * Returns the MLFQ level of xTask as last set by vTaskMlfqSetLevel() or by
+ * xApplicationMlfqQuantumExpired().
+ */
+    UBaseType_t uxTaskMlfqGetLevel( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/* Provided by the application; runs in the tick interrupt. */
+    BaseType_t xApplicationMlfqQuantumExpired( TaskHandle_t xTask,
+                                               UBaseType_t * puxLevel,
+                                               UBaseType_t * puxPriority,
+                                               UBaseType_t * puxQuantumTicks );
+
+#endif /* configUSE_MLFQ_NATIVE */
+
+#if ( configUSE_MLFQ_EDF == 1 )
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskMlfqSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline );
+ * @endcode
+ *
+ * Gives xTask a relative deadline in ticks.  Each time the task becomes ready
+ * after blocking, its job is due xRelativeDeadline ticks later, and at the
+ * priority set with vTaskMlfqSetEdfPriority() the ready task due first runs
+ * first.  Tasks without a deadline share what is left round robin.  A
+ * deadline of 0 removes the task from deadline ordering.
+ */
+    void vTaskMlfqSetDeadline( TaskHandle_t xTask,
+                               TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskMlfqSetEdfPriority( UBaseType_t uxPriority );
+ * @endcode
+ *
+ * Selects the priority whose ready tasks are ordered by deadline.  Tasks with
+ * a deadline at any other priority are scheduled as usual.
+ */
+    void vTaskMlfqSetEdfPriority( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MLFQ_EDF */
+
+#if ( configUSE_MLFQ_SLICE_CONTROL == 1 )
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskMlfqSetTimeSlicing( UBaseType_t uxPriority, BaseType_t xEnable );
+ * @endcode
+ *
+ * Turns the tick's round robin between ready tasks of priority uxPriority on
+ * or off (it is on for every priority at start-up).  With it off, a task of
+ * that priority keeps the CPU until it blocks, yields or is preempted by a
+ * higher priority; the application rotates equals at its own quantum
+ * boundaries.  Has no effect unless configUSE_TIME_SLICING is 1.
+ */
+    void vTaskMlfqSetTimeSlicing( UBaseType_t uxPriority,
+                                  BaseType_t xEnable ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MLFQ_SLICE_CONTROL */
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetReadyPriorities( void );
+ * @endcode
+ *
+ * Returns the ready priority bitmap kept by the port optimised task
+ * selection: bit n is set while at least one task of priority n is in the
+ * Ready or Running state.  The value is a snapshot and may be stale as
+ * soon as it is returned.
+ */
+    UBaseType_t uxTaskGetReadyPriorities( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
 
 /*-----------------------------------------------------------
 * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -115,6 +115,28 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
+/* With configUSE_MLFQ_EDF, the task chosen at the EDF priority is replaced by
+ * the ready task with the earliest deadline, and a task released with an
+ * earlier deadline than the running one preempts it. */
+#if ( configUSE_MLFQ_EDF == 1 )
+    #define taskSELECT_EDF_TASK( uxTopPriority )    prvMlfqEdfSelect( uxTopPriority )
+    #define taskEDF_PREEMPTS( pxTCB )               prvMlfqEdfPreempts( pxTCB )
+#else
+    #define taskSELECT_EDF_TASK( uxTopPriority )
+    #define taskEDF_PREEMPTS( pxTCB )               pdFALSE
+#endif
+
+/* With configUSE_MLFQ_SLICE_CONTROL, the tick only shares the CPU between
+ * ready tasks of equal priority at priorities that keep time slicing. */
+#if ( configUSE_MLFQ_SLICE_CONTROL == 1 )
+    #if ( configMAX_PRIORITIES > 32 )
+        #error configUSE_MLFQ_SLICE_CONTROL supports at most 32 priorities
+    #endif
+    #define taskTIME_SLICED( uxPriority )    ( ( ulMlfqUnslicedPriorities & ( 1UL << ( uxPriority ) ) ) == 0UL )
+#else
+    #define taskTIME_SLICED( uxPriority )    pdTRUE
+#endif
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -147,6 +169,7 @@
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
         listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskSELECT_EDF_TASK( uxTopPriority );                                                 \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -177,6 +200,7 @@
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
         listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskSELECT_EDF_TASK( uxTopPriority );                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 /*-----------------------------------------------------------*/
@@ -214,11 +238,30 @@
 
 /*-----------------------------------------------------------*/
 
+/*
+ * A task with a relative deadline that enters a ready list after blocking (or
+ * being created or resumed) starts a new job: its absolute deadline is taken
+ * from the current tick.  Priority changes of a ready task keep the deadline.
+ */
+#if ( configUSE_MLFQ_EDF == 1 )
+    #define taskEDF_RELEASE( pxTCB )                                                                       \
+    {                                                                                                      \
+        if( ( ( pxTCB )->xMlfqRelativeDeadline != ( TickType_t ) 0U ) && ( ( pxTCB )->xMlfqReleased == pdFALSE ) ) \
+        {                                                                                                  \
+            ( pxTCB )->xMlfqDeadline = xTickCount + ( pxTCB )->xMlfqRelativeDeadline;                      \
+            ( pxTCB )->xMlfqReleased = pdTRUE;                                                             \
+        }                                                                                                  \
+    }
+#else
+    #define taskEDF_RELEASE( pxTCB )
+#endif
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
 #define prvAddTaskToReadyList( pxTCB )                                                                 \
+    taskEDF_RELEASE( pxTCB );                                                                          \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
@@ -318,6 +361,18 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_MLFQ_NATIVE == 1 )
+        UBaseType_t uxMlfqLevel;      /*< MLFQ level, owned by the application. */
+        UBaseType_t uxMlfqQuantum;    /*< Ticks allowed at this level.  0 when the task is not managed. */
+        UBaseType_t uxMlfqRunTicks;   /*< Ticks used of the current quantum. */
+    #endif
+
+    #if ( configUSE_MLFQ_EDF == 1 )
+        TickType_t xMlfqRelativeDeadline; /*< Deadline of each job after its release.  0 when the task has none. */
+        TickType_t xMlfqDeadline;         /*< Absolute deadline of the current job. */
+        BaseType_t xMlfqReleased;         /*< pdTRUE from a release until the task blocks. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -385,6 +440,16 @@ const volatile UBaseType_t uxTopUsedPriority = configMAX_PRIORITIES - 1U;
  * accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
 
+#if ( configUSE_MLFQ_EDF == 1 )
+    /* Priority whose ready list is ordered by deadline; none until set. */
+    PRIVILEGED_DATA static UBaseType_t uxMlfqEdfPriority = ( UBaseType_t ) configMAX_PRIORITIES;
+#endif
+
+#if ( configUSE_MLFQ_SLICE_CONTROL == 1 )
+    /* Bit n set: tasks of priority n are not round robined on the tick. */
+    PRIVILEGED_DATA static volatile uint32_t ulMlfqUnslicedPriorities = 0UL;
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 /* Do not move these variables to function scope as doing so prevents the
@@ -516,6 +581,42 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MLFQ_NATIVE == 1 )
+
+/*
+ * Charges the tick to the running task and, once its MLFQ quantum is used
+ * up, moves it to the level chosen by xApplicationMlfqQuantumExpired().
+ * Called from xTaskIncrementTick() only.  Returns pdTRUE if the running
+ * task was moved to a lower priority and a context switch is required.
+ */
+    static BaseType_t prvMlfqChargeRunningTask( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_MLFQ_EDF == 1 )
+
+/*
+ * Returns pdTRUE if the current job of pxA is due before that of pxB.  A task
+ * without a released job is due after every task that has one.
+ */
+    static BaseType_t prvMlfqEdfBefore( const TCB_t * pxA,
+                                        const TCB_t * pxB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by taskSELECT_HIGHEST_PRIORITY_TASK() once pxCurrentTCB holds the
+ * round robin choice.  At the EDF priority it moves the choice, and the list
+ * index, to the ready task with the earliest deadline.
+ */
+    static void prvMlfqEdfSelect( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxTCB, just made ready, is due before the running task at
+ * the EDF priority and should preempt it.
+ */
+    static BaseType_t prvMlfqEdfPreempts( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -1682,6 +1783,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
             traceTASK_SUSPEND( pxTCB );
 
+            #if ( configUSE_MLFQ_EDF == 1 )
+            {
+                pxTCB->xMlfqReleased = pdFALSE;
+            }
+            #endif
+
             /* Remove task from the ready/delayed list and place in the
              * suspended list. */
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -2690,8 +2797,9 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 {
                     /* Preemption is on, but a context switch should only be
                      * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                     * higher than the currently executing task, or an
+                     * earlier deadline at the EDF priority. */
+                    if( ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) || ( taskEDF_PREEMPTS( pxTCB ) != pdFALSE ) )
                     {
                         /* Pend the yield to be performed when the scheduler
                          * is unsuspended. */
@@ -2818,8 +2926,9 @@ BaseType_t xTaskIncrementTick( void )
                          * The case of equal priority tasks sharing
                          * processing time (which happens when both
                          * preemption and time slicing are on) is
-                         * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                         * handled below, except that a task with an earlier
+                         * deadline at the EDF priority preempts at once. */
+                        if( ( pxTCB->uxPriority > pxCurrentTCB->uxPriority ) || ( taskEDF_PREEMPTS( pxTCB ) != pdFALSE ) )
                         {
                             xSwitchRequired = pdTRUE;
                         }
@@ -2838,7 +2947,8 @@ BaseType_t xTaskIncrementTick( void )
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                ( taskTIME_SLICED( pxCurrentTCB->uxPriority ) ) )
             {
                 xSwitchRequired = pdTRUE;
             }
@@ -2849,6 +2959,19 @@ BaseType_t xTaskIncrementTick( void )
         }
         #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
+        #if ( configUSE_MLFQ_NATIVE == 1 )
+        {
+            if( prvMlfqChargeRunningTask() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MLFQ_NATIVE */
+
         #if ( configUSE_TICK_HOOK == 1 )
         {
             /* Guard against the tick hook being called when the pended tick
@@ -3214,11 +3337,12 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( ( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority ) || ( taskEDF_PREEMPTS( pxUnblockedTCB ) != pdFALSE ) )
     {
         /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
+         * priority than the calling task, or is due first at the EDF priority.
+         * This allows the calling task to know if it should force a context
+         * switch now. */
         xReturn = pdTRUE;
 
         /* Mark that a yield is pending in case the user is not using the
@@ -5257,6 +5381,29 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* The counter may be wider than a word and is updated by the context
+         * switch, so read it in one piece. */
+        taskENTER_CRITICAL();
+        {
+            ulReturn = pxTCB->ulRunTimeCounter;
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
@@ -5309,6 +5456,13 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_MLFQ_EDF == 1 )
+    {
+        /* Blocking ends the current job; the next release starts another. */
+        pxCurrentTCB->xMlfqReleased = pdFALSE;
+    }
+    #endif
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -5406,6 +5560,277 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     #endif /* INCLUDE_vTaskSuspend */
 }
 
+#if ( configUSE_MLFQ_NATIVE == 1 )
+
+    static BaseType_t prvMlfqChargeRunningTask( void )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        UBaseType_t uxLevel, uxNewPriority, uxQuantum;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        if( pxTCB->uxMlfqQuantum == ( UBaseType_t ) 0U )
+        {
+            /* Not managed by the MLFQ. */
+            return pdFALSE;
+        }
+
+        if( ++( pxTCB->uxMlfqRunTicks ) < pxTCB->uxMlfqQuantum )
+        {
+            return pdFALSE;
+        }
+
+        uxLevel = pxTCB->uxMlfqLevel;
+        uxNewPriority = pxTCB->uxBasePriority;
+        uxQuantum = pxTCB->uxMlfqQuantum;
+
+        ( void ) xApplicationMlfqQuantumExpired( pxTCB, &uxLevel, &uxNewPriority, &uxQuantum );
+
+        pxTCB->uxMlfqLevel = uxLevel;
+        pxTCB->uxMlfqQuantum = uxQuantum;
+        pxTCB->uxMlfqRunTicks = ( UBaseType_t ) 0U;
+
+        if( uxNewPriority != pxTCB->uxBasePriority )
+        {
+            configASSERT( uxNewPriority < pxTCB->uxBasePriority );
+
+            /* As in vTaskPrioritySet(), a task running on an inherited
+             * priority only has its base priority changed. */
+            if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+            {
+                /* The running task is always in its ready list. */
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTCB->uxPriority = uxNewPriority;
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task of the old priority may now be the highest ready. */
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->uxBasePriority = uxNewPriority;
+
+            if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+            {
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* A task that keeps its priority gives way to its equals at the end
+         * of its quantum, where the tick does not rotate them. */
+        if( ( taskTIME_SLICED( pxTCB->uxPriority ) == pdFALSE ) &&
+            ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) )
+        {
+            xSwitchRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xSwitchRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskMlfqSetLevel( TaskHandle_t xTask,
+                            UBaseType_t uxLevel,
+                            UBaseType_t uxQuantumTicks )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxTCB->uxMlfqLevel = uxLevel;
+            pxTCB->uxMlfqQuantum = uxQuantumTicks;
+            pxTCB->uxMlfqRunTicks = ( UBaseType_t ) 0U;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskMlfqGetLevel( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxLevel;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxLevel = pxTCB->uxMlfqLevel;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxLevel;
+    }
+
+#endif /* configUSE_MLFQ_NATIVE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MLFQ_EDF == 1 )
+
+    static BaseType_t prvMlfqEdfBefore( const TCB_t * pxA,
+                                        const TCB_t * pxB )
+    {
+        BaseType_t xReturn;
+
+        if( pxA->xMlfqReleased == pdFALSE )
+        {
+            xReturn = pdFALSE;
+        }
+        else if( pxB->xMlfqReleased == pdFALSE )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            /* Deadlines in use are less than half the tick range apart, so the
+             * difference tells which comes first across a tick count wrap. */
+            xReturn = ( ( TickType_t ) ( pxA->xMlfqDeadline - pxB->xMlfqDeadline ) > ( portMAX_DELAY >> 1 ) ) ? pdTRUE : pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvMlfqEdfSelect( UBaseType_t uxPriority )
+    {
+        List_t * const pxList = &( pxReadyTasksLists[ uxPriority ] );
+        const ListItem_t * const pxEndMarker = ( const ListItem_t * ) listGET_END_MARKER( pxList );
+        ListItem_t * pxItem;
+        TCB_t * pxBest = pxCurrentTCB;
+        TCB_t * pxTCB;
+
+        if( uxPriority == uxMlfqEdfPriority )
+        {
+            for( pxItem = listGET_HEAD_ENTRY( pxList ); pxItem != pxEndMarker; pxItem = listGET_NEXT( pxItem ) )
+            {
+                pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
+
+                if( prvMlfqEdfBefore( pxTCB, pxBest ) != pdFALSE )
+                {
+                    pxBest = pxTCB;
+                }
+            }
+
+            if( pxBest != pxCurrentTCB )
+            {
+                /* Round robin among the tasks without a deadline carries on
+                 * from here once the deadline tasks have run. */
+                pxList->pxIndex = &( pxBest->xStateListItem );
+                pxCurrentTCB = pxBest;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvMlfqEdfPreempts( const TCB_t * pxTCB )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxTCB->uxPriority == uxMlfqEdfPriority ) && ( pxCurrentTCB->uxPriority == uxMlfqEdfPriority ) )
+        {
+            xReturn = prvMlfqEdfBefore( pxTCB, pxCurrentTCB );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskMlfqSetDeadline( TaskHandle_t xTask,
+                               TickType_t xRelativeDeadline )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxTCB->xMlfqRelativeDeadline = xRelativeDeadline;
+
+            /* A task that is ready now is taken as released now; a blocked
+             * task gets its first deadline when it next becomes ready. */
+            if( ( xRelativeDeadline != ( TickType_t ) 0U ) &&
+                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                pxTCB->xMlfqDeadline = xTickCount + xRelativeDeadline;
+                pxTCB->xMlfqReleased = pdTRUE;
+            }
+            else
+            {
+                pxTCB->xMlfqReleased = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskMlfqSetEdfPriority( UBaseType_t uxPriority )
+    {
+        taskENTER_CRITICAL();
+        {
+            uxMlfqEdfPriority = uxPriority;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_MLFQ_EDF */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MLFQ_SLICE_CONTROL == 1 )
+
+    void vTaskMlfqSetTimeSlicing( UBaseType_t uxPriority,
+                                  BaseType_t xEnable )
+    {
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        taskENTER_CRITICAL();
+        {
+            if( xEnable != pdFALSE )
+            {
+                ulMlfqUnslicedPriorities &= ~( 1UL << uxPriority );
+            }
+            else
+            {
+                ulMlfqUnslicedPriorities |= ( 1UL << uxPriority );
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_MLFQ_SLICE_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+    UBaseType_t uxTaskGetReadyPriorities( void )
+    {
+        /* With port optimised selection uxTopReadyPriority holds one bit per
+         * priority that has a task in its ready list.  A single word read,
+         * so no critical section is needed for a snapshot. */
+        return uxTopReadyPriority;
+    }
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
 /* Code below here allows additional code to be inserted into this source file,
  * especially where access to file scope functions and data is needed (for example
  * when performing module tests). */
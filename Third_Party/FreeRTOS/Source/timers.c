@@ -533,7 +533,9 @@
 
             /* Call the timer callback. */
             traceTIMER_EXPIRED( pxTimer );
+            traceTIMER_CALLBACK_START();
             pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+            traceTIMER_CALLBACK_END( pxTimer->pxCallbackFunction, pdFALSE );
         }
     }
 /*-----------------------------------------------------------*/
@@ -561,7 +563,9 @@
 
         /* Call the timer callback. */
         traceTIMER_EXPIRED( pxTimer );
+        traceTIMER_CALLBACK_START();
         pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        traceTIMER_CALLBACK_END( pxTimer->pxCallbackFunction, pdFALSE );
     }
 /*-----------------------------------------------------------*/
 
@@ -779,7 +783,9 @@
                     configASSERT( pxCallback );
 
                     /* Call the function. */
+                    traceTIMER_CALLBACK_START();
                     pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+                    traceTIMER_CALLBACK_END( pxCallback->pxCallbackFunction, pdTRUE );
                 }
                 else
                 {
@@ -840,7 +846,9 @@
 
                             /* Call the timer callback. */
                             traceTIMER_EXPIRED( pxTimer );
+                            traceTIMER_CALLBACK_START();
                             pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                            traceTIMER_CALLBACK_END( pxTimer->pxCallbackFunction, pdFALSE );
                         }
                         else
                         {
@@ -0,0 +1,80 @@
+/******************************************************************************
+ *  MODULE NAME  : Task Aging
+ *  FILE         : aging.h
+ *  DESCRIPTION  : Tracks how long each registered task has been ready
+ *                 without running, so the scheduler can promote only the
+ *                 tasks that are actually starving. Included from
+ *                 trace_hooks.h, so it must not pull in any FreeRTOS
+ *                 header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef AGING_H_
+#define AGING_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Per-task aging (promote one level after a per-level ready wait); when
+ * enabled it replaces the periodic global boost */
+#ifndef MLFQ_AGING_ENABLED
+#define MLFQ_AGING_ENABLED           0U
+#endif
+
+/* Overload detection (scheduler.h) reads the same ready waits */
+#ifndef MLFQ_OVERLOAD_ENABLED
+#define MLFQ_OVERLOAD_ENABLED        0U
+#endif
+
+/* Boost period auto-tuning (scheduler.h) watches the Low waits too */
+#ifndef MLFQ_BOOST_AUTOTUNE_ENABLED
+#define MLFQ_BOOST_AUTOTUNE_ENABLED  0U
+#endif
+
+/* Ready waits are tracked for any of them */
+#if (MLFQ_AGING_ENABLED == 1U) || (MLFQ_OVERLOAD_ENABLED == 1U) || \
+    (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+#define AGING_WAIT_TRACKING_ENABLED  1U
+#else
+#define AGING_WAIT_TRACKING_ENABLED  0U
+#endif
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (AGING_WAIT_TRACKING_ENABLED == 1U)
+/* Description : Ends the wait of the task switched in */
+void agingTaskSwitchedIn(void *task);
+
+/* Description : Starts a wait for a preempted task (still ready) */
+void agingTaskSwitchedOut(void *task, bool stillReady);
+
+/* Description : Starts a wait for a task moved to a ready list */
+void agingTaskReady(void *task);
+
+/* Description : Cycles the task in a profiler slot has been waiting in a
+ *               ready list. Returns false if it is running or blocked */
+bool agingGetWaitCycles(uint32_t slot, uint32_t *cycles);
+
+/* Description : Restarts the wait clock of a slot after a promotion */
+void agingRestartWait(uint32_t slot);
+
+/* Description : Clears the state of a profiler slot (slot reuse) */
+void agingResetTask(uint32_t slot);
+#endif
+
+#endif /* AGING_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,43 @@
+/******************************************************************************
+ *  MODULE NAME  : Board Selection
+ *  FILE         : board.h
+ *  DESCRIPTION  : Selects the board the firmware is built for. drivers.h
+ *                 is the hardware interface of the scheduler (logging,
+ *                 LEDs, timers, watchdog); each board has one source file
+ *                 implementing it, and the others compile to nothing.
+ *                 Macros only, so any header may include it.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Supported boards and the drivers backend of each */
+#define MLFQ_BOARD_TM4C123           0U   /* EK-TM4C123GXL, 80 MHz Cortex-M4F (drivers.c) */
+#define MLFQ_BOARD_CORTEX_M7         1U   /* NUCLEO-F767ZI, 216 MHz Cortex-M7 with caches (drivers_cm7.c) */
+
+#ifndef MLFQ_BOARD
+#define MLFQ_BOARD                   MLFQ_BOARD_TM4C123
+#endif
+
+#if (MLFQ_BOARD != MLFQ_BOARD_TM4C123) && (MLFQ_BOARD != MLFQ_BOARD_CORTEX_M7)
+#error "MLFQ_BOARD must name a MLFQ_BOARD_x"
+#endif
+
+/* Interrupt priority bits the NVIC implements */
+#if (MLFQ_BOARD == MLFQ_BOARD_CORTEX_M7)
+#define MLFQ_BOARD_PRIO_BITS         4
+#else
+#define MLFQ_BOARD_PRIO_BITS         3
+#endif
+
+#endif /* BOARD_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *  MODULE NAME  : Burst Statistics
+ *  FILE         : burst_stats.h
+ *  DESCRIPTION  : Measures CPU bursts (CPU time from a wake-up until the
+ *                 task blocks again) and keeps a histogram per MLFQ level
+ *                 over a rolling window. Included from trace_hooks.h, so
+ *                 it must not pull in any FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef BURST_STATS_H_
+#define BURST_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* CPU burst histograms; set to 0U to compile the hooks out */
+#ifndef BURST_STATS_ENABLED
+#define BURST_STATS_ENABLED          1U
+#endif
+
+/* Linear buckets; the last bucket also collects longer bursts */
+#ifndef BURST_HIST_BUCKETS
+#define BURST_HIST_BUCKETS           64U
+#endif
+
+/* Width of one bucket in microseconds */
+#ifndef BURST_BUCKET_US
+#define BURST_BUCKET_US              2000U
+#endif
+
+/* Promotes a task below High by one level after a run of short bursts
+ * (it blocked well before its quantum ran out) */
+#ifndef MLFQ_BURST_PROMOTION_ENABLED
+#define MLFQ_BURST_PROMOTION_ENABLED BURST_STATS_ENABLED
+#endif
+
+/* A burst is short when it used less than this share of the quantum */
+#ifndef MLFQ_SHORT_BURST_PERCENT
+#define MLFQ_SHORT_BURST_PERCENT     50U
+#endif
+
+/* Consecutive short bursts that earn one level */
+#ifndef MLFQ_SHORT_BURSTS_TO_PROMOTE
+#define MLFQ_SHORT_BURSTS_TO_PROMOTE 4U
+#endif
+
+#if ((MLFQ_BURST_PROMOTION_ENABLED == 1U) && (BURST_STATS_ENABLED == 0U))
+#error "MLFQ_BURST_PROMOTION_ENABLED needs BURST_STATS_ENABLED"
+#endif
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (BURST_STATS_ENABLED == 1U)
+/* Description : Converts the bucket width to cycles; call after initClock() */
+void burstStatsInit(void);
+
+/* Description : Starts or resumes the burst of the task switched in */
+void burstTaskSwitchedIn(void *task);
+
+/* Description : Charges the task switched out and closes its burst if it
+ *               blocked (is no longer in a ready list) */
+void burstTaskSwitchedOut(void *task, bool stillReady);
+
+/* Description : Burst length (us, bucket upper edge) that 'percent' of the
+ *               bursts started at 'level' fit in, and the sample count.
+ *               Returns false if the level has no samples */
+bool burstGetLevelPercentile(uint32_t level, uint32_t percent,
+                             uint32_t *burstUs, uint32_t *samples);
+
+/* Description : Clears the level histograms to start a new window */
+void burstStartWindow(void);
+
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+/* Description : Returns true once per completed run of short bursts */
+bool burstTakePromotion(uint32_t slot);
+#endif
+
+/* Description : Clears the per-task burst state of a profiler slot */
+void burstResetTask(uint32_t slot);
+#endif
+
+#endif /* BURST_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
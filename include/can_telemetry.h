@@ -0,0 +1,172 @@
+/******************************************************************************
+ *  MODULE NAME  : CAN Telemetry
+ *  FILE         : can_telemetry.h
+ *  DESCRIPTION  : Publishes a compact scheduler summary of this board on
+ *                 CAN0 at a fixed rate: per-level CPU use, wake-to-run
+ *                 latency percentiles, demotions, boosts and overload
+ *                 alarms, in three classic 8-byte frames. One board in
+ *                 collector mode also listens to every other board and
+ *                 prints a fleet table on its UART. With fleet tuning,
+ *                 the collector also pushes scheduler parameters to
+ *                 every board, which apply them at one instant and
+ *                 acknowledge.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef CAN_TELEMETRY_H_
+#define CAN_TELEMETRY_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "scheduler.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* CAN telemetry; set to 1U to publish on CAN0 (PE4 = RX, PE5 = TX) */
+#ifndef CAN_TELEMETRY_ENABLED
+#define CAN_TELEMETRY_ENABLED              0U
+#endif
+
+/* Set to 1U on the one board that collects the summaries of the others */
+#ifndef CAN_TELEMETRY_COLLECTOR
+#define CAN_TELEMETRY_COLLECTOR            0U
+#endif
+
+/* This board's node number, unique on the bus */
+#ifndef CAN_TELEMETRY_NODE_ID
+#define CAN_TELEMETRY_NODE_ID              1U
+#endif
+
+/* Publish period, and the bus bit rate */
+#ifndef CAN_TELEMETRY_PERIOD_MS
+#define CAN_TELEMETRY_PERIOD_MS            1000U
+#endif
+
+#ifndef CAN_TELEMETRY_BITRATE
+#define CAN_TELEMETRY_BITRATE              500000U
+#endif
+
+/* Standard identifiers used: BASE_ID + node * 4 + frame. Node numbers
+ * run from 0 to CAN_TELEMETRY_MAX_NODES - 1 */
+#ifndef CAN_TELEMETRY_BASE_ID
+#define CAN_TELEMETRY_BASE_ID              0x600U
+#endif
+
+#define CAN_TELEMETRY_MAX_NODES            64U
+
+#if (CAN_TELEMETRY_NODE_ID >= CAN_TELEMETRY_MAX_NODES)
+#error "CAN_TELEMETRY_NODE_ID must be below CAN_TELEMETRY_MAX_NODES"
+#endif
+
+#if ((CAN_TELEMETRY_BASE_ID & 0xFFU) != 0U) || ((CAN_TELEMETRY_BASE_ID + 0x100U) > 0x800U)
+#error "CAN_TELEMETRY_BASE_ID must be a multiple of 0x100, at most 0x700"
+#endif
+
+/* Frames of one summary, all values little-endian:
+ *   UTIL    : High, middle levels, Low and idle CPU (4 x uint16, 0.1 %)
+ *   LATENCY : High level p50, p99 and max, Low level p99 (4 x uint16, us)
+ *   EVENTS  : demotions/s, boosts and overload alarms in the period
+ *             (3 x uint16), registered tasks, overload causes in force */
+#define CAN_TELEMETRY_FRAME_UTIL           0U
+#define CAN_TELEMETRY_FRAME_LATENCY        1U
+#define CAN_TELEMETRY_FRAME_EVENTS         2U
+#define CAN_TELEMETRY_FRAMES               3U
+
+/* Fourth identifier of a node: its tuning acknowledgement, sequence and
+ * CAN_TUNING_ACK_x status, then its SCHED_POLICY */
+#define CAN_TELEMETRY_FRAME_ACK            3U
+
+/* A node not heard from for this many periods leaves the fleet table */
+#ifndef CAN_TELEMETRY_STALE_PERIODS
+#define CAN_TELEMETRY_STALE_PERIODS        3U
+#endif
+
+/* Collector: how often the receive FIFO is drained */
+#ifndef CAN_TELEMETRY_POLL_MS
+#define CAN_TELEMETRY_POLL_MS              20U
+#endif
+
+/* Fleet tuning; set to 1U on every board. The collector pushes a set
+ * with canTuningPush() (or the console's "push") and the others take it
+ * from CAN_TUNING_COMMAND_ID */
+#ifndef CAN_TUNING_ENABLED
+#define CAN_TUNING_ENABLED                 0U
+#endif
+
+/* Identifier of the collector's tuning frames. Below the telemetry block
+ * by default, so it wins arbitration over the summaries */
+#ifndef CAN_TUNING_COMMAND_ID
+#define CAN_TUNING_COMMAND_ID              (CAN_TELEMETRY_BASE_ID - 0x10U)
+#endif
+
+/* Time from the commit frame to the switch. Every board counts it from
+ * its own reception of the same frame, so the boards switch within one
+ * CAN_TELEMETRY_POLL_MS of each other; the lead covers the supervisor
+ * wake-up */
+#ifndef CAN_TUNING_LEAD_MS
+#define CAN_TUNING_LEAD_MS                 100U
+#endif
+
+#if (CAN_TUNING_ENABLED == 1U) && (CAN_TELEMETRY_ENABLED == 0U)
+#error "CAN_TUNING_ENABLED needs CAN_TELEMETRY_ENABLED"
+#endif
+
+#if (CAN_TUNING_ENABLED == 1U) && ((CAN_TUNING_COMMAND_ID > 0x7FFU) || \
+    ((CAN_TUNING_COMMAND_ID >= CAN_TELEMETRY_BASE_ID) && \
+     (CAN_TUNING_COMMAND_ID < (CAN_TELEMETRY_BASE_ID + 0x100U))))
+#error "CAN_TUNING_COMMAND_ID must be a standard identifier outside the telemetry block"
+#endif
+
+/* Tuning frames, byte 0 the kind and byte 1 the set's sequence number:
+ *   QUANTUM : level, quantum in ticks (uint16), in us (24 bits)
+ *   BOOST   : SCHED_POLICY, level count, boost period in ms (uint32)
+ *   COMMIT  : lead time in ms (uint16); applies the set if complete */
+#define CAN_TUNING_KIND_QUANTUM            0U
+#define CAN_TUNING_KIND_BOOST              1U
+#define CAN_TUNING_KIND_COMMIT             2U
+
+/* Acknowledgement status */
+#define CAN_TUNING_ACK_APPLIED             0U  /* In force */
+#define CAN_TUNING_ACK_REJECTED            1U  /* Outside schedulerSetTunables() limits */
+#define CAN_TUNING_ACK_MISMATCH            2U  /* Built with another policy or level count */
+#define CAN_TUNING_ACK_INCOMPLETE          3U  /* Commit without every frame of the set */
+
+/* Telemetry task: below every MLFQ level, like the logger task */
+#define CAN_TELEMETRY_PRIORITY             (tskIDLE_PRIORITY + 1U)
+#define CAN_TELEMETRY_STACK_SIZE           384U
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (CAN_TELEMETRY_ENABLED == 1U)
+/*
+ * Description : Telemetry task. Brings up CAN0, then publishes this
+ *               board's summary every CAN_TELEMETRY_PERIOD_MS. In
+ *               collector mode it also drains the receive FIFO and
+ *               prints the fleet table after each publish.
+ */
+void canTelemetryTask(void *pvParameters);
+#endif
+
+#if (CAN_TUNING_ENABLED == 1U) && (CAN_TELEMETRY_COLLECTOR == 1U)
+/*
+ * Description : Queues a parameter set for the fleet, the collector
+ *               included; the telemetry task sends it on its next poll.
+ *               reporting_enabled stays each board's own. Returns false
+ *               while the previous set is still waiting to go out.
+ */
+bool canTuningPush(const MLFQ_Tunables_t *tunables);
+#endif
+
+#endif /* CAN_TELEMETRY_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,67 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Console
+ *  FILE         : console.h
+ *  DESCRIPTION  : Line-based command interpreter on UART0 RX for reading
+ *                 and changing scheduler parameters at run time.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* UART command console; set to 0U to leave UART0 RX unused */
+#ifndef CONSOLE_ENABLED
+#define CONSOLE_ENABLED             1U
+#endif
+
+/* Longest command line accepted, including the terminator */
+#ifndef CONSOLE_LINE_SIZE
+#define CONSOLE_LINE_SIZE           48U
+#endif
+
+/* Console task: below every MLFQ level, like the logger task */
+#define CONSOLE_TASK_PRIORITY       (tskIDLE_PRIORITY + 1U)
+#define CONSOLE_STACK_SIZE          384U
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (CONSOLE_ENABLED == 1U)
+/*
+ * Description : Console task. Sleeps until the UART0 RX interrupt delivers
+ *               bytes, assembles lines and executes them. Commands:
+ *                 help
+ *                 get
+ *                 set quantum <level> <ticks>
+ *                 set quantum_us <level> <us>
+ *                 set boost <ms>
+ *                 report on|off
+ *                 save | defaults
+ *                 stats
+ *                 trace
+ *                 stacks
+ *                 heap
+ *                 pool
+ *                 history
+ *                 push (CAN tuning collector)
+ */
+void consoleTask(void *pvParameters);
+#endif
+
+#endif /* CONSOLE_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
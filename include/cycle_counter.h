@@ -0,0 +1,130 @@
+/******************************************************************************
+ *  MODULE NAME  : Cycle Counter
+ *  FILE         : cycle_counter.h
+ *  DESCRIPTION  : Minimal access to the Cortex-M DWT cycle counter used for
+ *                 sub-tick CPU accounting and overhead measurements.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+
+/* MLFQ_BOARD */
+#include "board.h"
+
+#if defined(MLFQ_HOST_SIM)
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/* Description : Simulated cycle count of the host build (sim/sim_drivers.c) */
+uint32_t simCycleCounterGet(void);
+
+/******************************************************************************
+ *  INLINE FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : The host build has no DWT; its counter always runs.
+ */
+static inline void cycleCounterInit(void)
+{
+}
+
+/*
+ * Description : Returns the simulated core cycle count.
+ */
+static inline uint32_t cycleCounterGet(void)
+{
+    return simCycleCounterGet();
+}
+
+/*
+ * Description : The simulated counter follows the host clock, so there is
+ *               no sleep gap to make up.
+ */
+static inline void cycleCounterAdvance(uint32_t cycles)
+{
+    (void)cycles;
+}
+
+#else
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Debug Exception and Monitor Control register (TRCENA enables the DWT) */
+#define CYCLE_COUNTER_DEMCR_REG       (*((volatile uint32_t *)0xE000EDFCUL))
+#define CYCLE_COUNTER_DEMCR_TRCENA    (1UL << 24)
+
+/* DWT control register (CYCCNTENA starts the counter) */
+#define CYCLE_COUNTER_DWT_CTRL_REG    (*((volatile uint32_t *)0xE0001000UL))
+#define CYCLE_COUNTER_DWT_CYCCNTENA   (1UL << 0)
+
+/* Free-running 32-bit cycle count */
+#define CYCLE_COUNTER_DWT_CYCCNT_REG  (*((volatile uint32_t *)0xE0001004UL))
+
+/* DWT lock access register. The Cortex-M7 ignores DWT writes from
+ * software until the key is written; the Cortex-M4 has no lock */
+#define CYCLE_COUNTER_DWT_LAR_REG     (*((volatile uint32_t *)0xE0001FB0UL))
+#define CYCLE_COUNTER_DWT_LAR_KEY     0xC5ACCE55UL
+
+/******************************************************************************
+ *  INLINE FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Enables the trace block and starts the DWT cycle counter
+ *               from zero. Safe to call more than once: a counter that
+ *               already runs is left alone, so a stamp taken at boot
+ *               stays comparable with later readings.
+ */
+static inline void cycleCounterInit(void)
+{
+    CYCLE_COUNTER_DEMCR_REG      |= CYCLE_COUNTER_DEMCR_TRCENA;
+#if (MLFQ_BOARD == MLFQ_BOARD_CORTEX_M7)
+    CYCLE_COUNTER_DWT_LAR_REG     = CYCLE_COUNTER_DWT_LAR_KEY;
+#endif
+    if ((CYCLE_COUNTER_DWT_CTRL_REG & CYCLE_COUNTER_DWT_CYCCNTENA) == 0U)
+    {
+        CYCLE_COUNTER_DWT_CYCCNT_REG  = 0U;
+        CYCLE_COUNTER_DWT_CTRL_REG   |= CYCLE_COUNTER_DWT_CYCCNTENA;
+    }
+}
+
+/*
+ * Description : Returns the current core cycle count. Differences between
+ *               two readings are wrap-safe in unsigned 32-bit arithmetic.
+ */
+static inline uint32_t cycleCounterGet(void)
+{
+    return CYCLE_COUNTER_DWT_CYCCNT_REG;
+}
+
+/*
+ * Description : Moves the counter forward by time it did not see. The DWT
+ *               is clocked by the core, so it stops in WFI sleep; after a
+ *               tickless sleep the slept ticks are added back here so
+ *               cycle stamps taken across the sleep stay wall-clock.
+ */
+static inline void cycleCounterAdvance(uint32_t cycles)
+{
+    CYCLE_COUNTER_DWT_CYCCNT_REG += cycles;
+}
+
+#endif /* MLFQ_HOST_SIM */
+
+#endif /* CYCLE_COUNTER_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
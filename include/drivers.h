@@ -2,7 +2,10 @@
  *  MODULE NAME  : Tiva-C Driver Layer Header
  *  FILE         : drivers.h
  *  DESCRIPTION  : Header file for UART, GPIO, LED control functions
- *                 and logging for Tiva-C platform.
+ *                 and logging for Tiva-C platform. The scheduler reaches
+ *                 the hardware only through this interface: drivers.c
+ *                 implements it for the TM4C123 and drivers_cm7.c for
+ *                 the Cortex-M7 board (MLFQ_BOARD, board.h).
  *  AUTHOR       : Omar Ashraf
  *  Date         : December 2025
  ******************************************************************************/
@@ -14,23 +17,454 @@
  *  INCLUDES
  ******************************************************************************/
 #include "scheduler.h"  /* Include scheduler definitions for MLFQ_QueueLevel_t */
+#include "board.h"      /* MLFQ_BOARD */
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Size of the UART0 transmit ring buffer in bytes (must be a power of two) */
+#ifndef LOG_TX_BUFFER_SIZE
+#define LOG_TX_BUFFER_SIZE          1024U
+#endif
+
+#if ((LOG_TX_BUFFER_SIZE & (LOG_TX_BUFFER_SIZE - 1U)) != 0U)
+#error "LOG_TX_BUFFER_SIZE must be a power of two"
+#endif
+
+/* Sends log buffers with uDMA (double-buffered) instead of the TX FIFO ISR */
+#ifndef LOG_TX_DMA_ENABLED
+#define LOG_TX_DMA_ENABLED          0U
+#endif
+
+/* Size of each of the two uDMA transmit buffers (uDMA limit is 1024) */
+#ifndef LOG_TX_DMA_BUFFER_SIZE
+#define LOG_TX_DMA_BUFFER_SIZE      512U
+#endif
+
+#if (LOG_TX_DMA_BUFFER_SIZE > 1024U)
+#error "LOG_TX_DMA_BUFFER_SIZE exceeds the uDMA transfer limit"
+#endif
+
+/* 1U = sendLogAsync() sends from the caller's buffer on UART0, through
+ * the TX interrupt or uDMA, instead of copying it into the ring */
+#ifndef LOG_TX_ASYNC_ENABLED
+#define LOG_TX_ASYNC_ENABLED        0U
+#endif
+
+/* Size of the UART0 receive ring buffer in bytes (must be a power of two) */
+#ifndef LOG_RX_BUFFER_SIZE
+#define LOG_RX_BUFFER_SIZE          64U
+#endif
+
+#if ((LOG_RX_BUFFER_SIZE & (LOG_RX_BUFFER_SIZE - 1U)) != 0U)
+#error "LOG_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+/* Size of the UART1 echo receive ring buffer in bytes (must be a power of two) */
+#ifndef ECHO_RX_BUFFER_SIZE
+#define ECHO_RX_BUFFER_SIZE         16U
+#endif
+
+#if ((ECHO_RX_BUFFER_SIZE & (ECHO_RX_BUFFER_SIZE - 1U)) != 0U)
+#error "ECHO_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+/* LaunchPad user switches on Port F, active low */
+#define BUTTON_PIN_SW1              0x10U   /* PF4 */
+#define BUTTON_PIN_SW2              0x01U   /* PF0 */
+
+/* Switch bounce: edges on a pin closer than this to the last one taken
+ * there are ignored */
+#ifndef BUTTON_DEBOUNCE_MS
+#define BUTTON_DEBOUNCE_MS          20U
+#endif
+
+/* Presses held for the handler task (must be a power of two) */
+#ifndef BUTTON_EVENT_BUFFER_SIZE
+#define BUTTON_EVENT_BUFFER_SIZE    8U
+#endif
+
+#if ((BUTTON_EVENT_BUFFER_SIZE & (BUTTON_EVENT_BUFFER_SIZE - 1U)) != 0U)
+#error "BUTTON_EVENT_BUFFER_SIZE must be a power of two"
+#endif
+
+/* Overflow policies applied by sendLog() when the ring buffer is full */
+#define LOG_OVERFLOW_DROP_NEW       0U  /* Discard the bytes that do not fit */
+#define LOG_OVERFLOW_DROP_OLD       1U  /* Overwrite the oldest queued bytes */
+#define LOG_OVERFLOW_BLOCK          2U  /* Wait for space, up to a timeout */
+
+#ifndef LOG_TX_OVERFLOW_POLICY
+#define LOG_TX_OVERFLOW_POLICY      LOG_OVERFLOW_DROP_NEW
+#endif
+
+/* Longest time sendLog() may wait for space under LOG_OVERFLOW_BLOCK */
+#ifndef LOG_TX_BLOCK_TIMEOUT_MS
+#define LOG_TX_BLOCK_TIMEOUT_MS     20U
+#endif
+
+/* Output channels. Each is routed to one sink (LOG_ROUTE_x below);
+ * channels on the same sink share its stream, except on the ITM sink,
+ * where each goes to its own stimulus port so the host can split them */
+#define LOG_CHANNEL_REPORT          0U  /* Reports, events, binary telemetry */
+#define LOG_CHANNEL_TRACE           1U  /* Event and heap trace dumps */
+#define LOG_CHANNEL_CSV             2U  /* Test and benchmark CSV rows */
+#define LOG_CHANNEL_CONSOLE         3U  /* Console replies */
+
+/* Log sinks. Each has its own buffer and drop counter, so a full or slow
+ * sink never holds up a channel routed elsewhere */
+#define LOG_SINK_UART0              0U  /* UART0 ring (or uDMA) buffer */
+#define LOG_SINK_UART1              1U  /* UART1 (PC5 TX) at LOG_UART1_BAUD */
+#define LOG_SINK_ITM                2U  /* ITM stimulus ports over SWO */
+#define LOG_SINK_RAM                3U  /* RAM ring for the debugger (g_logRam) */
+#define LOG_SINK_COUNT              4U
+
+/* Sends log output to ITM stimulus ports over SWO instead of UART0.
+ * UART0 still receives console input */
+#ifndef LOG_ITM_ENABLED
+#define LOG_ITM_ENABLED             0U
+#endif
+
+/* Stimulus port of each channel (0 to 31) */
+#ifndef LOG_ITM_PORT_REPORT
+#define LOG_ITM_PORT_REPORT         0U
+#endif
+
+#ifndef LOG_ITM_PORT_TRACE
+#define LOG_ITM_PORT_TRACE          1U
+#endif
+
+#ifndef LOG_ITM_PORT_CSV
+#define LOG_ITM_PORT_CSV            2U
+#endif
+
+#ifndef LOG_ITM_PORT_CONSOLE
+#define LOG_ITM_PORT_CONSOLE        3U
+#endif
+
+#if (LOG_ITM_PORT_REPORT > 31U) || (LOG_ITM_PORT_TRACE > 31U) || \
+    (LOG_ITM_PORT_CSV > 31U) || (LOG_ITM_PORT_CONSOLE > 31U)
+#error "ITM stimulus ports run from 0 to 31"
+#endif
+
+/* Sink of each channel. The console stays on UART0, where its input
+ * arrives; the others follow LOG_ITM_ENABLED unless routed explicitly */
+#if (LOG_ITM_ENABLED == 1U)
+#define LOG_SINK_DEFAULT            LOG_SINK_ITM
+#else
+#define LOG_SINK_DEFAULT            LOG_SINK_UART0
+#endif
+
+#ifndef LOG_ROUTE_REPORT
+#define LOG_ROUTE_REPORT            LOG_SINK_DEFAULT
+#endif
+
+#ifndef LOG_ROUTE_TRACE
+#define LOG_ROUTE_TRACE             LOG_SINK_DEFAULT
+#endif
+
+#ifndef LOG_ROUTE_CSV
+#define LOG_ROUTE_CSV               LOG_SINK_DEFAULT
+#endif
+
+#ifndef LOG_ROUTE_CONSOLE
+#define LOG_ROUTE_CONSOLE           LOG_SINK_UART0
+#endif
+
+/* 1 when at least one channel is routed to the sink */
+#define LOG_SINK_USED(sink)         ((LOG_ROUTE_REPORT == (sink)) || (LOG_ROUTE_TRACE == (sink)) || \
+                                     (LOG_ROUTE_CSV == (sink)) || (LOG_ROUTE_CONSOLE == (sink)))
+
+#if (LOG_ROUTE_REPORT >= LOG_SINK_COUNT) || (LOG_ROUTE_TRACE >= LOG_SINK_COUNT) || \
+    (LOG_ROUTE_CSV >= LOG_SINK_COUNT) || (LOG_ROUTE_CONSOLE >= LOG_SINK_COUNT)
+#error "LOG_ROUTE_x must name a LOG_SINK_x"
+#endif
+
+#if LOG_SINK_USED(LOG_SINK_ITM) && (LOG_ITM_ENABLED == 0U)
+#error "Routing a channel to LOG_SINK_ITM needs LOG_ITM_ENABLED"
+#endif
+
+/* UART1 sink: bit rate and transmit ring size (a power of two). UART1 is
+ * then taken, so the echo workload cannot run */
+#ifndef LOG_UART1_BAUD
+#define LOG_UART1_BAUD              921600U
+#endif
+
+#ifndef LOG_UART1_BUFFER_SIZE
+#define LOG_UART1_BUFFER_SIZE       1024U
+#endif
+
+#if ((LOG_UART1_BUFFER_SIZE & (LOG_UART1_BUFFER_SIZE - 1U)) != 0U)
+#error "LOG_UART1_BUFFER_SIZE must be a power of two"
+#endif
+
+/* RAM sink size (a power of two); the oldest bytes are overwritten */
+#ifndef LOG_RAM_BUFFER_SIZE
+#define LOG_RAM_BUFFER_SIZE         2048U
+#endif
+
+#if ((LOG_RAM_BUFFER_SIZE & (LOG_RAM_BUFFER_SIZE - 1U)) != 0U)
+#error "LOG_RAM_BUFFER_SIZE must be a power of two"
+#endif
+
+/* SWO bit rate (NRZ) set up by the firmware. 0 leaves the TPIU and the
+ * ITM to the debug probe, which then decides which ports are enabled */
+#ifndef LOG_ITM_SWO_BAUD
+#define LOG_ITM_SWO_BAUD            2000000U
+#endif
+
+/* SysCtlClockSet() setting applied by initClock(): 80 MHz from the PLL
+ * (400 MHz / 2 / 2.5) using the LaunchPad's 16 MHz crystal */
+#ifndef SYSTEM_CLOCK_CONFIG
+#define SYSTEM_CLOCK_CONFIG         (SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | \
+                                     SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN)
+#endif
+
+/* SysCtlClockSet() setting of the slow clock (MLFQ_CLOCK_SCALING_ENABLED):
+ * 20 MHz from the same PLL (400 MHz / 2 / 10), so only the divider
+ * changes and the PLL stays powered between the two */
+#ifndef SYSTEM_CLOCK_SLOW_CONFIG
+#define SYSTEM_CLOCK_SLOW_CONFIG    (SYSCTL_SYSDIV_10 | SYSCTL_USE_PLL | \
+                                     SYSCTL_XTAL_16MHZ | SYSCTL_OSC_MAIN)
+#endif
+
+/* MLFQ_BOARD_CORTEX_M7: core clock set by the board's SystemInit(), and
+ * the APB1 clock behind USART3 (log) and TIM2/TIM5 (quantum and run-time
+ * timers), which run at twice APB1 */
+#ifndef CM7_CPU_CLOCK_HZ
+#define CM7_CPU_CLOCK_HZ            216000000UL
+#endif
+
+#ifndef CM7_APB1_CLOCK_HZ
+#define CM7_APB1_CLOCK_HZ           54000000UL
+#endif
+
+/* With configUSE_IDLE_HOOK, 1U lets the idle hook deep-sleep the core
+ * (SysCtlDeepSleep) once the log output has drained; 0U only sleeps */
+#ifndef IDLE_DEEP_SLEEP_ENABLED
+#define IDLE_DEEP_SLEEP_ENABLED     0U
+#endif
+
+/* Clock the core and SysTick run from in deep sleep: the main oscillator,
+ * as DSLPCLKCFG selects out of reset */
+#ifndef IDLE_DEEP_SLEEP_CLOCK_HZ
+#define IDLE_DEEP_SLEEP_CLOCK_HZ    16000000U
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/* Called from the latency timer interrupt with the core cycles between the
+ * timer's timeout and the handler reading the counter */
+typedef void (*LatencyTimerHook_t)(uint32_t lateCycles);
+
+/* Called once an asynchronous send no longer needs its buffer, from the
+ * UART0 interrupt (so FromISR APIs only), with the context passed in */
+typedef void (*LogAsyncDone_t)(void *context, BaseType_t *pxHigherPriorityTaskWoken);
 
 /******************************************************************************
  *  FUNCTION PROTOTYPES
  ******************************************************************************/
 
-/* Description : Initializes UART0 peripheral with 115200 baud, 8N1 settings */
+/* Description : Switches the core to the PLL and records the resulting clock
+ *               in configCPU_CLOCK_HZ. Must be the first call in main() */
+void initClock(void);
+
+/* Description : Moves the core to SYSTEM_CLOCK_SLOW_CONFIG or back to
+ *               SYSTEM_CLOCK_CONFIG and re-derives the kernel tick and the
+ *               UART and SWO bit rates from the new clock. Returns the
+ *               clock now in configCPU_CLOCK_HZ */
+uint32_t setClockSlow(bool slow);
+
+/* Description : Initializes UART0 peripheral with 115200 baud, 8N1 settings,
+ *               and the ITM when LOG_ITM_ENABLED is set */
 void initUART(void);
 
 /* Description : Initializes GPIO Port F pins as output and turns LEDs off */
 void initGPIO(void);
 
-/* Description : Sends a null-terminated string over UART0 for logging */
-void sendLog(const char *message);
+/* Description : Queues a null-terminated string for interrupt-driven UART0
+ *               transmission. Returns the number of bytes queued; bytes
+ *               that did not fit are counted by getLogDroppedBytes() */
+uint32_t sendLog(const char *message);
+
+/* Description : Queues a block of bytes (text or binary) for UART0 transmission.
+ *               Returns the number of bytes queued */
+uint32_t sendLogBytes(const void *data, uint32_t length);
+
+/* Description : Sends a block of bytes on one LOG_CHANNEL_*. sendLogBytes()
+ *               is the report channel. Returns the number of bytes sent */
+uint32_t sendLogChannel(uint32_t channel, const void *data, uint32_t length);
+
+/* Description : Sends a buffer on the report channel without copying it.
+ *               It goes out after the bytes already queued; done runs
+ *               when the buffer may be reused. Returns false, sending
+ *               nothing, while an earlier one is still in flight.
+ *               Without LOG_TX_ASYNC_ENABLED, or when the report channel
+ *               is not on UART0, the bytes are queued as by
+ *               sendLogBytes() and done runs before it returns */
+bool sendLogAsync(const void *data, uint32_t length, LogAsyncDone_t done, void *context);
+
+/* Description : Returns the number of bytes sendLogBytes() can queue right now */
+uint32_t getLogTxFree(void);
+
+/* Description : Returns the number of bytes one LOG_CHANNEL_* can queue right now */
+uint32_t getLogChannelFree(uint32_t channel);
+
+/* Description : Enables the uDMA controller and its control table (idempotent) */
+void initDMA(void);
+
+/* Description : Sets up the uDMA software channel for memory-to-memory
+ *               copies. notifyTask gets xTaskNotifyGive from the
+ *               completion interrupt of every copy */
+void initDmaCopy(TaskHandle_t notifyTask);
+
+/* Description : Starts copying 'words' 32-bit words (1 .. 1024) on the
+ *               software channel and returns at once. Start the next
+ *               copy only after the notification of this one */
+void startDmaCopy(uint32_t *destination, const uint32_t *source, uint32_t words);
+
+/* Description : uDMA software transfer interrupt handler (copy done) */
+void uDMASoftwareIntHandler(void);
+
+/* Description : Returns the total number of log bytes dropped on overflow */
+uint32_t getLogDroppedBytes(void);
+
+/* Description : Returns the log bytes one LOG_SINK_* dropped on overflow */
+uint32_t getLogSinkDroppedBytes(uint32_t sink);
+
+/* Description : Returns the total number of log bytes queued on any channel
+ *               (wraps; take differences) */
+uint32_t getLogQueuedBytes(void);
+
+/* Description : Copies up to maxLength received bytes out of the receive
+ *               ring buffer. Returns the number of bytes copied */
+uint32_t receiveBytes(uint8_t *buffer, uint32_t maxLength);
+
+/* Description : Sets the task notified (xTaskNotifyGive) when bytes arrive */
+void setRxNotifyTask(TaskHandle_t task);
+
+/* Description : Returns the number of received bytes lost to a full buffer */
+uint32_t getRxDroppedBytes(void);
+
+/* Description : UART0 interrupt handler (drains the transmit ring buffer
+ *               and fills the receive ring buffer) */
+void UART0IntHandler(void);
+
+/* Description : Initializes UART1 (PC4 = RX, PC5 = TX) 8N1 for the echo
+ *               workload, with the FIFOs off so every byte raises its
+ *               own receive interrupt. notifyTask gets xTaskNotifyGive
+ *               from the handler */
+void initEchoUART(uint32_t baud, TaskHandle_t notifyTask);
+
+/* Description : Copies up to maxLength received bytes out of the echo
+ *               buffer, with the cycle count at which the handler took
+ *               each one. Returns the number of bytes copied */
+uint32_t receiveEchoBytes(uint8_t *bytes, uint32_t *stampCycles, uint32_t maxLength);
+
+/* Description : Sends one byte on UART1, waiting while the transmitter
+ *               is busy */
+void sendEchoByte(uint8_t byte);
+
+/* Description : Returns the number of echo bytes lost to a full buffer */
+uint32_t getEchoDroppedBytes(void);
+
+/* Description : UART1 interrupt handler (fills the echo receive buffer) */
+void UART1IntHandler(void);
+
+/* Description : Samples the internal temperature sensor at sampleHz on
+ *               ADC0 sequencer 3 (Timer 3A trigger), by uDMA ping-pong
+ *               into the two halves of buffer, halfSamples (1 .. 1024)
+ *               each. notifyTask gets xTaskNotifyGive as each half fills */
+void initAdcSampling(uint32_t sampleHz, uint16_t *buffer, uint32_t halfSamples,
+                     TaskHandle_t notifyTask);
+
+/* Description : Takes the oldest full half: its index (0 or 1) and the
+ *               cycle count at which it filled. Returns false when none
+ *               is waiting. The half is refilled one half-period after it
+ *               filled, so it must be processed by then */
+bool takeAdcHalf(uint32_t *half, uint32_t *stampCycles);
+
+/* Description : Returns the number of halves refilled before being taken */
+uint32_t getAdcOverruns(void);
+
+/* Description : ADC0 sequencer 3 interrupt handler (a uDMA half is full) */
+void ADC0SS3IntHandler(void);
+
+/* Description : Sets up SW1 (PF4) and SW2 (PF0) as inputs with pull-ups
+ *               and falling-edge interrupts. notifyTask gets
+ *               xTaskNotifyGive for every press taken */
+void initButtons(TaskHandle_t notifyTask);
+
+/* Description : Takes the oldest press: its pin (BUTTON_PIN_*) and the
+ *               cycle count at which the interrupt saw it. Returns false
+ *               when none is waiting */
+bool takeButtonEvent(uint32_t *pin, uint32_t *stampCycles);
+
+/* Description : Returns the number of presses lost to a full buffer */
+uint32_t getButtonDroppedEvents(void);
+
+/* Description : GPIO Port F interrupt handler (user switch edges) */
+void GPIOFIntHandler(void);
 
 /* Description : Sets RGB LED color based on MLFQ queue level */
 void setLEDColor(MLFQ_QueueLevel_t queueLevel);
 
+/* Description : Disables one interrupt at the NVIC. 'irq' is numbered as
+ *               the board's library does: INT_x of TivaWare on the
+ *               TM4C123, the IRQ number on the Cortex-M7 */
+void maskIrq(uint32_t irq);
+
+/* Description : Enables an interrupt disabled by maskIrq() again */
+void unmaskIrq(uint32_t irq);
+
+/* Description : Configures the GPTM one-shot timer used for quantum enforcement */
+void initQuantumTimer(void);
+
+/* Description : Starts the quantum timer to fire after the given core cycles */
+void armQuantumTimer(uint32_t cycles);
+
+/* Description : Stops the quantum timer without firing */
+void disarmQuantumTimer(void);
+
+/* Description : Timer 0A interrupt handler (quantum timer expiry) */
+void QuantumTimerIntHandler(void);
+
+/* Description : Starts Timer 1A as a periodic interrupt every periodCycles
+ *               core cycles, at configMAX_SYSCALL_INTERRUPT_PRIORITY so
+ *               kernel critical sections hold it off. Each interrupt
+ *               passes its lateness to the hook */
+void initLatencyTimer(uint32_t periodCycles, LatencyTimerHook_t hook);
+
+/* Description : Timer 1A interrupt handler (latency benchmark) */
+void LatencyTimerIntHandler(void);
+
+/* Description : Starts Timer 2A counting up at the CPU clock as the kernel's
+ *               run-time stats base (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS) */
+void initRunTimeTimer(void);
+
+/* Description : Returns the run-time stats counter in core cycles, extended
+ *               to 64 bits. Safe from tasks and interrupts */
+uint64_t getRunTimeCounter(void);
+
+/* Description : Timer 2A interrupt handler (run-time counter wrap) */
+void RunTimeTimerIntHandler(void);
+
+/* Description : Starts watchdog timer 0 so the device resets timeoutMs
+ *               after the last feedWatchdog() call */
+void initWatchdog(uint32_t timeoutMs);
+
+/* Description : Restarts the watchdog countdown */
+void feedWatchdog(void);
+
+/* Description : Watchdog 0 interrupt handler (first timeout) */
+void WatchdogIntHandler(void);
+
+/* Description : Returns true when the last reset came from watchdog 0.
+ *               Clears the reset causes, so the next boot sees only its own */
+bool takeWatchdogReset(void);
+
 #endif /* DRIVERS_H */
 
 /******************************************************************************
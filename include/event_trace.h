@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  MODULE NAME  : Event Trace
+ *  FILE         : event_trace.h
+ *  DESCRIPTION  : Fixed-size circular trace of scheduler events (quantum
+ *                 expiry, level changes, boosts, context switches, block
+ *                 and unblock), stamped with the DWT cycle counter.
+ *                 Included from trace_hooks.h, so it must not pull in any
+ *                 FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef EVENT_TRACE_H_
+#define EVENT_TRACE_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Always-on event trace; set to 0U to compile every hook out */
+#ifndef EVENT_TRACE_ENABLED
+#define EVENT_TRACE_ENABLED          1U
+#endif
+
+/* Number of entries kept (must be a power of two) */
+#ifndef EVENT_TRACE_LENGTH
+#define EVENT_TRACE_LENGTH           256U
+#endif
+
+#if ((EVENT_TRACE_LENGTH & (EVENT_TRACE_LENGTH - 1U)) != 0U)
+#error "EVENT_TRACE_LENGTH must be a power of two"
+#endif
+
+/* Event identifiers (keep in sync with tools/trace_decode.py) */
+#define EVENT_TRACE_QUANTUM_EXPIRY   1U   /* arg0 = level */
+#define EVENT_TRACE_DEMOTION         2U   /* arg0 = from, arg1 = to */
+#define EVENT_TRACE_PROMOTION        3U   /* arg0 = from, arg1 = to */
+#define EVENT_TRACE_BOOST_START      4U
+#define EVENT_TRACE_BOOST_END        5U
+#define EVENT_TRACE_SWITCH_IN        6U
+#define EVENT_TRACE_SWITCH_OUT       7U
+#define EVENT_TRACE_BLOCK            8U   /* arg0 = EVENT_TRACE_BLOCK_x */
+#define EVENT_TRACE_UNBLOCK          9U   /* Task moved to the ready list */
+#define EVENT_TRACE_TIMER_OVERRUN    10U  /* arg0 = timer stats entry, arg1 = ms */
+
+/* Reasons recorded with EVENT_TRACE_BLOCK */
+#define EVENT_TRACE_BLOCK_DELAY      0U
+#define EVENT_TRACE_BLOCK_QUEUE_RX   1U
+#define EVENT_TRACE_BLOCK_QUEUE_TX   2U
+#define EVENT_TRACE_BLOCK_NOTIFY     3U
+#define EVENT_TRACE_BLOCK_EVENTS     4U
+
+/* Slot recorded for tasks that are not in the profiler table */
+#define EVENT_TRACE_NO_SLOT          0xFFU
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : One trace entry (12 bytes).
+ */
+typedef struct
+{
+    uint32_t timestamp;  /* DWT cycle count */
+    uint32_t task;       /* Task handle (address), 0 if none */
+    uint8_t  event;      /* EVENT_TRACE_x */
+    uint8_t  slot;       /* Profiler slot or EVENT_TRACE_NO_SLOT */
+    uint8_t  arg0;
+    uint8_t  arg1;
+} EventTraceEntry_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (EVENT_TRACE_ENABLED == 1U)
+/* Description : Appends an event for a task. Safe from ISR and task context */
+void eventTraceRecord(uint8_t event, void *task, uint8_t arg0, uint8_t arg1);
+
+/* Description : Appends an event for the currently running task */
+void eventTraceRecordCurrent(uint8_t event, uint8_t arg0);
+
+/* Description : Pauses recording, prints the trace over UART for
+ *               tools/trace_decode.py, then resumes recording */
+void eventTraceDump(void);
+
+/* Description : Copies an entry, oldest first. Returns false past the end */
+bool eventTraceGetEntry(uint32_t index, EventTraceEntry_t *output);
+#endif
+
+#endif /* EVENT_TRACE_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *  MODULE NAME  : Flash History Log
+ *  FILE         : flash_log.h
+ *  DESCRIPTION  : Appends a low-rate summary of the scheduler to a ring of
+ *                 erase blocks in on-chip flash, so an unattended board
+ *                 keeps weeks of history without external storage.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef FLASH_LOG_H_
+#define FLASH_LOG_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "metrics_logger.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* 1 = the logger task appends a summary record every FLASH_LOG_PERIOD_S */
+#ifndef FLASH_LOG_ENABLED
+#define FLASH_LOG_ENABLED            0U
+#endif
+
+/* Seconds between records (3600 fills the default region in 21 days) */
+#ifndef FLASH_LOG_PERIOD_S
+#define FLASH_LOG_PERIOD_S           3600U
+#endif
+
+/* Reserved region; must match FLASHLOG in tm4c123gh6pm.cmd */
+#define FLASH_LOG_BASE               0x00038000UL
+#define FLASH_LOG_BLOCK_SIZE         1024U          /* TM4C123 erase block */
+#ifndef FLASH_LOG_BLOCKS
+#define FLASH_LOG_BLOCKS             32U
+#endif
+
+/* Bytes per record: whole words, dividing the erase block */
+#define FLASH_LOG_RECORD_SIZE        ((MLFQ_NUM_LEVELS <= 6U) ? 64U : 128U)
+
+#if (FLASH_LOG_ENABLED == 1U)
+#if (METRICS_REPORT_ENABLED == 0U)
+#error "FLASH_LOG_ENABLED needs the logger task (METRICS_REPORT_ENABLED)"
+#endif
+#if (FLASH_LOG_BLOCKS < 2U) || ((FLASH_LOG_BLOCKS * FLASH_LOG_BLOCK_SIZE) > 0x8000U)
+#error "FLASH_LOG_BLOCKS must be 2..32 (the FLASHLOG region is 32 KB)"
+#endif
+#if (FLASH_LOG_PERIOD_S == 0U)
+#error "FLASH_LOG_PERIOD_S must be at least 1"
+#endif
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : One summary record. Counts cover the period since the
+ *               previous record; latencies cover the time since boot.
+ */
+typedef struct
+{
+    uint32_t sequence;                        /* Runs on across boots */
+    uint32_t uptime_s;                        /* Since boot */
+    uint32_t demotions;
+    uint32_t boosts;
+    uint32_t overloads;                       /* Overload alarms raised */
+    uint16_t idle_permille;                   /* Idle share of the CPU */
+    uint16_t level_permille[MLFQ_NUM_LEVELS]; /* CPU share of each level */
+    uint16_t p50_us[MLFQ_NUM_LEVELS];         /* Wake-to-run latency */
+    uint16_t p99_us[MLFQ_NUM_LEVELS];
+    uint16_t crc;                             /* Crc16 of every preceding byte */
+} FlashLogRecord_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (FLASH_LOG_ENABLED == 1U)
+/* Description : Finds the newest record and the next free slot. Called by
+ *               the logger task as it starts */
+void flashLogInit(void);
+
+/* Description : Appends a record when one is due. Logger task only.
+ *               Returns the ticks until the next one */
+TickType_t flashLogService(void);
+
+/* Description : Number of record slots in the region */
+uint32_t flashLogGetSlotCount(void);
+
+/* Description : Copies the record in slot 'index', counted from the oldest
+ *               position of the ring. Returns false for an empty or
+ *               damaged slot */
+bool flashLogGetRecord(uint32_t index, FlashLogRecord_t *output);
+#endif
+
+#endif /* FLASH_LOG_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
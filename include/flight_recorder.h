@@ -0,0 +1,92 @@
+/******************************************************************************
+ *  MODULE NAME  : Flight Recorder
+ *  FILE         : flight_recorder.h
+ *  DESCRIPTION  : Keeps the newest scheduler events and the latest stats
+ *                 snapshot in RAM that the startup code does not clear,
+ *                 so a fault or watchdog reset can be analysed on the
+ *                 next boot. Included from the startup file, so it must
+ *                 not pull in any FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef FLIGHT_RECORDER_H_
+#define FLIGHT_RECORDER_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+
+/* Event trace configuration and event identifiers */
+#include "event_trace.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* 1 = copy every trace event and report snapshot into the retained RAM
+ * section .noinit, and dump the previous boot's copy from main() */
+#ifndef FLIGHT_RECORDER_ENABLED
+#define FLIGHT_RECORDER_ENABLED      0U
+#endif
+
+/* Number of events kept (must be a power of two) */
+#ifndef FLIGHT_RECORDER_EVENTS
+#define FLIGHT_RECORDER_EVENTS       64U
+#endif
+
+#if ((FLIGHT_RECORDER_EVENTS & (FLIGHT_RECORDER_EVENTS - 1U)) != 0U)
+#error "FLIGHT_RECORDER_EVENTS must be a power of two"
+#endif
+
+#if (FLIGHT_RECORDER_ENABLED == 1U) && (EVENT_TRACE_ENABLED == 0U)
+#error "FLIGHT_RECORDER_ENABLED needs EVENT_TRACE_ENABLED"
+#endif
+
+/* Why the event log was sealed (0 = it was not) */
+#define FLIGHT_RECORDER_CAUSE_NONE      0U
+#define FLIGHT_RECORDER_CAUSE_NMI       1U
+#define FLIGHT_RECORDER_CAUSE_FAULT     2U   /* Hard fault */
+#define FLIGHT_RECORDER_CAUSE_UNHANDLED 3U   /* IntDefaultHandler */
+#define FLIGHT_RECORDER_CAUSE_WATCHDOG  4U   /* First watchdog timeout */
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+/* Description : Prints what the previous boot left behind, then starts a
+ *               fresh record. Call from main() after initUART() and before
+ *               the first kernel call */
+void flightRecorderInit(void);
+
+/* Description : Appends an event. Safe from ISR and task context */
+void flightRecorderEvent(uint8_t event, void *task, uint8_t slot,
+                         uint8_t arg0, uint8_t arg1);
+
+/* Description : Starts a stats snapshot taken at 'tick' */
+void flightRecorderSnapshotBegin(uint32_t tick);
+
+/* Description : Adds the row of one profiler slot to the snapshot */
+void flightRecorderSnapshotRow(uint32_t slot, uint32_t level, uint32_t runTicks,
+                               uint32_t quantumTicks, uint32_t waitTicks);
+
+/* Description : Seals the snapshot with its CRC */
+void flightRecorderSnapshotEnd(void);
+
+/* Description : Stops recording and seals the events with their CRC.
+ *               Uses no kernel service, so it is safe from fault handlers */
+void flightRecorderSeal(uint32_t cause);
+
+/* Description : Drops a watchdog seal after a late feed and resumes
+ *               recording. A seal for any other cause is kept */
+void flightRecorderResume(void);
+#endif
+
+#endif /* FLIGHT_RECORDER_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
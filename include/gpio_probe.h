@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  MODULE NAME  : GPIO Timing Probes
+ *  FILE         : gpio_probe.h
+ *  DESCRIPTION  : Spare Port B pins driven at scheduler events for a logic
+ *                 analyzer: tick hook, supervisor pass, demotion and boost
+ *                 as single pins, and the level of the running task as a
+ *                 small bus. Each edge is one store through the GPIO DATA
+ *                 bit-mask alias on the AHB aperture. Included from
+ *                 trace_hooks.h, so it must not pull in any FreeRTOS or
+ *                 TivaWare header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef GPIO_PROBE_H_
+#define GPIO_PROBE_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Timing probes; set to 1U to drive the pins below */
+#ifndef GPIO_PROBE_ENABLED
+#define GPIO_PROBE_ENABLED           0U
+#endif
+
+/* Port the probes use: Port B on the AHB aperture. initGPIO() switches
+ * the port to AHB, so GPIO_PORTB_BASE (APB) must not be used for it */
+#ifndef GPIO_PROBE_PORT_BASE
+#define GPIO_PROBE_PORT_BASE         0x40059000UL
+#endif
+
+/* SysCtl peripheral of the port above; expanded only in drivers.c */
+#ifndef GPIO_PROBE_PERIPH
+#define GPIO_PROBE_PERIPH            SYSCTL_PERIPH_GPIOB
+#endif
+
+/* Pin masks on the port; 0U turns a probe off */
+#ifndef GPIO_PROBE_PIN_TICK
+#define GPIO_PROBE_PIN_TICK          0x01U   /* PB0: high inside the tick hook */
+#endif
+
+#ifndef GPIO_PROBE_PIN_SUPERVISOR
+#define GPIO_PROBE_PIN_SUPERVISOR    0x02U   /* PB1: high while the supervisor is awake */
+#endif
+
+#ifndef GPIO_PROBE_PIN_DEMOTION
+#define GPIO_PROBE_PIN_DEMOTION      0x04U   /* PB2: pulse at each demotion */
+#endif
+
+#ifndef GPIO_PROBE_PIN_BOOST
+#define GPIO_PROBE_PIN_BOOST         0x08U   /* PB3: high during a global boost */
+#endif
+
+/* Level bus: the level of the task switched in plus one, or 0 for a task
+ * outside the MLFQ levels, on GPIO_PROBE_LEVEL_BITS pins starting at
+ * GPIO_PROBE_LEVEL_SHIFT (PB4 to PB7 by default). 0 bits turns it off */
+#ifndef GPIO_PROBE_LEVEL_SHIFT
+#define GPIO_PROBE_LEVEL_SHIFT       4U
+#endif
+
+#ifndef GPIO_PROBE_LEVEL_BITS
+#define GPIO_PROBE_LEVEL_BITS        4U
+#endif
+
+#define GPIO_PROBE_PIN_LEVEL         (((1U << GPIO_PROBE_LEVEL_BITS) - 1U) << GPIO_PROBE_LEVEL_SHIFT)
+
+/* Every pin the probes drive */
+#define GPIO_PROBE_PINS              (GPIO_PROBE_PIN_TICK | GPIO_PROBE_PIN_SUPERVISOR | \
+                                      GPIO_PROBE_PIN_DEMOTION | GPIO_PROBE_PIN_BOOST | \
+                                      GPIO_PROBE_PIN_LEVEL)
+
+#if (GPIO_PROBE_PINS > 0xFFU)
+#error "GPIO probe pins must lie within one 8-pin port"
+#endif
+
+#if ((GPIO_PROBE_PIN_TICK & GPIO_PROBE_PIN_SUPERVISOR) != 0U) || \
+    (((GPIO_PROBE_PIN_TICK | GPIO_PROBE_PIN_SUPERVISOR) & GPIO_PROBE_PIN_DEMOTION) != 0U) || \
+    (((GPIO_PROBE_PIN_TICK | GPIO_PROBE_PIN_SUPERVISOR | GPIO_PROBE_PIN_DEMOTION) & \
+      GPIO_PROBE_PIN_BOOST) != 0U) || \
+    (((GPIO_PROBE_PIN_TICK | GPIO_PROBE_PIN_SUPERVISOR | GPIO_PROBE_PIN_DEMOTION | \
+       GPIO_PROBE_PIN_BOOST) & GPIO_PROBE_PIN_LEVEL) != 0U)
+#error "GPIO probe pins overlap"
+#endif
+
+/* Data register alias that reads and writes only 'pins' */
+#define GPIO_PROBE_DATA(pins)        (*(volatile uint32_t *)(GPIO_PROBE_PORT_BASE + ((uint32_t)(pins) << 2)))
+
+#if (GPIO_PROBE_ENABLED == 1U)
+/* Drive the pins of one probe; a probe with no pins costs nothing */
+#define GPIO_PROBE_HIGH(pins)        do { if ((pins) != 0U) { GPIO_PROBE_DATA(pins) = 0xFFU; } } while (0)
+#define GPIO_PROBE_LOW(pins)         do { if ((pins) != 0U) { GPIO_PROBE_DATA(pins) = 0U; } } while (0)
+#define GPIO_PROBE_PULSE(pins)       do { GPIO_PROBE_HIGH(pins); GPIO_PROBE_LOW(pins); } while (0)
+#else
+#define GPIO_PROBE_HIGH(pins)
+#define GPIO_PROBE_LOW(pins)
+#define GPIO_PROBE_PULSE(pins)
+#endif
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (GPIO_PROBE_ENABLED == 1U)
+/* Description : Puts the level of a task at this priority on the level
+ *               bus. Called from traceTASK_SWITCHED_IN */
+void gpioProbeTaskSwitchedIn(uint32_t priority);
+#endif
+
+#endif /* GPIO_PROBE_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,130 @@
+/******************************************************************************
+ *  MODULE NAME  : Heap Statistics
+ *  FILE         : heap_stats.h
+ *  DESCRIPTION  : Heap usage for the reports (free, minimum ever free,
+ *                 largest free block, free block count) from heap_4, and
+ *                 an optional circular trace of every pvPortMalloc() and
+ *                 vPortFree() with its call site. Included from
+ *                 trace_hooks.h, so it must not pull in any FreeRTOS
+ *                 header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef HEAP_STATS_H_
+#define HEAP_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Heap figures in every report; needs heap_4 or heap_5 (vPortGetHeapStats) */
+#ifndef HEAP_STATS_ENABLED
+#define HEAP_STATS_ENABLED           1U
+#endif
+
+/* Allocation trace through traceMALLOC/traceFREE; off by default since
+ * it adds a cycle stamp and a buffer write to every allocation */
+#ifndef HEAP_TRACE_ENABLED
+#define HEAP_TRACE_ENABLED           0U
+#endif
+
+/* Number of allocations and frees kept (must be a power of two) */
+#ifndef HEAP_TRACE_LENGTH
+#define HEAP_TRACE_LENGTH            64U
+#endif
+
+#if ((HEAP_TRACE_LENGTH & (HEAP_TRACE_LENGTH - 1U)) != 0U)
+#error "HEAP_TRACE_LENGTH must be a power of two"
+#endif
+
+#if (HEAP_TRACE_ENABLED == 1U) && (HEAP_STATS_ENABLED != 1U)
+#error "HEAP_TRACE_ENABLED needs HEAP_STATS_ENABLED"
+#endif
+
+/* Return address of the allocator, i.e. the call site, as seen from the
+ * hooks that expand inside pvPortMalloc() and vPortFree() */
+#ifndef HEAP_TRACE_CALLER
+#if (HEAP_TRACE_ENABLED == 1U)
+#define HEAP_TRACE_CALLER()          __builtin_return_address(0)
+#else
+#define HEAP_TRACE_CALLER()          ((void *)0)
+#endif
+#endif
+
+/* Operations recorded in the trace */
+#define HEAP_TRACE_ALLOC             0U
+#define HEAP_TRACE_FREE              1U
+#define HEAP_TRACE_FAILED            2U   /* pvPortMalloc() returned NULL */
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Heap figures in bytes. Sizes are heap_4 block sizes, which
+ *               include the block header and alignment padding.
+ */
+typedef struct
+{
+    uint32_t free_bytes;      /* Free now */
+    uint32_t min_free_bytes;  /* Least free since boot */
+    uint32_t largest_block;   /* Largest single allocation possible now */
+    uint32_t free_blocks;     /* Blocks in the free list; grows with fragmentation */
+    uint32_t allocations;     /* Successful pvPortMalloc() calls */
+    uint32_t frees;           /* vPortFree() calls */
+    uint32_t failures;        /* pvPortMalloc() calls that returned NULL */
+} HeapSummary_t;
+
+/*
+ * Description : One trace entry (24 bytes).
+ */
+typedef struct
+{
+    uint32_t timestamp;  /* DWT cycle count */
+    uint32_t task;       /* Calling task handle, 0 before the scheduler starts */
+    uint32_t address;    /* Block returned or freed, 0 on failure */
+    uint32_t caller;     /* Return address into the caller */
+    uint32_t size;       /* Block size in bytes */
+    uint8_t  operation;  /* HEAP_TRACE_x */
+    uint8_t  reserved[3];
+} HeapTraceEntry_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (HEAP_STATS_ENABLED == 1U)
+/* Description : Called from traceMALLOC with the scheduler suspended */
+void heapStatsMalloc(void *address, uint32_t size, void *caller);
+
+/* Description : Called from traceFREE with the scheduler suspended */
+void heapStatsFree(void *address, uint32_t size, void *caller);
+
+/* Description : Reads the current heap figures; walks the free list */
+void heapStatsGet(HeapSummary_t *output);
+#endif
+
+#if (HEAP_TRACE_ENABLED == 1U)
+/* Description : Copies an entry, oldest first. Returns false past the end */
+bool heapTraceGetEntry(uint32_t index, HeapTraceEntry_t *output);
+
+/* Description : Prints the trace over UART; may block on UART space */
+void heapTraceDump(void);
+#endif
+
+#endif /* HEAP_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,85 @@
+/******************************************************************************
+ *  MODULE NAME  : Interactivity Score
+ *  FILE         : interactivity.h
+ *  DESCRIPTION  : FreeBSD ULE style classifier. Keeps decaying per-task
+ *                 totals of run time and sleep time from the context-switch
+ *                 and ready hooks and turns them into a 0..100 score
+ *                 (0 = always sleeping, 100 = never sleeps). Included from
+ *                 trace_hooks.h, so it must not pull in any FreeRTOS header.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef INTERACTIVITY_H_
+#define INTERACTIVITY_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Places tasks on levels by interactivity score instead of one level per
+ * exhausted quantum */
+#ifndef MLFQ_SCORE_CLASSIFIER_ENABLED
+#define MLFQ_SCORE_CLASSIFIER_ENABLED    0U
+#endif
+
+/* History kept: once run + sleep exceed it, both decay by a quarter */
+#ifndef INTERACTIVITY_HISTORY_MS
+#define INTERACTIVITY_HISTORY_MS         5000U
+#endif
+
+/* Share of a vTaskDelay() sleep counted as sleep time, in percent, when
+ * TICK_PROFILER_BLOCK_REASON_ENABLED is set. Waiting on a queue,
+ * semaphore, notification or event group always counts in full, so an
+ * event-driven handler scores as more interactive than a task that polls
+ * and sleeps for the same share of the time */
+#ifndef INTERACTIVITY_DELAY_SLEEP_PERCENT
+#define INTERACTIVITY_DELAY_SLEEP_PERCENT  25U
+#endif
+
+#if (INTERACTIVITY_DELAY_SLEEP_PERCENT > 100U)
+#error "INTERACTIVITY_DELAY_SLEEP_PERCENT must not exceed 100"
+#endif
+
+/* Highest score */
+#define INTERACTIVITY_SCORE_MAX          100U
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+/* Description : Converts the history length to cycles; call after initClock() */
+void interactivityInit(void);
+
+/* Description : Stamps the start of a run */
+void interactivityTaskSwitchedIn(void *task);
+
+/* Description : Charges the run and, for a task that blocked, starts a sleep */
+void interactivityTaskSwitchedOut(void *task, bool stillReady);
+
+/* Description : Ends the sleep of a task moved to a ready list */
+void interactivityTaskReady(void *task);
+
+/* Description : Current score of a profiler slot (50 with no history) */
+uint32_t interactivityGetScore(uint32_t slot);
+
+/* Description : Clears the history of a profiler slot (slot reuse) */
+void interactivityResetTask(uint32_t slot);
+
+/* Description : Gives a slot a history that scores 'score' (warm start) */
+void interactivitySeedTask(uint32_t slot, uint32_t score);
+#endif
+
+#endif /* INTERACTIVITY_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,74 @@
+/******************************************************************************
+ *  MODULE NAME  : Priority Inversion Statistics
+ *  FILE         : inversion_stats.h
+ *  DESCRIPTION  : Measures how long registered tasks run on a priority
+ *                 inherited through a mutex, fed by the kernel inherit and
+ *                 disinherit trace hooks. Included from trace_hooks.h, so
+ *                 it must not pull in any FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef INVERSION_STATS_H_
+#define INVERSION_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Time spent holding an inherited priority; needs configUSE_MUTEXES */
+#ifndef INVERSION_STATS_ENABLED
+#define INVERSION_STATS_ENABLED      1U
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Inversion totals of one task, in core cycles. An episode
+ *               runs from the first inheritance until the task is back on
+ *               its base (MLFQ level) priority.
+ */
+typedef struct
+{
+    uint32_t episodes;
+    uint32_t total_cycles;
+    uint32_t max_cycles;
+} InversionSummary_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (INVERSION_STATS_ENABLED == 1U)
+/* Description : A mutex holder has inherited a waiter's priority */
+void inversionTaskInherited(void *task);
+
+/* Description : A mutex holder has given up some or all of its inherited
+ *               priority; restored is true once it is back on its base */
+void inversionTaskDisinherited(void *task, bool restored);
+
+/* Description : Copies the totals of a profiler slot. An episode still in
+ *               progress is not included until it ends */
+bool inversionGetTaskSummary(uint32_t slot, InversionSummary_t *output);
+
+/* Description : Clears the state of a profiler slot (slot reuse) */
+void inversionResetTask(uint32_t slot);
+#endif
+
+#endif /* INVERSION_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
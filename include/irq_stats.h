@@ -0,0 +1,172 @@
+/******************************************************************************
+ *  MODULE NAME  : Interrupt Statistics
+ *  FILE         : irq_stats.h
+ *  DESCRIPTION  : Cycle-counter accounting of interrupt handlers. Each
+ *                 instrumented ISR is timed from entry to exit less the
+ *                 handlers that nested inside it, per source, and the
+ *                 total is taken out of the interrupted task's quantum so
+ *                 an interrupt storm does not demote whoever was running.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef IRQ_STATS_H_
+#define IRQ_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Kernel types for the storm handler task */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Interrupt time accounting; set to 1U to instrument the handlers */
+#ifndef IRQ_STATS_ENABLED
+#define IRQ_STATS_ENABLED            0U
+#endif
+
+/* Takes interrupt time out of the quantum and CPU time of the task it
+ * interrupted. With 0U the time is only reported */
+#ifndef IRQ_STATS_EXCLUDE_ENABLED
+#define IRQ_STATS_EXCLUDE_ENABLED    1U
+#endif
+
+/* Sources tracked, the built-in ones included */
+#ifndef IRQ_STATS_MAX_SOURCES
+#define IRQ_STATS_MAX_SOURCES        6U
+#endif
+
+/* Deepest nesting of instrumented handlers */
+#ifndef IRQ_STATS_MAX_NESTING
+#define IRQ_STATS_MAX_NESTING        4U
+#endif
+
+/* Built-in sources; application handlers (CAN, ADC, ...) use ids from
+ * IRQ_STATS_FIRST_USER_SOURCE and name them with irqStatsSetName() */
+#define IRQ_STATS_SOURCE_UART0       0U
+#define IRQ_STATS_SOURCE_QUANTUM     1U   /* GPTM quantum timer */
+#define IRQ_STATS_SOURCE_TICK        2U   /* SysTick (IRQ_STATS_TICK_ENABLED) */
+#define IRQ_STATS_FIRST_USER_SOURCE  3U
+
+#if (IRQ_STATS_MAX_SOURCES <= IRQ_STATS_FIRST_USER_SOURCE)
+#error "IRQ_STATS_MAX_SOURCES must leave room past the built-in sources"
+#endif
+
+/* Times the whole tick interrupt, kernel and tick hook together, as
+ * IRQ_STATS_SOURCE_TICK: the TM4C123 vector table points SysTick at
+ * SysTickIntHandler() instead of the kernel's handler. Define it on the
+ * command line so the startup file sees it too. The tick then counts as
+ * interrupt time, so with IRQ_STATS_EXCLUDE_ENABLED it is also kept out
+ * of the tasks' CPU time and quanta */
+#ifndef IRQ_STATS_TICK_ENABLED
+#define IRQ_STATS_TICK_ENABLED       0U
+#endif
+
+#if (IRQ_STATS_TICK_ENABLED == 1U) && (IRQ_STATS_ENABLED == 0U)
+#error "IRQ_STATS_TICK_ENABLED needs IRQ_STATS_ENABLED"
+#endif
+
+/* Storm protection: an application source given a budget that spends
+ * more than it in one window is masked at the NVIC, and its handler task
+ * is notified to do the work at task level, under the MLFQ */
+#ifndef IRQ_STORM_ENABLED
+#define IRQ_STORM_ENABLED            0U
+#endif
+
+/* Length of a budget window */
+#ifndef IRQ_STORM_WINDOW_MS
+#define IRQ_STORM_WINDOW_MS          10U
+#endif
+
+#if (IRQ_STORM_ENABLED == 1U) && (IRQ_STATS_ENABLED == 0U)
+#error "IRQ_STORM_ENABLED needs IRQ_STATS_ENABLED"
+#endif
+
+#if (IRQ_STORM_WINDOW_MS == 0U)
+#error "IRQ_STORM_WINDOW_MS must be at least 1"
+#endif
+
+/* First and last statement of an instrumented handler */
+#if (IRQ_STATS_ENABLED == 1U)
+#define IRQ_STATS_ENTER()            irqStatsEnter()
+#define IRQ_STATS_EXIT(source)       irqStatsExit(source)
+#else
+#define IRQ_STATS_ENTER()
+#define IRQ_STATS_EXIT(source)
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Time spent in one source, excluding nested handlers.
+ */
+typedef struct
+{
+    const char *name;          /* NULL until named */
+    uint32_t    count;         /* Handler runs */
+    uint32_t    max_cycles;    /* Longest single run */
+    uint64_t    total_cycles;  /* All runs since boot */
+    uint32_t    storms;        /* Times masked for overrunning its budget */
+} IrqStats_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (IRQ_STATS_ENABLED == 1U)
+/* Description : Marks handler entry. Call from ISRs at or below
+ *               configMAX_SYSCALL_INTERRUPT_PRIORITY only */
+void irqStatsEnter(void);
+
+/* Description : Marks handler exit and charges the run to 'source' */
+void irqStatsExit(uint32_t source);
+
+/* Description : Names an application source for the reports */
+void irqStatsSetName(uint32_t source, const char *name);
+
+/* Description : Returns the cycles spent in every handler since boot.
+ *               Wraps; callers take differences */
+uint32_t irqStatsGetCycles(void);
+
+/* Description : Copies the figures of a source. Returns false past the
+ *               last one */
+bool irqStatsGet(uint32_t source, IrqStats_t *output);
+#endif
+
+#if (IRQ_STATS_TICK_ENABLED == 1U)
+/* Description : SysTick vector: the kernel's tick handler, timed */
+void SysTickIntHandler(void);
+#endif
+
+#if (IRQ_STORM_ENABLED == 1U)
+/* Description : Gives an application source a budget of budgetUs handler
+ *               time per IRQ_STORM_WINDOW_MS. 'irq' is the interrupt to
+ *               mask (maskIrq(), drivers.h) and 'handler' the task
+ *               notified when it is. A budget of 0 removes it. Returns
+ *               false for a built-in source or one out of range */
+bool irqStormSetBudget(uint32_t source, uint32_t irq, uint32_t budgetUs,
+                       TaskHandle_t handler);
+
+/* Description : True while the source is masked for a storm */
+bool irqStormIsMasked(uint32_t source);
+
+/* Description : Unmasks a source and starts it a fresh window. Called
+ *               by its handler task once the backlog is done */
+void irqStormUnmask(uint32_t source);
+#endif
+
+#endif /* IRQ_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,92 @@
+/******************************************************************************
+ *  MODULE NAME  : Latency Statistics
+ *  FILE         : latency_stats.h
+ *  DESCRIPTION  : Wake-to-run (ready-to-running) latency histograms per task
+ *                 and per MLFQ level, fed by the kernel ready and switch-in
+ *                 trace hooks. Included from trace_hooks.h, so it must not
+ *                 pull in any FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef LATENCY_STATS_H_
+#define LATENCY_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Wake-to-run latency histograms; set to 0U to compile the hooks out */
+#ifndef LATENCY_STATS_ENABLED
+#define LATENCY_STATS_ENABLED        1U
+#endif
+
+/* Log2 buckets: bucket 0 holds 0 cycles, bucket b holds [2^(b-1), 2^b).
+ * The last bucket also collects everything above its range. */
+#ifndef LATENCY_HIST_BUCKETS
+#define LATENCY_HIST_BUCKETS         28U
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Summary of one latency histogram, in core cycles.
+ *               Percentiles report the upper bound of the bucket holding
+ *               that rank, so they never under-state the latency.
+ */
+typedef struct
+{
+    uint32_t samples;
+    uint32_t p50_cycles;
+    uint32_t p99_cycles;
+    uint32_t max_cycles;
+    uint32_t target_cycles;  /* Declared target of a task, 0 if none */
+    uint32_t misses;         /* Samples above target_cycles */
+} LatencySummary_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (LATENCY_STATS_ENABLED == 1U)
+/* Description : Marks whether the task leaving the CPU blocked (it is no
+ *               longer in a ready list) or was only preempted */
+void latencyTaskSwitchedOut(void *task, bool stillReady);
+
+/* Description : Stamps a blocked task that has just been made ready */
+void latencyTaskReady(void *task);
+
+/* Description : Records the latency of a woken task getting the CPU */
+void latencyTaskSwitchedIn(void *task);
+
+/* Description : Summarises the histogram of a profiler slot */
+bool latencyGetTaskSummary(uint32_t slot, LatencySummary_t *output);
+
+/* Description : Summarises the histogram of an MLFQ level */
+bool latencyGetLevelSummary(uint32_t level, LatencySummary_t *output);
+
+/* Description : Sets the latency target of a profiler slot in cycles
+ *               (0 for none) and clears its miss count */
+void latencySetTarget(uint32_t slot, uint32_t targetCycles);
+
+/* Description : Clears the histogram of a profiler slot (slot reuse) */
+void latencyResetTask(uint32_t slot);
+#endif
+
+#endif /* LATENCY_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,73 @@
+/******************************************************************************
+ *  MODULE NAME  : Log Format
+ *  FILE         : log_format.h
+ *  DESCRIPTION  : Fixed-width decimal and hex formatting for the text
+ *                 reports, in place of snprintf(). A line is built in a
+ *                 small caller-owned buffer and queued with one
+ *                 sendLogBytes() call, so lines from different tasks never
+ *                 interleave and no shared buffer is involved.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef LOG_FORMAT_H_
+#define LOG_FORMAT_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : A line being built. The text is always terminated, and
+ *               anything past the buffer is dropped, as with snprintf().
+ */
+typedef struct
+{
+    char     *buffer;
+    uint32_t  size;    /* Buffer size, including the terminator */
+    uint32_t  length;  /* Characters written so far */
+} LogLine_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/* Description : Starts an empty line in 'buffer' (at least one byte) */
+void logLineInit(LogLine_t *line, char *buffer, uint32_t size);
+
+/* Description : Appends a string as is (%s) */
+void logPutText(LogLine_t *line, const char *text);
+
+/* Description : Appends a string padded with spaces to 'width' (%-Ns) */
+void logPutField(LogLine_t *line, const char *text, uint32_t width);
+
+/* Description : Appends a decimal right-aligned in 'width' spaces (%Nlu) */
+void logPutUnsigned(LogLine_t *line, uint32_t value, uint32_t width);
+
+/* Description : Appends a decimal zero-padded to 'digits' (%0Nlu) */
+void logPutUnsignedZero(LogLine_t *line, uint32_t value, uint32_t digits);
+
+/* Description : Appends a signed decimal right-aligned in 'width' (%Nld) */
+void logPutSigned(LogLine_t *line, int32_t value, uint32_t width);
+
+/* Description : Appends lower-case hex zero-padded to 'digits' (%0Nlx) */
+void logPutHex(LogLine_t *line, uint32_t value, uint32_t digits);
+
+/* Description : Queues the line for UART0 and empties it. Returns the
+ *               number of bytes queued */
+uint32_t logLineSend(LogLine_t *line);
+
+/* Description : As logLineSend(), on one LOG_CHANNEL_* */
+uint32_t logLineSendChannel(LogLine_t *line, uint32_t channel);
+
+#endif /* LOG_FORMAT_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -10,6 +10,7 @@
 #ifndef METRICS_LOGGER_H_
 #define METRICS_LOGGER_H_
 
+#include "mlfq_config.h"
 #include "FreeRTOS.h"
 #include "scheduler.h"
 #include <stdint.h>
@@ -20,20 +21,569 @@
 
 #define LOG_BUFFER_SIZE 128
 
+/* Queue report, level change records and the logger task; 0U turns the
+ * calls into empty macros (MLFQ_PROFILE_MINIMAL in mlfq_config.h) */
+#ifndef METRICS_REPORT_ENABLED
+#define METRICS_REPORT_ENABLED 1U
+#endif
+
+/* Emits COBS-framed binary records instead of the text table.
+ * Decode on the host with tools/mlfq_decode.py */
+#ifndef METRICS_BINARY_LOG_ENABLED
+#define METRICS_BINARY_LOG_ENABLED 0U
+#endif
+
+/* 1U = binary task rows and level changes are sent as TASK_DELTA frames:
+ * varint differences from the task's previous row. Every
+ * METRICS_DELTA_KEYFRAME_EVERY-th row of a task is sent whole again */
+#ifndef METRICS_DELTA_LOG_ENABLED
+#define METRICS_DELTA_LOG_ENABLED 0U
+#endif
+
+#ifndef METRICS_DELTA_KEYFRAME_EVERY
+#define METRICS_DELTA_KEYFRAME_EVERY 16U
+#endif
+
+#if (METRICS_DELTA_LOG_ENABLED == 1U) && (METRICS_BINARY_LOG_ENABLED == 0U)
+#error "METRICS_DELTA_LOG_ENABLED needs METRICS_BINARY_LOG_ENABLED"
+#endif
+
+#if (METRICS_DELTA_LOG_ENABLED == 1U) && \
+    ((METRICS_DELTA_KEYFRAME_EVERY == 0U) || (METRICS_DELTA_KEYFRAME_EVERY > 256U))
+#error "METRICS_DELTA_KEYFRAME_EVERY must be between 1 and 256"
+#endif
+
+/* Binary records carry only the task id; each name is sent once, again
+ * after a slot is reused, and to all tasks every
+ * METRICS_NAME_RESEND_EVERY-th report so a host that attached late can
+ * label rows (or at once with metricsResendTaskNames) */
+#ifndef METRICS_NAME_RESEND_EVERY
+#define METRICS_NAME_RESEND_EVERY 10U
+#endif
+
+#if (METRICS_BINARY_LOG_ENABLED == 1U) && (METRICS_NAME_RESEND_EVERY == 0U)
+#error "METRICS_NAME_RESEND_EVERY must be non-zero"
+#endif
+
+/* Snapshot records buffered between the supervisor and the logger task
+ * (must be a power of two) */
+#ifndef METRICS_SNAPSHOT_RING_LENGTH
+#define METRICS_SNAPSHOT_RING_LENGTH 32U
+#endif
+
+#if ((METRICS_SNAPSHOT_RING_LENGTH & (METRICS_SNAPSHOT_RING_LENGTH - 1U)) != 0U)
+#error "METRICS_SNAPSHOT_RING_LENGTH must be a power of two"
+#endif
+
+/* 1U = only every METRICS_KEYFRAME_EVERY-th queue report is complete.
+ * The ones in between carry just the rows whose level changed, whose run
+ * time moved to another METRICS_DIFF_RUN_BUCKET_TICKS bucket or whose wait
+ * moved by METRICS_DIFF_WAIT_TICKS or more since they were last sent */
+#ifndef METRICS_DIFF_REPORT_ENABLED
+#define METRICS_DIFF_REPORT_ENABLED 0U
+#endif
+
+#ifndef METRICS_KEYFRAME_EVERY
+#define METRICS_KEYFRAME_EVERY      10U
+#endif
+
+#ifndef METRICS_DIFF_RUN_BUCKET_TICKS
+#define METRICS_DIFF_RUN_BUCKET_TICKS 5U
+#endif
+
+#ifndef METRICS_DIFF_WAIT_TICKS
+#define METRICS_DIFF_WAIT_TICKS     100U
+#endif
+
+#if (METRICS_DIFF_REPORT_ENABLED == 1U) && \
+    ((METRICS_KEYFRAME_EVERY == 0U) || (METRICS_DIFF_RUN_BUCKET_TICKS == 0U))
+#error "METRICS_KEYFRAME_EVERY and METRICS_DIFF_RUN_BUCKET_TICKS must be non-zero"
+#endif
+
+/* 1U = the logger task may queue at most METRICS_BUDGET_BYTES of report
+ * output per METRICS_BUDGET_WINDOW_MS. A report over budget is spread
+ * over several windows, one row or section at a time. Event records
+ * (level changes, boosts, overload and watchdog alarms) have their own
+ * ring of METRICS_EVENT_RING_LENGTH, are sent first and are never held
+ * back; their bytes still count against the budget */
+#ifndef METRICS_BUDGET_ENABLED
+#define METRICS_BUDGET_ENABLED      0U
+#endif
+
+#ifndef METRICS_BUDGET_WINDOW_MS
+#define METRICS_BUDGET_WINDOW_MS    100U
+#endif
+
+/* Half of a 115200 baud link over the default window */
+#ifndef METRICS_BUDGET_BYTES
+#define METRICS_BUDGET_BYTES        576U
+#endif
+
+#ifndef METRICS_EVENT_RING_LENGTH
+#define METRICS_EVENT_RING_LENGTH   8U
+#endif
+
+#if (METRICS_BUDGET_ENABLED == 1U) && \
+    ((METRICS_EVENT_RING_LENGTH & (METRICS_EVENT_RING_LENGTH - 1U)) != 0U)
+#error "METRICS_EVENT_RING_LENGTH must be a power of two"
+#endif
+
+#if (METRICS_BUDGET_ENABLED == 1U) && \
+    ((METRICS_BUDGET_WINDOW_MS == 0U) || (METRICS_BUDGET_BYTES == 0U))
+#error "METRICS_BUDGET_WINDOW_MS and METRICS_BUDGET_BYTES must be non-zero"
+#endif
+
+/* Logger task runs below every MLFQ level and is not managed by the MLFQ */
+#ifndef METRICS_LOGGER_PRIORITY
+#define METRICS_LOGGER_PRIORITY    (tskIDLE_PRIORITY + 1U)
+#endif
+
+/* Logger task stack in words (it owns all report formatting and UART
+ * work; log_format.h keeps every line on a few dozen bytes of stack) */
+#ifndef METRICS_LOGGER_STACK_SIZE
+#define METRICS_LOGGER_STACK_SIZE  256U
+#endif
+
+/* Binary record types (first byte of every frame payload) */
+#define METRICS_RECORD_TASK_STATS   0x01U   /* One row of the queue report */
+#define METRICS_RECORD_LEVEL_CHANGE 0x02U   /* Task moved between levels */
+#define METRICS_RECORD_BOOST        0x03U   /* Global boost, all tasks to High */
+#define METRICS_RECORD_TASK_NAME    0x04U   /* Maps a task id to its name */
+#define METRICS_RECORD_REPORT_END   0x05U   /* Closes a queue report */
+#define METRICS_RECORD_LATENCY      0x06U   /* Wake-to-run latency summary */
+#define METRICS_RECORD_INVERSION    0x07U   /* Priority inversion totals */
+#define METRICS_RECORD_POPULATION   0x08U   /* Number of tasks at a level */
+#define METRICS_RECORD_CPU          0x09U   /* CPU share over the last window */
+#define METRICS_RECORD_STACK        0x0AU   /* Stack high-water mark of a task */
+#define METRICS_RECORD_HEAP         0x0BU   /* Heap usage and fragmentation */
+#define METRICS_RECORD_OVERLOAD     0x0CU   /* Overload alarm, see logOverload() */
+#define METRICS_RECORD_WATCHDOG     0x0DU   /* Watchdog event, see logWatchdog() */
+#define METRICS_RECORD_SWITCHES     0x0EU   /* Context switch counts of a task */
+#define METRICS_RECORD_TASK_DELTA   0x0FU   /* Task row as varint deltas */
+#define METRICS_RECORD_CORE         0x10U   /* Runqueue of one core (SMP) */
+#define METRICS_RECORD_SELF         0x11U   /* Scheduler's own activity */
+#define METRICS_RECORD_LEVEL_TIME   0x12U   /* Time a task spent at each level */
+#define METRICS_RECORD_DEGRADED     0x13U   /* Degraded mode change, see logDegradedMode() */
+#define METRICS_RECORD_FPU          0x14U   /* FPU context saves of a task */
+#define METRICS_RECORD_WAIT         0x15U   /* Blocking waits of a task on one object */
+#define METRICS_RECORD_PC_SAMPLES   0x16U   /* PC samples of a task in one address range */
+#define METRICS_RECORD_STATE_TIME   0x17U   /* Running / ready / blocked time of a task */
+#define METRICS_RECORD_TIMER        0x18U   /* Timer daemon time of one callback */
+
+/*
+ * Task delta frame (METRICS_DELTA_LOG_ENABLED): type, task id, a flags
+ * byte and a sequence byte, then one zigzag LEB128 varint per flagged
+ * field, in MetricsRecord_t order (level, prev_level, timestamp, run,
+ * quantum, arrival, wait). Each is the field minus the same field of the
+ * task's previous row, wrapping at 32 bits, and a clear flag means "no
+ * change". The sequence counts deltas since the last whole row, so the
+ * host can tell when it lost one and must wait for the next whole row.
+ */
+#define METRICS_DELTA_FIELDS        7U
+#define METRICS_DELTA_LEVEL_CHANGE  0x80U   /* Flag: the row is a LEVEL_CHANGE */
+
+/* Watchdog events (level field of a METRICS_RECORD_WATCHDOG record) */
+#define METRICS_WATCHDOG_RESET      0U      /* This boot follows a watchdog reset */
+#define METRICS_WATCHDOG_STARVED    1U      /* Feeding stopped: a task is starved */
+
+/* 'level' of a REPORT_END record; a delta report's run_ticks holds the
+ * number of unchanged rows it left out */
+#define METRICS_REPORT_FULL         0U      /* Every row was sent */
+#define METRICS_REPORT_DELTA        1U      /* Only changed rows were sent */
+
+/* Consumers of a CPU record (its 'kind' byte) */
+#define METRICS_CPU_KIND_TASK       0x00U   /* One managed task */
+#define METRICS_CPU_KIND_LEVEL      0x01U   /* All managed tasks at a level */
+#define METRICS_CPU_KIND_SUPERVISOR 0x02U   /* Scheduler task */
+#define METRICS_CPU_KIND_OTHER      0x03U   /* Unmanaged tasks (logger, ...) */
+#define METRICS_CPU_KIND_IDLE       0x04U   /* Idle task */
+#define METRICS_CPU_KIND_IRQ        0x05U   /* One interrupt source, id in 'level' */
+#define METRICS_CPU_KIND_ASLEEP     0x06U   /* Part of idle with the core asleep */
+#define METRICS_CPU_KIND_CORE_IDLE  0x07U   /* Idle of one core (SMP), core in 'level' */
+
+/* Task id used by records that are not about a single task */
+#define METRICS_TASK_ID_NONE        0xFFU
+
+/******************************************************************************
+ * TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Fixed-layout snapshot record (little-endian, 24 bytes).
+ * This is both the unit passed from the supervisor to the logger task
+ * and the payload of a binary frame.
+ * Framing on the wire: COBS(record | CRC-16) followed by a 0x00 delimiter,
+ * where the CRC is the sw_crc Crc16() (CRC-16/ARC) of the record bytes.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_x */
+    uint8_t  task_id;       /* Slot in the profiler table */
+    uint8_t  level;         /* Current (or new) MLFQ level */
+    uint8_t  prev_level;    /* Previous level for LEVEL_CHANGE records */
+    uint32_t timestamp;     /* Tick count when the record was produced */
+    uint32_t run_ticks;
+    uint32_t quantum_ticks;
+    uint32_t arrival_tick;
+    uint32_t wait_ticks;
+} MetricsRecord_t;
+
+/*
+ * Description : Binary wake-to-run latency summary (little-endian, 20 bytes),
+ * sent after each REPORT_END. task_id is a profiler slot, or
+ * METRICS_TASK_ID_NONE for a per-level row identified by 'level'.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_LATENCY */
+    uint8_t  task_id;
+    uint8_t  level;
+    uint8_t  reserved;
+    uint32_t samples;
+    uint32_t p50_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} MetricsLatencyRecord_t;
+
+/*
+ * Description : Binary priority inversion totals of one task (little-endian,
+ * 16 bytes), sent after the latency summaries for every task that has run
+ * on an inherited priority.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_INVERSION */
+    uint8_t  task_id;
+    uint8_t  level;
+    uint8_t  reserved;
+    uint32_t episodes;
+    uint32_t total_us;
+    uint32_t max_us;
+} MetricsInversionRecord_t;
+
+/*
+ * Description : Binary level population (little-endian, 8 bytes), one per
+ * MLFQ level, sent right after each REPORT_END.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_POPULATION */
+    uint8_t  task_id;       /* Always METRICS_TASK_ID_NONE */
+    uint8_t  level;
+    uint8_t  reserved;
+    uint32_t tasks;
+} MetricsPopulationRecord_t;
+
+/*
+ * Description : Binary CPU share and lifetime CPU time (little-endian,
+ * 16 bytes), sent after the population records. The window runs from the
+ * previous report to this one; shares of all non-task kinds add up to
+ * 1000. total_ms counts from registration (tasks) or boot (the rest).
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_CPU */
+    uint8_t  task_id;       /* Slot for KIND_TASK, else METRICS_TASK_ID_NONE */
+    uint8_t  level;         /* Level for KIND_TASK and KIND_LEVEL */
+    uint8_t  kind;          /* METRICS_CPU_KIND_x */
+    uint32_t permille;      /* Share of the window in 0.1 % */
+    uint64_t total_ms;      /* Lifetime CPU time in ms */
+} MetricsCpuRecord_t;
+
+/*
+ * Description : Binary runqueue of one core (little-endian, 16 bytes),
+ * sent after the switch records when MLFQ_CORE_BALANCE_ENABLED is set.
+ * The busy share covers the latest balance check.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_CORE */
+    uint8_t  core;
+    uint8_t  tasks;         /* Managed tasks homed on the core */
+    uint8_t  high_tasks;    /* Of those, at High */
+    uint32_t busy_permille;
+    uint32_t steals;        /* Tasks the core took from other cores */
+    uint32_t migrations;    /* Moves between all cores since init */
+} MetricsCoreRecord_t;
+
+/*
+ * Description : Binary scheduler self-metrics (little-endian, 48 bytes),
+ * sent just before each REPORT_END. The counters run from boot; the host
+ * takes differences for the interval. The supervisor share covers the
+ * interval since the previous report.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_SELF */
+    uint8_t  task_id;       /* Always METRICS_TASK_ID_NONE */
+    uint8_t  reserved[2];
+    uint32_t demotions;
+    uint32_t promotions;    /* Boosts not included */
+    uint32_t boosts;
+    uint32_t expiries;      /* Delivered to the supervisor */
+    uint32_t coalesced;     /* Repeats folded by the per-task latch */
+    uint32_t dropped;       /* Lost to a full expired queue */
+    uint32_t queue_high_water;
+    uint32_t wakes;         /* Supervisor passes */
+    uint32_t supervisor_permille; /* Supervisor CPU share of the interval */
+    uint64_t supervisor_ms; /* Supervisor CPU time since boot */
+} MetricsSelfRecord_t;
+
+/*
+ * Description : Binary time at each level of one managed task
+ * (little-endian, 8 bytes plus 4 per level), sent after the switch
+ * records when TICK_PROFILER_LEVEL_TIME_ENABLED is set. The times and
+ * the change count run from registration; the host takes differences
+ * for the interval.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_LEVEL_TIME */
+    uint8_t  task_id;
+    uint8_t  level;         /* Level now */
+    uint8_t  levels;        /* Entries in level_ms, MLFQ_NUM_LEVELS */
+    uint32_t changes;       /* Level changes */
+    uint32_t level_ms[MLFQ_NUM_LEVELS];
+} MetricsLevelTimeRecord_t;
+
+/*
+ * Description : Binary context switch counts of one managed task
+ * (little-endian, 16 bytes), sent after the CPU records. The counts run
+ * from registration.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_SWITCHES */
+    uint8_t  task_id;
+    uint8_t  level;
+    uint8_t  reserved;
+    uint32_t switch_ins;
+    uint32_t voluntary;     /* Blocked, delayed, suspended or yielded */
+    uint32_t involuntary;   /* Preempted while still ready */
+} MetricsSwitchRecord_t;
+
+/*
+ * Description : Binary FPU context saves of one managed task
+ * (little-endian, 16 bytes), sent after all the switch records when
+ * TICK_PROFILER_FPU_STATS_ENABLED is set. The counts run from
+ * registration; the cost is the estimate of trace_hooks.h.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_FPU */
+    uint8_t  task_id;
+    uint8_t  level;
+    uint8_t  reserved;
+    uint32_t saves;         /* Context saves (switch-outs) */
+    uint32_t fpu_saves;     /* Of those, the ones with FPU state */
+    uint32_t fpu_kcycles;   /* Estimated extra cost, thousands of cycles */
+} MetricsFpuRecord_t;
+
+/*
+ * Description : Binary blocking waits of one task on one queue, semaphore
+ * or mutex (little-endian, 20 bytes), sent after the priority inversion
+ * totals for the WAIT_STATS_REPORT_TOP pairs with the most time blocked.
+ * The object is the handle's address, as a key only.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_WAIT */
+    uint8_t  task_id;
+    uint8_t  direction;     /* WAIT_STATS_RECEIVE or WAIT_STATS_SEND */
+    uint8_t  reserved;
+    uint32_t object;
+    uint32_t waits;
+    uint32_t total_us;
+    uint32_t max_us;
+} MetricsWaitRecord_t;
+
+/* Start address of the PC sample record for samples outside the range */
+#define METRICS_PC_OUTSIDE          0xFFFFFFFFUL
+
+/*
+ * Description : Binary PC samples of one task in one address range
+ * (little-endian, 16 bytes), sent after the blocking waits for the
+ * PC_SAMPLER_REPORT_TOP busiest ranges of every task that has samples.
+ * The range is 2^shift bytes from start; task_samples is the task's total,
+ * for the share. Unmanaged tasks use METRICS_TASK_ID_NONE.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_PC_SAMPLES */
+    uint8_t  task_id;
+    uint8_t  shift;         /* PC_SAMPLER_BUCKET_SHIFT */
+    uint8_t  reserved;
+    uint32_t start;         /* METRICS_PC_OUTSIDE for the outside bucket */
+    uint32_t samples;
+    uint32_t task_samples;
+} MetricsPcSampleRecord_t;
+
+/*
+ * Description : Binary timer service task time of one software timer
+ * callback or pended function since boot (little-endian, 24 bytes), sent
+ * after the PC samples for the TIMER_STATS_REPORT_TOP heaviest callbacks.
+ * The callback is the function's address, 0 for the overflow entry.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_TIMER */
+    uint8_t  task_id;       /* Always METRICS_TASK_ID_NONE */
+    uint8_t  pended;        /* 1 if run through xTimerPendFunctionCall() */
+    uint8_t  reserved;
+    uint32_t callback;
+    uint32_t runs;
+    uint32_t total_ms;
+    uint32_t max_us;
+    uint32_t overruns;      /* Runs over TIMER_STATS_ALERT_US */
+} MetricsTimerRecord_t;
+
+/*
+ * Description : Binary running / ready / blocked time of one managed task
+ * since registration (little-endian, 16 bytes), sent after the time in
+ * level records when STATE_TIME_ENABLED is set.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_STATE_TIME */
+    uint8_t  task_id;
+    uint8_t  level;
+    uint8_t  state;         /* Current STATE_TIME_* state */
+    uint32_t running_ms;
+    uint32_t ready_ms;
+    uint32_t blocked_ms;    /* Blocked, delayed or suspended */
+} MetricsStateTimeRecord_t;
+
+/*
+ * Description : Binary stack figures of one task (little-endian, 16 bytes
+ * followed by the task name bytes), sent after the CPU records for every
+ * task, registered or not. Sizes are in stack words.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_STACK */
+    uint8_t  task_id;       /* Slot, or METRICS_TASK_ID_NONE if unmanaged */
+    uint8_t  reserved[2];
+    uint32_t size_words;
+    uint32_t min_free_words;
+    uint32_t suggested_words;
+} MetricsStackRecord_t;
+
+/*
+ * Description : Binary heap figures (little-endian, 32 bytes), sent after
+ * the stack records. Sizes are heap_4 block sizes in bytes; the counters
+ * run from boot.
+ */
+typedef struct
+{
+    uint8_t  type;          /* METRICS_RECORD_HEAP */
+    uint8_t  task_id;       /* Always METRICS_TASK_ID_NONE */
+    uint8_t  reserved[2];
+    uint32_t free_bytes;
+    uint32_t min_free_bytes; /* Least free since boot */
+    uint32_t largest_block;
+    uint32_t free_blocks;
+    uint32_t allocations;
+    uint32_t frees;
+    uint32_t failures;      /* Allocations that returned NULL */
+} MetricsHeapRecord_t;
+
 /******************************************************************************
  * FUNCTION PROTOTYPES
  ******************************************************************************/
 
+#if (METRICS_REPORT_ENABLED == 1U)
 /*
  * Description : Formats a TaskStats struct into a readable string.
  * stats: The task statistics to format
+ * Returns a static buffer that the next call overwrites; prefer
+ * formatStatsLine() anywhere more than one task may format.
  */
 char *formatStatsLog(MLFQ_Task_Profiler_t stats);
 
 /*
- * Description : Iterates through all tasks in the scheduler, retrieves their
- * stats, and prints a formatted report over UART.
+ * Description : Reentrant formatStatsLog(): writes the same row into the
+ * caller's buffer (LOG_BUFFER_SIZE always fits) and returns its length,
+ * truncating if the buffer is smaller. Callable from any task at once.
+ */
+uint32_t formatStatsLine(const MLFQ_Task_Profiler_t *stats, char *buffer, uint32_t size);
+
+/*
+ * Description : Iterates through all tasks in the scheduler and queues a
+ * snapshot of their stats for the logger task, which prints the report.
+ * Never touches the UART, so it is cheap to call from the supervisor.
  */
 void printQueueReport(void);
 
+/*
+ * Description : Logger task. Drains snapshot records and formats them
+ * as the text report, or as binary frames. Create it at
+ * METRICS_LOGGER_PRIORITY and do not register it with the MLFQ.
+ */
+void metricsLoggerTask(void *pvParameters);
+
+/*
+ * Description : Returns the number of snapshots discarded because the
+ * logger task had not drained the ring in time.
+ */
+uint32_t getMetricsDroppedSnapshots(void);
+
+/*
+ * Description : Records a level transition of the task in a profiler slot.
+ * Emits a LEVEL_CHANGE record when binary logging is enabled.
+ */
+void logLevelChange(uint32_t slot, MLFQ_QueueLevel_t fromLevel,
+                    MLFQ_QueueLevel_t toLevel);
+
+/*
+ * Description : Records that a global boost moved every task to High.
+ */
+void logGlobalBoost(void);
+
+/*
+ * Description : Records an overload alarm. The record keeps the
+ * MetricsRecord_t layout: prev_level holds the causes just raised,
+ * level the causes in force, task_id the longest-waiting Low task,
+ * run_ticks the demand in 0.1 %, quantum_ticks that task's wait in ms and
+ * arrival_tick the alarm count.
+ */
+void logOverload(const MLFQ_OverloadStatus_t *status, uint32_t raised);
+
+/*
+ * Description : Records a change of degraded mode in the MetricsRecord_t
+ * layout: level is 1 on entry and 0 on exit, run_ticks the demand in
+ * 0.1 % and arrival_tick the number of mode changes.
+ */
+void logDegradedMode(const MLFQ_OverloadStatus_t *status);
+
+/*
+ * Description : Records a watchdog event (METRICS_WATCHDOG_x). For a
+ * starved task, task_id is its slot and quantum_ticks how long it has
+ * gone without CPU time, in ms.
+ */
+void logWatchdog(uint32_t event, uint32_t slot, uint32_t stalledMs);
+
+/*
+ * Description : Records the name of the task in a profiler slot so the
+ * host decoder can label binary records.
+ */
+void logTaskName(uint32_t slot, TaskHandle_t task);
+
+/*
+ * Description : Sends every task name again before its next binary
+ * record, for a host that has just (re)connected. Any task may call it.
+ */
+void metricsResendTaskNames(void);
+#else
+/* Reporting compiled out: the supervisor's calls cost nothing */
+#define printQueueReport()                              ((void)0)
+#define getMetricsDroppedSnapshots()                    (0U)
+#define logLevelChange(slot, fromLevel, toLevel)        ((void)(slot), (void)(fromLevel), (void)(toLevel))
+#define logGlobalBoost()                                ((void)0)
+#define logOverload(status, raised)                     ((void)(status), (void)(raised))
+#define logDegradedMode(status)                         ((void)(status))
+#define logWatchdog(event, slot, stalledMs)             ((void)(event), (void)(slot), (void)(stalledMs))
+#define logTaskName(slot, task)                         ((void)(slot), (void)(task))
+#define metricsResendTaskNames()                        ((void)0)
+#endif
+
 #endif /* METRICS_LOGGER_H_ */
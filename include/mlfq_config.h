@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  MODULE NAME  : Build Profile
+ *  FILE         : mlfq_config.h
+ *  DESCRIPTION  : One switch that sets the defaults of every
+ *                 instrumentation feature at once, from the full
+ *                 development build down to a classification-only image.
+ *                 Each module header includes this before its own
+ *                 defaults, so a feature switch given on the command line
+ *                 still overrides the profile. Macros only, as it is
+ *                 reached from FreeRTOSConfig.h through trace_hooks.h.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef MLFQ_CONFIG_H_
+#define MLFQ_CONFIG_H_
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Profiles:
+ *   FULL    : every module at its own default (development)
+ *   RELEASE : no event or heap trace, histograms, switch counts, level
+ *             times, stack or heap checks and no LED; the queue report and the
+ *             console stay
+ *   MINIMAL : classification only; also no report, logger task,
+ *             console or parameter store */
+#define MLFQ_PROFILE_FULL              0U
+#define MLFQ_PROFILE_RELEASE           1U
+#define MLFQ_PROFILE_MINIMAL           2U
+
+#ifndef MLFQ_BUILD_PROFILE
+#define MLFQ_BUILD_PROFILE             MLFQ_PROFILE_FULL
+#endif
+
+#if (MLFQ_BUILD_PROFILE > MLFQ_PROFILE_MINIMAL)
+#error "MLFQ_BUILD_PROFILE must be one of the MLFQ_PROFILE_* values"
+#endif
+
+#if (MLFQ_BUILD_PROFILE >= MLFQ_PROFILE_RELEASE)
+/* Tracing */
+#ifndef EVENT_TRACE_ENABLED
+#define EVENT_TRACE_ENABLED            0U
+#endif
+
+#ifndef HEAP_TRACE_ENABLED
+#define HEAP_TRACE_ENABLED             0U
+#endif
+
+/* Histograms and totals */
+#ifndef LATENCY_STATS_ENABLED
+#define LATENCY_STATS_ENABLED          0U
+#endif
+
+#ifndef BURST_STATS_ENABLED
+#define BURST_STATS_ENABLED            0U
+#endif
+
+#ifndef INVERSION_STATS_ENABLED
+#define INVERSION_STATS_ENABLED        0U
+#endif
+
+#ifndef TICK_PROFILER_SWITCH_COUNTS_ENABLED
+#define TICK_PROFILER_SWITCH_COUNTS_ENABLED 0U
+#endif
+
+#ifndef TICK_PROFILER_LEVEL_TIME_ENABLED
+#define TICK_PROFILER_LEVEL_TIME_ENABLED 0U
+#endif
+
+/* Stack and heap checks */
+#ifndef STACK_STATS_ENABLED
+#define STACK_STATS_ENABLED            0U
+#endif
+
+#ifndef HEAP_STATS_ENABLED
+#define HEAP_STATS_ENABLED             0U
+#endif
+
+/* Level LED */
+#ifndef MLFQ_LED_ENABLED
+#define MLFQ_LED_ENABLED               0U
+#endif
+#endif
+
+#if (MLFQ_BUILD_PROFILE >= MLFQ_PROFILE_MINIMAL)
+/* Reporting and the interfaces built on it */
+#ifndef METRICS_REPORT_ENABLED
+#define METRICS_REPORT_ENABLED         0U
+#endif
+
+#ifndef CONSOLE_ENABLED
+#define CONSOLE_ENABLED                0U
+#endif
+
+#ifndef PARAM_STORE_ENABLED
+#define PARAM_STORE_ENABLED            0U
+#endif
+#endif
+
+#endif /* MLFQ_CONFIG_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
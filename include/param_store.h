@@ -0,0 +1,106 @@
+/******************************************************************************
+ *  MODULE NAME  : Parameter Store
+ *  FILE         : param_store.h
+ *  DESCRIPTION  : Keeps the tuned scheduler parameters, and the classes
+ *                 the scheduler learned for its tasks, in the on-chip
+ *                 EEPROM so a board boots straight into its tuned policy.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef PARAM_STORE_H_
+#define PARAM_STORE_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "scheduler.h"
+#include "board.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* EEPROM persistence of MLFQ_Tunables_t; set to 0U to always boot with
+ * the scheduler.h defaults. The EEPROM is a TM4C123 peripheral */
+#ifndef PARAM_STORE_ENABLED
+#if (MLFQ_BOARD == MLFQ_BOARD_TM4C123)
+#define PARAM_STORE_ENABLED          1U
+#else
+#define PARAM_STORE_ENABLED          0U
+#endif
+#endif
+
+/* Byte offset of the record in EEPROM (must be a multiple of 4) */
+#ifndef PARAM_STORE_EEPROM_ADDRESS
+#define PARAM_STORE_EEPROM_ADDRESS   0x0000U
+#endif
+
+/* Record identification; bump the version whenever the layout changes */
+#define PARAM_STORE_MAGIC            0x4D4C4651UL   /* "MLFQ" */
+#define PARAM_STORE_VERSION          1U
+
+/* Byte offset of the warm-start class table (MLFQ_WARM_START_ENABLED),
+ * clear of the parameter record, and the tasks it holds */
+#ifndef PARAM_STORE_CLASS_ADDRESS
+#define PARAM_STORE_CLASS_ADDRESS    0x0100U
+#endif
+#ifndef PARAM_STORE_CLASS_ENTRIES
+#define PARAM_STORE_CLASS_ENTRIES    16U
+#endif
+
+#define PARAM_STORE_CLASS_MAGIC      0x4D4C4643UL   /* "MLFC" */
+
+#if (PARAM_STORE_CLASS_ENTRIES == 0U) || (PARAM_STORE_CLASS_ENTRIES > 64U)
+#error "PARAM_STORE_CLASS_ENTRIES must be 1 .. 64"
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Learned class of one task, keyed by a hash of its name.
+ */
+typedef struct
+{
+    uint32_t name_hash;
+    uint8_t  level;          /* MLFQ_QueueLevel_t to start at */
+    uint8_t  score;          /* Interactivity score, 0 .. 100 */
+} ParamStoreClass_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (PARAM_STORE_ENABLED == 1U)
+/* Description : Powers up the EEPROM. Returns false if it cannot be used */
+bool paramStoreInit(void);
+
+/* Description : Reads the stored parameters. Returns false if there is no
+ *               record, or its magic, version, level count or CRC differ */
+bool paramStoreLoad(MLFQ_Tunables_t *output);
+
+/* Description : Writes the parameters with a fresh CRC. Blocks the caller
+ *               for the EEPROM programming time (milliseconds) */
+bool paramStoreSave(const MLFQ_Tunables_t *input);
+
+/* Description : Invalidates the stored record so the next boot uses the
+ *               compiled-in defaults */
+bool paramStoreErase(void);
+
+/* Description : Reads the class table into 'output', which holds
+ *               PARAM_STORE_CLASS_ENTRIES, and sets 'count'. False if
+ *               there is no valid table */
+bool paramStoreLoadClasses(ParamStoreClass_t *output, uint32_t *count);
+
+/* Description : Writes the first 'count' classes as the table. Blocks
+ *               the caller for the EEPROM programming time */
+bool paramStoreSaveClasses(const ParamStoreClass_t *input, uint32_t count);
+#endif
+
+#endif /* PARAM_STORE_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
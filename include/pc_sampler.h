@@ -0,0 +1,99 @@
+/******************************************************************************
+ *  MODULE NAME  : PC Sampler
+ *  FILE         : pc_sampler.h
+ *  DESCRIPTION  : Statistical profiler. On every tick the program counter
+ *                 the tick interrupted is read from the task's exception
+ *                 frame and counted in a per-task histogram of address
+ *                 ranges. Shows where a CPU-bound task spends its quantum;
+ *                 tools/mlfq_decode.py --map names the code in each range
+ *                 from the linker map.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef PC_SAMPLER_H_
+#define PC_SAMPLER_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/* TICK_PROFILER_MAX_TASKS */
+#include "tick_profiler.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Tick PC sampling; set to 1U to enable */
+#ifndef PC_SAMPLER_ENABLED
+#define PC_SAMPLER_ENABLED           0U
+#endif
+
+/* First address of the sampled range (start of flash) */
+#ifndef PC_SAMPLER_BASE
+#define PC_SAMPLER_BASE              0x00000000UL
+#endif
+
+/* Each bucket covers 2^PC_SAMPLER_BUCKET_SHIFT bytes (2 KB) */
+#ifndef PC_SAMPLER_BUCKET_SHIFT
+#define PC_SAMPLER_BUCKET_SHIFT      11U
+#endif
+
+/* Buckets per task; the range is PC_SAMPLER_BUCKETS << PC_SAMPLER_BUCKET_SHIFT
+ * bytes from PC_SAMPLER_BASE, and samples outside it share one more bucket */
+#ifndef PC_SAMPLER_BUCKETS
+#define PC_SAMPLER_BUCKETS           32U
+#endif
+
+/* Buckets listed per task by the report, most samples first */
+#ifndef PC_SAMPLER_REPORT_TOP
+#define PC_SAMPLER_REPORT_TOP        4U
+#endif
+
+#if (PC_SAMPLER_ENABLED == 1U) && \
+    ((PC_SAMPLER_BUCKETS == 0U) || (PC_SAMPLER_BUCKETS > 32U))
+#error "PC_SAMPLER_BUCKETS must be 1..32"
+#endif
+
+#if (PC_SAMPLER_ENABLED == 1U) && \
+    ((PC_SAMPLER_BUCKET_SHIFT < 2U) || (PC_SAMPLER_BUCKET_SHIFT > 20U))
+#error "PC_SAMPLER_BUCKET_SHIFT must be 2..20"
+#endif
+
+/* Bucket of the samples outside the range */
+#define PC_SAMPLER_OUTSIDE           PC_SAMPLER_BUCKETS
+
+/* Row of the samples taken in unregistered tasks (idle, logger, ...) */
+#define PC_SAMPLER_UNMANAGED         TICK_PROFILER_MAX_TASKS
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (PC_SAMPLER_ENABLED == 1U)
+/* Description : Samples the interrupted PC. Call from the tick hook only */
+void pcSamplerTick(void);
+
+/* Description : Samples of one bucket of a row (a profiler slot or
+ *               PC_SAMPLER_UNMANAGED); 0 when out of range */
+uint32_t pcSamplerGetCount(uint32_t row, uint32_t bucket);
+
+/* Description : All samples of a row, the outside bucket included */
+uint32_t pcSamplerGetTotal(uint32_t row);
+
+/* Description : Clears the histogram of a profiler slot (slot reuse) */
+void pcSamplerResetTask(uint32_t slot);
+#endif
+
+#endif /* PC_SAMPLER_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  MODULE NAME  : Scheduling Policy Interface
+ *  FILE         : sched_policy.h
+ *  DESCRIPTION  : Callback table through which the supervisor drives the
+ *                 scheduling policy, plus the compile-time policy switch.
+ *                 The MLFQ is one implementation; stride and lottery
+ *                 scheduling (proportional_share.c) share the same tick
+ *                 profiler and test runner. Included from trace_hooks.h,
+ *                 so it must not pull in any FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef SCHED_POLICY_H_
+#define SCHED_POLICY_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Policy identifiers */
+#define SCHED_POLICY_MLFQ               0U
+#define SCHED_POLICY_STRIDE             1U
+#define SCHED_POLICY_LOTTERY            2U
+
+/* Policy the supervisor runs */
+#ifndef SCHED_POLICY
+#define SCHED_POLICY                    SCHED_POLICY_MLFQ
+#endif
+
+#if (SCHED_POLICY > SCHED_POLICY_LOTTERY)
+#error "Unknown SCHED_POLICY"
+#endif
+
+/* Stride and lottery: tickets of a newly registered task, the largest
+ * ticket count accepted, and how often the running task is re-chosen
+ * when no quantum expires in between (milliseconds) */
+#ifndef SCHED_POLICY_DEFAULT_TICKETS
+#define SCHED_POLICY_DEFAULT_TICKETS    100U
+#endif
+
+#ifndef SCHED_POLICY_MAX_TICKETS
+#define SCHED_POLICY_MAX_TICKETS        10000U
+#endif
+
+#ifndef SCHED_POLICY_RESELECT_MS
+#define SCHED_POLICY_RESELECT_MS        50U
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Scheduling policy callbacks. Slots are profiler table
+ *               indices. Every callback runs in the supervisor task except
+ *               on_register, which may also run in the kernel task-create
+ *               hook and must not change priorities, and on_block, which
+ *               runs inside the context switch and may only set flags.
+ *               NULL entries are skipped.
+ */
+typedef struct
+{
+    const char *name;
+
+    /* A task was given a slot (level High, High quantum, zero runtime) */
+    void (*on_register)(uint32_t slot);
+
+    /* The task in a slot used up its quantum */
+    void (*on_quantum_expired)(uint32_t slot);
+
+    /* The task in a slot blocked or suspended */
+    void (*on_block)(uint32_t slot);
+
+    /* Periodic work; returns the ticks until the policy wants to be
+     * called again */
+    uint32_t (*on_periodic)(uint32_t nowTicks);
+
+    /* RTOS priority the task in a slot should have now */
+    uint32_t (*pick_priority)(uint32_t slot);
+} SchedPolicy_t;
+
+/******************************************************************************
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+
+/* Callback tables of the available policies */
+extern const SchedPolicy_t g_mlfqPolicy;
+
+#if (SCHED_POLICY == SCHED_POLICY_STRIDE)
+extern const SchedPolicy_t g_stridePolicy;
+#elif (SCHED_POLICY == SCHED_POLICY_LOTTERY)
+extern const SchedPolicy_t g_lotteryPolicy;
+#endif
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (SCHED_POLICY != SCHED_POLICY_MLFQ)
+/* Description : Context switch hook; forwards blocking switch-outs of
+ *               registered tasks to the policy's on_block */
+void schedPolicyTaskSwitchedOut(void *task, bool stillReady);
+
+/* Description : Sets the tickets of a slot (1 .. SCHED_POLICY_MAX_TICKETS) */
+bool schedPolicySetTickets(uint32_t slot, uint32_t tickets);
+#endif
+
+#endif /* SCHED_POLICY_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
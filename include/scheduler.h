@@ -23,10 +23,30 @@
 /* Tick-based runtime profiler interface */
 #include "tick_profiler.h"
 
+/* MLFQ_TIMER_WHEEL_ENABLED */
+#include "timer_wheel.h"
+
 /* Standard types */
 #include <stdbool.h>
 #include <stdint.h>
 
+/******************************************************************************
+ *  LEVEL CONFIGURATION
+ ******************************************************************************/
+
+/* Number of MLFQ levels (3 to 8). Level 0 is the highest priority */
+#ifndef MLFQ_NUM_LEVELS
+#define MLFQ_NUM_LEVELS                         3U
+#endif
+
+#if ((MLFQ_NUM_LEVELS < 3U) || (MLFQ_NUM_LEVELS > 8U))
+#error "MLFQ_NUM_LEVELS must be between 3 and 8"
+#endif
+
+#if (MLFQ_NUM_LEVELS > TICK_PROFILER_MAX_LEVELS)
+#error "MLFQ_NUM_LEVELS exceeds the profiler's level sets (TICK_PROFILER_MAX_LEVELS)"
+#endif
+
 /******************************************************************************
  *  TYPE DEFINITIONS
  ******************************************************************************/
@@ -34,25 +54,43 @@
 /*
  * Description : Enumeration defining the available MLFQ priority levels.
  *               Lower enum value corresponds to higher scheduling priority.
+ *               Levels between MEDIUM and LOW are plain numbers when
+ *               MLFQ_NUM_LEVELS is above three.
  */
 typedef enum
 {
-    MLFQ_QUEUE_HIGH,
-    MLFQ_QUEUE_MEDIUM,
-    MLFQ_QUEUE_LOW,
-    MLFQ_NUMBER_QUEUES
+    MLFQ_QUEUE_HIGH    = 0,
+    MLFQ_QUEUE_MEDIUM  = 1,
+    MLFQ_QUEUE_LOW     = (int)(MLFQ_NUM_LEVELS - 1U),
+    MLFQ_NUMBER_QUEUES = (int)MLFQ_NUM_LEVELS
 } MLFQ_QueueLevel_t;
 
 /*
- * Description : Task Control Block used internally by the scheduler.
- *               Stores scheduling metadata for each registered task.
+ * Description : Per-level scheduling parameters, one row per MLFQ level.
+ */
+typedef struct
+{
+    uint32_t    quantum_ticks;  /* Time slice in RTOS ticks */
+    uint32_t    quantum_us;     /* Time slice in microseconds (GPTM enforcement) */
+    UBaseType_t rtos_priority;  /* FreeRTOS priority of tasks at this level */
+    uint32_t    starvation_ms;  /* Ready wait that promotes one level (aging) */
+    uint32_t    budget_window_ms; /* Quantum give-back (MLFQ_BUDGET_x or ms) */
+    uint32_t    quantum_round_robin; /* 1: equals rotate at quantum ends only,
+                                      * not on every tick */
+} MLFQ_LevelConfig_t;
+
+/*
+ * Description : Scheduler parameters that may be changed while running
+ *               (UART console). Written with schedulerSetTunables() and
+ *               applied as one unit by the supervisor task.
  */
 typedef struct
 {
-    TaskHandle_t      task_handle;   /* FreeRTOS task handle */
-    MLFQ_QueueLevel_t task_level;    /* Current MLFQ queue level */
-    TickType_t        arrival_tick;  /* Tick count when task was registered */
-} MLFQ_TCB_t;
+    uint32_t quantum_ticks[MLFQ_NUM_LEVELS];
+    uint32_t quantum_us[MLFQ_NUM_LEVELS];
+    uint32_t boost_period_ms;
+    bool     reporting_enabled;
+} MLFQ_Tunables_t;
 
 /*
  * Description : Aggregated task profiling structure.
@@ -65,38 +103,889 @@ typedef struct
     TickType_t             arrival_tick; /* Task arrival timestamp */
 } MLFQ_Task_Profiler_t;
 
+/*
+ * Description : Cost metrics of the global priority boost.
+ */
+typedef struct
+{
+    uint32_t boost_count;  /* Boosts performed since init */
+    uint32_t last_cycles;  /* Duration of the latest boost (core cycles) */
+    uint32_t max_cycles;   /* Longest boost observed (core cycles) */
+    uint32_t period_ms;    /* Boost period in force (auto-tuned or set) */
+    uint32_t early_boosts; /* Boosts auto-tuning brought forward */
+} MLFQ_BoostStats_t;
+
+/*
+ * Description : Clock scaling counters (MLFQ_CLOCK_SCALING_ENABLED).
+ */
+typedef struct
+{
+    uint32_t clock_hz;    /* Core clock in force */
+    uint32_t slowdowns;   /* Switches to the slow clock */
+    uint32_t slow_ms;     /* Time spent slow, up to the last restore */
+} MLFQ_ClockStats_t;
+
+/*
+ * Description : Level changes asked of the scheduler: those that reached
+ *               the kernel, and those dropped because the task already
+ *               had the level and its priority (a demotion at Low, a
+ *               boosted task already in High). Both wrap.
+ */
+typedef struct
+{
+    uint32_t applied;    /* Priority and quantum changed */
+    uint32_t coalesced;  /* Only the quantum was re-armed */
+} MLFQ_LevelChangeStats_t;
+
+/*
+ * Description : Time from a quantum expiry being reported by the tick or
+ *               timer hook to the supervisor handing it to the policy.
+ */
+typedef struct
+{
+    uint32_t count;         /* Expiries handled since the last reset */
+    uint32_t last_cycles;   /* Latency of the latest one (core cycles) */
+    uint32_t max_cycles;    /* Longest latency since the last reset */
+    uint64_t total_cycles;  /* Sum, for the mean */
+} MLFQ_ExpiryLatencyStats_t;
+
+/*
+ * Description : The scheduler's own activity since init. The counters
+ *               wrap; take differences for a rate. A burst of demotions
+ *               with as many promotions, or a supervisor that wakes on
+ *               every tick, is the scheduler thrashing.
+ */
+typedef struct
+{
+    uint32_t demotions;          /* Level changes that moved a task down */
+    uint32_t promotions;         /* Moves up, boosts not included */
+    uint32_t boosts;             /* Global boosts (rolling: slices) */
+    uint32_t expiries_received;  /* Quantum expiries delivered to the supervisor */
+    uint32_t expiries_coalesced; /* Repeats folded by the per-task latch */
+    uint32_t expiries_dropped;   /* Lost to a full expired queue, then retried */
+    uint32_t queue_high_water;   /* Most expiries queued at once (0 with the expired mask) */
+    uint32_t wakes;              /* Supervisor passes */
+    uint64_t supervisor_time;    /* Supervisor CPU time, TickProfilerCpuTime_t units */
+} MLFQ_SelfMetrics_t;
+
+/*
+ * Description : Overload state as of the latest check.
+ */
+typedef struct
+{
+    uint32_t events;          /* Alarms raised since init */
+    uint32_t causes;          /* MLFQ_OVERLOAD_CAUSE_x in force now */
+    uint32_t demand_permille; /* Rolling CPU share of the levels above Low */
+    uint32_t max_wait_us[MLFQ_NUM_LEVELS]; /* Longest ready wait per level */
+    uint32_t starving_slot;   /* Longest-waiting Low task, TICK_PROFILER_MAX_TASKS = none */
+    uint32_t degraded;        /* 1 while degraded mode is in force (MLFQ_DEGRADE_ENABLED) */
+    uint32_t mode_changes;    /* Entries into and exits from degraded mode */
+} MLFQ_OverloadStatus_t;
+
+/*
+ * Description : Called by the supervisor when an alarm is raised, that is
+ *               when a cause comes into force, and when degraded mode
+ *               starts or ends. Must not block.
+ */
+typedef void (*MLFQ_OverloadHook_t)(const MLFQ_OverloadStatus_t *status);
+
+/*
+ * Description : Called by the supervisor after a task's level changed
+ *               (MLFQ_LEVEL_CALLBACKS_ENABLED), with the level before the
+ *               first change since the last call and the level now.
+ *               Boosts count. Runs in the supervisor task, so it must not
+ *               block; it sets a flag or notifies the task it belongs to.
+ */
+typedef void (*MLFQ_LevelCallback_t)(TaskHandle_t task, MLFQ_QueueLevel_t oldLevel,
+                                     MLFQ_QueueLevel_t newLevel, void *context);
+
+/*
+ * Description : One task group (MLFQ_GROUPS_ENABLED).
+ */
+typedef struct
+{
+    const char *name;          /* NULL for an unused group */
+    uint32_t    share_percent; /* Share of the Low level */
+    uint32_t    tasks;         /* Registered members */
+} MLFQ_GroupInfo_t;
+
+/*
+ * Description : One MLFQ partition (MLFQ_PARTITIONS_ENABLED).
+ */
+typedef struct
+{
+    const char *name;            /* NULL for an unused partition */
+    uint32_t    top_priority;    /* FreeRTOS priority of its High level */
+    uint32_t    levels;          /* Levels used, from High down */
+    uint32_t    quantum_percent; /* Quanta, in percent of the level table's */
+    uint32_t    boost_period_ms; /* 0: never boosted */
+    uint32_t    tasks;           /* Registered members */
+    uint32_t    boosts;          /* Boosts of its members since creation */
+} MLFQ_PartitionInfo_t;
+
+/*
+ * Description : One core's runqueue (MLFQ_CORE_BALANCE_ENABLED), as of the
+ *               latest balance check.
+ */
+typedef struct
+{
+    uint32_t busy_permille;                /* Share of the core not idle */
+    uint32_t tasks;                        /* Managed tasks homed on it */
+    uint32_t level_tasks[MLFQ_NUM_LEVELS]; /* The same, per level */
+    uint32_t steals;                       /* Tasks it took from other cores */
+} MLFQ_CoreStats_t;
+
+/*
+ * Description : Consistent copy of the stats of every registered task,
+ *               taken at one instant. Entry i belongs to profiler slot
+ *               slot[i]; only the first 'count' entries are valid.
+ */
+typedef struct
+{
+    uint32_t             count;
+    TickType_t           timestamp;                     /* Tick of the copy */
+    uint8_t              slot[TICK_PROFILER_MAX_TASKS];
+    MLFQ_Task_Profiler_t task[TICK_PROFILER_MAX_TASKS];
+} MLFQ_StatsSnapshot_t;
+
 /******************************************************************************
  *  MACRO DEFINITIONS AND CONFIGURATIONS
  ******************************************************************************/
 
-/* Highest FreeRTOS priority number used by the scheduler */
+/* Highest FreeRTOS priority number used by the scheduler (High level).
+ * The supervisor task runs one above it, or two with the Low-level
+ * reservation below. */
+#ifndef MLFQ_TOP_PRIORITY_NUMBER
+#if (MLFQ_NUM_LEVELS > 3U)
+#define MLFQ_TOP_PRIORITY_NUMBER                (MLFQ_NUM_LEVELS + 1U)
+#else
 #define MLFQ_TOP_PRIORITY_NUMBER                (5U)
+#endif
+#endif
+
+/* Low-level CPU reservation: from the start of every reservation period
+ * the Low tasks run at MLFQ_RESERVE_PRIORITY, above High, until the Low
+ * level has used MLFQ_RESERVE_PERCENT of the period, then drop back to
+ * the Low priority. Their level and quantum do not change */
+#ifndef MLFQ_RESERVE_ENABLED
+#define MLFQ_RESERVE_ENABLED                    0U
+#endif
+
+#ifndef MLFQ_RESERVE_PERIOD_MS
+#define MLFQ_RESERVE_PERIOD_MS                  100U
+#endif
+
+#ifndef MLFQ_RESERVE_PERCENT
+#define MLFQ_RESERVE_PERCENT                    10U
+#endif
+
+#if (MLFQ_RESERVE_ENABLED == 1U) && ((MLFQ_RESERVE_PERCENT == 0U) || (MLFQ_RESERVE_PERCENT >= 100U))
+#error "MLFQ_RESERVE_PERCENT must lie between 1 and 99"
+#endif
+
+/* Priority of the supervisor task, above every level and the reservation */
+#if (MLFQ_RESERVE_ENABLED == 1U)
+#define MLFQ_RESERVE_PRIORITY                   (MLFQ_TOP_PRIORITY_NUMBER + 1U)
+#define MLFQ_SUPERVISOR_PRIORITY                (MLFQ_TOP_PRIORITY_NUMBER + 2U)
+#else
+#define MLFQ_SUPERVISOR_PRIORITY                (MLFQ_TOP_PRIORITY_NUMBER + 1U)
+#endif
+
+/* The supervisor needs a priority above every level. The lowest default
+ * level keeps one priority above idle + 1, where the logger task runs */
+#if (MLFQ_SUPERVISOR_PRIORITY >= configMAX_PRIORITIES)
+#error "configMAX_PRIORITIES too small for MLFQ_TOP_PRIORITY_NUMBER and the supervisor"
+#endif
+#if (MLFQ_TOP_PRIORITY_NUMBER < (MLFQ_NUM_LEVELS + 1U))
+#error "MLFQ_TOP_PRIORITY_NUMBER leaves no room for MLFQ_NUM_LEVELS above the logger task"
+#endif
+
+/* Real-time band above the supervisor for tasks pinned with pinTask().
+ * The MLFQ never demotes, boosts or accounts these. Defaults to every
+ * priority left above the supervisor; may be 0U. */
+#ifndef MLFQ_RT_BAND_SIZE
+#define MLFQ_RT_BAND_SIZE                       (configMAX_PRIORITIES - 1U - MLFQ_SUPERVISOR_PRIORITY)
+#endif
+#define MLFQ_RT_PRIORITY_MIN                    (MLFQ_SUPERVISOR_PRIORITY + 1U)
+#define MLFQ_RT_PRIORITY_MAX                    (MLFQ_SUPERVISOR_PRIORITY + MLFQ_RT_BAND_SIZE)
+
+#if (MLFQ_RT_PRIORITY_MAX >= configMAX_PRIORITIES)
+#error "configMAX_PRIORITIES too small for MLFQ_RT_BAND_SIZE above the supervisor"
+#endif
+
+/* The timer service task stands in for the supervisor task */
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1) && (configTIMER_TASK_PRIORITY != MLFQ_SUPERVISOR_PRIORITY)
+#error "configTIMER_TASK_PRIORITY must equal MLFQ_SUPERVISOR_PRIORITY with configUSE_MLFQ_TIMER_SUPERVISOR"
+#endif
+
+/* Longest wake-to-run latency target schedulerSetLatencyTarget() takes */
+#define MLFQ_LATENCY_TARGET_MAX_US              10000000U
+
+/* Most tasks that can be pinned at once */
+#ifndef MLFQ_MAX_PINNED_TASKS
+#define MLFQ_MAX_PINNED_TASKS                   4U
+#endif
 
 /*
  * Description : Converts an MLFQ queue level to a FreeRTOS priority value.
  */
-#define MLFQ_TO_RTOS_LEVEL_SETTER(level)        (MLFQ_TOP_PRIORITY_NUMBER - level)
+#define MLFQ_TO_RTOS_LEVEL_SETTER(level)        (mlfqLevelPriority((MLFQ_QueueLevel_t)(level)))
 
 /* Periodic priority boost interval (milliseconds) */
 #define MLFQ_BOOST_PERIOD_MS                    3000U
 
+/* Rolling boost: with more than one slice the boost period is cut into
+ * MLFQ_BOOST_SLICES sub-periods, each boosting only the tasks whose slot
+ * falls in its slice (slot % MLFQ_BOOST_SLICES), round robin. Every task
+ * is still boosted once per boost period, but never all at once */
+#ifndef MLFQ_BOOST_SLICES
+#define MLFQ_BOOST_SLICES                       1U
+#endif
+
+#if (MLFQ_BOOST_SLICES == 0U)
+#error "MLFQ_BOOST_SLICES must be at least 1"
+#endif
+
+/* Adaptive quanta: at every boost period the High quantum is moved towards
+ * the burst length that MLFQ_ADAPTIVE_TARGET_PERCENT of the bursts started
+ * at High fit in, and the lower levels keep their table ratio to High */
+#ifndef MLFQ_ADAPTIVE_QUANTUM_ENABLED
+#define MLFQ_ADAPTIVE_QUANTUM_ENABLED           0U
+#endif
+
+#ifndef MLFQ_ADAPTIVE_TARGET_PERCENT
+#define MLFQ_ADAPTIVE_TARGET_PERCENT            90U
+#endif
+
+/* Bounds of the adapted High quantum */
+#ifndef MLFQ_ADAPTIVE_HIGH_MIN_US
+#define MLFQ_ADAPTIVE_HIGH_MIN_US               5000U
+#endif
+#ifndef MLFQ_ADAPTIVE_HIGH_MAX_US
+#define MLFQ_ADAPTIVE_HIGH_MAX_US               500000U
+#endif
+
+/* Bursts needed in a window before the quantum is moved */
+#ifndef MLFQ_ADAPTIVE_MIN_SAMPLES
+#define MLFQ_ADAPTIVE_MIN_SAMPLES               16U
+#endif
+
+#if ((MLFQ_ADAPTIVE_QUANTUM_ENABLED == 1U) && (BURST_STATS_ENABLED == 0U))
+#error "MLFQ_ADAPTIVE_QUANTUM_ENABLED needs BURST_STATS_ENABLED"
+#endif
+
+/* Aging (MLFQ_AGING_ENABLED, aging.h): ready wait per level below High
+ * after which a task is promoted one level */
+#ifndef MLFQ_AGING_STEP_MS
+#define MLFQ_AGING_STEP_MS                      500U
+#endif
+
+/* Overload detection (MLFQ_OVERLOAD_ENABLED, aging.h): every
+ * MLFQ_OVERLOAD_CHECK_MS the supervisor folds the CPU share of the levels
+ * above Low into a rolling average and finds the longest ready wait at
+ * each level. An alarm is raised when the share reaches
+ * MLFQ_OVERLOAD_DEMAND_PERCENT or a Low task has been ready for
+ * MLFQ_OVERLOAD_STARVE_MS without running */
+#ifndef MLFQ_OVERLOAD_CHECK_MS
+#define MLFQ_OVERLOAD_CHECK_MS                  100U
+#endif
+
+#ifndef MLFQ_OVERLOAD_DEMAND_PERCENT
+#define MLFQ_OVERLOAD_DEMAND_PERCENT            90U
+#endif
+
+#ifndef MLFQ_OVERLOAD_STARVE_MS
+#define MLFQ_OVERLOAD_STARVE_MS                 500U
+#endif
+
+#if (MLFQ_OVERLOAD_ENABLED == 1U) && (MLFQ_OVERLOAD_DEMAND_PERCENT > 100U)
+#error "MLFQ_OVERLOAD_DEMAND_PERCENT must not exceed 100"
+#endif
+
+/* Degraded mode: when the demand alarm is raised the scheduler sheds
+ * the least important work. The quanta of the levels between High and
+ * Low shrink to MLFQ_DEGRADE_MEDIUM_PERCENT, so their CPU-bound tasks
+ * sink to Low sooner, and Low tasks get MLFQ_DEGRADE_LOW_PERCENT of
+ * their quantum or, with MLFQ_DEGRADE_SUSPEND_LOW, are suspended. Boosts
+ * and the Low reservation are held off. Normal mode returns once the
+ * demand has stayed under MLFQ_DEGRADE_EXIT_PERCENT for
+ * MLFQ_DEGRADE_HOLD_MS */
+#ifndef MLFQ_DEGRADE_ENABLED
+#define MLFQ_DEGRADE_ENABLED                    0U
+#endif
+
+#ifndef MLFQ_DEGRADE_MEDIUM_PERCENT
+#define MLFQ_DEGRADE_MEDIUM_PERCENT             50U
+#endif
+
+#ifndef MLFQ_DEGRADE_LOW_PERCENT
+#define MLFQ_DEGRADE_LOW_PERCENT                10U
+#endif
+
+/* Suspend Low tasks instead of cutting their quantum. Only for builds
+ * whose Low tasks hold no lock another task may wait on */
+#ifndef MLFQ_DEGRADE_SUSPEND_LOW
+#define MLFQ_DEGRADE_SUSPEND_LOW                0U
+#endif
+
+#ifndef MLFQ_DEGRADE_EXIT_PERCENT
+#define MLFQ_DEGRADE_EXIT_PERCENT               70U
+#endif
+
+#ifndef MLFQ_DEGRADE_HOLD_MS
+#define MLFQ_DEGRADE_HOLD_MS                    500U
+#endif
+
+#if (MLFQ_DEGRADE_ENABLED == 1U)
+#if (MLFQ_DEGRADE_EXIT_PERCENT >= MLFQ_OVERLOAD_DEMAND_PERCENT)
+#error "MLFQ_DEGRADE_EXIT_PERCENT must be below MLFQ_OVERLOAD_DEMAND_PERCENT"
+#endif
+#if (MLFQ_DEGRADE_MEDIUM_PERCENT == 0U) || (MLFQ_DEGRADE_MEDIUM_PERCENT > 100U) || \
+    (MLFQ_DEGRADE_LOW_PERCENT == 0U) || (MLFQ_DEGRADE_LOW_PERCENT > 100U)
+#error "MLFQ_DEGRADE_MEDIUM_PERCENT and MLFQ_DEGRADE_LOW_PERCENT must be 1..100"
+#endif
+#endif
+
+/* FPU-aware slices: a task below High whose context saves mostly carry
+ * FPU state (TICK_PROFILER_FPU_STATS_ENABLED, trace_hooks.h) gets
+ * MLFQ_FPU_SLICE_PERCENT of its level's quantum, so a CPU-bound DSP task
+ * pays its longer switches less often. High keeps its short quantum */
+#ifndef MLFQ_FPU_SLICE_ENABLED
+#define MLFQ_FPU_SLICE_ENABLED                  0U
+#endif
+
+#ifndef MLFQ_FPU_SLICE_PERCENT
+#define MLFQ_FPU_SLICE_PERCENT                  200U
+#endif
+
+/* Share of the saves, in percent, that must hold FPU state, and the
+ * saves seen before a task is judged at all */
+#ifndef MLFQ_FPU_SLICE_SHARE_PERCENT
+#define MLFQ_FPU_SLICE_SHARE_PERCENT            50U
+#endif
+
+#ifndef MLFQ_FPU_SLICE_MIN_SAVES
+#define MLFQ_FPU_SLICE_MIN_SAVES                32U
+#endif
+
+#if (MLFQ_FPU_SLICE_ENABLED == 1U)
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 0U)
+#error "MLFQ_FPU_SLICE_ENABLED needs TICK_PROFILER_FPU_STATS_ENABLED"
+#endif
+#if (MLFQ_FPU_SLICE_PERCENT < 100U) || (MLFQ_FPU_SLICE_SHARE_PERCENT == 0U) || \
+    (MLFQ_FPU_SLICE_SHARE_PERCENT > 100U)
+#error "MLFQ_FPU_SLICE_PERCENT must be at least 100 and MLFQ_FPU_SLICE_SHARE_PERCENT 1..100"
+#endif
+#endif
+
+/* Boost period auto-tuning (MLFQ_BOOST_AUTOTUNE_ENABLED, aging.h): the
+ * boost period starts from the tunable and adapts to the Low waits. Every
+ * MLFQ_BOOST_AUTOTUNE_CHECK_MS the supervisor takes the longest ready wait
+ * at Low. Once it reaches MLFQ_BOOST_AUTOTUNE_HIGH_PERCENT of the bound
+ * MLFQ_BOOST_AUTOTUNE_BOUND_MS the boost runs at once and the period is
+ * halved; a period whose longest wait stayed under
+ * MLFQ_BOOST_AUTOTUNE_LOW_PERCENT of the bound grows by a quarter. The
+ * period stays within MLFQ_BOOST_PERIOD_MIN_MS..MLFQ_BOOST_PERIOD_MAX_MS */
+#ifndef MLFQ_BOOST_AUTOTUNE_CHECK_MS
+#define MLFQ_BOOST_AUTOTUNE_CHECK_MS            100U
+#endif
+
+#ifndef MLFQ_BOOST_AUTOTUNE_BOUND_MS
+#define MLFQ_BOOST_AUTOTUNE_BOUND_MS            2000U
+#endif
+
+#ifndef MLFQ_BOOST_AUTOTUNE_LOW_PERCENT
+#define MLFQ_BOOST_AUTOTUNE_LOW_PERCENT         50U
+#endif
+
+#ifndef MLFQ_BOOST_AUTOTUNE_HIGH_PERCENT
+#define MLFQ_BOOST_AUTOTUNE_HIGH_PERCENT        80U
+#endif
+
+#if (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+#if (MLFQ_BOOST_AUTOTUNE_LOW_PERCENT >= MLFQ_BOOST_AUTOTUNE_HIGH_PERCENT) || \
+    (MLFQ_BOOST_AUTOTUNE_HIGH_PERCENT > 100U)
+#error "MLFQ_BOOST_AUTOTUNE_LOW_PERCENT < MLFQ_BOOST_AUTOTUNE_HIGH_PERCENT <= 100 required"
+#endif
+#if (MLFQ_BOOST_SLICES > 1U)
+#error "MLFQ_BOOST_AUTOTUNE_ENABLED needs the whole boost (MLFQ_BOOST_SLICES 1)"
+#endif
+#endif
+
+/* Causes of an overload alarm (MLFQ_OverloadStatus_t.causes) */
+#define MLFQ_OVERLOAD_CAUSE_DEMAND              0x01U  /* Levels above Low too busy */
+#define MLFQ_OVERLOAD_CAUSE_STARVATION          0x02U  /* A Low task waited too long */
+
+/* Per-task weights ("nice"): a task's quantum at every level is scaled
+ * by weight / MLFQ_WEIGHT_DEFAULT, and the Low level is shared in rounds
+ * so each CPU-bound Low task gets its scaled quantum per round. A Low
+ * task that has used its quantum waits at MLFQ_WEIGHT_PARK_PRIORITY
+ * until the round ends, running there only while no other Low task is
+ * ready */
+#ifndef MLFQ_WEIGHTS_ENABLED
+#define MLFQ_WEIGHTS_ENABLED                    0U
+#endif
+
+#ifndef MLFQ_WEIGHT_DEFAULT
+#define MLFQ_WEIGHT_DEFAULT                     8U
+#endif
+
+#ifndef MLFQ_WEIGHT_MAX
+#define MLFQ_WEIGHT_MAX                         64U
+#endif
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U) && \
+    ((MLFQ_WEIGHT_DEFAULT == 0U) || (MLFQ_WEIGHT_MAX < MLFQ_WEIGHT_DEFAULT) || (MLFQ_WEIGHT_MAX > 255U))
+#error "MLFQ weights need 0 < MLFQ_WEIGHT_DEFAULT <= MLFQ_WEIGHT_MAX <= 255"
+#endif
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U) && (configUSE_MLFQ_NATIVE == 1)
+#error "MLFQ_WEIGHTS_ENABLED is not supported with configUSE_MLFQ_NATIVE"
+#endif
+
+/* Just below Low; may be the logger's priority, which mostly blocks */
+#define MLFQ_WEIGHT_PARK_PRIORITY               (MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_LOW) - 1U)
+
+/* Task groups: the Low level is shared between groups by their share
+ * first, then between the members of a group by their weights. Each
+ * task's Low quantum is scaled accordingly, so a group that spawns many
+ * tasks gets no more than its share. Group 0 holds every task not put
+ * in a group and gets the share the other groups leave */
+#ifndef MLFQ_GROUPS_ENABLED
+#define MLFQ_GROUPS_ENABLED                     0U
+#endif
+
+#ifndef MLFQ_MAX_GROUPS
+#define MLFQ_MAX_GROUPS                         4U
+#endif
+
+#define MLFQ_GROUP_DEFAULT                      0U
+
+#if (MLFQ_GROUPS_ENABLED == 1U) && (MLFQ_WEIGHTS_ENABLED == 0U)
+#error "MLFQ_GROUPS_ENABLED needs MLFQ_WEIGHTS_ENABLED"
+#endif
+
+#if (MLFQ_GROUPS_ENABLED == 1U) && (MLFQ_MAX_GROUPS < 2U)
+#error "MLFQ_MAX_GROUPS must leave room past the default group"
+#endif
+
+/* Partitions: independent MLFQ instances over the one profiler. Each has
+ * its own priority band, level count, quanta and boost period, and a
+ * boost, demotion or reservation in one never moves the tasks of
+ * another. Partition 0 holds every task not put in one and runs the
+ * level table, the tunables, the global boost and the reservation */
+#ifndef MLFQ_PARTITIONS_ENABLED
+#define MLFQ_PARTITIONS_ENABLED                 0U
+#endif
+
+#ifndef MLFQ_MAX_PARTITIONS
+#define MLFQ_MAX_PARTITIONS                     3U
+#endif
+
+#define MLFQ_PARTITION_DEFAULT                  0U
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U) && (MLFQ_MAX_PARTITIONS < 2U)
+#error "MLFQ_MAX_PARTITIONS must leave room past the default partition"
+#endif
+
+/* A parked weighted task drops below the default partition's Low level,
+ * which may be inside another partition's band */
+#if (MLFQ_PARTITIONS_ENABLED == 1U) && (MLFQ_WEIGHTS_ENABLED == 1U)
+#error "MLFQ_PARTITIONS_ENABLED does not support MLFQ_WEIGHTS_ENABLED"
+#endif
+
+/* Event boosts (MLFQ_EVENT_BOOST_ENABLED, trace_hooks.h): up to
+ * MLFQ_EVENT_BOOST_MAX_BINDINGS queue, semaphore or event group bindings,
+ * each with its own set of tasks. A bound event moves the set's tasks
+ * below High back to High on the next tick, instead of them waiting for
+ * the global boost; the other tasks keep their levels */
+#ifndef MLFQ_EVENT_BOOST_MAX_BINDINGS
+#define MLFQ_EVENT_BOOST_MAX_BINDINGS           8U
+#endif
+
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U) && \
+    ((MLFQ_EVENT_BOOST_MAX_BINDINGS == 0U) || (MLFQ_EVENT_BOOST_MAX_BINDINGS > 32U))
+#error "MLFQ_EVENT_BOOST_MAX_BINDINGS must be 1 .. 32"
+#endif
+
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U) && (SCHED_POLICY != SCHED_POLICY_MLFQ)
+#error "MLFQ_EVENT_BOOST_ENABLED moves tasks between the MLFQ levels"
+#endif
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U) && (SCHED_POLICY != SCHED_POLICY_MLFQ)
+#error "MLFQ_LEVEL_CALLBACKS_ENABLED reports moves between the MLFQ levels"
+#endif
+
+/* Warm start: every MLFQ_WARM_START_SAVE_MS the logger task saves the
+ * deepest level each task reached since the last save, and its
+ * interactivity score, to EEPROM under a hash of the task name. A task
+ * registered under a saved name starts at that level, with a history
+ * that gives that score, instead of at High with none. Needs the
+ * parameter store (param_store.h) and the logger task */
+#ifndef MLFQ_WARM_START_ENABLED
+#define MLFQ_WARM_START_ENABLED                 0U
+#endif
+
+#ifndef MLFQ_WARM_START_SAVE_MS
+#define MLFQ_WARM_START_SAVE_MS                 60000U
+#endif
+
+#if (MLFQ_WARM_START_ENABLED == 1U) && (SCHED_POLICY != SCHED_POLICY_MLFQ)
+#error "MLFQ_WARM_START_ENABLED saves the MLFQ levels"
+#endif
+
+#if (MLFQ_WARM_START_ENABLED == 1U) && (MLFQ_WARM_START_SAVE_MS < 1000U)
+#error "MLFQ_WARM_START_SAVE_MS must be at least 1000 (EEPROM wear)"
+#endif
+
+/* Reports on demand: the periodic queue report, and the level change and
+ * boost records of binary builds, only run while someone reads them. A
+ * reader is "report on" at the console, a host lease renewed with
+ * "watch" (schedulerWatchReports), or the flight recorder, which keeps
+ * its snapshots. "stats" still gives one report. Periodic reporting
+ * starts off, and with no reader the supervisor neither wakes for
+ * reports nor builds them */
+#ifndef MLFQ_REPORT_ON_DEMAND_ENABLED
+#define MLFQ_REPORT_ON_DEMAND_ENABLED           0U
+#endif
+
+/* Lease a plain "watch" gives a host reader, in ms */
+#ifndef MLFQ_REPORT_LEASE_MS
+#define MLFQ_REPORT_LEASE_MS                    10000U
+#endif
+
+/* Bottom halves: handler tasks that an interrupt wakes to finish its
+ * work. Each activation starts at High with the task's own budget in
+ * place of the High quantum (schedulerSetBottomHalf); running past it
+ * demotes the task as usual. After MLFQ_BOTTOM_HALF_STRIKES activations
+ * in a row that overran, the budget is no longer refilled until a boost
+ * brings the task back to High and it finishes an activation there */
+#ifndef MLFQ_BOTTOM_HALF_ENABLED
+#define MLFQ_BOTTOM_HALF_ENABLED                0U
+#endif
+
+#ifndef MLFQ_BOTTOM_HALF_STRIKES
+#define MLFQ_BOTTOM_HALF_STRIKES                3U
+#endif
+
+#if (MLFQ_BOTTOM_HALF_ENABLED == 1U) && \
+    ((MLFQ_BOTTOM_HALF_STRIKES == 0U) || (MLFQ_BOTTOM_HALF_STRIKES > 255U))
+#error "MLFQ_BOTTOM_HALF_STRIKES must be 1 .. 255"
+#endif
+
+/* Per-core runqueues (FreeRTOS SMP): each managed task is homed on one
+ * core with vTaskCoreAffinitySet(), the core with the fewest managed
+ * tasks at registration, so every core runs its own set of MLFQ levels.
+ * Every MLFQ_CORE_BALANCE_MS the least busy core steals one task below
+ * High from the busiest, Low first, when their busy shares differ by
+ * MLFQ_CORE_STEAL_PERCENT or more. High tasks keep their core and cache */
+#ifndef MLFQ_CORE_BALANCE_ENABLED
+#define MLFQ_CORE_BALANCE_ENABLED               0U
+#endif
+
+#ifndef MLFQ_CORE_BALANCE_MS
+#define MLFQ_CORE_BALANCE_MS                    100U
+#endif
+
+#ifndef MLFQ_CORE_STEAL_PERCENT
+#define MLFQ_CORE_STEAL_PERCENT                 25U
+#endif
+
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+#if (TICK_PROFILER_CORES < 2U) || (configUSE_CORE_AFFINITY != 1)
+#error "MLFQ_CORE_BALANCE_ENABLED needs configNUMBER_OF_CORES > 1 and configUSE_CORE_AFFINITY"
+#endif
+#if (SCHED_POLICY != SCHED_POLICY_MLFQ)
+#error "MLFQ_CORE_BALANCE_ENABLED balances the MLFQ levels"
+#endif
+#if (MLFQ_CORE_STEAL_PERCENT == 0U) || (MLFQ_CORE_STEAL_PERCENT > 100U)
+#error "MLFQ_CORE_STEAL_PERCENT must be 1 .. 100"
+#endif
+#endif
+
+/* Clock scaling (MLFQ_CLOCK_SCALING_ENABLED, trace_hooks.h): the core
+ * goes slow on a supervisor pass that finds no task above Low ready, no
+ * sooner than MLFQ_CLOCK_HOLD_MS after it last changed speed */
+#ifndef MLFQ_CLOCK_HOLD_MS
+#define MLFQ_CLOCK_HOLD_MS                      100U
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U) && (SCHED_POLICY != SCHED_POLICY_MLFQ)
+#error "MLFQ_CLOCK_SCALING_ENABLED follows the MLFQ levels"
+#endif
+
+/* The port works out the tickless sleep reload once, at start-up */
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U) && (configUSE_TICKLESS_IDLE == 1)
+#error "MLFQ_CLOCK_SCALING_ENABLED cannot be combined with configUSE_TICKLESS_IDLE"
+#endif
+
+/* Starvation watchdog: the supervisor feeds watchdog timer 0 every
+ * MLFQ_WATCHDOG_CHECK_MS, but only while no registered task has been
+ * ready for MLFQ_WATCHDOG_PROGRESS_MS without getting any CPU time. A
+ * task that stays starved, or a supervisor that stops running, ends in
+ * a reset MLFQ_WATCHDOG_TIMEOUT_MS after the last feed. The bound must
+ * exceed the boost period, which is what normally rescues Low tasks */
+#ifndef MLFQ_WATCHDOG_ENABLED
+#define MLFQ_WATCHDOG_ENABLED                   0U
+#endif
+
+#ifndef MLFQ_WATCHDOG_CHECK_MS
+#define MLFQ_WATCHDOG_CHECK_MS                  100U
+#endif
+
+#ifndef MLFQ_WATCHDOG_PROGRESS_MS
+#define MLFQ_WATCHDOG_PROGRESS_MS               5000U
+#endif
+
+#ifndef MLFQ_WATCHDOG_TIMEOUT_MS
+#define MLFQ_WATCHDOG_TIMEOUT_MS                1000U
+#endif
+
+#if (MLFQ_WATCHDOG_ENABLED == 1U) && \
+    ((MLFQ_WATCHDOG_PROGRESS_MS <= MLFQ_WATCHDOG_CHECK_MS) || \
+     (MLFQ_WATCHDOG_TIMEOUT_MS <= MLFQ_WATCHDOG_CHECK_MS))
+#error "MLFQ_WATCHDOG_PROGRESS_MS and MLFQ_WATCHDOG_TIMEOUT_MS must exceed MLFQ_WATCHDOG_CHECK_MS"
+#endif
+
+/* Score classifier (MLFQ_SCORE_CLASSIFIER_ENABLED, interactivity.h): each
+ * level owns an equal share of the 0..100 score range, and a task only
+ * changes level once its score is this far outside its current share */
+#ifndef MLFQ_SCORE_HYSTERESIS
+#define MLFQ_SCORE_HYSTERESIS                   10U
+#endif
+
+/* The supervisor's periodic policy scan (aging, score classifier and
+ * short-burst promotion); aging leaves it for its timers with the wheel */
+#define MLFQ_POLICY_SCAN_ENABLED                (((MLFQ_AGING_ENABLED == 1U) && \
+                                                  (MLFQ_TIMER_WHEEL_ENABLED == 0U)) || \
+                                                 (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U) || \
+                                                 (MLFQ_BURST_PROMOTION_ENABLED == 1U))
+#ifndef MLFQ_POLICY_SCAN_MS
+#define MLFQ_POLICY_SCAN_MS                     50U
+#endif
+
+/* Keeps the periodic global boost running alongside aging */
+#ifndef MLFQ_AGING_KEEP_GLOBAL_BOOST
+#define MLFQ_AGING_KEEP_GLOBAL_BOOST            0U
+#endif
+
+#if (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U) && (MLFQ_AGING_ENABLED == 1U) && \
+    (MLFQ_AGING_KEEP_GLOBAL_BOOST == 0U)
+#error "MLFQ_BOOST_AUTOTUNE_ENABLED has no boost to tune while aging replaces it"
+#endif
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U) && (MLFQ_AGING_ENABLED == 0U) && \
+    (MLFQ_PREPROMOTE_ENABLED == 0U)
+#error "MLFQ_TIMER_WHEEL_ENABLED needs MLFQ_AGING_ENABLED or MLFQ_PREPROMOTE_ENABLED"
+#endif
+
+/* Converts milliseconds to whole ticks at the build's tick rate */
+#define MLFQ_MS_TO_TICKS(ms)                    (((ms) * configTICK_RATE_HZ) / 1000U)
+
+/* Limits accepted by schedulerSetTunables(); the quantum limit is a
+ * time, so it holds at any tick rate */
+#define MLFQ_BOOST_PERIOD_MIN_MS                100U
+#define MLFQ_BOOST_PERIOD_MAX_MS                60000U
+#define MLFQ_QUANTUM_MAX_MS                     10000U
+#define MLFQ_QUANTUM_MAX_TICKS                  MLFQ_MS_TO_TICKS(MLFQ_QUANTUM_MAX_MS)
+#define MLFQ_QUANTUM_MAX_US                     (MLFQ_QUANTUM_MAX_TICKS * (1000000U / configTICK_RATE_HZ))
+
+/* Time slice values per queue level in milliseconds. The tick values
+ * below are derived from them, so a build at another configTICK_RATE_HZ
+ * (MLFQ_TICK_RATE_HZ) keeps the same quanta; a quantum that is not a
+ * whole number of ticks is rounded down */
+#ifndef MLFQ_TIME_SLICE_HIGH_MS
+#define MLFQ_TIME_SLICE_HIGH_MS                 200U
+#endif
+#ifndef MLFQ_TIME_SLICE_MEDIUM_MS
+#define MLFQ_TIME_SLICE_MEDIUM_MS               500U
+#endif
+#ifndef MLFQ_TIME_SLICE_LOW_MS
+#define MLFQ_TIME_SLICE_LOW_MS                  1000U
+#endif
+
 /* Time slice values assigned per queue level (ticks) */
-#define MLFQ_TIME_SLICE_HIGH                    20U
-#define MLFQ_TIME_SLICE_MEDIUM                  50U
-#define MLFQ_TIME_SLICE_LOW                     100U
+#define MLFQ_TIME_SLICE_HIGH                    MLFQ_MS_TO_TICKS(MLFQ_TIME_SLICE_HIGH_MS)
+#define MLFQ_TIME_SLICE_MEDIUM                  MLFQ_MS_TO_TICKS(MLFQ_TIME_SLICE_MEDIUM_MS)
+#define MLFQ_TIME_SLICE_LOW                     MLFQ_MS_TO_TICKS(MLFQ_TIME_SLICE_LOW_MS)
+
+/* Time slice values per queue level in microseconds, used when quanta are
+ * enforced by the GPTM quantum timer (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED) */
+#ifndef MLFQ_TIME_SLICE_HIGH_US
+#define MLFQ_TIME_SLICE_HIGH_US                 (MLFQ_TIME_SLICE_HIGH * (1000000U / configTICK_RATE_HZ))
+#endif
+#ifndef MLFQ_TIME_SLICE_MEDIUM_US
+#define MLFQ_TIME_SLICE_MEDIUM_US               (MLFQ_TIME_SLICE_MEDIUM * (1000000U / configTICK_RATE_HZ))
+#endif
+#ifndef MLFQ_TIME_SLICE_LOW_US
+#define MLFQ_TIME_SLICE_LOW_US                  (MLFQ_TIME_SLICE_LOW * (1000000U / configTICK_RATE_HZ))
+#endif
+
+/* budget_window_ms of a level (TICK_PROFILER_BUDGET_WINDOW_ENABLED):
+ * MLFQ_BUDGET_KEEP counts the quantum across blocks until the level
+ * changes, MLFQ_BUDGET_RESET_ON_BLOCK refunds it whenever the task blocks,
+ * and any other value halves the used quantum every that many ms. The
+ * values below fill the three-level table; other tables keep the budget
+ * unless MLFQ_LEVEL_TABLE says otherwise */
+#define MLFQ_BUDGET_KEEP                        0U
+#define MLFQ_BUDGET_RESET_ON_BLOCK              TICK_PROFILER_BUDGET_ON_BLOCK
+
+#ifndef MLFQ_BUDGET_WINDOW_HIGH_MS
+#define MLFQ_BUDGET_WINDOW_HIGH_MS              MLFQ_BUDGET_KEEP
+#endif
+#ifndef MLFQ_BUDGET_WINDOW_MEDIUM_MS
+#define MLFQ_BUDGET_WINDOW_MEDIUM_MS            MLFQ_BUDGET_KEEP
+#endif
+#ifndef MLFQ_BUDGET_WINDOW_LOW_MS
+#define MLFQ_BUDGET_WINDOW_LOW_MS               MLFQ_BUDGET_KEEP
+#endif
+
+/* quantum_round_robin of the three-level table. A level set to 1U stops the
+ * kernel's round robin on every tick between its ready tasks
+ * (configUSE_MLFQ_SLICE_CONTROL), so a CPU-bound task keeps the CPU for its
+ * whole quantum; High keeps the tick-by-tick sharing its short bursts want.
+ * Other tables rotate only their lowest level at quantum ends */
+#ifndef MLFQ_QUANTUM_ROUND_ROBIN_HIGH
+#define MLFQ_QUANTUM_ROUND_ROBIN_HIGH           0U
+#endif
+#ifndef MLFQ_QUANTUM_ROUND_ROBIN_MEDIUM
+#define MLFQ_QUANTUM_ROUND_ROBIN_MEDIUM         0U
+#endif
+#ifndef MLFQ_QUANTUM_ROUND_ROBIN_LOW
+#define MLFQ_QUANTUM_ROUND_ROBIN_LOW            1U
+#endif
+
+/* Converts a tick quantum to microseconds */
+#define MLFQ_TICKS_TO_US(ticks)                 ((ticks) * (1000000U / configTICK_RATE_HZ))
+
+/*
+ * Level table. With three levels it is built from the MLFQ_TIME_SLICE_x
+ * values above; with more levels the default quanta double from
+ * MLFQ_TIME_SLICE_HIGH at each level. Either can be replaced by defining
+ * MLFQ_LEVEL_TABLE as a brace list of MLFQ_NUM_LEVELS rows
+ * { quantum_ticks, quantum_us, rtos_priority, starvation_ms,
+ * budget_window_ms, quantum_round_robin }, highest level first; rows
+ * without the last columns keep their budget and the tick round robin.
+ * A starvation_ms of 0 never promotes from that level.
+ */
+#define MLFQ_DEFAULT_LEVEL(level)                                       \
+    { (MLFQ_TIME_SLICE_HIGH << (level)),                                \
+      MLFQ_TICKS_TO_US(MLFQ_TIME_SLICE_HIGH << (level)),                \
+      (MLFQ_TOP_PRIORITY_NUMBER - (level)),                             \
+      (MLFQ_AGING_STEP_MS * (level)),                                   \
+      MLFQ_BUDGET_KEEP,                                                 \
+      (((level) == (MLFQ_NUM_LEVELS - 1U)) ? 1U : 0U) }
 
 /* Generic wait duration used by scheduler logic */
 #define TICKS_TO_BE_WAITED                      (10U)
 
+/* Compile-time check: _Static_assert where the compiler has it, else an
+ * array typedef that fails with a negative size */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define MLFQ_STATIC_ASSERT(cond, name)  _Static_assert((cond), #name)
+#else
+#define MLFQ_STATIC_ASSERT(cond, name)  typedef char name[(cond) ? 1 : -1]
+#endif
+
 /******************************************************************************
- *  FUNCTION PROTOTYPES
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+
+/* Constant per-level parameters, indexed by MLFQ_QueueLevel_t, highest
+ * level first. Defined here rather than in scheduler.c so every file
+ * sees the values: a read at a constant level folds to an immediate,
+ * and a file that never reads the table does not keep a copy. Unsized
+ * so the row count of a custom MLFQ_LEVEL_TABLE is checked below */
+#if defined(MLFQ_LEVEL_TABLE)
+static const MLFQ_LevelConfig_t g_mlfqLevelTable[] = MLFQ_LEVEL_TABLE;
+#elif (MLFQ_NUM_LEVELS == 3U)
+static const MLFQ_LevelConfig_t g_mlfqLevelTable[] =
+{
+    { MLFQ_TIME_SLICE_HIGH,   MLFQ_TIME_SLICE_HIGH_US,   MLFQ_TOP_PRIORITY_NUMBER,      0U,                      MLFQ_BUDGET_WINDOW_HIGH_MS,   MLFQ_QUANTUM_ROUND_ROBIN_HIGH   },
+    { MLFQ_TIME_SLICE_MEDIUM, MLFQ_TIME_SLICE_MEDIUM_US, MLFQ_TOP_PRIORITY_NUMBER - 1U, MLFQ_AGING_STEP_MS,      MLFQ_BUDGET_WINDOW_MEDIUM_MS, MLFQ_QUANTUM_ROUND_ROBIN_MEDIUM },
+    { MLFQ_TIME_SLICE_LOW,    MLFQ_TIME_SLICE_LOW_US,    MLFQ_TOP_PRIORITY_NUMBER - 2U, MLFQ_AGING_STEP_MS * 2U, MLFQ_BUDGET_WINDOW_LOW_MS,    MLFQ_QUANTUM_ROUND_ROBIN_LOW    },
+};
+#else
+static const MLFQ_LevelConfig_t g_mlfqLevelTable[] =
+{
+    MLFQ_DEFAULT_LEVEL(0U),
+    MLFQ_DEFAULT_LEVEL(1U),
+    MLFQ_DEFAULT_LEVEL(2U),
+    MLFQ_DEFAULT_LEVEL(3U),
+#if (MLFQ_NUM_LEVELS > 4U)
+    MLFQ_DEFAULT_LEVEL(4U),
+#endif
+#if (MLFQ_NUM_LEVELS > 5U)
+    MLFQ_DEFAULT_LEVEL(5U),
+#endif
+#if (MLFQ_NUM_LEVELS > 6U)
+    MLFQ_DEFAULT_LEVEL(6U),
+#endif
+#if (MLFQ_NUM_LEVELS > 7U)
+    MLFQ_DEFAULT_LEVEL(7U),
+#endif
+};
+#endif
+
+MLFQ_STATIC_ASSERT((sizeof(g_mlfqLevelTable) / sizeof(g_mlfqLevelTable[0])) == MLFQ_NUM_LEVELS,
+                   mlfq_level_table_has_one_row_per_level);
+
+#if !defined(MLFQ_LEVEL_TABLE)
+/* The built-in tables are checked here; initScheduler() checks a custom
+ * one at run time. Quanta are non-zero, and the lowest level stays above
+ * the metrics logger (tskIDLE_PRIORITY + 1) */
+MLFQ_STATIC_ASSERT((MLFQ_TIME_SLICE_HIGH > 0U) && (MLFQ_TIME_SLICE_HIGH_US > 0U),
+                   mlfq_level_quanta_are_not_zero);
+#if (MLFQ_NUM_LEVELS == 3U)
+MLFQ_STATIC_ASSERT((MLFQ_TIME_SLICE_MEDIUM > 0U) && (MLFQ_TIME_SLICE_LOW > 0U) &&
+                   (MLFQ_TIME_SLICE_MEDIUM_US > 0U) && (MLFQ_TIME_SLICE_LOW_US > 0U),
+                   mlfq_lower_level_quanta_are_not_zero);
+MLFQ_STATIC_ASSERT(MLFQ_TIME_SLICE_LOW <= MLFQ_QUANTUM_MAX_TICKS,
+                   mlfq_level_quanta_are_within_the_limit);
+#endif
+MLFQ_STATIC_ASSERT((MLFQ_TOP_PRIORITY_NUMBER - (MLFQ_NUM_LEVELS - 1U)) > (tskIDLE_PRIORITY + 1U),
+                   mlfq_levels_stay_above_the_logger);
+#endif
+
+/******************************************************************************
+ *  INLINE FUNCTION DEFINITIONS
  ******************************************************************************/
 
 /*
- * Description : Returns the time quantum assigned to a specific MLFQ level.
- * Note        : Declared here for internal consistency with implementation.
+ * Description : Returns the FreeRTOS priority of a level.
  */
-static uint32_t getQuantumForLevel(MLFQ_QueueLevel_t level);
+static inline uint32_t mlfqLevelPriority(MLFQ_QueueLevel_t level)
+{
+    return g_mlfqLevelTable[level].rtos_priority;
+}
+
+/*
+ * Description : Returns the level table's quantum of a level, in ticks
+ *               and in microseconds. The quanta in force are the
+ *               tunables', which start as these.
+ */
+static inline uint32_t mlfqLevelQuantumTicks(MLFQ_QueueLevel_t level)
+{
+    return g_mlfqLevelTable[level].quantum_ticks;
+}
+
+static inline uint32_t mlfqLevelQuantumUs(MLFQ_QueueLevel_t level)
+{
+    return g_mlfqLevelTable[level].quantum_us;
+}
+
+/*
+ * Description : Returns the ready wait after which a task at a level is
+ *               promoted, in core cycles; 0 never promotes.
+ */
+static inline uint32_t mlfqLevelStarvationCycles(MLFQ_QueueLevel_t level)
+{
+    return TICK_PROFILER_US_TO_CYCLES(g_mlfqLevelTable[level].starvation_ms * 1000U);
+}
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
 
 
 /*
@@ -111,6 +1000,221 @@ void initScheduler(void);
  */
 void registerTask(TaskHandle_t task);
 
+/*
+ * Description : Removes a task from the scheduler and frees its slot so
+ *               it can be reused. With MLFQ_AUTO_REGISTER_ENABLED this
+ *               happens automatically when the task is deleted.
+ */
+void unregisterTask(TaskHandle_t task);
+
+/*
+ * Description : Creates a task and registers it as one step. The task is
+ *               created with the kernel suspended and only given its
+ *               MLFQ priority once it holds a profiler slot, so it never
+ *               runs unaccounted. If no slot is free the task is deleted
+ *               again and NULL is returned; it is never left unmanaged
+ *               at High. 'stack' and 'tcb' give static storage, or are
+ *               both NULL to take the task from the heap.
+ */
+TaskHandle_t schedulerCreateTask(TaskFunction_t code, const char *name,
+                                 uint32_t stackWords, void *parameters,
+                                 StackType_t *stack, StaticTask_t *tcb);
+
+#if (TASK_POOL_ENABLED == 1U)
+/*
+ * Description : Creates a worker at the High level from the task pool
+ *               (task_pool.h), with no heap allocation; the create hook
+ *               registers it. Delete it with vTaskDelete() as usual, and
+ *               its block goes back to the pool once the kernel has
+ *               released the TCB. Returns NULL if no block is free in the
+ *               smallest class that fits 'stackWords'.
+ */
+TaskHandle_t schedulerSpawnTask(TaskFunction_t code, const char *name,
+                                uint32_t stackWords, void *parameters);
+#endif
+
+/*
+ * Description : Takes a task out of the MLFQ for good and runs it at a
+ *               fixed priority: inside the real-time band above the
+ *               supervisor, or between the logger task and the Low level.
+ *               Pinned tasks are never demoted, boosted or accounted.
+ *               Returns false if the priority lies in the MLFQ band or
+ *               no pinned slot is left.
+ */
+bool pinTask(TaskHandle_t task, UBaseType_t priority);
+
+/*
+ * Description : Returns the task to normal FreeRTOS handling. The task
+ *               keeps its priority; call registerTask() to rejoin.
+ */
+void unpinTask(TaskHandle_t task);
+
+/*
+ * Description : Checks whether a task is pinned.
+ */
+bool schedulerIsTaskPinned(TaskHandle_t task);
+
+/*
+ * Description : Returns the name of the scheduling policy selected with
+ *               SCHED_POLICY (sched_policy.h), e.g. "MLFQ".
+ */
+const char *schedulerPolicyName(void);
+
+/*
+ * Description : Sets the share of a registered task under the stride and
+ *               lottery policies. Returns false under the MLFQ or if the
+ *               count is outside 1 .. SCHED_POLICY_MAX_TICKETS.
+ */
+bool schedulerSetTickets(TaskHandle_t task, uint32_t tickets);
+
+/*
+ * Description : Declares the wake-to-run latency a registered task needs,
+ *               in microseconds. The task moves to the deepest level that
+ *               can still meet it and is never demoted below that level;
+ *               the boost and aging still lift it. Latency misses are
+ *               counted in the latency report (LATENCY_STATS_ENABLED).
+ *               0 clears the target. Returns false if the task is not
+ *               registered, the target is above MLFQ_LATENCY_TARGET_MAX_US
+ *               or the policy is not the MLFQ.
+ */
+bool schedulerSetLatencyTarget(TaskHandle_t task, uint32_t targetUs);
+
+/*
+ * Description : Sets the weight of a registered task (MLFQ_WEIGHTS_ENABLED).
+ *               MLFQ_WEIGHT_DEFAULT is a normal task; twice that doubles
+ *               its quantum at every level and its share of the Low
+ *               level. The task is still demoted and boosted as usual.
+ *               Returns false if the task is not registered, the weight
+ *               is outside 1 .. MLFQ_WEIGHT_MAX, weights are not built in
+ *               or the policy is not the MLFQ.
+ */
+bool schedulerSetTaskWeight(TaskHandle_t task, uint32_t weight);
+
+/*
+ * Description : Returns the weight of a registered task;
+ *               MLFQ_WEIGHT_DEFAULT when weights are not built in, 0 if
+ *               the task is not registered.
+ */
+uint32_t schedulerGetTaskWeight(TaskHandle_t task);
+
+/*
+ * Description : Creates a task group with a share of the Low level in
+ *               percent (MLFQ_GROUPS_ENABLED). The name must outlive the
+ *               reports. Returns the group id, or -1 if groups are not
+ *               built in, the table is full or the shares would exceed
+ *               100 %.
+ */
+int32_t schedulerCreateGroup(const char *name, uint32_t sharePercent);
+
+/*
+ * Description : Moves a registered task into a group; MLFQ_GROUP_DEFAULT
+ *               takes it out again. Returns false if the task is not
+ *               registered or the group does not exist.
+ */
+bool schedulerSetTaskGroup(TaskHandle_t task, uint32_t group);
+
+/*
+ * Description : Returns the group of the task in a profiler slot.
+ */
+uint32_t schedulerGetSlotGroup(uint32_t slot);
+
+/*
+ * Description : Copies the description of a group. Returns false past
+ *               the last group or when groups are not built in.
+ */
+bool schedulerGetGroupInfo(uint32_t group, MLFQ_GroupInfo_t *output);
+
+/*
+ * Description : Creates an MLFQ partition (MLFQ_PARTITIONS_ENABLED) whose
+ *               High level runs at 'topPriority' and each of its 'levels'
+ *               levels one priority lower. The band must not overlap the
+ *               default partition's or another's and must stay above the
+ *               logger task. Quanta are 'quantumPercent' of the level
+ *               table's; 'boostPeriodMs' of 0 never boosts. The name
+ *               must outlive the reports. Returns the partition id, or -1.
+ */
+int32_t schedulerCreatePartition(const char *name, uint32_t topPriority, uint32_t levels,
+                                 uint32_t quantumPercent, uint32_t boostPeriodMs);
+
+/*
+ * Description : Moves a registered task into a partition at its High
+ *               level; MLFQ_PARTITION_DEFAULT takes it out again. Returns
+ *               false if the task is not registered or the partition does
+ *               not exist.
+ */
+bool schedulerSetTaskPartition(TaskHandle_t task, uint32_t partition);
+
+/*
+ * Description : Returns the partition of the task in a profiler slot.
+ */
+uint32_t schedulerGetSlotPartition(uint32_t slot);
+
+/*
+ * Description : Copies the description of a partition. Returns false
+ *               past the last one or when partitions are not built in.
+ */
+bool schedulerGetPartitionInfo(uint32_t partition, MLFQ_PartitionInfo_t *output);
+
+/*
+ * Description : Copies the runqueue of one core. Returns false past the
+ *               last core or when MLFQ_CORE_BALANCE_ENABLED is off.
+ */
+bool schedulerGetCoreStats(uint32_t core, MLFQ_CoreStats_t *output);
+
+/*
+ * Description : Returns the number of tasks moved between cores since
+ *               init (0 without MLFQ_CORE_BALANCE_ENABLED).
+ */
+uint32_t schedulerGetMigrationCount(void);
+
+/*
+ * Description : Gives a registered task a relative deadline in ms for
+ *               earliest-deadline-first ordering within the High level
+ *               (configUSE_MLFQ_EDF). Every time the task becomes ready,
+ *               its job is due that much later, and while it is at High
+ *               it runs ahead of any High task due later or without a
+ *               deadline. Quantum expiry still demotes it; at the lower
+ *               levels it is scheduled as usual. 0 clears the deadline.
+ *               Returns false if the task is not registered or EDF is
+ *               not built in.
+ */
+bool schedulerSetDeadline(TaskHandle_t task, uint32_t deadlineMs);
+
+/*
+ * Description : Makes a registered task a bottom half with a High budget
+ *               in microseconds (MLFQ_BOTTOM_HALF_ENABLED). The task moves
+ *               to High at once and must wait for its interrupt with
+ *               schedulerBottomHalfWait(), which refills the budget for
+ *               the next activation. 0 makes it an ordinary task again.
+ *               Returns false if the task is not registered, the budget
+ *               exceeds the High quantum, bottom halves are not built in
+ *               or the policy is not the MLFQ.
+ */
+bool schedulerSetBottomHalf(TaskHandle_t task, uint32_t budgetUs);
+
+/*
+ * Description : Ends the current activation of the calling bottom half
+ *               and waits up to xTicksToWait for its task notification,
+ *               as ulTaskNotifyTake(pdTRUE, ...) does, returning the
+ *               notification value. The task goes back to High with a
+ *               full budget before it blocks. Any other task just waits.
+ *               Work deferred with xTimerPendFunctionCallFromISR() runs in
+ *               the timer service task; notify a handler task instead to
+ *               make it a bottom half.
+ */
+uint32_t schedulerBottomHalfWait(TickType_t xTicksToWait);
+
+/*
+ * Description : Ends the current burst of the calling task and yields to
+ *               the next ready task of its level, without sleeping
+ *               (MLFQ_YIELD_BURST_ENABLED). The task stays ready, but the
+ *               burst statistics, short-burst promotion and the budget
+ *               refund count the burst as closed by a block. For batch
+ *               work that can stop between chunks; otherwise a plain
+ *               taskYIELD().
+ */
+void schedulerYieldBurst(void);
+
 /*
  * Description : Updates a tasks MLFQ level and synchronizes its
  *               FreeRTOS priority and runtime statistics.
@@ -118,7 +1222,8 @@ void registerTask(TaskHandle_t task);
 void updateTaskPriority(TaskHandle_t task, MLFQ_QueueLevel_t newLevel);
 
 /*
- * Description : Demotes a task after it exhausts its time quantum.
+ * Description : Demotes the task in a profiler slot after it exhausts
+ *               its time quantum.
  */
 void checkForDemotion(uint8_t table_index);
 
@@ -127,18 +1232,222 @@ void checkForDemotion(uint8_t table_index);
  */
 void performGlobalBoost(void);
 
+/*
+ * Description : Copies the global boost cost metrics.
+ */
+void schedulerGetBoostStats(MLFQ_BoostStats_t *output);
+
+/*
+ * Description : Copies the clock scaling counters; all but the clock are
+ *               0 when clock scaling is not built in.
+ */
+void schedulerGetClockStats(MLFQ_ClockStats_t *output);
+
+/*
+ * Description : Returns the number of demotions since init. Wraps;
+ *               callers take differences.
+ */
+uint32_t schedulerGetDemotionCount(void);
+
+/*
+ * Description : Returns the number of periodic tasks moved to High just
+ *               before their expected wake (MLFQ_PREPROMOTE_ENABLED)
+ *               since init. Wraps.
+ */
+uint32_t schedulerGetPrePromotionCount(void);
+
+/*
+ * Description : Binds a registered task to a queue, semaphore or event
+ *               group (MLFQ_EVENT_BOOST_ENABLED). A send or give to the
+ *               object, or a set of any of 'bits' of the event group,
+ *               moves the task back to High if it is below; 'bits' of 0
+ *               fires on every send, give or set. Calls with the same
+ *               object and bits add to one binding. Returns false if the
+ *               task is not registered or every binding is taken.
+ */
+bool schedulerBindEventBoost(const void *object, uint32_t bits, TaskHandle_t task);
+
+/*
+ * Description : Frees every binding of an object. Call it before the
+ *               object is deleted.
+ */
+void schedulerUnbindEventBoost(const void *object);
+
+/*
+ * Description : Returns the number of tasks moved to High by a bound
+ *               event since init. Wraps.
+ */
+uint32_t schedulerGetEventBoostCount(void);
+
+/*
+ * Description : Installs the level-change callback of a registered task
+ *               (MLFQ_LEVEL_CALLBACKS_ENABLED), or removes it with NULL.
+ *               Changes between two supervisor passes are folded into
+ *               one call, and none is made if the task ends where it
+ *               started. Returns false if the task is not registered or
+ *               callbacks are not built in.
+ */
+bool schedulerSetLevelCallback(TaskHandle_t task, MLFQ_LevelCallback_t callback, void *context);
+
+/*
+ * Description : Copies the applied and coalesced level change counts.
+ */
+void schedulerGetLevelChangeStats(MLFQ_LevelChangeStats_t *output);
+
+/*
+ * Description : Copies the scheduler's own activity counters.
+ */
+void schedulerGetSelfMetrics(MLFQ_SelfMetrics_t *output);
+
+/*
+ * Description : Copies the expiry-to-demotion latency metrics. Expiries
+ *               the kernel applies itself (configUSE_MLFQ_NATIVE) never
+ *               reach the supervisor and are not counted.
+ */
+void schedulerGetExpiryLatencyStats(MLFQ_ExpiryLatencyStats_t *output);
+
+/*
+ * Description : Clears the expiry latency metrics.
+ */
+void schedulerResetExpiryLatencyStats(void);
+
+/*
+ * Description : Copies the overload state (MLFQ_OVERLOAD_ENABLED). Returns
+ *               false when overload detection is not built in.
+ */
+bool schedulerGetOverloadStatus(MLFQ_OverloadStatus_t *output);
+
+/*
+ * Description : Installs the function called on every overload alarm,
+ *               or removes it with NULL.
+ */
+void schedulerSetOverloadHook(MLFQ_OverloadHook_t hook);
+
+/*
+ * Description : Returns the number of managed tasks at a level. Kept in
+ *               step with every level change, so reading it is O(1).
+ */
+uint32_t schedulerGetLevelPopulation(MLFQ_QueueLevel_t level);
+
+/*
+ * Description : Copies up to maxSlots profiler slots of the tasks at a
+ *               level into slots and returns how many were written.
+ */
+uint32_t schedulerGetLevelMembers(MLFQ_QueueLevel_t level, uint32_t *slots,
+                                  uint32_t maxSlots);
+
+/*
+ * Description : Returns one bit per MLFQ level (bit 0 = High) that has a
+ *               task in its ready list, read from the kernel's ready
+ *               priority bitmap. Without port-optimised task selection
+ *               every level is reported as ready.
+ */
+uint32_t schedulerGetReadyLevels(void);
+
+/*
+ * Description : Copies the scheduler parameters currently in force.
+ */
+void schedulerGetTunables(MLFQ_Tunables_t *output);
+
+/*
+ * Description : Validates a new parameter set and hands it to the
+ *               supervisor, which applies it between scheduling passes.
+ *               Before the supervisor runs it is applied immediately.
+ *               Returns false (nothing changed) if a value is out of range.
+ */
+bool schedulerSetTunables(const MLFQ_Tunables_t *input);
+
+/*
+ * Description : Asks the supervisor for a queue report on its next pass,
+ *               regardless of the periodic reporting setting.
+ */
+void schedulerRequestReport(void);
+
+/*
+ * Description : Keeps the periodic reports running for 'leaseMs' from
+ *               now (MLFQ_REPORT_ON_DEMAND_ENABLED), for a host reader
+ *               that renews the lease while it is attached. 0 ends the
+ *               lease. Nothing in builds without on-demand reports.
+ */
+void schedulerWatchReports(uint32_t leaseMs);
+
+/*
+ * Description : Limits the default partition to its first 'levels'
+ *               levels: demotion stops at level levels - 1, and the
+ *               supervisor moves the tasks below it up on its next pass.
+ *               The level table and quanta are unchanged, so a count is
+ *               a run-time stand-in for a build with fewer levels. Not
+ *               saved with the parameters. Returns false outside
+ *               1 .. MLFQ_NUM_LEVELS.
+ */
+bool schedulerSetLevelCount(uint32_t levels);
+
+/*
+ * Description : Returns the levels in use in the default partition.
+ */
+uint32_t schedulerGetLevelCount(void);
+
+/*
+ * Description : Saves the learned level and score of every registered
+ *               task when a save is due (MLFQ_WARM_START_ENABLED), and
+ *               only if they differ from what is stored. Called by the
+ *               logger task, which can take the EEPROM programming time.
+ *               Returns the ticks until the next save; portMAX_DELAY
+ *               when warm start is off.
+ */
+TickType_t schedulerWarmStartService(void);
+
 /*
  * Description : Main scheduler task responsible for handling demotion,
  *               boosting, and reporting logic.
  */
 void schedulerTask(void* pvParameters);
 
+/*
+ * Description : Starts the supervisor in the timer service task, in place
+ *               of creating schedulerTask (configUSE_MLFQ_TIMER_SUPERVISOR).
+ *               Call once before vTaskStartScheduler(). Returns false if
+ *               the timer cannot be created.
+ */
+bool schedulerStartTimerSupervisor(void);
+
+/*
+ * Description : Wakes the supervisor for a pass. Called by the tick hook
+ *               on quantum expiry.
+ */
+void schedulerWakeFromISR(BaseType_t *pxHigherPriorityTaskWoken);
+
+/*
+ * Description : Returns the level of the running task, for drivers that
+ *               decide in an interrupt whether to wake a handler now or
+ *               batch the work. MLFQ_NUMBER_QUEUES if the task is not
+ *               managed (supervisor, logger, idle, pinned tasks). A few
+ *               loads, no lock; safe from any interrupt.
+ */
+MLFQ_QueueLevel_t schedulerGetCurrentLevelFromISR(void);
+
+/*
+ * Description : Returns the quantum the running task has left, in
+ *               microseconds (whole ticks' worth without cycle
+ *               accounting); 0 once it is used up, UINT32_MAX if the
+ *               task is not managed or has no quantum. A few loads, no
+ *               lock; safe from any interrupt.
+ */
+uint32_t schedulerGetRemainingBudgetFromISR(void);
+
 /*
  * Description : Retrieves scheduler and profiling information for a task
- *               indexed in the internal task table.
+ *               indexed by its slot in the shared profiler table.
  */
 bool schedulerGetTaskStats(uint32_t index, MLFQ_Task_Profiler_t *output);
 
+/*
+ * Description : Copies the stats of all registered tasks as one consistent
+ *               view. Lock-free on the read side (the profiler table is a
+ *               seqlock); call from task context.
+ */
+void schedulerGetStatsSnapshot(MLFQ_StatsSnapshot_t *output);
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
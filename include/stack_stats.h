@@ -0,0 +1,96 @@
+/******************************************************************************
+ *  MODULE NAME  : Stack Statistics
+ *  FILE         : stack_stats.h
+ *  DESCRIPTION  : Records the stack depth of every task as the kernel
+ *                 creates it and samples the stack high-water marks for
+ *                 the reports, with a suggested depth per task. Included
+ *                 from trace_hooks.h, so it must not pull in any FreeRTOS
+ *                 header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef STACK_STATS_H_
+#define STACK_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Stack high-water-mark reporting; set to 0U to compile the hooks out */
+#ifndef STACK_STATS_ENABLED
+#define STACK_STATS_ENABLED          1U
+#endif
+
+/* Tasks tracked: the registered tasks plus the system tasks (idle,
+ * Scheduler, Logger, Console, timer service) */
+#ifndef STACK_STATS_MAX_TASKS
+#define STACK_STATS_MAX_TASKS        24U
+#endif
+
+/* Headroom added to the deepest use seen when suggesting a depth */
+#ifndef STACK_STATS_MARGIN_PERCENT
+#define STACK_STATS_MARGIN_PERCENT   25U
+#endif
+
+/* Suggested depths are rounded up to a multiple of this many words */
+#ifndef STACK_STATS_ROUND_WORDS
+#define STACK_STATS_ROUND_WORDS      16U
+#endif
+
+/* Task name bytes kept with a sample, including the terminator */
+#ifndef STACK_STATS_NAME_LENGTH
+#define STACK_STATS_NAME_LENGTH      16U
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Stack figures of one task, in words (StackType_t).
+ */
+typedef struct
+{
+    void     *task;            /* Task handle */
+    uint32_t  size_words;      /* Depth the task was created with */
+    uint32_t  min_free_words;  /* High-water mark: least free ever */
+    uint32_t  suggested_words; /* Deepest use plus the margin, rounded */
+    char      name[STACK_STATS_NAME_LENGTH]; /* Copied while the task is alive */
+} StackStats_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (STACK_STATS_ENABLED == 1U)
+/* Description : Records the depth of a task being created (traceTASK_CREATE) */
+void stackStatsTaskCreated(void *task, uint32_t depthWords);
+
+/* Description : Forgets a task being deleted (traceTASK_DELETE) */
+void stackStatsTaskDeleted(void *task);
+
+/* Description : Number of tracked tasks */
+uint32_t stackStatsGetCount(void);
+
+/* Description : Samples the high-water mark of the task at a position of
+ *               the table. Walks the task's stack; call from task context.
+ *               Returns false past the end */
+bool stackStatsSample(uint32_t index, StackStats_t *output);
+#endif
+
+#endif /* STACK_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
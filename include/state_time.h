@@ -0,0 +1,83 @@
+/******************************************************************************
+ *  MODULE NAME  : Task State Time
+ *  FILE         : state_time.h
+ *  DESCRIPTION  : Splits the life of each registered task into time
+ *                 running, time ready but not running, and time blocked
+ *                 or suspended, from the kernel's switch and ready hooks.
+ *                 The queue report's Wait column mixes the last two;
+ *                 ready time alone is the delay the scheduler causes.
+ *                 Included from trace_hooks.h, so it must not pull in any
+ *                 FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef STATE_TIME_H_
+#define STATE_TIME_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Running / ready / blocked time per task */
+#ifndef STATE_TIME_ENABLED
+#define STATE_TIME_ENABLED           0U
+#endif
+
+/* Task states, and the index of each in StateTimeSummary_t */
+#define STATE_TIME_RUNNING           0U
+#define STATE_TIME_READY             1U
+#define STATE_TIME_BLOCKED           2U  /* Blocked, delayed or suspended */
+#define STATE_TIME_STATES            3U
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Time of one task in each state since registration, in
+ *               core cycles, the current state counted up to the read.
+ */
+typedef struct
+{
+    uint64_t cycles[STATE_TIME_STATES];
+    uint8_t  state;          /* Current STATE_TIME_* state */
+} StateTimeSummary_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (STATE_TIME_ENABLED == 1U)
+/* Description : The task switched in starts running */
+void stateTimeSwitchedIn(void *task);
+
+/* Description : The task switched out is ready if preempted, else blocked */
+void stateTimeSwitchedOut(void *task, bool stillReady);
+
+/* Description : A task was moved to a ready list; ends a blocked spell */
+void stateTimeTaskReady(void *task);
+
+/* Description : Copies the totals of a profiler slot. False if the slot
+ *               is out of range */
+bool stateTimeGetTask(uint32_t slot, StateTimeSummary_t *output);
+
+/* Description : Clears a slot and starts it in the task's current state */
+void stateTimeResetTask(uint32_t slot, void *task);
+#endif
+
+#endif /* STATE_TIME_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
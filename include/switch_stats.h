@@ -0,0 +1,70 @@
+/******************************************************************************
+ *  MODULE NAME  : Context Switch Statistics
+ *  FILE         : switch_stats.h
+ *  DESCRIPTION  : Cycle cost of the kernel's task selection, measured from
+ *                 the last switch-out hook to the first switch-in hook of
+ *                 every context switch. Included from trace_hooks.h, so it
+ *                 must not pull in any FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef SWITCH_STATS_H_
+#define SWITCH_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Context switch cost measurement; set to 1U for benchmark builds */
+#ifndef SWITCH_STATS_ENABLED
+#define SWITCH_STATS_ENABLED         0U
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Task selection cost since the last reset, in core cycles.
+ *               Covers the stack check and taskSELECT_HIGHEST_PRIORITY_TASK
+ *               in vTaskSwitchContext, not the register save and restore.
+ */
+typedef struct
+{
+    uint32_t samples;
+    uint32_t min_cycles;
+    uint32_t mean_cycles;
+    uint32_t max_cycles;
+} SwitchStatsSummary_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (SWITCH_STATS_ENABLED == 1U)
+/* Description : Stamps the end of the switch-out hooks */
+void switchStatsSwitchedOut(void);
+
+/* Description : Charges the cycles since the switch-out stamp */
+void switchStatsSwitchedIn(void);
+
+/* Description : Copies the figures gathered since the last reset */
+void switchStatsGetSummary(SwitchStatsSummary_t *output);
+
+/* Description : Starts a new measurement window */
+void switchStatsReset(void);
+#endif
+
+#endif /* SWITCH_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
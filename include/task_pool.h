@@ -0,0 +1,102 @@
+/******************************************************************************
+ *  MODULE NAME  : Task Pool
+ *  FILE         : task_pool.h
+ *  DESCRIPTION  : Fixed-block pool of task control blocks and stacks for
+ *                 worker tasks spawned and deleted at run time, in two
+ *                 stack size classes with O(1) take and release. Included
+ *                 from trace_hooks.h, so it must not pull in any FreeRTOS
+ *                 header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef TASK_POOL_H_
+#define TASK_POOL_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Pool for schedulerSpawnTask(); set to 1U to reserve the blocks */
+#ifndef TASK_POOL_ENABLED
+#define TASK_POOL_ENABLED            0U
+#endif
+
+/* Small class: stack depth in words and number of blocks */
+#ifndef TASK_POOL_SMALL_WORDS
+#define TASK_POOL_SMALL_WORDS        128U
+#endif
+
+#ifndef TASK_POOL_SMALL_BLOCKS
+#define TASK_POOL_SMALL_BLOCKS       4U
+#endif
+
+/* Large class: stack depth in words and number of blocks */
+#ifndef TASK_POOL_LARGE_WORDS
+#define TASK_POOL_LARGE_WORDS        384U
+#endif
+
+#ifndef TASK_POOL_LARGE_BLOCKS
+#define TASK_POOL_LARGE_BLOCKS       2U
+#endif
+
+/* Size classes, smallest first */
+#define TASK_POOL_CLASSES            2U
+
+#if (TASK_POOL_SMALL_WORDS >= TASK_POOL_LARGE_WORDS)
+#error "TASK_POOL_SMALL_WORDS must be below TASK_POOL_LARGE_WORDS"
+#endif
+
+#if (TASK_POOL_SMALL_BLOCKS > 254U) || (TASK_POOL_LARGE_BLOCKS > 254U)
+#error "A task pool class holds at most 254 blocks"
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Usage of one size class.
+ */
+typedef struct
+{
+    uint32_t stack_words;  /* Stack depth of every block in the class */
+    uint32_t blocks;       /* Blocks in the class */
+    uint32_t in_use;       /* Blocks held by live or not yet cleaned up tasks */
+    uint32_t peak;         /* Most blocks ever in use at once */
+    uint32_t takes;        /* Blocks handed out since boot */
+    uint32_t failures;     /* Requests this class was chosen for but was full */
+} TaskPoolStats_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (TASK_POOL_ENABLED == 1U)
+/* Description : Takes a block from the smallest class whose stack holds
+ *               'stackWords'. The TCB and stack are StaticTask_t and
+ *               StackType_t buffers for xTaskCreateStatic(). Returns false
+ *               if the request is too large or the class is exhausted */
+bool taskPoolTake(uint32_t stackWords, void **tcb, void **stack, uint32_t *depthWords);
+
+/* Description : Returns the block of a TCB to its class; other TCBs are
+ *               ignored. Called from portCLEAN_UP_TCB once the kernel is
+ *               done with the TCB */
+void taskPoolRelease(void *tcb);
+
+/* Description : Copies the usage of a class. Returns false past the end */
+bool taskPoolGetStats(uint32_t sizeClass, TaskPoolStats_t *output);
+#endif
+
+#endif /* TASK_POOL_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
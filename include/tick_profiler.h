@@ -1,93 +1,408 @@
-/******************************************************************************
- *  MODULE NAME  : Tick Profiler
- *  FILE         : tick_profiler.h
- *  DESCRIPTION  : Public API for tracking task runtime using FreeRTOS tick hook.
- *  AUTHOR       : Elham Karam
- *  DATE CREATED : December 2025
- ******************************************************************************/
-
-#ifndef TICK_PROFILER_H
-#define TICK_PROFILER_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/******************************************************************************
- *  INCLUDES
- ******************************************************************************/
-
-#include "FreeRTOS.h"   /* FreeRTOS base definitions */
-#include "task.h"       /* Task services */
-#include "queue.h"      /* Queue services */
-#include <stdint.h>     /* Fixed-width integer types */
-#include <stdbool.h>    /* Boolean type */
-
-/******************************************************************************
- *  MACRO DEFINITIONS AND CONFIGURATIONS
- ******************************************************************************/
-
-/* Maximum number of tasks that can be profiled */
-#ifndef TICK_PROFILER_MAX_TASKS
-#define TICK_PROFILER_MAX_TASKS    16U
-#endif
-
-/* Enables expired quantum queue support */
-#ifndef TICK_PROFILER_EXPIRED_QUEUE_ENABLED
-#define TICK_PROFILER_EXPIRED_QUEUE_ENABLED  1U
-#endif
-
-/* Length of the expired quantum queue */
-#ifndef TICK_PROFILER_EXPIRED_QUEUE_LENGTH
-#define TICK_PROFILER_EXPIRED_QUEUE_LENGTH   (TICK_PROFILER_MAX_TASKS * 2U)
-#endif
-
-/******************************************************************************
- *  TYPE DEFINITIONS
- ******************************************************************************/
-
-/* Structure holding per-task runtime statistics */
-typedef struct
-{
-    TaskHandle_t task;        /* Associated FreeRTOS task */
-    uint32_t     run_ticks;   /* Total execution time in ticks */
-    uint32_t     quantum_ticks; /* Assigned execution quantum */
-} TickProfilerTaskInfo_t;
-
-/******************************************************************************
- *  FUNCTION PROTOTYPES
- ******************************************************************************/
-
-/* Initializes the tick profiler module */
-bool tickProfilerInit(void);
-
-/* Registers a task for runtime profiling */
-bool setupTaskStats(TaskHandle_t task);
-
-/* Assigns a time quantum to a task */
-bool setTaskQuantum(TaskHandle_t task, uint32_t quantumTicks);
-
-/* Retrieves the runtime of a task */
-uint32_t getTaskRuntime(TaskHandle_t task);
-
-/* Resets the runtime counter of a task */
-bool resetTaskRuntime(TaskHandle_t task);
-
-/* Sets the scheduler task handle for ISR notification */
-void tickProfilerSetSchedulerTaskHandle(TaskHandle_t schedulerHandle);
-
-/* Returns the queue containing expired tasks */
-QueueHandle_t tickProfilerGetExpiredQueue(void);
-
-/* FreeRTOS tick hook implementation */
-void vApplicationTickHook(void);
-
-#ifdef __cplusplus
-}
-#endif
-
-/******************************************************************************
- *  END OF FILE
- ******************************************************************************/
-
-#endif /* TICK_PROFILER_H */
+/******************************************************************************
+ *  MODULE NAME  : Tick Profiler
+ *  FILE         : tick_profiler.h
+ *  DESCRIPTION  : Public API for tracking task runtime using FreeRTOS tick hook.
+ *  AUTHOR       : Elham Karam
+ *  DATE CREATED : December 2025
+ ******************************************************************************/
+
+#ifndef TICK_PROFILER_H
+#define TICK_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+
+#include "FreeRTOS.h"   /* FreeRTOS base definitions */
+#include "task.h"       /* Task services */
+#include "queue.h"      /* Queue services */
+#include <stdint.h>     /* Fixed-width integer types */
+#include <stdbool.h>    /* Boolean type */
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Maximum number of tasks that can be profiled. Loops visit only the
+ * registered slots, so large tables cost memory, not scan time. */
+#ifndef TICK_PROFILER_MAX_TASKS
+#define TICK_PROFILER_MAX_TASKS    16U
+#endif
+
+/* Slots travel as one byte (trace entries, binary records), 0xFF = none */
+#if (TICK_PROFILER_MAX_TASKS > 254U)
+#error "TICK_PROFILER_MAX_TASKS must fit in a byte below 0xFF"
+#endif
+
+/* Number of 32-bit words needed to hold one bit per slot */
+#define TICK_PROFILER_SLOT_MASK_WORDS      ((TICK_PROFILER_MAX_TASKS + 31U) / 32U)
+
+/* Levels tracked by the per-level membership sets; records at a level
+ * at or above this are kept out of every set */
+#ifndef TICK_PROFILER_MAX_LEVELS
+#define TICK_PROFILER_MAX_LEVELS   8U
+#endif
+
+/* Enables expired quantum queue support */
+#ifndef TICK_PROFILER_EXPIRED_QUEUE_ENABLED
+#define TICK_PROFILER_EXPIRED_QUEUE_ENABLED  1U
+#endif
+
+/* Enables expired-slot bitmask support (replaces the queue on the hot path) */
+#ifndef TICK_PROFILER_EXPIRED_MASK_ENABLED
+#define TICK_PROFILER_EXPIRED_MASK_ENABLED   0U
+#endif
+
+#if (TICK_PROFILER_EXPIRED_QUEUE_ENABLED == 1U) && (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U)
+#error "Select either the expired queue or the expired mask, not both"
+#endif
+
+/* Number of 32-bit words needed to hold one expiry bit per slot */
+#define TICK_PROFILER_EXPIRED_MASK_WORDS   TICK_PROFILER_SLOT_MASK_WORDS
+
+/* Count-leading-zeros primitive used to walk expiry masks */
+#ifndef TICK_PROFILER_CLZ
+#define TICK_PROFILER_CLZ(x)               __clz(x)
+#endif
+
+/* Orders the table sequence counter against the record accesses */
+#ifndef TICK_PROFILER_MEMORY_BARRIER
+#define TICK_PROFILER_MEMORY_BARRIER()     __asm(" dmb")
+#endif
+
+/* Cores accounted for: every core of a FreeRTOS SMP kernel
+ * (configNUMBER_OF_CORES, FreeRTOS V11 onwards), otherwise the one core */
+#if defined(configNUMBER_OF_CORES)
+#define TICK_PROFILER_CORES                configNUMBER_OF_CORES
+#else
+#define TICK_PROFILER_CORES                1U
+#endif
+
+/* On SMP the tick hook charges the task running on every core. The
+ * cycle-accounting switch hooks keep one charge window against the local
+ * cycle counter, and the native kernel patch and the tick step assume a
+ * single core, so those stay single-core features */
+#if (TICK_PROFILER_CORES > 1U)
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+#error "TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED is single-core; use tick accounting with configNUMBER_OF_CORES > 1"
+#endif
+#if (configUSE_MLFQ_NATIVE == 1)
+#error "configUSE_MLFQ_NATIVE patches the single-core kernel"
+#endif
+#if (configUSE_TICKLESS_IDLE == 1)
+#error "configUSE_TICKLESS_IDLE is not supported with configNUMBER_OF_CORES > 1"
+#endif
+#endif
+
+/* Cycle-based accounting (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED) is
+ * configured in trace_hooks.h because the kernel trace macros depend on it */
+
+/* Core cycles in one RTOS tick, used to express quanta in cycles */
+#define TICK_PROFILER_CYCLES_PER_TICK  ((uint32_t)(configCPU_CLOCK_HZ / configTICK_RATE_HZ))
+
+/* Enforces quanta with a GPTM one-shot armed at every context switch with
+ * the incoming task's remaining budget (requires cycle accounting) */
+#ifndef TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED
+#define TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED  0U
+#endif
+
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U) && (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 0U)
+#error "TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED requires TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED"
+#endif
+
+/* Compact accounting, for tables of a hundred tasks or more on small
+ * parts: the run and quantum of each record shrink to 16 bits and
+ * saturate, the lifetime total to 32 bits of ticks, and the stamp behind
+ * the expiry latency metrics is dropped. A record takes 20 bytes instead
+ * of 32 with the optional fields off. */
+#ifndef TICK_PROFILER_COMPACT_ENABLED
+#define TICK_PROFILER_COMPACT_ENABLED  0U
+#endif
+
+#if (TICK_PROFILER_COMPACT_ENABLED == 1U) && (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+#error "TICK_PROFILER_COMPACT_ENABLED keeps totals in ticks; disable TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED"
+#endif
+
+/* Longest run or quantum a record holds, in ticks; longer quanta are
+ * clamped to it */
+#if (TICK_PROFILER_COMPACT_ENABLED == 1U)
+#define TICK_PROFILER_TICKS_MAX    0xFFFFU
+#else
+#define TICK_PROFILER_TICKS_MAX    0xFFFFFFFFU
+#endif
+
+/* Converts a duration in microseconds to core cycles */
+#define TICK_PROFILER_US_TO_CYCLES(us)  ((uint32_t)(((uint64_t)(us) * configCPU_CLOCK_HZ) / 1000000ULL))
+
+/* Thread local storage slot holding a pointer to the task's profiler record */
+#ifndef TICK_PROFILER_TLS_INDEX
+#define TICK_PROFILER_TLS_INDEX    0
+#endif
+
+#if (TICK_PROFILER_TLS_INDEX >= configNUM_THREAD_LOCAL_STORAGE_POINTERS)
+#error "TICK_PROFILER_TLS_INDEX must be below configNUM_THREAD_LOCAL_STORAGE_POINTERS"
+#endif
+
+/* Budget window of a level whose quantum is refunded on every block
+ * (tickProfilerSetBudgetWindow); 0 keeps the budget until it is reset */
+#define TICK_PROFILER_BUDGET_ON_BLOCK        0xFFFFFFFFU
+
+/* Length of the expired quantum queue */
+#ifndef TICK_PROFILER_EXPIRED_QUEUE_LENGTH
+#define TICK_PROFILER_EXPIRED_QUEUE_LENGTH   (TICK_PROFILER_MAX_TASKS * 2U)
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/* Width of the run and quantum fields and of the lifetime total */
+#if (TICK_PROFILER_COMPACT_ENABLED == 1U)
+typedef uint16_t TickProfilerTicks_t;
+typedef uint32_t TickProfilerTotal_t;
+#else
+typedef uint32_t TickProfilerTicks_t;
+typedef uint64_t TickProfilerTotal_t;
+#endif
+
+/*
+ * Structure holding the per-task record shared by the profiler and the
+ * scheduler. Words touched by the tick hook come first; the byte-sized
+ * scheduler state and flags are packed at the end.
+ */
+typedef struct
+{
+    /* Touched by the tick and switch hooks: keep these together at the
+     * front so the ISR reads one run of consecutive words */
+    TaskHandle_t task;        /* Associated FreeRTOS task */
+    TickProfilerTicks_t run_ticks;     /* Total execution time in ticks */
+    TickProfilerTicks_t quantum_ticks; /* Assigned execution quantum */
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    uint32_t     run_cycles;      /* Cycles consumed in the current quantum */
+    uint32_t     quantum_cycles;  /* Quantum converted to core cycles */
+#endif
+    uint8_t      level;           /* Scheduler queue level (owned by scheduler) */
+    bool         expiry_reported; /* Expiry of this quantum already sent */
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U)
+    uint8_t      block_reason;    /* TICK_PROFILER_BLOCK_* of the last block */
+#endif
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    bool         expiry_pending;  /* Expired at switch-out, report on tick */
+#endif
+    TickProfilerTotal_t total_time; /* CPU time since registration (ticks, or
+                                   * cycles with cycle accounting), or the
+                                   * kernel run-time counter at registration
+                                   * with configGENERATE_RUN_TIME_STATS;
+                                   * read it with tickProfilerGetTotalTime() */
+#if (TICK_PROFILER_COMPACT_ENABLED == 0U)
+    uint32_t     expiry_cycle;    /* Cycle counter when the last expiry was
+                                   * reported, for the expiry latency */
+#endif
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+    TickType_t   budget_tick;     /* Start of the current decay window */
+#endif
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+    uint32_t     switch_ins;      /* Times the task was switched in */
+    uint32_t     voluntary_switches;   /* Blocked, delayed, suspended or yielded */
+    uint32_t     involuntary_switches; /* Preempted while still ready */
+#endif
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+    uint32_t     context_saves;   /* Switch-outs, each a context save */
+    uint32_t     fpu_saves;       /* Of those, the ones with FPU state */
+#endif
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+    TickType_t   level_tick;      /* When the task entered its current level */
+    uint32_t     level_changes;   /* Level changes since registration */
+    uint32_t     level_ticks[TICK_PROFILER_MAX_LEVELS]; /* Time at each level,
+                                   * up to level_tick; read it with
+                                   * tickProfilerGetLevelTime() */
+#endif
+
+    /* Read by the reports only */
+    TickType_t   arrival_tick;    /* Tick count when the task was registered */
+} TickProfilerTaskInfo_t;
+
+/* Counters describing how quantum-expiry notifications were handled */
+typedef struct
+{
+    uint32_t reported;   /* Expiries delivered to the scheduler */
+    uint32_t coalesced;  /* Repeat expiries suppressed by the latch */
+    uint32_t dropped;    /* Expiries lost because the queue was full */
+    uint32_t max_queued; /* Most expiries the queue has held at once */
+} TickProfilerExpiryStats_t;
+
+/* Wall-clock time a task spent at each level since registration, in
+ * ticks, and its level changes. Ticks at a level and not on the CPU are
+ * time spent waiting or blocked there */
+typedef struct
+{
+    uint32_t ticks[TICK_PROFILER_MAX_LEVELS];
+    uint32_t changes;
+} TickProfilerLevelTime_t;
+
+/* Cumulative CPU time by consumer, in ticks (cycles with cycle accounting).
+ * 64 bits wide, so cycle counts do not wrap for thousands of years. ISR
+ * time is charged to the task it interrupted, except for the handlers
+ * instrumented with irq_stats.h while IRQ_STATS_EXCLUDE_ENABLED is set */
+typedef struct
+{
+    uint64_t level[TICK_PROFILER_MAX_LEVELS]; /* Managed tasks, by level */
+    uint64_t supervisor;  /* Scheduler task (tickProfilerSetSchedulerTaskHandle) */
+    uint64_t idle;        /* Kernel idle task, including tickless sleeps */
+    uint64_t other;       /* Unmanaged tasks: logger, console, timer service */
+    uint64_t asleep;      /* Part of idle with the core asleep (idle hook, tickless) */
+} TickProfilerCpuTime_t;
+
+/* Counters of the tickless idle periods (configUSE_TICKLESS_IDLE) */
+typedef struct
+{
+    uint32_t sleeps;         /* Sleeps that suppressed at least one tick */
+    uint32_t stepped_ticks;  /* Ticks skipped and replayed into the profiler */
+    uint32_t longest_ticks;  /* Longest single sleep in ticks */
+} TickProfilerSleepStats_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+/* Initializes the tick profiler module */
+bool tickProfilerInit(void);
+
+/* Registers a task for runtime profiling */
+bool setupTaskStats(TaskHandle_t task);
+
+/* Releases the profiler slot of a task */
+bool removeTaskStats(TaskHandle_t task);
+
+/* Assigns a time quantum to a task */
+bool setTaskQuantum(TaskHandle_t task, uint32_t quantumTicks);
+
+/* Assigns a time quantum in core cycles (sub-tick resolution) */
+bool setTaskQuantumCycles(TaskHandle_t task, uint32_t quantumCycles);
+
+/* Retrieves the runtime of a task */
+uint32_t getTaskRuntime(TaskHandle_t task);
+
+/* Resets the runtime counter of a task */
+bool resetTaskRuntime(TaskHandle_t task);
+
+/* Sets the scheduler task handle for ISR notification */
+void tickProfilerSetSchedulerTaskHandle(TaskHandle_t schedulerHandle);
+
+/* Returns the queue containing expired tasks */
+QueueHandle_t tickProfilerGetExpiredQueue(void);
+
+/* Returns the profiler slot of a task, or -1 if it is not registered */
+int32_t tickProfilerGetSlot(TaskHandle_t task);
+
+/* Returns the record stored in a slot, or NULL if the slot is empty */
+TickProfilerTaskInfo_t *tickProfilerGetRecord(uint32_t slot);
+
+/* Record of the task running on the calling core, or NULL. O(1) and
+ * lock-free; safe from interrupts */
+TickProfilerTaskInfo_t *tickProfilerGetCurrentRecord(void);
+
+/* Quantum left to the running task in core cycles, 0 once used up, or
+ * UINT32_MAX if it is not registered or has no quantum. O(1) and
+ * lock-free; safe from interrupts */
+uint32_t tickProfilerGetRemainingCycles(void);
+
+/* Slot-indexed variants of the quantum and runtime accessors */
+bool setSlotQuantum(uint32_t slot, uint32_t quantumTicks);
+bool setSlotQuantumCycles(uint32_t slot, uint32_t quantumCycles);
+bool resetSlotRuntime(uint32_t slot);
+
+/* Re-arms every registered slot with one quantum under a single lock */
+void tickProfilerRearmAll(uint32_t quantumTicks, uint32_t quantumCycles);
+
+/* Number of registered slots, and the slot at a position of the dense
+ * active list (TICK_PROFILER_MAX_TASKS past the end) */
+uint32_t tickProfilerGetActiveCount(void);
+uint32_t tickProfilerGetActiveSlot(uint32_t index);
+
+/* Moves a slot to a scheduler level and keeps the level sets in step.
+ * Safe from the tick interrupt */
+void tickProfilerSetLevel(uint32_t slot, uint8_t level);
+
+/* Sets how the quantum budget of a level is given back: never (0), on
+ * every block (TICK_PROFILER_BUDGET_ON_BLOCK), or halved each time the
+ * given number of ticks passes. Needs TICK_PROFILER_BUDGET_WINDOW_ENABLED */
+void tickProfilerSetBudgetWindow(uint8_t level, uint32_t windowTicks);
+
+/* Copies one word of the membership set of a level */
+uint32_t tickProfilerGetLevelMask(uint8_t level, uint32_t word);
+
+/* Number of slots in the membership set of a level */
+uint32_t tickProfilerGetLevelCount(uint8_t level);
+
+/* Table sequence counter (seqlock). Writers bracket every multi-word
+ * change of a record or of the active list with WriteBegin/WriteEnd while
+ * interrupts are masked; pairs must not nest. The quantum and runtime
+ * accessors store single aligned words and are not bracketed. Readers
+ * copy what they need between ReadBegin and ReadRetry and start over
+ * while ReadRetry returns true */
+void tickProfilerWriteBegin(void);
+void tickProfilerWriteEnd(void);
+uint32_t tickProfilerReadBegin(void);
+bool tickProfilerReadRetry(uint32_t sequence);
+
+/* Atomically fetches and clears one word of the expired-slot mask */
+uint32_t tickProfilerTakeExpiredMask(uint32_t word);
+
+/* Called by the quantum timer ISR when the armed budget runs out */
+void tickProfilerQuantumTimerExpired(void);
+
+/* Copies the expiry notification counters */
+void tickProfilerGetExpiryStats(TickProfilerExpiryStats_t *stats);
+
+/* Lifetime CPU time of the task in a slot (lock-free, task context; from
+ * the kernel counter in a short critical section with
+ * configGENERATE_RUN_TIME_STATS); 0 for an empty slot */
+uint64_t tickProfilerGetTotalTime(uint32_t slot);
+
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+/* Copies the time at each level of the task in a slot, up to now, in a
+ * short critical section; false for an empty slot */
+bool tickProfilerGetLevelTime(uint32_t slot, TickProfilerLevelTime_t *output);
+#endif
+
+/* Copies the cumulative CPU time by consumer, summed over every core
+ * (lock-free, task context) */
+void tickProfilerGetCpuTime(TickProfilerCpuTime_t *output);
+
+/* Copies the cumulative CPU time by consumer of one core. Returns false
+ * for a core past TICK_PROFILER_CORES */
+bool tickProfilerGetCoreCpuTime(uint32_t core, TickProfilerCpuTime_t *output);
+
+/* Copies the tickless idle counters (all zero with the tick always on) */
+void tickProfilerGetSleepStats(TickProfilerSleepStats_t *stats);
+
+/* Adds core cycles spent asleep in the idle task to the CPU split */
+void tickProfilerIdleSlept(uint32_t cycles);
+
+/* FreeRTOS tick hook implementation */
+void vApplicationTickHook(void);
+
+/* Starts the boot clock; call from main() right after initClock() */
+void tickProfilerBootStart(void);
+
+/* Stops the boot clock; call right before vTaskStartScheduler() */
+void tickProfilerBootEnd(void);
+
+/* Core cycles from tickProfilerBootStart() to tickProfilerBootEnd(), or
+ * 0 before the end */
+uint32_t tickProfilerGetBootCycles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
+
+#endif /* TICK_PROFILER_H */
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *  MODULE NAME  : Timer Daemon Statistics
+ *  FILE         : timer_stats.h
+ *  DESCRIPTION  : Charges the CPU time of the timer service task to the
+ *                 software timer callback or pended function it ran, from
+ *                 hooks around each call in timers.c. The task table only
+ *                 shows "Tmr Svc" as a whole; this shows which callback
+ *                 inside it is heavy, and flags a run over a budget.
+ *                 Included from trace_hooks.h, so it must not pull in any
+ *                 FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef TIMER_STATS_H_
+#define TIMER_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* CPU time per timer callback and pended function; needs configUSE_TIMERS */
+#ifndef TIMER_STATS_ENABLED
+#define TIMER_STATS_ENABLED          0U
+#endif
+
+/* Distinct callbacks tracked; later ones are summed in one extra entry
+ * with a NULL callback */
+#ifndef TIMER_STATS_MAX_CALLBACKS
+#define TIMER_STATS_MAX_CALLBACKS    8U
+#endif
+
+/* Heaviest callbacks printed by the metrics report */
+#ifndef TIMER_STATS_REPORT_TOP
+#define TIMER_STATS_REPORT_TOP       4U
+#endif
+
+/* A run longer than this, in microseconds, counts as an overrun and is
+ * recorded in the event trace; 0 turns the check off */
+#ifndef TIMER_STATS_ALERT_US
+#define TIMER_STATS_ALERT_US         0U
+#endif
+
+#if (TIMER_STATS_MAX_CALLBACKS == 0U) || (TIMER_STATS_MAX_CALLBACKS > 32U)
+#error "TIMER_STATS_MAX_CALLBACKS must be between 1 and 32"
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Figures of one callback since boot. Run times are core
+ *               cycles, less any interrupt time inside the run when the
+ *               build has IRQ_STATS_ENABLED.
+ */
+typedef struct
+{
+    const void *callback;    /* Function run; NULL for the overflow entry */
+    uint64_t    total_cycles;
+    uint32_t    runs;
+    uint32_t    max_cycles;
+    uint32_t    overruns;    /* Runs over TIMER_STATS_ALERT_US */
+    bool        pended;      /* Run through xTimerPendFunctionCall() */
+} TimerStats_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (TIMER_STATS_ENABLED == 1U)
+/* Description : The timer service task is about to run a callback */
+void timerStatsStart(void);
+
+/* Description : The callback started last has returned */
+void timerStatsEnd(const void *callback, bool pended);
+
+/* Description : Copies up to 'max' entries, heaviest total first, and
+ *               returns how many were copied */
+uint32_t timerStatsGetTop(TimerStats_t *output, uint32_t max);
+#endif
+
+#endif /* TIMER_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,87 @@
+/******************************************************************************
+ *  MODULE NAME  : Timer Wheel
+ *  FILE         : timer_wheel.h
+ *  DESCRIPTION  : Per-task policy timers of the supervisor (aging and
+ *                 periodic pre-promotion), kept in a two-level hashed
+ *                 timer wheel of one-tick buckets. Arming and cancelling
+ *                 are O(1); a supervisor pass only visits the entries
+ *                 that are due, and the tick hook wakes it on the tick the
+ *                 earliest one is, instead of the supervisor scanning
+ *                 every task at a fixed period.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef TIMER_WHEEL_H_
+#define TIMER_WHEEL_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Aging and pre-promotion run from per-task timers instead of the policy
+ * scan; set to 1U to enable */
+#ifndef MLFQ_TIMER_WHEEL_ENABLED
+#define MLFQ_TIMER_WHEEL_ENABLED     0U
+#endif
+
+/* Buckets per wheel level; one bit each in the busy masks. Level 0 holds
+ * the 32 ticks of the current block, level 1 the next 31 blocks; timers
+ * further out wait in an overflow set, re-placed every 1024 ticks */
+#define TIMER_WHEEL_BITS             5U
+#define TIMER_WHEEL_BUCKETS          (1UL << TIMER_WHEEL_BITS)
+
+/* Timer kinds; each profiler slot has one timer of each */
+#define TIMER_WHEEL_AGING            0U  /* Ready wait reaches starvation_ms */
+#define TIMER_WHEEL_PREPROMOTE       1U  /* Periodic task about to wake */
+#define TIMER_WHEEL_KINDS            2U
+
+/* Timer of a profiler slot, and the slot and kind of a timer */
+#define TIMER_WHEEL_ENTRY(slot, kind)  (((uint32_t)(slot) * TIMER_WHEEL_KINDS) + (uint32_t)(kind))
+#define TIMER_WHEEL_SLOT(entry)        ((entry) / TIMER_WHEEL_KINDS)
+#define TIMER_WHEEL_KIND(entry)        ((entry) % TIMER_WHEEL_KINDS)
+
+/* Returned by timerWheelTakeDue() when nothing is due */
+#define TIMER_WHEEL_NONE             0xFFFFFFFFUL
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U)
+/* Description : Arms (or moves) a timer to fire at a tick. Safe from the
+ *               kernel hooks; a tick already past fires on the next pass */
+void timerWheelArm(uint32_t entry, uint32_t dueTick);
+
+/* Description : Disarms a timer; nothing if it is not armed */
+void timerWheelCancel(uint32_t entry);
+
+/* Description : Advances the wheel to a tick and returns one timer due
+ *               by then, disarmed, or TIMER_WHEEL_NONE. Supervisor only */
+uint32_t timerWheelTakeDue(uint32_t nowTick);
+
+/* Description : Ticks until the wheel next needs a pass, at most 'limit',
+ *               and sets the tick timerWheelTickDue() reports. Supervisor
+ *               only, after timerWheelTakeDue() returned TIMER_WHEEL_NONE */
+uint32_t timerWheelTicksToNext(uint32_t nowTick, uint32_t limit);
+
+/* Description : True once per wake point, on the first tick at or after
+ *               it. Call from the tick hook only */
+bool timerWheelTickDue(uint32_t tick);
+#endif
+
+#endif /* TIMER_WHEEL_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
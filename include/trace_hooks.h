@@ -0,0 +1,676 @@
+/******************************************************************************
+ *  MODULE NAME  : Kernel Trace Hooks
+ *  FILE         : trace_hooks.h
+ *  DESCRIPTION  : Maps FreeRTOS trace macros onto the MLFQ profiling
+ *                 modules. Included at the end of FreeRTOSConfig.h, so it
+ *                 must not pull in any FreeRTOS header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef TRACE_HOOKS_H_
+#define TRACE_HOOKS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Build profile: instrumentation defaults of the modules below */
+#include "mlfq_config.h"
+
+/* Event trace switches, identifiers and prototypes */
+#include "event_trace.h"
+
+/* Wake-to-run latency switches and prototypes */
+#include "latency_stats.h"
+
+/* CPU burst switches and prototypes */
+#include "burst_stats.h"
+
+/* Per-task aging switches and prototypes */
+#include "aging.h"
+
+/* Wake period detection switches and prototypes */
+#include "wake_period.h"
+
+/* Interactivity score switches and prototypes */
+#include "interactivity.h"
+
+/* Priority inversion switches and prototypes */
+#include "inversion_stats.h"
+
+/* Blocking wait switches and prototypes */
+#include "wait_stats.h"
+
+/* Running / ready / blocked time switches and prototypes */
+#include "state_time.h"
+
+/* Scheduling policy switch and the policy block hook */
+#include "sched_policy.h"
+
+/* Context switch cost switches and prototypes */
+#include "switch_stats.h"
+
+/* Stack high-water-mark switches and prototypes */
+#include "stack_stats.h"
+
+/* Heap statistics and allocation trace switches and prototypes */
+#include "heap_stats.h"
+
+/* Worker task pool switches and prototypes */
+#include "task_pool.h"
+
+/* Logic analyzer probe switches, pins and prototypes */
+#include "gpio_probe.h"
+
+/* Timer daemon callback statistics switches and prototypes */
+#include "timer_stats.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Charges CPU time in DWT cycles at every context switch instead of
+ * charging a whole tick to whichever task is running at the SysTick */
+#ifndef TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED
+#define TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED   0U
+#endif
+
+/* Per-level quantum budget windows: the quantum a task has used is
+ * refunded when it blocks, or decays over time, as set by the level's
+ * budget_window_ms (scheduler.h), instead of building up until the next
+ * level change */
+#ifndef TICK_PROFILER_BUDGET_WINDOW_ENABLED
+#define TICK_PROFILER_BUDGET_WINDOW_ENABLED      0U
+#endif
+
+/* Records why each managed task last blocked, from the kernel blocking
+ * hooks, so a vTaskDelay() polling loop can be told apart from a task
+ * waiting on a queue, semaphore, notification or event group. The score
+ * classifier and the budget refund use it (see below and interactivity.h) */
+#ifndef TICK_PROFILER_BLOCK_REASON_ENABLED
+#define TICK_PROFILER_BLOCK_REASON_ENABLED       0U
+#endif
+
+/* With block reasons, whether a vTaskDelay() or xTaskDelayUntil() sleep
+ * refunds the quantum at a TICK_PROFILER_BUDGET_ON_BLOCK level. 0U keeps
+ * the refund for tasks that wait on an event, so a poll-and-sleep loop
+ * keeps using up its quantum across the sleeps and sinks */
+#ifndef TICK_PROFILER_DELAY_REFUND_ENABLED
+#define TICK_PROFILER_DELAY_REFUND_ENABLED       0U
+#endif
+
+/* Counts, per managed task, the times it was switched in and the times
+ * it gave up the CPU itself (block, delay, suspend, taskYIELD()) or was
+ * preempted, for the queue report */
+#ifndef TICK_PROFILER_SWITCH_COUNTS_ENABLED
+#define TICK_PROFILER_SWITCH_COUNTS_ENABLED      1U
+#endif
+
+/* Counts, per managed task, the context saves at switch-out and the
+ * ones that also stacked the FPU registers, for the switch report. On the
+ * M4F a task that has touched the FPU carries an extended frame, and
+ * every save and restore of it costs about TICK_PROFILER_FPU_SAVE_CYCLES
+ * more. Needs TICK_PROFILER_SWITCH_COUNTS_ENABLED */
+#ifndef TICK_PROFILER_FPU_STATS_ENABLED
+#define TICK_PROFILER_FPU_STATS_ENABLED          0U
+#endif
+
+/* Estimated extra cycles of one FPU context save and restore: s16-s31
+ * stacked by PendSV, s0-s15 and FPSCR by lazy stacking, and the same
+ * again on the way back in */
+#ifndef TICK_PROFILER_FPU_SAVE_CYCLES
+#define TICK_PROFILER_FPU_SAVE_CYCLES            70U
+#endif
+
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U) && (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 0U)
+#error "TICK_PROFILER_FPU_STATS_ENABLED needs TICK_PROFILER_SWITCH_COUNTS_ENABLED"
+#endif
+
+/* Keeps, per managed task, the time spent at each level (ready, running
+ * or blocked) and the number of level changes, for the queue report */
+#ifndef TICK_PROFILER_LEVEL_TIME_ENABLED
+#define TICK_PROFILER_LEVEL_TIME_ENABLED         1U
+#endif
+
+/* schedulerYieldBurst() (scheduler.h) ends the burst of a task that stays
+ * ready: the burst statistics and the budget refund take its switch-out
+ * as a block. 0U makes it a plain taskYIELD() */
+#ifndef MLFQ_YIELD_BURST_ENABLED
+#define MLFQ_YIELD_BURST_ENABLED                 1U
+#endif
+
+/* Block reasons */
+#define TICK_PROFILER_BLOCK_NONE                 0U   /* Running, preempted or suspended */
+#define TICK_PROFILER_BLOCK_DELAY                1U   /* vTaskDelay(), xTaskDelayUntil() */
+#define TICK_PROFILER_BLOCK_EVENT                2U   /* Queue, semaphore, mutex, notification, event group */
+#define TICK_PROFILER_BLOCK_YIELD                3U   /* schedulerYieldBurst(), still ready */
+
+/* Only built when a hook reads the end of a burst */
+#if (MLFQ_YIELD_BURST_ENABLED == 1U) && \
+    ((BURST_STATS_ENABLED == 1U) || (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U))
+#define MLFQ_YIELD_BURST_HOOKED                  1U
+#else
+#define MLFQ_YIELD_BURST_HOOKED                  0U
+#endif
+
+/* Registers every task created in the MLFQ High band with the scheduler
+ * and releases its slot when the task is deleted */
+#ifndef MLFQ_AUTO_REGISTER_ENABLED
+#define MLFQ_AUTO_REGISTER_ENABLED               0U
+#endif
+
+/* Drives the RGB LED from the level of the task being switched in, so it
+ * always shows what is running; 0U leaves the LED alone */
+#ifndef MLFQ_LED_ENABLED
+#define MLFQ_LED_ENABLED                         1U
+#endif
+
+/* Runs the core at SYSTEM_CLOCK_SLOW_CONFIG (drivers.h) while no task
+ * above the Low level is ready, and at full speed again within a tick of
+ * one becoming ready (scheduler.h) */
+#ifndef MLFQ_CLOCK_SCALING_ENABLED
+#define MLFQ_CLOCK_SCALING_ENABLED               0U
+#endif
+
+/* Moves the tasks bound to a queue, semaphore or event group back to
+ * High within a tick of it being sent to, given or set (scheduler.h) */
+#ifndef MLFQ_EVENT_BOOST_ENABLED
+#define MLFQ_EVENT_BOOST_ENABLED                 0U
+#endif
+
+/* Calls a task's level-change callback from the supervisor after the MLFQ
+ * demotes or promotes it; the tick hook wakes the supervisor for changes
+ * made elsewhere (scheduler.h) */
+#ifndef MLFQ_LEVEL_CALLBACKS_ENABLED
+#define MLFQ_LEVEL_CALLBACKS_ENABLED             0U
+#endif
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+/* Starts charging cycles to the task being switched in */
+void tickProfilerTaskSwitchedIn(void *task);
+
+/* Charges the cycles consumed by the task being switched out */
+void tickProfilerTaskSwitchedOut(void *task);
+#endif
+
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+/* Refunds the quantum of a task that blocked, if its level asks for it */
+void tickProfilerBudgetSwitchedOut(void *task, bool stillReady);
+#endif
+
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U)
+/* Records the TICK_PROFILER_BLOCK_* reason of a task; NULL is the caller */
+void tickProfilerSetBlockReason(void *task, uint8_t reason);
+#endif
+
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+/* Holds the outgoing task and whether it left on its own */
+void tickProfilerCountSwitchedOut(void *task, bool stillReady);
+
+/* Counts the switch, unless the outgoing task was selected again */
+void tickProfilerCountSwitchedIn(void *task);
+
+/* Marks the next switch-out of the calling task as voluntary */
+void tickProfilerTaskYielded(void);
+#endif
+
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+/* Counts a context save of the outgoing task, and whether it held FPU state */
+void tickProfilerFpuSwitchedOut(void *task, bool fpuFrame);
+#endif
+
+#if (MLFQ_YIELD_BURST_HOOKED == 1U)
+/* Marks the burst of the calling task as over at its next switch-out */
+void tickProfilerEndBurst(void);
+
+/* True if the outgoing task is still ready and did not end its burst */
+bool tickProfilerBurstOpen(void *task, bool stillReady);
+
+/* Drops the mark once every switch-out hook has seen it */
+void tickProfilerBurstSwitchedOut(void);
+#endif
+
+#if (configUSE_TICKLESS_IDLE == 1)
+/* Accounts the ticks the kernel skipped during a tickless sleep */
+void tickProfilerTicksStepped(uint32_t ticks);
+#endif
+
+#if (MLFQ_LED_ENABLED == 1U)
+/* Shows the colour of the level a task at this priority runs in */
+void ledTaskSwitchedIn(uint32_t priority);
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+/* Asks for full speed when a task above the Low level becomes ready */
+void schedulerClockTaskReady(uint32_t priority);
+
+/* True while a task is waiting for full speed, read by the tick hook */
+bool schedulerClockRestoreWanted(void);
+#endif
+
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+/* Notes the bindings fired by a send, give or event group set */
+void schedulerEventBoostFired(const void *object, uint32_t bits);
+
+/* True while a fired binding waits for the supervisor, read by the tick hook */
+bool schedulerEventBoostPending(void);
+#endif
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+/* True while a level change waits for its callback, read by the tick hook */
+bool schedulerLevelCallbackPending(void);
+#endif
+
+#if (MLFQ_AUTO_REGISTER_ENABLED == 1U)
+/* Registers a new task created at the MLFQ High priority */
+void schedulerTaskCreated(void *task, uint32_t priority);
+
+/* Releases the scheduler slot of a task being deleted */
+void schedulerTaskDeleted(void *task);
+#endif
+
+/******************************************************************************
+ *  KERNEL TRACE MACROS
+ *  These expand inside tasks.c where pxCurrentTCB is in scope, except the
+ *  blocking hooks that expand in queue.c and event_groups.c, which go
+ *  through eventTraceRecordCurrent() and tickProfilerSetBlockReason()
+ *  on the calling task instead.
+ ******************************************************************************/
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+#define TRACE_HOOK_PROFILER_SWITCHED_IN()   tickProfilerTaskSwitchedIn((void *)pxCurrentTCB)
+#define TRACE_HOOK_PROFILER_SWITCHED_OUT()  tickProfilerTaskSwitchedOut((void *)pxCurrentTCB)
+#else
+#define TRACE_HOOK_PROFILER_SWITCHED_IN()
+#define TRACE_HOOK_PROFILER_SWITCHED_OUT()
+#endif
+
+/* A yield leaves the task ready, so it is marked before the switch */
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+#define TRACE_HOOK_COUNT_SWITCHED_IN()   tickProfilerCountSwitchedIn((void *)pxCurrentTCB)
+#define TRACE_HOOK_COUNT_SWITCHED_OUT()  \
+    tickProfilerCountSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#define traceTASK_YIELD()                tickProfilerTaskYielded()
+#else
+#define TRACE_HOOK_COUNT_SWITCHED_IN()
+#define TRACE_HOOK_COUNT_SWITCHED_OUT()
+#endif
+
+/* PendSV has already stacked r4-r11 and then EXC_RETURN at the task's
+ * top of stack, whose bit 4 is clear for an extended (FPU) frame. The
+ * host build has no such frame */
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+#if defined(MLFQ_HOST_SIM)
+#define TRACE_HOOK_FPU_FRAME()  false
+#else
+#define TRACE_HOOK_FPU_FRAME()  \
+    ((((const uint32_t *)pxCurrentTCB->pxTopOfStack)[8] & 0x10UL) == 0UL)
+#endif
+#define TRACE_HOOK_FPU_SWITCHED_OUT() \
+    tickProfilerFpuSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_FPU_FRAME())
+#else
+#define TRACE_HOOK_FPU_SWITCHED_OUT()
+#endif
+
+#if (EVENT_TRACE_ENABLED == 1U)
+#define TRACE_HOOK_EVENT_SWITCHED_IN()  \
+    eventTraceRecord(EVENT_TRACE_SWITCH_IN, (void *)pxCurrentTCB, 0U, 0U)
+#define TRACE_HOOK_EVENT_SWITCHED_OUT() \
+    eventTraceRecord(EVENT_TRACE_SWITCH_OUT, (void *)pxCurrentTCB, 0U, 0U)
+
+#define TRACE_HOOK_EVENT_READY(pxTCB) \
+    eventTraceRecord(EVENT_TRACE_UNBLOCK, (void *)(pxTCB), 0U, 0U)
+#define TRACE_HOOK_EVENT_BLOCK(reason) \
+    eventTraceRecordCurrent(EVENT_TRACE_BLOCK, (reason))
+#else
+#define TRACE_HOOK_EVENT_SWITCHED_IN()
+#define TRACE_HOOK_EVENT_SWITCHED_OUT()
+#define TRACE_HOOK_EVENT_READY(pxTCB)
+#define TRACE_HOOK_EVENT_BLOCK(reason)
+#endif
+
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U)
+#define TRACE_HOOK_REASON_BLOCK(reason) \
+    tickProfilerSetBlockReason(NULL, (reason))
+
+/* A suspended task did not block on anything; drop the last reason so it
+ * is not applied to the resume */
+#define traceTASK_SUSPEND(pxTaskToSuspend) \
+    tickProfilerSetBlockReason((void *)(pxTaskToSuspend), TICK_PROFILER_BLOCK_NONE)
+#else
+#define TRACE_HOOK_REASON_BLOCK(reason)
+#endif
+
+#if (WAIT_STATS_ENABLED == 1U)
+/* Expands in queue.c, where pxCurrentTCB is not visible; the module
+ * looks the running task up itself */
+#define TRACE_HOOK_WAIT_BLOCK(pxQueue, direction) \
+    waitStatsBlocking((const void *)(pxQueue), (direction))
+#define TRACE_HOOK_WAIT_READY(pxTCB)    waitStatsTaskReady((void *)(pxTCB))
+#else
+#define TRACE_HOOK_WAIT_BLOCK(pxQueue, direction)
+#define TRACE_HOOK_WAIT_READY(pxTCB)
+#endif
+
+#if (EVENT_TRACE_ENABLED == 1U) || (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U) || \
+    (WAIT_STATS_ENABLED == 1U)
+/* Kernel blocking hooks, with the trace and profiler reason of each */
+#define TRACE_HOOK_BLOCK(traceReason, profilerReason) \
+    do {                                              \
+        TRACE_HOOK_EVENT_BLOCK(traceReason);          \
+        TRACE_HOOK_REASON_BLOCK(profilerReason);      \
+    } while (0)
+
+/* Queue blocks also name the object waited on */
+#define TRACE_HOOK_QUEUE_BLOCK(pxQueue, traceReason, direction)        \
+    do {                                                               \
+        TRACE_HOOK_BLOCK(traceReason, TICK_PROFILER_BLOCK_EVENT);      \
+        TRACE_HOOK_WAIT_BLOCK(pxQueue, direction);                     \
+    } while (0)
+
+#define traceTASK_DELAY() \
+    TRACE_HOOK_BLOCK(EVENT_TRACE_BLOCK_DELAY, TICK_PROFILER_BLOCK_DELAY)
+#define traceTASK_DELAY_UNTIL(xTimeToWake) \
+    TRACE_HOOK_BLOCK(EVENT_TRACE_BLOCK_DELAY, TICK_PROFILER_BLOCK_DELAY)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    TRACE_HOOK_QUEUE_BLOCK(pxQueue, EVENT_TRACE_BLOCK_QUEUE_RX, WAIT_STATS_RECEIVE)
+#define traceBLOCKING_ON_QUEUE_PEEK(pxQueue) \
+    TRACE_HOOK_QUEUE_BLOCK(pxQueue, EVENT_TRACE_BLOCK_QUEUE_RX, WAIT_STATS_RECEIVE)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    TRACE_HOOK_QUEUE_BLOCK(pxQueue, EVENT_TRACE_BLOCK_QUEUE_TX, WAIT_STATS_SEND)
+#define traceTASK_NOTIFY_TAKE_BLOCK(uxIndexToWait) \
+    TRACE_HOOK_BLOCK(EVENT_TRACE_BLOCK_NOTIFY, TICK_PROFILER_BLOCK_EVENT)
+#define traceTASK_NOTIFY_WAIT_BLOCK(uxIndexToWait) \
+    TRACE_HOOK_BLOCK(EVENT_TRACE_BLOCK_NOTIFY, TICK_PROFILER_BLOCK_EVENT)
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK(xEventGroup, uxBitsToWaitFor) \
+    TRACE_HOOK_BLOCK(EVENT_TRACE_BLOCK_EVENTS, TICK_PROFILER_BLOCK_EVENT)
+#define traceEVENT_GROUP_SYNC_BLOCK(xEventGroup, uxBitsToSet, uxBitsToWaitFor) \
+    TRACE_HOOK_BLOCK(EVENT_TRACE_BLOCK_EVENTS, TICK_PROFILER_BLOCK_EVENT)
+#endif
+
+/* A task still linked in its ready list at switch-out was only preempted */
+#define TRACE_HOOK_STILL_READY()                                                 \
+    (listIS_CONTAINED_WITHIN(&(pxReadyTasksLists[pxCurrentTCB->uxPriority]),    \
+                             &(pxCurrentTCB->xStateListItem)) != pdFALSE)
+
+/* Still ready, and the burst not ended with schedulerYieldBurst() */
+#if (MLFQ_YIELD_BURST_HOOKED == 1U)
+#define TRACE_HOOK_BURST_OPEN() \
+    tickProfilerBurstOpen((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#define TRACE_HOOK_YIELD_SWITCHED_OUT()   tickProfilerBurstSwitchedOut()
+#else
+#define TRACE_HOOK_BURST_OPEN()           TRACE_HOOK_STILL_READY()
+#define TRACE_HOOK_YIELD_SWITCHED_OUT()
+#endif
+
+#if (LATENCY_STATS_ENABLED == 1U)
+#define TRACE_HOOK_LATENCY_SWITCHED_OUT() \
+    latencyTaskSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#define TRACE_HOOK_LATENCY_SWITCHED_IN()  latencyTaskSwitchedIn((void *)pxCurrentTCB)
+#define TRACE_HOOK_LATENCY_READY(pxTCB)   latencyTaskReady((void *)(pxTCB))
+#else
+#define TRACE_HOOK_LATENCY_SWITCHED_OUT()
+#define TRACE_HOOK_LATENCY_SWITCHED_IN()
+#define TRACE_HOOK_LATENCY_READY(pxTCB)
+#endif
+
+#if (BURST_STATS_ENABLED == 1U)
+#define TRACE_HOOK_BURST_SWITCHED_OUT() \
+    burstTaskSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_BURST_OPEN())
+#define TRACE_HOOK_BURST_SWITCHED_IN()  burstTaskSwitchedIn((void *)pxCurrentTCB)
+#else
+#define TRACE_HOOK_BURST_SWITCHED_OUT()
+#define TRACE_HOOK_BURST_SWITCHED_IN()
+#endif
+
+#if (AGING_WAIT_TRACKING_ENABLED == 1U)
+#define TRACE_HOOK_AGING_SWITCHED_OUT() \
+    agingTaskSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#define TRACE_HOOK_AGING_SWITCHED_IN()  agingTaskSwitchedIn((void *)pxCurrentTCB)
+#define TRACE_HOOK_AGING_READY(pxTCB)   agingTaskReady((void *)(pxTCB))
+#else
+#define TRACE_HOOK_AGING_SWITCHED_OUT()
+#define TRACE_HOOK_AGING_SWITCHED_IN()
+#define TRACE_HOOK_AGING_READY(pxTCB)
+#endif
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+#define TRACE_HOOK_PERIOD_SWITCHED_OUT() \
+    wakePeriodTaskSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#define TRACE_HOOK_PERIOD_READY(pxTCB)   wakePeriodTaskReady((void *)(pxTCB))
+#else
+#define TRACE_HOOK_PERIOD_SWITCHED_OUT()
+#define TRACE_HOOK_PERIOD_READY(pxTCB)
+#endif
+
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+#define TRACE_HOOK_SCORE_SWITCHED_OUT() \
+    interactivityTaskSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#define TRACE_HOOK_SCORE_SWITCHED_IN()  interactivityTaskSwitchedIn((void *)pxCurrentTCB)
+#define TRACE_HOOK_SCORE_READY(pxTCB)   interactivityTaskReady((void *)(pxTCB))
+#else
+#define TRACE_HOOK_SCORE_SWITCHED_OUT()
+#define TRACE_HOOK_SCORE_SWITCHED_IN()
+#define TRACE_HOOK_SCORE_READY(pxTCB)
+#endif
+
+#if (STATE_TIME_ENABLED == 1U)
+#define TRACE_HOOK_STATE_SWITCHED_OUT() \
+    stateTimeSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#define TRACE_HOOK_STATE_SWITCHED_IN()  stateTimeSwitchedIn((void *)pxCurrentTCB)
+#define TRACE_HOOK_STATE_READY(pxTCB)   stateTimeTaskReady((void *)(pxTCB))
+#else
+#define TRACE_HOOK_STATE_SWITCHED_OUT()
+#define TRACE_HOOK_STATE_SWITCHED_IN()
+#define TRACE_HOOK_STATE_READY(pxTCB)
+#endif
+
+/* Runs after the profiler charge, so the refund covers the last burst */
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+#define TRACE_HOOK_BUDGET_SWITCHED_OUT() \
+    tickProfilerBudgetSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_BURST_OPEN())
+#else
+#define TRACE_HOOK_BUDGET_SWITCHED_OUT()
+#endif
+
+#if (SCHED_POLICY != SCHED_POLICY_MLFQ)
+#define TRACE_HOOK_POLICY_SWITCHED_OUT() \
+    schedPolicyTaskSwitchedOut((void *)pxCurrentTCB, TRACE_HOOK_STILL_READY())
+#else
+#define TRACE_HOOK_POLICY_SWITCHED_OUT()
+#endif
+
+/* Innermost pair, so only the kernel's own selection work is timed */
+#if (SWITCH_STATS_ENABLED == 1U)
+#define TRACE_HOOK_SWITCH_SWITCHED_OUT()  switchStatsSwitchedOut()
+#define TRACE_HOOK_SWITCH_SWITCHED_IN()   switchStatsSwitchedIn()
+#else
+#define TRACE_HOOK_SWITCH_SWITCHED_OUT()
+#define TRACE_HOOK_SWITCH_SWITCHED_IN()
+#endif
+
+/* Current priority, so a task running on an inherited priority shows the
+ * colour of the level it is running in */
+#if (MLFQ_LED_ENABLED == 1U)
+#define TRACE_HOOK_LED_SWITCHED_IN()      ledTaskSwitchedIn((uint32_t)pxCurrentTCB->uxPriority)
+#else
+#define TRACE_HOOK_LED_SWITCHED_IN()
+#endif
+
+#if (GPIO_PROBE_ENABLED == 1U) && (GPIO_PROBE_LEVEL_BITS > 0U)
+#define TRACE_HOOK_PROBE_SWITCHED_IN()    gpioProbeTaskSwitchedIn((uint32_t)pxCurrentTCB->uxPriority)
+#else
+#define TRACE_HOOK_PROBE_SWITCHED_IN()
+#endif
+
+#if ((TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U) || \
+     (EVENT_TRACE_ENABLED == 1U) || (LATENCY_STATS_ENABLED == 1U) || \
+     (BURST_STATS_ENABLED == 1U) || (AGING_WAIT_TRACKING_ENABLED == 1U) || \
+     (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U) || (SCHED_POLICY != SCHED_POLICY_MLFQ) || \
+     (SWITCH_STATS_ENABLED == 1U) || (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U) || \
+     (MLFQ_LED_ENABLED == 1U) || (GPIO_PROBE_ENABLED == 1U) || \
+     (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U) || (MLFQ_PREPROMOTE_ENABLED == 1U) || \
+     (STATE_TIME_ENABLED == 1U))
+#define traceTASK_SWITCHED_IN()             \
+    do {                                    \
+        TRACE_HOOK_SWITCH_SWITCHED_IN();    \
+        TRACE_HOOK_PROBE_SWITCHED_IN();     \
+        TRACE_HOOK_LED_SWITCHED_IN();       \
+        TRACE_HOOK_PROFILER_SWITCHED_IN();  \
+        TRACE_HOOK_COUNT_SWITCHED_IN();     \
+        TRACE_HOOK_SCORE_SWITCHED_IN();     \
+        TRACE_HOOK_STATE_SWITCHED_IN();     \
+        TRACE_HOOK_AGING_SWITCHED_IN();     \
+        TRACE_HOOK_BURST_SWITCHED_IN();     \
+        TRACE_HOOK_LATENCY_SWITCHED_IN();   \
+        TRACE_HOOK_EVENT_SWITCHED_IN();     \
+    } while (0)
+
+#define traceTASK_SWITCHED_OUT()            \
+    do {                                    \
+        TRACE_HOOK_EVENT_SWITCHED_OUT();    \
+        TRACE_HOOK_LATENCY_SWITCHED_OUT();  \
+        TRACE_HOOK_BURST_SWITCHED_OUT();    \
+        TRACE_HOOK_AGING_SWITCHED_OUT();    \
+        TRACE_HOOK_STATE_SWITCHED_OUT();    \
+        TRACE_HOOK_PERIOD_SWITCHED_OUT();   \
+        TRACE_HOOK_SCORE_SWITCHED_OUT();    \
+        TRACE_HOOK_POLICY_SWITCHED_OUT();   \
+        TRACE_HOOK_COUNT_SWITCHED_OUT();    \
+        TRACE_HOOK_FPU_SWITCHED_OUT();      \
+        TRACE_HOOK_PROFILER_SWITCHED_OUT(); \
+        TRACE_HOOK_BUDGET_SWITCHED_OUT();   \
+        TRACE_HOOK_SWITCH_SWITCHED_OUT();   \
+        TRACE_HOOK_YIELD_SWITCHED_OUT();    \
+    } while (0)
+#endif
+
+#if (INVERSION_STATS_ENABLED == 1U)
+#define traceTASK_PRIORITY_INHERIT(pxTCBOfMutexHolder, uxInheritedPriority) \
+    inversionTaskInherited((void *)(pxTCBOfMutexHolder))
+#define traceTASK_PRIORITY_DISINHERIT(pxTCBOfMutexHolder, uxOriginalPriority) \
+    inversionTaskDisinherited((void *)(pxTCBOfMutexHolder),                   \
+                              (uxOriginalPriority) == (pxTCBOfMutexHolder)->uxBasePriority)
+#endif
+
+/* The stack depth is only known from the TCB, which keeps its high end
+ * with configRECORD_STACK_HIGH_ADDRESS */
+#if (STACK_STATS_ENABLED == 1U)
+#if (configRECORD_STACK_HIGH_ADDRESS != 1) || (INCLUDE_uxTaskGetStackHighWaterMark != 1)
+#error "STACK_STATS_ENABLED needs configRECORD_STACK_HIGH_ADDRESS and INCLUDE_uxTaskGetStackHighWaterMark"
+#endif
+#define TRACE_HOOK_STACK_CREATE(pxNewTCB)                                       \
+    stackStatsTaskCreated((void *)(pxNewTCB),                                   \
+                          (uint32_t)((pxNewTCB)->pxEndOfStack - (pxNewTCB)->pxStack) + 1U)
+#define TRACE_HOOK_STACK_DELETE(pxTCB)  stackStatsTaskDeleted((void *)(pxTCB))
+#else
+#define TRACE_HOOK_STACK_CREATE(pxNewTCB)
+#define TRACE_HOOK_STACK_DELETE(pxTCB)
+#endif
+
+#if (MLFQ_AUTO_REGISTER_ENABLED == 1U)
+#define TRACE_HOOK_REGISTER_CREATE(pxNewTCB) \
+    schedulerTaskCreated((void *)(pxNewTCB), (uint32_t)(pxNewTCB)->uxPriority)
+#define TRACE_HOOK_REGISTER_DELETE(pxTCB)    schedulerTaskDeleted((void *)(pxTCB))
+#else
+#define TRACE_HOOK_REGISTER_CREATE(pxNewTCB)
+#define TRACE_HOOK_REGISTER_DELETE(pxTCB)
+#endif
+
+#if (MLFQ_AUTO_REGISTER_ENABLED == 1U) || (STACK_STATS_ENABLED == 1U)
+/* Both expand inside a kernel critical section; the new TCB is fully
+ * initialised but not yet in a ready list */
+#define traceTASK_CREATE(pxNewTCB)              \
+    do {                                        \
+        TRACE_HOOK_STACK_CREATE(pxNewTCB);      \
+        TRACE_HOOK_REGISTER_CREATE(pxNewTCB);   \
+    } while (0)
+
+#define traceTASK_DELETE(pxTCB)                 \
+    do {                                        \
+        TRACE_HOOK_REGISTER_DELETE(pxTCB);      \
+        TRACE_HOOK_STACK_DELETE(pxTCB);         \
+    } while (0)
+#endif
+
+/* Both expand in heap_4.c with the scheduler suspended; the sizes are
+ * block sizes, including the block header */
+#if (HEAP_STATS_ENABLED == 1U)
+#define traceMALLOC(pvAddress, uiSize) \
+    heapStatsMalloc((pvAddress), (uint32_t)(uiSize), HEAP_TRACE_CALLER())
+#define traceFREE(pvAddress, uiSize) \
+    heapStatsFree((pvAddress), (uint32_t)(uiSize), HEAP_TRACE_CALLER())
+#endif
+
+/* Expands in prvDeleteTCB() once the TCB is off every kernel list, which
+ * for a task that deleted itself is only when the idle task cleans up */
+#if (TASK_POOL_ENABLED == 1U)
+#if (configSUPPORT_STATIC_ALLOCATION != 1) || (MLFQ_AUTO_REGISTER_ENABLED != 1U)
+#error "TASK_POOL_ENABLED needs configSUPPORT_STATIC_ALLOCATION and MLFQ_AUTO_REGISTER_ENABLED"
+#endif
+#define portCLEAN_UP_TCB(pxTCB)  taskPoolRelease((void *)(pxTCB))
+#endif
+
+/* Both expand in timers.c in the timer service task, around each timer
+ * callback and each function pended with xTimerPendFunctionCall() */
+#if (TIMER_STATS_ENABLED == 1U)
+#if !defined(configUSE_TIMERS) || (configUSE_TIMERS != 1)
+#error "TIMER_STATS_ENABLED needs configUSE_TIMERS"
+#endif
+#define traceTIMER_CALLBACK_START()  timerStatsStart()
+#define traceTIMER_CALLBACK_END(pxCallbackFunction, xPended) \
+    timerStatsEnd((const void *)(pxCallbackFunction), (xPended) == pdTRUE)
+#endif
+
+/* Expands in vTaskStepTick() with interrupts disabled, right after a
+ * tickless sleep; the stepped ticks never reach vApplicationTickHook() */
+#if (configUSE_TICKLESS_IDLE == 1)
+#define traceINCREASE_TICK_COUNT(xTicksToJump) \
+    tickProfilerTicksStepped((uint32_t)(xTicksToJump))
+#endif
+
+/* The queue hooks expand in queue.c with interrupts masked, on every
+ * send and give; the event group one in xEventGroupSetBits() with the
+ * scheduler suspended. xEventGroupSetBitsFromISR() defers to the timer
+ * task, which sets the bits through xEventGroupSetBits() */
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+#define traceQUEUE_SEND(pxQueue) \
+    schedulerEventBoostFired((const void *)(pxQueue), 0U)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    schedulerEventBoostFired((const void *)(pxQueue), 0U)
+#define traceEVENT_GROUP_SET_BITS(xEventGroup, uxBitsToSet) \
+    schedulerEventBoostFired((const void *)(xEventGroup), (uint32_t)(uxBitsToSet))
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+#define TRACE_HOOK_CLOCK_READY(pxTCB)   schedulerClockTaskReady((uint32_t)(pxTCB)->uxPriority)
+#else
+#define TRACE_HOOK_CLOCK_READY(pxTCB)
+#endif
+
+#if ((EVENT_TRACE_ENABLED == 1U) || (LATENCY_STATS_ENABLED == 1U) || \
+     (AGING_WAIT_TRACKING_ENABLED == 1U) || (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U) || \
+     (MLFQ_CLOCK_SCALING_ENABLED == 1U) || (MLFQ_PREPROMOTE_ENABLED == 1U) || \
+     (WAIT_STATS_ENABLED == 1U) || (STATE_TIME_ENABLED == 1U))
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+    do {                                      \
+        TRACE_HOOK_CLOCK_READY(pxTCB);        \
+        TRACE_HOOK_WAIT_READY(pxTCB);         \
+        TRACE_HOOK_STATE_READY(pxTCB);        \
+        TRACE_HOOK_LATENCY_READY(pxTCB);      \
+        TRACE_HOOK_AGING_READY(pxTCB);        \
+        TRACE_HOOK_PERIOD_READY(pxTCB);       \
+        TRACE_HOOK_SCORE_READY(pxTCB);        \
+        TRACE_HOOK_EVENT_READY(pxTCB);        \
+    } while (0)
+#endif
+
+#endif /* TRACE_HOOKS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
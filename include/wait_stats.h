@@ -0,0 +1,102 @@
+/******************************************************************************
+ *  MODULE NAME  : Blocking Wait Statistics
+ *  FILE         : wait_stats.h
+ *  DESCRIPTION  : Measures how long and how often each registered task
+ *                 blocks on each queue, semaphore or mutex, fed by the
+ *                 kernel's queue blocking hooks and the move back to a
+ *                 ready list. Separates time spent waiting on I/O from
+ *                 time spent waiting for the CPU. Included from
+ *                 trace_hooks.h, so it must not pull in any FreeRTOS
+ *                 header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef WAIT_STATS_H_
+#define WAIT_STATS_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Build profile defaults (mlfq_config.h) */
+#include "mlfq_config.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Time blocked per task and queue object */
+#ifndef WAIT_STATS_ENABLED
+#define WAIT_STATS_ENABLED           0U
+#endif
+
+/* Task and object pairs tracked; blocks on a new pair once the table is
+ * full are only counted as dropped */
+#ifndef WAIT_STATS_MAX_ENTRIES
+#define WAIT_STATS_MAX_ENTRIES       32U
+#endif
+
+/* Pairs listed by the report, most time blocked first */
+#ifndef WAIT_STATS_REPORT_TOP
+#define WAIT_STATS_REPORT_TOP        8U
+#endif
+
+#if (WAIT_STATS_ENABLED == 1U) && \
+    ((WAIT_STATS_MAX_ENTRIES == 0U) || (WAIT_STATS_MAX_ENTRIES > 32U))
+#error "WAIT_STATS_MAX_ENTRIES must be 1..32"
+#endif
+
+/* Direction of a wait */
+#define WAIT_STATS_RECEIVE           0U  /* Receive, peek or take */
+#define WAIT_STATS_SEND              1U  /* Send on a full queue */
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Waits of one task on one object, in core cycles. A wait
+ *               runs from the block until the task is ready again, by
+ *               the event or by its timeout; a single wait longer than
+ *               the 32-bit cycle counter wraps is undercounted.
+ */
+typedef struct
+{
+    const void *object;      /* Queue, semaphore or mutex handle */
+    uint8_t     slot;        /* Profiler slot of the task */
+    uint8_t     direction;   /* WAIT_STATS_RECEIVE or WAIT_STATS_SEND */
+    uint32_t    waits;
+    uint64_t    total_cycles;
+    uint32_t    max_cycles;
+} WaitStatsEntry_t;
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (WAIT_STATS_ENABLED == 1U)
+/* Description : The running task is about to block on a queue object */
+void waitStatsBlocking(const void *object, uint32_t direction);
+
+/* Description : A task was moved to a ready list; ends its wait, if any */
+void waitStatsTaskReady(void *task);
+
+/* Description : Copies one entry of the table. False if it is unused */
+bool waitStatsGetEntry(uint32_t index, WaitStatsEntry_t *output);
+
+/* Description : Blocks not recorded because the table was full */
+uint32_t waitStatsGetDropped(void);
+
+/* Description : Clears the entries of a profiler slot (slot reuse) */
+void waitStatsResetTask(uint32_t slot);
+#endif
+
+#endif /* WAIT_STATS_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,87 @@
+/******************************************************************************
+ *  MODULE NAME  : Wake Period Detection
+ *  FILE         : wake_period.h
+ *  DESCRIPTION  : Learns the wake period of each registered task from the
+ *                 ticks at which it leaves the blocked state, so the
+ *                 scheduler can put a demoted periodic task back at High
+ *                 just before its next release. Included from
+ *                 trace_hooks.h, so it must not pull in any FreeRTOS
+ *                 header itself.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef WAKE_PERIOD_H_
+#define WAKE_PERIOD_H_
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard types */
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Predictive pre-promotion: a task below High whose wakes have kept to
+ * a steady period is moved to High MLFQ_PREPROMOTE_LEAD_TICKS before its
+ * next expected wake, so the burst of that release runs at High */
+#ifndef MLFQ_PREPROMOTE_ENABLED
+#define MLFQ_PREPROMOTE_ENABLED         0U
+#endif
+
+/* Ticks before the expected wake at which the task is promoted */
+#ifndef MLFQ_PREPROMOTE_LEAD_TICKS
+#define MLFQ_PREPROMOTE_LEAD_TICKS      1U
+#endif
+
+/* Wake intervals in a row that must match before a period is trusted */
+#ifndef MLFQ_PREPROMOTE_CONFIRM
+#define MLFQ_PREPROMOTE_CONFIRM         3U
+#endif
+
+/* Largest difference from the period, in percent of it (at least one
+ * tick), for an interval to count as a match */
+#ifndef MLFQ_PREPROMOTE_JITTER_PERCENT
+#define MLFQ_PREPROMOTE_JITTER_PERCENT  10U
+#endif
+
+/* Shortest period worth predicting; faster tasks are left to the
+ * short-burst promotion and the boost */
+#ifndef MLFQ_PREPROMOTE_MIN_PERIOD_TICKS
+#define MLFQ_PREPROMOTE_MIN_PERIOD_TICKS  4U
+#endif
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U) && \
+    ((MLFQ_PREPROMOTE_CONFIRM == 0U) || (MLFQ_PREPROMOTE_CONFIRM > 255U) || \
+     (MLFQ_PREPROMOTE_LEAD_TICKS >= MLFQ_PREPROMOTE_MIN_PERIOD_TICKS))
+#error "MLFQ_PREPROMOTE_CONFIRM must be 1..255 and the lead shorter than the shortest period"
+#endif
+
+/******************************************************************************
+ *  FUNCTION PROTOTYPES
+ ******************************************************************************/
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+/* Description : Notes that a task switched out blocked (not still ready) */
+void wakePeriodTaskSwitchedOut(void *task, bool stillReady);
+
+/* Description : Stamps the wake of a blocked task moved to a ready list */
+void wakePeriodTaskReady(void *task);
+
+/* Description : Tick of the next expected wake of a slot and its period.
+ *               False unless the task is blocked and its period is
+ *               trusted */
+bool wakePeriodGetNextWake(uint32_t slot, uint32_t *wakeTick, uint32_t *period);
+
+/* Description : Clears the state of a profiler slot (slot reuse) */
+void wakePeriodResetTask(uint32_t slot);
+#endif
+
+#endif /* WAKE_PERIOD_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -10,36 +10,472 @@
 #ifndef WORKLOADS_H_
 #define WORKLOADS_H_
 
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+/* Standard integer types */
+#include <stdint.h>
+#include <stdbool.h>
+
 /******************************************************************************
  *  MACRO DEFINITIONS AND CONFIGURATIONS
  ******************************************************************************/
-/* Number of loop iterations used to simulate a CPU-heavy task */
-#define HEAVY_TASK_TIME         65535U
+/* CPU time of one CPU-heavy burst; longer than the Low level quantum */
+#define HEAVY_BURST_US          2000000U
+
+/* CPU time of one interactive burst; well inside the High level quantum */
+#define INTERACTIVE_BURST_US    1000U
+
+/* Time an interactive task waits for its next request, and a generator
+ * task in simulateBlocking(); in milliseconds, so the workload stays the
+ * same at any tick rate */
+#define INTERACTIVE_BLOCK_MS    50U
+
+/* CPU time counted as one unit of work by the throughput counters */
+#define WORKLOAD_WORK_UNIT_US   1000U
+
+/* CPU time the echo workload spends on each byte before answering */
+#ifndef ECHO_BURST_US
+#define ECHO_BURST_US           200U
+#endif
+
+/* Bit rate of the echo UART */
+#ifndef ECHO_BAUD
+#define ECHO_BAUD               115200U
+#endif
+
+/* Most phases one workload descriptor can cycle through */
+#define WORKLOAD_MAX_PHASES     4U
+
+/* Most tasks that can hold a per-task work counter */
+#ifndef WORKLOAD_MAX_COUNTERS
+#define WORKLOAD_MAX_COUNTERS   16U
+#endif
+
+/* DSP benchmark workloads: one work unit is one block of real signal
+ * processing. A floating-point FIR filter of WORKLOAD_FIR_TAPS taps over
+ * WORKLOAD_FIR_BLOCK samples, a Q15 FFT of WORKLOAD_FFT_POINTS points, or
+ * a CRC-32 of WORKLOAD_CRC_BYTES bytes */
+#ifndef WORKLOAD_FIR_TAPS
+#define WORKLOAD_FIR_TAPS       32U
+#endif
+
+#ifndef WORKLOAD_FIR_BLOCK
+#define WORKLOAD_FIR_BLOCK      128U
+#endif
+
+#ifndef WORKLOAD_FFT_POINTS
+#define WORKLOAD_FFT_POINTS     256U
+#endif
+
+#ifndef WORKLOAD_CRC_BYTES
+#define WORKLOAD_CRC_BYTES      1024U
+#endif
+
+/* Blocks a DSP task processes before it blocks for a moment */
+#ifndef WORKLOAD_DSP_BURST_BLOCKS
+#define WORKLOAD_DSP_BURST_BLOCKS  200U
+#endif
+
+#if (WORKLOAD_FIR_TAPS == 0U) || (WORKLOAD_FIR_BLOCK == 0U) || (WORKLOAD_CRC_BYTES == 0U)
+#error "WORKLOAD_FIR_TAPS, WORKLOAD_FIR_BLOCK and WORKLOAD_CRC_BYTES must not be 0"
+#endif
+
+#if (WORKLOAD_FFT_POINTS < 4U) || ((WORKLOAD_FFT_POINTS & (WORKLOAD_FFT_POINTS - 1U)) != 0U)
+#error "WORKLOAD_FFT_POINTS must be a power of two, at least 4"
+#endif
+
+/* Memory-bound benchmark: copies of WORKLOAD_COPY_BYTES, by the CPU or by
+ * the uDMA software channel, WORKLOAD_COPY_BURST_COPIES of them between
+ * blocks. One uDMA transfer moves at most 1024 words */
+#ifndef WORKLOAD_COPY_BYTES
+#define WORKLOAD_COPY_BYTES     2048U
+#endif
+
+#ifndef WORKLOAD_COPY_BURST_COPIES
+#define WORKLOAD_COPY_BURST_COPIES  256U
+#endif
+
+#if (WORKLOAD_COPY_BYTES == 0U) || ((WORKLOAD_COPY_BYTES % 4U) != 0U) || (WORKLOAD_COPY_BYTES > 4096U)
+#error "WORKLOAD_COPY_BYTES must be a multiple of 4, at most 4096"
+#endif
+
+/* ADC sampling pipeline: WORKLOAD_ADC_SAMPLE_HZ conversions a second, by
+ * uDMA into half-buffers of WORKLOAD_ADC_BATCH samples. The handler task
+ * reduces each half to one result; the aggregate task spends
+ * WORKLOAD_ADC_AGGREGATE_US on every WORKLOAD_ADC_AGGREGATE_BATCHES of
+ * them, longer than the High level quantum, so it settles lower. A
+ * bigger batch means fewer wake-ups per sample, and more latency */
+#ifndef WORKLOAD_ADC_SAMPLE_HZ
+#define WORKLOAD_ADC_SAMPLE_HZ  4000U
+#endif
+
+#ifndef WORKLOAD_ADC_BATCH
+#define WORKLOAD_ADC_BATCH      64U
+#endif
+
+#ifndef WORKLOAD_ADC_AGGREGATE_BATCHES
+#define WORKLOAD_ADC_AGGREGATE_BATCHES  64U
+#endif
+
+#ifndef WORKLOAD_ADC_AGGREGATE_US
+#define WORKLOAD_ADC_AGGREGATE_US  250000U
+#endif
+
+/* Results the handler can queue while the aggregate task is busy */
+#ifndef WORKLOAD_ADC_QUEUE_LENGTH
+#define WORKLOAD_ADC_QUEUE_LENGTH  32U
+#endif
+
+#if (WORKLOAD_ADC_BATCH == 0U) || (WORKLOAD_ADC_BATCH > 1024U)
+#error "WORKLOAD_ADC_BATCH must be 1 .. 1024 samples (one uDMA transfer)"
+#endif
+
+#if (WORKLOAD_ADC_SAMPLE_HZ == 0U) || (WORKLOAD_ADC_SAMPLE_HZ > 1000000U)
+#error "WORKLOAD_ADC_SAMPLE_HZ must be 1 .. 1000000 (the ADC's 1 Msps)"
+#endif
+
+#if (WORKLOAD_ADC_AGGREGATE_BATCHES == 0U) || (WORKLOAD_ADC_QUEUE_LENGTH == 0U)
+#error "WORKLOAD_ADC_AGGREGATE_BATCHES and WORKLOAD_ADC_QUEUE_LENGTH must not be 0"
+#endif
+
+/* Stages of the sampling pipeline in WorkloadAdcStats_t */
+#define WORKLOAD_ADC_STAGE_HANDLER    0U  /* Half full to reduced */
+#define WORKLOAD_ADC_STAGE_AGGREGATE  1U  /* Half full to aggregated */
+#define WORKLOAD_ADC_STAGES           2U
+
+/* Queue pipeline benchmark: WORKLOAD_PIPELINE_STAGES tasks in a chain, each
+ * joined to the next by a queue of WORKLOAD_PIPELINE_QUEUE_LENGTH items.
+ * Stage 0 makes the items, the last stage retires them. Each stage spends
+ * its entry of WORKLOAD_PIPELINE_COSTS_US on every item; by default the
+ * middle stage is the bottleneck and burns its quantum while the others
+ * block on their queues, so the stages settle at different levels */
+#ifndef WORKLOAD_PIPELINE_STAGES
+#define WORKLOAD_PIPELINE_STAGES        3U
+#endif
+
+#ifndef WORKLOAD_PIPELINE_COSTS_US
+#define WORKLOAD_PIPELINE_COSTS_US      { 500U, 4000U, 1000U }
+#endif
+
+#ifndef WORKLOAD_PIPELINE_QUEUE_LENGTH
+#define WORKLOAD_PIPELINE_QUEUE_LENGTH  8U
+#endif
+
+#if (WORKLOAD_PIPELINE_STAGES < 2U) || (WORKLOAD_PIPELINE_STAGES > 8U)
+#error "WORKLOAD_PIPELINE_STAGES must be 2 .. 8"
+#endif
+
+#if (WORKLOAD_PIPELINE_QUEUE_LENGTH == 0U)
+#error "WORKLOAD_PIPELINE_QUEUE_LENGTH must not be 0"
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : One behaviour of a workload. Each burst burns burst_us of
+ *               CPU time (plus up to burst_jitter_us), then the task
+ *               sleeps for a uniformly drawn block_min_ms..block_max_ms.
+ *               A block of 0 ms only yields.
+ */
+typedef struct
+{
+    uint32_t burst_us;
+    uint32_t burst_jitter_us;
+    uint32_t block_min_ms;
+    uint32_t block_max_ms;
+    uint32_t duration_ms;      /* Time in this phase, 0 = stay forever */
+} WorkloadPhase_t;
+
+/*
+ * Description : A workload: its phases run in order and wrap around.
+ */
+typedef struct
+{
+    const char     *name;
+    uint32_t        phase_count;
+    WorkloadPhase_t phases[WORKLOAD_MAX_PHASES];
+} WorkloadDescriptor_t;
+
+/*
+ * Description : One recorded burst of a task and the time it then spent
+ *               blocked, as extracted from an event trace capture.
+ */
+typedef struct
+{
+    uint32_t burst_us;
+    uint32_t block_us;         /* Rounded to whole ticks, 0 = only yields */
+} WorkloadStep_t;
+
+/*
+ * Description : The recorded behaviour of one task. The steps replay in
+ *               order and wrap around, with no random draws, so every
+ *               run sees the same demand. Tables are generated by
+ *               tools/trace_decode.py --replay.
+ */
+typedef struct
+{
+    const char           *name;
+    uint32_t              step_count;
+    const WorkloadStep_t *steps;
+} WorkloadReplay_t;
+
+/*
+ * Description : Work units completed by one task. Only the task that
+ *               claimed the counter writes it, so the update needs no
+ *               critical section; any task may read it. The count is one
+ *               aligned word, so a read never sees half an update.
+ */
+typedef struct
+{
+    const char       *name;
+    void             *task;    /* TaskHandle_t of the owner */
+    volatile uint32_t units;   /* Wraps; readers take differences */
+} WorkloadCounter_t;
+
+/*
+ * Description : One generator task. Pass a pointer to it as the task
+ *               parameter of runWorkloadTask; the counters are written by
+ *               that task only.
+ */
+typedef struct
+{
+    const WorkloadDescriptor_t *descriptor;
+    const WorkloadReplay_t *replay;  /* Recorded steps instead, NULL = none */
+    uint32_t seed;                   /* Block-time draw, 0 picks a default */
+    volatile uint32_t bursts;        /* Bursts completed */
+    volatile uint32_t phase;         /* Phase currently running */
+    WorkloadCounter_t *counter;      /* Claimed by the task, NULL if none was free */
+} WorkloadTask_t;
+
+/*
+ * Description : Receive-interrupt-to-answer time of the echo workload,
+ *               in core cycles, since the figures were last taken.
+ */
+typedef struct
+{
+    uint32_t samples;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} WorkloadEchoStats_t;
+
+/*
+ * Description : Timing of the ADC sampling pipeline since the figures
+ *               were last taken: per stage, the half-buffers through it
+ *               and the time from the half filling to the stage being
+ *               done with it, in core cycles; and the halves lost, to
+ *               the handler being late or to a full result queue.
+ */
+typedef struct
+{
+    WorkloadEchoStats_t stage[WORKLOAD_ADC_STAGES];
+    uint32_t overruns;       /* Refilled before the handler took them */
+    uint32_t dropped;        /* Results the aggregate queue had no room for */
+} WorkloadAdcStats_t;
+
+/*
+ * Description : One stage of the queue pipeline since the figures were
+ *               last taken: the items it passed on and, per item, the
+ *               time from entering the stage's input queue to the stage
+ *               being done with it, in core cycles. Stage 0 has no input
+ *               queue; its items are timed from being made. The depth is
+ *               that of the input queue as the stage took each item.
+ */
+typedef struct
+{
+    WorkloadEchoStats_t latency;
+    uint32_t depth_total;    /* Sum over the items taken */
+    uint32_t depth_max;
+} WorkloadPipelineStage_t;
+
+/*
+ * Description : Queue pipeline figures since they were last taken: the
+ *               items the last stage retired with their time from being
+ *               made, and the figures of each stage.
+ */
+typedef struct
+{
+    WorkloadEchoStats_t end_to_end;
+    WorkloadPipelineStage_t stage[WORKLOAD_PIPELINE_STAGES];
+} WorkloadPipelineStats_t;
+
+/*
+ * Description : Called by an interactive task each time it has answered
+ *               a request, with the tick the request arrived at. Runs in
+ *               that task and must not block.
+ */
+typedef void (*WorkloadResponseHook_t)(uint32_t requestTick);
+
+/******************************************************************************
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+/* Work units completed by all CPU-heavy and all interactive tasks */
+extern volatile uint32_t g_cpu_work_counter;
+extern volatile uint32_t g_interactive_work_counter;
 
-/* Number of loop iterations used to simulate an interactive task */
-#define INTERACTIVE_TASK_TIME   9800U
+/* Ready-made mixes */
+extern const WorkloadDescriptor_t g_workloadPeriodicSensor;
+extern const WorkloadDescriptor_t g_workloadBurstyNetwork;
+extern const WorkloadDescriptor_t g_workloadBackgroundCompression;
 
 /******************************************************************************
  *  FUNCTION PROTOTYPES
  ******************************************************************************/
+/*
+ * Description : Measures the busy loop against the cycle counter so
+ *               bursts are given in microseconds of CPU time. Call once
+ *               before the kernel starts; initScheduler() must run first.
+ */
+void initWorkloads(void);
+
+/*
+ * Description : Burns the given CPU time in a calibrated busy loop.
+ *               Time spent preempted does not count.
+ */
+void runBurst(uint32_t burstUs);
+
 /*
  * Description : Simulates a blocking operation by forcing the
  *               calling task to yield execution.
  */
 void simulateBlocking(void);
 
+/*
+ * Description : Claims a work counter for the calling task under 'name'.
+ *               Returns NULL once all WORKLOAD_MAX_COUNTERS are taken.
+ */
+WorkloadCounter_t *workloadClaimCounter(const char *name);
+
+/*
+ * Description : Adds work units to a counter. Call only from the task
+ *               that claimed it; a NULL counter is ignored.
+ */
+void workloadCountWork(WorkloadCounter_t *counter, uint32_t units);
+
+/*
+ * Description : Returns the number of counters claimed so far.
+ */
+uint32_t workloadGetCounterCount(void);
+
+/*
+ * Description : Returns a claimed counter by index, or NULL past the last.
+ */
+const WorkloadCounter_t *workloadGetCounter(uint32_t index);
+
+/*
+ * Description : Entry function of a generator task driven by a
+ *               WorkloadTask_t passed as the parameter. Replays the
+ *               recorded steps when the task has a replay table, and
+ *               generates from the descriptor otherwise.
+ */
+void runWorkloadTask(void *pvParameters);
+
 /*
  * Description : Entry function for an interactive workload task
  *               that performs short computations and blocks frequently.
+ *               Each wake-up after INTERACTIVE_BLOCK_MS is a request,
+ *               answered once its burst is done.
  */
 void runInteractiveTask(void *pvParameters);
 
+/*
+ * Description : Installs the hook called as the interactive tasks answer
+ *               their requests; NULL removes it.
+ */
+void workloadSetResponseHook(WorkloadResponseHook_t hook);
+
 /*
  * Description : Entry function for a CPU-intensive workload task
  *               that performs long computations before blocking.
  */
 void runCPUHeavyTask(void *pvParameters);
 
+/*
+ * Description : Entry function of the echo workload: an interactive task
+ *               that really waits on I/O. It sleeps until UART1 receives
+ *               a byte, spends ECHO_BURST_US on it, sends it back and
+ *               times the receive interrupt to the answer.
+ */
+void runEchoTask(void *pvParameters);
+
+/*
+ * Description : Copies the echo timing gathered since the last call and
+ *               starts over.
+ */
+void workloadTakeEchoStats(WorkloadEchoStats_t *output);
+
+/*
+ * Description : Entry functions of the DSP benchmark workloads. Each
+ *               processes WORKLOAD_DSP_BURST_BLOCKS blocks, counting one
+ *               work unit per block, then blocks like the CPU-heavy task.
+ *               runFirTask uses the FPU, runFftTask the dual 16-bit
+ *               multiplies of the DSP extension and runCrcTask the
+ *               table-driven Crc32() with its tables in flash. The
+ *               parameter names the work counter. The buffers are
+ *               static, so run at most one task of each.
+ */
+void runFirTask(void *pvParameters);
+void runFftTask(void *pvParameters);
+void runCrcTask(void *pvParameters);
+
+/*
+ * Description : Entry functions of the memory copy benchmark. Both copy
+ *               one WORKLOAD_COPY_BYTES buffer into another, counting
+ *               one work unit per copy. runCpuCopyTask copies with
+ *               memcpy() and stays on the CPU for the whole burst of
+ *               WORKLOAD_COPY_BURST_COPIES copies, then blocks like the
+ *               CPU-heavy task. runDmaCopyTask hands each copy to the
+ *               uDMA software channel and blocks until it completes. The
+ *               parameter names the work counter; run at most one task
+ *               of each.
+ */
+void runCpuCopyTask(void *pvParameters);
+void runDmaCopyTask(void *pvParameters);
+
+/*
+ * Description : Entry functions of the ADC sampling pipeline. The
+ *               handler task starts the sampling and sleeps until a
+ *               half-buffer fills, then filters it down to its mean,
+ *               minimum and maximum and queues the result; short bursts
+ *               on each interrupt keep it at the top level. The
+ *               aggregate task waits on the queue and runs the long
+ *               aggregation over every WORKLOAD_ADC_AGGREGATE_BATCHES
+ *               results. Each counts one work unit per half-buffer; the
+ *               parameter names the work counter. Run one of each.
+ */
+void runAdcHandlerTask(void *pvParameters);
+void runAdcAggregateTask(void *pvParameters);
+
+/*
+ * Description : Copies the pipeline timing gathered since the last call
+ *               and starts over.
+ */
+void workloadTakeAdcStats(WorkloadAdcStats_t *output);
+
+/*
+ * Description : Creates the queues between the stages of the queue
+ *               pipeline. Call once before creating the stage tasks;
+ *               returns false if the heap had no room.
+ */
+bool workloadInitPipeline(void);
+
+/*
+ * Description : Entry function of one queue pipeline stage. The
+ *               parameter is the stage index cast to a pointer; it also
+ *               picks the work counter, "Pipe0" and on, one work unit
+ *               per item passed on. Create one task per stage.
+ */
+void runPipelineStageTask(void *pvParameters);
+
+/*
+ * Description : Copies the queue pipeline figures gathered since the
+ *               last call and starts over.
+ */
+void workloadTakePipelineStats(WorkloadPipelineStats_t *output);
+
 #endif /* WORKLOADS_H_ */
 
 /******************************************************************************
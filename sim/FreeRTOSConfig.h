@@ -0,0 +1,120 @@
+/******************************************************************************
+ *  MODULE NAME  : Host Simulator Configuration
+ *  FILE         : FreeRTOSConfig.h
+ *  DESCRIPTION  : Kernel configuration of the host simulator build. Found
+ *                 before the target FreeRTOSConfig.h on the include path;
+ *                 keeps the target's scheduling settings so the scheduler
+ *                 behaves the same, and replaces the hardware parts.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/******************************************************************************
+ *  SIMULATED TIME
+ ******************************************************************************/
+
+/* Simulated seconds per host second. Only the POSIX port's tick timer is
+ * built with the faster rate (MLFQ_SIM_PORT_TU, set by the Makefile for
+ * the port sources); the kernel and the application see the target's
+ * tick, so every tick, millisecond and cycle figure is simulated. At a
+ * high MLFQ_TICK_RATE_HZ lower the speedup, or the host timer falls
+ * behind. */
+#ifndef MLFQ_SIM_SPEEDUP
+#define MLFQ_SIM_SPEEDUP                      100U
+#endif
+
+/* Target tick rate, as in the target FreeRTOSConfig.h */
+#ifndef MLFQ_TICK_RATE_HZ
+#define MLFQ_TICK_RATE_HZ                     100U
+#endif
+
+#if defined(MLFQ_SIM_PORT_TU)
+#define configTICK_RATE_HZ                    ((TickType_t)(MLFQ_TICK_RATE_HZ * MLFQ_SIM_SPEEDUP))
+#else
+#define configTICK_RATE_HZ                    ((TickType_t)MLFQ_TICK_RATE_HZ)
+#endif
+
+/* Simulated core clock; sim_drivers.c derives the cycle counter from it */
+extern unsigned long g_systemClockHz;
+#define configCPU_CLOCK_HZ                    ( g_systemClockHz )
+
+/******************************************************************************
+ *  SCHEDULING (as on target)
+ ******************************************************************************/
+#define configMINIMAL_STACK_SIZE              (1024)
+#define configMAX_PRIORITIES                  (11)
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#define configUSE_PREEMPTION                  (1)
+#define configUSE_TIME_SLICING                (1)
+#define configUSE_MUTEXES                     (1)
+#ifndef configUSE_MLFQ_NATIVE
+#define configUSE_MLFQ_NATIVE                 0
+#endif
+#ifndef configUSE_MLFQ_TIMER_SUPERVISOR
+#define configUSE_MLFQ_TIMER_SUPERVISOR       0
+#endif
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+#define configUSE_TIMERS                      1
+#endif
+#if defined(configUSE_TIMERS) && (configUSE_TIMERS == 1)
+#ifndef configTIMER_TASK_PRIORITY
+#define configTIMER_TASK_PRIORITY             6
+#endif
+#define configTIMER_QUEUE_LENGTH              8
+#define configTIMER_TASK_STACK_DEPTH          configMINIMAL_STACK_SIZE
+#define INCLUDE_xTimerPendFunctionCall        1
+#endif
+#ifndef configUSE_MLFQ_EDF
+#define configUSE_MLFQ_EDF                    0
+#endif
+#ifndef configUSE_MLFQ_SLICE_CONTROL
+#define configUSE_MLFQ_SLICE_CONTROL          0
+#endif
+#define configUSE_16_BIT_TICKS                0
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS   (1)
+#define configRECORD_STACK_HIGH_ADDRESS       1
+#define configUSE_IDLE_HOOK                   0
+#define configUSE_TICK_HOOK                   1
+
+/* Generous heap, so sweeps can run large workload mixes */
+#define configSUPPORT_DYNAMIC_ALLOCATION      1
+#define configTOTAL_HEAP_SIZE                 ((size_t)(1024U * 1024U))
+
+/******************************************************************************
+ *  HOST SPECIFICS
+ ******************************************************************************/
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY  0
+#define configKERNEL_INTERRUPT_PRIORITY       0
+
+#include <assert.h>
+#define configASSERT( x )                     assert( x )
+
+/******************************************************************************
+ *  FUNCTION INCLUDES
+ ******************************************************************************/
+#define INCLUDE_vTaskDelay          1
+#define INCLUDE_xTaskDelayUntil     1
+#define INCLUDE_vTaskPrioritySet    1
+#define INCLUDE_eTaskGetState       1
+#define INCLUDE_vTaskSuspend        1
+#define INCLUDE_vTaskDelete         1
+#define INCLUDE_xTaskGetSchedulerState 1
+#define INCLUDE_xTaskGetIdleTaskHandle 1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+
+/* The probes write Port B registers, which do not exist on the host */
+#if defined(GPIO_PROBE_ENABLED) && (GPIO_PROBE_ENABLED == 1U)
+#error "GPIO_PROBE_ENABLED is target only"
+#endif
+
+/* Same kernel hooks as the target build */
+#include "trace_hooks.h"
+
+#endif /* FREERTOS_CONFIG_H */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
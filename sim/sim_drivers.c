@@ -0,0 +1,295 @@
+/******************************************************************************
+ *  MODULE NAME  : Host Simulator Drivers
+ *  FILE         : sim_drivers.c
+ *  DESCRIPTION  : Host stand-ins for drivers.c and the DWT cycle counter.
+ *                 Log output goes to stdout, the LEDs and the quantum
+ *                 timer are no-ops, and cycles are derived from the host
+ *                 monotonic clock scaled to simulated time.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "drivers.h"
+#include "cycle_counter.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Simulated core clock, the target's PLL setting */
+#ifndef SIM_CPU_CLOCK_HZ
+#define SIM_CPU_CLOCK_HZ            80000000UL
+#endif
+
+/******************************************************************************
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+unsigned long g_systemClockHz = SIM_CPU_CLOCK_HZ;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+static uint32_t g_droppedBytes = 0U;
+static uint32_t g_queuedBytes = 0U;
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Simulated cycle counter. Host time runs MLFQ_SIM_SPEEDUP
+ *               times slower than simulated time, so one host nanosecond
+ *               is SPEEDUP * CPU_HZ / 1e9 simulated cycles. Wraps at 32
+ *               bits like the DWT counter.
+ */
+uint32_t simCycleCounterGet(void)
+{
+    struct timespec now;
+    uint64_t cyclesPerSecond = (uint64_t)MLFQ_SIM_SPEEDUP * g_systemClockHz;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * cyclesPerSecond) +
+                      (((uint64_t)now.tv_nsec * cyclesPerSecond) / 1000000000ULL));
+}
+
+void initClock(void)
+{
+    g_systemClockHz = SIM_CPU_CLOCK_HZ;
+}
+
+/*
+ * Description : The simulated clock is scaled from host time and stays
+ *               at its one rate; only the decision is exercised.
+ */
+uint32_t setClockSlow(bool slow)
+{
+    (void)slow;
+    return (uint32_t)g_systemClockHz;
+}
+
+void initUART(void)
+{
+}
+
+void initGPIO(void)
+{
+}
+
+void initDMA(void)
+{
+}
+
+/* No uDMA either; the copy is done on the spot, and the caller sleeps a
+ * tick in place of the transfer so it still blocks once per copy */
+static TaskHandle_t g_dmaCopyTask = NULL;
+
+void initDmaCopy(TaskHandle_t notifyTask)
+{
+    g_dmaCopyTask = notifyTask;
+}
+
+void startDmaCopy(uint32_t *destination, const uint32_t *source, uint32_t words)
+{
+    memcpy(destination, source, words * sizeof(uint32_t));
+    vTaskDelay(1);
+
+    if (g_dmaCopyTask != NULL)
+    {
+        (void)xTaskNotifyGive(g_dmaCopyTask);
+    }
+}
+
+uint32_t sendLog(const char *message)
+{
+    return sendLogBytes(message, (uint32_t)strlen(message));
+}
+
+/*
+ * Description : Writes the bytes to stdout straight away. Only one task
+ *               thread of the POSIX port runs at a time, so writes from
+ *               different tasks do not interleave.
+ */
+uint32_t sendLogBytes(const void *data, uint32_t length)
+{
+    uint32_t written = (uint32_t)fwrite(data, 1U, length, stdout);
+
+    g_droppedBytes += length - written;
+    g_queuedBytes  += written;
+    (void)fflush(stdout);
+    return written;
+}
+
+/* One stream on the host; the channel only matters for the ITM sink */
+uint32_t sendLogChannel(uint32_t channel, const void *data, uint32_t length)
+{
+    (void)channel;
+    return sendLogBytes(data, length);
+}
+
+/* stdout writes complete at once, so the send is done before returning */
+bool sendLogAsync(const void *data, uint32_t length, LogAsyncDone_t done, void *context)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if ((data == NULL) || (length == 0U))
+    {
+        return false;
+    }
+
+    (void)sendLogBytes(data, length);
+
+    if (done != NULL)
+    {
+        done(context, &xHigherPriorityTaskWoken);
+    }
+
+    return true;
+}
+
+uint32_t getLogTxFree(void)
+{
+    return LOG_TX_BUFFER_SIZE;
+}
+
+uint32_t getLogChannelFree(uint32_t channel)
+{
+    (void)channel;
+    return LOG_TX_BUFFER_SIZE;
+}
+
+uint32_t getLogDroppedBytes(void)
+{
+    return g_droppedBytes;
+}
+
+uint32_t getLogSinkDroppedBytes(uint32_t sink)
+{
+    return (sink == LOG_SINK_UART0) ? g_droppedBytes : 0U;
+}
+
+uint32_t getLogQueuedBytes(void)
+{
+    return g_queuedBytes;
+}
+
+/* No UART input on the host */
+uint32_t receiveBytes(uint8_t *buffer, uint32_t maxLength)
+{
+    (void)buffer;
+    (void)maxLength;
+    return 0U;
+}
+
+void setRxNotifyTask(TaskHandle_t task)
+{
+    (void)task;
+}
+
+uint32_t getRxDroppedBytes(void)
+{
+    return 0U;
+}
+
+void UART0IntHandler(void)
+{
+}
+
+/* No echo port either; the echo workload just stays blocked */
+void initEchoUART(uint32_t baud, TaskHandle_t notifyTask)
+{
+    (void)baud;
+    (void)notifyTask;
+}
+
+uint32_t receiveEchoBytes(uint8_t *bytes, uint32_t *stampCycles, uint32_t maxLength)
+{
+    (void)bytes;
+    (void)stampCycles;
+    (void)maxLength;
+    return 0U;
+}
+
+void sendEchoByte(uint8_t byte)
+{
+    (void)byte;
+}
+
+uint32_t getEchoDroppedBytes(void)
+{
+    return 0U;
+}
+
+/* No ADC; the sampling pipeline's handler task just stays blocked */
+void initAdcSampling(uint32_t sampleHz, uint16_t *buffer, uint32_t halfSamples,
+                     TaskHandle_t notifyTask)
+{
+    (void)sampleHz;
+    (void)buffer;
+    (void)halfSamples;
+    (void)notifyTask;
+}
+
+bool takeAdcHalf(uint32_t *half, uint32_t *stampCycles)
+{
+    (void)half;
+    (void)stampCycles;
+    return false;
+}
+
+uint32_t getAdcOverruns(void)
+{
+    return 0U;
+}
+
+void setLEDColor(MLFQ_QueueLevel_t queueLevel)
+{
+    (void)queueLevel;
+}
+
+#if (MLFQ_LED_ENABLED == 1U)
+void ledTaskSwitchedIn(uint32_t priority)
+{
+    (void)priority;
+}
+#endif
+
+/* No interrupt controller on the host */
+void maskIrq(uint32_t irq)
+{
+    (void)irq;
+}
+
+void unmaskIrq(uint32_t irq)
+{
+    (void)irq;
+}
+
+/* Timer enforcement is not simulated; quanta are charged by the tick */
+void initQuantumTimer(void)
+{
+}
+
+void armQuantumTimer(uint32_t cycles)
+{
+    (void)cycles;
+}
+
+void disarmQuantumTimer(void)
+{
+}
+
+void QuantumTimerIntHandler(void)
+{
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
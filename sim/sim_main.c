@@ -0,0 +1,313 @@
+/******************************************************************************
+ *  MODULE NAME  : Host Simulator
+ *  FILE         : sim_main.c
+ *  DESCRIPTION  : Runs the MLFQ scheduler and the workload generator on
+ *                 the FreeRTOS POSIX port for a fixed simulated time, then
+ *                 prints one summary line and exits. Parameters come from
+ *                 the command line so tools/sim_sweep.py can explore a
+ *                 grid of quanta, boost periods and mixes in seconds.
+ *                 Built with REPLAY=<header>, it replays a recorded trace
+ *                 (tools/trace_decode.py --replay) instead of the mix.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "scheduler.h"
+#include "metrics_logger.h"
+#include "workloads.h"
+#include "latency_stats.h"
+#include "drivers.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Replay table chosen with make REPLAY=<header> */
+#if defined(SIM_REPLAY_TRACE)
+#include SIM_REPLAY_TRACE
+#endif
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Most generator tasks in one run */
+#define SIM_MAX_TASKS               32U
+
+/* Stack of a generator task (words) */
+#define SIM_TASK_STACK_SIZE         (configMINIMAL_STACK_SIZE)
+
+#if defined(SIM_REPLAY_TRACE) && (REPLAY_TRACE_TASKS > SIM_MAX_TASKS)
+#error "Replay trace has more tasks than SIM_MAX_TASKS"
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Run settings, from the command line */
+static uint32_t g_durationMs = 10000U;
+static uint32_t g_mixCounts[3] = { 4U, 3U, 1U };
+static uint32_t g_seed = 1U;
+
+/* Generator tasks */
+static WorkloadTask_t g_tasks[SIM_MAX_TASKS];
+static uint32_t g_taskCount = 0U;
+
+/* Classes, in the order of g_mixCounts */
+static const WorkloadDescriptor_t *const g_classes[3] =
+{
+    &g_workloadPeriodicSensor,
+    &g_workloadBurstyNetwork,
+    &g_workloadBackgroundCompression
+};
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--duration-ms MS] [--quantum LEVEL TICKS] [--boost MS]\n"
+            "          [--mix SENSORS,NETWORK,COMPRESSION] [--seed N] [--report]\n",
+            program);
+    exit(2);
+}
+
+/*
+ * Description : Applies the command line to the scheduler parameters.
+ *               Runs before the kernel starts, so schedulerSetTunables()
+ *               takes effect immediately.
+ */
+static void parseArguments(int argc, char *argv[])
+{
+    MLFQ_Tunables_t tunables;
+
+    schedulerGetTunables(&tunables);
+    tunables.reporting_enabled = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--duration-ms") == 0) && ((i + 1) < argc))
+        {
+            g_durationMs = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if ((strcmp(argv[i], "--quantum") == 0) && ((i + 2) < argc))
+        {
+            uint32_t level = (uint32_t)strtoul(argv[++i], NULL, 10);
+            uint32_t ticks = (uint32_t)strtoul(argv[++i], NULL, 10);
+
+            if (level >= MLFQ_NUM_LEVELS)
+            {
+                usage(argv[0]);
+            }
+            tunables.quantum_ticks[level] = ticks;
+            tunables.quantum_us[level]    = MLFQ_TICKS_TO_US(ticks);
+        }
+        else if ((strcmp(argv[i], "--boost") == 0) && ((i + 1) < argc))
+        {
+            tunables.boost_period_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+#if !defined(SIM_REPLAY_TRACE)
+        else if ((strcmp(argv[i], "--mix") == 0) && ((i + 1) < argc))
+        {
+            unsigned long s, n, c;
+
+            if ((sscanf(argv[++i], "%lu,%lu,%lu", &s, &n, &c) != 3) ||
+                ((s + n + c) == 0UL) || ((s + n + c) > SIM_MAX_TASKS))
+            {
+                usage(argv[0]);
+            }
+            g_mixCounts[0] = (uint32_t)s;
+            g_mixCounts[1] = (uint32_t)n;
+            g_mixCounts[2] = (uint32_t)c;
+        }
+#endif
+        else if ((strcmp(argv[i], "--seed") == 0) && ((i + 1) < argc))
+        {
+            g_seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--report") == 0)
+        {
+            tunables.reporting_enabled = true;
+        }
+        else
+        {
+            usage(argv[0]);
+        }
+    }
+
+    if (!schedulerSetTunables(&tunables))
+    {
+        fprintf(stderr, "rejected scheduler parameters\n");
+        exit(2);
+    }
+}
+
+/*
+ * Description : Creates and registers the generator tasks of the mix,
+ *               or one replay task per recorded task.
+ */
+static void createMix(void)
+{
+#if defined(SIM_REPLAY_TRACE)
+    for (uint32_t i = 0U; i < REPLAY_TRACE_TASKS; i++)
+    {
+        WorkloadTask_t *task = &g_tasks[g_taskCount++];
+        TaskHandle_t handle = NULL;
+
+        task->replay = &g_replayTrace[i];
+
+        if (xTaskCreate(runWorkloadTask, g_replayTrace[i].name,
+                        SIM_TASK_STACK_SIZE, task,
+                        MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH),
+                        &handle) == pdPASS)
+        {
+            registerTask(handle);
+        }
+    }
+#else
+    for (uint32_t cls = 0U; cls < 3U; cls++)
+    {
+        for (uint32_t n = 0U; n < g_mixCounts[cls]; n++)
+        {
+            WorkloadTask_t *task = &g_tasks[g_taskCount];
+            TaskHandle_t handle = NULL;
+
+            task->descriptor = g_classes[cls];
+            task->seed       = (g_seed * 7919U) + g_taskCount + 1U;
+
+            if (xTaskCreate(runWorkloadTask, task->descriptor->name,
+                            SIM_TASK_STACK_SIZE, task,
+                            MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH),
+                            &handle) == pdPASS)
+            {
+                registerTask(handle);
+            }
+            g_taskCount++;
+        }
+    }
+#endif
+}
+
+/*
+ * Description : Prints the per-class bursts, the per-level wake latency
+ *               and the boost figures as one SIM line of key=value pairs.
+ */
+static void printSummary(void)
+{
+    MLFQ_Tunables_t tunables;
+    MLFQ_BoostStats_t boost;
+    uint32_t cyclesPerUs = (uint32_t)(configCPU_CLOCK_HZ / 1000000UL);
+
+    schedulerGetTunables(&tunables);
+    schedulerGetBoostStats(&boost);
+
+    printf("SIM,duration_ms=%lu,seed=%lu,boost_ms=%lu",
+           (unsigned long)g_durationMs, (unsigned long)g_seed,
+           (unsigned long)tunables.boost_period_ms);
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        printf(",q%lu_ticks=%lu", (unsigned long)level,
+               (unsigned long)tunables.quantum_ticks[level]);
+    }
+
+#if defined(SIM_REPLAY_TRACE)
+    /* Replay: bursts per recorded task */
+    for (uint32_t i = 0U; i < g_taskCount; i++)
+    {
+        printf(",%s_bursts=%lu", g_tasks[i].replay->name,
+               (unsigned long)g_tasks[i].bursts);
+    }
+#else
+    for (uint32_t cls = 0U; cls < 3U; cls++)
+    {
+        uint32_t bursts = 0U;
+
+        for (uint32_t i = 0U; i < g_taskCount; i++)
+        {
+            if (g_tasks[i].descriptor == g_classes[cls])
+            {
+                bursts += g_tasks[i].bursts;
+            }
+        }
+        printf(",%s_tasks=%lu,%s_bursts=%lu",
+               g_classes[cls]->name, (unsigned long)g_mixCounts[cls],
+               g_classes[cls]->name, (unsigned long)bursts);
+    }
+#endif
+
+#if (LATENCY_STATS_ENABLED == 1U)
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        LatencySummary_t summary;
+
+        (void)latencyGetLevelSummary(level, &summary);
+        printf(",l%lu_wakes=%lu,l%lu_p99_us=%lu,l%lu_max_us=%lu",
+               (unsigned long)level, (unsigned long)summary.samples,
+               (unsigned long)level, (unsigned long)(summary.p99_cycles / cyclesPerUs),
+               (unsigned long)level, (unsigned long)(summary.max_cycles / cyclesPerUs));
+    }
+#endif
+
+    printf(",boosts=%lu,boost_period_ms=%lu,early_boosts=%lu\n",
+           (unsigned long)boost.boost_count, (unsigned long)boost.period_ms,
+           (unsigned long)boost.early_boosts);
+    (void)fflush(stdout);
+}
+
+/*
+ * Description : Top-priority task that sleeps for the run duration in
+ *               simulated time, then reports and ends the process.
+ */
+static void monitorTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    vTaskDelay(pdMS_TO_TICKS(g_durationMs));
+
+    vTaskSuspendAll();
+    printSummary();
+    exit(0);
+}
+
+/******************************************************************************
+ *  MAIN FUNCTION
+ ******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    initClock();
+    initScheduler();
+    parseArguments(argc, argv);
+    initWorkloads();
+
+    createMix();
+
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+    (void)schedulerStartTimerSupervisor();
+#else
+    xTaskCreate(schedulerTask, "Scheduler", configMINIMAL_STACK_SIZE, NULL,
+                MLFQ_SUPERVISOR_PRIORITY, NULL);
+#endif
+    xTaskCreate(metricsLoggerTask, "Logger", configMINIMAL_STACK_SIZE, NULL,
+                METRICS_LOGGER_PRIORITY, NULL);
+    xTaskCreate(monitorTask, "Monitor", configMINIMAL_STACK_SIZE, NULL,
+                configMAX_PRIORITIES - 1U, NULL);
+
+    vTaskStartScheduler();
+
+    /* Only reached if the kernel could not start */
+    return 1;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,135 @@
+/******************************************************************************
+ *  MODULE NAME  : Task Aging
+ *  FILE         : aging.c
+ *  DESCRIPTION  : Stamps the moment a registered task starts waiting in a
+ *                 ready list (woken or preempted) and clears it when the
+ *                 task is switched in. The supervisor reads the waits.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "aging.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (AGING_WAIT_TRACKING_ENABLED == 1U)
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Start of the current ready wait per profiler slot */
+static volatile uint32_t g_waitSince[TICK_PROFILER_MAX_TASKS];
+static volatile bool g_waiting[TICK_PROFILER_MAX_TASKS];
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from traceTASK_SWITCHED_IN.
+ */
+void agingTaskSwitchedIn(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot >= 0)
+    {
+        g_waiting[slot] = false;
+    }
+}
+
+/*
+ * Description : Called from traceTASK_SWITCHED_OUT. A preempted task
+ *               starts waiting now; a blocked one is not waiting.
+ */
+void agingTaskSwitchedOut(void *task, bool stillReady)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot >= 0)
+    {
+        g_waitSince[slot] = cycleCounterGet();
+        g_waiting[slot]   = stillReady;
+    }
+}
+
+/*
+ * Description : Called from traceMOVED_TASK_TO_READY_STATE. Priority
+ *               changes also move tasks between ready lists; those must
+ *               not restart a wait already in progress, and the running
+ *               task is never waiting.
+ */
+void agingTaskReady(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot < 0) || g_waiting[slot] ||
+        ((TaskHandle_t)task == xTaskGetCurrentTaskHandle()))
+    {
+        return;
+    }
+
+    g_waitSince[slot] = cycleCounterGet();
+    g_waiting[slot]   = true;
+}
+
+/*
+ * Description : Reads the wait of a slot under a critical section so the
+ *               flag and the stamp belong to the same wait.
+ */
+bool agingGetWaitCycles(uint32_t slot, uint32_t *cycles)
+{
+    bool waiting;
+    uint32_t since;
+
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (cycles == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        waiting = g_waiting[slot];
+        since   = g_waitSince[slot];
+    }
+    taskEXIT_CRITICAL();
+
+    *cycles = waiting ? (cycleCounterGet() - since) : 0U;
+    return waiting;
+}
+
+/*
+ * Description : Counts the next threshold from now, so a task that is
+ *               still not scheduled after a promotion climbs one level
+ *               per threshold instead of all levels at once.
+ */
+void agingRestartWait(uint32_t slot)
+{
+    if (slot < TICK_PROFILER_MAX_TASKS)
+    {
+        g_waitSince[slot] = cycleCounterGet();
+    }
+}
+
+/*
+ * Description : Clears the wait state of a profiler slot.
+ */
+void agingResetTask(uint32_t slot)
+{
+    if (slot < TICK_PROFILER_MAX_TASKS)
+    {
+        g_waiting[slot] = false;
+    }
+}
+
+#endif /* AGING_WAIT_TRACKING_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
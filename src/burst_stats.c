@@ -0,0 +1,260 @@
+/******************************************************************************
+ *  MODULE NAME  : Burst Statistics
+ *  FILE         : burst_stats.c
+ *  DESCRIPTION  : Accumulates the CPU time of each task from the moment it
+ *                 is woken until it blocks, across preemptions and level
+ *                 changes, and files the burst under the level it started at.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "burst_stats.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+#include "scheduler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if (BURST_STATS_ENABLED == 1U)
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Level histograms of the current window, written from the switch hook */
+static uint32_t g_levelCounts[MLFQ_NUMBER_QUEUES][BURST_HIST_BUCKETS];
+static uint32_t g_levelSamples[MLFQ_NUMBER_QUEUES];
+
+/* Burst in progress per profiler slot */
+static uint32_t g_switchInCycles[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_burstCycles[TICK_PROFILER_MAX_TASKS];
+static uint8_t  g_burstLevel[TICK_PROFILER_MAX_TASKS];
+static bool     g_inBurst[TICK_PROFILER_MAX_TASKS];
+
+/* BURST_BUCKET_US in core cycles, set once the clock is known */
+static uint32_t g_bucketCycles = 1U;
+
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+/* Short-burst streaks, and promotions waiting for the supervisor */
+static uint8_t g_shortStreak[TICK_PROFILER_MAX_TASKS];
+static volatile bool g_promotePending[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_cyclesPerTick = 1U;
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+/*
+ * Description : Extends or breaks the short-burst streak of a slot whose
+ *               burst just ended. Runs in the context-switch hook, where
+ *               priorities cannot be changed, so it only raises a flag.
+ */
+static void trackShortBurst(uint32_t slot, uint32_t burstCycles)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if (record->level == (uint8_t)MLFQ_QUEUE_HIGH)
+    {
+        g_shortStreak[slot] = 0U;
+        return;
+    }
+
+    uint32_t limit = ((record->quantum_ticks * g_cyclesPerTick) / 100U) *
+                     MLFQ_SHORT_BURST_PERCENT;
+
+    if (burstCycles >= limit)
+    {
+        g_shortStreak[slot] = 0U;
+    }
+    else if (++g_shortStreak[slot] >= MLFQ_SHORT_BURSTS_TO_PROMOTE)
+    {
+        g_shortStreak[slot]    = 0U;
+        g_promotePending[slot] = true;
+    }
+}
+#endif
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Derives the bucket width in cycles from the core clock.
+ */
+void burstStatsInit(void)
+{
+    g_bucketCycles = TICK_PROFILER_US_TO_CYCLES(BURST_BUCKET_US);
+    if (g_bucketCycles == 0U)
+    {
+        g_bucketCycles = 1U;
+    }
+
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+    g_cyclesPerTick = TICK_PROFILER_CYCLES_PER_TICK;
+#endif
+}
+
+/*
+ * Description : Called from traceTASK_SWITCHED_IN. A task that is not in
+ *               a burst was just woken (or is new), so a burst begins at
+ *               its current level.
+ */
+void burstTaskSwitchedIn(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot < 0)
+    {
+        return;
+    }
+
+    g_switchInCycles[slot] = cycleCounterGet();
+
+    if (!g_inBurst[slot])
+    {
+        g_inBurst[slot]     = true;
+        g_burstCycles[slot] = 0U;
+        g_burstLevel[slot]  = tickProfilerGetRecord((uint32_t)slot)->level;
+    }
+}
+
+/*
+ * Description : Called from traceTASK_SWITCHED_OUT. Preempted tasks keep
+ *               their burst open; blocked tasks close it into a sample.
+ */
+void burstTaskSwitchedOut(void *task, bool stillReady)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot < 0) || !g_inBurst[slot])
+    {
+        return;
+    }
+
+    g_burstCycles[slot] += cycleCounterGet() - g_switchInCycles[slot];
+
+    if (!stillReady)
+    {
+        uint32_t level  = g_burstLevel[slot];
+        uint32_t bucket = g_burstCycles[slot] / g_bucketCycles;
+
+        if (bucket >= BURST_HIST_BUCKETS)
+        {
+            bucket = BURST_HIST_BUCKETS - 1U;
+        }
+
+        if (level < MLFQ_NUMBER_QUEUES)
+        {
+            g_levelCounts[level][bucket]++;
+            g_levelSamples[level]++;
+        }
+
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+        trackShortBurst((uint32_t)slot, g_burstCycles[slot]);
+#endif
+
+        g_inBurst[slot] = false;
+    }
+}
+
+/*
+ * Description : Finds the smallest bucket edge covering 'percent' of the
+ *               bursts of a level in the current window.
+ */
+bool burstGetLevelPercentile(uint32_t level, uint32_t percent,
+                             uint32_t *burstUs, uint32_t *samples)
+{
+    uint32_t counts[BURST_HIST_BUCKETS];
+    uint32_t total;
+
+    if ((level >= MLFQ_NUMBER_QUEUES) || (burstUs == NULL) || (samples == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        memcpy(counts, g_levelCounts[level], sizeof(counts));
+        total = g_levelSamples[level];
+    }
+    taskEXIT_CRITICAL();
+
+    *samples = total;
+    if (total == 0U)
+    {
+        return false;
+    }
+
+    uint32_t rank = (uint32_t)(((uint64_t)total * percent + 99U) / 100U);
+    uint32_t seen = 0U;
+    uint32_t bucket;
+
+    for (bucket = 0U; bucket < (BURST_HIST_BUCKETS - 1U); bucket++)
+    {
+        seen += counts[bucket];
+        if (seen >= rank)
+        {
+            break;
+        }
+    }
+
+    *burstUs = (bucket + 1U) * BURST_BUCKET_US;
+    return true;
+}
+
+/*
+ * Description : Empties the level histograms. Bursts in progress are
+ *               kept and land in the new window.
+ */
+void burstStartWindow(void)
+{
+    taskENTER_CRITICAL();
+    {
+        memset(g_levelCounts, 0, sizeof(g_levelCounts));
+        memset(g_levelSamples, 0, sizeof(g_levelSamples));
+    }
+    taskEXIT_CRITICAL();
+}
+
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+/*
+ * Description : Consumes the promotion flag of a slot.
+ */
+bool burstTakePromotion(uint32_t slot)
+{
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || !g_promotePending[slot])
+    {
+        return false;
+    }
+
+    g_promotePending[slot] = false;
+    return true;
+}
+#endif
+
+/*
+ * Description : Forgets the burst in progress of a profiler slot.
+ */
+void burstResetTask(uint32_t slot)
+{
+    if (slot < TICK_PROFILER_MAX_TASKS)
+    {
+        g_inBurst[slot] = false;
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+        g_shortStreak[slot]    = 0U;
+        g_promotePending[slot] = false;
+#endif
+    }
+}
+
+#endif /* BURST_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,835 @@
+/******************************************************************************
+ *  MODULE NAME  : CAN Telemetry
+ *  FILE         : can_telemetry.c
+ *  DESCRIPTION  : Builds this board's scheduler summary from the profiler,
+ *                 latency and scheduler counters, sends it as three CAN0
+ *                 frames per period and, on the collector, keeps the
+ *                 latest summary of every node for the fleet table. Fleet
+ *                 tuning stages the collector's parameter frames, applies
+ *                 a complete set a fixed lead time after its commit and
+ *                 answers with an acknowledgement.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "can_telemetry.h"
+#include "scheduler.h"
+#include "latency_stats.h"
+#include "log_format.h"
+#include "drivers.h"
+
+#include "TivaWare/driverlib/hw_memmap.h"
+#include "TivaWare/driverlib/hw_types.h"
+#include "TivaWare/driverlib/sysctl.h"
+#include "TivaWare/driverlib/gpio.h"
+#include "TivaWare/driverlib/pin_map.h"
+#include "TivaWare/driverlib/can.h"
+
+#include <string.h>
+
+#if (CAN_TELEMETRY_ENABLED == 1U)
+
+/* The bit timing is set once from the clock at start-up */
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+#error "CAN_TELEMETRY_ENABLED cannot be combined with MLFQ_CLOCK_SCALING_ENABLED"
+#endif
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Message objects: one transmit object per frame, one for the tuning
+ * frames (acknowledgements, or the collector's commands), the rest a
+ * receive FIFO */
+#define CAN_OBJ_TX_FIRST        1U
+#define CAN_OBJ_TX_TUNING       (CAN_OBJ_TX_FIRST + CAN_TELEMETRY_FRAME_ACK)
+#define CAN_OBJ_RX_FIRST        (CAN_OBJ_TX_TUNING + 1U)
+#define CAN_OBJ_LAST            32U
+
+/* The collector and tuned boards drain the receive FIFO between publishes */
+#define CAN_POLLING             ((CAN_TELEMETRY_COLLECTOR == 1U) || (CAN_TUNING_ENABLED == 1U))
+
+/* Frames seen of a complete set: one bit per level, then the boost frame */
+#define CAN_TUNING_SEEN_ALL     ((2UL << MLFQ_NUM_LEVELS) - 1UL)
+
+/* Longest wait for the tuning object to be free for the next frame */
+#define CAN_TUNING_TX_WAIT_MS   20U
+
+/* Fleet table lines */
+#define CAN_LINE_SIZE           128U
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : One board's summary, as carried by the three frames.
+ */
+typedef struct
+{
+    uint16_t   util[4];      /* High, middle, Low, idle (0.1 %) */
+    uint16_t   latency[4];   /* High p50, p99, max, Low p99 (us) */
+    uint16_t   events[3];    /* Demotions/s, boosts, overload alarms */
+    uint8_t    tasks;        /* Registered tasks */
+    uint8_t    causes;       /* MLFQ_OVERLOAD_CAUSE_x in force */
+    TickType_t heard;        /* Tick of the latest frame, 0 = never */
+} CanNodeSummary_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+
+/* Counters at the previous publish, for the per-period figures */
+static TickProfilerCpuTime_t g_lastCpu;
+static uint32_t g_lastDemotions = 0U;
+static uint32_t g_lastBoosts = 0U;
+static uint32_t g_lastAlarms = 0U;
+
+/* Frames not sent because the previous one was still pending */
+static uint32_t g_txDropped = 0U;
+
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+static CanNodeSummary_t g_nodes[CAN_TELEMETRY_MAX_NODES];
+#endif
+
+#if (CAN_TUNING_ENABLED == 1U)
+/* Set being received: its sequence number, the frames of it seen, its
+ * values, and whether its boost frame named another build */
+static MLFQ_Tunables_t g_tuningStage;
+static uint8_t g_tuningSeq = 0U;
+static uint32_t g_tuningSeen = 0U;
+static bool g_tuningMismatch = false;
+
+/* Committed set and the tick it takes effect at, valid while armed */
+static MLFQ_Tunables_t g_tuningArmedSet;
+static uint8_t g_tuningArmedSeq = 0U;
+static TickType_t g_tuningApplyTick = 0U;
+static bool g_tuningArmed = false;
+
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+/* Set queued by canTuningPush() for the telemetry task */
+static MLFQ_Tunables_t g_pushSet;
+static volatile bool g_pushPending = false;
+#endif
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Little-endian 16-bit field, saturated.
+ */
+static void putField(uint8_t *data, uint32_t index, uint32_t value)
+{
+    if (value > 0xFFFFU)
+    {
+        value = 0xFFFFU;
+    }
+
+    data[index * 2U]      = (uint8_t)(value & 0xFFU);
+    data[index * 2U + 1U] = (uint8_t)(value >> 8);
+}
+
+/*
+ * Description : Reads a field written by putField().
+ */
+static uint16_t getField(const uint8_t *data, uint32_t index)
+{
+    return (uint16_t)(data[index * 2U] | ((uint16_t)data[index * 2U + 1U] << 8));
+}
+
+/*
+ * Description : Core cycles to microseconds, saturated to a frame field.
+ */
+static uint16_t cyclesToUs(uint32_t cycles)
+{
+    uint64_t us = ((uint64_t)cycles * 1000000ULL) / configCPU_CLOCK_HZ;
+
+    return (uint16_t)((us > 0xFFFFU) ? 0xFFFFU : us);
+}
+
+/*
+ * Description : Enables CAN0 on PE4/PE5 at CAN_TELEMETRY_BITRATE and sets
+ *               up the receive FIFO on the collector. Reception is polled,
+ *               so the CAN interrupt stays disabled.
+ */
+static void initCan(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_CAN0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOE));
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_CAN0));
+
+    GPIOPinConfigure(GPIO_PE4_CAN0RX);
+    GPIOPinConfigure(GPIO_PE5_CAN0TX);
+    GPIOPinTypeCAN(GPIO_PORTE_BASE, GPIO_PIN_4 | GPIO_PIN_5);
+
+    CANInit(CAN0_BASE);
+    CANBitRateSet(CAN0_BASE, configCPU_CLOCK_HZ, CAN_TELEMETRY_BITRATE);
+
+#if CAN_POLLING
+    /* The collector takes every identifier of the telemetry block, any
+     * other board the tuning commands, chained into one FIFO */
+    for (uint32_t object = CAN_OBJ_RX_FIRST; object <= CAN_OBJ_LAST; object++)
+    {
+        tCANMsgObject message;
+
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+        message.ui32MsgID     = CAN_TELEMETRY_BASE_ID;
+        message.ui32MsgIDMask = 0x700U;
+#else
+        message.ui32MsgID     = CAN_TUNING_COMMAND_ID;
+        message.ui32MsgIDMask = 0x7FFU;
+#endif
+        message.ui32Flags     = MSG_OBJ_USE_ID_FILTER |
+                                ((object < CAN_OBJ_LAST) ? MSG_OBJ_FIFO : 0U);
+        message.ui32MsgLen    = 8U;
+        message.pui8MsgData   = NULL;
+        CANMessageSet(CAN0_BASE, object, &message, MSG_OBJ_TYPE_RX);
+    }
+#endif
+
+    CANEnable(CAN0_BASE);
+}
+
+/*
+ * Description : Collects this board's summary for the period that just
+ *               ended.
+ */
+static void buildSummary(CanNodeSummary_t *summary, uint32_t periodMs)
+{
+    TickProfilerCpuTime_t cpu;
+    uint64_t window[4] = { 0U, 0U, 0U, 0U };
+    uint64_t total;
+
+    memset(summary, 0, sizeof(*summary));
+
+    tickProfilerGetCpuTime(&cpu);
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        uint32_t column = (level == (uint32_t)MLFQ_QUEUE_HIGH) ? 0U :
+                          (level == (uint32_t)MLFQ_QUEUE_LOW) ? 2U : 1U;
+
+        window[column] += cpu.level[level] - g_lastCpu.level[level];
+    }
+    window[3] = cpu.idle - g_lastCpu.idle;
+    total = window[0] + window[1] + window[2] + window[3] +
+            (cpu.supervisor - g_lastCpu.supervisor) + (cpu.other - g_lastCpu.other);
+    g_lastCpu = cpu;
+
+    for (uint32_t column = 0U; column < 4U; column++)
+    {
+        summary->util[column] = (total == 0U) ? 0U : (uint16_t)((window[column] * 1000U) / total);
+    }
+
+#if (LATENCY_STATS_ENABLED == 1U)
+    LatencySummary_t latency;
+
+    if (latencyGetLevelSummary(MLFQ_QUEUE_HIGH, &latency) && (latency.samples != 0U))
+    {
+        summary->latency[0] = cyclesToUs(latency.p50_cycles);
+        summary->latency[1] = cyclesToUs(latency.p99_cycles);
+        summary->latency[2] = cyclesToUs(latency.max_cycles);
+    }
+    if (latencyGetLevelSummary(MLFQ_QUEUE_LOW, &latency) && (latency.samples != 0U))
+    {
+        summary->latency[3] = cyclesToUs(latency.p99_cycles);
+    }
+#endif
+
+    MLFQ_BoostStats_t boosts;
+    MLFQ_OverloadStatus_t overload;
+    uint32_t demotions = schedulerGetDemotionCount();
+
+    schedulerGetBoostStats(&boosts);
+    if (!schedulerGetOverloadStatus(&overload))
+    {
+        memset(&overload, 0, sizeof(overload));
+    }
+
+    uint32_t perSecond = (periodMs == 0U) ? 0U : (((demotions - g_lastDemotions) * 1000U) / periodMs);
+
+    summary->events[0] = (uint16_t)((perSecond > 0xFFFFU) ? 0xFFFFU : perSecond);
+    summary->events[1] = (uint16_t)(boosts.boost_count - g_lastBoosts);
+    summary->events[2] = (uint16_t)(overload.events - g_lastAlarms);
+    summary->tasks     = (uint8_t)tickProfilerGetActiveCount();
+    summary->causes    = (uint8_t)overload.causes;
+
+    g_lastDemotions = demotions;
+    g_lastBoosts    = boosts.boost_count;
+    g_lastAlarms    = overload.events;
+}
+
+/*
+ * Description : Sends one frame of this node. A frame whose previous
+ *               transmission is still pending (no other node on the bus,
+ *               or bus-off) is dropped and counted.
+ */
+static void sendFrame(uint32_t frame, uint8_t *data)
+{
+    uint32_t object = CAN_OBJ_TX_FIRST + frame;
+    tCANMsgObject message;
+
+    if ((CANStatusGet(CAN0_BASE, CAN_STS_TXREQUEST) & (1UL << (object - 1U))) != 0U)
+    {
+        g_txDropped++;
+        return;
+    }
+
+    message.ui32MsgID     = CAN_TELEMETRY_BASE_ID + (CAN_TELEMETRY_NODE_ID * 4U) + frame;
+    message.ui32MsgIDMask = 0U;
+    message.ui32Flags     = MSG_OBJ_NO_FLAGS;
+    message.ui32MsgLen    = 8U;
+    message.pui8MsgData   = data;
+    CANMessageSet(CAN0_BASE, object, &message, MSG_OBJ_TYPE_TX);
+}
+
+/*
+ * Description : Sends a summary as its three frames.
+ */
+static void publishSummary(const CanNodeSummary_t *summary)
+{
+    uint8_t data[8];
+
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        putField(data, i, summary->util[i]);
+    }
+    sendFrame(CAN_TELEMETRY_FRAME_UTIL, data);
+
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        putField(data, i, summary->latency[i]);
+    }
+    sendFrame(CAN_TELEMETRY_FRAME_LATENCY, data);
+
+    for (uint32_t i = 0U; i < 3U; i++)
+    {
+        putField(data, i, summary->events[i]);
+    }
+    data[6] = summary->tasks;
+    data[7] = summary->causes;
+    sendFrame(CAN_TELEMETRY_FRAME_EVENTS, data);
+}
+
+#if (CAN_TUNING_ENABLED == 1U)
+/*
+ * Description : Sends one tuning frame from the tuning object, waiting
+ *               up to CAN_TUNING_TX_WAIT_MS for the previous one to
+ *               leave. Returns false if it never did.
+ */
+static bool sendTuningFrame(uint32_t id, uint8_t *data)
+{
+    tCANMsgObject message;
+    uint32_t waited = 0U;
+
+    while ((CANStatusGet(CAN0_BASE, CAN_STS_TXREQUEST) & (1UL << (CAN_OBJ_TX_TUNING - 1U))) != 0U)
+    {
+        if (waited++ >= pdMS_TO_TICKS(CAN_TUNING_TX_WAIT_MS))
+        {
+            return false;
+        }
+        vTaskDelay(1U);
+    }
+
+    message.ui32MsgID     = id;
+    message.ui32MsgIDMask = 0U;
+    message.ui32Flags     = MSG_OBJ_NO_FLAGS;
+    message.ui32MsgLen    = 8U;
+    message.pui8MsgData   = data;
+    CANMessageSet(CAN0_BASE, CAN_OBJ_TX_TUNING, &message, MSG_OBJ_TYPE_TX);
+
+    return true;
+}
+
+/*
+ * Description : Arms a set to take effect 'leadMs' from now.
+ */
+static void armTuning(const MLFQ_Tunables_t *tunables, uint8_t seq, uint32_t leadMs)
+{
+    g_tuningArmedSet   = *tunables;
+    g_tuningArmedSeq   = seq;
+    g_tuningApplyTick  = xTaskGetTickCount() + pdMS_TO_TICKS(leadMs);
+    g_tuningArmed      = true;
+}
+
+/*
+ * Description : Ticks until the armed set is due, at most 'limit'.
+ */
+static TickType_t tuningWait(TickType_t limit)
+{
+    if (!g_tuningArmed)
+    {
+        return limit;
+    }
+
+    TickType_t xLeft = g_tuningApplyTick - xTaskGetTickCount();
+
+    /* Past due shows up as a wrapped, very long wait */
+    if (xLeft > (portMAX_DELAY / 2U))
+    {
+        return 0U;
+    }
+
+    return (xLeft < limit) ? xLeft : limit;
+}
+
+#if (CAN_TELEMETRY_COLLECTOR == 0U)
+/*
+ * Description : Sends this node's acknowledgement of a set.
+ */
+static void sendAck(uint8_t seq, uint32_t status)
+{
+    uint8_t data[8] = { 0U };
+
+    data[0] = seq;
+    data[1] = (uint8_t)status;
+    data[2] = (uint8_t)SCHED_POLICY;
+    (void)sendTuningFrame(CAN_TELEMETRY_BASE_ID + (CAN_TELEMETRY_NODE_ID * 4U) +
+                          CAN_TELEMETRY_FRAME_ACK, data);
+}
+
+/*
+ * Description : Stages one frame of the collector's set. A frame with a
+ *               new sequence number starts a new set from this board's
+ *               own parameters. A commit arms a complete set, or is
+ *               answered at once if the set cannot be used.
+ */
+static void receiveTuning(const uint8_t *data)
+{
+    uint8_t seq = data[1];
+
+    if ((g_tuningSeen == 0U) || (seq != g_tuningSeq))
+    {
+        schedulerGetTunables(&g_tuningStage);
+        g_tuningSeq      = seq;
+        g_tuningSeen     = 0U;
+        g_tuningMismatch = false;
+    }
+
+    switch (data[0])
+    {
+        case CAN_TUNING_KIND_QUANTUM:
+            if (data[2] < MLFQ_NUM_LEVELS)
+            {
+                g_tuningStage.quantum_ticks[data[2]] = (uint32_t)data[3] | ((uint32_t)data[4] << 8);
+                g_tuningStage.quantum_us[data[2]]    = (uint32_t)data[5] | ((uint32_t)data[6] << 8) |
+                                                       ((uint32_t)data[7] << 16);
+                g_tuningSeen |= (1UL << data[2]);
+            }
+            break;
+
+        case CAN_TUNING_KIND_BOOST:
+            g_tuningMismatch = (data[2] != (uint8_t)SCHED_POLICY) || (data[3] != (uint8_t)MLFQ_NUM_LEVELS);
+            g_tuningStage.boost_period_ms = (uint32_t)getField(data, 2U) | ((uint32_t)getField(data, 3U) << 16);
+            g_tuningSeen |= (1UL << MLFQ_NUM_LEVELS);
+            break;
+
+        case CAN_TUNING_KIND_COMMIT:
+            if (g_tuningSeen != CAN_TUNING_SEEN_ALL)
+            {
+                sendAck(seq, CAN_TUNING_ACK_INCOMPLETE);
+            }
+            else if (g_tuningMismatch)
+            {
+                sendAck(seq, CAN_TUNING_ACK_MISMATCH);
+            }
+            else
+            {
+                armTuning(&g_tuningStage, seq, getField(data, 1U));
+            }
+
+            /* A repeated commit finds nothing staged */
+            g_tuningSeen = 0U;
+            break;
+
+        default:
+            break;
+    }
+}
+#else
+/*
+ * Description : Queues a set for the telemetry task.
+ */
+bool canTuningPush(const MLFQ_Tunables_t *tunables)
+{
+    bool queued = false;
+
+    if (tunables == NULL)
+    {
+        return false;
+    }
+
+    /* Every quantum must fit its frame field; the limits do */
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        if ((tunables->quantum_ticks[level] > MLFQ_QUANTUM_MAX_TICKS) ||
+            (tunables->quantum_us[level] > MLFQ_QUANTUM_MAX_US))
+        {
+            return false;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    if (!g_pushPending)
+    {
+        g_pushSet = *tunables;
+        g_pushPending = true;
+        queued = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return queued;
+}
+
+/*
+ * Description : Sends the queued set as one frame per level, the boost
+ *               frame and the commit, then arms it here too with the
+ *               same lead, counted from the commit leaving.
+ */
+static void pushTuning(void)
+{
+    MLFQ_Tunables_t set;
+    uint8_t data[8];
+    bool sent = true;
+
+    taskENTER_CRITICAL();
+    set = g_pushSet;
+    taskEXIT_CRITICAL();
+
+    g_tuningSeq++;
+    data[1] = g_tuningSeq;
+
+    for (uint32_t level = 0U; (level < MLFQ_NUM_LEVELS) && sent; level++)
+    {
+        data[0] = CAN_TUNING_KIND_QUANTUM;
+        data[2] = (uint8_t)level;
+        data[3] = (uint8_t)(set.quantum_ticks[level] & 0xFFU);
+        data[4] = (uint8_t)(set.quantum_ticks[level] >> 8);
+        data[5] = (uint8_t)(set.quantum_us[level] & 0xFFU);
+        data[6] = (uint8_t)(set.quantum_us[level] >> 8);
+        data[7] = (uint8_t)(set.quantum_us[level] >> 16);
+        sent = sendTuningFrame(CAN_TUNING_COMMAND_ID, data);
+    }
+
+    if (sent)
+    {
+        data[0] = CAN_TUNING_KIND_BOOST;
+        data[2] = (uint8_t)SCHED_POLICY;
+        data[3] = (uint8_t)MLFQ_NUM_LEVELS;
+        putField(data, 2U, set.boost_period_ms & 0xFFFFU);
+        putField(data, 3U, set.boost_period_ms >> 16);
+        sent = sendTuningFrame(CAN_TUNING_COMMAND_ID, data);
+    }
+
+    if (sent)
+    {
+        memset(&data[2], 0, 6U);
+        data[0] = CAN_TUNING_KIND_COMMIT;
+        putField(data, 1U, CAN_TUNING_LEAD_MS);
+        sent = sendTuningFrame(CAN_TUNING_COMMAND_ID, data);
+    }
+
+    if (sent)
+    {
+        armTuning(&set, g_tuningSeq, CAN_TUNING_LEAD_MS);
+    }
+
+    g_pushPending = false;
+
+    char text[CAN_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    logPutText(&line, "[CAN] Tuning ");
+    logPutUnsigned(&line, g_tuningSeq, 0U);
+    logPutText(&line, sent ? " pushed\r\n" : " not sent, bus busy\r\n");
+    logLineSend(&line);
+}
+#endif
+
+/*
+ * Description : Applies the armed set once due, keeping this board's own
+ *               report switch. The supervisor installs it on the pass it
+ *               is woken for. Tuned boards answer with the outcome.
+ */
+static void serviceTuning(void)
+{
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+    if (g_pushPending)
+    {
+        pushTuning();
+    }
+#endif
+
+    if (!g_tuningArmed || (tuningWait(1U) != 0U))
+    {
+        return;
+    }
+
+    MLFQ_Tunables_t current;
+    bool applied;
+
+    schedulerGetTunables(&current);
+    g_tuningArmedSet.reporting_enabled = current.reporting_enabled;
+    applied = schedulerSetTunables(&g_tuningArmedSet);
+    g_tuningArmed = false;
+
+#if (CAN_TELEMETRY_COLLECTOR == 0U)
+    sendAck(g_tuningArmedSeq, applied ? CAN_TUNING_ACK_APPLIED : CAN_TUNING_ACK_REJECTED);
+#else
+    char text[CAN_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    logPutText(&line, "[CAN] Node ");
+    logPutUnsigned(&line, CAN_TELEMETRY_NODE_ID, 0U);
+    logPutText(&line, " tuning ");
+    logPutUnsigned(&line, g_tuningArmedSeq, 0U);
+    logPutText(&line, applied ? ": applied\r\n" : ": rejected\r\n");
+    logLineSend(&line);
+#endif
+}
+#endif
+
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+#if (CAN_TUNING_ENABLED == 1U)
+/*
+ * Description : Prints a node's acknowledgement of a set.
+ */
+static void receiveAck(uint32_t node, const uint8_t *data)
+{
+    static const char *const s_status[] = { "applied", "rejected", "mismatch", "incomplete" };
+    char text[CAN_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    logPutText(&line, "[CAN] Node ");
+    logPutUnsigned(&line, node, 0U);
+    logPutText(&line, " tuning ");
+    logPutUnsigned(&line, data[0], 0U);
+    logPutText(&line, ": ");
+    logPutText(&line, (data[1] <= CAN_TUNING_ACK_INCOMPLETE) ? s_status[data[1]] : "?");
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+}
+#endif
+
+/*
+ * Description : Files one received frame into its node's summary.
+ */
+static void storeFrame(uint32_t id, const uint8_t *data)
+{
+    uint32_t offset = id - CAN_TELEMETRY_BASE_ID;
+    uint32_t node = offset / 4U;
+    uint32_t frame = offset % 4U;
+    CanNodeSummary_t *summary;
+
+    if ((id < CAN_TELEMETRY_BASE_ID) || (node >= CAN_TELEMETRY_MAX_NODES))
+    {
+        return;
+    }
+
+    if (frame == CAN_TELEMETRY_FRAME_ACK)
+    {
+#if (CAN_TUNING_ENABLED == 1U)
+        receiveAck(node, data);
+#endif
+        return;
+    }
+
+    summary = &g_nodes[node];
+
+    switch (frame)
+    {
+        case CAN_TELEMETRY_FRAME_UTIL:
+            for (uint32_t i = 0U; i < 4U; i++)
+            {
+                summary->util[i] = getField(data, i);
+            }
+            break;
+
+        case CAN_TELEMETRY_FRAME_LATENCY:
+            for (uint32_t i = 0U; i < 4U; i++)
+            {
+                summary->latency[i] = getField(data, i);
+            }
+            break;
+
+        default:
+            for (uint32_t i = 0U; i < 3U; i++)
+            {
+                summary->events[i] = getField(data, i);
+            }
+            summary->tasks  = data[6];
+            summary->causes = data[7];
+            break;
+    }
+
+    summary->heard = xTaskGetTickCount();
+    if (summary->heard == 0U)
+    {
+        summary->heard = 1U;
+    }
+}
+#endif
+
+#if CAN_POLLING
+/*
+ * Description : Takes every frame waiting in the receive FIFO: summaries
+ *               and acknowledgements on the collector, tuning commands
+ *               on the other boards.
+ */
+static void drainReceive(void)
+{
+    uint32_t pending = CANStatusGet(CAN0_BASE, CAN_STS_NEWDAT);
+
+    for (uint32_t object = CAN_OBJ_RX_FIRST; object <= CAN_OBJ_LAST; object++)
+    {
+        if ((pending & (1UL << (object - 1U))) != 0U)
+        {
+            uint8_t data[8];
+            tCANMsgObject message;
+
+            message.pui8MsgData = data;
+            CANMessageGet(CAN0_BASE, object, &message, true);
+
+            if (message.ui32MsgLen == 8U)
+            {
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+                storeFrame(message.ui32MsgID, data);
+#else
+                receiveTuning(data);
+#endif
+            }
+        }
+    }
+}
+#endif
+
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+/*
+ * Description : Appends a 0.1 % value as "12.3".
+ */
+static void putPermille(LogLine_t *line, uint32_t permille)
+{
+    logPutUnsigned(line, permille / 10U, 3U);
+    logPutText(line, ".");
+    logPutUnsigned(line, permille % 10U, 0U);
+}
+
+/*
+ * Description : Prints one row per node heard from recently, the
+ *               collector itself included.
+ */
+static void printFleet(void)
+{
+    const TickType_t xStale = pdMS_TO_TICKS(CAN_TELEMETRY_PERIOD_MS * CAN_TELEMETRY_STALE_PERIODS);
+    TickType_t xNow = xTaskGetTickCount();
+    char text[CAN_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    logPutText(&line, "--- FLEET (CAN dropped ");
+    logPutUnsigned(&line, g_txDropped, 0U);
+    logPutText(&line, ") ---\r\n");
+    logLineSend(&line);
+    sendLog("Node | High % | Mid %  | Low %  | Idle % | p99 High us | p99 Low us | Dem/s | Boosts | Alarms | Tasks\r\n");
+
+    for (uint32_t node = 0U; node < CAN_TELEMETRY_MAX_NODES; node++)
+    {
+        const CanNodeSummary_t *summary = &g_nodes[node];
+
+        if ((summary->heard == 0U) || ((xNow - summary->heard) > xStale))
+        {
+            continue;
+        }
+
+        logPutUnsigned(&line, node, 4U);
+        for (uint32_t i = 0U; i < 4U; i++)
+        {
+            logPutText(&line, " | ");
+            putPermille(&line, summary->util[i]);
+            logPutText(&line, " ");
+        }
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary->latency[1], 11U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary->latency[3], 10U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary->events[0], 5U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary->events[1], 6U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary->events[2], 6U);
+        logPutText(&line, (summary->causes != 0U) ? "!| " : " | ");
+        logPutUnsigned(&line, summary->tasks, 5U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+}
+#endif
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Telemetry task body. Publishes on a fixed period with
+ *               vTaskDelayUntil(); the collector and tuned boards sleep in
+ *               CAN_TELEMETRY_POLL_MS steps in between to drain the FIFO,
+ *               waking early for an armed set.
+ */
+void canTelemetryTask(void *pvParameters)
+{
+    const TickType_t xPeriod = pdMS_TO_TICKS(CAN_TELEMETRY_PERIOD_MS);
+    TickType_t xLastPublish = xTaskGetTickCount();
+    CanNodeSummary_t own;
+
+    (void)pvParameters;
+
+    initCan();
+    tickProfilerGetCpuTime(&g_lastCpu);
+
+    for (;;)
+    {
+#if CAN_POLLING
+        while ((xTaskGetTickCount() - xLastPublish) < xPeriod)
+        {
+            TickType_t xLeft = xPeriod - (xTaskGetTickCount() - xLastPublish);
+            TickType_t xPoll = pdMS_TO_TICKS(CAN_TELEMETRY_POLL_MS);
+
+#if (CAN_TUNING_ENABLED == 1U)
+            xPoll = tuningWait(xPoll);
+#endif
+            vTaskDelay((xLeft < xPoll) ? xLeft : xPoll);
+            drainReceive();
+#if (CAN_TUNING_ENABLED == 1U)
+            serviceTuning();
+#endif
+        }
+        xLastPublish += xPeriod;
+#else
+        vTaskDelayUntil(&xLastPublish, xPeriod);
+#endif
+
+        buildSummary(&own, CAN_TELEMETRY_PERIOD_MS);
+        publishSummary(&own);
+
+#if (CAN_TELEMETRY_COLLECTOR == 1U)
+        own.heard = xTaskGetTickCount();
+        g_nodes[CAN_TELEMETRY_NODE_ID] = own;
+        printFleet();
+#endif
+    }
+}
+
+#endif /* CAN_TELEMETRY_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
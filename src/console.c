@@ -0,0 +1,496 @@
+/******************************************************************************
+ *  MODULE NAME  : Command Console
+ *  FILE         : console.c
+ *  DESCRIPTION  : Reads command lines from the UART0 receive buffer and
+ *                 turns them into scheduler parameter changes, which the
+ *                 supervisor applies as one unit.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "console.h"
+#include "scheduler.h"
+#include "metrics_logger.h"
+#include "event_trace.h"
+#include "drivers.h"
+#include "param_store.h"
+#include "stack_stats.h"
+#include "heap_stats.h"
+#include "task_pool.h"
+#include "flash_log.h"
+#include "can_telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (CONSOLE_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Most words in one command line */
+#define CONSOLE_MAX_ARGS            4U
+
+/* Longest reply line */
+#define CONSOLE_REPLY_SIZE          64U
+
+/* Longest flash history line: six counters and three values per level */
+#define CONSOLE_HISTORY_SIZE        (64U + (MLFQ_NUM_LEVELS * 18U))
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Line being assembled; only the console task touches it */
+static char g_line[CONSOLE_LINE_SIZE];
+static uint32_t g_lineLength = 0U;
+static bool g_lineOverflow = false;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Sends one reply line on the console channel. In binary
+ *               metrics mode, when the console shares the report sink,
+ *               the line is closed with a COBS delimiter so the host
+ *               decoder discards it as one bad frame instead of losing
+ *               the next record.
+ */
+static void reply(const char *text)
+{
+    (void)sendLogChannel(LOG_CHANNEL_CONSOLE, text, (uint32_t)strlen(text));
+
+#if (METRICS_BINARY_LOG_ENABLED == 1U) && (LOG_ROUTE_CONSOLE == LOG_ROUTE_REPORT)
+    static const uint8_t delimiter = 0U;
+    (void)sendLogChannel(LOG_CHANNEL_CONSOLE, &delimiter, 1U);
+#endif
+}
+
+/*
+ * Description : Parses an unsigned decimal argument. Returns false if
+ *               the word is not entirely a number.
+ */
+static bool parseNumber(const char *word, uint32_t *value)
+{
+    char *end;
+    unsigned long parsed;
+
+    if ((word == NULL) || (*word == '\0'))
+    {
+        return false;
+    }
+
+    parsed = strtoul(word, &end, 10);
+    if (*end != '\0')
+    {
+        return false;
+    }
+
+    *value = (uint32_t)parsed;
+    return true;
+}
+
+/*
+ * Description : Prints the parameters currently in force.
+ */
+static void printTunables(void)
+{
+    char text[CONSOLE_REPLY_SIZE];
+    MLFQ_Tunables_t tunables;
+
+    schedulerGetTunables(&tunables);
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        snprintf(text, sizeof(text), "quantum %lu: %lu ticks, %lu us\r\n",
+                 (unsigned long)level,
+                 (unsigned long)tunables.quantum_ticks[level],
+                 (unsigned long)tunables.quantum_us[level]);
+        reply(text);
+    }
+
+    snprintf(text, sizeof(text), "boost: %lu ms, report: %s\r\n",
+             (unsigned long)tunables.boost_period_ms,
+             tunables.reporting_enabled ? "on" : "off");
+    reply(text);
+}
+
+#if (STACK_STATS_ENABLED == 1U)
+/*
+ * Description : Prints the suggested stack depth of every task, for
+ *               copying into the xTaskCreate calls.
+ */
+static void printStacks(void)
+{
+    char text[CONSOLE_REPLY_SIZE];
+    StackStats_t stats;
+
+    for (uint32_t i = 0U; stackStatsSample(i, &stats); i++)
+    {
+        snprintf(text, sizeof(text), "%s: %lu -> %lu words\r\n",
+                 stats.name,
+                 (unsigned long)stats.size_words,
+                 (unsigned long)stats.suggested_words);
+        reply(text);
+    }
+}
+#endif
+
+#if (TASK_POOL_ENABLED == 1U)
+/*
+ * Description : Prints the usage of every task pool class.
+ */
+static void printPool(void)
+{
+    char text[CONSOLE_REPLY_SIZE];
+    TaskPoolStats_t stats;
+
+    for (uint32_t i = 0U; taskPoolGetStats(i, &stats); i++)
+    {
+        snprintf(text, sizeof(text), "pool %lu words: %lu/%lu used, peak %lu, full %lu\r\n",
+                 (unsigned long)stats.stack_words,
+                 (unsigned long)stats.in_use,
+                 (unsigned long)stats.blocks,
+                 (unsigned long)stats.peak,
+                 (unsigned long)stats.failures);
+        reply(text);
+    }
+}
+#endif
+
+#if (FLASH_LOG_ENABLED == 1U)
+/*
+ * Description : Prints the flash history, oldest record first, one line
+ *               per record:
+ *                 <seq> <uptime s> <demotions> <boosts> <overloads>
+ *                 <idle permille> <permille per level> <p50 us per level>
+ *                 <p99 us per level>
+ *               Waits for UART space, as a full region is hundreds of
+ *               lines.
+ */
+static void printHistory(void)
+{
+    char text[CONSOLE_HISTORY_SIZE];
+    FlashLogRecord_t record;
+
+    for (uint32_t i = 0U; i < flashLogGetSlotCount(); i++)
+    {
+        if (!flashLogGetRecord(i, &record))
+        {
+            continue;
+        }
+
+        int length = snprintf(text, sizeof(text), "%lu %lu %lu %lu %lu %u",
+                              (unsigned long)record.sequence,
+                              (unsigned long)record.uptime_s,
+                              (unsigned long)record.demotions,
+                              (unsigned long)record.boosts,
+                              (unsigned long)record.overloads,
+                              (unsigned)record.idle_permille);
+        for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            length += snprintf(&text[length], sizeof(text) - (uint32_t)length, " %u",
+                               (unsigned)record.level_permille[level]);
+        }
+        for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            length += snprintf(&text[length], sizeof(text) - (uint32_t)length, " %u",
+                               (unsigned)record.p50_us[level]);
+        }
+        for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            length += snprintf(&text[length], sizeof(text) - (uint32_t)length, " %u",
+                               (unsigned)record.p99_us[level]);
+        }
+        length += snprintf(&text[length], sizeof(text) - (uint32_t)length, "\r\n");
+
+        while (getLogChannelFree(LOG_CHANNEL_CONSOLE) < (uint32_t)length)
+        {
+            vTaskDelay(1);
+        }
+        reply(text);
+    }
+}
+#endif
+
+/*
+ * Description : Handles "set quantum", "set quantum_us" and "set boost".
+ *               Changes a copy of the current parameters and submits it
+ *               whole, so the supervisor never sees half an update.
+ */
+static bool executeSet(uint32_t argc, char *argv[])
+{
+    MLFQ_Tunables_t tunables;
+    uint32_t level;
+    uint32_t value;
+
+    schedulerGetTunables(&tunables);
+
+    if ((argc == 4U) && (strcmp(argv[1], "quantum") == 0) &&
+        parseNumber(argv[2], &level) && (level < MLFQ_NUM_LEVELS) &&
+        parseNumber(argv[3], &value))
+    {
+        tunables.quantum_ticks[level] = value;
+        tunables.quantum_us[level]    = MLFQ_TICKS_TO_US(value);
+    }
+    else if ((argc == 4U) && (strcmp(argv[1], "quantum_us") == 0) &&
+             parseNumber(argv[2], &level) && (level < MLFQ_NUM_LEVELS) &&
+             parseNumber(argv[3], &value))
+    {
+        tunables.quantum_us[level] = value;
+    }
+    else if ((argc == 3U) && (strcmp(argv[1], "boost") == 0) &&
+             parseNumber(argv[2], &value))
+    {
+        tunables.boost_period_ms = value;
+    }
+    else
+    {
+        return false;
+    }
+
+    return schedulerSetTunables(&tunables);
+}
+
+/*
+ * Description : Splits a line into words and runs the command.
+ */
+static void executeLine(char *line)
+{
+    char *argv[CONSOLE_MAX_ARGS];
+    uint32_t argc = 0U;
+    bool ok = true;
+
+    /* Split on spaces in place */
+    char *cursor = line;
+    while ((*cursor != '\0') && (argc < CONSOLE_MAX_ARGS))
+    {
+        while (*cursor == ' ')
+        {
+            *cursor++ = '\0';
+        }
+        if (*cursor == '\0')
+        {
+            break;
+        }
+
+        argv[argc++] = cursor;
+        while ((*cursor != ' ') && (*cursor != '\0'))
+        {
+            cursor++;
+        }
+    }
+
+    if (argc == 0U)
+    {
+        return;
+    }
+
+    if (strcmp(argv[0], "help") == 0)
+    {
+        reply("get | set quantum <lvl> <ticks> | set quantum_us <lvl> <us>\r\n");
+        reply("set boost <ms> | report on|off | save | defaults | stats | trace\r\n");
+        reply("stacks | heap | pool | history | names | push | watch [s]\r\n");
+    }
+    else if (strcmp(argv[0], "get") == 0)
+    {
+        printTunables();
+    }
+    else if (strcmp(argv[0], "set") == 0)
+    {
+        ok = executeSet(argc, argv);
+    }
+    else if ((strcmp(argv[0], "report") == 0) && (argc == 2U))
+    {
+        MLFQ_Tunables_t tunables;
+
+        schedulerGetTunables(&tunables);
+        if (strcmp(argv[1], "on") == 0)
+        {
+            tunables.reporting_enabled = true;
+        }
+        else if (strcmp(argv[1], "off") == 0)
+        {
+            tunables.reporting_enabled = false;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        ok = ok && schedulerSetTunables(&tunables);
+    }
+#if (PARAM_STORE_ENABLED == 1U)
+    else if (strcmp(argv[0], "save") == 0)
+    {
+        MLFQ_Tunables_t tunables;
+
+        schedulerGetTunables(&tunables);
+        ok = paramStoreSave(&tunables);
+    }
+    else if (strcmp(argv[0], "defaults") == 0)
+    {
+        /* Takes effect on the next boot */
+        ok = paramStoreErase();
+    }
+#endif
+    else if (strcmp(argv[0], "stats") == 0)
+    {
+        schedulerRequestReport();
+    }
+#if (MLFQ_REPORT_ON_DEMAND_ENABLED == 1U)
+    else if ((strcmp(argv[0], "watch") == 0) && (argc <= 2U))
+    {
+        /* Renewed by a host decoder while it reads the reports; 0 ends it */
+        uint32_t seconds = 0U;
+
+        if (argc == 1U)
+        {
+            schedulerWatchReports(MLFQ_REPORT_LEASE_MS);
+        }
+        else if (parseNumber(argv[1], &seconds) && (seconds <= 3600U))
+        {
+            schedulerWatchReports(seconds * 1000U);
+        }
+        else
+        {
+            ok = false;
+        }
+    }
+#endif
+#if (EVENT_TRACE_ENABLED == 1U)
+    else if (strcmp(argv[0], "trace") == 0)
+    {
+        eventTraceDump();
+    }
+#endif
+#if (STACK_STATS_ENABLED == 1U)
+    else if (strcmp(argv[0], "stacks") == 0)
+    {
+        printStacks();
+    }
+#endif
+#if (HEAP_TRACE_ENABLED == 1U)
+    else if (strcmp(argv[0], "heap") == 0)
+    {
+        heapTraceDump();
+    }
+#endif
+#if (TASK_POOL_ENABLED == 1U)
+    else if (strcmp(argv[0], "pool") == 0)
+    {
+        printPool();
+    }
+#endif
+#if (FLASH_LOG_ENABLED == 1U)
+    else if (strcmp(argv[0], "history") == 0)
+    {
+        printHistory();
+    }
+#endif
+#if (METRICS_BINARY_LOG_ENABLED == 1U)
+    else if (strcmp(argv[0], "names") == 0)
+    {
+        /* Sent by a host decoder when it attaches */
+        metricsResendTaskNames();
+    }
+#endif
+#if (CAN_TUNING_ENABLED == 1U) && (CAN_TELEMETRY_COLLECTOR == 1U)
+    else if (strcmp(argv[0], "push") == 0)
+    {
+        /* This board's parameters to every board on the bus */
+        MLFQ_Tunables_t tunables;
+
+        schedulerGetTunables(&tunables);
+        ok = canTuningPush(&tunables);
+    }
+#endif
+    else
+    {
+        ok = false;
+    }
+
+    reply(ok ? "[Console] ok\r\n" : "[Console] error (try help)\r\n");
+}
+
+/*
+ * Description : Adds one received byte to the line buffer and runs the
+ *               line on CR or LF. Over-long lines are rejected whole.
+ */
+static void consumeByte(uint8_t byte)
+{
+    if ((byte == '\r') || (byte == '\n'))
+    {
+        if (g_lineOverflow)
+        {
+            reply("[Console] line too long\r\n");
+        }
+        else if (g_lineLength > 0U)
+        {
+            g_line[g_lineLength] = '\0';
+            executeLine(g_line);
+        }
+
+        g_lineLength = 0U;
+        g_lineOverflow = false;
+    }
+    else if ((byte == '\b') || (byte == 0x7FU))
+    {
+        if (g_lineLength > 0U)
+        {
+            g_lineLength--;
+        }
+    }
+    else if (g_lineLength < (CONSOLE_LINE_SIZE - 1U))
+    {
+        g_line[g_lineLength++] = (char)byte;
+    }
+    else
+    {
+        g_lineOverflow = true;
+    }
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Console task. Registers itself with the UART driver as
+ *               the receiver and blocks on its notification between
+ *               bursts of input.
+ */
+void consoleTask(void *pvParameters)
+{
+    uint8_t chunk[16];
+
+    (void)pvParameters;
+
+    setRxNotifyTask(xTaskGetCurrentTaskHandle());
+
+    for (;;)
+    {
+        uint32_t count;
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while ((count = receiveBytes(chunk, sizeof(chunk))) > 0U)
+        {
+            for (uint32_t i = 0U; i < count; i++)
+            {
+                consumeByte(chunk[i]);
+            }
+        }
+    }
+}
+
+#endif /* CONSOLE_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -11,17 +11,760 @@
  *  INCLUDES
  ******************************************************************************/
 #include "drivers.h"
+#include "gpio_probe.h"
+#include "irq_stats.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+#include "flight_recorder.h"
 #include "TivaWare/driverlib/hw_memmap.h"
 #include "TivaWare/driverlib/hw_types.h"
 #include "TivaWare/driverlib/sysctl.h"
 #include "TivaWare/driverlib/gpio.h"
 #include "TivaWare/driverlib/uart.h"
 #include "TivaWare/driverlib/pin_map.h"
+#include "TivaWare/driverlib/hw_ints.h"
+#include "TivaWare/driverlib/interrupt.h"
+#include "TivaWare/driverlib/timer.h"
+#include "TivaWare/driverlib/udma.h"
+#include "TivaWare/driverlib/watchdog.h"
+#include "TivaWare/driverlib/hw_uart.h"
+#include "TivaWare/driverlib/hw_gpio.h"
+#include "TivaWare/driverlib/hw_nvic.h"
+#include "semphr.h"
+#include <string.h>
+
+#if (MLFQ_BOARD == MLFQ_BOARD_TM4C123)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Bit rate of the UART0 log output */
+#define LOG_UART_BAUD           115200U
+
+/* RGB LED pins on Port F, and the data register alias that writes only them */
+#define LED_PINS                (GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3)
+#define LED_DATA_REG            HWREG(GPIO_PORTF_BASE + GPIO_O_DATA + (LED_PINS << 2))
+
+/* Port F interrupt of the TM4C123 (INT_GPIOF_TM4C123 in later TivaWare);
+ * the hw_ints.h in this tree carries the older assignments without it */
+#ifndef INT_GPIOF
+#define INT_GPIOF               46U
+#endif
+
+/* uDMA software transfer interrupt of the TM4C123, likewise missing */
+#ifndef INT_UDMA
+#define INT_UDMA                62U
+#endif
+
+/* ADC0 registers of the sampling pipeline. This tree has no hw_adc.h, and
+ * its adc.h pulls in a header it does not ship, so sample sequencer 3 is
+ * driven through its registers */
+#define ADC0_ACTSS              (ADC0_BASE + 0x000UL)   /* Sequencer enables */
+#define ADC0_IM                 (ADC0_BASE + 0x008UL)   /* Interrupt mask */
+#define ADC0_ISC                (ADC0_BASE + 0x00CUL)   /* Interrupt status and clear */
+#define ADC0_EMUX               (ADC0_BASE + 0x014UL)   /* Trigger select */
+#define ADC0_SSCTL3             (ADC0_BASE + 0x0A4UL)   /* Sequencer 3 step control */
+#define ADC0_SSFIFO3            (ADC0_BASE + 0x0A8UL)   /* Sequencer 3 result FIFO */
+#define ADC_SS3_ENABLE          (1UL << 3)              /* ACTSS ASEN3 */
+#define ADC_SS3_DMA             (1UL << 11)             /* ACTSS ADEN3, IM/ISC DMA bit */
+#define ADC_EMUX_EM3_M          (0xFUL << 12)
+#define ADC_EMUX_EM3_TIMER      (0x5UL << 12)
+#define ADC_SSCTL_END0          0x2UL
+#define ADC_SSCTL_IE0           0x4UL
+#define ADC_SSCTL_TS0           0x8UL                   /* Temperature sensor */
+
+#if (LOG_ITM_ENABLED == 1U)
+/* ITM and TPIU registers (ARMv7-M architecture, not in the TivaWare maps) */
+#define ITM_STIM_BASE           0xE0000000UL    /* Stimulus port 0, one word per port */
+#define ITM_TER                 0xE0000E00UL    /* Trace enable, one bit per port */
+#define ITM_TCR                 0xE0000E80UL    /* Trace control */
+#define ITM_LAR                 0xE0000FB0UL    /* Lock access */
+#define ITM_LAR_KEY             0xC5ACCE55UL
+#define ITM_TCR_ITMENA          (1UL << 0)
+#define ITM_TCR_SYNCENA         (1UL << 2)
+#define ITM_TCR_TRACE_BUS_ID    (1UL << 16)
+
+#define TPIU_ACPR               0xE0040010UL    /* SWO clock prescaler */
+#define TPIU_SPPR               0xE00400F0UL    /* Pin protocol */
+#define TPIU_FFCR               0xE0040304UL    /* Formatter control */
+#define TPIU_SPPR_NRZ           2UL
+#define TPIU_FFCR_TRIGIN        0x100UL         /* Formatter off, as SWO needs */
+
+#define DEMCR                   0xE000EDFCUL
+#define DEMCR_TRCENA            (1UL << 24)
+
+/* Stimulus port of a LOG_CHANNEL_* */
+#define ITM_PORT_OF(channel)    (((channel) == LOG_CHANNEL_TRACE)   ? LOG_ITM_PORT_TRACE   : \
+                                 ((channel) == LOG_CHANNEL_CSV)     ? LOG_ITM_PORT_CSV     : \
+                                 ((channel) == LOG_CHANNEL_CONSOLE) ? LOG_ITM_PORT_CONSOLE : \
+                                                                      LOG_ITM_PORT_REPORT)
+#endif
+
+/* LOG_SINK_* a LOG_CHANNEL_* is routed to */
+#define LOG_ROUTE_OF(channel)   (((channel) == LOG_CHANNEL_TRACE)   ? LOG_ROUTE_TRACE   : \
+                                 ((channel) == LOG_CHANNEL_CSV)     ? LOG_ROUTE_CSV     : \
+                                 ((channel) == LOG_CHANNEL_CONSOLE) ? LOG_ROUTE_CONSOLE : \
+                                                                      LOG_ROUTE_REPORT)
+
+/* Marks g_logRam so a debugger script can find and check it */
+#define LOG_RAM_MAGIC           0x4C4F4752UL    /* "LOGR" */
+
+/******************************************************************************
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+/* Core clock in Hz behind configCPU_CLOCK_HZ; PIOSC until initClock() runs */
+unsigned long g_systemClockHz = 16000000UL;
+
+#if LOG_SINK_USED(LOG_SINK_RAM)
+/* RAM sink, read with the debugger. 'head' counts every byte written, so
+ * the newest min(head, size) bytes end at data[(head - 1) % size] */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t size;
+    volatile uint32_t head;
+    uint8_t data[LOG_RAM_BUFFER_SIZE];
+} LogRamSink_t;
+
+LogRamSink_t g_logRam = { LOG_RAM_MAGIC, LOG_RAM_BUFFER_SIZE, 0U, { 0U } };
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+#if (LOG_TX_DMA_ENABLED == 1U)
+/* Two transmit buffers: one on the wire via uDMA, one being filled */
+static uint8_t g_dmaTxBuffers[2][LOG_TX_DMA_BUFFER_SIZE];
+static volatile uint32_t g_dmaFillIndex = 0U;   /* Buffer sendLog writes to */
+static volatile uint32_t g_dmaFillLength = 0U;  /* Bytes waiting in it */
+static volatile bool g_dmaTxBusy = false;       /* A transfer is in flight */
+#else
+/* UART0 transmit ring buffer; indices run freely and are masked on access */
+static uint8_t g_txBuffer[LOG_TX_BUFFER_SIZE];
+static volatile uint32_t g_txHead = 0U;    /* Next byte written by sendLog */
+static volatile uint32_t g_txTail = 0U;    /* Next byte sent by the ISR */
+#endif
+
+#if (LOG_TX_ASYNC_ENABLED == 1U)
+/* Asynchronous send in flight: the caller's bytes not yet handed to the
+ * UART (or uDMA), and whom to tell when they all have been */
+static const uint8_t *volatile g_asyncData = NULL;
+static volatile uint32_t g_asyncLength = 0U;
+static LogAsyncDone_t g_asyncDone = NULL;
+static void *g_asyncContext = NULL;
+#if (LOG_TX_DMA_ENABLED == 1U)
+static volatile bool g_asyncAfterFill = false;  /* Fill buffer goes first */
+static volatile uint32_t g_asyncChunk = 0U;     /* Bytes in the transfer */
+#else
+static volatile uint32_t g_asyncMark = 0U;      /* g_txHead at submission */
+#endif
+#endif
+
+/* uDMA channel control table (1024-byte alignment required by hardware) */
+#pragma DATA_ALIGN(g_dmaControlTable, 1024)
+static uint8_t g_dmaControlTable[1024];
+static bool g_dmaInitialized = false;
+
+/* Task told when a software channel copy is done */
+static TaskHandle_t g_dmaCopyTask = NULL;
+
+#if (MLFQ_LED_ENABLED == 1U)
+/* LED pins lit for each FreeRTOS priority: the colour of the MLFQ level at
+ * that priority, dark for priorities outside the levels */
+static uint8_t g_ledByPriority[configMAX_PRIORITIES];
+#endif
+
+#if (GPIO_PROBE_ENABLED == 1U) && (GPIO_PROBE_LEVEL_BITS > 0U)
+#if ((1U << GPIO_PROBE_LEVEL_BITS) <= MLFQ_NUM_LEVELS)
+#error "GPIO_PROBE_LEVEL_BITS too narrow for MLFQ_NUM_LEVELS plus the idle code"
+#endif
+
+/* Level bus value for each FreeRTOS priority, already shifted into place */
+static uint8_t g_probeByPriority[configMAX_PRIORITIES];
+#endif
+
+/* Bytes discarded because a sink's buffer was full, per LOG_SINK_* */
+static volatile uint32_t g_sinkDroppedBytes[LOG_SINK_COUNT];
+
+/* Bytes accepted by sendLogChannel() on any channel since reset */
+static volatile uint32_t g_txQueuedBytes = 0U;
+
+/* UART0 receive ring buffer, filled by the ISR and drained by one task */
+static uint8_t g_rxBuffer[LOG_RX_BUFFER_SIZE];
+static volatile uint32_t g_rxHead = 0U;    /* Next byte written by the ISR */
+static volatile uint32_t g_rxTail = 0U;    /* Next byte read by receiveBytes */
+static volatile uint32_t g_rxDroppedBytes = 0U;
+static TaskHandle_t g_rxNotifyTask = NULL;
+
+/* UART1 echo receive ring buffer, with the cycle count each byte was
+ * taken at; filled by the ISR and drained by the echo task */
+static uint8_t g_echoBytes[ECHO_RX_BUFFER_SIZE];
+static uint32_t g_echoStamps[ECHO_RX_BUFFER_SIZE];
+static volatile uint32_t g_echoHead = 0U;
+static volatile uint32_t g_echoTail = 0U;
+static volatile uint32_t g_echoDroppedBytes = 0U;
+static TaskHandle_t g_echoNotifyTask = NULL;
+static uint32_t g_uart1Baud = 0U;   /* 0 until UART1 is set up */
+
+#if LOG_SINK_USED(LOG_SINK_UART1)
+/* UART1 sink transmit ring buffer; indices run freely like g_txBuffer's */
+static uint8_t g_uart1TxBuffer[LOG_UART1_BUFFER_SIZE];
+static volatile uint32_t g_uart1TxHead = 0U;
+static volatile uint32_t g_uart1TxTail = 0U;
+#endif
+
+/* Presses waiting for the button task, with the cycle count of each */
+static uint8_t g_buttonPins[BUTTON_EVENT_BUFFER_SIZE];
+static uint32_t g_buttonStamps[BUTTON_EVENT_BUFFER_SIZE];
+static volatile uint32_t g_buttonHead = 0U;
+static volatile uint32_t g_buttonTail = 0U;
+static volatile uint32_t g_buttonDropped = 0U;
+static TaskHandle_t g_buttonNotifyTask = NULL;
+
+/* Cycle count of the last edge taken per switch, for the debounce */
+static uint32_t g_buttonLastSw1 = 0U;
+static uint32_t g_buttonLastSw2 = 0U;
+
+/* ADC sampling: the two halves of the caller's buffer, which of them are
+ * full and waiting for the task, the cycle count each one filled at, and
+ * the half the task takes next. g_adcSampleHz is 0 until it is set up */
+static uint16_t *g_adcBuffer = NULL;
+static uint32_t g_adcHalfSamples = 0U;
+static uint32_t g_adcSampleHz = 0U;
+static volatile uint32_t g_adcReady = 0U;
+static uint32_t g_adcStamps[2];
+static uint32_t g_adcNextHalf = 0U;
+static volatile uint32_t g_adcOverruns = 0U;
+static TaskHandle_t g_adcNotifyTask = NULL;
+
+/* Latency timer: its reload value and the consumer of each sample */
+static uint32_t g_latencyLoad = 0U;
+static LatencyTimerHook_t g_latencyHook = NULL;
+
+/* Run-time stats counter: wraps of the 32-bit Timer 2 counted so far,
+ * the upper half of the 64-bit value */
+static volatile uint32_t g_runTimeWraps = 0U;
+
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_BLOCK)
+/* Given by the ISR whenever it frees transmit space */
+static SemaphoreHandle_t g_txSpaceSemaphore = NULL;
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static StaticSemaphore_t g_txSpaceSemaphoreControl;
+#endif
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+#if (LOG_TX_DMA_ENABLED == 1U)
+/*
+ * Description : Starts a uDMA transfer of the fill buffer if the channel
+ *               is idle, and switches sendLog over to the other buffer.
+ *               Must run with the UART interrupt masked.
+ */
+static void kickTransmit(void)
+{
+    if (g_dmaTxBusy)
+    {
+        return;
+    }
+
+#if (LOG_TX_ASYNC_ENABLED == 1U)
+    /* An asynchronous buffer goes straight from the caller's memory, in
+     * transfers of up to the uDMA limit */
+    if ((g_asyncData != NULL) && !g_asyncAfterFill)
+    {
+        if (g_asyncLength != 0U)
+        {
+            g_asyncChunk = (g_asyncLength < 1024U) ? g_asyncLength : 1024U;
+
+            uDMAChannelTransferSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT,
+                                   UDMA_MODE_BASIC,
+                                   (void *)g_asyncData,
+                                   (void *)(UART0_BASE + UART_O_DR),
+                                   g_asyncChunk);
+            uDMAChannelEnable(UDMA_CHANNEL_UART0TX);
+            g_dmaTxBusy = true;
+        }
+        return;
+    }
+
+    g_asyncAfterFill = false;
+#endif
+
+    if (g_dmaFillLength == 0U)
+    {
+        return;
+    }
+
+    uDMAChannelTransferSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT,
+                           UDMA_MODE_BASIC,
+                           g_dmaTxBuffers[g_dmaFillIndex],
+                           (void *)(UART0_BASE + UART_O_DR),
+                           g_dmaFillLength);
+    uDMAChannelEnable(UDMA_CHANNEL_UART0TX);
+
+    g_dmaTxBusy = true;
+    g_dmaFillIndex ^= 1U;
+    g_dmaFillLength = 0U;
+}
+
+/*
+ * Description : Copies as many bytes as fit into the fill buffer.
+ *               Under LOG_OVERFLOW_DROP_OLD a full fill buffer is
+ *               discarded to make room. Returns the bytes accepted.
+ *               Must run with the UART interrupt masked.
+ */
+static uint32_t enqueueBytes(const uint8_t *data, uint32_t length)
+{
+    uint32_t space = LOG_TX_DMA_BUFFER_SIZE - g_dmaFillLength;
+
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_DROP_OLD)
+    if (space < length)
+    {
+        /* Oldest unsent bytes are the ones waiting in the fill buffer */
+        g_sinkDroppedBytes[LOG_SINK_UART0] += g_dmaFillLength;
+        g_dmaFillLength = 0U;
+        space = LOG_TX_DMA_BUFFER_SIZE;
+    }
+#endif
+
+    uint32_t count = (length < space) ? length : space;
+    uint8_t *fill = &g_dmaTxBuffers[g_dmaFillIndex][g_dmaFillLength];
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        fill[i] = data[i];
+    }
+    g_dmaFillLength += count;
+
+    return count;
+}
+#else
+/*
+ * Description : Moves queued bytes into the UART0 TX FIFO and enables
+ *               the TX interrupt while bytes remain. Must run with the
+ *               UART interrupt masked (critical section or the ISR).
+ */
+static void kickTransmit(void)
+{
+    while (UARTSpaceAvail(UART0_BASE))
+    {
+#if (LOG_TX_ASYNC_ENABLED == 1U)
+        /* The asynchronous buffer slots in where the ring stood when it
+         * was submitted (DROP_OLD may have moved the tail past that) */
+        if ((g_asyncData != NULL) && ((int32_t)(g_asyncMark - g_txTail) <= 0))
+        {
+            if (g_asyncLength == 0U)
+            {
+                break;
+            }
+
+            UARTCharPutNonBlocking(UART0_BASE, *g_asyncData);
+            g_asyncData++;
+            g_asyncLength--;
+            continue;
+        }
+#endif
+
+        if (g_txTail == g_txHead)
+        {
+            break;
+        }
+
+        UARTCharPutNonBlocking(UART0_BASE,
+                               g_txBuffer[g_txTail & (LOG_TX_BUFFER_SIZE - 1U)]);
+        g_txTail++;
+    }
+
+#if (LOG_TX_ASYNC_ENABLED == 1U)
+    /* The interrupt stays on until it has reported the send complete */
+    if ((g_txTail != g_txHead) || (g_asyncData != NULL))
+#else
+    if (g_txTail != g_txHead)
+#endif
+    {
+        UARTIntEnable(UART0_BASE, UART_INT_TX);
+    }
+    else
+    {
+        UARTIntDisable(UART0_BASE, UART_INT_TX);
+    }
+}
+
+/*
+ * Description : Copies as many bytes as fit into the ring buffer.
+ *               Under LOG_OVERFLOW_DROP_OLD the oldest queued bytes
+ *               are overwritten instead. Returns the bytes accepted.
+ *               Must run with the UART interrupt masked.
+ */
+static uint32_t enqueueBytes(const uint8_t *data, uint32_t length)
+{
+    uint32_t count = 0U;
+
+    while (count < length)
+    {
+        if ((g_txHead - g_txTail) >= LOG_TX_BUFFER_SIZE)
+        {
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_DROP_OLD)
+            /* Sacrifice the oldest queued byte */
+            g_txTail++;
+            g_sinkDroppedBytes[LOG_SINK_UART0]++;
+#else
+            break;
+#endif
+        }
+
+        g_txBuffer[g_txHead & (LOG_TX_BUFFER_SIZE - 1U)] = data[count];
+        g_txHead++;
+        count++;
+    }
+
+    return count;
+}
+#endif
+
+/*
+ * Description : Queues bytes for UART0 under LOG_TX_OVERFLOW_POLICY and
+ *               returns the number queued.
+ */
+static uint32_t uart0Send(const uint8_t *bytes, uint32_t length)
+{
+    uint32_t queued = 0U;
+
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_BLOCK)
+    TickType_t xStart = xTaskGetTickCount();
+    const TickType_t xTimeout = pdMS_TO_TICKS(LOG_TX_BLOCK_TIMEOUT_MS);
+#endif
+
+    while (length > 0U)
+    {
+        uint32_t count;
+
+        taskENTER_CRITICAL();
+        {
+            count = enqueueBytes(bytes, length);
+            kickTransmit();
+        }
+        taskEXIT_CRITICAL();
+
+        bytes  += count;
+        length -= count;
+        queued += count;
+
+        if (length == 0U)
+        {
+            break;
+        }
+
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_BLOCK)
+        /* Wait for the ISR to free space, but only from a running task */
+        if ((xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) &&
+            (g_txSpaceSemaphore != NULL))
+        {
+            TickType_t xWaited = xTaskGetTickCount() - xStart;
+
+            if ((xWaited < xTimeout) &&
+                (xSemaphoreTake(g_txSpaceSemaphore, xTimeout - xWaited) == pdTRUE))
+            {
+                continue;
+            }
+        }
+#endif
+
+        /* Out of space: account for the rest of the data */
+        g_sinkDroppedBytes[LOG_SINK_UART0] += length;
+        break;
+    }
+
+    return queued;
+}
+
+#if LOG_SINK_USED(LOG_SINK_UART1)
+/*
+ * Description : Moves queued bytes into the UART1 TX FIFO and enables
+ *               the TX interrupt while bytes remain. Must run with the
+ *               UART interrupt masked (critical section or the ISR).
+ */
+static void kickUart1Transmit(void)
+{
+    while ((g_uart1TxTail != g_uart1TxHead) && UARTSpaceAvail(UART1_BASE))
+    {
+        UARTCharPutNonBlocking(UART1_BASE,
+                               g_uart1TxBuffer[g_uart1TxTail & (LOG_UART1_BUFFER_SIZE - 1U)]);
+        g_uart1TxTail++;
+    }
+
+    if (g_uart1TxTail != g_uart1TxHead)
+    {
+        UARTIntEnable(UART1_BASE, UART_INT_TX);
+    }
+    else
+    {
+        UARTIntDisable(UART1_BASE, UART_INT_TX);
+    }
+}
+
+/*
+ * Description : Queues bytes for the UART1 sink. It never waits: the
+ *               bytes that do not fit are dropped and counted.
+ */
+static uint32_t uart1Send(const uint8_t *bytes, uint32_t length)
+{
+    uint32_t count = 0U;
+
+    taskENTER_CRITICAL();
+    {
+        while ((count < length) &&
+               ((g_uart1TxHead - g_uart1TxTail) < LOG_UART1_BUFFER_SIZE))
+        {
+            g_uart1TxBuffer[g_uart1TxHead & (LOG_UART1_BUFFER_SIZE - 1U)] = bytes[count];
+            g_uart1TxHead++;
+            count++;
+        }
+        kickUart1Transmit();
+        g_sinkDroppedBytes[LOG_SINK_UART1] += length - count;
+    }
+    taskEXIT_CRITICAL();
+
+    return count;
+}
+#endif
+
+#if LOG_SINK_USED(LOG_SINK_RAM)
+/*
+ * Description : Appends bytes to the RAM sink. It always takes them; the
+ *               bytes they overwrite count as dropped.
+ */
+static uint32_t ramSend(const uint8_t *bytes, uint32_t length)
+{
+    taskENTER_CRITICAL();
+    {
+        uint32_t head = g_logRam.head;
+
+        for (uint32_t i = 0U; i < length; i++)
+        {
+            g_logRam.data[(head + i) & (LOG_RAM_BUFFER_SIZE - 1U)] = bytes[i];
+        }
+
+        if ((head + length) > LOG_RAM_BUFFER_SIZE)
+        {
+            uint32_t over = (head + length) - LOG_RAM_BUFFER_SIZE;
+
+            g_sinkDroppedBytes[LOG_SINK_RAM] += (over < length) ? over : length;
+        }
+
+        g_logRam.head = head + length;
+    }
+    taskEXIT_CRITICAL();
+
+    return length;
+}
+#endif
+
+/*
+ * Description : Returns the LED pins of a queue level; every level
+ *               between High and Low shares the Medium colour.
+ */
+static uint8_t ledPinsForLevel(MLFQ_QueueLevel_t queueLevel)
+{
+    if (queueLevel == MLFQ_QUEUE_HIGH)
+    {
+        return GPIO_PIN_3;
+    }
+    if (queueLevel == MLFQ_QUEUE_LOW)
+    {
+        return GPIO_PIN_1;
+    }
+    if ((uint32_t)queueLevel < MLFQ_NUM_LEVELS)
+    {
+        return GPIO_PIN_2;
+    }
+
+    return 0U;
+}
+
+#if (LOG_ITM_ENABLED == 1U)
+/*
+ * Description : Powers up the trace block and, unless the debug probe is
+ *               left in charge (LOG_ITM_SWO_BAUD of 0), sets the SWO pin
+ *               to NRZ at LOG_ITM_SWO_BAUD and enables the channels' ports.
+ */
+static void initITM(void)
+{
+    HWREG(DEMCR) |= DEMCR_TRCENA;
+
+#if (LOG_ITM_SWO_BAUD > 0U)
+    HWREG(TPIU_SPPR) = TPIU_SPPR_NRZ;
+    HWREG(TPIU_ACPR) = (configCPU_CLOCK_HZ / LOG_ITM_SWO_BAUD) - 1U;
+    HWREG(TPIU_FFCR) = TPIU_FFCR_TRIGIN;
+
+    HWREG(ITM_LAR) = ITM_LAR_KEY;
+    HWREG(ITM_TCR) = ITM_TCR_TRACE_BUS_ID | ITM_TCR_SYNCENA | ITM_TCR_ITMENA;
+    HWREG(ITM_TER) = (1UL << LOG_ITM_PORT_REPORT) |
+                     (1UL << LOG_ITM_PORT_TRACE) |
+                     (1UL << LOG_ITM_PORT_CSV) |
+                     (1UL << LOG_ITM_PORT_CONSOLE);
+#endif
+}
+
+/*
+ * Description : Writes bytes to a stimulus port, a word at a time while
+ *               four or more remain. Each write waits only for the port's
+ *               one-entry FIFO, so the cost is set by the SWO bit rate.
+ *               A disabled port (no probe listening) takes nothing and
+ *               the bytes count as dropped. The scheduler is suspended,
+ *               not interrupts, so a line from one task is never split
+ *               by another while ISRs keep running.
+ */
+static uint32_t itmSend(uint32_t port, const uint8_t *bytes, uint32_t length)
+{
+    volatile uint32_t *stimulus = (volatile uint32_t *)(ITM_STIM_BASE + (port * 4U));
+
+    if (((HWREG(ITM_TCR) & ITM_TCR_ITMENA) == 0U) ||
+        ((HWREG(ITM_TER) & (1UL << port)) == 0U))
+    {
+        g_sinkDroppedBytes[LOG_SINK_ITM] += length;
+        return 0U;
+    }
+
+    vTaskSuspendAll();
+    {
+        uint32_t i = 0U;
+
+        for (; (i + 4U) <= length; i += 4U)
+        {
+            uint32_t word = (uint32_t)bytes[i] |
+                            ((uint32_t)bytes[i + 1U] << 8) |
+                            ((uint32_t)bytes[i + 2U] << 16) |
+                            ((uint32_t)bytes[i + 3U] << 24);
+
+            while (*stimulus == 0U) {}
+            *stimulus = word;
+        }
+
+        for (; i < length; i++)
+        {
+            while (*stimulus == 0U) {}
+            *(volatile uint8_t *)stimulus = bytes[i];
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return length;
+}
+#endif
+
+/*
+ * Description : Queues one edge unless it falls inside the debounce
+ *               window of the previous one on the same switch.
+ */
+static void queueButtonEdge(uint32_t pin, uint32_t stamp, uint32_t *last)
+{
+    const uint32_t debounce = (configCPU_CLOCK_HZ / 1000U) * BUTTON_DEBOUNCE_MS;
+
+    if ((stamp - *last) < debounce)
+    {
+        return;
+    }
+    *last = stamp;
+
+    if ((g_buttonHead - g_buttonTail) < BUTTON_EVENT_BUFFER_SIZE)
+    {
+        g_buttonPins[g_buttonHead & (BUTTON_EVENT_BUFFER_SIZE - 1U)] = (uint8_t)pin;
+        g_buttonStamps[g_buttonHead & (BUTTON_EVENT_BUFFER_SIZE - 1U)] = stamp;
+        g_buttonHead++;
+    }
+    else
+    {
+        g_buttonDropped++;
+    }
+}
 
 /******************************************************************************
  *  FUNCTION DEFINITIONS
  ******************************************************************************/
 
+/*
+ * Description : Brings the system clock up to SYSTEM_CLOCK_CONFIG and
+ *               stores the frequency the clock tree actually produced, so
+ *               the kernel tick, UART baud rate, quantum timer and cycle
+ *               accounting all derive from the real clock.
+ */
+void initClock(void)
+{
+    /* Gate on the peripherals the boot brings up first, so they leave
+     * reset while the PLL locks and the ready waits in initUART() and
+     * initGPIO() fall straight through */
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+#if LOG_SINK_USED(LOG_SINK_UART1)
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART1);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOC);
+#endif
+#if (GPIO_PROBE_ENABLED == 1U)
+    SysCtlPeripheralEnable(GPIO_PROBE_PERIPH);
+#endif
+
+    SysCtlClockSet(SYSTEM_CLOCK_CONFIG);
+
+    g_systemClockHz = SysCtlClockGet();
+}
+
+/*
+ * Description : Changes the core clock with the kernel's interrupts
+ *               masked. SysCtlClockSet() runs from the PLL bypass until
+ *               the PLL reports lock, then the SysTick reload and the bit
+ *               rate dividers are worked out again from the clock the
+ *               tree produced, so the tick stays 1/configTICK_RATE_HZ
+ *               and the links keep their rates. The UARTs are let drain
+ *               first; a byte cut by the change would be garbled.
+ */
+uint32_t setClockSlow(bool slow)
+{
+    taskENTER_CRITICAL();
+    {
+        while (UARTBusy(UART0_BASE));
+        if (g_uart1Baud != 0U)
+        {
+            while (UARTBusy(UART1_BASE));
+        }
+
+        SysCtlClockSet(slow ? SYSTEM_CLOCK_SLOW_CONFIG : SYSTEM_CLOCK_CONFIG);
+        g_systemClockHz = SysCtlClockGet();
+
+        HWREG(NVIC_ST_RELOAD) = (g_systemClockHz / configTICK_RATE_HZ) - 1UL;
+        HWREG(NVIC_ST_CURRENT) = 0UL;
+
+        UARTConfigSetExpClk(UART0_BASE, g_systemClockHz, LOG_UART_BAUD,
+                            UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+
+        if (g_uart1Baud != 0U)
+        {
+            UARTConfigSetExpClk(UART1_BASE, g_systemClockHz, g_uart1Baud,
+                                UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+#if !LOG_SINK_USED(LOG_SINK_UART1)
+            UARTFIFODisable(UART1_BASE);
+#endif
+        }
+
+#if (LOG_ITM_ENABLED == 1U) && (LOG_ITM_SWO_BAUD > 0U)
+        HWREG(TPIU_ACPR) = (g_systemClockHz / LOG_ITM_SWO_BAUD) - 1U;
+#endif
+
+        if (g_adcSampleHz != 0U)
+        {
+            TimerLoadSet(TIMER3_BASE, TIMER_A, (g_systemClockHz / g_adcSampleHz) - 1UL);
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return (uint32_t)g_systemClockHz;
+}
+
 /*
  * Description : Initializes UART0 peripheral.
  *               Configures GPIO pins for UART RX/TX,
@@ -48,13 +791,68 @@ void initUART(void)
     /* Configure UART parameters */
     UARTConfigSetExpClk(
         UART0_BASE,
-        SysCtlClockGet(),
-        115200,
+        configCPU_CLOCK_HZ,
+        LOG_UART_BAUD,
         UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE
     );
 
     /* Enable UART module */
     UARTEnable(UART0_BASE);
+
+    /* Interrupt when the TX FIFO drains to half, at kernel priority so
+     * the handler may use FromISR APIs */
+    UARTFIFOLevelSet(UART0_BASE, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+
+#if (LOG_ITM_ENABLED == 1U)
+    initITM();
+#endif
+
+#if LOG_SINK_USED(LOG_SINK_UART1)
+    /* UART1 sink: transmit only, FIFO on, refilled from its ring by
+     * UART1IntHandler() like UART0 */
+    g_uart1Baud = LOG_UART1_BAUD;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART1);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOC);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UART1));
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOC));
+
+    GPIOPinConfigure(GPIO_PC5_U1TX);
+    GPIOPinTypeUART(GPIO_PORTC_BASE, GPIO_PIN_5);
+
+    UARTConfigSetExpClk(UART1_BASE, configCPU_CLOCK_HZ, LOG_UART1_BAUD,
+                        UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+    UARTEnable(UART1_BASE);
+    UARTFIFOLevelSet(UART1_BASE, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+    IntPrioritySet(INT_UART1, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_UART1);
+#endif
+
+    /* Received bytes are taken on the RX FIFO level or the receive
+     * timeout, so a single keystroke is delivered without polling */
+    UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
+    IntPrioritySet(INT_UART0, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_UART0);
+
+#if (LOG_TX_DMA_ENABLED == 1U)
+    /* Byte-wide transfers from memory into the UART data register; the
+     * completion is signalled on the UART0 interrupt */
+    initDMA();
+    uDMAChannelAssign(UDMA_CH9_UART0TX);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_UART0TX, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_8 |
+                          UDMA_DST_INC_NONE | UDMA_ARB_4);
+    UARTDMAEnable(UART0_BASE, UART_DMA_TX);
+#endif
+
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_BLOCK)
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    g_txSpaceSemaphore = xSemaphoreCreateBinaryStatic(&g_txSpaceSemaphoreControl);
+#else
+    g_txSpaceSemaphore = xSemaphoreCreateBinary();
+#endif
+#endif
 }
 
 /*
@@ -82,65 +880,1163 @@ void initGPIO(void)
         GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3,
         0x0
     );
+
+#if (GPIO_PROBE_ENABLED == 1U)
+    /* Timing probes, all low. The AHB aperture gives single-cycle access */
+    SysCtlPeripheralEnable(GPIO_PROBE_PERIPH);
+    while (!SysCtlPeripheralReady(GPIO_PROBE_PERIPH));
+    SysCtlGPIOAHBEnable(GPIO_PROBE_PERIPH);
+
+    GPIOPinTypeGPIOOutput(GPIO_PROBE_PORT_BASE, GPIO_PROBE_PINS);
+    GPIO_PROBE_DATA(GPIO_PROBE_PINS) = 0U;
+
+#if (GPIO_PROBE_LEVEL_BITS > 0U)
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        g_probeByPriority[MLFQ_TO_RTOS_LEVEL_SETTER(level)] =
+            (uint8_t)((level + 1U) << GPIO_PROBE_LEVEL_SHIFT);
+    }
+#if (MLFQ_RESERVE_ENABLED == 1U)
+    /* Low tasks running on the reservation are still Low */
+    g_probeByPriority[MLFQ_RESERVE_PRIORITY] =
+        (uint8_t)((MLFQ_QUEUE_LOW + 1U) << GPIO_PROBE_LEVEL_SHIFT);
+#endif
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    /* So are Low tasks parked by the weights */
+    g_probeByPriority[MLFQ_WEIGHT_PARK_PRIORITY] =
+        (uint8_t)((MLFQ_QUEUE_LOW + 1U) << GPIO_PROBE_LEVEL_SHIFT);
+#endif
+#endif
+#endif
+
+#if (MLFQ_LED_ENABLED == 1U)
+    /* Colour of each priority for the switch-in hook */
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        g_ledByPriority[MLFQ_TO_RTOS_LEVEL_SETTER(level)] =
+            ledPinsForLevel((MLFQ_QueueLevel_t)level);
+    }
+#if (MLFQ_RESERVE_ENABLED == 1U)
+    g_ledByPriority[MLFQ_RESERVE_PRIORITY] = ledPinsForLevel(MLFQ_QUEUE_LOW);
+#endif
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    g_ledByPriority[MLFQ_WEIGHT_PARK_PRIORITY] = ledPinsForLevel(MLFQ_QUEUE_LOW);
+#endif
+#endif
 }
 
 /*
- * Description : Sends a null-terminated string over UART.
- *               Used for logging and debugging messages.
+ * Description : Enables the uDMA controller and installs the channel
+ *               control table. Shared by every driver that uses uDMA;
+ *               safe to call more than once.
  */
-void sendLog(const char *message)
+void initDMA(void)
 {
-    /* Check for null pointer */
-    if (message == 0)
-        return;
-
-    /* Send each character until end of string */
-    while (*message)
+    if (g_dmaInitialized)
     {
-        UARTCharPut(UART0_BASE, *message);
-        message++;
+        return;
     }
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA));
+
+    uDMAEnable();
+    uDMAControlBaseSet(g_dmaControlTable);
+
+    g_dmaInitialized = true;
 }
 
 /*
- * Description : Sets LED color based on MLFQ queue level.
- *               High    -> Green LED
- *               Medium  -> Blue LED
- *               Low     -> Red LED
- *               Default -> All LEDs off
+ * Description : Configures the software channel for word copies in auto
+ *               mode. Arbitration every 8 words lets the log transmit
+ *               channel in between, and the bus matrix gives the CPU
+ *               the cycles the transfer does not use.
  */
-void setLEDColor(MLFQ_QueueLevel_t queueLevel)
+void initDmaCopy(TaskHandle_t notifyTask)
 {
-    /* LED output value */
-    uint8_t ledValue = 0x0;
+    g_dmaCopyTask = notifyTask;
 
-    /* Select LED based on queue level */
-    switch (queueLevel)
+    initDMA();
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_SW, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(UDMA_CHANNEL_SW | UDMA_PRI_SELECT,
+                          UDMA_SIZE_32 | UDMA_SRC_INC_32 |
+                          UDMA_DST_INC_32 | UDMA_ARB_8);
+
+    IntPrioritySet(INT_UDMA, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_UDMA);
+}
+
+/*
+ * Description : Starts one copy. The channel disables itself once it is
+ *               done and raises the software transfer interrupt.
+ */
+void startDmaCopy(uint32_t *destination, const uint32_t *source, uint32_t words)
+{
+    uDMAChannelTransferSet(UDMA_CHANNEL_SW | UDMA_PRI_SELECT, UDMA_MODE_AUTO,
+                           (void *)source, destination, words);
+    uDMAChannelEnable(UDMA_CHANNEL_SW);
+    uDMAChannelRequest(UDMA_CHANNEL_SW);
+}
+
+/*
+ * Description : Wakes the copying task.
+ */
+void uDMASoftwareIntHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    uDMAIntClear(1UL << UDMA_CHANNEL_SW);
+
+    if (g_dmaCopyTask != NULL)
+    {
+        vTaskNotifyGiveFromISR(g_dmaCopyTask, &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*
+ * Description : Queues a block of bytes for transmission.
+ *               Never busy-waits on the UART: bytes are copied into
+ *               the transmit buffer and sent by the UART0 interrupt
+ *               or, with LOG_TX_DMA_ENABLED, by uDMA while the next
+ *               buffer is being filled. When the buffer is full the
+ *               LOG_TX_OVERFLOW_POLICY decides whether new bytes are
+ *               dropped, old bytes are overwritten, or the caller
+ *               waits for space. Returns the number of bytes queued.
+ */
+uint32_t sendLogBytes(const void *data, uint32_t length)
+{
+    return sendLogChannel(LOG_CHANNEL_REPORT, data, length);
+}
+
+/*
+ * Description : Sends a block of bytes on a channel, to the sink it is
+ *               routed to. UART0 follows the buffering and overflow rules
+ *               described at sendLogBytes(); UART1 and the RAM sink never
+ *               wait; on the ITM sink the channel picks the stimulus port
+ *               and the bytes go out synchronously.
+ *               Call it from a task, or before the scheduler starts.
+ */
+uint32_t sendLogChannel(uint32_t channel, const void *data, uint32_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t queued;
+
+    /* Check for null pointer */
+    if (data == 0)
+        return 0U;
+
+    switch (LOG_ROUTE_OF(channel))
     {
-        case MLFQ_QUEUE_HIGH:
-            ledValue = GPIO_PIN_3;
+#if (LOG_ITM_ENABLED == 1U)
+        case LOG_SINK_ITM:
+            queued = itmSend(ITM_PORT_OF(channel), bytes, length);
             break;
+#endif
 
-        case MLFQ_QUEUE_MEDIUM:
-            ledValue = GPIO_PIN_2;
+#if LOG_SINK_USED(LOG_SINK_UART1)
+        case LOG_SINK_UART1:
+            queued = uart1Send(bytes, length);
             break;
+#endif
 
-        case MLFQ_QUEUE_LOW:
-            ledValue = GPIO_PIN_1;
+#if LOG_SINK_USED(LOG_SINK_RAM)
+        case LOG_SINK_RAM:
+            queued = ramSend(bytes, length);
             break;
+#endif
 
         default:
-            ledValue = 0x0;
+            queued = uart0Send(bytes, length);
             break;
     }
 
+    taskENTER_CRITICAL();
+    g_txQueuedBytes += queued;
+    taskEXIT_CRITICAL();
+
+    return queued;
+}
+
+/*
+ * Description : Queues a null-terminated string for transmission.
+ *               See sendLogBytes() for buffering and overflow rules.
+ *               Returns the number of bytes queued.
+ */
+uint32_t sendLog(const char *message)
+{
+    /* Check for null pointer */
+    if (message == 0)
+        return 0U;
+
+    return sendLogBytes(message, (uint32_t)strlen(message));
+}
+
+/*
+ * Description : Returns the total number of log bytes dropped
+ *               because a sink's buffer was full.
+ */
+uint32_t getLogDroppedBytes(void)
+{
+    uint32_t total = 0U;
+
+    for (uint32_t sink = 0U; sink < LOG_SINK_COUNT; sink++)
+    {
+        total += g_sinkDroppedBytes[sink];
+    }
+
+    return total;
+}
+
+/*
+ * Description : Returns the log bytes dropped by one LOG_SINK_*.
+ */
+uint32_t getLogSinkDroppedBytes(uint32_t sink)
+{
+    return (sink < LOG_SINK_COUNT) ? g_sinkDroppedBytes[sink] : 0U;
+}
+
+/*
+ * Description : Returns the total number of log bytes accepted for
+ *               transmission on any channel. It wraps at 32 bits, so
+ *               callers take differences.
+ */
+uint32_t getLogQueuedBytes(void)
+{
+    return g_txQueuedBytes;
+}
+
+/*
+ * Description : Hands a buffer to the UART0 interrupt (or uDMA) to send
+ *               in place, after the bytes queued so far. In uDMA mode
+ *               bytes queued while it waits for the fill buffer to go
+ *               out may go before it; bytes queued later wait for it.
+ *               The completion runs in the UART0 interrupt.
+ */
+bool sendLogAsync(const void *data, uint32_t length, LogAsyncDone_t done, void *context)
+{
+    if ((data == 0) || (length == 0U))
+    {
+        return false;
+    }
+
+#if (LOG_TX_ASYNC_ENABLED == 1U) && (LOG_ROUTE_REPORT == LOG_SINK_UART0)
+    bool accepted = false;
+
+    taskENTER_CRITICAL();
+    {
+        if (g_asyncData == NULL)
+        {
+            g_asyncDone    = done;
+            g_asyncContext = context;
+            g_asyncLength  = length;
+#if (LOG_TX_DMA_ENABLED == 1U)
+            g_asyncAfterFill = (g_dmaFillLength != 0U);
+#else
+            g_asyncMark = g_txHead;
+#endif
+            g_asyncData = (const uint8_t *)data;
+            g_txQueuedBytes += length;
+
+            kickTransmit();
+            accepted = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return accepted;
+#else
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    (void)sendLogChannel(LOG_CHANNEL_REPORT, data, length);
+
+    if (done != NULL)
+    {
+        done(context, &xHigherPriorityTaskWoken);
+    }
+
+    if ((xHigherPriorityTaskWoken != pdFALSE) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        taskYIELD();
+    }
+
+    return true;
+#endif
+}
+
+/*
+ * Description : Returns the free space in the report channel's buffer.
+ */
+uint32_t getLogTxFree(void)
+{
+    return getLogChannelFree(LOG_CHANNEL_REPORT);
+}
+
+/*
+ * Description : Returns the free space in the buffer of the sink a
+ *               channel is routed to, so a caller can pace bulk output
+ *               instead of losing bytes.
+ */
+uint32_t getLogChannelFree(uint32_t channel)
+{
+    switch (LOG_ROUTE_OF(channel))
+    {
+        case LOG_SINK_ITM:
+            /* ITM writes complete before sendLogChannel() returns */
+            return LOG_TX_BUFFER_SIZE;
+
+#if LOG_SINK_USED(LOG_SINK_UART1)
+        case LOG_SINK_UART1:
+            return LOG_UART1_BUFFER_SIZE - (g_uart1TxHead - g_uart1TxTail);
+#endif
+
+        case LOG_SINK_RAM:
+            /* Always takes everything, overwriting the oldest bytes */
+            return LOG_RAM_BUFFER_SIZE;
+
+        default:
+#if (LOG_TX_DMA_ENABLED == 1U)
+            return LOG_TX_DMA_BUFFER_SIZE - g_dmaFillLength;
+#else
+            return LOG_TX_BUFFER_SIZE - (g_txHead - g_txTail);
+#endif
+    }
+}
+
+/*
+ * Description : UART0 interrupt handler.
+ *               Refills the TX FIFO from the ring buffer, or in uDMA
+ *               mode starts the next buffer once the channel stops,
+ *               and wakes a writer waiting for space under the
+ *               blocking policy.
+ */
+void UART0IntHandler(void)
+{
+    IRQ_STATS_ENTER();
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t status = UARTIntStatus(UART0_BASE, true);
+    UARTIntClear(UART0_BASE, status);
+
+    if ((status & (UART_INT_RX | UART_INT_RT)) != 0U)
+    {
+        while (UARTCharsAvail(UART0_BASE))
+        {
+            uint8_t byte = (uint8_t)UARTCharGetNonBlocking(UART0_BASE);
+
+            if ((g_rxHead - g_rxTail) < LOG_RX_BUFFER_SIZE)
+            {
+                g_rxBuffer[g_rxHead & (LOG_RX_BUFFER_SIZE - 1U)] = byte;
+                g_rxHead++;
+            }
+            else
+            {
+                g_rxDroppedBytes++;
+            }
+        }
+
+        if (g_rxNotifyTask != NULL)
+        {
+            vTaskNotifyGiveFromISR(g_rxNotifyTask, &xHigherPriorityTaskWoken);
+        }
+    }
+
+#if (LOG_TX_DMA_ENABLED == 1U)
+    bool freed = false;
+
+    if (g_dmaTxBusy &&
+        (uDMAChannelModeGet(UDMA_CHANNEL_UART0TX | UDMA_PRI_SELECT) == UDMA_MODE_STOP))
+    {
+        g_dmaTxBusy = false;
+#if (LOG_TX_ASYNC_ENABLED == 1U)
+        if (g_asyncChunk != 0U)
+        {
+            g_asyncData   += g_asyncChunk;
+            g_asyncLength -= g_asyncChunk;
+            g_asyncChunk   = 0U;
+        }
+#endif
+        kickTransmit();
+        freed = true;
+    }
+#else
+    bool freed = ((status & UART_INT_TX) != 0U);
+
+    if (freed)
+    {
+        kickTransmit();
+    }
+#endif
+
+#if (LOG_TX_ASYNC_ENABLED == 1U)
+    /* Every byte of the caller's buffer is in the FIFO or on the wire */
+    if ((g_asyncData != NULL) && (g_asyncLength == 0U))
+    {
+        LogAsyncDone_t done = g_asyncDone;
+
+        g_asyncData = NULL;
+        kickTransmit();
+
+        if (done != NULL)
+        {
+            done(g_asyncContext, &xHigherPriorityTaskWoken);
+        }
+    }
+#endif
+
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_BLOCK)
+    if (freed && (g_txSpaceSemaphore != NULL))
+    {
+        (void)xSemaphoreGiveFromISR(g_txSpaceSemaphore,
+                                    &xHigherPriorityTaskWoken);
+    }
+#else
+    (void)freed;
+#endif
+
+    IRQ_STATS_EXIT(IRQ_STATS_SOURCE_UART0);
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*
+ * Description : Copies received bytes out of the receive ring buffer.
+ *               Single consumer: only one task may call it.
+ */
+uint32_t receiveBytes(uint8_t *buffer, uint32_t maxLength)
+{
+    uint32_t count = 0U;
+
+    while ((count < maxLength) && (g_rxTail != g_rxHead))
+    {
+        buffer[count] = g_rxBuffer[g_rxTail & (LOG_RX_BUFFER_SIZE - 1U)];
+        g_rxTail++;
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Description : Sets the task the UART0 ISR notifies on received bytes.
+ */
+void setRxNotifyTask(TaskHandle_t task)
+{
+    g_rxNotifyTask = task;
+}
+
+/*
+ * Description : Returns the number of received bytes lost because the
+ *               consumer did not keep up.
+ */
+uint32_t getRxDroppedBytes(void)
+{
+    return g_rxDroppedBytes;
+}
+
+/*
+ * Description : Sets LED color based on MLFQ queue level.
+ *               High    -> Green LED
+ *               Medium  -> Blue LED
+ *               Low     -> Red LED
+ *               Default -> All LEDs off
+ */
+void setLEDColor(MLFQ_QueueLevel_t queueLevel)
+{
     /* Update LED output */
-    GPIOPinWrite(
-        GPIO_PORTF_BASE,
-        GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3,
-        ledValue
-    );
+    LED_DATA_REG = ledPinsForLevel(queueLevel);
+}
+
+#if (MLFQ_LED_ENABLED == 1U)
+/*
+ * Description : traceTASK_SWITCHED_IN hook. One table load and one store
+ *               to the masked data register, so it costs a few cycles per
+ *               switch and no read-modify-write of Port F.
+ */
+void ledTaskSwitchedIn(uint32_t priority)
+{
+    LED_DATA_REG = g_ledByPriority[priority];
+}
+#endif
+
+#if (GPIO_PROBE_ENABLED == 1U) && (GPIO_PROBE_LEVEL_BITS > 0U)
+/*
+ * Description : traceTASK_SWITCHED_IN hook for the level bus. Like the
+ *               LED, one table load and one masked store, so the bus
+ *               changes within a few cycles of the switch.
+ */
+void gpioProbeTaskSwitchedIn(uint32_t priority)
+{
+    GPIO_PROBE_DATA(GPIO_PROBE_PIN_LEVEL) = g_probeByPriority[priority];
+}
+#endif
+
+/*
+ * Description : Disables an interrupt at the NVIC. Safe from handlers.
+ */
+void maskIrq(uint32_t irq)
+{
+    IntDisable(irq);
+}
+
+/*
+ * Description : Enables an interrupt at the NVIC.
+ */
+void unmaskIrq(uint32_t irq)
+{
+    IntEnable(irq);
+}
+
+/*
+ * Description : Configures Timer 0A as a full-width one-shot timer
+ *               clocked from the system clock. Its interrupt runs at
+ *               the kernel priority so the ISR may use FromISR APIs.
+ */
+void initQuantumTimer(void)
+{
+    /* Enable Timer 0 peripheral */
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+
+    /* Wait until the timer is ready */
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER0));
+
+    /* Full-width one-shot, stopped until armed */
+    TimerConfigure(TIMER0_BASE, TIMER_CFG_ONE_SHOT);
+    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+
+    IntPrioritySet(INT_TIMER0A, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_TIMER0A);
+}
+
+/*
+ * Description : Restarts the quantum timer so it expires after
+ *               the given number of core cycles.
+ */
+void armQuantumTimer(uint32_t cycles)
+{
+    TimerDisable(TIMER0_BASE, TIMER_A);
+    TimerLoadSet(TIMER0_BASE, TIMER_A, cycles);
+    TimerEnable(TIMER0_BASE, TIMER_A);
+}
+
+/*
+ * Description : Stops the quantum timer.
+ */
+void disarmQuantumTimer(void)
+{
+    TimerDisable(TIMER0_BASE, TIMER_A);
+}
+
+/*
+ * Description : Timer 0A interrupt handler.
+ *               Acknowledges the timeout and hands over to the
+ *               profiler's quantum enforcement path.
+ */
+void QuantumTimerIntHandler(void)
+{
+    IRQ_STATS_ENTER();
+
+    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+    tickProfilerQuantumTimerExpired();
+
+    IRQ_STATS_EXIT(IRQ_STATS_SOURCE_QUANTUM);
+}
+
+/*
+ * Description : Initializes UART1 on PC4/PC5 for the echo workload; PB0
+ *               and PB1 are taken by the GPIO probes.
+ *               Without the FIFOs the receive interrupt fires as each
+ *               stop bit arrives, so the handler's timestamp is the
+ *               arrival of that byte rather than of a FIFO level or the
+ *               receive timeout.
+ */
+void initEchoUART(uint32_t baud, TaskHandle_t notifyTask)
+{
+    g_echoNotifyTask = notifyTask;
+    g_uart1Baud = baud;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UART1);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOC);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UART1));
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOC));
+
+    GPIOPinConfigure(GPIO_PC4_U1RX);
+    GPIOPinConfigure(GPIO_PC5_U1TX);
+    GPIOPinTypeUART(GPIO_PORTC_BASE, GPIO_PIN_4 | GPIO_PIN_5);
+
+    UARTConfigSetExpClk(UART1_BASE, configCPU_CLOCK_HZ, baud,
+                        UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+    UARTEnable(UART1_BASE);
+    UARTFIFODisable(UART1_BASE);
+
+    UARTIntEnable(UART1_BASE, UART_INT_RX | UART_INT_RT);
+    IntPrioritySet(INT_UART1, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_UART1);
+}
+
+/*
+ * Description : Copies received echo bytes and their timestamps out of
+ *               the ring buffer.
+ */
+uint32_t receiveEchoBytes(uint8_t *bytes, uint32_t *stampCycles, uint32_t maxLength)
+{
+    uint32_t count = 0U;
+
+    while ((count < maxLength) && (g_echoTail != g_echoHead))
+    {
+        bytes[count] = g_echoBytes[g_echoTail & (ECHO_RX_BUFFER_SIZE - 1U)];
+        stampCycles[count] = g_echoStamps[g_echoTail & (ECHO_RX_BUFFER_SIZE - 1U)];
+        g_echoTail++;
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Description : Sends one echo byte. With the FIFO off the wait is at
+ *               most one character time.
+ */
+void sendEchoByte(uint8_t byte)
+{
+    UARTCharPut(UART1_BASE, byte);
+}
+
+/*
+ * Description : Returns the echo bytes dropped on a full buffer.
+ */
+uint32_t getEchoDroppedBytes(void)
+{
+    return g_echoDroppedBytes;
+}
+
+/*
+ * Description : UART1 interrupt handler. Stamps the bytes with the
+ *               cycle counter on entry and wakes the echo task, or
+ *               refills the TX FIFO of the UART1 log sink.
+ */
+void UART1IntHandler(void)
+{
+    uint32_t stamp = cycleCounterGet();
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t status = UARTIntStatus(UART1_BASE, true);
+
+    UARTIntClear(UART1_BASE, status);
+
+    while (UARTCharsAvail(UART1_BASE))
+    {
+        uint8_t byte = (uint8_t)UARTCharGetNonBlocking(UART1_BASE);
+
+        if ((g_echoHead - g_echoTail) < ECHO_RX_BUFFER_SIZE)
+        {
+            g_echoBytes[g_echoHead & (ECHO_RX_BUFFER_SIZE - 1U)] = byte;
+            g_echoStamps[g_echoHead & (ECHO_RX_BUFFER_SIZE - 1U)] = stamp;
+            g_echoHead++;
+        }
+        else
+        {
+            g_echoDroppedBytes++;
+        }
+    }
+
+#if LOG_SINK_USED(LOG_SINK_UART1)
+    if ((status & UART_INT_TX) != 0U)
+    {
+        kickUart1Transmit();
+    }
+#endif
+
+    if (g_echoNotifyTask != NULL)
+    {
+        vTaskNotifyGiveFromISR(g_echoNotifyTask, &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*
+ * Description : Configures the LaunchPad switches. PF0 doubles as NMI
+ *               and is locked after reset, so its commit bit is opened
+ *               with the unlock key first. Port F is already clocked by
+ *               initGPIO().
+ */
+void initButtons(TaskHandle_t notifyTask)
+{
+    const uint8_t pins = (uint8_t)(BUTTON_PIN_SW1 | BUTTON_PIN_SW2);
+
+    g_buttonNotifyTask = notifyTask;
+
+    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
+    HWREG(GPIO_PORTF_BASE + GPIO_O_CR) |= BUTTON_PIN_SW2;
+    HWREG(GPIO_PORTF_BASE + GPIO_O_LOCK) = 0U;
+
+    GPIOPinTypeGPIOInput(GPIO_PORTF_BASE, pins);
+    GPIOPadConfigSet(GPIO_PORTF_BASE, pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+
+    /* Pressing pulls the pin to ground */
+    GPIOIntTypeSet(GPIO_PORTF_BASE, pins, GPIO_FALLING_EDGE);
+    GPIOIntClear(GPIO_PORTF_BASE, pins);
+    GPIOIntEnable(GPIO_PORTF_BASE, pins);
+
+    IntPrioritySet(INT_GPIOF, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_GPIOF);
+}
+
+/*
+ * Description : Takes the oldest waiting press.
+ */
+bool takeButtonEvent(uint32_t *pin, uint32_t *stampCycles)
+{
+    if (g_buttonTail == g_buttonHead)
+    {
+        return false;
+    }
+
+    *pin = g_buttonPins[g_buttonTail & (BUTTON_EVENT_BUFFER_SIZE - 1U)];
+    *stampCycles = g_buttonStamps[g_buttonTail & (BUTTON_EVENT_BUFFER_SIZE - 1U)];
+    g_buttonTail++;
+
+    return true;
+}
+
+/*
+ * Description : Returns the presses dropped on a full buffer.
+ */
+uint32_t getButtonDroppedEvents(void)
+{
+    return g_buttonDropped;
+}
+
+/*
+ * Description : GPIO Port F interrupt handler. Stamps the edge with the
+ *               cycle counter on entry and wakes the button task.
+ */
+void GPIOFIntHandler(void)
+{
+    uint32_t stamp = cycleCounterGet();
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t status = GPIOIntStatus(GPIO_PORTF_BASE, true);
+    uint32_t queued = g_buttonHead;
+
+    GPIOIntClear(GPIO_PORTF_BASE, status);
+
+    if ((status & BUTTON_PIN_SW1) != 0U)
+    {
+        queueButtonEdge(BUTTON_PIN_SW1, stamp, &g_buttonLastSw1);
+    }
+    if ((status & BUTTON_PIN_SW2) != 0U)
+    {
+        queueButtonEdge(BUTTON_PIN_SW2, stamp, &g_buttonLastSw2);
+    }
+
+    if ((g_buttonHead != queued) && (g_buttonNotifyTask != NULL))
+    {
+        vTaskNotifyGiveFromISR(g_buttonNotifyTask, &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*
+ * Description : Points one control structure of the ADC channel at its
+ *               half of the buffer. The FIFO address stays put; only the
+ *               destination moves on.
+ */
+static void armAdcHalf(uint32_t half)
+{
+    uDMAChannelTransferSet(UDMA_CHANNEL_ADC3 | ((half == 0U) ? UDMA_PRI_SELECT : UDMA_ALT_SELECT),
+                           UDMA_MODE_PINGPONG, (void *)ADC0_SSFIFO3,
+                           &g_adcBuffer[half * g_adcHalfSamples], g_adcHalfSamples);
+}
+
+/*
+ * Description : Samples the internal temperature sensor on ADC0 sample
+ *               sequencer 3, one conversion per Timer 3A timeout. Each
+ *               result goes by uDMA in ping-pong mode into one half of
+ *               the buffer while the other half waits for the task, so
+ *               the CPU only sees one interrupt per half.
+ */
+void initAdcSampling(uint32_t sampleHz, uint16_t *buffer, uint32_t halfSamples,
+                     TaskHandle_t notifyTask)
+{
+    g_adcBuffer = buffer;
+    g_adcHalfSamples = halfSamples;
+    g_adcNotifyTask = notifyTask;
+    g_adcReady = 0U;
+    g_adcNextHalf = 0U;
+
+    initDMA();
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER3);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC0));
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER3));
+
+    HWREG(ADC0_ACTSS) &= ~ADC_SS3_ENABLE;
+    HWREG(ADC0_EMUX) = (HWREG(ADC0_EMUX) & ~ADC_EMUX_EM3_M) | ADC_EMUX_EM3_TIMER;
+    HWREG(ADC0_SSCTL3) = ADC_SSCTL_TS0 | ADC_SSCTL_IE0 | ADC_SSCTL_END0;
+    HWREG(ADC0_ACTSS) |= ADC_SS3_ENABLE | ADC_SS3_DMA;
+
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_ADC3, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(UDMA_CHANNEL_ADC3 | UDMA_PRI_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+    uDMAChannelControlSet(UDMA_CHANNEL_ADC3 | UDMA_ALT_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+    armAdcHalf(0U);
+    armAdcHalf(1U);
+    uDMAChannelEnable(UDMA_CHANNEL_ADC3);
+
+    HWREG(ADC0_ISC) = ADC_SS3_DMA;
+    HWREG(ADC0_IM) |= ADC_SS3_DMA;
+    IntPrioritySet(INT_ADC3, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_ADC3);
+
+    TimerConfigure(TIMER3_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(TIMER3_BASE, TIMER_A, (g_systemClockHz / sampleHz) - 1UL);
+    TimerControlTrigger(TIMER3_BASE, TIMER_A, true);
+    g_adcSampleHz = sampleHz;
+    TimerEnable(TIMER3_BASE, TIMER_A);
+}
+
+/*
+ * Description : Takes the oldest full half. The halves fill in turn, so
+ *               only the one due next is looked at.
+ */
+bool takeAdcHalf(uint32_t *half, uint32_t *stampCycles)
+{
+    bool taken = false;
+
+    taskENTER_CRITICAL();
+    if ((g_adcReady & (1UL << g_adcNextHalf)) != 0U)
+    {
+        *half = g_adcNextHalf;
+        *stampCycles = g_adcStamps[g_adcNextHalf];
+        g_adcReady &= ~(1UL << g_adcNextHalf);
+        g_adcNextHalf ^= 1U;
+        taken = true;
+    }
+    taskEXIT_CRITICAL();
+
+    return taken;
+}
+
+/*
+ * Description : Returns the halves refilled before the task took them.
+ */
+uint32_t getAdcOverruns(void)
+{
+    return g_adcOverruns;
+}
+
+/*
+ * Description : ADC0 sequencer 3 interrupt handler, raised when a uDMA
+ *               half completes. The finished control structure has gone
+ *               back to the stop mode; it is re-armed at once, as the
+ *               other half is already filling, and its half is stamped
+ *               and handed to the task. A half the task has not taken
+ *               yet is being overwritten, which counts as an overrun.
+ */
+void ADC0SS3IntHandler(void)
+{
+    uint32_t stamp = cycleCounterGet();
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    bool filled = false;
+
+    HWREG(ADC0_ISC) = ADC_SS3_DMA;
+
+    for (uint32_t half = 0U; half < 2U; half++)
+    {
+        uint32_t select = (half == 0U) ? UDMA_PRI_SELECT : UDMA_ALT_SELECT;
+
+        if (uDMAChannelModeGet(UDMA_CHANNEL_ADC3 | select) == UDMA_MODE_STOP)
+        {
+            armAdcHalf(half);
+
+            if ((g_adcReady & (1UL << half)) != 0U)
+            {
+                g_adcOverruns++;
+            }
+            g_adcReady |= (1UL << half);
+            g_adcStamps[half] = stamp;
+            filled = true;
+        }
+    }
+
+    /* Both halves completed before the handler ran: the channel stopped */
+    if (!uDMAChannelIsEnabled(UDMA_CHANNEL_ADC3))
+    {
+        uDMAChannelEnable(UDMA_CHANNEL_ADC3);
+    }
+
+    if (filled && (g_adcNotifyTask != NULL))
+    {
+        vTaskNotifyGiveFromISR(g_adcNotifyTask, &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*
+ * Description : Configures Timer 1A as a full-width periodic timer
+ *               clocked from the system clock. The interrupt sits at the
+ *               highest priority the kernel masks, so its lateness shows
+ *               how long critical sections keep interrupts off.
+ */
+void initLatencyTimer(uint32_t periodCycles, LatencyTimerHook_t hook)
+{
+    g_latencyLoad = periodCycles - 1U;
+    g_latencyHook = hook;
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER1));
+
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(TIMER1_BASE, TIMER_A, g_latencyLoad);
+    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+
+    IntPrioritySet(INT_TIMER1A, configMAX_SYSCALL_INTERRUPT_PRIORITY);
+    IntEnable(INT_TIMER1A);
+    TimerEnable(TIMER1_BASE, TIMER_A);
+}
+
+/*
+ * Description : Timer 1A interrupt handler. The timer reloads and
+ *               counts down from the load value at the timeout that
+ *               raised this interrupt, so the distance the counter has
+ *               moved since is the cycles from trigger to handler. The
+ *               counter is read first, before anything else adds to it.
+ */
+void LatencyTimerIntHandler(void)
+{
+    uint32_t late = g_latencyLoad - TimerValueGet(TIMER1_BASE, TIMER_A);
+
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+
+    if (g_latencyHook != NULL)
+    {
+        g_latencyHook(late);
+    }
+}
+
+/*
+ * Description : Configures Timer 2A as a full-width periodic timer
+ *               counting up from 0 at the system clock. Its only
+ *               interrupt is the wrap, every 2^32 cycles (54 s at
+ *               80 MHz), at the kernel priority.
+ */
+void initRunTimeTimer(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER2);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER2));
+
+    TimerConfigure(TIMER2_BASE, TIMER_CFG_PERIODIC_UP);
+    TimerLoadSet(TIMER2_BASE, TIMER_A, 0xFFFFFFFFU);
+    TimerIntEnable(TIMER2_BASE, TIMER_TIMA_TIMEOUT);
+
+    IntPrioritySet(INT_TIMER2A, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_TIMER2A);
+    TimerEnable(TIMER2_BASE, TIMER_A);
+}
+
+/*
+ * Description : Reads the run-time counter. The kernel calls this from
+ *               the context switch, where the wrap interrupt cannot run,
+ *               so a wrap it has not counted yet is taken from the raw
+ *               timeout flag. The low half is read again after a wrap
+ *               is seen, as the first read may predate it.
+ */
+uint64_t getRunTimeCounter(void)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    uint32_t high = g_runTimeWraps;
+    uint32_t low = TimerValueGet(TIMER2_BASE, TIMER_A);
+
+    if ((TimerIntStatus(TIMER2_BASE, false) & TIMER_TIMA_TIMEOUT) != 0U)
+    {
+        low = TimerValueGet(TIMER2_BASE, TIMER_A);
+        high++;
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return ((uint64_t)high << 32) | low;
+}
+
+/*
+ * Description : Timer 2A interrupt handler. Counts one wrap of the
+ *               run-time counter.
+ */
+void RunTimeTimerIntHandler(void)
+{
+    TimerIntClear(TIMER2_BASE, TIMER_TIMA_TIMEOUT);
+    g_runTimeWraps++;
+}
+
+/*
+ * Description : Starts watchdog timer 0 in reset mode. The counter
+ *               raises its interrupt at the first timeout and resets the
+ *               device at the second, so it is loaded with half the
+ *               timeout. The interrupt is left disabled in the NVIC: the
+ *               first timeout only re-arms the counter. With
+ *               FLIGHT_RECORDER_ENABLED it is enabled above the kernel
+ *               mask instead, so the flight recorder is sealed half a
+ *               timeout before the reset. The counter stops while the
+ *               debugger halts the core.
+ */
+void initWatchdog(uint32_t timeoutMs)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_WDOG0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_WDOG0));
+
+    if (WatchdogLockState(WATCHDOG0_BASE))
+    {
+        WatchdogUnlock(WATCHDOG0_BASE);
+    }
+
+    WatchdogReloadSet(WATCHDOG0_BASE,
+                      (uint32_t)(((uint64_t)configCPU_CLOCK_HZ * timeoutMs) / 2000U));
+    WatchdogStallEnable(WATCHDOG0_BASE);
+    WatchdogResetEnable(WATCHDOG0_BASE);
+    WatchdogEnable(WATCHDOG0_BASE);
+
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    IntPrioritySet(INT_WATCHDOG, 0x00);
+    IntEnable(INT_WATCHDOG);
+#endif
+}
+
+/*
+ * Description : Watchdog interrupt handler, at the first timeout. Seals
+ *               the flight recorder and masks itself without clearing the
+ *               timeout, so the second one still resets the device. Runs
+ *               above the kernel mask and makes no kernel call.
+ */
+void WatchdogIntHandler(void)
+{
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    flightRecorderSeal(FLIGHT_RECORDER_CAUSE_WATCHDOG);
+#endif
+    IntDisable(INT_WATCHDOG);
+}
+
+/*
+ * Description : Feeds the watchdog. Clearing the timeout interrupt
+ *               reloads the counter. The timer is left unlocked, as the
+ *               lock would also cover the clear register.
+ */
+void feedWatchdog(void)
+{
+    WatchdogIntClear(WATCHDOG0_BASE);
+
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    /* A late feed after the first timeout: no reset follows */
+    flightRecorderResume();
+    IntEnable(INT_WATCHDOG);
+#endif
+}
+
+/*
+ * Description : Reads and clears the reset cause register.
+ */
+bool takeWatchdogReset(void)
+{
+    uint32_t cause = SysCtlResetCauseGet();
+
+    SysCtlResetCauseClear(cause);
+    return ((cause & SYSCTL_CAUSE_WDOG0) != 0U);
+}
+
+#if (configUSE_IDLE_HOOK == 1)
+#if (IDLE_DEEP_SLEEP_ENABLED == 1U)
+/*
+ * Description : True once every log byte is out of the UART, which stops
+ *               keeping its bit rate when the clock drops in deep sleep.
+ */
+static bool logOutputDrained(void)
+{
+#if (LOG_TX_DMA_ENABLED == 1U)
+    bool queued = g_dmaTxBusy || (g_dmaFillLength != 0U);
+#else
+    bool queued = (g_txHead != g_txTail);
+#endif
+
+#if (LOG_TX_ASYNC_ENABLED == 1U)
+    queued = queued || (g_asyncData != NULL);
+#endif
+
+#if LOG_SINK_USED(LOG_SINK_UART1)
+    /* The UART1 sink loses its bit rate in deep sleep too */
+    if ((g_uart1TxHead != g_uart1TxTail) || UARTBusy(UART1_BASE))
+    {
+        return false;
+    }
+#endif
+
+    return !queued && !UARTBusy(UART0_BASE);
 }
+#endif
+
+/*
+ * Description : FreeRTOS idle hook. Sleeps the core until the next
+ *               interrupt, at the latest the next tick. PRIMASK is set
+ *               across the sleep: a pending interrupt still ends the WFI
+ *               but is only taken once the sleep has been measured. The
+ *               DWT counter stops while the core sleeps, SysTick does
+ *               not, so the time asleep is read from SysTick (one wrap at
+ *               most, as the wrap ends the sleep), added back to the
+ *               cycle counter and recorded with the profiler.
+ */
+void vApplicationIdleHook(void)
+{
+#if (IDLE_DEEP_SLEEP_ENABLED == 1U)
+    bool deep = logOutputDrained();
+#endif
+
+    IntMasterDisable();
+
+    (void)HWREG(NVIC_ST_CTRL);    /* Clears the count flag */
+    uint32_t before = HWREG(NVIC_ST_CURRENT);
+
+#if (IDLE_DEEP_SLEEP_ENABLED == 1U)
+    if (deep)
+    {
+        SysCtlDeepSleep();
+    }
+    else
+    {
+        SysCtlSleep();
+    }
+#else
+    SysCtlSleep();
+#endif
+
+    uint32_t after = HWREG(NVIC_ST_CURRENT);
+    uint32_t slept = before - after;
+
+    if ((HWREG(NVIC_ST_CTRL) & NVIC_ST_CTRL_COUNT) != 0U)
+    {
+        slept += HWREG(NVIC_ST_RELOAD) + 1U;
+    }
+
+#if (IDLE_DEEP_SLEEP_ENABLED == 1U)
+    /* SysTick counted at the deep-sleep clock */
+    if (deep)
+    {
+        slept = (uint32_t)(((uint64_t)slept * configCPU_CLOCK_HZ) / IDLE_DEEP_SLEEP_CLOCK_HZ);
+    }
+#endif
+
+    cycleCounterAdvance(slept);
+    tickProfilerIdleSlept(slept);
+
+    IntMasterEnable();
+}
+#endif
+
+#endif /* MLFQ_BOARD */
 
 /******************************************************************************
  *  END OF FILE
@@ -0,0 +1,870 @@
+/******************************************************************************
+ *  MODULE NAME  : Cortex-M7 Driver Layer
+ *  FILE         : drivers_cm7.c
+ *  DESCRIPTION  : drivers.h for MLFQ_BOARD_CORTEX_M7, a NUCLEO-F767ZI
+ *                 (STM32F767, Cortex-M7 with 16 KB I- and D-caches).
+ *                 Logging and console on USART3 (the ST-LINK virtual COM
+ *                 port), the level LEDs LD1..LD3, the quantum and
+ *                 run-time timers on TIM2 and TIM5, and the independent
+ *                 watchdog, all at register level so no vendor library
+ *                 is needed. The board's startup file points the USART3,
+ *                 TIM2 and TIM5 vectors at UART0IntHandler(),
+ *                 QuantumTimerIntHandler() and RunTimeTimerIntHandler().
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "drivers.h"
+#include "irq_stats.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+#include "gpio_probe.h"
+#include "flight_recorder.h"
+#include "flash_log.h"
+#include "param_store.h"
+#include "can_telemetry.h"
+#include <string.h>
+
+#if (MLFQ_BOARD == MLFQ_BOARD_CORTEX_M7)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+#if (LOG_TX_DMA_ENABLED == 1U) || (LOG_TX_ASYNC_ENABLED == 1U)
+#error "The Cortex-M7 backend sends the log from the USART3 interrupt only"
+#endif
+
+#if (LOG_ITM_ENABLED == 1U) || LOG_SINK_USED(LOG_SINK_UART1) || LOG_SINK_USED(LOG_SINK_RAM)
+#error "The Cortex-M7 backend has the LOG_SINK_UART0 sink (USART3) only"
+#endif
+
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_BLOCK)
+#error "The Cortex-M7 backend supports LOG_OVERFLOW_DROP_NEW and LOG_OVERFLOW_DROP_OLD"
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U) || (IDLE_DEEP_SLEEP_ENABLED == 1U)
+#error "Clock scaling and deep sleep are implemented for the TM4C123 only"
+#endif
+
+#if (GPIO_PROBE_ENABLED == 1U) || (FLASH_LOG_ENABLED == 1U) || (PARAM_STORE_ENABLED == 1U) || \
+    (CAN_TELEMETRY_ENABLED == 1U) || (FLIGHT_RECORDER_ENABLED == 1U)
+#error "GPIO probes, flash log, parameter store, CAN telemetry and flight recorder need TM4C123 peripherals"
+#endif
+
+/* Timers count at twice APB1; cycles per timer count must be whole */
+#define CM7_TIMER_CLOCK_HZ      (2UL * CM7_APB1_CLOCK_HZ)
+#define CM7_CYCLES_PER_COUNT    (CM7_CPU_CLOCK_HZ / CM7_TIMER_CLOCK_HZ)
+
+#if ((CM7_CPU_CLOCK_HZ % CM7_TIMER_CLOCK_HZ) != 0UL)
+#error "CM7_CPU_CLOCK_HZ must be a multiple of twice CM7_APB1_CLOCK_HZ"
+#endif
+
+/* Bit rate of the USART3 log output */
+#define LOG_UART_BAUD           115200U
+
+#define CM7_REG(address)        (*((volatile uint32_t *)(address)))
+
+/* Core registers (ARMv7-M architecture) */
+#define SCB_CCR                 0xE000ED14UL    /* Configuration and control */
+#define SCB_CCR_IC              (1UL << 17)
+#define SCB_CCR_DC              (1UL << 16)
+#define SCB_CCSIDR              0xE000ED80UL    /* Cache size of the level in CSSELR */
+#define SCB_CSSELR              0xE000ED84UL
+#define SCB_ICIALLU             0xE000EF50UL    /* I-cache invalidate all */
+#define SCB_DCISW               0xE000EF60UL    /* D-cache invalidate by set/way */
+
+#define NVIC_ISER               0xE000E100UL    /* Set-enable, one bit per IRQ */
+#define NVIC_ICER               0xE000E180UL    /* Clear-enable, one bit per IRQ */
+#define NVIC_IPR                0xE000E400UL    /* Priority, one byte per IRQ */
+
+#define SYSTICK_CTRL            0xE000E010UL
+#define SYSTICK_LOAD            0xE000E014UL
+#define SYSTICK_VAL             0xE000E018UL
+#define SYSTICK_CTRL_COUNTFLAG  (1UL << 16)
+
+#define DBGMCU_APB1_FZ          0xE0042008UL
+#define DBGMCU_IWDG_STOP        (1UL << 12)     /* Watchdog stops while halted */
+
+/* STM32F767 peripherals */
+#define RCC_AHB1ENR             0x40023830UL
+#define RCC_AHB1ENR_GPIOB       (1UL << 1)
+#define RCC_AHB1ENR_GPIOD       (1UL << 3)
+#define RCC_APB1ENR             0x40023840UL
+#define RCC_APB1ENR_TIM2        (1UL << 0)
+#define RCC_APB1ENR_TIM5        (1UL << 3)
+#define RCC_APB1ENR_USART3      (1UL << 18)
+#define RCC_CSR                 0x40023874UL    /* Reset causes */
+#define RCC_CSR_RMVF            (1UL << 24)
+#define RCC_CSR_IWDGRSTF        (1UL << 29)
+
+#define GPIOB_BASE              0x40020400UL
+#define GPIOD_BASE              0x40020C00UL
+#define GPIO_MODER              0x00UL
+#define GPIO_AFRH               0x24UL
+#define GPIO_BSRR               0x18UL
+
+#define USART3_BASE             0x40004800UL
+#define USART_CR1               (USART3_BASE + 0x00UL)
+#define USART_BRR               (USART3_BASE + 0x0CUL)
+#define USART_ISR               (USART3_BASE + 0x1CUL)
+#define USART_ICR               (USART3_BASE + 0x20UL)
+#define USART_RDR               (USART3_BASE + 0x24UL)
+#define USART_TDR               (USART3_BASE + 0x28UL)
+#define USART_CR1_UE            (1UL << 0)
+#define USART_CR1_RE            (1UL << 2)
+#define USART_CR1_TE            (1UL << 3)
+#define USART_CR1_RXNEIE        (1UL << 5)
+#define USART_CR1_TXEIE         (1UL << 7)
+#define USART_ISR_ORE           (1UL << 3)
+#define USART_ISR_RXNE          (1UL << 5)
+#define USART_ISR_TXE           (1UL << 7)
+#define USART_ICR_ORECF         (1UL << 3)
+
+#define TIM2_BASE               0x40000000UL    /* 32-bit, quantum timer */
+#define TIM5_BASE               0x40000C00UL    /* 32-bit, run-time counter */
+#define TIM_CR1                 0x00UL
+#define TIM_DIER                0x0CUL
+#define TIM_SR                  0x10UL
+#define TIM_EGR                 0x14UL
+#define TIM_CNT                 0x24UL
+#define TIM_PSC                 0x28UL
+#define TIM_ARR                 0x2CUL
+#define TIM_CR1_CEN             (1UL << 0)
+#define TIM_CR1_URS             (1UL << 2)      /* Only overflow raises UIF */
+#define TIM_CR1_OPM             (1UL << 3)      /* Stops at the update */
+#define TIM_DIER_UIE            (1UL << 0)
+#define TIM_SR_UIF              (1U << 0)
+#define TIM_EGR_UG              (1UL << 0)
+
+#define IWDG_KR                 0x40003000UL
+#define IWDG_PR                 0x40003004UL
+#define IWDG_RLR                0x40003008UL
+#define IWDG_SR                 0x4000300CUL
+#define IWDG_KEY_START          0xCCCCUL
+#define IWDG_KEY_ACCESS         0x5555UL
+#define IWDG_KEY_RELOAD         0xAAAAUL
+#define IWDG_LSI_HZ             32000UL
+#define IWDG_RELOAD_MAX         0xFFFUL
+
+/* Interrupt numbers */
+#define IRQ_TIM2                28U
+#define IRQ_USART3              39U
+#define IRQ_TIM5                50U
+
+/* Log pins: PD8 = USART3 TX, PD9 = RX, alternate function 7 */
+#define LOG_PIN_TX              8U
+#define LOG_PIN_RX              9U
+#define LOG_PIN_AF              7UL
+
+/* LED pins on Port B: LD1 green, LD2 blue, LD3 red */
+#define LED_PIN_GREEN           (1UL << 0)
+#define LED_PIN_BLUE            (1UL << 7)
+#define LED_PIN_RED             (1UL << 14)
+#define LED_PINS                (LED_PIN_GREEN | LED_PIN_BLUE | LED_PIN_RED)
+
+/* BSRR word lighting 'pins' and clearing the other LEDs in one store */
+#define LED_BSRR_WORD(pins)     ((pins) | ((LED_PINS & ~(pins)) << 16))
+
+#define CM7_DSB()               __asm(" dsb")
+#define CM7_ISB()               __asm(" isb")
+
+/******************************************************************************
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+/* Core clock in Hz behind configCPU_CLOCK_HZ; HSI until initClock() runs */
+unsigned long g_systemClockHz = 16000000UL;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* USART3 transmit ring buffer; indices run freely and are masked on access */
+static uint8_t g_txBuffer[LOG_TX_BUFFER_SIZE];
+static volatile uint32_t g_txHead = 0U;    /* Next byte written by sendLog */
+static volatile uint32_t g_txTail = 0U;    /* Next byte sent by the ISR */
+
+/* Bytes discarded because the buffer was full, per LOG_SINK_* */
+static volatile uint32_t g_sinkDroppedBytes[LOG_SINK_COUNT];
+
+/* Bytes accepted by sendLogChannel() since reset */
+static volatile uint32_t g_txQueuedBytes = 0U;
+
+/* USART3 receive ring buffer, filled by the ISR and drained by one task */
+static uint8_t g_rxBuffer[LOG_RX_BUFFER_SIZE];
+static volatile uint32_t g_rxHead = 0U;
+static volatile uint32_t g_rxTail = 0U;
+static volatile uint32_t g_rxDroppedBytes = 0U;
+static TaskHandle_t g_rxNotifyTask = NULL;
+
+#if (MLFQ_LED_ENABLED == 1U)
+/* BSRR word for each FreeRTOS priority: the colour of the MLFQ level at
+ * that priority, dark for priorities outside the levels */
+static uint32_t g_ledByPriority[configMAX_PRIORITIES];
+#endif
+
+/* Run-time stats counter: wraps of the 32-bit TIM5 counted so far */
+static volatile uint32_t g_runTimeWraps = 0U;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Enables an interrupt at the kernel priority, so its
+ *               handler may use FromISR APIs.
+ */
+static void enableKernelIrq(uint32_t irq)
+{
+    *((volatile uint8_t *)(NVIC_IPR + irq)) = (uint8_t)configKERNEL_INTERRUPT_PRIORITY;
+    CM7_REG(NVIC_ISER + ((irq / 32U) * 4U)) = 1UL << (irq % 32U);
+}
+
+/*
+ * Description : Invalidates and enables both L1 caches, as the reset
+ *               state of their contents is undefined. The D-cache is
+ *               invalidated by set and way over its geometry in CCSIDR.
+ *               No driver here uses DMA, so no cache maintenance is
+ *               needed afterwards.
+ */
+static void enableCaches(void)
+{
+    CM7_DSB();
+    CM7_ISB();
+    CM7_REG(SCB_ICIALLU) = 0U;
+    CM7_DSB();
+    CM7_ISB();
+    CM7_REG(SCB_CCR) |= SCB_CCR_IC;
+    CM7_DSB();
+    CM7_ISB();
+
+    CM7_REG(SCB_CSSELR) = 0U;          /* Level 1 data cache */
+    CM7_DSB();
+
+    uint32_t ccsidr = CM7_REG(SCB_CCSIDR);
+    uint32_t sets = (ccsidr >> 13) & 0x7FFFU;
+
+    do
+    {
+        uint32_t ways = (ccsidr >> 3) & 0x3FFU;
+
+        do
+        {
+            CM7_REG(SCB_DCISW) = ((sets << 5) & 0x3FE0U) | (ways << 30);
+        } while (ways-- != 0U);
+    } while (sets-- != 0U);
+
+    CM7_DSB();
+    CM7_REG(SCB_CCR) |= SCB_CCR_DC;
+    CM7_DSB();
+    CM7_ISB();
+}
+
+/*
+ * Description : Moves queued bytes to the transmitter while it has room
+ *               and keeps the TX interrupt on while bytes remain. Must
+ *               run with the USART interrupt masked (critical section or
+ *               the ISR).
+ */
+static void kickTransmit(void)
+{
+    while (((CM7_REG(USART_ISR) & USART_ISR_TXE) != 0U) && (g_txTail != g_txHead))
+    {
+        CM7_REG(USART_TDR) = g_txBuffer[g_txTail & (LOG_TX_BUFFER_SIZE - 1U)];
+        g_txTail++;
+    }
+
+    if (g_txTail != g_txHead)
+    {
+        CM7_REG(USART_CR1) |= USART_CR1_TXEIE;
+    }
+    else
+    {
+        CM7_REG(USART_CR1) &= ~USART_CR1_TXEIE;
+    }
+}
+
+/*
+ * Description : Copies as many bytes as fit into the ring buffer.
+ *               Under LOG_OVERFLOW_DROP_OLD the oldest queued bytes
+ *               are overwritten instead. Returns the bytes accepted.
+ *               Must run with the USART interrupt masked.
+ */
+static uint32_t enqueueBytes(const uint8_t *data, uint32_t length)
+{
+    uint32_t count = 0U;
+
+    while (count < length)
+    {
+        if ((g_txHead - g_txTail) >= LOG_TX_BUFFER_SIZE)
+        {
+#if (LOG_TX_OVERFLOW_POLICY == LOG_OVERFLOW_DROP_OLD)
+            g_txTail++;
+            g_sinkDroppedBytes[LOG_SINK_UART0]++;
+#else
+            break;
+#endif
+        }
+
+        g_txBuffer[g_txHead & (LOG_TX_BUFFER_SIZE - 1U)] = data[count];
+        g_txHead++;
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Description : Returns the LED pins of a queue level; every level
+ *               between High and Low shares the Medium colour, as on
+ *               the LaunchPad.
+ */
+static uint32_t ledPinsForLevel(MLFQ_QueueLevel_t queueLevel)
+{
+    if (queueLevel == MLFQ_QUEUE_HIGH)
+    {
+        return LED_PIN_GREEN;
+    }
+    if (queueLevel == MLFQ_QUEUE_LOW)
+    {
+        return LED_PIN_RED;
+    }
+    if ((uint32_t)queueLevel < MLFQ_NUM_LEVELS)
+    {
+        return LED_PIN_BLUE;
+    }
+
+    return 0U;
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : The board's SystemInit() has set the PLL, the flash wait
+ *               states and the bus dividers before main(). Records the
+ *               resulting clock and turns the caches on, which the
+ *               scheduler's cycle budgets assume: code and data run from
+ *               flash and SRAM1 at full speed only through them.
+ */
+void initClock(void)
+{
+    g_systemClockHz = CM7_CPU_CLOCK_HZ;
+
+    enableCaches();
+}
+
+/*
+ * Description : The clock stays at CM7_CPU_CLOCK_HZ (clock scaling is
+ *               rejected at build time on this board).
+ */
+uint32_t setClockSlow(bool slow)
+{
+    (void)slow;
+    return (uint32_t)g_systemClockHz;
+}
+
+/*
+ * Description : Initializes USART3 on PD8/PD9 at 115200 baud, 8N1, with
+ *               the receive interrupt on so the console gets every byte.
+ */
+void initUART(void)
+{
+    CM7_REG(RCC_AHB1ENR) |= RCC_AHB1ENR_GPIOD;
+    CM7_REG(RCC_APB1ENR) |= RCC_APB1ENR_USART3;
+    (void)CM7_REG(RCC_APB1ENR);        /* Clock on before the first access */
+
+    /* PD8 and PD9 to alternate function 7 */
+    CM7_REG(GPIOD_BASE + GPIO_MODER) =
+        (CM7_REG(GPIOD_BASE + GPIO_MODER) & ~((3UL << (LOG_PIN_TX * 2U)) | (3UL << (LOG_PIN_RX * 2U)))) |
+        (2UL << (LOG_PIN_TX * 2U)) | (2UL << (LOG_PIN_RX * 2U));
+    CM7_REG(GPIOD_BASE + GPIO_AFRH) =
+        (CM7_REG(GPIOD_BASE + GPIO_AFRH) & ~((0xFUL << ((LOG_PIN_TX - 8U) * 4U)) | (0xFUL << ((LOG_PIN_RX - 8U) * 4U)))) |
+        (LOG_PIN_AF << ((LOG_PIN_TX - 8U) * 4U)) | (LOG_PIN_AF << ((LOG_PIN_RX - 8U) * 4U));
+
+    /* 16x oversampling: the divider is the clock over the bit rate */
+    CM7_REG(USART_BRR) = (CM7_APB1_CLOCK_HZ + (LOG_UART_BAUD / 2U)) / LOG_UART_BAUD;
+    CM7_REG(USART_CR1) = USART_CR1_TE | USART_CR1_RE | USART_CR1_RXNEIE | USART_CR1_UE;
+
+    enableKernelIrq(IRQ_USART3);
+}
+
+/*
+ * Description : Initializes the LED pins on Port B as outputs, all off.
+ */
+void initGPIO(void)
+{
+    CM7_REG(RCC_AHB1ENR) |= RCC_AHB1ENR_GPIOB;
+    (void)CM7_REG(RCC_AHB1ENR);
+
+    CM7_REG(GPIOB_BASE + GPIO_BSRR) = LED_BSRR_WORD(0U);
+    CM7_REG(GPIOB_BASE + GPIO_MODER) =
+        (CM7_REG(GPIOB_BASE + GPIO_MODER) & ~((3UL << 0) | (3UL << 14) | (3UL << 28))) |
+        (1UL << 0) | (1UL << 14) | (1UL << 28);
+
+#if (MLFQ_LED_ENABLED == 1U)
+    for (uint32_t priority = 0U; priority < configMAX_PRIORITIES; priority++)
+    {
+        g_ledByPriority[priority] = LED_BSRR_WORD(0U);
+    }
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        g_ledByPriority[MLFQ_TO_RTOS_LEVEL_SETTER(level)] =
+            LED_BSRR_WORD(ledPinsForLevel((MLFQ_QueueLevel_t)level));
+    }
+#if (MLFQ_RESERVE_ENABLED == 1U)
+    g_ledByPriority[MLFQ_RESERVE_PRIORITY] = LED_BSRR_WORD(ledPinsForLevel(MLFQ_QUEUE_LOW));
+#endif
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    g_ledByPriority[MLFQ_WEIGHT_PARK_PRIORITY] = LED_BSRR_WORD(ledPinsForLevel(MLFQ_QUEUE_LOW));
+#endif
+#endif
+}
+
+/*
+ * Description : Queues a block of bytes on the report channel.
+ */
+uint32_t sendLogBytes(const void *data, uint32_t length)
+{
+    return sendLogChannel(LOG_CHANNEL_REPORT, data, length);
+}
+
+/*
+ * Description : Queues bytes for USART3 under LOG_TX_OVERFLOW_POLICY.
+ *               Every channel goes to USART3 on this board. Returns the
+ *               number of bytes queued.
+ */
+uint32_t sendLogChannel(uint32_t channel, const void *data, uint32_t length)
+{
+    uint32_t queued;
+
+    (void)channel;
+
+    if (data == 0)
+        return 0U;
+
+    taskENTER_CRITICAL();
+    {
+        queued = enqueueBytes((const uint8_t *)data, length);
+        kickTransmit();
+
+        g_sinkDroppedBytes[LOG_SINK_UART0] += length - queued;
+        g_txQueuedBytes += queued;
+    }
+    taskEXIT_CRITICAL();
+
+    return queued;
+}
+
+/*
+ * Description : Queues a null-terminated string for transmission.
+ */
+uint32_t sendLog(const char *message)
+{
+    if (message == 0)
+        return 0U;
+
+    return sendLogBytes(message, (uint32_t)strlen(message));
+}
+
+/*
+ * Description : Queues the buffer like sendLogBytes() and runs done at
+ *               once, as this board has no in-place send.
+ */
+bool sendLogAsync(const void *data, uint32_t length, LogAsyncDone_t done, void *context)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if ((data == 0) || (length == 0U))
+    {
+        return false;
+    }
+
+    (void)sendLogChannel(LOG_CHANNEL_REPORT, data, length);
+
+    if (done != NULL)
+    {
+        done(context, &xHigherPriorityTaskWoken);
+    }
+
+    if ((xHigherPriorityTaskWoken != pdFALSE) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+    {
+        taskYIELD();
+    }
+
+    return true;
+}
+
+/*
+ * Description : Returns the free space in the transmit buffer.
+ */
+uint32_t getLogTxFree(void)
+{
+    return LOG_TX_BUFFER_SIZE - (g_txHead - g_txTail);
+}
+
+/*
+ * Description : Every channel shares the USART3 buffer.
+ */
+uint32_t getLogChannelFree(uint32_t channel)
+{
+    (void)channel;
+    return getLogTxFree();
+}
+
+/*
+ * Description : Returns the total number of log bytes dropped.
+ */
+uint32_t getLogDroppedBytes(void)
+{
+    return g_sinkDroppedBytes[LOG_SINK_UART0];
+}
+
+/*
+ * Description : Returns the log bytes dropped by one LOG_SINK_*.
+ */
+uint32_t getLogSinkDroppedBytes(uint32_t sink)
+{
+    return (sink < LOG_SINK_COUNT) ? g_sinkDroppedBytes[sink] : 0U;
+}
+
+/*
+ * Description : Returns the log bytes accepted since reset (wraps).
+ */
+uint32_t getLogQueuedBytes(void)
+{
+    return g_txQueuedBytes;
+}
+
+/*
+ * Description : USART3 interrupt handler. Takes a received byte (an
+ *               overrun is cleared and counted as one lost byte) and
+ *               refills the transmitter from the ring buffer.
+ */
+void UART0IntHandler(void)
+{
+    IRQ_STATS_ENTER();
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t status = CM7_REG(USART_ISR);
+
+    if ((status & USART_ISR_ORE) != 0U)
+    {
+        CM7_REG(USART_ICR) = USART_ICR_ORECF;
+        g_rxDroppedBytes++;
+    }
+
+    if ((status & USART_ISR_RXNE) != 0U)
+    {
+        uint8_t byte = (uint8_t)CM7_REG(USART_RDR);
+
+        if ((g_rxHead - g_rxTail) < LOG_RX_BUFFER_SIZE)
+        {
+            g_rxBuffer[g_rxHead & (LOG_RX_BUFFER_SIZE - 1U)] = byte;
+            g_rxHead++;
+        }
+        else
+        {
+            g_rxDroppedBytes++;
+        }
+
+        if (g_rxNotifyTask != NULL)
+        {
+            vTaskNotifyGiveFromISR(g_rxNotifyTask, &xHigherPriorityTaskWoken);
+        }
+    }
+
+    if ((status & USART_ISR_TXE) != 0U)
+    {
+        kickTransmit();
+    }
+
+    IRQ_STATS_EXIT(IRQ_STATS_SOURCE_UART0);
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*
+ * Description : Copies received bytes out of the receive ring buffer.
+ *               Single consumer: only one task may call it.
+ */
+uint32_t receiveBytes(uint8_t *buffer, uint32_t maxLength)
+{
+    uint32_t count = 0U;
+
+    while ((count < maxLength) && (g_rxTail != g_rxHead))
+    {
+        buffer[count] = g_rxBuffer[g_rxTail & (LOG_RX_BUFFER_SIZE - 1U)];
+        g_rxTail++;
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Description : Sets the task the USART3 ISR notifies on received bytes.
+ */
+void setRxNotifyTask(TaskHandle_t task)
+{
+    g_rxNotifyTask = task;
+}
+
+/*
+ * Description : Returns the number of received bytes lost.
+ */
+uint32_t getRxDroppedBytes(void)
+{
+    return g_rxDroppedBytes;
+}
+
+/*
+ * Description : Sets LED color based on MLFQ queue level, with the
+ *               LaunchPad's colours: High green, Medium blue, Low red.
+ */
+void setLEDColor(MLFQ_QueueLevel_t queueLevel)
+{
+    CM7_REG(GPIOB_BASE + GPIO_BSRR) = LED_BSRR_WORD(ledPinsForLevel(queueLevel));
+}
+
+#if (MLFQ_LED_ENABLED == 1U)
+/*
+ * Description : traceTASK_SWITCHED_IN hook. One table load and one BSRR
+ *               store, which sets and clears the pins without a
+ *               read-modify-write of the port.
+ */
+void ledTaskSwitchedIn(uint32_t priority)
+{
+    CM7_REG(GPIOB_BASE + GPIO_BSRR) = g_ledByPriority[priority];
+}
+#endif
+
+/*
+ * Description : Disables an interrupt at the NVIC. The barriers make sure
+ *               it cannot be taken once this returns.
+ */
+void maskIrq(uint32_t irq)
+{
+    CM7_REG(NVIC_ICER + ((irq / 32U) * 4U)) = 1UL << (irq % 32U);
+    CM7_DSB();
+    CM7_ISB();
+}
+
+/*
+ * Description : Enables an interrupt at the NVIC.
+ */
+void unmaskIrq(uint32_t irq)
+{
+    CM7_REG(NVIC_ISER + ((irq / 32U) * 4U)) = 1UL << (irq % 32U);
+}
+
+/*
+ * Description : Configures TIM2 as a one-pulse up-counter at the timer
+ *               clock, stopped until armed, interrupting on its update.
+ */
+void initQuantumTimer(void)
+{
+    CM7_REG(RCC_APB1ENR) |= RCC_APB1ENR_TIM2;
+    (void)CM7_REG(RCC_APB1ENR);
+
+    CM7_REG(TIM2_BASE + TIM_CR1) = TIM_CR1_URS | TIM_CR1_OPM;
+    CM7_REG(TIM2_BASE + TIM_PSC) = 0U;
+    CM7_REG(TIM2_BASE + TIM_EGR) = TIM_EGR_UG;   /* Loads the prescaler */
+    CM7_REG(TIM2_BASE + TIM_SR) = 0U;
+    CM7_REG(TIM2_BASE + TIM_DIER) = TIM_DIER_UIE;
+
+    enableKernelIrq(IRQ_TIM2);
+}
+
+/*
+ * Description : Restarts the quantum timer so it expires after the given
+ *               number of core cycles, rounded down to timer counts.
+ */
+void armQuantumTimer(uint32_t cycles)
+{
+    uint32_t counts = cycles / CM7_CYCLES_PER_COUNT;
+
+    CM7_REG(TIM2_BASE + TIM_CR1) = TIM_CR1_URS | TIM_CR1_OPM;
+    CM7_REG(TIM2_BASE + TIM_CNT) = 0U;
+    CM7_REG(TIM2_BASE + TIM_ARR) = (counts > 0U) ? counts : 1U;
+    CM7_REG(TIM2_BASE + TIM_SR) = 0U;
+    CM7_REG(TIM2_BASE + TIM_CR1) = TIM_CR1_URS | TIM_CR1_OPM | TIM_CR1_CEN;
+}
+
+/*
+ * Description : Stops the quantum timer.
+ */
+void disarmQuantumTimer(void)
+{
+    CM7_REG(TIM2_BASE + TIM_CR1) = TIM_CR1_URS | TIM_CR1_OPM;
+}
+
+/*
+ * Description : TIM2 interrupt handler. Acknowledges the update and
+ *               hands over to the profiler's quantum enforcement path.
+ *               The flag is cleared first and read back: on the
+ *               Cortex-M7 the write could still be in flight at the
+ *               exception return and the interrupt taken again.
+ */
+void QuantumTimerIntHandler(void)
+{
+    IRQ_STATS_ENTER();
+
+    CM7_REG(TIM2_BASE + TIM_SR) = ~TIM_SR_UIF;
+    (void)CM7_REG(TIM2_BASE + TIM_SR);
+    tickProfilerQuantumTimerExpired();
+
+    IRQ_STATS_EXIT(IRQ_STATS_SOURCE_QUANTUM);
+}
+
+/*
+ * Description : Starts TIM5 as a free-running 32-bit up-counter at the
+ *               timer clock. Its only interrupt is the wrap, every 2^32
+ *               counts (39.8 s at 108 MHz).
+ */
+void initRunTimeTimer(void)
+{
+    CM7_REG(RCC_APB1ENR) |= RCC_APB1ENR_TIM5;
+    (void)CM7_REG(RCC_APB1ENR);
+
+    CM7_REG(TIM5_BASE + TIM_CR1) = TIM_CR1_URS;
+    CM7_REG(TIM5_BASE + TIM_PSC) = 0U;
+    CM7_REG(TIM5_BASE + TIM_ARR) = 0xFFFFFFFFU;
+    CM7_REG(TIM5_BASE + TIM_EGR) = TIM_EGR_UG;
+    CM7_REG(TIM5_BASE + TIM_SR) = 0U;
+    CM7_REG(TIM5_BASE + TIM_DIER) = TIM_DIER_UIE;
+
+    enableKernelIrq(IRQ_TIM5);
+    CM7_REG(TIM5_BASE + TIM_CR1) = TIM_CR1_URS | TIM_CR1_CEN;
+}
+
+/*
+ * Description : Reads the run-time counter in core cycles. As on the
+ *               TM4C123, a wrap the interrupt has not counted yet is
+ *               taken from the raw update flag, and the counter is read
+ *               again after one is seen.
+ */
+uint64_t getRunTimeCounter(void)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    uint32_t high = g_runTimeWraps;
+    uint32_t low = CM7_REG(TIM5_BASE + TIM_CNT);
+
+    if ((CM7_REG(TIM5_BASE + TIM_SR) & TIM_SR_UIF) != 0U)
+    {
+        low = CM7_REG(TIM5_BASE + TIM_CNT);
+        high++;
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+    return (((uint64_t)high << 32) | low) * CM7_CYCLES_PER_COUNT;
+}
+
+/*
+ * Description : TIM5 interrupt handler. Counts one wrap of the run-time
+ *               counter.
+ */
+void RunTimeTimerIntHandler(void)
+{
+    CM7_REG(TIM5_BASE + TIM_SR) = ~TIM_SR_UIF;
+    (void)CM7_REG(TIM5_BASE + TIM_SR);
+    g_runTimeWraps++;
+}
+
+/*
+ * Description : Starts the independent watchdog from the 32 kHz LSI with
+ *               the smallest prescaler whose reload covers timeoutMs
+ *               (about 32 s at most). It has no early interrupt, so the
+ *               first timeout resets the device. It stops while the
+ *               debugger halts the core, like the TM4C123 watchdog.
+ */
+void initWatchdog(uint32_t timeoutMs)
+{
+    uint32_t prescaler = 0U;
+    uint32_t counts = (uint32_t)(((uint64_t)timeoutMs * IWDG_LSI_HZ) / (4U * 1000U));
+
+    while ((counts > IWDG_RELOAD_MAX) && (prescaler < 6U))
+    {
+        prescaler++;
+        counts /= 2U;
+    }
+    if (counts > IWDG_RELOAD_MAX)
+    {
+        counts = IWDG_RELOAD_MAX;
+    }
+
+    CM7_REG(DBGMCU_APB1_FZ) |= DBGMCU_IWDG_STOP;
+
+    CM7_REG(IWDG_KR) = IWDG_KEY_START;
+    CM7_REG(IWDG_KR) = IWDG_KEY_ACCESS;
+    CM7_REG(IWDG_PR) = prescaler;
+    CM7_REG(IWDG_RLR) = counts;
+    while (CM7_REG(IWDG_SR) != 0U) {}
+    CM7_REG(IWDG_KR) = IWDG_KEY_RELOAD;
+}
+
+/*
+ * Description : Reloads the watchdog counter.
+ */
+void feedWatchdog(void)
+{
+    CM7_REG(IWDG_KR) = IWDG_KEY_RELOAD;
+}
+
+/*
+ * Description : Reads the watchdog reset flag and clears every reset
+ *               flag, so the next boot sees only its own.
+ */
+bool takeWatchdogReset(void)
+{
+    bool watchdog = ((CM7_REG(RCC_CSR) & RCC_CSR_IWDGRSTF) != 0U);
+
+    CM7_REG(RCC_CSR) |= RCC_CSR_RMVF;
+    return watchdog;
+}
+
+#if (configUSE_IDLE_HOOK == 1)
+/*
+ * Description : FreeRTOS idle hook. Sleeps the core until the next
+ *               interrupt, measuring the sleep on SysTick as drivers.c
+ *               does, since the DWT counter stops in WFI here too. The
+ *               DSB makes every buffered write complete before the core
+ *               sleeps.
+ */
+void vApplicationIdleHook(void)
+{
+    __asm(" cpsid i");
+
+    (void)CM7_REG(SYSTICK_CTRL);       /* Clears the count flag */
+    uint32_t before = CM7_REG(SYSTICK_VAL);
+
+    CM7_DSB();
+    __asm(" wfi");
+    CM7_ISB();
+
+    uint32_t after = CM7_REG(SYSTICK_VAL);
+    uint32_t slept = before - after;
+
+    if ((CM7_REG(SYSTICK_CTRL) & SYSTICK_CTRL_COUNTFLAG) != 0U)
+    {
+        slept += CM7_REG(SYSTICK_LOAD) + 1U;
+    }
+
+    cycleCounterAdvance(slept);
+    tickProfilerIdleSlept(slept);
+
+    __asm(" cpsie i");
+}
+#endif
+
+#endif /* MLFQ_BOARD */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
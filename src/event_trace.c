@@ -0,0 +1,193 @@
+/******************************************************************************
+ *  MODULE NAME  : Event Trace
+ *  FILE         : event_trace.c
+ *  DESCRIPTION  : Always-on circular event trace. Entries are written from
+ *                 kernel trace hooks, the tick hook and the supervisor, and
+ *                 printed on demand for the host decoder.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "event_trace.h"
+#include "flight_recorder.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+#include "drivers.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+
+#if (EVENT_TRACE_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Longest line printed by the dump */
+#define EVENT_TRACE_LINE_SIZE    64U
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Trace storage; g_traceCount runs freely and is masked on access */
+static EventTraceEntry_t g_traceBuffer[EVENT_TRACE_LENGTH];
+static volatile uint32_t g_traceCount = 0U;
+
+/* Recording is paused while the buffer is being dumped */
+static volatile bool g_tracePaused = false;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Sends one dump line on the trace channel, waiting for
+ *               UART space rather than letting the transmit buffer drop it.
+ */
+static void sendTraceLine(const char *line, uint32_t length)
+{
+    while (getLogChannelFree(LOG_CHANNEL_TRACE) < length)
+    {
+        vTaskDelay(1);
+    }
+
+    (void)sendLogChannel(LOG_CHANNEL_TRACE, line, length);
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Appends an event. Only the slot index is claimed with
+ *               interrupts masked (a few cycles, no kernel lock), so the
+ *               function is usable from any task or ISR at or below
+ *               configMAX_SYSCALL_INTERRUPT_PRIORITY, including the
+ *               context-switch hooks. With FLIGHT_RECORDER_ENABLED the
+ *               event is also copied to the retained log, even while the
+ *               trace is paused for a dump.
+ */
+void eventTraceRecord(uint8_t event, void *task, uint8_t arg0, uint8_t arg1)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    flightRecorderEvent(event, task,
+                        (slot >= 0) ? (uint8_t)slot : (uint8_t)EVENT_TRACE_NO_SLOT,
+                        arg0, arg1);
+#endif
+
+    if (g_tracePaused)
+    {
+        return;
+    }
+
+    /* The ISR lock rather than the mask alone: on SMP both cores record */
+    UBaseType_t savedMask = taskENTER_CRITICAL_FROM_ISR();
+    EventTraceEntry_t *entry = &g_traceBuffer[g_traceCount & (EVENT_TRACE_LENGTH - 1U)];
+    g_traceCount++;
+
+    entry->timestamp = cycleCounterGet();
+    entry->task      = (uint32_t)(uintptr_t)task;
+    entry->event     = event;
+    entry->slot      = (slot >= 0) ? (uint8_t)slot : (uint8_t)EVENT_TRACE_NO_SLOT;
+    entry->arg0      = arg0;
+    entry->arg1      = arg1;
+    taskEXIT_CRITICAL_FROM_ISR(savedMask);
+}
+
+/*
+ * Description : Appends an event for the currently running task.
+ *               Used by hooks that expand outside tasks.c.
+ */
+void eventTraceRecordCurrent(uint8_t event, uint8_t arg0)
+{
+    eventTraceRecord(event, (void *)xTaskGetCurrentTaskHandle(), arg0, 0U);
+}
+
+/*
+ * Description : Copies trace entry 'index', counted from the oldest
+ *               entry still held. Returns false past the newest one.
+ */
+bool eventTraceGetEntry(uint32_t index, EventTraceEntry_t *output)
+{
+    uint32_t count = g_traceCount;
+    uint32_t held = (count < EVENT_TRACE_LENGTH) ? count : EVENT_TRACE_LENGTH;
+
+    if ((output == NULL) || (index >= held))
+    {
+        return false;
+    }
+
+    *output = g_traceBuffer[(count - held + index) & (EVENT_TRACE_LENGTH - 1U)];
+    return true;
+}
+
+/*
+ * Description : Prints the trace as text lines for tools/trace_decode.py:
+ *                 #TRACE BEGIN <entries> <overwritten> <cpu hz>
+ *                 N <slot> <task> <name>          one per profiled task
+ *                 E <cycles> <event> <task> <slot> <arg0> <arg1>
+ *                 #TRACE END
+ *               Recording is paused for the duration, so call it from a
+ *               task that may block (it waits for UART space).
+ */
+void eventTraceDump(void)
+{
+    char line[EVENT_TRACE_LINE_SIZE];
+    EventTraceEntry_t entry;
+    int length;
+
+    g_tracePaused = true;
+
+    uint32_t count = g_traceCount;
+    uint32_t held  = (count < EVENT_TRACE_LENGTH) ? count : EVENT_TRACE_LENGTH;
+
+    length = snprintf(line, sizeof(line), "#TRACE BEGIN %lu %lu %lu\r\n",
+                      (unsigned long)held,
+                      (unsigned long)(count - held),
+                      (unsigned long)configCPU_CLOCK_HZ);
+    sendTraceLine(line, (uint32_t)length);
+
+    /* Name table so the decoder can label task handles */
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if (record != NULL)
+        {
+            length = snprintf(line, sizeof(line), "N %lu %08lx %s\r\n",
+                              (unsigned long)slot,
+                              (unsigned long)(uintptr_t)record->task,
+                              pcTaskGetName(record->task));
+            sendTraceLine(line, (uint32_t)length);
+        }
+    }
+
+    for (uint32_t i = 0U; eventTraceGetEntry(i, &entry); i++)
+    {
+        length = snprintf(line, sizeof(line), "E %08lx %u %08lx %u %u %u\r\n",
+                          (unsigned long)entry.timestamp,
+                          (unsigned)entry.event,
+                          (unsigned long)entry.task,
+                          (unsigned)entry.slot,
+                          (unsigned)entry.arg0,
+                          (unsigned)entry.arg1);
+        sendTraceLine(line, (uint32_t)length);
+    }
+
+    sendTraceLine("#TRACE END\r\n", 12U);
+
+    g_tracePaused = false;
+}
+
+#endif /* EVENT_TRACE_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,333 @@
+/******************************************************************************
+ *  MODULE NAME  : Flash History Log
+ *  FILE         : flash_log.c
+ *  DESCRIPTION  : Ring of summary records in on-chip flash, written with
+ *                 TivaWare flash.c. Records are appended in slot order and
+ *                 each erase block is erased just before the ring wraps
+ *                 into it, so every block wears at the same rate.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "flash_log.h"
+#include "tick_profiler.h"
+#include "latency_stats.h"
+
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+#include "TivaWare/driverlib/flash.h"
+#include "TivaWare/driverlib/sw_crc.h"
+
+#if (FLASH_LOG_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+#define FLASH_LOG_SLOTS              ((FLASH_LOG_BLOCKS * FLASH_LOG_BLOCK_SIZE) / FLASH_LOG_RECORD_SIZE)
+#define FLASH_LOG_SLOTS_PER_BLOCK    (FLASH_LOG_BLOCK_SIZE / FLASH_LOG_RECORD_SIZE)
+
+/* Value of an erased word */
+#define FLASH_LOG_ERASED             0xFFFFFFFFUL
+
+#define FLASH_LOG_STATIC_ASSERT(cond, name)  typedef char name[(cond) ? 1 : -1]
+
+FLASH_LOG_STATIC_ASSERT(sizeof(FlashLogRecord_t) <= FLASH_LOG_RECORD_SIZE,
+                        flash_log_record_fits_slot);
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Record padded to its slot, as programmed: whole words,
+ *               with the unused tail left erased.
+ */
+typedef union
+{
+    FlashLogRecord_t record;
+    uint32_t         words[FLASH_LOG_RECORD_SIZE / 4U];
+} FlashLogSlot_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Next slot to program and the sequence number it gets */
+static uint32_t g_nextSlot = 0U;
+static uint32_t g_nextSequence = 0U;
+
+/* Period bookkeeping, logger task only */
+static TickType_t g_lastTick = 0U;
+static uint64_t g_uptimeTicks = 0U;
+
+/* Counters at the previous record, for the per-period differences */
+static TickProfilerCpuTime_t g_cpuLast;
+static uint32_t g_demotionsLast = 0U;
+static uint32_t g_boostsLast = 0U;
+static uint32_t g_overloadsLast = 0U;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Returns the slot at index 'slot', read in place.
+ */
+static const FlashLogSlot_t *slotAddress(uint32_t slot)
+{
+    return (const FlashLogSlot_t *)(FLASH_LOG_BASE + (slot * FLASH_LOG_RECORD_SIZE));
+}
+
+/*
+ * Description : CRC of a record, excluding the CRC itself.
+ */
+static uint16_t recordCrc(const FlashLogRecord_t *record)
+{
+    return Crc16(0U, (const uint8_t *)record,
+                 (uint32_t)offsetof(FlashLogRecord_t, crc));
+}
+
+/*
+ * Description : True for a slot holding a complete record.
+ */
+static bool slotValid(const FlashLogSlot_t *slot)
+{
+    return (slot->record.sequence != FLASH_LOG_ERASED) &&
+           (slot->record.crc == recordCrc(&slot->record));
+}
+
+/*
+ * Description : True if 'count' words from 'address' are all erased.
+ */
+static bool rangeErased(uint32_t address, uint32_t count)
+{
+    const uint32_t *word = (const uint32_t *)(uintptr_t)address;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (word[i] != FLASH_LOG_ERASED)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Description : Share of 'part' in 'total', in permille.
+ */
+static uint16_t permille(uint64_t part, uint64_t total)
+{
+    return (total == 0U) ? 0U : (uint16_t)((part * 1000U) / total);
+}
+
+/*
+ * Description : Converts a cycle count to microseconds, saturating at
+ *               the 16-bit field.
+ */
+static uint16_t cyclesToUs(uint32_t cycles)
+{
+    uint32_t us = cycles / (configCPU_CLOCK_HZ / 1000000UL);
+
+    return (us > 0xFFFFU) ? 0xFFFFU : (uint16_t)us;
+}
+
+/*
+ * Description : Fills a record with the summary of the period ending now
+ *               and moves the counters on to the next period.
+ */
+static void buildRecord(FlashLogRecord_t *record)
+{
+    TickProfilerCpuTime_t now;
+    MLFQ_BoostStats_t boost;
+    MLFQ_OverloadStatus_t overload;
+    uint64_t total = 0U;
+
+    memset(record, 0, sizeof(*record));
+    record->sequence = g_nextSequence;
+    record->uptime_s = (uint32_t)(g_uptimeTicks / configTICK_RATE_HZ);
+
+    tickProfilerGetCpuTime(&now);
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        total += now.level[level] - g_cpuLast.level[level];
+    }
+    total += (now.supervisor - g_cpuLast.supervisor) +
+             (now.idle - g_cpuLast.idle) +
+             (now.other - g_cpuLast.other);
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        record->level_permille[level] =
+            permille(now.level[level] - g_cpuLast.level[level], total);
+    }
+    record->idle_permille = permille(now.idle - g_cpuLast.idle, total);
+    g_cpuLast = now;
+
+    uint32_t demotions = schedulerGetDemotionCount();
+    record->demotions = demotions - g_demotionsLast;
+    g_demotionsLast = demotions;
+
+    schedulerGetBoostStats(&boost);
+    record->boosts = boost.boost_count - g_boostsLast;
+    g_boostsLast = boost.boost_count;
+
+    if (schedulerGetOverloadStatus(&overload))
+    {
+        record->overloads = overload.events - g_overloadsLast;
+        g_overloadsLast = overload.events;
+    }
+
+#if (LATENCY_STATS_ENABLED == 1U)
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        LatencySummary_t summary;
+
+        if (latencyGetLevelSummary(level, &summary))
+        {
+            record->p50_us[level] = cyclesToUs(summary.p50_cycles);
+            record->p99_us[level] = cyclesToUs(summary.p99_cycles);
+        }
+    }
+#endif
+
+    record->crc = recordCrc(record);
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Scans the region for the newest valid record. The next
+ *               slot follows it; a slot left half-programmed by a reset
+ *               is skipped, up to the next block, which is erased anyway.
+ */
+void flashLogInit(void)
+{
+    bool found = false;
+    uint32_t newest = 0U;
+
+    for (uint32_t slot = 0U; slot < FLASH_LOG_SLOTS; slot++)
+    {
+        const FlashLogSlot_t *stored = slotAddress(slot);
+
+        if (slotValid(stored) &&
+            (!found || (stored->record.sequence > slotAddress(newest)->record.sequence)))
+        {
+            newest = slot;
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        g_nextSequence = slotAddress(newest)->record.sequence + 1U;
+        g_nextSlot = (newest + 1U) % FLASH_LOG_SLOTS;
+
+        while (((g_nextSlot % FLASH_LOG_SLOTS_PER_BLOCK) != 0U) &&
+               !rangeErased((uint32_t)(uintptr_t)slotAddress(g_nextSlot), FLASH_LOG_RECORD_SIZE / 4U))
+        {
+            g_nextSlot = (g_nextSlot + 1U) % FLASH_LOG_SLOTS;
+        }
+    }
+
+    // The first period starts now
+    MLFQ_BoostStats_t boost;
+    MLFQ_OverloadStatus_t overload;
+
+    g_lastTick = xTaskGetTickCount();
+    tickProfilerGetCpuTime(&g_cpuLast);
+    g_demotionsLast = schedulerGetDemotionCount();
+    schedulerGetBoostStats(&boost);
+    g_boostsLast = boost.boost_count;
+    if (schedulerGetOverloadStatus(&overload))
+    {
+        g_overloadsLast = overload.events;
+    }
+}
+
+/*
+ * Description : Appends a record once FLASH_LOG_PERIOD_S has passed.
+ *               Erasing a block stalls the core for some milliseconds
+ *               and programming a record for some tens of microseconds,
+ *               including interrupts whose code runs from flash, so this
+ *               runs in the logger task and never in the supervisor.
+ */
+TickType_t flashLogService(void)
+{
+    const TickType_t xPeriod = (TickType_t)FLASH_LOG_PERIOD_S * configTICK_RATE_HZ;
+    TickType_t xNow = xTaskGetTickCount();
+    TickType_t xElapsed = xNow - g_lastTick;
+    FlashLogSlot_t buffer;
+
+    if (xElapsed < xPeriod)
+    {
+        return xPeriod - xElapsed;
+    }
+
+    g_uptimeTicks += xElapsed;
+    g_lastTick = xNow;
+
+    memset(&buffer, 0xFF, sizeof(buffer));
+    buildRecord(&buffer.record);
+
+    // Entering a block: it holds the oldest records, erase it first
+    uint32_t address = (uint32_t)(uintptr_t)slotAddress(g_nextSlot);
+    uint32_t blockStart = address & ~(FLASH_LOG_BLOCK_SIZE - 1U);
+
+    if (((g_nextSlot % FLASH_LOG_SLOTS_PER_BLOCK) == 0U) &&
+        !rangeErased(blockStart, FLASH_LOG_BLOCK_SIZE / 4U))
+    {
+        (void)FlashErase(blockStart);
+    }
+
+    (void)FlashProgram(buffer.words, address, FLASH_LOG_RECORD_SIZE);
+
+    g_nextSlot = (g_nextSlot + 1U) % FLASH_LOG_SLOTS;
+    g_nextSequence++;
+
+    return xPeriod;
+}
+
+/*
+ * Description : Number of record slots in the region.
+ */
+uint32_t flashLogGetSlotCount(void)
+{
+    return FLASH_LOG_SLOTS;
+}
+
+/*
+ * Description : Copies the record in slot 'index', counted from the slot
+ *               to be written next, which is the oldest position.
+ */
+bool flashLogGetRecord(uint32_t index, FlashLogRecord_t *output)
+{
+    if ((index >= FLASH_LOG_SLOTS) || (output == NULL))
+    {
+        return false;
+    }
+
+    const FlashLogSlot_t *stored = slotAddress((g_nextSlot + index) % FLASH_LOG_SLOTS);
+
+    if (!slotValid(stored))
+    {
+        return false;
+    }
+
+    *output = stored->record;
+    return true;
+}
+
+#endif /* FLASH_LOG_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
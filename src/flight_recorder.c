@@ -0,0 +1,447 @@
+/******************************************************************************
+ *  MODULE NAME  : Flight Recorder
+ *  FILE         : flight_recorder.c
+ *  DESCRIPTION  : Event ring and A/B stats snapshots in retained RAM. The
+ *                 events are sealed with a CRC by the fault handlers and
+ *                 the first watchdog timeout; each snapshot carries its
+ *                 own CRC. The next boot prints whatever checks out.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "flight_recorder.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+#include "drivers.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "TivaWare/driverlib/sw_crc.h"
+#if !defined(MLFQ_HOST_SIM)
+#include "TivaWare/driverlib/hw_types.h"
+#include "TivaWare/driverlib/hw_nvic.h"
+#include "TivaWare/driverlib/sysctl.h"
+#endif
+
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Marks a log or snapshot written by this firmware layout */
+#define FLIGHT_RECORDER_MAGIC        0x464C5431UL   /* "FLT1" */
+
+/* Longest line printed by the dump */
+#define FLIGHT_RECORDER_LINE_SIZE    80U
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Event log. Written freely while running; the CRC is only
+ *               valid once flightRecorderSeal() has run.
+ */
+typedef struct
+{
+    uint32_t          magic;
+    uint32_t          cause;          /* FLIGHT_RECORDER_CAUSE_x */
+    uint32_t          vector;         /* Active exception number at the seal */
+    uint32_t          fault_status;   /* CFSR at the seal */
+    uint32_t          count;          /* Events recorded, runs freely */
+    EventTraceEntry_t event[FLIGHT_RECORDER_EVENTS];
+    uint32_t          crc;            /* Crc32 of every preceding byte */
+} FlightRecorderLog_t;
+
+/*
+ * Description : One task of a stats snapshot.
+ */
+typedef struct
+{
+    uint32_t task;                    /* Task handle, as in the event log */
+    uint8_t  slot;
+    uint8_t  level;
+    uint16_t reserved;
+    uint32_t run_ticks;
+    uint32_t quantum_ticks;
+    uint32_t wait_ticks;
+    char     name[configMAX_TASK_NAME_LEN];
+} FlightRecorderRow_t;
+
+/*
+ * Description : Stats snapshot. Two are kept and written in turn, so a
+ *               reset while one is being written leaves the other intact.
+ */
+typedef struct
+{
+    uint32_t            magic;
+    uint32_t            sequence;     /* Higher is newer */
+    uint32_t            timestamp;    /* Tick of the snapshot */
+    uint32_t            count;        /* Valid rows */
+    FlightRecorderRow_t row[TICK_PROFILER_MAX_TASKS];
+    uint32_t            crc;          /* Crc32 of the header and valid rows */
+} FlightRecorderSnapshot_t;
+
+typedef struct
+{
+    FlightRecorderLog_t      log;
+    FlightRecorderSnapshot_t snapshot[2];
+} FlightRecorder_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Placed in .noinit, which the C startup neither zeroes nor copies */
+#if !defined(MLFQ_HOST_SIM)
+#pragma DATA_SECTION(g_flightRecorder, ".noinit")
+#endif
+static FlightRecorder_t g_flightRecorder;
+
+/* Snapshot being written and the sequence number it gets */
+static FlightRecorderSnapshot_t *g_snapshotNext = NULL;
+static uint32_t g_snapshotSequence = 0U;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : CRC of the event log, excluding the CRC word itself.
+ */
+static uint32_t logCrc(const FlightRecorderLog_t *log)
+{
+    return Crc32(0xFFFFFFFFUL, (const uint8_t *)log,
+                 (uint32_t)offsetof(FlightRecorderLog_t, crc));
+}
+
+/*
+ * Description : CRC of a snapshot header and its valid rows.
+ */
+static uint32_t snapshotCrc(const FlightRecorderSnapshot_t *snapshot)
+{
+    uint32_t count = (snapshot->count <= TICK_PROFILER_MAX_TASKS) ?
+                     snapshot->count : TICK_PROFILER_MAX_TASKS;
+
+    return Crc32(0xFFFFFFFFUL, (const uint8_t *)snapshot,
+                 (uint32_t)(offsetof(FlightRecorderSnapshot_t, row) +
+                            (count * sizeof(FlightRecorderRow_t))));
+}
+
+/*
+ * Description : True for a snapshot left complete by the previous boot.
+ */
+static bool snapshotValid(const FlightRecorderSnapshot_t *snapshot)
+{
+    return (snapshot->magic == FLIGHT_RECORDER_MAGIC) &&
+           (snapshot->count <= TICK_PROFILER_MAX_TASKS) &&
+           (snapshot->crc == snapshotCrc(snapshot));
+}
+
+/*
+ * Description : Sends one dump line. The kernel is not running yet, so
+ *               this spins until the UART interrupt has made room.
+ */
+static void sendDumpLine(const char *line, int length)
+{
+    while (getLogChannelFree(LOG_CHANNEL_TRACE) < (uint32_t)length)
+    {
+    }
+
+    (void)sendLogChannel(LOG_CHANNEL_TRACE, line, (uint32_t)length);
+}
+
+/*
+ * Description : Prints the sealed event log in the #TRACE format of
+ *               eventTraceDump(), named from the snapshot if there is one.
+ */
+static void dumpLog(const FlightRecorderLog_t *log,
+                    const FlightRecorderSnapshot_t *snapshot)
+{
+    char line[FLIGHT_RECORDER_LINE_SIZE];
+    uint32_t held = (log->count < FLIGHT_RECORDER_EVENTS) ?
+                    log->count : FLIGHT_RECORDER_EVENTS;
+    int length;
+
+    length = snprintf(line, sizeof(line), "#TRACE BEGIN %lu %lu %lu\r\n",
+                      (unsigned long)held,
+                      (unsigned long)(log->count - held),
+                      (unsigned long)configCPU_CLOCK_HZ);
+    sendDumpLine(line, length);
+
+    for (uint32_t i = 0U; (snapshot != NULL) && (i < snapshot->count); i++)
+    {
+        const FlightRecorderRow_t *row = &snapshot->row[i];
+
+        length = snprintf(line, sizeof(line), "N %u %08lx %.*s\r\n",
+                          (unsigned)row->slot,
+                          (unsigned long)row->task,
+                          (int)configMAX_TASK_NAME_LEN, row->name);
+        sendDumpLine(line, length);
+    }
+
+    for (uint32_t i = 0U; i < held; i++)
+    {
+        const EventTraceEntry_t *entry =
+            &log->event[(log->count - held + i) & (FLIGHT_RECORDER_EVENTS - 1U)];
+
+        length = snprintf(line, sizeof(line), "E %08lx %u %08lx %u %u %u\r\n",
+                          (unsigned long)entry->timestamp,
+                          (unsigned)entry->event,
+                          (unsigned long)entry->task,
+                          (unsigned)entry->slot,
+                          (unsigned)entry->arg0,
+                          (unsigned)entry->arg1);
+        sendDumpLine(line, length);
+    }
+
+    sendDumpLine("#TRACE END\r\n", 12);
+}
+
+/*
+ * Description : Prints the rows of a snapshot:
+ *                 S <slot> <level> <run> <quantum> <wait> <name>
+ */
+static void dumpSnapshot(const FlightRecorderSnapshot_t *snapshot)
+{
+    char line[FLIGHT_RECORDER_LINE_SIZE];
+    int length;
+
+    length = snprintf(line, sizeof(line), "#SNAPSHOT %lu %lu\r\n",
+                      (unsigned long)snapshot->timestamp,
+                      (unsigned long)snapshot->count);
+    sendDumpLine(line, length);
+
+    for (uint32_t i = 0U; i < snapshot->count; i++)
+    {
+        const FlightRecorderRow_t *row = &snapshot->row[i];
+
+        length = snprintf(line, sizeof(line), "S %u %u %lu %lu %lu %.*s\r\n",
+                          (unsigned)row->slot,
+                          (unsigned)row->level,
+                          (unsigned long)row->run_ticks,
+                          (unsigned long)row->quantum_ticks,
+                          (unsigned long)row->wait_ticks,
+                          (int)configMAX_TASK_NAME_LEN, row->name);
+        sendDumpLine(line, length);
+    }
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Prints the previous boot's record, if any part of it
+ *               checks out:
+ *                 #FLIGHT BEGIN <cause> <vector> <fault status> <reset cause>
+ *                 #TRACE BEGIN ... #TRACE END       sealed event log
+ *                 #SNAPSHOT <tick> <rows> and S lines newest snapshot
+ *                 #FLIGHT END
+ *               or "#FLIGHT NONE" after a power-on or a reset that did not
+ *               seal the events and left no snapshot. The event log is
+ *               then restarted; the older snapshot is invalidated, so the
+ *               first report of this boot overwrites it.
+ */
+void flightRecorderInit(void)
+{
+    FlightRecorderLog_t *log = &g_flightRecorder.log;
+    const FlightRecorderSnapshot_t *snapshot = NULL;
+    bool sealed = (log->magic == FLIGHT_RECORDER_MAGIC) &&
+                  (log->cause != FLIGHT_RECORDER_CAUSE_NONE) &&
+                  (log->crc == logCrc(log));
+    uint32_t resetCause = 0U;
+    char line[FLIGHT_RECORDER_LINE_SIZE];
+    int length;
+
+#if !defined(MLFQ_HOST_SIM)
+    /* Read only: the supervisor takes and clears the watchdog cause */
+    resetCause = SysCtlResetCauseGet();
+#endif
+
+    for (uint32_t i = 0U; i < 2U; i++)
+    {
+        const FlightRecorderSnapshot_t *candidate = &g_flightRecorder.snapshot[i];
+
+        if (snapshotValid(candidate) &&
+            ((snapshot == NULL) ||
+             ((int32_t)(candidate->sequence - snapshot->sequence) > 0)))
+        {
+            snapshot = candidate;
+        }
+    }
+
+    if (!sealed && (snapshot == NULL))
+    {
+        sendDumpLine("#FLIGHT NONE\r\n", 14);
+    }
+    else
+    {
+        length = snprintf(line, sizeof(line), "#FLIGHT BEGIN %lu %lu %08lx %08lx\r\n",
+                          (unsigned long)(sealed ? log->cause : FLIGHT_RECORDER_CAUSE_NONE),
+                          (unsigned long)(sealed ? log->vector : 0U),
+                          (unsigned long)(sealed ? log->fault_status : 0U),
+                          (unsigned long)resetCause);
+        sendDumpLine(line, length);
+
+        if (sealed)
+        {
+            dumpLog(log, snapshot);
+        }
+        if (snapshot != NULL)
+        {
+            dumpSnapshot(snapshot);
+        }
+
+        sendDumpLine("#FLIGHT END\r\n", 13);
+    }
+
+    /* Continue the sequence, so the next snapshot is the newest */
+    g_snapshotSequence = (snapshot != NULL) ? (snapshot->sequence + 1U) : 0U;
+    g_flightRecorder.snapshot[0].magic = 0U;
+    g_flightRecorder.snapshot[1].magic = 0U;
+
+    log->cause = FLIGHT_RECORDER_CAUSE_NONE;
+    log->count = 0U;
+    log->crc   = 0U;
+    log->magic = FLIGHT_RECORDER_MAGIC;
+}
+
+/*
+ * Description : Appends an event. Called from eventTraceRecord() with the
+ *               slot already resolved. Nothing is recorded once sealed,
+ *               so the log keeps the events that led up to the seal.
+ */
+void flightRecorderEvent(uint8_t event, void *task, uint8_t slot,
+                         uint8_t arg0, uint8_t arg1)
+{
+    FlightRecorderLog_t *log = &g_flightRecorder.log;
+
+    UBaseType_t savedMask = taskENTER_CRITICAL_FROM_ISR();
+    if (log->cause == FLIGHT_RECORDER_CAUSE_NONE)
+    {
+        EventTraceEntry_t *entry = &log->event[log->count & (FLIGHT_RECORDER_EVENTS - 1U)];
+        log->count++;
+
+        entry->timestamp = cycleCounterGet();
+        entry->task      = (uint32_t)(uintptr_t)task;
+        entry->event     = event;
+        entry->slot      = slot;
+        entry->arg0      = arg0;
+        entry->arg1      = arg1;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(savedMask);
+}
+
+/*
+ * Description : Starts a snapshot in the older of the two buffers.
+ *               Supervisor only, from printQueueReport().
+ */
+void flightRecorderSnapshotBegin(uint32_t tick)
+{
+    g_snapshotNext = &g_flightRecorder.snapshot[g_snapshotSequence & 1U];
+
+    g_snapshotNext->magic     = 0U;
+    g_snapshotNext->sequence  = g_snapshotSequence;
+    g_snapshotNext->timestamp = tick;
+    g_snapshotNext->count     = 0U;
+}
+
+/*
+ * Description : Adds one task to the snapshot being written, with the
+ *               handle and name the dump uses to label the event log.
+ */
+void flightRecorderSnapshotRow(uint32_t slot, uint32_t level, uint32_t runTicks,
+                               uint32_t quantumTicks, uint32_t waitTicks)
+{
+    TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+    if ((g_snapshotNext == NULL) || (info == NULL) ||
+        (g_snapshotNext->count >= TICK_PROFILER_MAX_TASKS))
+    {
+        return;
+    }
+
+    FlightRecorderRow_t *row = &g_snapshotNext->row[g_snapshotNext->count];
+
+    row->task          = (uint32_t)(uintptr_t)info->task;
+    row->slot          = (uint8_t)slot;
+    row->level         = (uint8_t)level;
+    row->reserved      = 0U;
+    row->run_ticks     = runTicks;
+    row->quantum_ticks = quantumTicks;
+    row->wait_ticks    = waitTicks;
+    (void)strncpy(row->name, pcTaskGetName(info->task), sizeof(row->name));
+
+    g_snapshotNext->count++;
+}
+
+/*
+ * Description : Seals the snapshot being written. It replaces the older
+ *               one only once its CRC is in place.
+ */
+void flightRecorderSnapshotEnd(void)
+{
+    if (g_snapshotNext == NULL)
+    {
+        return;
+    }
+
+    g_snapshotNext->magic = FLIGHT_RECORDER_MAGIC;
+    g_snapshotNext->crc   = snapshotCrc(g_snapshotNext);
+    g_snapshotNext = NULL;
+    g_snapshotSequence++;
+}
+
+/*
+ * Description : Freezes the event log and seals it with its CRC, along
+ *               with the active exception and the configurable fault
+ *               status. The first seal wins.
+ */
+void flightRecorderSeal(uint32_t cause)
+{
+    FlightRecorderLog_t *log = &g_flightRecorder.log;
+
+    if ((log->magic != FLIGHT_RECORDER_MAGIC) ||
+        (log->cause != FLIGHT_RECORDER_CAUSE_NONE))
+    {
+        return;
+    }
+
+#if !defined(MLFQ_HOST_SIM)
+    log->vector       = HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_VEC_ACT_M;
+    log->fault_status = HWREG(NVIC_FAULT_STAT);
+#else
+    log->vector       = 0U;
+    log->fault_status = 0U;
+#endif
+    log->cause = cause;
+    log->crc   = logCrc(log);
+}
+
+/*
+ * Description : Lifts a watchdog seal. The supervisor fed the watchdog
+ *               after its first timeout, so no reset follows.
+ */
+void flightRecorderResume(void)
+{
+    FlightRecorderLog_t *log = &g_flightRecorder.log;
+
+    if (log->cause == FLIGHT_RECORDER_CAUSE_WATCHDOG)
+    {
+        log->cause = FLIGHT_RECORDER_CAUSE_NONE;
+    }
+}
+
+#endif /* FLIGHT_RECORDER_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,228 @@
+/******************************************************************************
+ *  MODULE NAME  : Heap Statistics
+ *  FILE         : heap_stats.c
+ *  DESCRIPTION  : Counts failed allocations and keeps the optional
+ *                 allocation trace, both fed by the heap_4 trace hooks,
+ *                 and reads the heap figures for the metrics logger.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "heap_stats.h"
+#include "cycle_counter.h"
+#include "drivers.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+
+#if (HEAP_STATS_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Longest line printed by the dump */
+#define HEAP_TRACE_LINE_SIZE     64U
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Both hooks run with the scheduler suspended and the heap is never used
+ * from an ISR, so the writers need no further locking */
+static uint32_t g_heapFailures = 0U;
+
+#if (HEAP_TRACE_ENABLED == 1U)
+/* Trace storage; g_heapTraceCount runs freely and is masked on access */
+static HeapTraceEntry_t g_heapTrace[HEAP_TRACE_LENGTH];
+static uint32_t g_heapTraceCount = 0U;
+
+/* Recording is paused while the buffer is being dumped */
+static volatile bool g_heapTracePaused = false;
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+#if (HEAP_TRACE_ENABLED == 1U)
+/*
+ * Description : Appends one operation. Allocations made before the
+ *               scheduler starts are charged to no task.
+ */
+static void recordOperation(uint8_t operation, void *address, uint32_t size, void *caller)
+{
+    if (g_heapTracePaused)
+    {
+        return;
+    }
+
+    HeapTraceEntry_t *entry = &g_heapTrace[g_heapTraceCount & (HEAP_TRACE_LENGTH - 1U)];
+    g_heapTraceCount++;
+
+    entry->timestamp = cycleCounterGet();
+    entry->task      = (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) ?
+                       0U : (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+    entry->address   = (uint32_t)(uintptr_t)address;
+    entry->caller    = (uint32_t)(uintptr_t)caller;
+    entry->size      = size;
+    entry->operation = operation;
+}
+
+/*
+ * Description : Sends one dump line on the trace channel, waiting for
+ *               UART space rather than letting the transmit buffer drop it.
+ */
+static void sendTraceLine(const char *line, uint32_t length)
+{
+    while (getLogChannelFree(LOG_CHANNEL_TRACE) < length)
+    {
+        vTaskDelay(1);
+    }
+
+    (void)sendLogChannel(LOG_CHANNEL_TRACE, line, length);
+}
+#endif
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : traceMALLOC hook. 'address' is NULL when the allocation
+ *               failed; 'size' is the block size heap_4 searched for.
+ */
+void heapStatsMalloc(void *address, uint32_t size, void *caller)
+{
+    if (address == NULL)
+    {
+        g_heapFailures++;
+    }
+
+#if (HEAP_TRACE_ENABLED == 1U)
+    recordOperation((address != NULL) ? HEAP_TRACE_ALLOC : HEAP_TRACE_FAILED,
+                    address, size, caller);
+#else
+    (void)size;
+    (void)caller;
+#endif
+}
+
+/*
+ * Description : traceFREE hook. 'size' is the size of the block returned.
+ */
+void heapStatsFree(void *address, uint32_t size, void *caller)
+{
+#if (HEAP_TRACE_ENABLED == 1U)
+    recordOperation(HEAP_TRACE_FREE, address, size, caller);
+#else
+    (void)address;
+    (void)size;
+    (void)caller;
+#endif
+}
+
+/*
+ * Description : Reads the heap figures. vPortGetHeapStats() walks the
+ *               free list with the scheduler suspended, so call it from a
+ *               task, not from the tick hook or an ISR.
+ */
+void heapStatsGet(HeapSummary_t *output)
+{
+    HeapStats_t stats;
+
+    if (output == NULL)
+    {
+        return;
+    }
+
+    vPortGetHeapStats(&stats);
+
+    output->free_bytes     = (uint32_t)stats.xAvailableHeapSpaceInBytes;
+    output->min_free_bytes = (uint32_t)stats.xMinimumEverFreeBytesRemaining;
+    output->largest_block  = (uint32_t)stats.xSizeOfLargestFreeBlockInBytes;
+    output->free_blocks    = (uint32_t)stats.xNumberOfFreeBlocks;
+    output->allocations    = (uint32_t)stats.xNumberOfSuccessfulAllocations;
+    output->frees          = (uint32_t)stats.xNumberOfSuccessfulFrees;
+    output->failures       = g_heapFailures;
+}
+
+#if (HEAP_TRACE_ENABLED == 1U)
+/*
+ * Description : Copies trace entry 'index', counted from the oldest
+ *               entry still held. Returns false past the newest one.
+ */
+bool heapTraceGetEntry(uint32_t index, HeapTraceEntry_t *output)
+{
+    bool found = false;
+
+    vTaskSuspendAll();
+    {
+        uint32_t count = g_heapTraceCount;
+        uint32_t held  = (count < HEAP_TRACE_LENGTH) ? count : HEAP_TRACE_LENGTH;
+
+        if ((output != NULL) && (index < held))
+        {
+            *output = g_heapTrace[(count - held + index) & (HEAP_TRACE_LENGTH - 1U)];
+            found = true;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return found;
+}
+
+/*
+ * Description : Prints the trace as text lines, oldest first:
+ *                 #HEAP BEGIN <entries> <overwritten> <cpu hz>
+ *                 A|F|X <cycles> <task> <address> <size> <caller>
+ *                 #HEAP END
+ *               A is an allocation, F a free and X a failed allocation.
+ *               Look the callers up in the map file or with addr2line.
+ *               Recording is paused for the duration; call it from a
+ *               task that may block (it waits for UART space).
+ */
+void heapTraceDump(void)
+{
+    static const char operations[] = { 'A', 'F', 'X' };
+    char line[HEAP_TRACE_LINE_SIZE];
+    HeapTraceEntry_t entry;
+    int length;
+
+    g_heapTracePaused = true;
+
+    uint32_t count = g_heapTraceCount;
+    uint32_t held  = (count < HEAP_TRACE_LENGTH) ? count : HEAP_TRACE_LENGTH;
+
+    length = snprintf(line, sizeof(line), "#HEAP BEGIN %lu %lu %lu\r\n",
+                      (unsigned long)held,
+                      (unsigned long)(count - held),
+                      (unsigned long)configCPU_CLOCK_HZ);
+    sendTraceLine(line, (uint32_t)length);
+
+    for (uint32_t i = 0U; heapTraceGetEntry(i, &entry); i++)
+    {
+        length = snprintf(line, sizeof(line), "%c %08lx %08lx %08lx %lu %08lx\r\n",
+                          operations[entry.operation],
+                          (unsigned long)entry.timestamp,
+                          (unsigned long)entry.task,
+                          (unsigned long)entry.address,
+                          (unsigned long)entry.size,
+                          (unsigned long)entry.caller);
+        sendTraceLine(line, (uint32_t)length);
+    }
+
+    sendTraceLine("#HEAP END\r\n", 11U);
+
+    g_heapTracePaused = false;
+}
+#endif /* HEAP_TRACE_ENABLED */
+
+#endif /* HEAP_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
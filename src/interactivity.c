@@ -0,0 +1,258 @@
+/******************************************************************************
+ *  MODULE NAME  : Interactivity Score
+ *  FILE         : interactivity.c
+ *  DESCRIPTION  : Run/sleep accounting and scoring for the score-based
+ *                 classifier. All times are DWT cycles.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "interactivity.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+typedef struct
+{
+    uint32_t run_cycles;    /* Decayed CPU time */
+    uint32_t sleep_cycles;  /* Decayed blocked time */
+    uint32_t stamp;         /* Switch-in time, or block time while asleep */
+    bool     sleeping;      /* Blocked since the last switch-out */
+} InteractivityHistory_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+static InteractivityHistory_t g_history[TICK_PROFILER_MAX_TASKS];
+
+/* INTERACTIVITY_HISTORY_MS in cycles */
+static uint32_t g_historyCycles = 0U;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Keeps run + sleep within the history length, so the
+ *               score follows recent behaviour. A single sleep longer
+ *               than the whole history is clamped first.
+ */
+static void decay(InteractivityHistory_t *history)
+{
+    if (history->sleep_cycles > g_historyCycles)
+    {
+        history->sleep_cycles = g_historyCycles;
+    }
+    if (history->run_cycles > g_historyCycles)
+    {
+        history->run_cycles = g_historyCycles;
+    }
+
+    while ((history->run_cycles + history->sleep_cycles) > g_historyCycles)
+    {
+        history->run_cycles   -= history->run_cycles >> 2;
+        history->sleep_cycles -= history->sleep_cycles >> 2;
+    }
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Derives the history length in cycles. It must stay well
+ *               below 2^31 so run + sleep cannot overflow.
+ */
+void interactivityInit(void)
+{
+    g_historyCycles = TICK_PROFILER_US_TO_CYCLES(INTERACTIVITY_HISTORY_MS * 1000U);
+
+    if (g_historyCycles > 0x40000000UL)
+    {
+        g_historyCycles = 0x40000000UL;
+    }
+}
+
+/*
+ * Description : Called from traceTASK_SWITCHED_IN.
+ */
+void interactivityTaskSwitchedIn(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot >= 0)
+    {
+        g_history[slot].stamp    = cycleCounterGet();
+        g_history[slot].sleeping = false;
+    }
+}
+
+/*
+ * Description : Called from traceTASK_SWITCHED_OUT. Preemption only adds
+ *               run time; blocking also starts the sleep clock.
+ */
+void interactivityTaskSwitchedOut(void *task, bool stillReady)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot < 0)
+    {
+        return;
+    }
+
+    InteractivityHistory_t *history = &g_history[slot];
+    uint32_t now = cycleCounterGet();
+
+    history->run_cycles += now - history->stamp;
+    decay(history);
+
+    if (!stillReady)
+    {
+        history->stamp    = now;
+        history->sleeping = true;
+    }
+}
+
+/*
+ * Description : Called from traceMOVED_TASK_TO_READY_STATE. Only a task
+ *               asleep since it blocked has sleep time to charge, so
+ *               priority moves of ready tasks are ignored. With block
+ *               reasons, a delay is charged at
+ *               INTERACTIVITY_DELAY_SLEEP_PERCENT.
+ */
+void interactivityTaskReady(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot < 0) || !g_history[slot].sleeping)
+    {
+        return;
+    }
+
+    InteractivityHistory_t *history = &g_history[slot];
+
+    uint32_t slept = cycleCounterGet() - history->stamp;
+
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U)
+    if (tickProfilerGetRecord((uint32_t)slot)->block_reason == TICK_PROFILER_BLOCK_DELAY)
+    {
+        slept = (uint32_t)(((uint64_t)slept * INTERACTIVITY_DELAY_SLEEP_PERCENT) / 100U);
+    }
+#endif
+
+    history->sleep_cycles += slept;
+    history->sleeping = false;
+    decay(history);
+}
+
+/*
+ * Description : ULE interactivity score: with more sleep than run it is
+ *               50 * run / sleep, otherwise 100 - 50 * sleep / run.
+ */
+uint32_t interactivityGetScore(uint32_t slot)
+{
+    uint32_t run;
+    uint32_t sleep;
+    const uint32_t half = INTERACTIVITY_SCORE_MAX / 2U;
+
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return half;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        run   = g_history[slot].run_cycles;
+        sleep = g_history[slot].sleep_cycles;
+    }
+    taskEXIT_CRITICAL();
+
+    if (sleep > run)
+    {
+        return (uint32_t)(((uint64_t)half * run) / sleep);
+    }
+    if (run > sleep)
+    {
+        return INTERACTIVITY_SCORE_MAX - (uint32_t)(((uint64_t)half * sleep) / run);
+    }
+
+    return half;
+}
+
+/*
+ * Description : Starts a slot with no history (neutral score).
+ */
+void interactivityResetTask(uint32_t slot)
+{
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        g_history[slot].run_cycles   = 0U;
+        g_history[slot].sleep_cycles = 0U;
+        g_history[slot].stamp        = cycleCounterGet();
+        g_history[slot].sleeping     = false;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Inverts the score into a run and sleep totalling at
+ *               most a quarter of the history, so real behaviour
+ *               outweighs the seed soon after the task starts running.
+ */
+void interactivitySeedTask(uint32_t slot, uint32_t score)
+{
+    const uint32_t half = INTERACTIVITY_SCORE_MAX / 2U;
+    uint32_t span = g_historyCycles / 4U;
+    uint32_t run;
+    uint32_t sleep;
+
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    if (score > INTERACTIVITY_SCORE_MAX)
+    {
+        score = INTERACTIVITY_SCORE_MAX;
+    }
+
+    if (score <= half)
+    {
+        sleep = span;
+        run   = (uint32_t)(((uint64_t)span * score) / half);
+    }
+    else
+    {
+        run   = span;
+        sleep = (uint32_t)(((uint64_t)span * (INTERACTIVITY_SCORE_MAX - score)) / half);
+    }
+
+    taskENTER_CRITICAL();
+    {
+        g_history[slot].run_cycles   = run;
+        g_history[slot].sleep_cycles = sleep;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* MLFQ_SCORE_CLASSIFIER_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *  MODULE NAME  : Priority Inversion Statistics
+ *  FILE         : inversion_stats.c
+ *  DESCRIPTION  : Times each episode in which a registered task holds a
+ *                 mutex on a priority inherited from a waiter, and keeps
+ *                 per-task episode counts, total and worst duration.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "inversion_stats.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if (INVERSION_STATS_ENABLED == 1U)
+
+#if (configUSE_MUTEXES != 1)
+#error "INVERSION_STATS_ENABLED needs configUSE_MUTEXES"
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Totals per profiler slot, written from the kernel hooks only */
+static InversionSummary_t g_summaries[TICK_PROFILER_MAX_TASKS];
+
+/* Episode in progress per profiler slot */
+static uint32_t g_startCycles[TICK_PROFILER_MAX_TASKS];
+static bool g_inherited[TICK_PROFILER_MAX_TASKS];
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from traceTASK_PRIORITY_INHERIT with the kernel
+ *               lists locked. A holder raised again by a higher waiter
+ *               stays in the episode it is already in.
+ */
+void inversionTaskInherited(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot >= 0) && !g_inherited[slot])
+    {
+        g_startCycles[slot] = cycleCounterGet();
+        g_inherited[slot]   = true;
+    }
+}
+
+/*
+ * Description : Called from traceTASK_PRIORITY_DISINHERIT. A waiter that
+ *               times out may only lower the holder to the next inherited
+ *               priority, which does not end the episode.
+ */
+void inversionTaskDisinherited(void *task, bool restored)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot < 0) || !restored || !g_inherited[slot])
+    {
+        return;
+    }
+
+    uint32_t cycles = cycleCounterGet() - g_startCycles[slot];
+    InversionSummary_t *summary = &g_summaries[slot];
+
+    g_inherited[slot] = false;
+    summary->episodes++;
+    summary->total_cycles += cycles;
+    if (cycles > summary->max_cycles)
+    {
+        summary->max_cycles = cycles;
+    }
+}
+
+/*
+ * Description : Takes a consistent copy of the totals of a profiler slot.
+ */
+bool inversionGetTaskSummary(uint32_t slot, InversionSummary_t *output)
+{
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (output == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *output = g_summaries[slot];
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/*
+ * Description : Clears the per-task state of a profiler slot.
+ */
+void inversionResetTask(uint32_t slot)
+{
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        memset(&g_summaries[slot], 0, sizeof(g_summaries[slot]));
+        g_inherited[slot] = false;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* INVERSION_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
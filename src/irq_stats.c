@@ -0,0 +1,343 @@
+/******************************************************************************
+ *  MODULE NAME  : Interrupt Statistics
+ *  FILE         : irq_stats.c
+ *  DESCRIPTION  : Times instrumented interrupt handlers with the DWT cycle
+ *                 counter, keeping nested handlers out of the handler they
+ *                 interrupted, and keeps the running total the tick
+ *                 profiler subtracts from task quanta. Optionally holds
+ *                 application sources to a time budget per window.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "irq_stats.h"
+#include "cycle_counter.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (IRQ_STORM_ENABLED == 1U)
+#include "drivers.h"
+#endif
+
+#if (IRQ_STATS_ENABLED == 1U)
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : One handler in progress: when it started and how long the
+ *               handlers nested inside it have taken so far.
+ */
+typedef struct
+{
+    uint32_t start;
+    uint32_t nested;
+} IrqFrame_t;
+
+#if (IRQ_STORM_ENABLED == 1U)
+/*
+ * Description : Budget of one source and its spending in the current
+ *               window. 'masked' is set by the handler and cleared by
+ *               irqStormUnmask().
+ */
+typedef struct
+{
+    uint32_t budget_cycles;    /* 0 = no budget */
+    uint32_t irq;
+    TaskHandle_t handler;
+    uint32_t window_start;
+    uint32_t spent;
+    volatile bool masked;
+} IrqBudget_t;
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Handlers in progress, innermost last */
+static IrqFrame_t g_frames[IRQ_STATS_MAX_NESTING];
+static uint32_t g_depth = 0U;
+
+/* Per-source figures; the built-in sources are named up front */
+static IrqStats_t g_sources[IRQ_STATS_MAX_SOURCES] =
+{
+    [IRQ_STATS_SOURCE_UART0]   = { "IRQ UART0", 0U, 0U, 0U, 0U },
+    [IRQ_STATS_SOURCE_QUANTUM] = { "IRQ Timer", 0U, 0U, 0U, 0U },
+#if (IRQ_STATS_TICK_ENABLED == 1U)
+    [IRQ_STATS_SOURCE_TICK]    = { "IRQ Tick", 0U, 0U, 0U, 0U },
+#endif
+};
+
+/* Cycles spent in all handlers; wraps freely */
+static volatile uint32_t g_totalCycles = 0U;
+
+#if (IRQ_STORM_ENABLED == 1U)
+static IrqBudget_t g_budgets[IRQ_STATS_MAX_SOURCES];
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+#if (IRQ_STORM_ENABLED == 1U)
+/*
+ * Description : Charges a run to the source's budget. Windows are kept
+ *               per source and start at the first run after the last
+ *               one ended, so an idle source costs nothing. Past the
+ *               budget the interrupt is masked and the handler task
+ *               notified; the yield it may need is pended now and taken
+ *               when the outermost handler returns. Runs with the
+ *               kernel's interrupts masked.
+ */
+static void chargeBudget(uint32_t source, uint32_t own, uint32_t now)
+{
+    IrqBudget_t *budget = &g_budgets[source];
+    const uint32_t window = (configCPU_CLOCK_HZ / 1000U) * IRQ_STORM_WINDOW_MS;
+
+    if ((budget->budget_cycles == 0U) || budget->masked)
+    {
+        return;
+    }
+
+    if ((now - budget->window_start) >= window)
+    {
+        budget->window_start = now;
+        budget->spent = 0U;
+    }
+
+    budget->spent += own;
+    if (budget->spent <= budget->budget_cycles)
+    {
+        return;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    maskIrq(budget->irq);
+    budget->masked = true;
+    g_sources[source].storms++;
+
+    if (budget->handler != NULL)
+    {
+        vTaskNotifyGiveFromISR(budget->handler, &xHigherPriorityTaskWoken);
+    }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Pushes a frame for the handler being entered. Nesting
+ *               deeper than IRQ_STATS_MAX_NESTING is not timed; the
+ *               depth still counts so the exits pair up.
+ */
+void irqStatsEnter(void)
+{
+    UBaseType_t savedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    if (g_depth < IRQ_STATS_MAX_NESTING)
+    {
+        g_frames[g_depth].start  = cycleCounterGet();
+        g_frames[g_depth].nested = 0U;
+    }
+    g_depth++;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(savedMask);
+}
+
+/*
+ * Description : Pops the frame of the handler leaving, charges its own
+ *               time to the source and its whole time to the handler it
+ *               nested in, if any.
+ */
+void irqStatsExit(uint32_t source)
+{
+    UBaseType_t savedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    if (g_depth > 0U)
+    {
+        g_depth--;
+
+        if (g_depth < IRQ_STATS_MAX_NESTING)
+        {
+            IrqFrame_t *frame = &g_frames[g_depth];
+            uint32_t now = cycleCounterGet();
+            uint32_t elapsed = now - frame->start;
+            uint32_t own = (frame->nested < elapsed) ? (elapsed - frame->nested) : 0U;
+
+            if (g_depth > 0U)
+            {
+                g_frames[g_depth - 1U].nested += elapsed;
+            }
+
+            g_totalCycles += own;
+
+            if (source < IRQ_STATS_MAX_SOURCES)
+            {
+                IrqStats_t *stats = &g_sources[source];
+
+                stats->count++;
+                stats->total_cycles += own;
+                if (own > stats->max_cycles)
+                {
+                    stats->max_cycles = own;
+                }
+#if (IRQ_STORM_ENABLED == 1U)
+                chargeBudget(source, own, now);
+#endif
+            }
+        }
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(savedMask);
+}
+
+/*
+ * Description : Names a source. The string must outlive the reports.
+ */
+void irqStatsSetName(uint32_t source, const char *name)
+{
+    if (source < IRQ_STATS_MAX_SOURCES)
+    {
+        g_sources[source].name = name;
+    }
+}
+
+/*
+ * Description : Returns the handler cycles since boot, wrapping.
+ */
+uint32_t irqStatsGetCycles(void)
+{
+    return g_totalCycles;
+}
+
+/*
+ * Description : Copies the figures of one source.
+ */
+bool irqStatsGet(uint32_t source, IrqStats_t *output)
+{
+    if ((output == NULL) || (source >= IRQ_STATS_MAX_SOURCES))
+    {
+        return false;
+    }
+
+    UBaseType_t savedMask = portSET_INTERRUPT_MASK_FROM_ISR();
+    *output = g_sources[source];
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(savedMask);
+
+    return true;
+}
+
+#if (IRQ_STATS_TICK_ENABLED == 1U) && !defined(MLFQ_HOST_SIM)
+/* The port's SysTick handler (port.c); no kernel header declares it */
+extern void xPortSysTickHandler(void);
+
+/*
+ * Description : Runs the port's tick handler between the entry and exit
+ *               marks. SysTick has the lowest priority, so nothing the
+ *               tick handler masks can nest inside the timing; the
+ *               process stack the tick hook samples is not touched. The
+ *               host simulator ticks from a POSIX timer and has no
+ *               vector to point here.
+ */
+void SysTickIntHandler(void)
+{
+    IRQ_STATS_ENTER();
+    xPortSysTickHandler();
+    IRQ_STATS_EXIT(IRQ_STATS_SOURCE_TICK);
+}
+#endif
+
+#if (IRQ_STORM_ENABLED == 1U)
+/*
+ * Description : Sets or removes the budget of an application source.
+ *               The built-in sources have none: masking the quantum
+ *               timer would stop quantum enforcement, and the log UART
+ *               has no handler task. A source masked at the time is
+ *               unmasked.
+ */
+bool irqStormSetBudget(uint32_t source, uint32_t irq, uint32_t budgetUs,
+                       TaskHandle_t handler)
+{
+    if ((source < IRQ_STATS_FIRST_USER_SOURCE) || (source >= IRQ_STATS_MAX_SOURCES))
+    {
+        return false;
+    }
+
+    IrqBudget_t *budget = &g_budgets[source];
+    bool wasMasked;
+
+    taskENTER_CRITICAL();
+    {
+        wasMasked = budget->masked;
+
+        budget->budget_cycles = budgetUs * (configCPU_CLOCK_HZ / 1000000U);
+        budget->irq           = irq;
+        budget->handler       = handler;
+        budget->window_start  = cycleCounterGet();
+        budget->spent         = 0U;
+        budget->masked        = false;
+    }
+    taskEXIT_CRITICAL();
+
+    if (wasMasked)
+    {
+        unmaskIrq(irq);
+    }
+
+    return true;
+}
+
+/*
+ * Description : True while the source is masked for a storm.
+ */
+bool irqStormIsMasked(uint32_t source)
+{
+    return (source < IRQ_STATS_MAX_SOURCES) && g_budgets[source].masked;
+}
+
+/*
+ * Description : Unmasks a source after a storm, with a fresh window.
+ *               A source still chattering is masked again once it has
+ *               spent another budget, which holds it to about the budget
+ *               per window while its handler task gets CPU.
+ */
+void irqStormUnmask(uint32_t source)
+{
+    if (source >= IRQ_STATS_MAX_SOURCES)
+    {
+        return;
+    }
+
+    IrqBudget_t *budget = &g_budgets[source];
+    bool wasMasked;
+
+    taskENTER_CRITICAL();
+    {
+        wasMasked = budget->masked;
+        budget->window_start = cycleCounterGet();
+        budget->spent = 0U;
+        budget->masked = false;
+    }
+    taskEXIT_CRITICAL();
+
+    if (wasMasked)
+    {
+        unmaskIrq(budget->irq);
+    }
+}
+#endif
+
+#endif /* IRQ_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,281 @@
+/******************************************************************************
+ *  MODULE NAME  : Latency Statistics
+ *  FILE         : latency_stats.c
+ *  DESCRIPTION  : Measures how long a woken task waits in the ready list
+ *                 before it is switched in, and keeps log2-bucketed
+ *                 histograms of that latency per task and per MLFQ level.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "latency_stats.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+#include "scheduler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if (LATENCY_STATS_ENABLED == 1U)
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+typedef struct
+{
+    uint32_t counts[LATENCY_HIST_BUCKETS];
+    uint32_t samples;
+    uint32_t max_cycles;
+} LatencyHistogram_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Histograms, written from the context-switch hook only */
+static LatencyHistogram_t g_taskHistograms[TICK_PROFILER_MAX_TASKS];
+static LatencyHistogram_t g_levelHistograms[MLFQ_NUMBER_QUEUES];
+
+/* Wake bookkeeping per profiler slot */
+static uint32_t g_readyCycles[TICK_PROFILER_MAX_TASKS];
+static bool g_blocked[TICK_PROFILER_MAX_TASKS];
+static bool g_readyPending[TICK_PROFILER_MAX_TASKS];
+
+/* Declared targets and the samples that missed them, per profiler slot */
+static uint32_t g_targetCycles[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_misses[TICK_PROFILER_MAX_TASKS];
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Adds one latency sample to a histogram.
+ */
+static void addSample(LatencyHistogram_t *histogram, uint32_t cycles)
+{
+    uint32_t bucket = (cycles == 0U) ? 0U : (32U - (uint32_t)TICK_PROFILER_CLZ(cycles));
+
+    if (bucket >= LATENCY_HIST_BUCKETS)
+    {
+        bucket = LATENCY_HIST_BUCKETS - 1U;
+    }
+
+    histogram->counts[bucket]++;
+    histogram->samples++;
+    if (cycles > histogram->max_cycles)
+    {
+        histogram->max_cycles = cycles;
+    }
+}
+
+/*
+ * Description : Returns the upper bound of the bucket holding the sample
+ *               of the given rank (1-based), capped at the observed max.
+ */
+static uint32_t rankUpperBound(const LatencyHistogram_t *histogram, uint32_t rank)
+{
+    uint32_t seen = 0U;
+
+    for (uint32_t bucket = 0U; bucket < LATENCY_HIST_BUCKETS; bucket++)
+    {
+        seen += histogram->counts[bucket];
+
+        if (seen >= rank)
+        {
+            if ((bucket == 0U) || (bucket == (LATENCY_HIST_BUCKETS - 1U)))
+            {
+                return (bucket == 0U) ? 0U : histogram->max_cycles;
+            }
+
+            uint32_t bound = (1UL << bucket) - 1U;
+            return (bound < histogram->max_cycles) ? bound : histogram->max_cycles;
+        }
+    }
+
+    return histogram->max_cycles;
+}
+
+/*
+ * Description : Takes a consistent copy of a histogram and summarises it.
+ */
+static void summarise(const LatencyHistogram_t *source, LatencySummary_t *output)
+{
+    LatencyHistogram_t copy;
+
+    taskENTER_CRITICAL();
+    {
+        copy = *source;
+    }
+    taskEXIT_CRITICAL();
+
+    output->samples       = copy.samples;
+    output->max_cycles    = copy.max_cycles;
+    output->target_cycles = 0U;
+    output->misses        = 0U;
+
+    if (copy.samples == 0U)
+    {
+        output->p50_cycles = 0U;
+        output->p99_cycles = 0U;
+        return;
+    }
+
+    output->p50_cycles = rankUpperBound(&copy, (copy.samples + 1U) / 2U);
+    output->p99_cycles = rankUpperBound(&copy, copy.samples -
+                                               (copy.samples / 100U));
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from traceTASK_SWITCHED_OUT. A task that is no
+ *               longer in its ready list has blocked or suspended, so its
+ *               next move to the ready list is a wake-up. Preemption and
+ *               priority changes of ready tasks are therefore not counted.
+ */
+void latencyTaskSwitchedOut(void *task, bool stillReady)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot >= 0)
+    {
+        g_blocked[slot] = !stillReady;
+    }
+}
+
+/*
+ * Description : Called from traceMOVED_TASK_TO_READY_STATE, from task
+ *               or ISR context with the kernel lists locked.
+ */
+void latencyTaskReady(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot >= 0) && g_blocked[slot] && !g_readyPending[slot])
+    {
+        g_readyCycles[slot]  = cycleCounterGet();
+        g_readyPending[slot] = true;
+        g_blocked[slot]      = false;
+    }
+}
+
+/*
+ * Description : Called from traceTASK_SWITCHED_IN. Charges the time
+ *               since the wake-up to the task and to its current level,
+ *               and counts a miss if the task has a target it exceeded.
+ */
+void latencyTaskSwitchedIn(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot < 0) || !g_readyPending[slot])
+    {
+        return;
+    }
+
+    uint32_t latency = cycleCounterGet() - g_readyCycles[slot];
+    g_readyPending[slot] = false;
+
+    addSample(&g_taskHistograms[slot], latency);
+
+    if ((g_targetCycles[slot] != 0U) && (latency > g_targetCycles[slot]))
+    {
+        g_misses[slot]++;
+    }
+
+    uint8_t level = tickProfilerGetRecord((uint32_t)slot)->level;
+    if (level < MLFQ_NUMBER_QUEUES)
+    {
+        addSample(&g_levelHistograms[level], latency);
+    }
+}
+
+/*
+ * Description : Summarises the latency histogram of a profiler slot.
+ */
+bool latencyGetTaskSummary(uint32_t slot, LatencySummary_t *output)
+{
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (output == NULL))
+    {
+        return false;
+    }
+
+    summarise(&g_taskHistograms[slot], output);
+
+    taskENTER_CRITICAL();
+    {
+        output->target_cycles = g_targetCycles[slot];
+        output->misses        = g_misses[slot];
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/*
+ * Description : Summarises the latency histogram of an MLFQ level.
+ */
+bool latencyGetLevelSummary(uint32_t level, LatencySummary_t *output)
+{
+    if ((level >= MLFQ_NUMBER_QUEUES) || (output == NULL))
+    {
+        return false;
+    }
+
+    summarise(&g_levelHistograms[level], output);
+    return true;
+}
+
+/*
+ * Description : Sets the target the wake-to-run latency of a slot is
+ *               checked against. Misses are counted from now on.
+ */
+void latencySetTarget(uint32_t slot, uint32_t targetCycles)
+{
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        g_targetCycles[slot] = targetCycles;
+        g_misses[slot]       = 0U;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Clears the per-task state of a profiler slot, the
+ *               latency target included.
+ */
+void latencyResetTask(uint32_t slot)
+{
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        memset(&g_taskHistograms[slot], 0, sizeof(g_taskHistograms[slot]));
+        g_blocked[slot]      = false;
+        g_readyPending[slot] = false;
+        g_targetCycles[slot] = 0U;
+        g_misses[slot]       = 0U;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* LATENCY_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,223 @@
+/******************************************************************************
+ *  MODULE NAME  : Log Format
+ *  FILE         : log_format.c
+ *  DESCRIPTION  : Small fixed-width formatter for report lines. Uses a
+ *                 handful of stack bytes per call instead of the libc
+ *                 printf engine.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "log_format.h"
+#include "drivers.h"
+
+#include <stddef.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Digits in the largest uint32_t */
+#define LOG_FORMAT_MAX_DIGITS    10U
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Appends one character if it fits, keeping the text
+ *               terminated.
+ */
+static void putChar(LogLine_t *line, char character)
+{
+    if ((line->length + 1U) < line->size)
+    {
+        line->buffer[line->length++] = character;
+        line->buffer[line->length] = '\0';
+    }
+}
+
+/*
+ * Description : Appends 'count' copies of a character.
+ */
+static void putRepeated(LogLine_t *line, char character, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        putChar(line, character);
+    }
+}
+
+/*
+ * Description : Writes the decimal digits of a value, least significant
+ *               first, and returns how many there are.
+ */
+static uint32_t toDecimal(uint32_t value, char digits[LOG_FORMAT_MAX_DIGITS])
+{
+    uint32_t count = 0U;
+
+    do
+    {
+        digits[count++] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+
+    return count;
+}
+
+/*
+ * Description : Appends digits produced by toDecimal(), padded on the
+ *               left with 'pad' up to 'width' characters in all, the
+ *               optional sign included.
+ */
+static void putDigits(LogLine_t *line, const char *digits, uint32_t count,
+                      char sign, char pad, uint32_t width)
+{
+    uint32_t used = count + ((sign != '\0') ? 1U : 0U);
+
+    if ((pad == '0') && (sign != '\0'))
+    {
+        putChar(line, sign);
+    }
+    if (width > used)
+    {
+        putRepeated(line, pad, width - used);
+    }
+    if ((pad != '0') && (sign != '\0'))
+    {
+        putChar(line, sign);
+    }
+
+    while (count > 0U)
+    {
+        putChar(line, digits[--count]);
+    }
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Starts an empty line.
+ */
+void logLineInit(LogLine_t *line, char *buffer, uint32_t size)
+{
+    line->buffer = buffer;
+    line->size   = size;
+    line->length = 0U;
+    buffer[0]    = '\0';
+}
+
+/*
+ * Description : Appends a string.
+ */
+void logPutText(LogLine_t *line, const char *text)
+{
+    if (text == NULL)
+    {
+        return;
+    }
+
+    while (*text != '\0')
+    {
+        putChar(line, *text++);
+    }
+}
+
+/*
+ * Description : Appends a string and pads it to 'width'. Longer strings
+ *               are kept whole, as with %-Ns.
+ */
+void logPutField(LogLine_t *line, const char *text, uint32_t width)
+{
+    uint32_t start = line->length;
+
+    logPutText(line, text);
+
+    if ((line->length - start) < width)
+    {
+        putRepeated(line, ' ', width - (line->length - start));
+    }
+}
+
+/*
+ * Description : Appends an unsigned decimal padded with spaces.
+ */
+void logPutUnsigned(LogLine_t *line, uint32_t value, uint32_t width)
+{
+    char digits[LOG_FORMAT_MAX_DIGITS];
+    uint32_t count = toDecimal(value, digits);
+
+    putDigits(line, digits, count, '\0', ' ', width);
+}
+
+/*
+ * Description : Appends an unsigned decimal padded with zeros.
+ */
+void logPutUnsignedZero(LogLine_t *line, uint32_t value, uint32_t digits)
+{
+    char text[LOG_FORMAT_MAX_DIGITS];
+    uint32_t count = toDecimal(value, text);
+
+    putDigits(line, text, count, '\0', '0', digits);
+}
+
+/*
+ * Description : Appends a signed decimal padded with spaces.
+ */
+void logPutSigned(LogLine_t *line, int32_t value, uint32_t width)
+{
+    char digits[LOG_FORMAT_MAX_DIGITS];
+    /* Negated in unsigned arithmetic, so INT32_MIN works too */
+    uint32_t magnitude = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+    uint32_t count = toDecimal(magnitude, digits);
+
+    putDigits(line, digits, count, (value < 0) ? '-' : '\0', ' ', width);
+}
+
+/*
+ * Description : Appends a value in hex, at least 'digits' wide.
+ */
+void logPutHex(LogLine_t *line, uint32_t value, uint32_t digits)
+{
+    static const char hex[] = "0123456789abcdef";
+    char text[8];
+    uint32_t count = 0U;
+
+    do
+    {
+        text[count++] = hex[value & 0xFU];
+        value >>= 4;
+    } while (value != 0U);
+
+    putDigits(line, text, count, '\0', '0', digits);
+}
+
+/*
+ * Description : Queues the line and starts it again from empty.
+ */
+uint32_t logLineSend(LogLine_t *line)
+{
+    return logLineSendChannel(line, LOG_CHANNEL_REPORT);
+}
+
+/*
+ * Description : Sends the line on a channel and starts it again from empty.
+ */
+uint32_t logLineSendChannel(LogLine_t *line, uint32_t channel)
+{
+    uint32_t queued = sendLogChannel(channel, line->buffer, line->length);
+
+    line->length = 0U;
+    line->buffer[0] = '\0';
+
+    return queued;
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
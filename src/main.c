@@ -19,6 +19,25 @@
 #include "scheduler.h"      /* MLFQ Logic */
 #include "workloads.h"      /* Simulation Tasks (Heavy/Interactive) */
 #include "metrics_logger.h" /* Logging Utilities */
+#include "console.h"        /* UART Command Console */
+#include "can_telemetry.h"  /* CAN Fleet Telemetry */
+#include "flight_recorder.h" /* Retained Scheduler History */
+#include "tick_profiler.h"  /* Boot Time */
+#include "log_format.h"     /* Banner Formatting */
+
+/******************************************************************************
+ * MACRO DEFINITIONS
+ ******************************************************************************/
+/* Stack depths in words of the tasks without a module default */
+#define MAIN_WORKLOAD_STACK_SIZE    256U
+#define MAIN_SCHEDULER_STACK_SIZE   256U
+
+/* Static storage of a task, dropped when tasks come from the heap */
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+#define MAIN_TASK_STORAGE(stack, tcb)   (stack), (tcb)
+#else
+#define MAIN_TASK_STORAGE(stack, tcb)   NULL, NULL
+#endif
 
 /******************************************************************************
  * GLOBAL VARIABLES
@@ -32,12 +51,76 @@ TaskHandle_t hTask4_Interactive = NULL;
 /* Scheduler Management Task Handle */
 TaskHandle_t hSchedulerTask     = NULL;
 
+/* Report Logger Task Handle */
+TaskHandle_t hLoggerTask        = NULL;
+
+/* Command Console Task Handle */
+TaskHandle_t hConsoleTask       = NULL;
+
+/* CAN Telemetry Task Handle */
+TaskHandle_t hCanTelemetryTask  = NULL;
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/* TCBs and stacks of every task created below, sized at link time */
+static StaticTask_t g_workloadTcb[4];
+static StackType_t  g_workloadStack[4][MAIN_WORKLOAD_STACK_SIZE];
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 0)
+static StaticTask_t g_schedulerTcb;
+static StackType_t  g_schedulerStack[MAIN_SCHEDULER_STACK_SIZE];
+#endif
+#if (METRICS_REPORT_ENABLED == 1U)
+static StaticTask_t g_loggerTcb;
+static StackType_t  g_loggerStack[METRICS_LOGGER_STACK_SIZE];
+#endif
+#if (CONSOLE_ENABLED == 1U)
+static StaticTask_t g_consoleTcb;
+static StackType_t  g_consoleStack[CONSOLE_STACK_SIZE];
+#endif
+#if (CAN_TELEMETRY_ENABLED == 1U)
+static StaticTask_t g_canTelemetryTcb;
+static StackType_t  g_canTelemetryStack[CAN_TELEMETRY_STACK_SIZE];
+#endif
+#endif
+
+/******************************************************************************
+ * STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Creates a task in the given static storage, or from the
+ *               heap when static allocation is disabled (stack and tcb
+ *               are then NULL).
+ */
+static void createTask(TaskFunction_t function, const char *name,
+                       uint32_t stackDepth, void *parameter,
+                       UBaseType_t priority, StackType_t *stack,
+                       StaticTask_t *tcb, TaskHandle_t *handle)
+{
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    *handle = xTaskCreateStatic(function, name, stackDepth, parameter,
+                                priority, stack, tcb);
+#else
+    (void)stack;
+    (void)tcb;
+    (void)xTaskCreate(function, name, (configSTACK_DEPTH_TYPE)stackDepth,
+                      parameter, priority, handle);
+#endif
+}
+
 /******************************************************************************
  * FUNCTION DEFINITIONS
  ******************************************************************************/
 
 int main(void)
 {
+    char text[64];
+    LogLine_t line;
+
+    /* Run from the PLL; everything below derives from this clock */
+    initClock();
+
+    /* Time the rest of the boot with the cycle counter */
+    tickProfilerBootStart();
 
     /* Initialize UART for logging (Baud: 115200) */
     initUART();
@@ -45,72 +128,152 @@ int main(void)
     /* Initialize RGB LEDs for visual feedback (Red/Green/Blue) */
     initGPIO();
 
-    /* Send boot banner */
+    /* Send boot banner. sendLog() only queues; the UART interrupt sends
+     * it once the kernel runs, so nothing here waits on the wire */
     sendLog("\n\n");
     sendLog("************************************************\r\n");
     sendLog("* MLFQ SCHEDULER PROJECT START          *\r\n");
     sendLog("* Target: Tiva-C (TM4C123G)             *\r\n");
+    logLineInit(&line, text, sizeof(text));
+    logPutText(&line, "* Clock : ");
+    logPutUnsigned(&line, (uint32_t)(configCPU_CLOCK_HZ / 1000000UL), 3U);
+    logPutText(&line, " MHz                       *\r\n");
+    logLineSend(&line);
     sendLog("************************************************\r\n");
 
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    /* Print what the last boot left behind, before any kernel call */
+    flightRecorderInit();
+#endif
+
     /* Initialize internal tables and Tick Profiler */
     initScheduler();
 
+    /* Calibrate the workload busy loop against the cycle counter */
+    initWorkloads();
+
+    /* Each workload is created and registered in one step, so it starts
+     * at the MLFQ High level with its runtime tracked from the first tick */
+
     /* TASK 1: Interactive (Should stay High Priority / Green LED) */
-    xTaskCreate(runInteractiveTask,         /* Function */
-                "Interact_1",               /* Name */
-                256,                        /* Stack Size */
-                (void*)"Interact_1",        /* Parameter */
-                MLFQ_TOP_PRIORITY_NUMBER,   /* Initial Priority (Must match MLFQ High) */
-                &hTask1_Interactive);       /* Handle Storage */
+    hTask1_Interactive = schedulerCreateTask(
+               runInteractiveTask,          /* Function */
+               "Interact_1",                /* Name */
+               MAIN_WORKLOAD_STACK_SIZE,    /* Stack Size */
+               (void*)"Interact_1",         /* Parameter */
+               MAIN_TASK_STORAGE(g_workloadStack[0], &g_workloadTcb[0])); /* Static Storage */
 
     /* TASK 2: CPU Heavy (Should drop to Low Priority / Red LED) */
-    xTaskCreate(runCPUHeavyTask,
-                "Heavy_2",
-                256,
-                (void*)"Heavy_2",
-                MLFQ_TOP_PRIORITY_NUMBER,
-                &hTask2_Heavy);
+    hTask2_Heavy = schedulerCreateTask(
+               runCPUHeavyTask,
+               "Heavy_2",
+               MAIN_WORKLOAD_STACK_SIZE,
+               (void*)"Heavy_2",
+               MAIN_TASK_STORAGE(g_workloadStack[1], &g_workloadTcb[1]));
 
     /* TASK 3: CPU Heavy (Should drop to Low Priority / Red LED) */
-    xTaskCreate(runCPUHeavyTask,
-                "Heavy_3",
-                256,
-                (void*)"Heavy_3",
-                MLFQ_TOP_PRIORITY_NUMBER,
-                &hTask3_Heavy);
+    hTask3_Heavy = schedulerCreateTask(
+               runCPUHeavyTask,
+               "Heavy_3",
+               MAIN_WORKLOAD_STACK_SIZE,
+               (void*)"Heavy_3",
+               MAIN_TASK_STORAGE(g_workloadStack[2], &g_workloadTcb[2]));
 
     /* TASK 4: Interactive (Should stay High Priority / Green LED) */
-    xTaskCreate(runInteractiveTask,
-                "Interact_4",
-                256,
-                (void*)"Interact_4",
-                MLFQ_TOP_PRIORITY_NUMBER,
-                &hTask4_Interactive);
+    hTask4_Interactive = schedulerCreateTask(
+               runInteractiveTask,
+               "Interact_4",
+               MAIN_WORKLOAD_STACK_SIZE,
+               (void*)"Interact_4",
+               MAIN_TASK_STORAGE(g_workloadStack[3], &g_workloadTcb[3]));
 
-    /* This tells the scheduler to start tracking these tasks' runtimes */
-    registerTask(hTask1_Interactive);
-    registerTask(hTask2_Heavy);
-    registerTask(hTask3_Heavy);
-    registerTask(hTask4_Interactive);
-
-    sendLog("[System] Workload tasks created and registered.\r\n");
+    if ((hTask1_Interactive == NULL) || (hTask2_Heavy == NULL) ||
+        (hTask3_Heavy == NULL) || (hTask4_Interactive == NULL))
+    {
+        sendLog("[System] A workload task could not be created.\r\n");
+    }
+    else
+    {
+        sendLog("[System] Workload tasks created and registered.\r\n");
+    }
 
     /* * Scheduler Task: Manages Demotion and Global Boosts.
      * PRIORITY: Must be higher than the highest MLFQ queue so it can interrupt!
-     * STACK: Large (512 or 1024) because it calls printQueueReport() -> snprintf().
+     * STACK: Small, it only copies report snapshots for the logger task.
+     * With configUSE_MLFQ_TIMER_SUPERVISOR it runs in the timer service
+     * task instead, which already has the supervisor priority.
+     */
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+    if (!schedulerStartTimerSupervisor())
+    {
+        sendLog("[System] Supervisor timer could not be created.\r\n");
+    }
+#else
+    createTask(schedulerTask,
+               "Scheduler",
+               MAIN_SCHEDULER_STACK_SIZE,
+               NULL,
+               MLFQ_SUPERVISOR_PRIORITY,    /* Above every MLFQ level */
+               MAIN_TASK_STORAGE(g_schedulerStack, &g_schedulerTcb),
+               &hSchedulerTask);
+#endif
+
+    /* * Logger Task: Formats and sends the reports over UART.
+     * PRIORITY: Below every MLFQ level, never registered with the MLFQ.
+     * STACK: METRICS_LOGGER_STACK_SIZE; lines use log_format.h, not snprintf().
+     */
+#if (METRICS_REPORT_ENABLED == 1U)
+    createTask(metricsLoggerTask,
+               "Logger",
+               METRICS_LOGGER_STACK_SIZE,
+               NULL,
+               METRICS_LOGGER_PRIORITY,
+               MAIN_TASK_STORAGE(g_loggerStack, &g_loggerTcb),
+               &hLoggerTask);
+#endif
+
+#if (CONSOLE_ENABLED == 1U)
+    /* * Console Task: Parses UART0 commands (type "help").
+     * PRIORITY: Same as the logger; parameter changes are applied by the
+     * Scheduler Task, so the console itself needs no urgency.
+     */
+    createTask(consoleTask,
+               "Console",
+               CONSOLE_STACK_SIZE,
+               NULL,
+               CONSOLE_TASK_PRIORITY,
+               MAIN_TASK_STORAGE(g_consoleStack, &g_consoleTcb),
+               &hConsoleTask);
+#endif
+
+#if (CAN_TELEMETRY_ENABLED == 1U)
+    /* * CAN Telemetry Task: Publishes this board's summary on CAN0 and,
+     * on the collector, prints the fleet table.
+     * PRIORITY: Same as the logger; a late summary costs nothing.
      */
-    xTaskCreate(schedulerTask,
-                "Scheduler",
-                512,                       /* Stack size increased for safe printing */
-                NULL,
-                MLFQ_TOP_PRIORITY_NUMBER + 1, /* Highest priority in system */
-                &hSchedulerTask);
+    createTask(canTelemetryTask,
+               "CanTelem",
+               CAN_TELEMETRY_STACK_SIZE,
+               NULL,
+               CAN_TELEMETRY_PRIORITY,
+               MAIN_TASK_STORAGE(g_canTelemetryStack, &g_canTelemetryTcb),
+               &hCanTelemetryTask);
+#endif
 
     /* ---------------------------------------------------------------------
      * 6. Start the Kernel
      * --------------------------------------------------------------------- */
     sendLog("[System] Starting FreeRTOS Scheduler...\r\n");
 
+    /* Boot time up to the kernel start, queued like the banner */
+    tickProfilerBootEnd();
+    logLineInit(&line, text, sizeof(text));
+    logPutText(&line, "[System] Boot: ");
+    logPutUnsigned(&line, tickProfilerGetBootCycles() /
+                   (uint32_t)(configCPU_CLOCK_HZ / 1000000UL), 0U);
+    logPutText(&line, " us from clock setup to kernel start\r\n");
+    logLineSend(&line);
+
     /* Set LED to White (All On) briefly to indicate start */
     // Note: You can add a specific LED pattern here if desired
 
@@ -11,68 +11,2646 @@
 #include "drivers.h"        // For sendLog()
 #include "scheduler.h"      // For MLFQ definitions and getter
 #include "tick_profiler.h"  // For getTaskRuntime()
+#include "latency_stats.h"  // For latency summaries
+#include "inversion_stats.h" // For priority inversion totals
+#include "wait_stats.h"     // For blocking wait totals
+#include "pc_sampler.h"     // For the PC sample histograms
+#include "state_time.h"     // For running / ready / blocked time
+#include "stack_stats.h"    // For stack high-water marks
+#include "heap_stats.h"     // For heap usage
+#include "irq_stats.h"      // For interrupt handler time
+#include "timer_stats.h"    // For timer daemon callback time
+#include "log_format.h"     // For the text report lines
+#include "flight_recorder.h" // For the retained snapshot
+#include "flash_log.h"      // For the flash history records
 
-#include <stdio.h>
 #include <string.h>
 
-/* Helper buffer size for log messages */
+#if (METRICS_REPORT_ENABLED == 1U)
+
+#if (METRICS_BINARY_LOG_ENABLED == 1U)
+#include "TivaWare/driverlib/sw_crc.h"  // For Crc16()
+#endif
+
+/* Core cycles per microsecond and millisecond for the cycle-timed figures */
+#define METRICS_CYCLES_PER_US     (configCPU_CLOCK_HZ / 1000000U)
+#define METRICS_CYCLES_PER_MS     (configCPU_CLOCK_HZ / 1000U)
+
+/* Keeps the record copy ordered before publishing the new ring index */
+#ifndef METRICS_MEMORY_BARRIER
+#define METRICS_MEMORY_BARRIER()  __asm(" dmb")
+#endif
+
+/* Result buffer of the non-reentrant formatStatsLog() only */
 static char g_logBuffer[LOG_BUFFER_SIZE];
 
+/* Single-producer (supervisor) / single-consumer (logger task) ring.
+ * Indices run freely and are masked on access. */
+typedef struct
+{
+    MetricsRecord_t *record;
+    uint32_t mask;                  // Length - 1, a power of two
+    volatile uint32_t head;         // Written by the producer only
+    volatile uint32_t tail;         // Written by the consumer only
+} MetricsRing_t;
+
+static MetricsRecord_t g_snapshotRecords[METRICS_SNAPSHOT_RING_LENGTH];
+static MetricsRing_t g_snapshotRing =
+    { g_snapshotRecords, METRICS_SNAPSHOT_RING_LENGTH - 1U, 0U, 0U };
+static volatile uint32_t g_snapshotsDropped = 0U;
+
+#if (METRICS_BUDGET_ENABLED == 1U)
+/* Event records bypass the report ring so a backlog of rows held back by
+ * the budget never delays them */
+static MetricsRecord_t g_eventRecords[METRICS_EVENT_RING_LENGTH];
+static MetricsRing_t g_eventRing =
+    { g_eventRecords, METRICS_EVENT_RING_LENGTH - 1U, 0U, 0U };
+#endif
+
+/* Sections sent after the queue table of a report (see g_reportParts) */
+#define METRICS_REPORT_PARTS      13U
+
+/* Next section of the current report still to be sent (logger task only) */
+static uint32_t g_reportPart = METRICS_REPORT_PARTS;
+
+/* Logger task handle, notified whenever snapshots are queued */
+static TaskHandle_t g_loggerTaskHandle = NULL;
+
+/* Whole-table copy taken by printQueueReport (supervisor only) */
+static MLFQ_StatsSnapshot_t g_reportSnapshot;
+
+/* Lifetime CPU time counters as of the latest report (logger task only) */
+static TickProfilerCpuTime_t g_cpuLast;
+static TickType_t g_cpuLastTick = 0U;
+static uint64_t g_cpuLastTask[TICK_PROFILER_MAX_TASKS];
+static TickType_t g_cpuLastArrival[TICK_PROFILER_MAX_TASKS];
+
+#if (MLFQ_GROUPS_ENABLED == 1U)
+/* CPU time of each task group: this window's and the total reported so
+ * far, built from the members' windows */
+static uint64_t g_groupWindow[MLFQ_MAX_GROUPS];
+static uint64_t g_groupTotal[MLFQ_MAX_GROUPS];
+#endif
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+/* CPU time of each partition, built the same way */
+static uint64_t g_partitionWindow[MLFQ_MAX_PARTITIONS];
+static uint64_t g_partitionTotal[MLFQ_MAX_PARTITIONS];
+#endif
+
+/* Scheduler self-metrics and the tick at the previous report's footer
+ * (logger task only) */
+static MLFQ_SelfMetrics_t g_selfLast;
+static TickType_t g_selfLastTick = 0U;
+
+/* CPU time used in the current window, refreshed by takeCpuWindow() */
+static TickProfilerCpuTime_t g_cpuWindow;
+static uint64_t g_cpuWindowTotal = 0U;
+static uint32_t g_cpuWindowTicks = 0U;
+
+#if (TICK_PROFILER_CORES > 1U)
+/* Idle time of each core in the current window, and at the last report */
+static uint64_t g_coreIdleWindow[TICK_PROFILER_CORES];
+static uint64_t g_coreIdleLast[TICK_PROFILER_CORES];
+#endif
+
+#if (METRICS_DIFF_REPORT_ENABLED == 1U)
+/* Each slot's row as last sent (supervisor only); a new arrival tick means
+ * the slot was reused and the row is always sent */
+typedef struct
+{
+    uint32_t arrival_tick;
+    uint32_t run_bucket;
+    uint32_t wait_ticks;
+    uint8_t  level;
+    bool     sent;
+} MetricsSentRow_t;
+
+static MetricsSentRow_t g_sentRow[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_reportsSinceKeyframe = 0U;
+#endif
+
+#if (IRQ_STATS_ENABLED == 1U)
+/* Handler time per interrupt source, in profiler units like g_cpuLast */
+static uint64_t g_irqLast[IRQ_STATS_MAX_SOURCES];
+static uint64_t g_irqWindow[IRQ_STATS_MAX_SOURCES];
+#endif
+
+/*
+ * Description : Copies one record into its ring and wakes the logger.
+ * Drops the record (and counts it) when the ring is full.
+ */
+static void pushSnapshot(const MetricsRecord_t *record)
+{
+    MetricsRing_t *ring = &g_snapshotRing;
+
+#if (METRICS_BUDGET_ENABLED == 1U)
+    if ((record->type == METRICS_RECORD_LEVEL_CHANGE) ||
+        (record->type == METRICS_RECORD_BOOST) ||
+        (record->type == METRICS_RECORD_OVERLOAD) ||
+        (record->type == METRICS_RECORD_DEGRADED) ||
+        (record->type == METRICS_RECORD_WATCHDOG))
+    {
+        ring = &g_eventRing;
+    }
+#endif
+
+    uint32_t head = ring->head;
+
+    if ((head - ring->tail) > ring->mask)
+    {
+        g_snapshotsDropped++;
+        return;
+    }
+
+    ring->record[head & ring->mask] = *record;
+    METRICS_MEMORY_BARRIER();
+    ring->head = head + 1U;
+
+    if (g_loggerTaskHandle != NULL)
+    {
+        xTaskNotifyGive(g_loggerTaskHandle);
+    }
+}
+
+/*
+ * Description : Takes the oldest record out of a ring, if any.
+ */
+static bool popSnapshot(MetricsRing_t *ring, MetricsRecord_t *record)
+{
+    uint32_t tail = ring->tail;
+
+    if (tail == ring->head)
+    {
+        return false;
+    }
+
+    METRICS_MEMORY_BARRIER();
+    *record = ring->record[tail & ring->mask];
+    METRICS_MEMORY_BARRIER();
+    ring->tail = tail + 1U;
+
+    return true;
+}
+
+/*
+ * Description : Fills a TASK_STATS record from a stats snapshot.
+ */
+static void fillStatsRecord(MetricsRecord_t *record, uint32_t slot,
+                            const MLFQ_Task_Profiler_t *stats)
+{
+    uint32_t currentTick = xTaskGetTickCount();
+    uint32_t totalTimeAlive = currentTick - stats->arrival_tick;
+
+    record->type          = METRICS_RECORD_TASK_STATS;
+    record->task_id       = (uint8_t)slot;
+    record->level         = (uint8_t)stats->task_level;
+    record->prev_level    = (uint8_t)stats->task_level;
+    record->timestamp     = currentTick;
+    record->run_ticks     = stats->task_info.run_ticks;
+    record->quantum_ticks = stats->task_info.quantum_ticks;
+    record->arrival_tick  = stats->arrival_tick;
+    record->wait_ticks    = (totalTimeAlive > stats->task_info.run_ticks) ?
+                            (totalTimeAlive - stats->task_info.run_ticks) : 0U;
+}
+
+/*
+ * Description : Returns the name of the task in a profiler slot.
+ */
+static const char *slotTaskName(uint32_t slot)
+{
+    TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+    return (info != NULL) ? pcTaskGetName(info->task) : "?";
+}
+
+#if (WAIT_STATS_ENABLED == 1U)
+/*
+ * Description : Copies the wait entry with the most time blocked that is
+ * not yet in 'taken', and marks it. Returns false when none is left.
+ */
+static bool nextTopWait(uint32_t *taken, WaitStatsEntry_t *output)
+{
+    WaitStatsEntry_t entry;
+    uint32_t best = WAIT_STATS_MAX_ENTRIES;
+
+    for (uint32_t i = 0U; i < WAIT_STATS_MAX_ENTRIES; i++)
+    {
+        if (((*taken & (1UL << i)) == 0U) && waitStatsGetEntry(i, &entry) &&
+            (entry.waits > 0U) &&
+            ((best == WAIT_STATS_MAX_ENTRIES) || (entry.total_cycles > output->total_cycles)))
+        {
+            *output = entry;
+            best = i;
+        }
+    }
+
+    if (best == WAIT_STATS_MAX_ENTRIES)
+    {
+        return false;
+    }
+
+    *taken |= (1UL << best);
+    return true;
+}
+#endif
+
+#if (PC_SAMPLER_ENABLED == 1U)
+/* No PC sampler bucket left to report */
+#define PC_SAMPLER_NONE    (PC_SAMPLER_OUTSIDE + 1U)
+
+/*
+ * Description : Returns the bucket of a PC sampler row with the most
+ * samples that is not yet in 'taken', and marks it, or PC_SAMPLER_NONE
+ * when no bucket with samples is left.
+ */
+
+static uint32_t nextTopBucket(uint32_t row, uint64_t *taken)
+{
+    uint32_t best = PC_SAMPLER_NONE;
+    uint32_t bestCount = 0U;
+
+    for (uint32_t bucket = 0U; bucket <= PC_SAMPLER_OUTSIDE; bucket++)
+    {
+        uint32_t count = pcSamplerGetCount(row, bucket);
+
+        if (((*taken & (1ULL << bucket)) == 0U) && (count > bestCount))
+        {
+            best = bucket;
+            bestCount = count;
+        }
+    }
+
+    if (best != PC_SAMPLER_NONE)
+    {
+        *taken |= (1ULL << best);
+    }
+    return best;
+}
+
+/*
+ * Description : Returns the PC sampler row at a position: the active
+ * profiler slots, then the unmanaged row.
+ */
+static uint32_t pcSamplerRow(uint32_t position)
+{
+    return (position < tickProfilerGetActiveCount()) ?
+           tickProfilerGetActiveSlot(position) : PC_SAMPLER_UNMANAGED;
+}
+#endif
+
+/*
+ * Description : Closes the CPU window at the current report: the usage of
+ * every consumer since the previous report goes into g_cpuWindow, their
+ * sum (the whole CPU) into g_cpuWindowTotal, and the lifetime counters
+ * into g_cpuLast.
+ */
+static void takeCpuWindow(void)
+{
+    TickProfilerCpuTime_t now;
+    TickType_t tick = xTaskGetTickCount();
+
+    tickProfilerGetCpuTime(&now);
+
+    g_cpuWindowTotal = 0U;
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        g_cpuWindow.level[level] = now.level[level] - g_cpuLast.level[level];
+        g_cpuWindowTotal += g_cpuWindow.level[level];
+    }
+    g_cpuWindow.supervisor = now.supervisor - g_cpuLast.supervisor;
+    g_cpuWindow.idle       = now.idle - g_cpuLast.idle;
+    g_cpuWindow.other      = now.other - g_cpuLast.other;
+    g_cpuWindowTotal += g_cpuWindow.supervisor + g_cpuWindow.idle + g_cpuWindow.other;
+
+    /* Part of idle, so not added to the total */
+    g_cpuWindow.asleep     = now.asleep - g_cpuLast.asleep;
+
+#if (TICK_PROFILER_CORES > 1U)
+    /* The idle split by core, also part of idle */
+    for (uint32_t core = 0U; core < TICK_PROFILER_CORES; core++)
+    {
+        TickProfilerCpuTime_t coreTime;
+
+        (void)tickProfilerGetCoreCpuTime(core, &coreTime);
+        g_coreIdleWindow[core] = coreTime.idle - g_coreIdleLast[core];
+        g_coreIdleLast[core]   = coreTime.idle;
+    }
+#endif
+
+#if (IRQ_STATS_ENABLED == 1U)
+    for (uint32_t source = 0U; source < IRQ_STATS_MAX_SOURCES; source++)
+    {
+        IrqStats_t irq;
+        uint64_t total;
+
+        (void)irqStatsGet(source, &irq);
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+        total = irq.total_cycles;
+#else
+        total = irq.total_cycles / TICK_PROFILER_CYCLES_PER_TICK;
+#endif
+        g_irqWindow[source] = total - g_irqLast[source];
+        g_irqLast[source]   = total;
+#if (IRQ_STATS_EXCLUDE_ENABLED == 1U)
+        /* Charged to no task, so it adds to the whole */
+        g_cpuWindowTotal += g_irqWindow[source];
+#endif
+    }
+#endif
+
+    g_cpuWindowTicks = tick - g_cpuLastTick;
+    g_cpuLast        = now;
+    g_cpuLastTick    = tick;
+}
+
+/*
+ * Description : Returns the CPU time a task used in the current window
+ * and leaves its lifetime total in g_cpuLastTask. A slot that was reused
+ * since the previous report starts from zero.
+ */
+static uint64_t taskWindowTime(uint32_t slot, const TickProfilerTaskInfo_t *info)
+{
+    uint64_t total = tickProfilerGetTotalTime(slot);
+    uint64_t previous = (g_cpuLastArrival[slot] == info->arrival_tick) ?
+                        g_cpuLastTask[slot] : 0U;
+
+    g_cpuLastTask[slot]    = total;
+    g_cpuLastArrival[slot] = info->arrival_tick;
+
+    return total - previous;
+}
+
+/*
+ * Description : Converts CPU time of the current window to 0.1 % units.
+ */
+static uint32_t cpuPermille(uint64_t used)
+{
+    if (g_cpuWindowTotal == 0U)
+    {
+        return 0U;
+    }
+
+    return (uint32_t)((used * 1000U) / g_cpuWindowTotal);
+}
+
+/*
+ * Description : Converts profiler CPU time (ticks, or cycles with cycle
+ * accounting) to milliseconds.
+ */
+static uint64_t cpuTimeToMs(uint64_t time)
+{
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    return time / (configCPU_CLOCK_HZ / 1000U);
+#else
+    return (time * 1000U) / configTICK_RATE_HZ;
+#endif
+}
+
+/*
+ * Description : Reads the scheduler's own counters into 'total' and their
+ * change since the previous report into 'interval' (the queue high-water
+ * mark is copied, not differenced). Returns the supervisor's CPU share of
+ * the interval in 0.1 % units.
+ */
+static uint32_t takeSelfMetrics(MLFQ_SelfMetrics_t *total, MLFQ_SelfMetrics_t *interval)
+{
+    TickType_t tick = xTaskGetTickCount();
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    uint64_t elapsed = (uint64_t)(tick - g_selfLastTick) * TICK_PROFILER_CYCLES_PER_TICK;
+#else
+    uint64_t elapsed = (uint64_t)(tick - g_selfLastTick);
+#endif
+
+    schedulerGetSelfMetrics(total);
+
+    interval->demotions          = total->demotions - g_selfLast.demotions;
+    interval->promotions         = total->promotions - g_selfLast.promotions;
+    interval->boosts             = total->boosts - g_selfLast.boosts;
+    interval->expiries_received  = total->expiries_received - g_selfLast.expiries_received;
+    interval->expiries_coalesced = total->expiries_coalesced - g_selfLast.expiries_coalesced;
+    interval->expiries_dropped   = total->expiries_dropped - g_selfLast.expiries_dropped;
+    interval->queue_high_water   = total->queue_high_water;
+    interval->wakes              = total->wakes - g_selfLast.wakes;
+    interval->supervisor_time    = total->supervisor_time - g_selfLast.supervisor_time;
+
+    g_selfLast     = *total;
+    g_selfLastTick = tick;
+
+    return (elapsed == 0U) ? 0U : (uint32_t)((interval->supervisor_time * 1000U) / elapsed);
+}
+
+/*
+ * Description : Appends one report row to a line. Touches no shared
+ * state, so any number of tasks can format rows at the same time.
+ */
+static void formatRow(LogLine_t *line, const char *name, uint32_t level, uint32_t run,
+                      uint32_t quantum, uint32_t arrival, uint32_t wait)
+{
+    // Same layout as "%-10s | Lvl: %d | Run: %2lu | Qtm: %2lu | Arr: %1lu | Wait: %2lu"
+    logPutField(line, name, 10U);
+    logPutText(line, " | Lvl: ");
+    logPutSigned(line, (int32_t)level, 0U);
+    logPutText(line, " | Run: ");
+    logPutUnsigned(line, run, 2U);
+    logPutText(line, " | Qtm: ");
+    logPutUnsigned(line, quantum, 2U);
+    logPutText(line, " | Arr: ");
+    logPutUnsigned(line, arrival, 1U);
+    logPutText(line, " | Wait: ");
+    logPutUnsigned(line, wait, 2U);
+    logPutText(line, "\r\n");
+}
+
+#if (METRICS_BINARY_LOG_ENABLED == 1U)
+#define METRICS_MAX(a, b)     (((a) > (b)) ? (a) : (b))
+
+/* Largest frame payload: the self-metrics record or a stack record with a
+ * name (both no smaller than the heap record), plus its CRC */
+#define METRICS_MAX_PAYLOAD   (METRICS_MAX(sizeof(MetricsSelfRecord_t), \
+                                           sizeof(MetricsStackRecord_t) + configMAX_TASK_NAME_LEN) + 2U)
+
+/* COBS adds one byte per 254 payload bytes, plus the 0x00 delimiter */
+#define METRICS_MAX_FRAME     (METRICS_MAX_PAYLOAD + 2U)
+
+/* Slots whose name the host has been sent (logger task only) */
+static bool g_nameSent[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_reportsSinceNames = 0U;
+
+/* Set by metricsResendTaskNames, taken by the logger task */
+static volatile bool g_namesStale = false;
+
+/*
+ * Description : Appends a CRC-16 to the payload, COBS-encodes it so the
+ * frame contains no zero bytes, and queues it followed by the delimiter.
+ */
+static void sendFrame(const uint8_t *payload, uint32_t length)
+{
+    uint8_t raw[METRICS_MAX_PAYLOAD];
+    uint8_t frame[METRICS_MAX_FRAME];
+
+    if (length > (METRICS_MAX_PAYLOAD - 2U)) return;
+
+    memcpy(raw, payload, length);
+    uint16_t crc = Crc16(0, payload, length);
+    raw[length++] = (uint8_t)(crc & 0xFFU);
+    raw[length++] = (uint8_t)(crc >> 8);
+
+    // COBS: each code byte tells how far away the next zero is
+    uint32_t out = 1U;
+    uint32_t codeIndex = 0U;
+    uint8_t code = 1U;
+
+    for (uint32_t i = 0U; i < length; i++)
+    {
+        if (raw[i] == 0U)
+        {
+            frame[codeIndex] = code;
+            codeIndex = out++;
+            code = 1U;
+        }
+        else
+        {
+            frame[out++] = raw[i];
+            code++;
+        }
+    }
+    frame[codeIndex] = code;
+    frame[out++] = 0U;
+
+    sendLogBytes(frame, out);
+}
+
+/*
+ * Description : Sends the name of the task in a profiler slot.
+ * Payload: type, task id, two reserved bytes, then the name bytes.
+ */
+static void sendTaskName(uint32_t slot)
+{
+    uint8_t payload[4U + configMAX_TASK_NAME_LEN];
+    const char *name = slotTaskName(slot);
+    uint32_t length = 0U;
+
+    payload[0] = METRICS_RECORD_TASK_NAME;
+    payload[1] = (uint8_t)slot;
+    payload[2] = 0U;
+    payload[3] = 0U;
+
+    while ((length < configMAX_TASK_NAME_LEN) && (name[length] != '\0'))
+    {
+        payload[4U + length] = (uint8_t)name[length];
+        length++;
+    }
+
+    sendFrame(payload, 4U + length);
+
+    if (slot < TICK_PROFILER_MAX_TASKS)
+    {
+        g_nameSent[slot] = true;
+    }
+}
+
+/*
+ * Description : Sends the name of a slot unless the host already has it,
+ * so records after the first carry only the task id.
+ */
+static void announceTask(uint32_t slot)
+{
+    if (g_namesStale)
+    {
+        g_namesStale = false;
+        memset(g_nameSent, 0, sizeof(g_nameSent));
+    }
+
+    if ((slot < TICK_PROFILER_MAX_TASKS) && !g_nameSent[slot])
+    {
+        sendTaskName(slot);
+    }
+}
+
+#if (LATENCY_STATS_ENABLED == 1U)
+/*
+ * Description : Sends one binary latency summary.
+ */
+static void sendLatencyRecord(uint8_t taskId, uint8_t level,
+                              const LatencySummary_t *summary)
+{
+    MetricsLatencyRecord_t record;
+
+    record.type     = METRICS_RECORD_LATENCY;
+    record.task_id  = taskId;
+    record.level    = level;
+    record.reserved = 0U;
+    record.samples  = summary->samples;
+    record.p50_us   = summary->p50_cycles / METRICS_CYCLES_PER_US;
+    record.p99_us   = summary->p99_cycles / METRICS_CYCLES_PER_US;
+    record.max_us   = summary->max_cycles / METRICS_CYCLES_PER_US;
+
+    sendFrame((const uint8_t *)&record, sizeof(record));
+}
+#endif
+
+/*
+ * Description : Sends the latency summaries of every level and task.
+ */
+static void emitLatencyReport(void)
+{
+#if (LATENCY_STATS_ENABLED == 1U)
+    LatencySummary_t summary;
+
+    for (uint32_t level = 0U; level < MLFQ_NUMBER_QUEUES; level++)
+    {
+        if (latencyGetLevelSummary(level, &summary))
+        {
+            sendLatencyRecord(METRICS_TASK_ID_NONE, (uint8_t)level, &summary);
+        }
+    }
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if ((info != NULL) && latencyGetTaskSummary(slot, &summary))
+        {
+            sendLatencyRecord((uint8_t)slot, info->level, &summary);
+        }
+    }
+#endif
+}
+
+/*
+ * Description : Sends the priority inversion totals of every task that
+ * has run on an inherited priority.
+ */
+static void emitInversionReport(void)
+{
+#if (INVERSION_STATS_ENABLED == 1U)
+    InversionSummary_t summary;
+    MetricsInversionRecord_t record;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if ((info != NULL) && inversionGetTaskSummary(slot, &summary) &&
+            (summary.episodes > 0U))
+        {
+            record.type     = METRICS_RECORD_INVERSION;
+            record.task_id  = (uint8_t)slot;
+            record.level    = info->level;
+            record.reserved = 0U;
+            record.episodes = summary.episodes;
+            record.total_us = summary.total_cycles / METRICS_CYCLES_PER_US;
+            record.max_us   = summary.max_cycles / METRICS_CYCLES_PER_US;
+
+            sendFrame((const uint8_t *)&record, sizeof(record));
+        }
+    }
+#endif
+}
+
+/*
+ * Description : Sends the blocking waits with the most time blocked,
+ * most first.
+ */
+static void emitWaitReport(void)
+{
+#if (WAIT_STATS_ENABLED == 1U)
+    WaitStatsEntry_t entry;
+    MetricsWaitRecord_t record;
+    uint32_t taken = 0U;
+
+    for (uint32_t i = 0U; (i < WAIT_STATS_REPORT_TOP) && nextTopWait(&taken, &entry); i++)
+    {
+        record.type      = METRICS_RECORD_WAIT;
+        record.task_id   = entry.slot;
+        record.direction = entry.direction;
+        record.reserved  = 0U;
+        record.object    = (uint32_t)(uintptr_t)entry.object;
+        record.waits     = entry.waits;
+        record.total_us  = (uint32_t)(entry.total_cycles / METRICS_CYCLES_PER_US);
+        record.max_us    = entry.max_cycles / METRICS_CYCLES_PER_US;
+
+        sendFrame((const uint8_t *)&record, sizeof(record));
+    }
+#endif
+}
+
+/*
+ * Description : Sends the busiest address ranges of every task that has
+ * PC samples, most first.
+ */
+static void emitPcSampleReport(void)
+{
+#if (PC_SAMPLER_ENABLED == 1U)
+    MetricsPcSampleRecord_t record;
+
+    for (uint32_t i = 0U; i <= tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t row = pcSamplerRow(i);
+        uint32_t total = pcSamplerGetTotal(row);
+        uint64_t taken = 0U;
+
+        for (uint32_t n = 0U; (total > 0U) && (n < PC_SAMPLER_REPORT_TOP); n++)
+        {
+            uint32_t bucket = nextTopBucket(row, &taken);
+
+            if (bucket == PC_SAMPLER_NONE)
+            {
+                break;
+            }
+
+            record.type         = METRICS_RECORD_PC_SAMPLES;
+            record.task_id      = (row == PC_SAMPLER_UNMANAGED) ?
+                                  METRICS_TASK_ID_NONE : (uint8_t)row;
+            record.shift        = PC_SAMPLER_BUCKET_SHIFT;
+            record.reserved     = 0U;
+            record.start        = (bucket == PC_SAMPLER_OUTSIDE) ? METRICS_PC_OUTSIDE :
+                                  (uint32_t)PC_SAMPLER_BASE + (bucket << PC_SAMPLER_BUCKET_SHIFT);
+            record.samples      = pcSamplerGetCount(row, bucket);
+            record.task_samples = total;
+
+            sendFrame((const uint8_t *)&record, sizeof(record));
+        }
+    }
+#endif
+}
+
+/*
+ * Description : Sends the timer callbacks with the most time in the timer
+ * service task, most first.
+ */
+static void emitTimerReport(void)
+{
+#if (TIMER_STATS_ENABLED == 1U)
+    TimerStats_t top[TIMER_STATS_REPORT_TOP];
+    MetricsTimerRecord_t record;
+    uint32_t count = timerStatsGetTop(top, TIMER_STATS_REPORT_TOP);
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        record.type     = METRICS_RECORD_TIMER;
+        record.task_id  = METRICS_TASK_ID_NONE;
+        record.pended   = top[i].pended ? 1U : 0U;
+        record.reserved = 0U;
+        record.callback = (uint32_t)(uintptr_t)top[i].callback;
+        record.runs     = top[i].runs;
+        record.total_ms = (uint32_t)(top[i].total_cycles / METRICS_CYCLES_PER_MS);
+        record.max_us   = top[i].max_cycles / METRICS_CYCLES_PER_US;
+        record.overruns = top[i].overruns;
+
+        sendFrame((const uint8_t *)&record, sizeof(record));
+    }
+#endif
+}
+
+/*
+ * Description : Sends the number of tasks at every MLFQ level.
+ */
+static void emitPopulationReport(void)
+{
+    MetricsPopulationRecord_t record;
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        record.type     = METRICS_RECORD_POPULATION;
+        record.task_id  = METRICS_TASK_ID_NONE;
+        record.level    = (uint8_t)level;
+        record.reserved = 0U;
+        record.tasks    = schedulerGetLevelPopulation((MLFQ_QueueLevel_t)level);
+
+        sendFrame((const uint8_t *)&record, sizeof(record));
+    }
+}
+
+/*
+ * Description : Sends one binary CPU share and lifetime total.
+ */
+static void sendCpuRecord(uint8_t taskId, uint8_t level, uint8_t kind,
+                          uint64_t used, uint64_t lifetime)
+{
+    MetricsCpuRecord_t record;
+
+    record.type     = METRICS_RECORD_CPU;
+    record.task_id  = taskId;
+    record.level    = level;
+    record.kind     = kind;
+    record.permille = cpuPermille(used);
+    record.total_ms = cpuTimeToMs(lifetime);
+
+    sendFrame((const uint8_t *)&record, sizeof(record));
+}
+
+/*
+ * Description : Sends the CPU share of every task, level, the supervisor,
+ * the unmanaged tasks, idle and each timed interrupt source over the
+ * window since the last report.
+ */
+static void emitCpuReport(void)
+{
+    takeCpuWindow();
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if (info != NULL)
+        {
+            uint64_t used = taskWindowTime(slot, info);
+
+            sendCpuRecord((uint8_t)slot, info->level, METRICS_CPU_KIND_TASK,
+                          used, g_cpuLastTask[slot]);
+        }
+    }
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        sendCpuRecord(METRICS_TASK_ID_NONE, (uint8_t)level, METRICS_CPU_KIND_LEVEL,
+                      g_cpuWindow.level[level], g_cpuLast.level[level]);
+    }
+
+    sendCpuRecord(METRICS_TASK_ID_NONE, 0U, METRICS_CPU_KIND_SUPERVISOR,
+                  g_cpuWindow.supervisor, g_cpuLast.supervisor);
+    sendCpuRecord(METRICS_TASK_ID_NONE, 0U, METRICS_CPU_KIND_OTHER,
+                  g_cpuWindow.other, g_cpuLast.other);
+    sendCpuRecord(METRICS_TASK_ID_NONE, 0U, METRICS_CPU_KIND_IDLE,
+                  g_cpuWindow.idle, g_cpuLast.idle);
+#if (configUSE_IDLE_HOOK == 1) || (configUSE_TICKLESS_IDLE == 1)
+    sendCpuRecord(METRICS_TASK_ID_NONE, 0U, METRICS_CPU_KIND_ASLEEP,
+                  g_cpuWindow.asleep, g_cpuLast.asleep);
+#endif
+#if (TICK_PROFILER_CORES > 1U)
+    for (uint32_t core = 0U; core < TICK_PROFILER_CORES; core++)
+    {
+        sendCpuRecord(METRICS_TASK_ID_NONE, (uint8_t)core, METRICS_CPU_KIND_CORE_IDLE,
+                      g_coreIdleWindow[core], g_coreIdleLast[core]);
+    }
+#endif
+
+#if (IRQ_STATS_ENABLED == 1U)
+    for (uint32_t source = 0U; source < IRQ_STATS_MAX_SOURCES; source++)
+    {
+        if (g_irqLast[source] != 0U)
+        {
+            sendCpuRecord(METRICS_TASK_ID_NONE, (uint8_t)source, METRICS_CPU_KIND_IRQ,
+                          g_irqWindow[source], g_irqLast[source]);
+        }
+    }
+#endif
+}
+
+/*
+ * Description : Sends the context switch counts of every managed task.
+ */
+static void emitSwitchReport(void)
+{
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+    MetricsSwitchRecord_t record;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if (info == NULL)
+        {
+            continue;
+        }
+
+        record.type        = METRICS_RECORD_SWITCHES;
+        record.task_id     = (uint8_t)slot;
+        record.level       = info->level;
+        record.reserved    = 0U;
+        record.switch_ins  = info->switch_ins;
+        record.voluntary   = info->voluntary_switches;
+        record.involuntary = info->involuntary_switches;
+
+        sendFrame((const uint8_t *)&record, sizeof(record));
+    }
+#endif
+
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+    MetricsFpuRecord_t fpu;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if (info == NULL)
+        {
+            continue;
+        }
+
+        fpu.type        = METRICS_RECORD_FPU;
+        fpu.task_id     = (uint8_t)slot;
+        fpu.level       = info->level;
+        fpu.reserved    = 0U;
+        fpu.saves       = info->context_saves;
+        fpu.fpu_saves   = info->fpu_saves;
+        fpu.fpu_kcycles = (uint32_t)(((uint64_t)info->fpu_saves *
+                                      TICK_PROFILER_FPU_SAVE_CYCLES) / 1000U);
+
+        sendFrame((const uint8_t *)&fpu, sizeof(fpu));
+    }
+#endif
+}
+
+/*
+ * Description : Sends the time at each level of every managed task.
+ */
+static void emitLevelTimeReport(void)
+{
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+    MetricsLevelTimeRecord_t record;
+    TickProfilerLevelTime_t time;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if ((info == NULL) || !tickProfilerGetLevelTime(slot, &time))
+        {
+            continue;
+        }
+
+        record.type    = METRICS_RECORD_LEVEL_TIME;
+        record.task_id = (uint8_t)slot;
+        record.level   = info->level;
+        record.levels  = (uint8_t)MLFQ_NUM_LEVELS;
+        record.changes = time.changes;
+        for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            record.level_ms[level] =
+                (uint32_t)(((uint64_t)time.ticks[level] * 1000U) / configTICK_RATE_HZ);
+        }
+
+        sendFrame((const uint8_t *)&record, sizeof(record));
+    }
+#endif
+}
+
+/*
+ * Description : Sends the running / ready / blocked time of every managed
+ * task.
+ */
+static void emitStateTimeReport(void)
+{
+#if (STATE_TIME_ENABLED == 1U)
+    MetricsStateTimeRecord_t record;
+    StateTimeSummary_t summary;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if ((info == NULL) || !stateTimeGetTask(slot, &summary))
+        {
+            continue;
+        }
+
+        record.type       = METRICS_RECORD_STATE_TIME;
+        record.task_id    = (uint8_t)slot;
+        record.level      = info->level;
+        record.state      = summary.state;
+        record.running_ms = (uint32_t)(summary.cycles[STATE_TIME_RUNNING] / METRICS_CYCLES_PER_MS);
+        record.ready_ms   = (uint32_t)(summary.cycles[STATE_TIME_READY] / METRICS_CYCLES_PER_MS);
+        record.blocked_ms = (uint32_t)(summary.cycles[STATE_TIME_BLOCKED] / METRICS_CYCLES_PER_MS);
+
+        sendFrame((const uint8_t *)&record, sizeof(record));
+    }
+#endif
+}
+
+/*
+ * Description : Sends the runqueue of every core.
+ */
+static void emitCoreReport(void)
+{
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+    MetricsCoreRecord_t record;
+    MLFQ_CoreStats_t stats;
+
+    for (uint32_t core = 0U; schedulerGetCoreStats(core, &stats); core++)
+    {
+        record.type          = METRICS_RECORD_CORE;
+        record.core          = (uint8_t)core;
+        record.tasks         = (uint8_t)stats.tasks;
+        record.high_tasks    = (uint8_t)stats.level_tasks[MLFQ_QUEUE_HIGH];
+        record.busy_permille = stats.busy_permille;
+        record.steals        = stats.steals;
+        record.migrations    = schedulerGetMigrationCount();
+
+        sendFrame((const uint8_t *)&record, sizeof(record));
+    }
+#endif
+}
+
+/*
+ * Description : Sends the scheduler's own counters, closing the queue
+ * table of a report.
+ */
+static void sendSelfRecord(void)
+{
+    MetricsSelfRecord_t record;
+    MLFQ_SelfMetrics_t total;
+    MLFQ_SelfMetrics_t interval;
+
+    record.supervisor_permille = takeSelfMetrics(&total, &interval);
+    record.type                = METRICS_RECORD_SELF;
+    record.task_id             = METRICS_TASK_ID_NONE;
+    record.reserved[0]         = 0U;
+    record.reserved[1]         = 0U;
+    record.demotions           = total.demotions;
+    record.promotions          = total.promotions;
+    record.boosts              = total.boosts;
+    record.expiries            = total.expiries_received;
+    record.coalesced           = total.expiries_coalesced;
+    record.dropped             = total.expiries_dropped;
+    record.queue_high_water    = total.queue_high_water;
+    record.wakes               = total.wakes;
+    record.supervisor_ms       = cpuTimeToMs(total.supervisor_time);
+
+    sendFrame((const uint8_t *)&record, sizeof(record));
+}
+
+/*
+ * Description : Sends the stack figures of every task the kernel created,
+ * each followed by the task name so unmanaged tasks can be labelled.
+ */
+static void emitStackReport(void)
+{
+#if (STACK_STATS_ENABLED == 1U)
+    uint8_t payload[sizeof(MetricsStackRecord_t) + STACK_STATS_NAME_LENGTH];
+    MetricsStackRecord_t record;
+    StackStats_t stats;
+
+    for (uint32_t i = 0U; stackStatsSample(i, &stats); i++)
+    {
+        int32_t slot = tickProfilerGetSlot((TaskHandle_t)stats.task);
+        uint32_t length = 0U;
+
+        record.type            = METRICS_RECORD_STACK;
+        record.task_id         = (slot >= 0) ? (uint8_t)slot : METRICS_TASK_ID_NONE;
+        record.reserved[0]     = 0U;
+        record.reserved[1]     = 0U;
+        record.size_words      = stats.size_words;
+        record.min_free_words  = stats.min_free_words;
+        record.suggested_words = stats.suggested_words;
+
+        memcpy(payload, &record, sizeof(record));
+        while ((length < (STACK_STATS_NAME_LENGTH - 1U)) && (stats.name[length] != '\0'))
+        {
+            payload[sizeof(record) + length] = (uint8_t)stats.name[length];
+            length++;
+        }
+
+        sendFrame(payload, sizeof(record) + length);
+    }
+#endif
+}
+
+/*
+ * Description : Sends the heap figures.
+ */
+static void emitHeapReport(void)
+{
+#if (HEAP_STATS_ENABLED == 1U)
+    MetricsHeapRecord_t record;
+    HeapSummary_t heap;
+
+    heapStatsGet(&heap);
+
+    record.type           = METRICS_RECORD_HEAP;
+    record.task_id        = METRICS_TASK_ID_NONE;
+    record.reserved[0]    = 0U;
+    record.reserved[1]    = 0U;
+    record.free_bytes     = heap.free_bytes;
+    record.min_free_bytes = heap.min_free_bytes;
+    record.largest_block  = heap.largest_block;
+    record.free_blocks    = heap.free_blocks;
+    record.allocations    = heap.allocations;
+    record.frees          = heap.frees;
+    record.failures       = heap.failures;
+
+    sendFrame((const uint8_t *)&record, sizeof(record));
+#endif
+}
+
+#if (METRICS_DELTA_LOG_ENABLED == 1U)
+/* Fields of the last row sent per task, the base of its next delta
+ * (logger task only) */
+typedef struct
+{
+    uint32_t field[METRICS_DELTA_FIELDS];
+    uint8_t  sequence;      /* Deltas sent since the last whole row */
+    bool     valid;
+} MetricsDeltaBase_t;
+
+static MetricsDeltaBase_t g_deltaBase[TICK_PROFILER_MAX_TASKS];
+
+/*
+ * Description : Writes a 32-bit difference as a zigzag LEB128 varint and
+ * returns its length (1 to 5 bytes). Small steps either way stay short.
+ */
+static uint32_t putVarint(uint8_t *out, uint32_t diff)
+{
+    uint32_t value = (diff << 1) ^ (((diff & 0x80000000U) != 0U) ? 0xFFFFFFFFU : 0U);
+    uint32_t length = 0U;
+
+    while (value >= 0x80U)
+    {
+        out[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+
+    return length;
+}
+
+/*
+ * Description : Sends a task row or level change as a delta from the
+ * task's previous row. The row goes out whole, and becomes the new base,
+ * when there is no base yet, the keyframe interval has passed, or the
+ * delta would not be shorter. withName announces the task first if the
+ * host does not have its name yet.
+ */
+static void sendTaskRow(const MetricsRecord_t *record, bool withName)
+{
+    uint8_t payload[4U + (METRICS_DELTA_FIELDS * 5U)];
+    uint32_t field[METRICS_DELTA_FIELDS];
+    MetricsDeltaBase_t *base;
+    uint32_t length = 4U;
+    uint8_t flags = 0U;
+
+    if (record->task_id >= TICK_PROFILER_MAX_TASKS)
+    {
+        sendFrame((const uint8_t *)record, sizeof(MetricsRecord_t));
+        return;
+    }
+
+    base = &g_deltaBase[record->task_id];
+    field[0] = record->level;
+    field[1] = record->prev_level;
+    field[2] = record->timestamp;
+    field[3] = record->run_ticks;
+    field[4] = record->quantum_ticks;
+    field[5] = record->arrival_tick;
+    field[6] = record->wait_ticks;
+
+    if (base->valid && (base->sequence < (METRICS_DELTA_KEYFRAME_EVERY - 1U)))
+    {
+        for (uint32_t i = 0U; i < METRICS_DELTA_FIELDS; i++)
+        {
+            uint32_t diff = field[i] - base->field[i];
+
+            if (diff != 0U)
+            {
+                flags |= (uint8_t)(1U << i);
+                length += putVarint(&payload[length], diff);
+            }
+        }
+
+        if (length < sizeof(MetricsRecord_t))
+        {
+            if (record->type == METRICS_RECORD_LEVEL_CHANGE)
+            {
+                flags |= METRICS_DELTA_LEVEL_CHANGE;
+            }
+
+            base->sequence++;
+            payload[0] = METRICS_RECORD_TASK_DELTA;
+            payload[1] = record->task_id;
+            payload[2] = flags;
+            payload[3] = base->sequence;
+            memcpy(base->field, field, sizeof(field));
+            sendFrame(payload, length);
+            return;
+        }
+    }
+
+    base->sequence = 0U;
+    base->valid    = true;
+    memcpy(base->field, field, sizeof(field));
+
+    if (withName)
+    {
+        announceTask(record->task_id);
+    }
+    sendFrame((const uint8_t *)record, sizeof(MetricsRecord_t));
+}
+#endif
+
+/*
+ * Description : Emits one snapshot as binary frames.
+ */
+static void emitSnapshot(const MetricsRecord_t *record)
+{
+    switch (record->type)
+    {
+        case METRICS_RECORD_TASK_NAME:
+            sendTaskName(record->task_id);
+            break;
+
+        case METRICS_RECORD_TASK_STATS:
+#if (METRICS_DELTA_LOG_ENABLED == 1U)
+            sendTaskRow(record, true);
+#else
+            announceTask(record->task_id);
+            sendFrame((const uint8_t *)record, sizeof(MetricsRecord_t));
+#endif
+            break;
+
+#if (METRICS_DELTA_LOG_ENABLED == 1U)
+        case METRICS_RECORD_LEVEL_CHANGE:
+            sendTaskRow(record, false);
+            break;
+#endif
+
+        case METRICS_RECORD_REPORT_END:
+            sendSelfRecord();
+            sendFrame((const uint8_t *)record, sizeof(MetricsRecord_t));
+            g_reportPart = 0U;
+
+            // Every few reports the next one names all its tasks again
+            g_reportsSinceNames++;
+            if (g_reportsSinceNames >= METRICS_NAME_RESEND_EVERY)
+            {
+                g_reportsSinceNames = 0U;
+                memset(g_nameSent, 0, sizeof(g_nameSent));
+            }
+            break;
+
+        default:
+            sendFrame((const uint8_t *)record, sizeof(MetricsRecord_t));
+            break;
+    }
+}
+#else
+/* True while a text report has printed its header but not its footer */
+static bool g_reportOpen = false;
+
+/* Longest table line after the queue report rows */
+#define METRICS_LINE_SIZE     64U
+
+/* Latency rows, which may end with a target and its misses */
+#define METRICS_LATENCY_LINE_SIZE  96U
+
+/*
+ * Description : Returns a printable name for an MLFQ level.
+ */
+static const char *levelName(uint32_t level)
+{
+#if (MLFQ_NUM_LEVELS == 3U)
+    static const char *const names[] = { "High", "Medium", "Low" };
+#else
+    static const char *const names[] = { "Level 0", "Level 1", "Level 2", "Level 3",
+                                         "Level 4", "Level 5", "Level 6", "Level 7" };
+#endif
+
+    return (level < MLFQ_NUM_LEVELS) ? names[level] : "?";
+}
+
+/*
+ * Description : Prints the number of tasks at every level after a report,
+ * then the level changes applied and coalesced since init, and the band,
+ * members and boosts of every partition.
+ */
+static void emitPopulationReport(void)
+{
+    MLFQ_LevelChangeStats_t changes;
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    sendLog("Level      | Tasks\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        logPutField(&line, levelName(level), 10U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, schedulerGetLevelPopulation((MLFQ_QueueLevel_t)level), 5U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+
+    schedulerGetLevelChangeStats(&changes);
+    logPutText(&line, "Level changes: ");
+    logPutUnsigned(&line, changes.applied, 0U);
+    logPutText(&line, " applied, ");
+    logPutUnsigned(&line, changes.coalesced, 0U);
+    logPutText(&line, " coalesced\r\n");
+    logLineSend(&line);
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    sendLog("Partition  | Top | Lv | Tasks | Boosts\r\n");
+
+    for (uint32_t partition = 0U; partition < MLFQ_MAX_PARTITIONS; partition++)
+    {
+        MLFQ_PartitionInfo_t info;
+
+        if (schedulerGetPartitionInfo(partition, &info) && (info.name != NULL))
+        {
+            logPutField(&line, info.name, 10U);
+            logPutText(&line, " | ");
+            logPutUnsigned(&line, info.top_priority, 3U);
+            logPutText(&line, " | ");
+            logPutUnsigned(&line, info.levels, 2U);
+            logPutText(&line, " | ");
+            logPutUnsigned(&line, info.tasks, 5U);
+            logPutText(&line, " | ");
+            logPutUnsigned(&line, info.boosts, 0U);
+            logPutText(&line, "\r\n");
+            logLineSend(&line);
+        }
+    }
+#endif
+
+    sendLog("===================================================\r\n");
+}
+
+/*
+ * Description : Prints one CPU row: the share of the window as a
+ * percentage and the lifetime total in seconds.
+ */
+static void sendCpuRow(const char *name, uint64_t used, uint64_t lifetime)
+{
+    uint32_t permille = cpuPermille(used);
+    uint64_t totalMs = cpuTimeToMs(lifetime);
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    logPutField(&line, name, 10U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, permille / 10U, 3U);
+    logPutText(&line, ".");
+    logPutUnsigned(&line, permille % 10U, 0U);
+    logPutText(&line, "  | ");
+    logPutUnsigned(&line, (uint32_t)(totalMs / 1000U), 8U);
+    logPutText(&line, ".");
+    logPutUnsignedZero(&line, (uint32_t)(totalMs % 1000U), 3U);
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+}
+
+/*
+ * Description : Prints the CPU share of every task, task group, partition,
+ * level, the supervisor, the unmanaged tasks, idle and each timed
+ * interrupt source over the window since the last report.
+ */
+static void emitCpuReport(void)
+{
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    takeCpuWindow();
+
+    logLineInit(&line, text, sizeof(text));
+    logPutText(&line, "CPU usage over the last ");
+    logPutUnsigned(&line, (uint32_t)(((uint64_t)g_cpuWindowTicks * 1000U) / configTICK_RATE_HZ), 0U);
+    logPutText(&line, " ms\r\n");
+    logLineSend(&line);
+    sendLog("Consumer   | CPU %  | Total (s)\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    memset(g_groupWindow, 0, sizeof(g_groupWindow));
+#endif
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    memset(g_partitionWindow, 0, sizeof(g_partitionWindow));
+#endif
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if (info != NULL)
+        {
+            uint64_t used = taskWindowTime(slot, info);
+
+            sendCpuRow(slotTaskName(slot), used, g_cpuLastTask[slot]);
+#if (MLFQ_GROUPS_ENABLED == 1U)
+            g_groupWindow[schedulerGetSlotGroup(slot)] += used;
+#endif
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+            g_partitionWindow[schedulerGetSlotPartition(slot)] += used;
+#endif
+        }
+    }
+
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    /* Tasks that left a group during the window take that part along */
+    for (uint32_t group = 0U; group < MLFQ_MAX_GROUPS; group++)
+    {
+        MLFQ_GroupInfo_t info;
+
+        if (schedulerGetGroupInfo(group, &info) && (info.name != NULL))
+        {
+            g_groupTotal[group] += g_groupWindow[group];
+            sendCpuRow(info.name, g_groupWindow[group], g_groupTotal[group]);
+        }
+    }
+#endif
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    for (uint32_t partition = 0U; partition < MLFQ_MAX_PARTITIONS; partition++)
+    {
+        MLFQ_PartitionInfo_t info;
+
+        if (schedulerGetPartitionInfo(partition, &info) && (info.name != NULL))
+        {
+            g_partitionTotal[partition] += g_partitionWindow[partition];
+            sendCpuRow(info.name, g_partitionWindow[partition], g_partitionTotal[partition]);
+        }
+    }
+#endif
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        sendCpuRow(levelName(level), g_cpuWindow.level[level], g_cpuLast.level[level]);
+    }
+
+    sendCpuRow("Supervisor", g_cpuWindow.supervisor, g_cpuLast.supervisor);
+    sendCpuRow("Other", g_cpuWindow.other, g_cpuLast.other);
+    sendCpuRow("Idle", g_cpuWindow.idle, g_cpuLast.idle);
+#if (configUSE_IDLE_HOOK == 1) || (configUSE_TICKLESS_IDLE == 1)
+    sendCpuRow(" asleep", g_cpuWindow.asleep, g_cpuLast.asleep);
+#endif
+#if (TICK_PROFILER_CORES > 1U)
+    /* Shares of the whole machine, so one idle core of two shows 50 % */
+    for (uint32_t core = 0U; (core < TICK_PROFILER_CORES) && (core < 10U); core++)
+    {
+        char name[] = " core 0";
+
+        name[6] = (char)('0' + core);
+        sendCpuRow(name, g_coreIdleWindow[core], g_coreIdleLast[core]);
+    }
+#endif
+
+#if (IRQ_STATS_ENABLED == 1U)
+    for (uint32_t source = 0U; source < IRQ_STATS_MAX_SOURCES; source++)
+    {
+        IrqStats_t irq;
+
+        if (g_irqLast[source] != 0U)
+        {
+            (void)irqStatsGet(source, &irq);
+            sendCpuRow((irq.name != NULL) ? irq.name : "IRQ ?",
+                       g_irqWindow[source], g_irqLast[source]);
+#if (IRQ_STORM_ENABLED == 1U)
+            /* Masked for overrunning its budget, since boot */
+            if (irq.storms != 0U)
+            {
+                logPutText(&line, "  storms: ");
+                logPutUnsigned(&line, irq.storms, 0U);
+                logPutText(&line, irqStormIsMasked(source) ? " (masked)\r\n" : "\r\n");
+                logLineSend(&line);
+            }
+#endif
+        }
+    }
+#endif
+
+    sendLog("===================================================\r\n");
+}
+
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+/* Switch rows with the FPU columns */
+#define METRICS_SWITCH_LINE_SIZE  (METRICS_LINE_SIZE + 24U)
+#else
+#define METRICS_SWITCH_LINE_SIZE  METRICS_LINE_SIZE
+#endif
+
+/*
+ * Description : Prints the context switch counts of every managed task.
+ * A task that is mostly preempted is CPU bound at its level; one that
+ * mostly gives the CPU up waits on I/O or timers. With FPU stats, the
+ * share of its context saves that held FPU state and their estimated
+ * extra cost in thousands of cycles follow.
+ */
+static void emitSwitchReport(void)
+{
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+    char text[METRICS_SWITCH_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    sendLog("Context switches since registration\r\n");
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+    sendLog("Task       | Lvl | Switch-ins | Voluntary | Preempted | FPU % | FPU kcyc\r\n");
+#else
+    sendLog("Task       | Lvl | Switch-ins | Voluntary | Preempted\r\n");
+#endif
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+
+        if (info == NULL)
+        {
+            continue;
+        }
+
+        logPutField(&line, slotTaskName(slot), 10U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, info->level, 3U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, info->switch_ins, 10U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, info->voluntary_switches, 9U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, info->involuntary_switches, 9U);
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+        uint32_t saves = info->context_saves;
+
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, (saves == 0U) ? 0U :
+                       (uint32_t)(((uint64_t)info->fpu_saves * 100U) / saves), 5U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, (uint32_t)(((uint64_t)info->fpu_saves *
+                                          TICK_PROFILER_FPU_SAVE_CYCLES) / 1000U), 8U);
+#endif
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+
+    sendLog("===================================================\r\n");
+#endif
+}
+
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+/* Level times at the previous report and the arrival tick of the task
+ * they belong to, for the interval (logger task only) */
+static TickProfilerLevelTime_t g_levelTimeLast[TICK_PROFILER_MAX_TASKS];
+static TickType_t g_levelTimeArrival[TICK_PROFILER_MAX_TASKS];
+
+/* Level time rows: two columns per level */
+#define METRICS_LEVEL_TIME_LINE_SIZE  (48U + (MLFQ_NUM_LEVELS * 8U))
+
+/*
+ * Description : Appends each level's share of 'ticks' in whole percent.
+ */
+static void putLevelShares(LogLine_t *line, const uint32_t *ticks)
+{
+    uint64_t sum = 0U;
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        sum += ticks[level];
+    }
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        logPutText(line, " ");
+        logPutUnsigned(line, (sum == 0U) ? 0U : (uint32_t)((ticks[level] * 100U) / sum), 3U);
+    }
+}
+#endif
+
+/*
+ * Description : Prints how each managed task divided its time between
+ * the levels, over the interval since the previous report and since it
+ * registered, with its level changes. A task that never leaves High is
+ * interactive; one with many changes flaps between levels; tasks that
+ * sink again right after every boost are CPU bound.
+ */
+static void emitLevelTimeReport(void)
+{
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+    char text[METRICS_LEVEL_TIME_LINE_SIZE];
+    LogLine_t line;
+    TickProfilerLevelTime_t time;
+
+    logLineInit(&line, text, sizeof(text));
+    sendLog("Time in level (% by level, High first)\r\n");
+    sendLog("Task       | Interval | Since registration | Changes\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *info = tickProfilerGetRecord(slot);
+        uint32_t interval[MLFQ_NUM_LEVELS];
+
+        if ((info == NULL) || !tickProfilerGetLevelTime(slot, &time))
+        {
+            continue;
+        }
+
+        // A reused slot starts from zero
+        if (g_levelTimeArrival[slot] != info->arrival_tick)
+        {
+            memset(&g_levelTimeLast[slot], 0, sizeof(g_levelTimeLast[slot]));
+            g_levelTimeArrival[slot] = info->arrival_tick;
+        }
+
+        for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            interval[level] = time.ticks[level] - g_levelTimeLast[slot].ticks[level];
+        }
+
+        logPutField(&line, slotTaskName(slot), 10U);
+        logPutText(&line, " |");
+        putLevelShares(&line, interval);
+        logPutText(&line, " |");
+        putLevelShares(&line, time.ticks);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, time.changes, 0U);
+        logPutText(&line, " (+");
+        logPutUnsigned(&line, time.changes - g_levelTimeLast[slot].changes, 0U);
+        logPutText(&line, ")\r\n");
+        logLineSend(&line);
+
+        g_levelTimeLast[slot] = time;
+    }
+
+    sendLog("===================================================\r\n");
+#endif
+}
+
+/*
+ * Description : Prints the running / ready / blocked time of every
+ * managed task since registration. Ready % is the share of the time the
+ * task wanted the CPU that it spent waiting for it.
+ */
+static void emitStateTimeReport(void)
+{
+#if (STATE_TIME_ENABLED == 1U)
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+    StateTimeSummary_t summary;
+
+    logLineInit(&line, text, sizeof(text));
+    sendLog("Task state time since registration (ms)\r\n");
+    sendLog("Task       | Running  | Ready    | Blocked  | Ready %\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+
+        if ((tickProfilerGetRecord(slot) == NULL) || !stateTimeGetTask(slot, &summary))
+        {
+            continue;
+        }
+
+        uint64_t running = summary.cycles[STATE_TIME_RUNNING];
+        uint64_t ready   = summary.cycles[STATE_TIME_READY];
+        uint64_t blocked = summary.cycles[STATE_TIME_BLOCKED];
+        uint32_t share   = ((running + ready) > 0U) ?
+                           (uint32_t)((ready * 100U) / (running + ready)) : 0U;
+
+        logPutField(&line, slotTaskName(slot), 10U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, (uint32_t)(running / METRICS_CYCLES_PER_MS), 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, (uint32_t)(ready / METRICS_CYCLES_PER_MS), 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, (uint32_t)(blocked / METRICS_CYCLES_PER_MS), 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, share, 6U);
+        logPutText(&line, "%\r\n");
+        logLineSend(&line);
+    }
+
+    sendLog("===================================================\r\n");
+#endif
+}
+
+/*
+ * Description : Prints the runqueue of every core: its busy share at the
+ * last balance check, the tasks homed on it by level and the tasks it
+ * stole, then the moves between cores since boot.
+ */
+static void emitCoreReport(void)
+{
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+    MLFQ_CoreStats_t stats;
+
+    logLineInit(&line, text, sizeof(text));
+    sendLog("Per-core runqueues\r\n");
+    sendLog("Core | Busy % | Tasks by level | Steals\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t core = 0U; schedulerGetCoreStats(core, &stats); core++)
+    {
+        logPutUnsigned(&line, core, 4U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, stats.busy_permille / 10U, 4U);
+        logPutText(&line, ".");
+        logPutUnsigned(&line, stats.busy_permille % 10U, 0U);
+        logPutText(&line, " |");
+        for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            logPutText(&line, " ");
+            logPutUnsigned(&line, stats.level_tasks[level], 2U);
+        }
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, stats.steals, 6U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+
+    logPutText(&line, "Migrations: ");
+    logPutUnsigned(&line, schedulerGetMigrationCount(), 0U);
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+    sendLog("===================================================\r\n");
+#endif
+}
+
+/*
+ * Description : Appends "label total (+interval)" to a footer line.
+ */
+static void putSelfCounter(LogLine_t *line, const char *label, uint32_t total,
+                           uint32_t interval)
+{
+    logPutText(line, label);
+    logPutUnsigned(line, total, 0U);
+    logPutText(line, " (+");
+    logPutUnsigned(line, interval, 0U);
+    logPutText(line, ")");
+}
+
+/*
+ * Description : Prints the scheduler's own activity under the queue
+ * table: totals since boot with the change since the previous report.
+ * Demotions and promotions climbing together, or a supervisor waking
+ * far more often than quanta expire, is the scheduler thrashing.
+ */
+static void emitSelfFooter(void)
+{
+    char text[METRICS_LATENCY_LINE_SIZE];
+    LogLine_t line;
+    MLFQ_SelfMetrics_t total;
+    MLFQ_SelfMetrics_t interval;
+    uint32_t share = takeSelfMetrics(&total, &interval);
+
+    logLineInit(&line, text, sizeof(text));
+    putSelfCounter(&line, "Sched: demote ", total.demotions, interval.demotions);
+    putSelfCounter(&line, " | promote ", total.promotions, interval.promotions);
+    putSelfCounter(&line, " | boost ", total.boosts, interval.boosts);
+    putSelfCounter(&line, " | wakes ", total.wakes, interval.wakes);
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+
+    putSelfCounter(&line, "Expiry: got ", total.expiries_received, interval.expiries_received);
+    putSelfCounter(&line, " | coalesced ", total.expiries_coalesced, interval.expiries_coalesced);
+    putSelfCounter(&line, " | dropped ", total.expiries_dropped, interval.expiries_dropped);
+    logPutText(&line, " | queue max ");
+    logPutUnsigned(&line, total.queue_high_water, 0U);
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+
+    logPutText(&line, "Supervisor CPU: ");
+    logPutUnsigned(&line, share / 10U, 0U);
+    logPutText(&line, ".");
+    logPutUnsigned(&line, share % 10U, 0U);
+    logPutText(&line, " % of the interval, ");
+    logPutUnsigned(&line, (uint32_t)cpuTimeToMs(total.supervisor_time), 0U);
+    logPutText(&line, " ms since boot\r\n");
+    logLineSend(&line);
+}
+
+/*
+ * Description : Prints the stack figures of every task the kernel created.
+ */
+static void emitStackReport(void)
+{
+#if (STACK_STATS_ENABLED == 1U)
+    StackStats_t stats;
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    sendLog("Stack usage (words)\r\n");
+    sendLog("Task       |  Size | Min free | Suggest\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t i = 0U; stackStatsSample(i, &stats); i++)
+    {
+        logPutField(&line, stats.name, 10U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, stats.size_words, 5U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, stats.min_free_words, 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, stats.suggested_words, 7U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+
+    sendLog("===================================================\r\n");
+#endif
+}
+
+/*
+ * Description : Prints the heap figures and allocation counters.
+ */
+static void emitHeapReport(void)
+{
+#if (HEAP_STATS_ENABLED == 1U)
+    HeapSummary_t heap;
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    heapStatsGet(&heap);
+
+    sendLog("Heap (bytes)\r\n");
+    sendLog("  Free  | Min ever | Largest | Blocks\r\n");
+    sendLog("---------------------------------------------------\r\n");
+    logLineInit(&line, text, sizeof(text));
+    logPutUnsigned(&line, heap.free_bytes, 7U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, heap.min_free_bytes, 8U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, heap.largest_block, 7U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, heap.free_blocks, 6U);
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+    logPutText(&line, "Allocs: ");
+    logPutUnsigned(&line, heap.allocations, 0U);
+    logPutText(&line, " | Frees: ");
+    logPutUnsigned(&line, heap.frees, 0U);
+    logPutText(&line, " | Failed: ");
+    logPutUnsigned(&line, heap.failures, 0U);
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+    sendLog("===================================================\r\n");
+#endif
+}
+
+#if (LATENCY_STATS_ENABLED == 1U)
+/*
+ * Description : Prints one latency row in microseconds, with the target
+ *               and its misses for a task that declared one.
+ */
+static void sendLatencyRow(const char *name, const LatencySummary_t *summary)
+{
+    char text[METRICS_LATENCY_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+    logPutField(&line, name, 10U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, summary->samples, 7U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, summary->p50_cycles / METRICS_CYCLES_PER_US, 6U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, summary->p99_cycles / METRICS_CYCLES_PER_US, 6U);
+    logPutText(&line, " | ");
+    logPutUnsigned(&line, summary->max_cycles / METRICS_CYCLES_PER_US, 6U);
+    if (summary->target_cycles != 0U)
+    {
+        logPutText(&line, "  target ");
+        logPutUnsigned(&line, summary->target_cycles / METRICS_CYCLES_PER_US, 0U);
+        logPutText(&line, " us, missed ");
+        logPutUnsigned(&line, summary->misses, 0U);
+    }
+    logPutText(&line, "\r\n");
+    logLineSend(&line);
+}
+#endif
+
+/*
+ * Description : Prints the wake-to-run latency table after a report.
+ */
+static void emitLatencyReport(void)
+{
+#if (LATENCY_STATS_ENABLED == 1U)
+    LatencySummary_t summary;
+
+    sendLog("Wake-to-run latency (us)\r\n");
+    sendLog("Level/Task | Samples |  p50   |  p99   |  Max\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t level = 0U; level < MLFQ_NUMBER_QUEUES; level++)
+    {
+        if (latencyGetLevelSummary(level, &summary))
+        {
+            sendLatencyRow(levelName(level), &summary);
+        }
+    }
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+
+        if ((tickProfilerGetRecord(slot) != NULL) && latencyGetTaskSummary(slot, &summary))
+        {
+            sendLatencyRow(slotTaskName(slot), &summary);
+        }
+    }
+
+    sendLog("===================================================\r\n");
+#endif
+}
+
+/*
+ * Description : Prints the priority inversion table after a report,
+ * listing only tasks that have run on an inherited priority.
+ */
+static void emitInversionReport(void)
+{
+#if (INVERSION_STATS_ENABLED == 1U)
+    InversionSummary_t summary;
+    bool headerSent = false;
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+
+        if ((tickProfilerGetRecord(slot) == NULL) ||
+            !inversionGetTaskSummary(slot, &summary) || (summary.episodes == 0U))
+        {
+            continue;
+        }
+
+        if (!headerSent)
+        {
+            sendLog("Priority inversion (us)\r\n");
+            sendLog("Task       | Episodes |  Total   |  Max\r\n");
+            sendLog("---------------------------------------------------\r\n");
+            headerSent = true;
+        }
+
+        logPutField(&line, slotTaskName(slot), 10U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary.episodes, 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary.total_cycles / METRICS_CYCLES_PER_US, 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, summary.max_cycles / METRICS_CYCLES_PER_US, 6U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+
+    if (headerSent)
+    {
+        sendLog("===================================================\r\n");
+    }
+#endif
+}
+
+/*
+ * Description : Prints the blocking waits with the most time blocked,
+ * most first. Objects are named from the queue registry when it has
+ * them, else shown by address.
+ */
+static void emitWaitReport(void)
+{
+#if (WAIT_STATS_ENABLED == 1U)
+    WaitStatsEntry_t entry;
+    uint32_t taken = 0U;
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+
+    for (uint32_t i = 0U; (i < WAIT_STATS_REPORT_TOP) && nextTopWait(&taken, &entry); i++)
+    {
+        const char *objectName = NULL;
+
+        if (i == 0U)
+        {
+            sendLog("Blocking waits (us)\r\n");
+            sendLog("Task       | Object     | Dir | Waits  |  Total   | Max\r\n");
+            sendLog("---------------------------------------------------\r\n");
+        }
+
+#if (configQUEUE_REGISTRY_SIZE > 0)
+        objectName = pcQueueGetName((QueueHandle_t)entry.object);
+#endif
+
+        logPutField(&line, slotTaskName(entry.slot), 10U);
+        logPutText(&line, " | ");
+        if (objectName != NULL)
+        {
+            logPutField(&line, objectName, 10U);
+        }
+        else
+        {
+            logPutText(&line, "0x");
+            logPutHex(&line, (uint32_t)(uintptr_t)entry.object, 8U);
+        }
+        logPutText(&line, (entry.direction == WAIT_STATS_SEND) ? " | TX  | " : " | RX  | ");
+        logPutUnsigned(&line, entry.waits, 6U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, (uint32_t)(entry.total_cycles / METRICS_CYCLES_PER_US), 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, entry.max_cycles / METRICS_CYCLES_PER_US, 0U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+
+    if (taken != 0U)
+    {
+        if (waitStatsGetDropped() > 0U)
+        {
+            logPutText(&line, "Dropped (table full): ");
+            logPutUnsigned(&line, waitStatsGetDropped(), 0U);
+            logPutText(&line, "\r\n");
+            logLineSend(&line);
+        }
+        sendLog("===================================================\r\n");
+    }
+#endif
+}
+
+/*
+ * Description : Prints the busiest address ranges of every task that has
+ * PC samples, most first, with their share of the task's samples.
+ * tools/mlfq_decode.py --map names the functions in each range.
+ */
+static void emitPcSampleReport(void)
+{
+#if (PC_SAMPLER_ENABLED == 1U)
+    bool headerSent = false;
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    logLineInit(&line, text, sizeof(text));
+
+    for (uint32_t i = 0U; i <= tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t row = pcSamplerRow(i);
+        uint32_t total = pcSamplerGetTotal(row);
+        uint64_t taken = 0U;
+
+        for (uint32_t n = 0U; (total > 0U) && (n < PC_SAMPLER_REPORT_TOP); n++)
+        {
+            uint32_t bucket = nextTopBucket(row, &taken);
+
+            if (bucket == PC_SAMPLER_NONE)
+            {
+                break;
+            }
+
+            uint32_t count = pcSamplerGetCount(row, bucket);
+            uint32_t start = (uint32_t)PC_SAMPLER_BASE + (bucket << PC_SAMPLER_BUCKET_SHIFT);
+
+            if (!headerSent)
+            {
+                sendLog("PC samples since registration\r\n");
+                sendLog("Task       | Address range         | Samples | Share\r\n");
+                sendLog("---------------------------------------------------\r\n");
+                headerSent = true;
+            }
+
+            logPutField(&line, (row == PC_SAMPLER_UNMANAGED) ? "Unmanaged" : slotTaskName(row),
+                        10U);
+            logPutText(&line, " | ");
+            if (bucket == PC_SAMPLER_OUTSIDE)
+            {
+                logPutField(&line, "outside range", 21U);
+            }
+            else
+            {
+                logPutText(&line, "0x");
+                logPutHex(&line, start, 8U);
+                logPutText(&line, "-0x");
+                logPutHex(&line, start + (1UL << PC_SAMPLER_BUCKET_SHIFT) - 1U, 8U);
+            }
+            logPutText(&line, " | ");
+            logPutUnsigned(&line, count, 7U);
+            logPutText(&line, " | ");
+            logPutUnsigned(&line, (uint32_t)(((uint64_t)count * 100U) / total), 4U);
+            logPutText(&line, "%\r\n");
+            logLineSend(&line);
+        }
+    }
+
+    if (headerSent)
+    {
+        sendLog("===================================================\r\n");
+    }
+#endif
+}
+
+/*
+ * Description : Prints the timer callbacks with the most time in the
+ * timer service task, most first. Callbacks are addresses, to look up
+ * in the .map file; tools/mlfq_decode.py --map names them in binary logs.
+ */
+static void emitTimerReport(void)
+{
+#if (TIMER_STATS_ENABLED == 1U)
+    TimerStats_t top[TIMER_STATS_REPORT_TOP];
+    uint32_t count = timerStatsGetTop(top, TIMER_STATS_REPORT_TOP);
+    char text[METRICS_LINE_SIZE];
+    LogLine_t line;
+
+    if (count == 0U)
+    {
+        return;
+    }
+
+    logLineInit(&line, text, sizeof(text));
+    sendLog("Timer daemon callbacks since boot\r\n");
+    sendLog("Callback   | Kind  | Runs   | Total ms | Max us | Over\r\n");
+    sendLog("---------------------------------------------------\r\n");
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (top[i].callback == NULL)
+        {
+            logPutField(&line, "Others", 10U);
+        }
+        else
+        {
+            logPutText(&line, "0x");
+            logPutHex(&line, (uint32_t)(uintptr_t)top[i].callback, 8U);
+        }
+        logPutText(&line, top[i].pended ? " | Pend  | " : " | Timer | ");
+        logPutUnsigned(&line, top[i].runs, 6U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, (uint32_t)(top[i].total_cycles / METRICS_CYCLES_PER_MS), 8U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, top[i].max_cycles / METRICS_CYCLES_PER_US, 6U);
+        logPutText(&line, " | ");
+        logPutUnsigned(&line, top[i].overruns, 0U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+
+    sendLog("===================================================\r\n");
+#endif
+}
+
+/*
+ * Description : Emits one snapshot as lines of the text report.
+ */
+static void emitSnapshot(const MetricsRecord_t *record)
+{
+    if (!g_reportOpen &&
+        ((record->type == METRICS_RECORD_TASK_STATS) ||
+         (record->type == METRICS_RECORD_REPORT_END)))
+    {
+        // 1. Print Header
+        sendLog("\n================ MLFQ QUEUE REPORT ================\r\n");
+        sendLog("Name       | Lvl | Run  | Qtm | Arr   | Wait\r\n");
+        sendLog("---------------------------------------------------\r\n");
+        g_reportOpen = true;
+    }
+
+    if (record->type == METRICS_RECORD_TASK_STATS)
+    {
+        // 2. One row per task
+        char text[LOG_BUFFER_SIZE];
+        LogLine_t line;
+
+        logLineInit(&line, text, sizeof(text));
+        formatRow(&line,
+                  slotTaskName(record->task_id),
+                  record->level,
+                  record->run_ticks,
+                  record->quantum_ticks,
+                  record->arrival_tick,
+                  record->wait_ticks);
+        logLineSend(&line);
+    }
+    else if (record->type == METRICS_RECORD_OVERLOAD)
+    {
+        char text[METRICS_LATENCY_LINE_SIZE];
+        LogLine_t line;
+
+        logLineInit(&line, text, sizeof(text));
+        logPutText(&line, "[OVERLOAD] ");
+        if ((record->prev_level & MLFQ_OVERLOAD_CAUSE_DEMAND) != 0U)
+        {
+            logPutText(&line, "demand ");
+        }
+        if ((record->prev_level & MLFQ_OVERLOAD_CAUSE_STARVATION) != 0U)
+        {
+            logPutText(&line, "starvation ");
+        }
+        logPutText(&line, "| upper levels ");
+        logPutUnsigned(&line, record->run_ticks / 10U, 0U);
+        logPutText(&line, ".");
+        logPutUnsigned(&line, record->run_ticks % 10U, 0U);
+        logPutText(&line, " % | Low wait ");
+        logPutUnsigned(&line, record->quantum_ticks, 0U);
+        logPutText(&line, " ms");
+        if (record->task_id != METRICS_TASK_ID_NONE)
+        {
+            logPutText(&line, " (");
+            logPutText(&line, slotTaskName(record->task_id));
+            logPutText(&line, ")");
+        }
+        logPutText(&line, " | alarm ");
+        logPutUnsigned(&line, record->arrival_tick, 0U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+    else if (record->type == METRICS_RECORD_WATCHDOG)
+    {
+        char text[METRICS_LATENCY_LINE_SIZE];
+        LogLine_t line;
+
+        logLineInit(&line, text, sizeof(text));
+        if (record->level == METRICS_WATCHDOG_STARVED)
+        {
+            logPutText(&line, "[WATCHDOG] ");
+            logPutText(&line, slotTaskName(record->task_id));
+            logPutText(&line, " got no CPU for ");
+            logPutUnsigned(&line, record->quantum_ticks, 0U);
+            logPutText(&line, " ms, watchdog no longer fed\r\n");
+        }
+        else
+        {
+            logPutText(&line, "[WATCHDOG] last reset was a watchdog reset\r\n");
+        }
+        logLineSend(&line);
+    }
+    else if (record->type == METRICS_RECORD_DEGRADED)
+    {
+        char text[METRICS_LATENCY_LINE_SIZE];
+        LogLine_t line;
+
+        logLineInit(&line, text, sizeof(text));
+        logPutText(&line, (record->level != 0U) ? "[DEGRADED] entered" : "[DEGRADED] left");
+        logPutText(&line, " | upper levels ");
+        logPutUnsigned(&line, record->run_ticks / 10U, 0U);
+        logPutText(&line, ".");
+        logPutUnsigned(&line, record->run_ticks % 10U, 0U);
+        logPutText(&line, " % | change ");
+        logPutUnsigned(&line, record->arrival_tick, 0U);
+        logPutText(&line, "\r\n");
+        logLineSend(&line);
+    }
+    else if (record->type == METRICS_RECORD_REPORT_END)
+    {
+        if (record->level == METRICS_REPORT_DELTA)
+        {
+            char text[METRICS_LATENCY_LINE_SIZE];
+            LogLine_t line;
+
+            logLineInit(&line, text, sizeof(text));
+            logPutText(&line, "(");
+            logPutUnsigned(&line, record->run_ticks, 0U);
+            logPutText(&line, " unchanged rows not sent)\r\n");
+            logLineSend(&line);
+        }
+        emitSelfFooter();
+        sendLog("===================================================\r\n");
+        g_reportOpen = false;
+        g_reportPart = 0U;
+    }
+}
+#endif
+
+/* Sections of a report after its queue table, in the order they are sent */
+static void (*const g_reportParts[METRICS_REPORT_PARTS])(void) =
+{
+    emitPopulationReport,
+    emitCpuReport,
+    emitSwitchReport,
+    emitLevelTimeReport,
+    emitStateTimeReport,
+    emitCoreReport,
+    emitStackReport,
+    emitHeapReport,
+    emitLatencyReport,
+    emitInversionReport,
+    emitWaitReport,
+    emitPcSampleReport,
+    emitTimerReport
+};
+
+/*
+ * Description : Sends the next due section of the current report, else
+ * the next queued record. Returns false when there was nothing to send.
+ */
+static bool emitNextReportItem(void)
+{
+    MetricsRecord_t record;
+
+    if (g_reportPart < METRICS_REPORT_PARTS)
+    {
+        g_reportParts[g_reportPart++]();
+        return true;
+    }
+
+    if (popSnapshot(&g_snapshotRing, &record))
+    {
+        emitSnapshot(&record);
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Description : Formats a report row for one task into the caller's
+ * buffer and returns its length, without copying the stats or touching
+ * any static buffer.
+ */
+uint32_t formatStatsLine(const MLFQ_Task_Profiler_t *stats, char *buffer, uint32_t size)
+{
+    MetricsRecord_t record;
+    LogLine_t line;
+
+    if ((stats == NULL) || (buffer == NULL) || (size == 0U)) return 0U;
+
+    fillStatsRecord(&record, 0U, stats);
+
+    logLineInit(&line, buffer, size);
+    formatRow(&line,
+              pcTaskGetName(stats->task_info.task), /* Use FreeRTOS helper for name string */
+              record.level,
+              record.run_ticks,
+              record.quantum_ticks,
+              record.arrival_tick,
+              record.wait_ticks);
+
+    return line.length;
+}
+
 /*
  * Description : Produces a formatted string for UART or report.
- * Format: [Name] | Runtime: [X] ticks | Level: [Y]
+ * Format: [Name] | Lvl: [L] | Run: [X] | Qtm: [Q] | Arr: [A] | Wait: [W]
  */
 char *formatStatsLog(MLFQ_Task_Profiler_t stats)
 {
-    if (g_logBuffer == NULL) return NULL;
-    uint32_t currentTick = xTaskGetTickCount();
-    uint32_t totalTimeAlive = currentTick - stats.arrival_tick;
-    uint32_t waitingTime = 0;
-
-    if(totalTimeAlive > stats.task_info.run_ticks)
-    {
-        waitingTime = totalTimeAlive - stats.task_info.run_ticks;
-    }
-        
-    snprintf(g_logBuffer, LOG_BUFFER_SIZE, 
-                "%-10s | Lvl: %d | Run: %2lu | Qtm: %2lu | Arr: %1lu | Wait: %2lu\r\n",
-                pcTaskGetName(stats.task_info.task), /* Use FreeRTOS helper for name string */
-                stats.task_level,
-                stats.task_info.run_ticks, 
-                stats.task_info.quantum_ticks,
-                stats.arrival_tick,
-                waitingTime);
-    // Despite the misleading name, snprintf does not print but rather it saves the output in the mentioned buffer
-    
+    (void)formatStatsLine(&stats, g_logBuffer, LOG_BUFFER_SIZE);
+
     return g_logBuffer;
 }
 
+#if (METRICS_DIFF_REPORT_ENABLED == 1U)
+/*
+ * Description : Tells whether a row differs enough from the one last sent
+ * for its slot, and remembers it as sent when it does.
+ */
+static bool rowChanged(const MetricsRecord_t *record, bool keyframe)
+{
+    MetricsSentRow_t *sent = &g_sentRow[record->task_id];
+    uint32_t bucket = record->run_ticks / METRICS_DIFF_RUN_BUCKET_TICKS;
+    uint32_t waitMoved = (record->wait_ticks > sent->wait_ticks) ?
+                         (record->wait_ticks - sent->wait_ticks) :
+                         (sent->wait_ticks - record->wait_ticks);
+
+    if (!keyframe && sent->sent &&
+        (sent->arrival_tick == record->arrival_tick) &&
+        (sent->level == record->level) &&
+        (sent->run_bucket == bucket) &&
+        (waitMoved < METRICS_DIFF_WAIT_TICKS))
+    {
+        return false;
+    }
+
+    sent->arrival_tick = record->arrival_tick;
+    sent->run_bucket   = bucket;
+    sent->wait_ticks   = record->wait_ticks;
+    sent->level        = record->level;
+    sent->sent         = true;
+
+    return true;
+}
+#endif
+
 /*
- * Description : Prints current queue levels and stats for all tasks.
- * It relies on schedulerGetTaskStats (Helper) to bridge
- * the private data in scheduler.c.
+ * Description : Snapshots current queue levels and stats for all tasks.
+ * It relies on schedulerGetStatsSnapshot to take one consistent copy
+ * of the whole table without masking interrupts. Only fixed-size records
+ * are copied here; the logger task does the formatting and UART output.
+ * With METRICS_DIFF_REPORT_ENABLED only keyframes copy every row.
  */
 void printQueueReport(void)
 {
-    MLFQ_Task_Profiler_t currentStats;
-    
-    // 1. Print Header
-    sendLog("\n================ MLFQ QUEUE REPORT ================\r\n");
-    sendLog("Name       | Lvl | Run  | Qtm | Arr   | Wait\r\n");
-    sendLog("---------------------------------------------------\r\n");
+    MetricsRecord_t record;
+    uint32_t unchanged = 0U;
+#if (METRICS_DIFF_REPORT_ENABLED == 1U)
+    bool keyframe = (g_reportsSinceKeyframe == 0U);
+
+    g_reportsSinceKeyframe = (g_reportsSinceKeyframe + 1U) % METRICS_KEYFRAME_EVERY;
+#endif
+
+    // Every row comes from the same instant, in active list order
+    schedulerGetStatsSnapshot(&g_reportSnapshot);
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    flightRecorderSnapshotBegin(g_reportSnapshot.timestamp);
+#endif
 
-    // 2. Iterate through all potential slots
-    // We use TICK_PROFILER_MAX_TASKS as defined in tick_profiler.h
-    for (uint32_t i = 0; i < TICK_PROFILER_MAX_TASKS; i++)
+    for (uint32_t i = 0; i < g_reportSnapshot.count; i++)
     {
-        // helper function to fetch stats from scheduler.c
-        // Returns true if a valid task exists at this index
-        if (schedulerGetTaskStats(i, &currentStats)) 
+        fillStatsRecord(&record, g_reportSnapshot.slot[i], &g_reportSnapshot.task[i]);
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+        flightRecorderSnapshotRow(record.task_id, record.level, record.run_ticks,
+                                  record.quantum_ticks, record.wait_ticks);
+#endif
+#if (METRICS_DIFF_REPORT_ENABLED == 1U)
+        if (!rowChanged(&record, keyframe))
         {
-            // Format and Send
-            sendLog(formatStatsLog(currentStats));
+            unchanged++;
+            continue;
         }
+#endif
+        pushSnapshot(&record);
     }
-    
-    sendLog("===================================================\r\n");
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    flightRecorderSnapshotEnd();
+#endif
+
+    memset(&record, 0, sizeof(record));
+    record.type      = METRICS_RECORD_REPORT_END;
+    record.task_id   = METRICS_TASK_ID_NONE;
+    record.timestamp = xTaskGetTickCount();
+#if (METRICS_DIFF_REPORT_ENABLED == 1U)
+    record.level     = keyframe ? METRICS_REPORT_FULL : METRICS_REPORT_DELTA;
+#endif
+    record.run_ticks = unchanged;
+    pushSnapshot(&record);
+}
+
+/*
+ * Description : Records a level transition of the task in a profiler slot.
+ * Text mode keeps the periodic table only, so this is binary-only.
+ */
+void logLevelChange(uint32_t slot, MLFQ_QueueLevel_t fromLevel,
+                    MLFQ_QueueLevel_t toLevel)
+{
+#if (METRICS_BINARY_LOG_ENABLED == 1U)
+    MLFQ_Task_Profiler_t stats;
+    MetricsRecord_t record;
+
+    if (!schedulerGetTaskStats(slot, &stats)) return;
+
+    fillStatsRecord(&record, slot, &stats);
+    record.type       = METRICS_RECORD_LEVEL_CHANGE;
+    record.level      = (uint8_t)toLevel;
+    record.prev_level = (uint8_t)fromLevel;
+    pushSnapshot(&record);
+#else
+    (void)slot;
+    (void)fromLevel;
+    (void)toLevel;
+#endif
+}
+
+/*
+ * Description : Records that a global boost moved every task to High.
+ */
+void logGlobalBoost(void)
+{
+#if (METRICS_BINARY_LOG_ENABLED == 1U)
+    MetricsRecord_t record;
+
+    memset(&record, 0, sizeof(record));
+    record.type      = METRICS_RECORD_BOOST;
+    record.task_id   = METRICS_TASK_ID_NONE;
+    record.level     = (uint8_t)MLFQ_QUEUE_HIGH;
+    record.timestamp = xTaskGetTickCount();
+    pushSnapshot(&record);
+#endif
+}
+
+/*
+ * Description : Queues an overload alarm for the logger. Text builds print
+ * it as one line; binary builds send the record as is.
+ */
+void logOverload(const MLFQ_OverloadStatus_t *status, uint32_t raised)
+{
+    MetricsRecord_t record;
+
+    memset(&record, 0, sizeof(record));
+    record.type          = METRICS_RECORD_OVERLOAD;
+    record.task_id       = (status->starving_slot < TICK_PROFILER_MAX_TASKS) ?
+                           (uint8_t)status->starving_slot : METRICS_TASK_ID_NONE;
+    record.level         = (uint8_t)status->causes;
+    record.prev_level    = (uint8_t)raised;
+    record.timestamp     = xTaskGetTickCount();
+    record.run_ticks     = status->demand_permille;
+    record.quantum_ticks = status->max_wait_us[MLFQ_QUEUE_LOW] / 1000U;
+    record.arrival_tick  = status->events;
+    pushSnapshot(&record);
+}
+
+/*
+ * Description : Queues a degraded mode change for the logger.
+ */
+void logDegradedMode(const MLFQ_OverloadStatus_t *status)
+{
+    MetricsRecord_t record;
+
+    memset(&record, 0, sizeof(record));
+    record.type         = METRICS_RECORD_DEGRADED;
+    record.task_id      = METRICS_TASK_ID_NONE;
+    record.level        = (uint8_t)status->degraded;
+    record.timestamp    = xTaskGetTickCount();
+    record.run_ticks    = status->demand_permille;
+    record.arrival_tick = status->mode_changes;
+    pushSnapshot(&record);
+}
+
+/*
+ * Description : Queues a watchdog event for the logger.
+ */
+void logWatchdog(uint32_t event, uint32_t slot, uint32_t stalledMs)
+{
+    MetricsRecord_t record;
+
+    memset(&record, 0, sizeof(record));
+    record.type          = METRICS_RECORD_WATCHDOG;
+    record.task_id       = (slot < TICK_PROFILER_MAX_TASKS) ?
+                           (uint8_t)slot : METRICS_TASK_ID_NONE;
+    record.level         = (uint8_t)event;
+    record.timestamp     = xTaskGetTickCount();
+    record.quantum_ticks = stalledMs;
+    pushSnapshot(&record);
+}
+
+/*
+ * Description : Records the name of the task in a profiler slot.
+ * The logger task looks the name up when it emits the frame.
+ */
+void logTaskName(uint32_t slot, TaskHandle_t task)
+{
+#if (METRICS_BINARY_LOG_ENABLED == 1U)
+    MetricsRecord_t record;
+
+    (void)task;
+
+    memset(&record, 0, sizeof(record));
+    record.type      = METRICS_RECORD_TASK_NAME;
+    record.task_id   = (uint8_t)slot;
+    record.timestamp = xTaskGetTickCount();
+    pushSnapshot(&record);
+#else
+    (void)slot;
+    (void)task;
+#endif
+}
+
+/*
+ * Description : Sends every task name again before its next binary
+ * record. The logger task clears its flags when it next sends a row.
+ */
+void metricsResendTaskNames(void)
+{
+#if (METRICS_BINARY_LOG_ENABLED == 1U)
+    g_namesStale = true;
+#endif
+}
+
+/*
+ * Description : Logger task. Sleeps until snapshots are queued, then
+ * drains the ring and does all formatting and UART output.
+ * With METRICS_BUDGET_ENABLED it drains the event ring first and then
+ * sends report items until the window's byte budget is spent, sleeping
+ * until the next window when the report is not finished.
+ */
+void metricsLoggerTask(void *pvParameters)
+{
+#if (METRICS_BUDGET_ENABLED == 1U)
+    const TickType_t xWindow = pdMS_TO_TICKS(METRICS_BUDGET_WINDOW_MS);
+    TickType_t xWindowStart = xTaskGetTickCount();
+    uint32_t budget = METRICS_BUDGET_BYTES;
+    MetricsRecord_t record;
+#endif
+
+    (void)pvParameters;
+
+    g_loggerTaskHandle = xTaskGetCurrentTaskHandle();
+
+#if (FLASH_LOG_ENABLED == 1U)
+    flashLogInit();
+#endif
+
+    for (;;)
+    {
+#if (METRICS_BUDGET_ENABLED == 1U)
+        TickType_t xElapsed = xTaskGetTickCount() - xWindowStart;
+
+        if (xElapsed >= xWindow)
+        {
+            xWindowStart += xElapsed - (xElapsed % xWindow);
+            xElapsed %= xWindow;
+            budget = METRICS_BUDGET_BYTES;
+        }
+
+        for (;;)
+        {
+            uint32_t before = getLogQueuedBytes();
+            uint32_t used;
+
+            // Events go first and are never held back
+            if (popSnapshot(&g_eventRing, &record))
+            {
+                emitSnapshot(&record);
+            }
+            else if ((budget == 0U) || !emitNextReportItem())
+            {
+                break;
+            }
+
+            used = getLogQueuedBytes() - before;
+            budget = (used < budget) ? (budget - used) : 0U;
+        }
+
+        // Out of budget: carry on with the report in the next window
+        TickType_t xWait = portMAX_DELAY;
+
+        if (budget == 0U)
+        {
+            xElapsed = xTaskGetTickCount() - xWindowStart;
+            xWait = (xElapsed < xWindow) ? (xWindow - xElapsed) : 0U;
+        }
+#else
+        TickType_t xWait = portMAX_DELAY;
+
+        // Snapshots queued before this task started are drained too
+        while (emitNextReportItem())
+        {
+        }
+#endif
+
+#if (FLASH_LOG_ENABLED == 1U)
+        // Flash writes stall the core, so they stay in this task
+        TickType_t xToFlash = flashLogService();
+        if (xToFlash < xWait)
+        {
+            xWait = xToFlash;
+        }
+#endif
+
+#if (MLFQ_WARM_START_ENABLED == 1U)
+        // So do the EEPROM writes of the task classes
+        TickType_t xToSave = schedulerWarmStartService();
+        if (xToSave < xWait)
+        {
+            xWait = xToSave;
+        }
+#endif
+
+        (void)ulTaskNotifyTake(pdTRUE, xWait);
+    }
+}
+
+/*
+ * Description : Returns the number of snapshots the logger task
+ * could not keep up with.
+ */
+uint32_t getMetricsDroppedSnapshots(void)
+{
+    return g_snapshotsDropped;
 }
+
+#endif /* METRICS_REPORT_ENABLED */
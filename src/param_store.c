@@ -0,0 +1,252 @@
+/******************************************************************************
+ *  MODULE NAME  : Parameter Store
+ *  FILE         : param_store.c
+ *  DESCRIPTION  : Saves and restores MLFQ_Tunables_t in the TM4C123 EEPROM
+ *                 as one versioned record protected by a CRC-32.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "param_store.h"
+
+#include "TivaWare/driverlib/sysctl.h"
+#include "TivaWare/driverlib/eeprom.h"
+#include "TivaWare/driverlib/sw_crc.h"
+
+#if (PARAM_STORE_ENABLED == 1U)
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : EEPROM image of the parameters. Word-sized fields only,
+ *               since the EEPROM is read and programmed in words.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_levels;
+    uint32_t quantum_ticks[MLFQ_NUM_LEVELS];
+    uint32_t quantum_us[MLFQ_NUM_LEVELS];
+    uint32_t boost_period_ms;
+    uint32_t reporting_enabled;
+    uint32_t crc;                 /* Crc32 of every preceding byte */
+} ParamStoreRecord_t;
+
+/*
+ * Description : EEPROM image of the class table, in words likewise;
+ *               each class word holds the level in its low byte and the
+ *               score in the next.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t name_hash[PARAM_STORE_CLASS_ENTRIES];
+    uint32_t class_word[PARAM_STORE_CLASS_ENTRIES];
+    uint32_t crc;                 /* Crc32 of every preceding byte */
+} ParamStoreClassRecord_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+static bool g_eepromReady = false;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : CRC over the record, excluding the CRC word itself.
+ */
+static uint32_t recordCrc(const ParamStoreRecord_t *record)
+{
+    return Crc32(0xFFFFFFFFUL, (const uint8_t *)record,
+                 (uint32_t)(sizeof(*record) - sizeof(record->crc)));
+}
+
+/*
+ * Description : CRC over the class table, excluding the CRC word.
+ */
+static uint32_t classRecordCrc(const ParamStoreClassRecord_t *record)
+{
+    return Crc32(0xFFFFFFFFUL, (const uint8_t *)record,
+                 (uint32_t)(sizeof(*record) - sizeof(record->crc)));
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Enables the EEPROM module and runs the TivaWare recovery
+ *               of any write interrupted by a reset.
+ */
+bool paramStoreInit(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_EEPROM0);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_EEPROM0));
+
+    g_eepromReady = (EEPROMInit() == EEPROM_INIT_OK) &&
+                    ((PARAM_STORE_EEPROM_ADDRESS + sizeof(ParamStoreRecord_t)) <=
+                     EEPROMSizeGet()) &&
+                    ((PARAM_STORE_CLASS_ADDRESS + sizeof(ParamStoreClassRecord_t)) <=
+                     EEPROMSizeGet());
+
+    return g_eepromReady;
+}
+
+/*
+ * Description : Copies a valid stored record into 'output'. The values
+ *               are not range checked here; schedulerSetTunables() does.
+ */
+bool paramStoreLoad(MLFQ_Tunables_t *output)
+{
+    ParamStoreRecord_t record;
+
+    if (!g_eepromReady || (output == NULL))
+    {
+        return false;
+    }
+
+    EEPROMRead((uint32_t *)&record, PARAM_STORE_EEPROM_ADDRESS, sizeof(record));
+
+    if ((record.magic != PARAM_STORE_MAGIC) ||
+        (record.version != PARAM_STORE_VERSION) ||
+        (record.num_levels != MLFQ_NUM_LEVELS) ||
+        (record.crc != recordCrc(&record)))
+    {
+        return false;
+    }
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        output->quantum_ticks[level] = record.quantum_ticks[level];
+        output->quantum_us[level]    = record.quantum_us[level];
+    }
+    output->boost_period_ms   = record.boost_period_ms;
+    output->reporting_enabled = (record.reporting_enabled != 0U);
+
+    return true;
+}
+
+/*
+ * Description : Programs the whole record. A reset part-way leaves a
+ *               record whose CRC fails, so the next boot falls back to
+ *               the defaults rather than a mix of old and new values.
+ */
+bool paramStoreSave(const MLFQ_Tunables_t *input)
+{
+    ParamStoreRecord_t record;
+
+    if (!g_eepromReady || (input == NULL))
+    {
+        return false;
+    }
+
+    record.magic      = PARAM_STORE_MAGIC;
+    record.version    = PARAM_STORE_VERSION;
+    record.num_levels = MLFQ_NUM_LEVELS;
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        record.quantum_ticks[level] = input->quantum_ticks[level];
+        record.quantum_us[level]    = input->quantum_us[level];
+    }
+    record.boost_period_ms   = input->boost_period_ms;
+    record.reporting_enabled = input->reporting_enabled ? 1U : 0U;
+    record.crc               = recordCrc(&record);
+
+    return EEPROMProgram((uint32_t *)&record, PARAM_STORE_EEPROM_ADDRESS,
+                         sizeof(record)) == 0U;
+}
+
+/*
+ * Description : Overwrites the magic word, which is enough to make
+ *               paramStoreLoad() reject the record.
+ */
+bool paramStoreErase(void)
+{
+    uint32_t blank = 0xFFFFFFFFUL;
+
+    if (!g_eepromReady)
+    {
+        return false;
+    }
+
+    return EEPROMProgram(&blank, PARAM_STORE_EEPROM_ADDRESS, sizeof(blank)) == 0U;
+}
+
+/*
+ * Description : Copies a valid class table. Levels and scores are not
+ *               range checked here; the scheduler clamps them.
+ */
+bool paramStoreLoadClasses(ParamStoreClass_t *output, uint32_t *count)
+{
+    ParamStoreClassRecord_t record;
+
+    if (!g_eepromReady || (output == NULL) || (count == NULL))
+    {
+        return false;
+    }
+
+    EEPROMRead((uint32_t *)&record, PARAM_STORE_CLASS_ADDRESS, sizeof(record));
+
+    if ((record.magic != PARAM_STORE_CLASS_MAGIC) ||
+        (record.version != PARAM_STORE_VERSION) ||
+        (record.count > PARAM_STORE_CLASS_ENTRIES) ||
+        (record.crc != classRecordCrc(&record)))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0U; i < record.count; i++)
+    {
+        output[i].name_hash = record.name_hash[i];
+        output[i].level     = (uint8_t)(record.class_word[i] & 0xFFU);
+        output[i].score     = (uint8_t)((record.class_word[i] >> 8U) & 0xFFU);
+    }
+    *count = record.count;
+
+    return true;
+}
+
+/*
+ * Description : Programs the whole table, unused entries zeroed so the
+ *               CRC covers a defined image. A reset part-way fails the
+ *               CRC, and the next boot starts every task cold.
+ */
+bool paramStoreSaveClasses(const ParamStoreClass_t *input, uint32_t count)
+{
+    ParamStoreClassRecord_t record;
+
+    if (!g_eepromReady || (input == NULL) || (count > PARAM_STORE_CLASS_ENTRIES))
+    {
+        return false;
+    }
+
+    record.magic   = PARAM_STORE_CLASS_MAGIC;
+    record.version = PARAM_STORE_VERSION;
+    record.count   = count;
+    for (uint32_t i = 0U; i < PARAM_STORE_CLASS_ENTRIES; i++)
+    {
+        record.name_hash[i]  = (i < count) ? input[i].name_hash : 0U;
+        record.class_word[i] = (i < count) ?
+                               ((uint32_t)input[i].level | ((uint32_t)input[i].score << 8U)) : 0U;
+    }
+    record.crc = classRecordCrc(&record);
+
+    return EEPROMProgram((uint32_t *)&record, PARAM_STORE_CLASS_ADDRESS,
+                         sizeof(record)) == 0U;
+}
+
+#endif /* PARAM_STORE_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
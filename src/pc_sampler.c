@@ -0,0 +1,140 @@
+/******************************************************************************
+ *  MODULE NAME  : PC Sampler
+ *  FILE         : pc_sampler.c
+ *  DESCRIPTION  : Counts the program counter interrupted by each tick in
+ *                 a histogram of address ranges per profiler slot, plus
+ *                 one row for the tasks the scheduler does not manage.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "pc_sampler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if (PC_SAMPLER_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Word of the stacked PC in a Cortex-M exception frame (r0-r3, r12, lr,
+ * pc, xpsr); the lazily stacked FPU registers come after it */
+#define PC_SAMPLER_FRAME_PC     6U
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* One row per slot and one for unmanaged tasks; the last bucket of each
+ * row counts the samples outside the range */
+static uint32_t g_samples[TICK_PROFILER_MAX_TASKS + 1U][PC_SAMPLER_BUCKETS + 1U];
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+#if !defined(MLFQ_HOST_SIM)
+/*
+ * Description : Returns the process stack pointer. As in TivaWare's
+ *               cpu.c, the value is left in r0 and returned by the
+ *               assembly; the return statement only keeps the compiler
+ *               quiet. It must stay a real call for that to hold.
+ */
+#pragma FUNC_CANNOT_INLINE(readProcessStack)
+static uint32_t readProcessStack(void)
+{
+    __asm("    mrs     r0, PSP\n"
+          "    bx      lr\n");
+
+    return 0U;
+}
+#endif
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called first thing in vApplicationTickHook(). SysTick
+ *               runs at the lowest priority, so it only ever interrupts
+ *               thread mode, and tasks run on the process stack: the
+ *               frame at PSP is the running task's, holding the PC it
+ *               will resume at. The host simulator has no such frame and
+ *               takes no samples.
+ */
+void pcSamplerTick(void)
+{
+#if !defined(MLFQ_HOST_SIM)
+    const uint32_t *frame = (const uint32_t *)(uintptr_t)readProcessStack();
+    uint32_t offset = frame[PC_SAMPLER_FRAME_PC] - (uint32_t)PC_SAMPLER_BASE;
+    uint32_t bucket = offset >> PC_SAMPLER_BUCKET_SHIFT;
+    int32_t slot = tickProfilerGetSlot(xTaskGetCurrentTaskHandle());
+    uint32_t row = (slot < 0) ? PC_SAMPLER_UNMANAGED : (uint32_t)slot;
+
+    /* Addresses below the base wrap to a large offset and land outside */
+    if (bucket >= PC_SAMPLER_BUCKETS)
+    {
+        bucket = PC_SAMPLER_OUTSIDE;
+    }
+
+    g_samples[row][bucket]++;
+#endif
+}
+
+/*
+ * Description : Reads one counter; a torn read is not possible on a
+ *               32-bit word, so no lock is taken.
+ */
+uint32_t pcSamplerGetCount(uint32_t row, uint32_t bucket)
+{
+    if ((row > PC_SAMPLER_UNMANAGED) || (bucket > PC_SAMPLER_OUTSIDE))
+    {
+        return 0U;
+    }
+
+    return g_samples[row][bucket];
+}
+
+/*
+ * Description : Sums a row, the outside bucket included.
+ */
+uint32_t pcSamplerGetTotal(uint32_t row)
+{
+    uint32_t total = 0U;
+
+    for (uint32_t bucket = 0U; bucket <= PC_SAMPLER_OUTSIDE; bucket++)
+    {
+        total += pcSamplerGetCount(row, bucket);
+    }
+
+    return total;
+}
+
+/*
+ * Description : Clears a slot's histogram so a new task in the slot
+ *               starts clean. Masks the tick while clearing.
+ */
+void pcSamplerResetTask(uint32_t slot)
+{
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        memset(g_samples[slot], 0, sizeof(g_samples[slot]));
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* PC_SAMPLER_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,373 @@
+/******************************************************************************
+ *  MODULE NAME  : Proportional-Share Policies
+ *  FILE         : proportional_share.c
+ *  DESCRIPTION  : Stride and lottery scheduling on top of FreeRTOS fixed
+ *                 priorities. One chosen task runs at the High level
+ *                 priority, every other registered task waits one level
+ *                 below it, and the supervisor re-chooses on each quantum
+ *                 expiry and every SCHED_POLICY_RESELECT_MS.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "sched_policy.h"
+#include "scheduler.h"
+#include "tick_profiler.h"
+#include "cycle_counter.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (SCHED_POLICY != SCHED_POLICY_MLFQ)
+
+#if (INCLUDE_eTaskGetState != 1)
+#error "Stride and lottery scheduling need INCLUDE_eTaskGetState"
+#endif
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Priority of the chosen task and of everyone else */
+#define SHARE_RUN_PRIORITY      MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH)
+#define SHARE_WAIT_PRIORITY     MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_MEDIUM)
+
+/* Stride of a one-ticket task; a task's stride is this over its tickets */
+#define STRIDE_ONE              (1UL << 20)
+
+/* Quantum use is measured in thousandths */
+#define SHARE_FULL_QUANTUM      1000U
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Tickets per profiler slot */
+static uint32_t g_tickets[TICK_PROFILER_MAX_TASKS];
+
+#if (SCHED_POLICY == SCHED_POLICY_STRIDE)
+/* Virtual time of each slot, and of the system (pass of the last choice) */
+static uint32_t g_pass[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_globalPass = 0U;
+
+/* Slots that were blocked at the last choice */
+static bool g_away[TICK_PROFILER_MAX_TASKS];
+#else
+/* xorshift32 state, seeded from the cycle counter on first use */
+static uint32_t g_random = 0U;
+#endif
+
+/* Slot running at SHARE_RUN_PRIORITY, or -1 */
+static int32_t g_chosen = -1;
+
+/* Set from the context switch when the chosen task blocks */
+static volatile bool g_reselect = false;
+
+/* Tick of the last choice */
+static uint32_t g_lastChoice = 0U;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Returns true if the task in a slot can use the CPU.
+ */
+static bool isRunnable(const TickProfilerTaskInfo_t *record)
+{
+    eTaskState state = eTaskGetState(record->task);
+
+    return (state == eRunning) || (state == eReady);
+}
+
+/*
+ * Description : Thousandths of its quantum the task in a slot has used
+ *               since it was last charged, at most one full quantum.
+ */
+static uint32_t quantumUsed(const TickProfilerTaskInfo_t *record)
+{
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    uint32_t used  = record->run_cycles;
+    uint32_t slice = record->quantum_cycles;
+#else
+    uint32_t used  = record->run_ticks;
+    uint32_t slice = record->quantum_ticks;
+#endif
+
+    if ((slice == 0U) || (used >= slice))
+    {
+        return SHARE_FULL_QUANTUM;
+    }
+
+    return (uint32_t)(((uint64_t)used * SHARE_FULL_QUANTUM) / slice);
+}
+
+/*
+ * Description : Charges a slot for the CPU it used and restarts its
+ *               quantum. Lottery keeps no history, so only the quantum
+ *               is restarted there.
+ */
+static void chargeSlot(uint32_t slot, uint32_t used)
+{
+#if (SCHED_POLICY == SCHED_POLICY_STRIDE)
+    uint32_t stride = STRIDE_ONE / g_tickets[slot];
+
+    g_pass[slot] += (uint32_t)(((uint64_t)stride * used) / SHARE_FULL_QUANTUM);
+#else
+    (void)used;
+#endif
+
+    (void)resetSlotRuntime(slot);
+}
+
+#if (SCHED_POLICY == SCHED_POLICY_STRIDE)
+/*
+ * Description : Chooses the runnable slot with the smallest pass. A task
+ *               returning from a block gets no credit for the time it
+ *               slept: its pass is raised to the global pass.
+ */
+static int32_t chooseSlot(void)
+{
+    int32_t best = -1;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if (record == NULL)
+        {
+            continue;
+        }
+
+        if (!isRunnable(record))
+        {
+            g_away[slot] = true;
+            continue;
+        }
+
+        if (g_away[slot])
+        {
+            g_away[slot] = false;
+            if ((int32_t)(g_pass[slot] - g_globalPass) < 0)
+            {
+                g_pass[slot] = g_globalPass;
+            }
+        }
+
+        if ((best < 0) || ((int32_t)(g_pass[slot] - g_pass[best]) < 0))
+        {
+            best = (int32_t)slot;
+        }
+    }
+
+    if (best >= 0)
+    {
+        g_globalPass = g_pass[best];
+    }
+
+    return best;
+}
+#else
+/*
+ * Description : Draws a winning ticket among the runnable slots.
+ */
+static int32_t chooseSlot(void)
+{
+    uint32_t total = 0U;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if ((record != NULL) && isRunnable(record))
+        {
+            total += g_tickets[slot];
+        }
+    }
+
+    if (total == 0U)
+    {
+        return -1;
+    }
+
+    if (g_random == 0U)
+    {
+        g_random = cycleCounterGet() | 1U;
+    }
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+
+    uint32_t winner = g_random % total;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if ((record != NULL) && isRunnable(record))
+        {
+            if (winner < g_tickets[slot])
+            {
+                return (int32_t)slot;
+            }
+            winner -= g_tickets[slot];
+        }
+    }
+
+    return -1;
+}
+#endif
+
+/*
+ * Description : Chooses the next task and gives every registered task
+ *               the priority that goes with the choice. Tasks admitted
+ *               by the create hook are still at the High priority until
+ *               they pass through here.
+ */
+static void reselect(uint32_t nowTicks)
+{
+    g_chosen     = chooseSlot();
+    g_reselect   = false;
+    g_lastChoice = nowTicks;
+
+    vTaskSuspendAll();
+    {
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            uint32_t slot = tickProfilerGetActiveSlot(i);
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+            if (record != NULL)
+            {
+                vTaskPrioritySet(record->task,
+                                 ((int32_t)slot == g_chosen) ? SHARE_RUN_PRIORITY :
+                                                               SHARE_WAIT_PRIORITY);
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+}
+
+/*
+ * Description : on_register. Runs in any task or in the create hook.
+ */
+static void shareOnRegister(uint32_t slot)
+{
+    g_tickets[slot] = SCHED_POLICY_DEFAULT_TICKETS;
+
+#if (SCHED_POLICY == SCHED_POLICY_STRIDE)
+    /* Join at the current virtual time */
+    g_pass[slot] = g_globalPass;
+    g_away[slot] = false;
+#endif
+}
+
+/*
+ * Description : on_quantum_expired. The expired task pays for a whole
+ *               quantum and the next one is chosen.
+ */
+static void shareOnQuantumExpired(uint32_t slot)
+{
+    chargeSlot(slot, SHARE_FULL_QUANTUM);
+    reselect(xTaskGetTickCount());
+}
+
+/*
+ * Description : on_block, from the context switch. Flags a new choice
+ *               when the chosen task gives up the CPU.
+ */
+static void shareOnBlock(uint32_t slot)
+{
+    if ((int32_t)slot == g_chosen)
+    {
+        g_reselect = true;
+    }
+}
+
+/*
+ * Description : on_periodic. Charges everyone for the CPU used since the
+ *               last choice and chooses again.
+ */
+static uint32_t shareOnPeriodic(uint32_t nowTicks)
+{
+    const uint32_t period = pdMS_TO_TICKS(SCHED_POLICY_RESELECT_MS);
+    uint32_t elapsed = nowTicks - g_lastChoice;
+
+    if (g_reselect || (elapsed >= period))
+    {
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            uint32_t slot = tickProfilerGetActiveSlot(i);
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+            if (record != NULL)
+            {
+                chargeSlot(slot, quantumUsed(record));
+            }
+        }
+
+        reselect(nowTicks);
+        return period;
+    }
+
+    return period - elapsed;
+}
+
+/*
+ * Description : pick_priority.
+ */
+static uint32_t sharePickPriority(uint32_t slot)
+{
+    return ((int32_t)slot == g_chosen) ? SHARE_RUN_PRIORITY : SHARE_WAIT_PRIORITY;
+}
+
+/******************************************************************************
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+
+#if (SCHED_POLICY == SCHED_POLICY_STRIDE)
+const SchedPolicy_t g_stridePolicy =
+{
+    "Stride",
+#else
+const SchedPolicy_t g_lotteryPolicy =
+{
+    "Lottery",
+#endif
+    shareOnRegister,
+    shareOnQuantumExpired,
+    shareOnBlock,
+    shareOnPeriodic,
+    sharePickPriority,
+};
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Sets the tickets of a slot. Takes effect at the next
+ *               choice.
+ */
+bool schedPolicySetTickets(uint32_t slot, uint32_t tickets)
+{
+    if ((tickProfilerGetRecord(slot) == NULL) ||
+        (tickets == 0U) || (tickets > SCHED_POLICY_MAX_TICKETS))
+    {
+        return false;
+    }
+
+    g_tickets[slot] = tickets;
+    return true;
+}
+
+#endif /* SCHED_POLICY != SCHED_POLICY_MLFQ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -1,245 +1,5121 @@
-/******************************************************************************
- *  MODULE NAME  : MLFQ Scheduler
- *  FILE         : scheduler.c
- *  DESCRIPTION  : Implements a Multi-Level Feedback Queue (MLFQ) scheduler
- *                 on top of FreeRTOS, handling task registration, promotion,
- *                 demotion, and periodic priority boosting.
- *  AUTHOR       : Hassan Darwish
- ******************************************************************************/
-
-/******************************************************************************
- *  INCLUDES
- ******************************************************************************/
-#include "scheduler.h"
-#include "metrics_logger.h"
-#include "drivers.h"
-#include <stdlib.h>
-
-/******************************************************************************
- *  STATIC (PRIVATE) VARIABLES
- ******************************************************************************/
-/* Task table holding MLFQ-related metadata for all registered tasks */
-static MLFQ_TCB_t g_taskTable[TICK_PROFILER_MAX_TASKS];
-
-/******************************************************************************
- *  STATIC (PRIVATE) FUNCTION DEFINITIONS
- *****************************************************************************-0---*/
-
-/*
- * Description : Returns the time quantum assigned to a specific MLFQ level.
- *               Higher priority queues receive shorter response-focused
- *               time slices, while lower levels get longer CPU bursts.
- */
-static uint32_t getQuantumForLevel(MLFQ_QueueLevel_t level)
-{
-    switch(level) {
-        case MLFQ_QUEUE_HIGH:   return MLFQ_TIME_SLICE_HIGH;
-        case MLFQ_QUEUE_MEDIUM: return MLFQ_TIME_SLICE_MEDIUM;
-        case MLFQ_QUEUE_LOW:    return MLFQ_TIME_SLICE_LOW;
-        default:                return MLFQ_TIME_SLICE_LOW;
-    }
-}
-
-/******************************************************************************
- *  FUNCTION DEFINITIONS
- ******************************************************************************/
-
-/*
- * Description : Initializes the scheduler subsystem.
- *               Sets up the tick profiler and clears the
- *               internal task table entries.
- */
-void initScheduler(void)
-{
-    /* Initialize runtime profiling system */
-    tickProfilerInit();
-
-    /* Clear task table */
-    for (uint8_t table_index = 0; table_index < TICK_PROFILER_MAX_TASKS; table_index++)
-    {
-        g_taskTable[table_index].task_handle = NULL;
-        g_taskTable[table_index].task_level = MLFQ_QUEUE_HIGH;
-        g_taskTable[table_index].arrival_tick = 0;
-    }
-}
-
-/*
- * Description : Registers a new task with the scheduler.
- *               Initializes profiling data, assigns the
- *               highest priority queue, and sets the initial
- *               quantum and arrival timestamp.
- */
-void registerTask(TaskHandle_t taskHandle)
-{
-    for (uint8_t table_index = 0; table_index < TICK_PROFILER_MAX_TASKS; table_index++)
-    {
-        if (g_taskTable[table_index].task_handle == NULL)
-        {
-            /* Initialize profiler statistics for the task */
-            if (!setupTaskStats(taskHandle))
-            {
-                break;
-            }
-            else
-            {
-                g_taskTable[table_index].task_handle = taskHandle;
-                g_taskTable[table_index].task_level = MLFQ_QUEUE_HIGH;
-                g_taskTable[table_index].arrival_tick = xTaskGetTickCount();
-
-                /* Assign highest RTOS priority */
-                vTaskPrioritySet(taskHandle,
-                                 MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH));
-
-                /* Assign initial quantum */
-                setTaskQuantum(taskHandle, MLFQ_TIME_SLICE_HIGH);
-
-                break;
-            }
-        }
-    }
-}
-
-/*
- * Description : Updates the scheduling level of a task.
- *               This includes updating the internal MLFQ table,
- *               adjusting the FreeRTOS priority, resetting runtime
- *               statistics, assigning a new time quantum, and
- *               reflecting the change using system LEDs.
- */
-void updateTaskPriority(TaskHandle_t task, MLFQ_QueueLevel_t newLevel)
-{
-    for (uint8_t table_index = 0; table_index < TICK_PROFILER_MAX_TASKS; table_index++)
-    {
-        if (g_taskTable[table_index].task_handle == task)
-        {
-            g_taskTable[table_index].task_level = newLevel;
-
-            /* Update RTOS priority according to MLFQ level */
-            vTaskPrioritySet(task, MLFQ_TO_RTOS_LEVEL_SETTER(newLevel));
-
-            /* Reset runtime statistics and apply new quantum */
-            setTaskQuantum(task, getQuantumForLevel(newLevel));
-            resetTaskRuntime(task);
-
-            /* Visual indication of task level */
-            setLEDColor(newLevel);
-            return;
-        }
-    }
-}
-
-/*
- * Description : Demotes a task to a lower priority queue
- *               when it exhausts its assigned time quantum.
- *               Tasks at the lowest level remain there.
- */
-void checkForDemotion(uint8_t table_index)
-{
-    TaskHandle_t task = g_taskTable[table_index].task_handle;
-    MLFQ_QueueLevel_t currentLevel = g_taskTable[table_index].task_level;
-
-    if(currentLevel < MLFQ_QUEUE_LOW)
-    {
-        updateTaskPriority(task, (MLFQ_QueueLevel_t)(currentLevel + 1));
-    }
-    else
-    {
-        updateTaskPriority(task, MLFQ_QUEUE_LOW);
-    }
-}
-
-/*
- * Description : Performs a global priority boost.
- *               Periodically elevates all tasks back to
- *               the highest priority queue to prevent starvation.
- */
-void performGlobalBoost(void)
-{
-    for (uint8_t table_index = 0; table_index < TICK_PROFILER_MAX_TASKS; table_index++)
-    {
-        if (g_taskTable[table_index].task_handle != NULL)
-        {
-            updateTaskPriority(g_taskTable[table_index].task_handle,
-                               MLFQ_QUEUE_HIGH);
-        }
-    }
-}
-
-/*
- * Description : Dedicated scheduler task.
- *               Handles task demotion events, periodic global
- *               priority boosts, and system monitoring reports.
- */
-void schedulerTask(void *pvParameters)
-{
-    /* Register scheduler task with profiler */
-    tickProfilerSetSchedulerTaskHandle(xTaskGetCurrentTaskHandle());
-
-    /* Retrieve expired-quantum notification queue */
-    QueueHandle_t expiredQueue = tickProfilerGetExpiredQueue();
-    TaskHandle_t xExpiredHandle = NULL;
-
-    /* Global boost timing control */
-    TickType_t xLastBoostTime = xTaskGetTickCount();
-    const TickType_t xBoostPeriod = pdMS_TO_TICKS(MLFQ_BOOST_PERIOD_MS);
-
-    for (;;)
-    {
-        /* 1. Handle task demotions */
-        while (xQueueReceive(expiredQueue, &xExpiredHandle, 0) == pdTRUE)
-        {
-            for (uint8_t i = 0; i < TICK_PROFILER_MAX_TASKS; i++)
-            {
-                if (g_taskTable[i].task_handle == xExpiredHandle)
-                {
-                    checkForDemotion(i);
-                    break;
-                }
-            }
-        }
-
-        /* 2. Periodic global boost and reporting */
-        TickType_t xNow = xTaskGetTickCount();
-        if ((xNow - xLastBoostTime) >= xBoostPeriod)
-        {
-            printQueueReport();
-
-            performGlobalBoost();
-
-            xLastBoostTime = xNow;
-        }
-
-        /* 3. Scheduler idle delay */
-        vTaskDelay(pdMS_TO_TICKS(10));
-    }
-}
-
-/*
- * Description : Retrieves MLFQ and runtime profiling information
- *               for a task indexed in the scheduler table.
- */
-bool schedulerGetTaskStats(uint32_t index, MLFQ_Task_Profiler_t *output)
-{
-    if (index >= TICK_PROFILER_MAX_TASKS ||
-        g_taskTable[index].task_handle == NULL)
-    {
-        return false;
-    }
-
-    /* Copy scheduler metadata */
-    output->task_info.task  = g_taskTable[index].task_handle;
-    output->task_level      = g_taskTable[index].task_level;
-    output->arrival_tick    = g_taskTable[index].arrival_tick;
-
-    /* Copy live profiler statistics */
-    output->task_info.run_ticks     =
-        getTaskRuntime(output->task_info.task);
-    output->task_info.quantum_ticks =
-        getQuantumForLevel(output->task_level);
-
-    return true;
-}
-
-/******************************************************************************
- *  END OF FILE
- ******************************************************************************/
+/******************************************************************************
+ *  MODULE NAME  : MLFQ Scheduler
+ *  FILE         : scheduler.c
+ *  DESCRIPTION  : Implements a Multi-Level Feedback Queue (MLFQ) scheduler
+ *                 on top of FreeRTOS, handling task registration, promotion,
+ *                 demotion, and periodic priority boosting.
+ *  AUTHOR       : Hassan Darwish
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "scheduler.h"
+#include "metrics_logger.h"
+#include "drivers.h"
+#include "cycle_counter.h"
+#include "event_trace.h"
+#include "latency_stats.h"
+#include "burst_stats.h"
+#include "aging.h"
+#include "wake_period.h"
+#include "interactivity.h"
+#include "inversion_stats.h"
+#include "wait_stats.h"
+#include "pc_sampler.h"
+#include "state_time.h"
+#include "param_store.h"
+#include "sched_policy.h"
+#include "task_pool.h"
+#include "gpio_probe.h"
+#include "flight_recorder.h"
+#include <stdlib.h>
+
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+#include "timers.h"
+#endif
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Kernel-native demotion is the MLFQ rule applied in the tick, in ticks */
+#if (configUSE_MLFQ_NATIVE == 1)
+#if (SCHED_POLICY != SCHED_POLICY_MLFQ)
+#error "configUSE_MLFQ_NATIVE needs SCHED_POLICY_MLFQ"
+#endif
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+#error "configUSE_MLFQ_NATIVE and TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED are exclusive"
+#endif
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+#error "configUSE_MLFQ_NATIVE keeps the quantum in the kernel; budget windows need the profiler quantum"
+#endif
+#endif
+
+/* Degraded mode is entered from the overload check */
+#if (MLFQ_DEGRADE_ENABLED == 1U) && (MLFQ_OVERLOAD_ENABLED == 0U)
+#error "MLFQ_DEGRADE_ENABLED needs MLFQ_OVERLOAD_ENABLED"
+#endif
+
+/* Warm start keeps its table in the EEPROM and writes it from the logger */
+#if (MLFQ_WARM_START_ENABLED == 1U)
+#if (PARAM_STORE_ENABLED == 0U)
+#error "MLFQ_WARM_START_ENABLED needs PARAM_STORE_ENABLED"
+#endif
+#if (METRICS_REPORT_ENABLED == 0U)
+#error "MLFQ_WARM_START_ENABLED saves from the logger task (METRICS_REPORT_ENABLED)"
+#endif
+#endif
+
+/* A saved score this close to the current one is not rewritten, so the
+ * table is only programmed when a task's class has really moved */
+#define WARM_START_SCORE_SLACK                  10U
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Cost metrics of the global boost */
+static MLFQ_BoostStats_t g_boostStats;
+
+/* Expiry-to-policy latency, written by the supervisor */
+static MLFQ_ExpiryLatencyStats_t g_expiryLatency;
+
+/* Level changes that moved a task down, and up outside a boost, since
+ * init; wrap */
+static volatile uint32_t g_demotionCount = 0U;
+static volatile uint32_t g_promotionCount = 0U;
+
+/* Supervisor passes since init; wraps */
+static volatile uint32_t g_supervisorPasses = 0U;
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+/* Periodic tasks moved to High ahead of their wake, since init; wraps */
+static volatile uint32_t g_prePromotions = 0U;
+#endif
+
+/* Level changes applied to the kernel, and those skipped because the
+ * task already had the level and its priority */
+static MLFQ_LevelChangeStats_t g_levelChanges;
+
+/* Parameters in force, written only by initScheduler and the supervisor */
+static MLFQ_Tunables_t g_tunables;
+
+/* Parameter set waiting for the supervisor and the request flags */
+static MLFQ_Tunables_t g_pendingTunables;
+static volatile bool g_tunablesPending = false;
+static volatile bool g_reportRequested = false;
+
+#if (MLFQ_REPORT_ON_DEMAND_ENABLED == 1U)
+/* Host report lease (schedulerWatchReports): its start and length in
+ * ticks, 0 for none */
+static TickType_t g_reportLeaseStart = 0U;
+static TickType_t g_reportLeaseTicks = 0U;
+#endif
+
+/* Whether the last supervisor pass found a report reader; always true
+ * without on-demand reports */
+static bool g_reportReader = true;
+
+/* Levels in use in the default partition, and a count waiting for the
+ * supervisor (0 = none) */
+static uint32_t g_levelCount = MLFQ_NUM_LEVELS;
+static volatile uint32_t g_pendingLevelCount = 0U;
+
+/* Supervisor task, NULL until schedulerTask starts */
+static TaskHandle_t g_supervisorHandle = NULL;
+
+/* Supervisor pass state: the last report, the report period in force and
+ * the time the policy asked to sleep for */
+static TickType_t g_lastReportTick = 0U;
+static TickType_t g_reportPeriod = 0U;
+static TickType_t g_timeToPolicy = 0U;
+
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+/* Timer re-armed with each pass's timeout, and the flag that keeps one
+ * deferred pass at most in the timer command queue */
+static TimerHandle_t g_supervisorTimer = NULL;
+static volatile bool g_passPending = false;
+
+static void supervisorDeferredPass(void *pvParameter1, uint32_t ulParameter2);
+#endif
+
+/* Tick of the last global boost and of the last policy scan, and the
+ * rolling-boost slice due next */
+static TickType_t g_lastBoostTick = 0U;
+static uint32_t g_boostSlice = 0U;
+
+/* Boost period in force: the tunable, or its auto-tuned value */
+static uint32_t g_boostPeriodMs = MLFQ_BOOST_PERIOD_MS;
+
+#if (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+/* Boost auto-tuning: tick of the last Low wait check and the longest Low
+ * wait seen since the last boost, in microseconds */
+static TickType_t g_lastTuneTick = 0U;
+static uint32_t g_tuneMaxWaitUs = 0U;
+#endif
+#if (MLFQ_POLICY_SCAN_ENABLED)
+static TickType_t g_lastScanTick = 0U;
+#endif
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U)
+/* Slots below High, whose policy timers are armed, as of the last sync */
+static uint32_t g_timedSlots[TICK_PROFILER_SLOT_MASK_WORDS];
+#endif
+
+#if (MLFQ_RESERVE_ENABLED == 1U)
+/* Low-level reservation: start of the current period, the Low CPU time
+ * at that start, and whether the Low tasks run at MLFQ_RESERVE_PRIORITY */
+static TickType_t g_reserveStart = 0U;
+static uint64_t g_reserveLowAtStart = 0U;
+static volatile bool g_reserveServing = false;
+#endif
+
+#if (MLFQ_OVERLOAD_ENABLED == 1U)
+/* Overload state, the alarm hook, and the tick and CPU time of the last
+ * check */
+static MLFQ_OverloadStatus_t g_overload = { .starving_slot = TICK_PROFILER_MAX_TASKS };
+static MLFQ_OverloadHook_t g_overloadHook = NULL;
+static TickType_t g_lastOverloadTick = 0U;
+static TickProfilerCpuTime_t g_overloadCpu;
+#endif
+
+#if (MLFQ_DEGRADE_ENABLED == 1U)
+/* Degraded mode, the tick the demand last fell under the exit threshold
+ * (valid while g_degradeCalm), and the Low tasks it suspended, by slot */
+static volatile bool g_degraded = false;
+static bool g_degradeCalm = false;
+static TickType_t g_degradeCalmSince = 0U;
+#if (MLFQ_DEGRADE_SUSPEND_LOW == 1U)
+static TaskHandle_t g_degradeSuspended[TICK_PROFILER_MAX_TASKS];
+#endif
+#endif
+
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+/* Home core of every slot, and the slots whose affinity the supervisor
+ * has still to set (registration may run in the create hook) */
+static uint8_t g_homeCore[TICK_PROFILER_MAX_TASKS];
+static volatile bool g_homePending[TICK_PROFILER_MAX_TASKS];
+
+/* Per core: idle and total CPU time at the last check, the busy share
+ * over the window it closed and the tasks it stole. Supervisor only */
+static uint64_t g_coreIdleLast[TICK_PROFILER_CORES];
+static uint64_t g_coreTotalLast[TICK_PROFILER_CORES];
+static uint32_t g_coreBusy[TICK_PROFILER_CORES];
+static uint32_t g_coreSteals[TICK_PROFILER_CORES];
+static uint32_t g_migrations = 0U;
+static TickType_t g_lastBalanceTick = 0U;
+#endif
+
+#if (MLFQ_WATCHDOG_ENABLED == 1U)
+/* Starvation watchdog, per slot: the task last seen there, its CPU time
+ * then, and the last tick it ran or was not ready. Supervisor only */
+static TaskHandle_t g_watchTask[TICK_PROFILER_MAX_TASKS];
+static uint64_t g_watchTime[TICK_PROFILER_MAX_TASKS];
+static TickType_t g_watchProgress[TICK_PROFILER_MAX_TASKS];
+static TickType_t g_lastWatchdogTick = 0U;
+static bool g_watchdogStarved = false;
+#endif
+
+/* Slots whose task name the supervisor has yet to log. Registration can
+ * happen in any task or in the kernel create hook, while the snapshot
+ * ring accepts a single producer, so names go through the supervisor. */
+static volatile bool g_namePending[TICK_PROFILER_MAX_TASKS];
+
+/* Tasks pinned outside the MLFQ band (NULL = free entry) */
+static TaskHandle_t g_pinnedTasks[MLFQ_MAX_PINNED_TASKS];
+
+/* Deepest level each slot may be demoted to (schedulerSetLatencyTarget) */
+static uint8_t g_levelFloor[TICK_PROFILER_MAX_TASKS];
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+/* Weight of each slot, and the Low tasks parked until the round ends */
+static uint8_t g_taskWeight[TICK_PROFILER_MAX_TASKS];
+static bool g_weightParked[TICK_PROFILER_MAX_TASKS];
+#endif
+
+#if (MLFQ_BOTTOM_HALF_ENABLED == 1U)
+/* High budget of each bottom half in us (0 = ordinary task), and its
+ * activations in a row that ran past the budget */
+static uint32_t g_bottomHalfBudgetUs[TICK_PROFILER_MAX_TASKS];
+static uint8_t g_bottomHalfStrikes[TICK_PROFILER_MAX_TASKS];
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+/* Core at SYSTEM_CLOCK_SLOW_CONFIG; from the moment it is set the ready
+ * hook asks for full speed back */
+static volatile bool g_clockSlow = false;
+static volatile bool g_clockRestoreWanted = false;
+
+/* Tick of the last change of speed, and the counters */
+static TickType_t g_clockChangeTick = 0U;
+static MLFQ_ClockStats_t g_clockStats;
+#endif
+
+#if (MLFQ_GROUPS_ENABLED == 1U)
+/* Groups (group 0 is the default one and takes the share left over),
+ * the group of each slot, and the summed weights of each group's
+ * members and of every registered task, kept in step on every change */
+static MLFQ_GroupInfo_t g_groups[MLFQ_MAX_GROUPS] =
+{
+    [MLFQ_GROUP_DEFAULT] = { "Default", 100U, 0U },
+};
+static uint8_t g_slotGroup[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_groupWeight[MLFQ_MAX_GROUPS];
+static uint32_t g_totalWeight = 0U;
+#endif
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+/* Partitions (partition 0 is the default one; its band and boost period
+ * are the level table's and the tunables'), the partition of each slot,
+ * the tick of each partition's last boost and the partitions created */
+static MLFQ_PartitionInfo_t g_partitions[MLFQ_MAX_PARTITIONS] =
+{
+    [MLFQ_PARTITION_DEFAULT] = { "Default", 0U, MLFQ_NUM_LEVELS, 100U, 0U, 0U, 0U },
+};
+static uint8_t g_slotPartition[TICK_PROFILER_MAX_TASKS];
+static TickType_t g_partitionBoostTick[MLFQ_MAX_PARTITIONS];
+static uint32_t g_partitionsCreated = 0U;
+#endif
+
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+/* Event boost bindings: the object (NULL = free entry), the event group
+ * bits it fires on (0 = any send, give or set) and the slots it moves
+ * to High. The hook marks fired bindings in the pending mask; the
+ * supervisor takes it. Bindings in use, and tasks promoted since init */
+static const void *g_eventObject[MLFQ_EVENT_BOOST_MAX_BINDINGS];
+static uint32_t g_eventBits[MLFQ_EVENT_BOOST_MAX_BINDINGS];
+static uint32_t g_eventSlots[MLFQ_EVENT_BOOST_MAX_BINDINGS][TICK_PROFILER_SLOT_MASK_WORDS];
+static volatile uint32_t g_eventBoostPending = 0U;
+static volatile uint32_t g_eventBindings = 0U;
+static volatile uint32_t g_eventBoosts = 0U;
+#endif
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+/* Level-change callback and its argument per slot (NULL = none), the
+ * level before the first change not yet reported, and the slots with a
+ * change waiting for the supervisor */
+static MLFQ_LevelCallback_t g_levelCallback[TICK_PROFILER_MAX_TASKS];
+static void *g_levelCallbackContext[TICK_PROFILER_MAX_TASKS];
+static uint8_t g_levelCallbackFrom[TICK_PROFILER_MAX_TASKS];
+static volatile uint32_t g_levelCallbackPending[TICK_PROFILER_SLOT_MASK_WORDS];
+#endif
+
+#if (MLFQ_WARM_START_ENABLED == 1U)
+/* Class table as last loaded or saved, the deepest level each slot has
+ * reached since the last save, and the tick of that save */
+static ParamStoreClass_t g_warmClasses[PARAM_STORE_CLASS_ENTRIES];
+static uint32_t g_warmClassCount = 0U;
+static volatile uint8_t g_warmDeepest[TICK_PROFILER_MAX_TASKS];
+static TickType_t g_warmLastSave = 0U;
+#endif
+
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+/* Kernel ready-bitmap bits of the MLFQ band, and the level of each one */
+static uint32_t g_levelPriorityMask = 0U;
+static uint8_t g_levelOfPriority[configMAX_PRIORITIES];
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ *****************************************************************************-0---*/
+
+/*
+ * Description : Returns the time quantum assigned to a specific MLFQ level.
+ *               Higher priority queues receive shorter response-focused
+ *               time slices, while lower levels get longer CPU bursts.
+ *               Inline: it is on the path of every level change.
+ */
+static inline uint32_t getQuantumForLevel(MLFQ_QueueLevel_t level)
+{
+    if ((uint32_t)level >= MLFQ_NUM_LEVELS)
+    {
+        level = MLFQ_QUEUE_LOW;
+    }
+
+    return g_tunables.quantum_ticks[level];
+}
+
+/*
+ * Description : Scales a quantum by the weight of a slot, keeping at
+ *               least one unit so a light task still runs. With groups,
+ *               the Low quantum is scaled by the task's part of its
+ *               group's share instead:
+ *               weight * share * all weights / (100 * group weights),
+ *               which sums to the group's share of the Low round.
+ */
+static uint32_t weightedQuantum(uint32_t slot, MLFQ_QueueLevel_t level, uint32_t quantum)
+{
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    uint64_t weight = g_taskWeight[slot];
+
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    if (level == MLFQ_QUEUE_LOW)
+    {
+        uint32_t group = g_slotGroup[slot];
+
+        if (g_groupWeight[group] != 0U)
+        {
+            weight = (weight * g_groups[group].share_percent * g_totalWeight) /
+                     (100U * (uint64_t)g_groupWeight[group]);
+        }
+    }
+#else
+    (void)level;
+#endif
+
+    uint32_t scaled = (uint32_t)(((uint64_t)quantum * weight) / MLFQ_WEIGHT_DEFAULT);
+
+    return (scaled == 0U) ? 1U : scaled;
+#else
+    (void)slot;
+    (void)level;
+    return quantum;
+#endif
+}
+
+/*
+ * Description : Scales a quantum by the quantum percentage of the slot's
+ *               partition, keeping at least one unit.
+ */
+static uint32_t partitionQuantum(uint32_t slot, uint32_t quantum)
+{
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    uint32_t scaled = (uint32_t)(((uint64_t)quantum *
+                                  g_partitions[g_slotPartition[slot]].quantum_percent) / 100U);
+
+    return (scaled == 0U) ? 1U : scaled;
+#else
+    (void)slot;
+    return quantum;
+#endif
+}
+
+/*
+ * Description : Shrinks a quantum while degraded mode is in force: the
+ *               levels between High and Low get
+ *               MLFQ_DEGRADE_MEDIUM_PERCENT of it and Low
+ *               MLFQ_DEGRADE_LOW_PERCENT, keeping at least one unit.
+ */
+static uint32_t degradedQuantum(MLFQ_QueueLevel_t level, uint32_t quantum)
+{
+#if (MLFQ_DEGRADE_ENABLED == 1U)
+    if (!g_degraded || (level == MLFQ_QUEUE_HIGH))
+    {
+        return quantum;
+    }
+
+    uint32_t percent = ((uint32_t)level >= (uint32_t)MLFQ_QUEUE_LOW) ?
+                       MLFQ_DEGRADE_LOW_PERCENT : MLFQ_DEGRADE_MEDIUM_PERCENT;
+    uint32_t scaled = (uint32_t)(((uint64_t)quantum * percent) / 100U);
+
+    return (scaled == 0U) ? 1U : scaled;
+#else
+    (void)level;
+    return quantum;
+#endif
+}
+
+/*
+ * Description : Lengthens the quantum of a task below High whose context
+ *               saves mostly held FPU state, once it has made
+ *               MLFQ_FPU_SLICE_MIN_SAVES of them.
+ */
+static uint32_t fpuQuantum(uint32_t slot, MLFQ_QueueLevel_t level, uint32_t quantum)
+{
+#if (MLFQ_FPU_SLICE_ENABLED == 1U)
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if ((record == NULL) || (level == MLFQ_QUEUE_HIGH))
+    {
+        return quantum;
+    }
+
+    uint32_t saves = record->context_saves;
+    uint32_t fpuSaves = record->fpu_saves;
+
+    if ((saves < MLFQ_FPU_SLICE_MIN_SAVES) ||
+        (((uint64_t)fpuSaves * 100U) < ((uint64_t)saves * MLFQ_FPU_SLICE_SHARE_PERCENT)))
+    {
+        return quantum;
+    }
+
+    return (uint32_t)(((uint64_t)quantum * MLFQ_FPU_SLICE_PERCENT) / 100U);
+#else
+    (void)slot;
+    (void)level;
+    return quantum;
+#endif
+}
+
+#if (MLFQ_BOTTOM_HALF_ENABLED == 1U)
+/*
+ * Description : Programs the budget of a bottom half as its High
+ *               quantum: in cycles with the GPTM quantum timer, else
+ *               rounded up to whole ticks. Weights do not scale it.
+ */
+static void applyBottomHalfBudget(uint32_t slot)
+{
+    uint32_t budgetUs = g_bottomHalfBudgetUs[slot];
+
+#if (configUSE_MLFQ_NATIVE == 1)
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+    uint32_t ticks = (budgetUs + MLFQ_TICKS_TO_US(1U) - 1U) / MLFQ_TICKS_TO_US(1U);
+
+    if (record != NULL)
+    {
+        vTaskMlfqSetLevel(record->task, (UBaseType_t)MLFQ_QUEUE_HIGH, (UBaseType_t)ticks);
+    }
+    setSlotQuantum(slot, ticks);
+#elif (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+    setSlotQuantumCycles(slot, TICK_PROFILER_US_TO_CYCLES(budgetUs));
+#else
+    setSlotQuantum(slot, (budgetUs + MLFQ_TICKS_TO_US(1U) - 1U) / MLFQ_TICKS_TO_US(1U));
+#endif
+}
+#endif
+
+/*
+ * Description : Programs the profiler quantum for a task at a level,
+ *               scaled by the task's weight and partition, lengthened for
+ *               an FPU-heavy task and cut in degraded mode.
+ *               With the GPTM quantum timer
+ *               the microsecond slice is used so quanta are not rounded
+ *               to the RTOS tick. With kernel-native MLFQ the TCB gets
+ *               the level and quantum too. A bottom half gets its budget
+ *               at High instead.
+ */
+static void applyLevelQuantum(uint32_t slot, MLFQ_QueueLevel_t level)
+{
+#if (MLFQ_BOTTOM_HALF_ENABLED == 1U)
+    if ((level == MLFQ_QUEUE_HIGH) && (g_bottomHalfBudgetUs[slot] != 0U))
+    {
+        applyBottomHalfBudget(slot);
+        return;
+    }
+#endif
+
+#if (configUSE_MLFQ_NATIVE == 1)
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if ((uint32_t)level >= MLFQ_NUM_LEVELS)
+    {
+        level = MLFQ_QUEUE_LOW;
+    }
+
+    if (record != NULL)
+    {
+        vTaskMlfqSetLevel(record->task, (UBaseType_t)level,
+                          (UBaseType_t)degradedQuantum(level, fpuQuantum(slot, level,
+                                                       partitionQuantum(slot, g_tunables.quantum_ticks[level]))));
+    }
+    setSlotQuantum(slot, degradedQuantum(level, fpuQuantum(slot, level,
+                                                           partitionQuantum(slot, getQuantumForLevel(level)))));
+#elif (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+    if ((uint32_t)level >= MLFQ_NUM_LEVELS)
+    {
+        level = MLFQ_QUEUE_LOW;
+    }
+
+    setSlotQuantumCycles(slot, degradedQuantum(level, fpuQuantum(slot, level,
+                         weightedQuantum(slot, level, partitionQuantum(slot,
+                         TICK_PROFILER_US_TO_CYCLES(g_tunables.quantum_us[level]))))));
+#else
+    setSlotQuantum(slot, degradedQuantum(level, fpuQuantum(slot, level,
+                   weightedQuantum(slot, level, partitionQuantum(slot, getQuantumForLevel(level))))));
+#endif
+}
+
+/*
+ * Description : Returns the FreeRTOS priority for a level. Low tasks run
+ *               at the reservation priority while the reservation is
+ *               being served.
+ */
+static UBaseType_t levelPriority(MLFQ_QueueLevel_t level)
+{
+#if (MLFQ_RESERVE_ENABLED == 1U)
+    if ((level == MLFQ_QUEUE_LOW) && g_reserveServing)
+    {
+        return (UBaseType_t)MLFQ_RESERVE_PRIORITY;
+    }
+#endif
+
+    return (UBaseType_t)MLFQ_TO_RTOS_LEVEL_SETTER(level);
+}
+
+/*
+ * Description : Returns the FreeRTOS priority for a slot at a level: its
+ *               partition's band, or levelPriority() in the default one.
+ */
+static UBaseType_t slotLevelPriority(uint32_t slot, MLFQ_QueueLevel_t level)
+{
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    uint32_t partition = g_slotPartition[slot];
+
+    if (partition != MLFQ_PARTITION_DEFAULT)
+    {
+        return (UBaseType_t)(g_partitions[partition].top_priority - (uint32_t)level);
+    }
+#else
+    (void)slot;
+#endif
+
+    return levelPriority(level);
+}
+
+/*
+ * Description : Limits a level to the deepest one of the slot's
+ *               partition; in the default partition, to the deepest of
+ *               the levels in use (schedulerSetLevelCount).
+ */
+static MLFQ_QueueLevel_t partitionLevel(uint32_t slot, MLFQ_QueueLevel_t level)
+{
+    uint32_t deepest = g_levelCount - 1U;
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    if (g_slotPartition[slot] != MLFQ_PARTITION_DEFAULT)
+    {
+        deepest = g_partitions[g_slotPartition[slot]].levels - 1U;
+    }
+#else
+    (void)slot;
+#endif
+
+    if ((uint32_t)level > deepest)
+    {
+        return (MLFQ_QueueLevel_t)deepest;
+    }
+
+    return level;
+}
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+/*
+ * Description : Notes a level change for the slot's callback, keeping
+ *               the level of the first change since the last report.
+ *               Called from task context and from the tick interrupt.
+ */
+static void markLevelChange(uint32_t slot, MLFQ_QueueLevel_t oldLevel)
+{
+    uint32_t mask = 1UL << (slot % 32U);
+
+    if (g_levelCallback[slot] == NULL)
+    {
+        return;
+    }
+
+    UBaseType_t uxSaved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if ((g_levelCallbackPending[slot / 32U] & mask) == 0U)
+        {
+            g_levelCallbackFrom[slot] = (uint8_t)oldLevel;
+            g_levelCallbackPending[slot / 32U] |= mask;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSaved);
+}
+#endif
+
+#if (MLFQ_WARM_START_ENABLED == 1U)
+/*
+ * Description : FNV-1a hash of a task name, the key of its saved class.
+ */
+static uint32_t warmNameHash(const char *name)
+{
+    uint32_t hash = 2166136261UL;
+
+    while (*name != '\0')
+    {
+        hash ^= (uint8_t)*name;
+        hash *= 16777619UL;
+        name++;
+    }
+
+    return hash;
+}
+
+/*
+ * Description : Returns the saved class of a name hash, or NULL.
+ */
+static const ParamStoreClass_t *warmFindClass(uint32_t hash)
+{
+    for (uint32_t i = 0U; i < g_warmClassCount; i++)
+    {
+        if (g_warmClasses[i].name_hash == hash)
+        {
+            return &g_warmClasses[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Description : Notes the level a slot moved to if it is the deepest
+ *               since the last save. Called from task context and from
+ *               the tick interrupt; a byte store, so no lock.
+ */
+static inline void warmNoteLevel(uint32_t slot, MLFQ_QueueLevel_t level)
+{
+    if ((uint8_t)level > g_warmDeepest[slot])
+    {
+        g_warmDeepest[slot] = (uint8_t)level;
+    }
+}
+#endif
+
+/*
+ * Description : Moves the task in a profiler slot to a new level.
+ *               Updates the shared record, the FreeRTOS priority,
+ *               and the quantum and runtime statistics. A task that
+ *               already has the level and its priority (a Low task
+ *               demoted again, say) only gets its runtime reset, which
+ *               re-arms the expiry of its next quantum; the priority,
+ *               the level sets and the quantum are left alone.
+ */
+static void setSlotLevel(uint32_t slot, MLFQ_QueueLevel_t newLevel)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if (record == NULL)
+    {
+        return;
+    }
+
+    /* A partition with fewer levels keeps its tasks at its deepest */
+    newLevel = partitionLevel(slot, newLevel);
+
+    MLFQ_QueueLevel_t oldLevel = (MLFQ_QueueLevel_t)record->level;
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    bool parked = g_weightParked[slot];
+#else
+    bool parked = false;
+#endif
+
+    if ((newLevel == oldLevel) && !parked)
+    {
+#if (configUSE_MLFQ_NATIVE == 1)
+        /* The kernel keeps its own count of the quantum */
+        applyLevelQuantum(slot, newLevel);
+#endif
+        resetSlotRuntime(slot);
+        g_levelChanges.coalesced++;
+        return;
+    }
+
+    g_levelChanges.applied++;
+    tickProfilerSetLevel(slot, (uint8_t)newLevel);
+
+    /* Update RTOS priority according to MLFQ level. This is the base
+     * priority: a mutex holder keeps any priority it has inherited until
+     * it gives the mutex back, then drops to the new level. */
+    vTaskPrioritySet(record->task, slotLevelPriority(slot, newLevel));
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    g_weightParked[slot] = false;
+#endif
+
+    /* Reset runtime statistics and apply new quantum */
+    applyLevelQuantum(slot, newLevel);
+    resetSlotRuntime(slot);
+
+    if (newLevel > oldLevel)
+    {
+        g_demotionCount++;
+        GPIO_PROBE_PULSE(GPIO_PROBE_PIN_DEMOTION);
+    }
+    else if (newLevel < oldLevel)
+    {
+        g_promotionCount++;
+    }
+
+    if (oldLevel != newLevel)
+    {
+#if (EVENT_TRACE_ENABLED == 1U)
+        eventTraceRecord((newLevel > oldLevel) ? EVENT_TRACE_DEMOTION : EVENT_TRACE_PROMOTION,
+                         (void *)record->task, (uint8_t)oldLevel, (uint8_t)newLevel);
+#endif
+        if (g_reportReader)
+        {
+            logLevelChange(slot, oldLevel, newLevel);
+        }
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+        markLevelChange(slot, oldLevel);
+#endif
+#if (MLFQ_WARM_START_ENABLED == 1U)
+        warmNoteLevel(slot, newLevel);
+#endif
+    }
+}
+
+/*
+ * Description : Re-programs the quantum of every registered task for its
+ *               current level. Called with the kernel suspended.
+ */
+static void applyAllQuanta(void)
+{
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if (record != NULL)
+        {
+            applyLevelQuantum(slot, (MLFQ_QueueLevel_t)record->level);
+        }
+    }
+}
+
+/*
+ * Description : Installs the pending parameter set and re-programs the
+ *               quantum of every registered task for its current level.
+ *               The kernel is suspended so no task runs, or is demoted,
+ *               under a mix of old and new quanta.
+ */
+static void applyPendingTunables(void)
+{
+    vTaskSuspendAll();
+    {
+        taskENTER_CRITICAL();
+        {
+            /* A new boost period restarts auto-tuning from it */
+            if (g_pendingTunables.boost_period_ms != g_tunables.boost_period_ms)
+            {
+                g_boostPeriodMs = g_pendingTunables.boost_period_ms;
+            }
+            g_tunables = g_pendingTunables;
+            g_tunablesPending = false;
+        }
+        taskEXIT_CRITICAL();
+
+        applyAllQuanta();
+    }
+    (void)xTaskResumeAll();
+}
+
+/*
+ * Description : Installs the pending level count and moves the tasks
+ *               below the new deepest level up to it, in one batch.
+ */
+static void applyPendingLevelCount(void)
+{
+    vTaskSuspendAll();
+    {
+        taskENTER_CRITICAL();
+        g_levelCount = g_pendingLevelCount;
+        g_pendingLevelCount = 0U;
+        taskEXIT_CRITICAL();
+
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            uint32_t slot = tickProfilerGetActiveSlot(i);
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+            if ((record != NULL) && (record->level < MLFQ_NUM_LEVELS) &&
+                (record->level != (uint8_t)partitionLevel(slot, (MLFQ_QueueLevel_t)record->level)))
+            {
+                setSlotLevel(slot, (MLFQ_QueueLevel_t)record->level);
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+}
+
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+/*
+ * Description : Places the task in a slot on the level its score maps
+ *               to. Level L owns scores [L * 100 / N, (L + 1) * 100 / N);
+ *               the task moves only when its score is more than
+ *               MLFQ_SCORE_HYSTERESIS outside its current band, so tasks
+ *               near a boundary do not flap. After a quantum expiry the
+ *               task is re-armed even if it keeps its level.
+ */
+static void placeByScore(uint32_t slot, bool quantumExpired)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if (record == NULL)
+    {
+        return;
+    }
+
+    uint32_t score   = interactivityGetScore(slot);
+    uint32_t current = (record->level < MLFQ_NUM_LEVELS) ? record->level : MLFQ_QUEUE_LOW;
+    uint32_t bandLow  = (current * INTERACTIVITY_SCORE_MAX) / MLFQ_NUM_LEVELS;
+    uint32_t bandHigh = ((current + 1U) * INTERACTIVITY_SCORE_MAX) / MLFQ_NUM_LEVELS;
+    uint32_t target   = current;
+
+    if (((score + MLFQ_SCORE_HYSTERESIS) < bandLow) ||
+        (score >= (bandHigh + MLFQ_SCORE_HYSTERESIS)))
+    {
+        target = (score * MLFQ_NUM_LEVELS) / (INTERACTIVITY_SCORE_MAX + 1U);
+    }
+
+    if (target > g_levelFloor[slot])
+    {
+        target = g_levelFloor[slot];
+    }
+
+    if ((target != current) || quantumExpired)
+    {
+        setSlotLevel(slot, (MLFQ_QueueLevel_t)target);
+    }
+}
+#endif
+
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+/*
+ * Description : Promotes by one level every task the burst tracker has
+ *               flagged for MLFQ_SHORT_BURSTS_TO_PROMOTE short bursts in
+ *               a row, so a task that was CPU-bound only briefly climbs
+ *               back without waiting for the global boost.
+ */
+static void promoteShortBurstTasks(void)
+{
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if ((record != NULL) && burstTakePromotion(slot) &&
+            (record->level > (uint8_t)MLFQ_QUEUE_HIGH) &&
+            (record->level < MLFQ_NUM_LEVELS))
+        {
+            setSlotLevel(slot, (MLFQ_QueueLevel_t)(record->level - 1U));
+        }
+    }
+}
+#endif
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U) && (MLFQ_TIMER_WHEEL_ENABLED == 0U)
+/*
+ * Description : Moves to High every task below it whose wake period is
+ *               trusted and whose next wake is MLFQ_PREPROMOTE_LEAD_TICKS
+ *               away or less, so the burst of that release starts at High
+ *               instead of the level a transient overload left it at. A
+ *               wake more than a period overdue is stale and ignored.
+ *               Returns the ticks until the next promotion is due, at
+ *               most 'limit'.
+ */
+static uint32_t prePromotePeriodicTasks(TickType_t xNow, uint32_t limit)
+{
+    uint32_t next = limit;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+        uint32_t wake;
+        uint32_t period;
+
+        if ((record == NULL) || (record->level == (uint8_t)MLFQ_QUEUE_HIGH) ||
+            (record->level >= MLFQ_NUM_LEVELS) ||
+            !wakePeriodGetNextWake(slot, &wake, &period))
+        {
+            continue;
+        }
+
+        uint32_t due = wake - MLFQ_PREPROMOTE_LEAD_TICKS;
+        uint32_t late = (uint32_t)xNow - due;
+
+        if (late <= period)
+        {
+            setSlotLevel(slot, MLFQ_QUEUE_HIGH);
+            g_prePromotions++;
+        }
+        else if ((due - (uint32_t)xNow) < next)
+        {
+            next = due - (uint32_t)xNow;
+        }
+    }
+
+    return next;
+}
+#endif
+
+#if (MLFQ_AGING_ENABLED == 1U) && (MLFQ_TIMER_WHEEL_ENABLED == 0U)
+/*
+ * Description : Promotes by one level every registered task below High
+ *               that has waited in a ready list for longer than its
+ *               level's starvation_ms. Tasks that run or block in time
+ *               keep their level, so CPU hogs that are merely sharing
+ *               the CPU stay classified as such. Only the members of
+ *               the levels below High are visited.
+ */
+static void promoteStarvingTasks(void)
+{
+    for (uint32_t level = (uint32_t)MLFQ_QUEUE_HIGH + 1U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        uint32_t limitCycles = mlfqLevelStarvationCycles((MLFQ_QueueLevel_t)level);
+
+        if ((limitCycles == 0U) || (tickProfilerGetLevelCount((uint8_t)level) == 0U))
+        {
+            continue;
+        }
+
+        for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+        {
+            /* A copy: promotions below clear bits of the live set */
+            uint32_t members = tickProfilerGetLevelMask((uint8_t)level, word);
+
+            while (members != 0U)
+            {
+                uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+                uint32_t slot = (word * 32U) + bit;
+                uint32_t waited;
+
+                members &= ~(1UL << bit);
+
+                if (agingGetWaitCycles(slot, &waited) && (waited >= limitCycles))
+                {
+                    setSlotLevel(slot, (MLFQ_QueueLevel_t)(level - 1U));
+                    agingRestartWait(slot);
+                }
+            }
+        }
+    }
+}
+#endif
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U)
+#if (MLFQ_AGING_ENABLED == 1U)
+/*
+ * Description : Arms the aging timer of a slot for the tick its ready
+ *               wait reaches its level's starvation_ms. A task that is
+ *               not waiting cannot starve sooner than a full threshold
+ *               from now; if it blocks first, the timer finds it not
+ *               starving and is armed again.
+ */
+static void armAgingTimer(uint32_t slot, TickType_t xNow)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+    uint32_t entry = TIMER_WHEEL_ENTRY(slot, TIMER_WHEEL_AGING);
+
+    if ((record == NULL) || (record->level == (uint8_t)MLFQ_QUEUE_HIGH) ||
+        (record->level >= MLFQ_NUM_LEVELS))
+    {
+        timerWheelCancel(entry);
+        return;
+    }
+
+    uint32_t limitCycles = mlfqLevelStarvationCycles((MLFQ_QueueLevel_t)record->level);
+    uint32_t waited = 0U;
+
+    if (limitCycles == 0U)
+    {
+        timerWheelCancel(entry);
+        return;
+    }
+
+    (void)agingGetWaitCycles(slot, &waited);
+
+    uint32_t left = (waited < limitCycles) ? (limitCycles - waited) : 0U;
+
+    timerWheelArm(entry, (uint32_t)xNow +
+                  ((left + TICK_PROFILER_CYCLES_PER_TICK - 1U) / TICK_PROFILER_CYCLES_PER_TICK));
+}
+
+/*
+ * Description : Aging timer: promotes the task by one level if it has
+ *               been ready for its level's starvation_ms, as the scan
+ *               did, then arms the timer for its new level and wait.
+ */
+static void agingTimerFired(uint32_t slot, TickType_t xNow)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+    uint32_t waited;
+
+    if ((record != NULL) && (record->level > (uint8_t)MLFQ_QUEUE_HIGH) &&
+        (record->level < MLFQ_NUM_LEVELS) &&
+        agingGetWaitCycles(slot, &waited) &&
+        (waited >= mlfqLevelStarvationCycles((MLFQ_QueueLevel_t)record->level)))
+    {
+        setSlotLevel(slot, (MLFQ_QueueLevel_t)(record->level - 1U));
+        agingRestartWait(slot);
+    }
+
+    armAgingTimer(slot, xNow);
+}
+#endif
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+/*
+ * Description : Arms the pre-promotion timer of a slot that is blocked
+ *               with a trusted period. The switch hook arms it whenever
+ *               such a task blocks below High; this covers a task that
+ *               was demoted while already blocked.
+ */
+static void armPrePromoteTimer(uint32_t slot)
+{
+    uint32_t wake;
+    uint32_t period;
+
+    if (wakePeriodGetNextWake(slot, &wake, &period))
+    {
+        timerWheelArm(TIMER_WHEEL_ENTRY(slot, TIMER_WHEEL_PREPROMOTE),
+                      wake - MLFQ_PREPROMOTE_LEAD_TICKS);
+    }
+}
+
+/*
+ * Description : Pre-promotion timer: moves the task to High if it is
+ *               still below it and blocked with a trusted period, and
+ *               the wake is not more than a period overdue (stale).
+ */
+static void prePromoteTimerFired(uint32_t slot, TickType_t xNow)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+    uint32_t wake;
+    uint32_t period;
+
+    if ((record == NULL) || (record->level == (uint8_t)MLFQ_QUEUE_HIGH) ||
+        (record->level >= MLFQ_NUM_LEVELS) ||
+        !wakePeriodGetNextWake(slot, &wake, &period))
+    {
+        return;
+    }
+
+    uint32_t due = wake - MLFQ_PREPROMOTE_LEAD_TICKS;
+
+    if (((uint32_t)xNow - due) <= period)
+    {
+        setSlotLevel(slot, MLFQ_QUEUE_HIGH);
+        g_prePromotions++;
+    }
+    else if ((int32_t)(due - (uint32_t)xNow) > 0)
+    {
+        /* Re-learnt since it was armed */
+        timerWheelArm(TIMER_WHEEL_ENTRY(slot, TIMER_WHEEL_PREPROMOTE), due);
+    }
+}
+#endif
+
+/*
+ * Description : Arms the timers of the slots that went below High since
+ *               the last sync and cancels those of the slots that went
+ *               back to High. Works on the level sets, a few words per
+ *               level, not on the task table.
+ */
+static void syncTimedSlots(TickType_t xNow)
+{
+    for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+    {
+        uint32_t below = 0U;
+
+        for (uint32_t level = (uint32_t)MLFQ_QUEUE_HIGH + 1U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            below |= tickProfilerGetLevelMask((uint8_t)level, word);
+        }
+
+        uint32_t added = below & ~g_timedSlots[word];
+        uint32_t removed = g_timedSlots[word] & ~below;
+
+        g_timedSlots[word] = below;
+
+        while (added != 0U)
+        {
+            uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(added);
+            uint32_t slot = (word * 32U) + bit;
+
+            added &= ~(1UL << bit);
+#if (MLFQ_AGING_ENABLED == 1U)
+            armAgingTimer(slot, xNow);
+#endif
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+            armPrePromoteTimer(slot);
+#endif
+        }
+
+        while (removed != 0U)
+        {
+            uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(removed);
+            uint32_t slot = (word * 32U) + bit;
+
+            removed &= ~(1UL << bit);
+            for (uint32_t kind = 0U; kind < TIMER_WHEEL_KINDS; kind++)
+            {
+                timerWheelCancel(TIMER_WHEEL_ENTRY(slot, kind));
+            }
+        }
+    }
+
+    (void)xNow;
+}
+
+/*
+ * Description : Runs the policy timers that are due, syncing the armed
+ *               slots before and after (a timer's promotion can take a
+ *               task to High). Returns the ticks until the next one;
+ *               the tick hook also wakes the supervisor on that tick.
+ */
+static uint32_t serviceTimers(TickType_t xNow)
+{
+    uint32_t entry;
+
+    syncTimedSlots(xNow);
+
+    while ((entry = timerWheelTakeDue((uint32_t)xNow)) != TIMER_WHEEL_NONE)
+    {
+        switch (TIMER_WHEEL_KIND(entry))
+        {
+#if (MLFQ_AGING_ENABLED == 1U)
+            case TIMER_WHEEL_AGING:
+                agingTimerFired(TIMER_WHEEL_SLOT(entry), xNow);
+                break;
+#endif
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+            case TIMER_WHEEL_PREPROMOTE:
+                prePromoteTimerFired(TIMER_WHEEL_SLOT(entry), xNow);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+
+    syncTimedSlots(xNow);
+
+    return timerWheelTicksToNext((uint32_t)xNow, (uint32_t)portMAX_DELAY);
+}
+#endif
+
+#if (MLFQ_ADAPTIVE_QUANTUM_ENABLED == 1U)
+/*
+ * Description : Moves the quanta towards the measured High-level burst
+ *               distribution, then starts a new measurement window.
+ *               The target is blended 1:3 with the current High quantum
+ *               so one unusual window cannot swing the policy. Runs in
+ *               the supervisor task at the boost period.
+ */
+static void adaptQuanta(void)
+{
+    MLFQ_Tunables_t tunables;
+    uint32_t burstUs = 0U;
+    uint32_t samples = 0U;
+    bool measured = burstGetLevelPercentile(MLFQ_QUEUE_HIGH, MLFQ_ADAPTIVE_TARGET_PERCENT,
+                                            &burstUs, &samples);
+
+    burstStartWindow();
+
+    if (!measured || (samples < MLFQ_ADAPTIVE_MIN_SAMPLES))
+    {
+        return;
+    }
+
+    if (burstUs < MLFQ_ADAPTIVE_HIGH_MIN_US)
+    {
+        burstUs = MLFQ_ADAPTIVE_HIGH_MIN_US;
+    }
+    else if (burstUs > MLFQ_ADAPTIVE_HIGH_MAX_US)
+    {
+        burstUs = MLFQ_ADAPTIVE_HIGH_MAX_US;
+    }
+
+    schedulerGetTunables(&tunables);
+
+    uint32_t highUs = ((tunables.quantum_us[MLFQ_QUEUE_HIGH] * 3U) + burstUs) / 4U;
+    uint32_t tickUs = 1000000U / configTICK_RATE_HZ;
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        /* Keep the compiled-in ratio between this level and High */
+        uint32_t levelUs = (uint32_t)(((uint64_t)highUs * mlfqLevelQuantumUs((MLFQ_QueueLevel_t)level)) /
+                                      mlfqLevelQuantumUs(MLFQ_QUEUE_HIGH));
+
+        if (levelUs > MLFQ_QUANTUM_MAX_US)
+        {
+            levelUs = MLFQ_QUANTUM_MAX_US;
+        }
+
+        tunables.quantum_us[level]    = levelUs;
+        tunables.quantum_ticks[level] = (levelUs + tickUs - 1U) / tickUs;
+    }
+
+    if (schedulerSetTunables(&tunables))
+    {
+        applyPendingTunables();
+    }
+}
+#endif
+
+/*
+ * Description : MLFQ on_quantum_expired: demote (or re-place by score).
+ */
+static void mlfqOnQuantumExpired(uint32_t slot)
+{
+    checkForDemotion((uint8_t)slot);
+}
+
+/*
+ * Description : Closes a boost or boost slice started at cycle 'start':
+ *               probe, trace, cost metrics and the boost record.
+ */
+static void finishBoost(uint32_t start)
+{
+    GPIO_PROBE_LOW(GPIO_PROBE_PIN_BOOST);
+
+#if (EVENT_TRACE_ENABLED == 1U)
+    eventTraceRecord(EVENT_TRACE_BOOST_END, NULL, 0U, 0U);
+#endif
+
+    /* Boost cost metrics */
+    uint32_t elapsed = cycleCounterGet() - start;
+    g_boostStats.boost_count++;
+    g_boostStats.last_cycles = elapsed;
+    if (elapsed > g_boostStats.max_cycles)
+    {
+        g_boostStats.max_cycles = elapsed;
+    }
+
+    if (g_reportReader)
+    {
+        logGlobalBoost();
+    }
+}
+
+#if (MLFQ_BOOST_SLICES > 1U) || (MLFQ_PARTITIONS_ENABLED == 1U)
+/*
+ * Description : Moves one task to High with a fresh High quantum and
+ *               zero runtime. The caller holds the scheduler suspended.
+ */
+static void boostSlot(uint32_t slot, TickProfilerTaskInfo_t *record)
+{
+    if (record->level != (uint8_t)MLFQ_QUEUE_HIGH)
+    {
+        tickProfilerSetLevel(slot, (uint8_t)MLFQ_QUEUE_HIGH);
+        vTaskPrioritySet(record->task, slotLevelPriority(slot, MLFQ_QUEUE_HIGH));
+        g_levelChanges.applied++;
+    }
+    else
+    {
+        g_levelChanges.coalesced++;
+    }
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    g_weightParked[slot] = false;
+#endif
+
+    applyLevelQuantum(slot, MLFQ_QUEUE_HIGH);
+    (void)resetSlotRuntime(slot);
+}
+#endif
+
+#if (MLFQ_BOOST_SLICES > 1U)
+/*
+ * Description : Boosts one slice of the rolling boost: each managed task
+ *               whose slot falls in 'slice' moves to High with a fresh
+ *               High quantum and zero runtime. The other tasks are not
+ *               touched, so a slice costs about 1/MLFQ_BOOST_SLICES of a
+ *               global boost. Only the default partition is sliced.
+ */
+static void performBoostSlice(uint32_t slice)
+{
+    uint32_t start = cycleCounterGet();
+
+    GPIO_PROBE_HIGH(GPIO_PROBE_PIN_BOOST);
+
+#if (EVENT_TRACE_ENABLED == 1U)
+    eventTraceRecord(EVENT_TRACE_BOOST_START, NULL, 0U, 0U);
+#endif
+
+    vTaskSuspendAll();
+    {
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            uint32_t slot = tickProfilerGetActiveSlot(i);
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+            if ((record == NULL) || ((slot % MLFQ_BOOST_SLICES) != slice))
+            {
+                continue;
+            }
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+            if (g_slotPartition[slot] != MLFQ_PARTITION_DEFAULT)
+            {
+                continue;
+            }
+#endif
+
+            boostSlot(slot, record);
+        }
+    }
+    (void)xTaskResumeAll();
+
+    finishBoost(start);
+}
+#endif
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+/*
+ * Description : Boosts the members of one partition only. The default
+ *               partition's boost is the global boost, with its probe,
+ *               trace and cost metrics; another partition's only counts.
+ */
+static void boostPartition(uint32_t partition)
+{
+    uint32_t start = cycleCounterGet();
+
+    if (partition == MLFQ_PARTITION_DEFAULT)
+    {
+        GPIO_PROBE_HIGH(GPIO_PROBE_PIN_BOOST);
+#if (EVENT_TRACE_ENABLED == 1U)
+        eventTraceRecord(EVENT_TRACE_BOOST_START, NULL, 0U, 0U);
+#endif
+    }
+
+    vTaskSuspendAll();
+    {
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            uint32_t slot = tickProfilerGetActiveSlot(i);
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+            if ((record != NULL) && (g_slotPartition[slot] == partition))
+            {
+                boostSlot(slot, record);
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+
+    if (partition == MLFQ_PARTITION_DEFAULT)
+    {
+        finishBoost(start);
+    }
+    else
+    {
+        g_partitions[partition].boosts++;
+    }
+}
+
+/*
+ * Description : Boosts every created partition whose own boost period
+ *               has passed. Returns the ticks until the next one is due.
+ */
+static uint32_t servePartitionBoosts(TickType_t xNow)
+{
+    uint32_t next = (uint32_t)portMAX_DELAY;
+
+    for (uint32_t partition = MLFQ_PARTITION_DEFAULT + 1U; partition < MLFQ_MAX_PARTITIONS; partition++)
+    {
+        if ((g_partitions[partition].name == NULL) || (g_partitions[partition].boost_period_ms == 0U))
+        {
+            continue;
+        }
+
+        TickType_t xPeriod = pdMS_TO_TICKS(g_partitions[partition].boost_period_ms);
+
+        if ((xNow - g_partitionBoostTick[partition]) >= xPeriod)
+        {
+            boostPartition(partition);
+            g_partitionBoostTick[partition] = xNow;
+        }
+
+        uint32_t left = (uint32_t)(xPeriod - (xNow - g_partitionBoostTick[partition]));
+
+        if (left < next)
+        {
+            next = left;
+        }
+    }
+
+    return next;
+}
+#endif
+
+#if (MLFQ_RESERVE_ENABLED == 1U)
+/* Reservation budget in the units of TickProfilerCpuTime_t, and the
+ * units in one tick */
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+#define MLFQ_RESERVE_BUDGET     ((uint64_t)TICK_PROFILER_US_TO_CYCLES((uint64_t)MLFQ_RESERVE_PERIOD_MS * \
+                                                                      10U * MLFQ_RESERVE_PERCENT))
+#define MLFQ_RESERVE_PER_TICK   ((uint64_t)TICK_PROFILER_CYCLES_PER_TICK)
+#else
+#define MLFQ_RESERVE_BUDGET     ((uint64_t)(((pdMS_TO_TICKS(MLFQ_RESERVE_PERIOD_MS) * \
+                                              MLFQ_RESERVE_PERCENT) + 99U) / 100U))
+#define MLFQ_RESERVE_PER_TICK   1ULL
+#endif
+
+/*
+ * Description : Sets the priority of every Low-level task to the one
+ *               levelPriority() gives now. Levels and quanta stay as
+ *               they are. The reservation is the default partition's.
+ */
+static void applyReservePriority(void)
+{
+    UBaseType_t priority = levelPriority(MLFQ_QUEUE_LOW);
+
+    vTaskSuspendAll();
+    {
+        for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+        {
+            uint32_t members = tickProfilerGetLevelMask((uint8_t)MLFQ_QUEUE_LOW, word);
+
+            while (members != 0U)
+            {
+                uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+                TickProfilerTaskInfo_t *record = tickProfilerGetRecord((word * 32U) + bit);
+
+                members &= ~(1UL << bit);
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+                if (g_slotPartition[(word * 32U) + bit] != MLFQ_PARTITION_DEFAULT)
+                {
+                    continue;
+                }
+#endif
+
+                if (record != NULL)
+                {
+                    vTaskPrioritySet(record->task, priority);
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+                    /* Switching the reservation starts a new Low round */
+                    g_weightParked[(word * 32U) + bit] = false;
+#endif
+                }
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+}
+
+/*
+ * Description : Serves the Low-level reservation as a deferrable server:
+ *               the budget is refilled at the start of every period and
+ *               the Low tasks run above High until the Low level has
+ *               used it up, measured from the profiler's per-level CPU
+ *               time. Unused budget is not carried over. Returns the
+ *               ticks until the next check.
+ */
+static uint32_t serveReservation(TickType_t xNow)
+{
+    const TickType_t xPeriod = pdMS_TO_TICKS(MLFQ_RESERVE_PERIOD_MS);
+    TickProfilerCpuTime_t cpu;
+
+    tickProfilerGetCpuTime(&cpu);
+
+    if ((xNow - g_reserveStart) >= xPeriod)
+    {
+        g_reserveStart      = xNow;
+        g_reserveLowAtStart = cpu.level[MLFQ_QUEUE_LOW];
+    }
+
+    uint64_t used = cpu.level[MLFQ_QUEUE_LOW] - g_reserveLowAtStart;
+    bool serve = (used < MLFQ_RESERVE_BUDGET);
+#if (MLFQ_DEGRADE_ENABLED == 1U)
+    /* Low work is what degraded mode sheds */
+    serve = serve && !g_degraded;
+#endif
+    TickType_t xNext = xPeriod - (xNow - g_reserveStart);
+
+    if (serve != g_reserveServing)
+    {
+        g_reserveServing = serve;
+        applyReservePriority();
+    }
+
+    if (serve)
+    {
+        /* The budget cannot run out sooner than this */
+        uint64_t left = (MLFQ_RESERVE_BUDGET - used + MLFQ_RESERVE_PER_TICK - 1U) /
+                        MLFQ_RESERVE_PER_TICK;
+
+        if (left < (uint64_t)xNext)
+        {
+            xNext = (TickType_t)left;
+        }
+    }
+
+    return (uint32_t)xNext;
+}
+#endif
+
+#if (MLFQ_OVERLOAD_ENABLED == 1U) || (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+/*
+ * Description : Returns the longest ready wait among the members of a
+ *               level in microseconds, and the slot of that waiter
+ *               (TICK_PROFILER_MAX_TASKS when nobody is waiting).
+ */
+static uint32_t longestLevelWait(uint32_t level, uint32_t *slotOut)
+{
+    uint32_t longest = 0U;
+
+    *slotOut = TICK_PROFILER_MAX_TASKS;
+
+    for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+    {
+        uint32_t members = tickProfilerGetLevelMask((uint8_t)level, word);
+
+        while (members != 0U)
+        {
+            uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+            uint32_t slot = (word * 32U) + bit;
+            uint32_t waited;
+
+            members &= ~(1UL << bit);
+
+            if (agingGetWaitCycles(slot, &waited) && (waited > longest))
+            {
+                longest  = waited;
+                *slotOut = slot;
+            }
+        }
+    }
+
+    return (uint32_t)(((uint64_t)longest * 1000000ULL) / configCPU_CLOCK_HZ);
+}
+#endif
+
+#if (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+/*
+ * Description : Boost auto-tuning check, every MLFQ_BOOST_AUTOTUNE_CHECK_MS.
+ *               Keeps the longest Low wait seen since the last boost and
+ *               returns true once it is close enough to the bound that the
+ *               boost must not wait for the end of the period.
+ */
+static bool checkBoostStarvation(void)
+{
+    uint32_t slot;
+    uint32_t waited = longestLevelWait((uint32_t)MLFQ_QUEUE_LOW, &slot);
+
+    if (waited > g_tuneMaxWaitUs)
+    {
+        g_tuneMaxWaitUs = waited;
+    }
+
+    return (g_tuneMaxWaitUs >=
+            (MLFQ_BOOST_AUTOTUNE_BOUND_MS * MLFQ_BOOST_AUTOTUNE_HIGH_PERCENT * 10U));
+}
+
+/*
+ * Description : Adapts the boost period at a boost. A boost brought
+ *               forward halves it; a period whose longest Low wait stayed
+ *               under the low threshold grows by a quarter; otherwise it
+ *               is kept.
+ */
+static void tuneBoostPeriod(bool early)
+{
+    uint32_t period = g_boostPeriodMs;
+
+    if (early)
+    {
+        period /= 2U;
+        g_boostStats.early_boosts++;
+    }
+    else if (g_tuneMaxWaitUs <
+             (MLFQ_BOOST_AUTOTUNE_BOUND_MS * MLFQ_BOOST_AUTOTUNE_LOW_PERCENT * 10U))
+    {
+        period += period / 4U;
+    }
+
+    if (period < MLFQ_BOOST_PERIOD_MIN_MS)
+    {
+        period = MLFQ_BOOST_PERIOD_MIN_MS;
+    }
+    else if (period > MLFQ_BOOST_PERIOD_MAX_MS)
+    {
+        period = MLFQ_BOOST_PERIOD_MAX_MS;
+    }
+
+    g_boostPeriodMs = period;
+    g_tuneMaxWaitUs = 0U;
+}
+#endif
+
+#if (MLFQ_DEGRADE_ENABLED == 1U)
+#if (MLFQ_DEGRADE_SUSPEND_LOW == 1U)
+/*
+ * Description : Suspends every Low task that is not suspended yet, so
+ *               tasks that sink to Low while degraded stop too. A task
+ *               already suspended (or blocked without timeout) is left
+ *               alone and so is never resumed by degraded mode.
+ */
+static void suspendLowTasks(void)
+{
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if ((record != NULL) && (record->level == (uint32_t)MLFQ_QUEUE_LOW) &&
+            (eTaskGetState(record->task) != eSuspended))
+        {
+            g_degradeSuspended[slot] = record->task;
+            vTaskSuspend(record->task);
+        }
+    }
+}
+
+/*
+ * Description : Resumes the tasks degraded mode suspended, skipping
+ *               slots that have since been given to another task.
+ */
+static void resumeLowTasks(void)
+{
+    for (uint32_t slot = 0U; slot < TICK_PROFILER_MAX_TASKS; slot++)
+    {
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if ((g_degradeSuspended[slot] != NULL) && (record != NULL) &&
+            (record->task == g_degradeSuspended[slot]))
+        {
+            vTaskResume(record->task);
+        }
+        g_degradeSuspended[slot] = NULL;
+    }
+}
+#endif
+
+/*
+ * Description : Enters or leaves degraded mode: re-arms every task with
+ *               the quanta of the new mode, suspends or resumes the Low
+ *               tasks, and counts and logs the change.
+ */
+static void setDegradedMode(bool degraded)
+{
+    vTaskSuspendAll();
+    {
+        g_degraded = degraded;
+        applyAllQuanta();
+#if (MLFQ_DEGRADE_SUSPEND_LOW == 1U)
+        if (degraded)
+        {
+            suspendLowTasks();
+        }
+        else
+        {
+            resumeLowTasks();
+        }
+#endif
+    }
+    (void)xTaskResumeAll();
+
+    g_degradeCalm = false;
+    g_overload.degraded = degraded ? 1U : 0U;
+    g_overload.mode_changes++;
+    logDegradedMode(&g_overload);
+
+    if (g_overloadHook != NULL)
+    {
+        g_overloadHook(&g_overload);
+    }
+}
+
+/*
+ * Description : Degraded mode step of the overload check. Entered when
+ *               the demand alarm is raised; left once the demand has
+ *               stayed under MLFQ_DEGRADE_EXIT_PERCENT for
+ *               MLFQ_DEGRADE_HOLD_MS, so a load hovering near the alarm
+ *               threshold does not flip the mode on every check.
+ */
+static void updateDegradedMode(uint32_t raised)
+{
+    TickType_t xNow = xTaskGetTickCount();
+
+    if (!g_degraded)
+    {
+        if ((raised & MLFQ_OVERLOAD_CAUSE_DEMAND) != 0U)
+        {
+            setDegradedMode(true);
+        }
+        return;
+    }
+
+    if (g_overload.demand_permille >= (MLFQ_DEGRADE_EXIT_PERCENT * 10U))
+    {
+        g_degradeCalm = false;
+    }
+    else if (!g_degradeCalm)
+    {
+        g_degradeCalm      = true;
+        g_degradeCalmSince = xNow;
+    }
+    else if ((xNow - g_degradeCalmSince) >= pdMS_TO_TICKS(MLFQ_DEGRADE_HOLD_MS))
+    {
+        setDegradedMode(false);
+        return;
+    }
+
+#if (MLFQ_DEGRADE_SUSPEND_LOW == 1U)
+    vTaskSuspendAll();
+    suspendLowTasks();
+    (void)xTaskResumeAll();
+#endif
+}
+#endif
+
+#if (MLFQ_OVERLOAD_ENABLED == 1U)
+/*
+ * Description : Overload check, every MLFQ_OVERLOAD_CHECK_MS. Folds the
+ *               CPU share the levels above Low took over the window into
+ *               a rolling figure (1:3 with the previous one), takes the
+ *               longest ready wait of each level, and raises an alarm
+ *               (log record and hook) for every cause that has just come
+ *               into force. A cause that stays in force is reported once.
+ */
+static void checkOverload(void)
+{
+    TickProfilerCpuTime_t cpu;
+    uint64_t upper = 0U;
+    uint64_t total;
+    uint32_t raised;
+    uint32_t causes = 0U;
+
+    tickProfilerGetCpuTime(&cpu);
+
+    total = (cpu.supervisor - g_overloadCpu.supervisor) +
+            (cpu.idle - g_overloadCpu.idle) + (cpu.other - g_overloadCpu.other);
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        uint64_t used = cpu.level[level] - g_overloadCpu.level[level];
+
+        total += used;
+        if (level != (uint32_t)MLFQ_QUEUE_LOW)
+        {
+            upper += used;
+        }
+    }
+    g_overloadCpu = cpu;
+
+    if (total != 0U)
+    {
+        uint32_t window = (uint32_t)((upper * 1000U) / total);
+        g_overload.demand_permille = ((g_overload.demand_permille * 3U) + window) / 4U;
+    }
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        uint32_t slot;
+        uint32_t waited = longestLevelWait(level, &slot);
+
+        g_overload.max_wait_us[level] = waited;
+        if (level == (uint32_t)MLFQ_QUEUE_LOW)
+        {
+            g_overload.starving_slot = slot;
+        }
+    }
+
+    if (g_overload.demand_permille >= (MLFQ_OVERLOAD_DEMAND_PERCENT * 10U))
+    {
+        causes |= MLFQ_OVERLOAD_CAUSE_DEMAND;
+    }
+    if (g_overload.max_wait_us[MLFQ_QUEUE_LOW] >= (MLFQ_OVERLOAD_STARVE_MS * 1000U))
+    {
+        causes |= MLFQ_OVERLOAD_CAUSE_STARVATION;
+    }
+
+    raised = causes & ~g_overload.causes;
+    g_overload.causes = causes;
+
+    if (raised != 0U)
+    {
+        g_overload.events++;
+        logOverload(&g_overload, raised);
+
+        if (g_overloadHook != NULL)
+        {
+            g_overloadHook(&g_overload);
+        }
+    }
+
+#if (MLFQ_DEGRADE_ENABLED == 1U)
+    updateDegradedMode(raised);
+#endif
+}
+#endif
+
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+/*
+ * Description : Returns the core with the fewest managed tasks homed on
+ *               it, where a new task goes.
+ */
+static uint32_t leastLoadedCore(void)
+{
+    uint32_t tasks[TICK_PROFILER_CORES] = { 0U };
+    uint32_t best = 0U;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t home = g_homeCore[tickProfilerGetActiveSlot(i)];
+
+        if (home < TICK_PROFILER_CORES)
+        {
+            tasks[home]++;
+        }
+    }
+
+    for (uint32_t core = 1U; core < TICK_PROFILER_CORES; core++)
+    {
+        if (tasks[core] < tasks[best])
+        {
+            best = core;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Description : Homes a slot on a core and restricts its task to it.
+ */
+static void setHomeCore(uint32_t slot, uint32_t core)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    g_homeCore[slot] = (uint8_t)core;
+    g_homePending[slot] = false;
+    if (record != NULL)
+    {
+        vTaskCoreAffinitySet(record->task, (UBaseType_t)(1UL << core));
+    }
+}
+
+/*
+ * Description : Core balance check. Applies the homes of new tasks, takes
+ *               each core's busy share over the window since the last
+ *               check, and lets the least busy core steal one task below
+ *               High from the busiest if the gap is wide enough. The
+ *               deepest level goes first: CPU-bound work loses least from
+ *               a cold cache, and one move per check cannot thrash.
+ */
+static void balanceCores(void)
+{
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+
+        if (g_homePending[slot])
+        {
+            setHomeCore(slot, g_homeCore[slot]);
+        }
+    }
+
+    uint32_t thief = 0U;
+    uint32_t victim = 0U;
+
+    for (uint32_t core = 0U; core < TICK_PROFILER_CORES; core++)
+    {
+        TickProfilerCpuTime_t cpu;
+
+        (void)tickProfilerGetCoreCpuTime(core, &cpu);
+
+        uint64_t total = cpu.supervisor + cpu.idle + cpu.other;
+        for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            total += cpu.level[level];
+        }
+
+        uint64_t window = total - g_coreTotalLast[core];
+        uint64_t idle = cpu.idle - g_coreIdleLast[core];
+
+        g_coreBusy[core] = (window == 0U) ? 0U :
+                           (uint32_t)(((window - idle) * 1000U) / window);
+        g_coreTotalLast[core] = total;
+        g_coreIdleLast[core] = cpu.idle;
+
+        if (g_coreBusy[core] < g_coreBusy[thief])
+        {
+            thief = core;
+        }
+        if (g_coreBusy[core] > g_coreBusy[victim])
+        {
+            victim = core;
+        }
+    }
+
+    if ((g_coreBusy[victim] - g_coreBusy[thief]) < (MLFQ_CORE_STEAL_PERCENT * 10U))
+    {
+        return;
+    }
+
+    uint32_t stolen = TICK_PROFILER_MAX_TASKS;
+    uint8_t deepest = (uint8_t)MLFQ_QUEUE_HIGH;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if ((record != NULL) && (g_homeCore[slot] == victim) &&
+            (record->level > deepest))
+        {
+            deepest = record->level;
+            stolen = slot;
+        }
+    }
+
+    if (stolen < TICK_PROFILER_MAX_TASKS)
+    {
+        setHomeCore(stolen, thief);
+        g_coreSteals[thief]++;
+        g_migrations++;
+    }
+}
+#endif
+
+/*
+ * Description : MLFQ on_periodic: the policy scan (score, short-burst
+ *               promotion, aging) and the adaptive quanta and global
+ *               boost at every boost period (or earlier, when auto-tuning
+ *               sees Low starving), the due aging and pre-promotion
+ *               timers when the timer wheel runs them, then the Low-level
+ *               reservation and the overload check. Returns the ticks
+ *               until the next of them is due.
+ */
+static uint32_t mlfqOnPeriodic(uint32_t nowTicks)
+{
+    TickType_t xNow = (TickType_t)nowTicks;
+    TickType_t xBoostPeriod = pdMS_TO_TICKS(g_boostPeriodMs);
+    bool boostEarly = false;
+
+#if (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+    const TickType_t xTunePeriod = pdMS_TO_TICKS(MLFQ_BOOST_AUTOTUNE_CHECK_MS);
+
+    if ((xNow - g_lastTuneTick) >= xTunePeriod)
+    {
+        boostEarly = checkBoostStarvation();
+        g_lastTuneTick = xNow;
+    }
+#endif
+
+#if (MLFQ_BOOST_SLICES > 1U)
+    /* One slice per sub-period */
+    xBoostPeriod /= MLFQ_BOOST_SLICES;
+    if (xBoostPeriod == 0U)
+    {
+        xBoostPeriod = 1U;
+    }
+#endif
+
+#if (MLFQ_POLICY_SCAN_ENABLED)
+    const TickType_t xScanPeriod = pdMS_TO_TICKS(MLFQ_POLICY_SCAN_MS);
+
+    if ((xNow - g_lastScanTick) >= xScanPeriod)
+    {
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+        /* Re-place every task whose score left its level's band */
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            placeByScore(tickProfilerGetActiveSlot(i), false);
+        }
+#endif
+#if (MLFQ_BURST_PROMOTION_ENABLED == 1U)
+        /* Tasks that keep blocking early have turned interactive */
+        promoteShortBurstTasks();
+#endif
+#if (MLFQ_AGING_ENABLED == 1U) && (MLFQ_TIMER_WHEEL_ENABLED == 0U)
+        /* Promote only the tasks that have been starving; a task can only
+         * be starving while its level has a ready task */
+        if ((schedulerGetReadyLevels() & ~(1UL << MLFQ_QUEUE_HIGH)) != 0U)
+        {
+            promoteStarvingTasks();
+        }
+#endif
+        g_lastScanTick = xNow;
+    }
+#endif
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U) && (MLFQ_TIMER_WHEEL_ENABLED == 0U)
+    /* Demoted periodic tasks about to wake go back to High first */
+    TickType_t xToWake = (TickType_t)prePromotePeriodicTasks(xNow, (uint32_t)portMAX_DELAY);
+#endif
+
+    if (boostEarly || ((xNow - g_lastBoostTick) >= xBoostPeriod))
+    {
+#if (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+        /* The next period starts at this boost */
+        tuneBoostPeriod(boostEarly);
+        xBoostPeriod = pdMS_TO_TICKS(g_boostPeriodMs);
+#endif
+
+#if (MLFQ_ADAPTIVE_QUANTUM_ENABLED == 1U)
+        /* The boost below re-arms everyone with the adapted quanta; a
+         * rolling boost adapts once per full round */
+        if (g_boostSlice == 0U)
+        {
+            adaptQuanta();
+        }
+#endif
+
+#if ((MLFQ_AGING_ENABLED == 0U) || (MLFQ_AGING_KEEP_GLOBAL_BOOST == 1U))
+#if (MLFQ_DEGRADE_ENABLED == 1U)
+        /* Degraded mode keeps the shed work down; the period still runs */
+        if (!g_degraded)
+#endif
+        {
+#if (MLFQ_BOOST_SLICES > 1U)
+            performBoostSlice(g_boostSlice);
+#else
+            performGlobalBoost();
+#endif
+        }
+#endif
+
+        g_boostSlice    = (g_boostSlice + 1U) % MLFQ_BOOST_SLICES;
+        g_lastBoostTick = xNow;
+    }
+
+    TickType_t xNext = xBoostPeriod - (xNow - g_lastBoostTick);
+
+#if (MLFQ_BOOST_AUTOTUNE_ENABLED == 1U)
+    TickType_t xToTune = xTunePeriod - (xNow - g_lastTuneTick);
+    if (xToTune < xNext)
+    {
+        xNext = xToTune;
+    }
+#endif
+
+#if (MLFQ_POLICY_SCAN_ENABLED)
+    TickType_t xToScan = xScanPeriod - (xNow - g_lastScanTick);
+    if (xToScan < xNext)
+    {
+        xNext = xToScan;
+    }
+#endif
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U) && (MLFQ_TIMER_WHEEL_ENABLED == 0U)
+    if (xToWake < xNext)
+    {
+        xNext = xToWake;
+    }
+#endif
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U)
+    /* Aging and pre-promotion: only the timers that are due. After the
+     * boost, so the tasks it lifted to High are cancelled, not aged */
+    TickType_t xToTimer = (TickType_t)serviceTimers(xNow);
+    if (xToTimer < xNext)
+    {
+        xNext = xToTimer;
+    }
+#endif
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    /* Every other partition boosts its own members on its own period */
+    TickType_t xToPartition = (TickType_t)servePartitionBoosts(xNow);
+    if (xToPartition < xNext)
+    {
+        xNext = xToPartition;
+    }
+#endif
+
+#if (MLFQ_RESERVE_ENABLED == 1U)
+    /* After the boost, so the tasks it lifted out of Low are not touched */
+    TickType_t xToReserve = (TickType_t)serveReservation(xNow);
+    if (xToReserve < xNext)
+    {
+        xNext = xToReserve;
+    }
+#endif
+
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+    const TickType_t xBalancePeriod = pdMS_TO_TICKS(MLFQ_CORE_BALANCE_MS);
+
+    if ((xNow - g_lastBalanceTick) >= xBalancePeriod)
+    {
+        balanceCores();
+        g_lastBalanceTick = xNow;
+    }
+
+    TickType_t xToBalance = xBalancePeriod - (xNow - g_lastBalanceTick);
+    if (xToBalance < xNext)
+    {
+        xNext = xToBalance;
+    }
+#endif
+
+#if (MLFQ_OVERLOAD_ENABLED == 1U)
+    const TickType_t xCheckPeriod = pdMS_TO_TICKS(MLFQ_OVERLOAD_CHECK_MS);
+
+    if ((xNow - g_lastOverloadTick) >= xCheckPeriod)
+    {
+        checkOverload();
+        g_lastOverloadTick = xNow;
+    }
+
+    TickType_t xToCheck = xCheckPeriod - (xNow - g_lastOverloadTick);
+    if (xToCheck < xNext)
+    {
+        xNext = xToCheck;
+    }
+#endif
+
+    return (uint32_t)xNext;
+}
+
+/*
+ * Description : MLFQ pick_priority: the priority of the slot's level.
+ */
+static uint32_t mlfqPickPriority(uint32_t slot)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+    MLFQ_QueueLevel_t level = (record != NULL) ? (MLFQ_QueueLevel_t)record->level :
+                                                 MLFQ_QUEUE_HIGH;
+
+    return (uint32_t)MLFQ_TO_RTOS_LEVEL_SETTER(level);
+}
+
+/* The feedback queues; levels move on expiry, scan and boost only */
+const SchedPolicy_t g_mlfqPolicy =
+{
+    "MLFQ",
+    NULL,
+    mlfqOnQuantumExpired,
+    NULL,
+    mlfqOnPeriodic,
+    mlfqPickPriority,
+};
+
+/* Policy driven by the supervisor */
+#if (SCHED_POLICY == SCHED_POLICY_MLFQ)
+static const SchedPolicy_t *const g_policy = &g_mlfqPolicy;
+#elif (SCHED_POLICY == SCHED_POLICY_STRIDE)
+static const SchedPolicy_t *const g_policy = &g_stridePolicy;
+#else
+static const SchedPolicy_t *const g_policy = &g_lotteryPolicy;
+#endif
+
+/*
+ * Description : Hands one expired slot to the policy, first charging the
+ *               time since the hook reported it to the latency metrics.
+ */
+static void handleExpiry(uint32_t slot)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+#if (TICK_PROFILER_COMPACT_ENABLED == 0U)
+    if (record != NULL)
+    {
+        uint32_t latency = cycleCounterGet() - record->expiry_cycle;
+
+        taskENTER_CRITICAL();
+        g_expiryLatency.count++;
+        g_expiryLatency.last_cycles = latency;
+        g_expiryLatency.total_cycles += latency;
+        if (latency > g_expiryLatency.max_cycles)
+        {
+            g_expiryLatency.max_cycles = latency;
+        }
+        taskEXIT_CRITICAL();
+    }
+#else
+    /* The compact record keeps no expiry stamp; the latency stays zero */
+    (void)record;
+#endif
+
+    g_policy->on_quantum_expired(slot);
+}
+
+/*
+ * Description : Returns the pinned-table index of a task, or -1.
+ *               Must be called inside a critical section.
+ */
+static int32_t findPinned(TaskHandle_t taskHandle)
+{
+    for (uint32_t i = 0U; i < MLFQ_MAX_PINNED_TASKS; i++)
+    {
+        if ((taskHandle != NULL) && (g_pinnedTasks[i] == taskHandle))
+        {
+            return (int32_t)i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Description : Returns true for priorities a task may be pinned at:
+ *               the real-time band above the supervisor, or anything
+ *               above idle and below the Low level.
+ */
+static bool isPinnablePriority(UBaseType_t priority)
+{
+#if (MLFQ_RT_BAND_SIZE > 0U)
+    if ((priority >= MLFQ_RT_PRIORITY_MIN) && (priority <= MLFQ_RT_PRIORITY_MAX))
+    {
+        return true;
+    }
+#endif
+
+    return (priority > tskIDLE_PRIORITY) &&
+           (priority < mlfqLevelPriority(MLFQ_QUEUE_LOW));
+}
+
+/*
+ * Description : Allocates a profiler slot for a task at the High level
+ *               and arms its quantum. Does not touch the RTOS priority,
+ *               so it is usable from the kernel task-create hook.
+ *               Returns false if the task is already registered or the
+ *               table is full.
+ */
+static bool admitTask(TaskHandle_t taskHandle)
+{
+    /* Pinned tasks stay outside the MLFQ; otherwise allocate the shared
+     * record (stamps the arrival tick) */
+    if (schedulerIsTaskPinned(taskHandle) || !setupTaskStats(taskHandle))
+    {
+        return false;
+    }
+
+    uint32_t slot = (uint32_t)tickProfilerGetSlot(taskHandle);
+
+    tickProfilerSetLevel(slot, (uint8_t)MLFQ_QUEUE_HIGH);
+    g_levelFloor[slot] = (uint8_t)MLFQ_QUEUE_LOW;
+
+#if (LATENCY_STATS_ENABLED == 1U)
+    /* Start from an empty histogram (and no target) if the slot was used
+     * before */
+    latencyResetTask(slot);
+#endif
+
+#if (BURST_STATS_ENABLED == 1U)
+    burstResetTask(slot);
+#endif
+
+#if (AGING_WAIT_TRACKING_ENABLED == 1U)
+    agingResetTask(slot);
+#endif
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+    wakePeriodResetTask(slot);
+#endif
+
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+    interactivityResetTask(slot);
+#endif
+
+#if (INVERSION_STATS_ENABLED == 1U)
+    inversionResetTask(slot);
+#endif
+
+#if (WAIT_STATS_ENABLED == 1U)
+    waitStatsResetTask(slot);
+#endif
+
+#if (PC_SAMPLER_ENABLED == 1U)
+    pcSamplerResetTask(slot);
+#endif
+
+#if (STATE_TIME_ENABLED == 1U)
+    stateTimeResetTask(slot, taskHandle);
+#endif
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    g_taskWeight[slot]   = (uint8_t)MLFQ_WEIGHT_DEFAULT;
+    g_weightParked[slot] = false;
+#endif
+
+#if (MLFQ_BOTTOM_HALF_ENABLED == 1U)
+    g_bottomHalfBudgetUs[slot] = 0U;
+    g_bottomHalfStrikes[slot]  = 0U;
+#endif
+
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+    /* Not counted while the core is picked; the supervisor sets the
+     * affinity at its next balance check */
+    g_homeCore[slot] = (uint8_t)TICK_PROFILER_CORES;
+    g_homeCore[slot] = (uint8_t)leastLoadedCore();
+    g_homePending[slot] = true;
+#endif
+
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    /* Called with interrupts masked by the create hook, or from a task */
+    taskENTER_CRITICAL();
+    g_slotGroup[slot] = (uint8_t)MLFQ_GROUP_DEFAULT;
+    g_groups[MLFQ_GROUP_DEFAULT].tasks++;
+    g_groupWeight[MLFQ_GROUP_DEFAULT] += MLFQ_WEIGHT_DEFAULT;
+    g_totalWeight += MLFQ_WEIGHT_DEFAULT;
+    taskEXIT_CRITICAL();
+#endif
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    taskENTER_CRITICAL();
+    g_slotPartition[slot] = (uint8_t)MLFQ_PARTITION_DEFAULT;
+    g_partitions[MLFQ_PARTITION_DEFAULT].tasks++;
+    taskEXIT_CRITICAL();
+#endif
+
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+    /* The bindings of the slot's last task do not carry over */
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0U; i < MLFQ_EVENT_BOOST_MAX_BINDINGS; i++)
+    {
+        g_eventSlots[i][slot / 32U] &= ~(1UL << (slot % 32U));
+    }
+    taskEXIT_CRITICAL();
+#endif
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+    /* Nor does the callback, or a change it had not been told of */
+    taskENTER_CRITICAL();
+    g_levelCallback[slot] = NULL;
+    g_levelCallbackContext[slot] = NULL;
+    g_levelCallbackPending[slot / 32U] &= ~(1UL << (slot % 32U));
+    taskEXIT_CRITICAL();
+#endif
+
+    MLFQ_QueueLevel_t startLevel = MLFQ_QUEUE_HIGH;
+
+#if (MLFQ_WARM_START_ENABLED == 1U)
+    /* A task seen on an earlier boot starts where it settled then. The
+     * partition is set by now, so its level count applies */
+    const ParamStoreClass_t *saved = warmFindClass(warmNameHash(pcTaskGetName(taskHandle)));
+
+    if (saved != NULL)
+    {
+        startLevel = partitionLevel(slot, (saved->level < MLFQ_NUM_LEVELS) ?
+                                          (MLFQ_QueueLevel_t)saved->level :
+                                          MLFQ_QUEUE_LOW);
+        tickProfilerSetLevel(slot, (uint8_t)startLevel);
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+        interactivitySeedTask(slot, saved->score);
+#endif
+    }
+    g_warmDeepest[slot] = (uint8_t)startLevel;
+#endif
+
+    /* Assign initial quantum */
+    applyLevelQuantum(slot, startLevel);
+
+    if (g_policy->on_register != NULL)
+    {
+        g_policy->on_register(slot);
+    }
+
+    /* Let the host decoder label this slot */
+    g_namePending[slot] = true;
+
+    return true;
+}
+
+/*
+ * Description : Logs the names of newly registered tasks. Runs in the
+ *               supervisor, the only producer of the snapshot ring.
+ */
+static void flushPendingNames(void)
+{
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+
+        if (g_namePending[slot])
+        {
+            g_namePending[slot] = false;
+
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+            if (record != NULL)
+            {
+                logTaskName(slot, record->task);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Initializes the scheduler subsystem.
+ *               Sets up the tick profiler, whose task table also
+ *               holds the scheduler's per-task state.
+ */
+void initScheduler(void)
+{
+    /* Start the cycle counter before the profiler samples it */
+    cycleCounterInit();
+
+#if (BURST_STATS_ENABLED == 1U)
+    burstStatsInit();
+#endif
+
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+    interactivityInit();
+#endif
+
+    /* A custom level table must still order levels strictly by priority,
+     * stay below the supervisor and above the logger task */
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        configASSERT(g_mlfqLevelTable[level].quantum_ticks > 0U);
+        configASSERT(g_mlfqLevelTable[level].rtos_priority <= MLFQ_TOP_PRIORITY_NUMBER);
+        configASSERT(g_mlfqLevelTable[level].rtos_priority > METRICS_LOGGER_PRIORITY);
+        if (level > 0U)
+        {
+            configASSERT(g_mlfqLevelTable[level].rtos_priority <
+                         g_mlfqLevelTable[level - 1U].rtos_priority);
+        }
+
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+        g_levelPriorityMask |= (1UL << g_mlfqLevelTable[level].rtos_priority);
+        g_levelOfPriority[g_mlfqLevelTable[level].rtos_priority] = (uint8_t)level;
+#endif
+    }
+
+#if (MLFQ_RESERVE_ENABLED == 1U) && (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+    /* Low tasks on the reservation count as ready Low tasks */
+    g_levelPriorityMask |= (1UL << MLFQ_RESERVE_PRIORITY);
+    g_levelOfPriority[MLFQ_RESERVE_PRIORITY] = (uint8_t)MLFQ_QUEUE_LOW;
+#endif
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    /* Parked Low tasks are still Low */
+    configASSERT(MLFQ_WEIGHT_PARK_PRIORITY > tskIDLE_PRIORITY);
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+    g_levelPriorityMask |= (1UL << MLFQ_WEIGHT_PARK_PRIORITY);
+    g_levelOfPriority[MLFQ_WEIGHT_PARK_PRIORITY] = (uint8_t)MLFQ_QUEUE_LOW;
+#endif
+#endif
+
+    g_boostStats.boost_count = 0U;
+    g_boostStats.last_cycles = 0U;
+    g_boostStats.max_cycles  = 0U;
+    g_boostStats.early_boosts = 0U;
+
+    /* Start from the compiled-in parameters */
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        g_tunables.quantum_ticks[level] = mlfqLevelQuantumTicks((MLFQ_QueueLevel_t)level);
+        g_tunables.quantum_us[level]    = mlfqLevelQuantumUs((MLFQ_QueueLevel_t)level);
+    }
+    g_tunables.boost_period_ms   = MLFQ_BOOST_PERIOD_MS;
+    g_boostPeriodMs              = MLFQ_BOOST_PERIOD_MS;
+    g_tunables.reporting_enabled = (MLFQ_REPORT_ON_DEMAND_ENABLED == 0U);
+
+#if (PARAM_STORE_ENABLED == 1U)
+    /* Warm boot: a valid, in-range EEPROM record replaces the defaults */
+    MLFQ_Tunables_t stored;
+
+    if (paramStoreInit() && paramStoreLoad(&stored) && schedulerSetTunables(&stored))
+    {
+        sendLog("[System] Tuned scheduler parameters loaded from EEPROM.\r\n");
+    }
+
+#if (MLFQ_WARM_START_ENABLED == 1U)
+    /* paramStoreInit() has run above, whatever the tunables held */
+    if (paramStoreLoadClasses(g_warmClasses, &g_warmClassCount))
+    {
+        sendLog("[System] Task classes loaded from EEPROM.\r\n");
+    }
+    else
+    {
+        g_warmClassCount = 0U;
+    }
+#endif
+#endif
+
+    /* Initialize runtime profiling system and the shared task table */
+    tickProfilerInit();
+
+#if (configUSE_MLFQ_EDF == 1)
+    /* Deadline tasks are ordered within the High level only */
+    vTaskMlfqSetEdfPriority(MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH));
+#endif
+
+#if (configUSE_MLFQ_SLICE_CONTROL == 1) && (SCHED_POLICY == SCHED_POLICY_MLFQ)
+    /* Levels that rotate at quantum ends only. The rotation comes from the
+     * expiry itself: the supervisor preempts the task to handle it, and
+     * the kernel then picks the next task of that priority (with
+     * kernel-native MLFQ the tick asks for the switch) */
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        vTaskMlfqSetTimeSlicing(g_mlfqLevelTable[level].rtos_priority,
+                                (g_mlfqLevelTable[level].quantum_round_robin == 0U) ? pdTRUE : pdFALSE);
+    }
+
+#if (MLFQ_RESERVE_ENABLED == 1U)
+    /* Low tasks on the reservation keep the Low rotation */
+    vTaskMlfqSetTimeSlicing(MLFQ_RESERVE_PRIORITY,
+                            (g_mlfqLevelTable[MLFQ_QUEUE_LOW].quantum_round_robin == 0U) ? pdTRUE : pdFALSE);
+#endif
+#endif
+
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+    /* Tell the profiler how each level gives its quantum back */
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        uint32_t window = g_mlfqLevelTable[level].budget_window_ms;
+
+        if ((window != MLFQ_BUDGET_KEEP) && (window != MLFQ_BUDGET_RESET_ON_BLOCK))
+        {
+            /* A window below one tick would be no window at all */
+            window = pdMS_TO_TICKS(window);
+            window = (window > 0U) ? window : 1U;
+        }
+        tickProfilerSetBudgetWindow((uint8_t)level, window);
+    }
+#endif
+}
+
+/*
+ * Description : Registers a new task with the scheduler.
+ *               Initializes profiling data, assigns the
+ *               highest priority queue, and sets the initial
+ *               quantum and arrival timestamp.
+ */
+void registerTask(TaskHandle_t taskHandle)
+{
+    if (!admitTask(taskHandle))
+    {
+        return;
+    }
+
+    /* Assign the starting RTOS priority (MLFQ: the High level) */
+    vTaskPrioritySet(taskHandle,
+                     g_policy->pick_priority((uint32_t)tickProfilerGetSlot(taskHandle)));
+}
+
+/*
+ * Description : Creates the task at the idle priority inside a scheduler
+ *               suspension, so nothing runs until it is registered; the
+ *               auto-registration hook also leaves a task at that
+ *               priority alone. Once admitted it takes the priority its
+ *               level calls for; a task that gets no slot is deleted
+ *               before the kernel resumes.
+ */
+TaskHandle_t schedulerCreateTask(TaskFunction_t code, const char *name,
+                                 uint32_t stackWords, void *parameters,
+                                 StackType_t *stack, StaticTask_t *tcb)
+{
+    TaskHandle_t handle = NULL;
+
+    vTaskSuspendAll();
+    {
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+        if ((stack != NULL) && (tcb != NULL))
+        {
+            handle = xTaskCreateStatic(code, name, stackWords, parameters,
+                                       tskIDLE_PRIORITY, stack, tcb);
+        }
+#else
+        (void)stack;
+        (void)tcb;
+#endif
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        if ((stack == NULL) && (tcb == NULL) &&
+            (xTaskCreate(code, name, (configSTACK_DEPTH_TYPE)stackWords,
+                         parameters, tskIDLE_PRIORITY, &handle) != pdPASS))
+        {
+            handle = NULL;
+        }
+#endif
+
+        if (handle != NULL)
+        {
+            if (admitTask(handle))
+            {
+                vTaskPrioritySet(handle,
+                                 g_policy->pick_priority((uint32_t)tickProfilerGetSlot(handle)));
+            }
+            else
+            {
+                vTaskDelete(handle);
+                handle = NULL;
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return handle;
+}
+
+/*
+ * Description : Removes a task from the scheduler and frees its slot.
+ *               The task keeps its current RTOS priority; call this
+ *               before deleting a task or handing it to another policy.
+ */
+void unregisterTask(TaskHandle_t taskHandle)
+{
+    int32_t slot = tickProfilerGetSlot(taskHandle);
+
+    if (slot < 0)
+    {
+        return;
+    }
+
+    g_namePending[slot] = false;
+
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    taskENTER_CRITICAL();
+    g_groups[g_slotGroup[slot]].tasks--;
+    g_groupWeight[g_slotGroup[slot]] -= g_taskWeight[slot];
+    g_totalWeight -= g_taskWeight[slot];
+    taskEXIT_CRITICAL();
+#endif
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    taskENTER_CRITICAL();
+    g_partitions[g_slotPartition[slot]].tasks--;
+    taskEXIT_CRITICAL();
+#endif
+
+#if (configUSE_MLFQ_NATIVE == 1)
+    /* Stop the tick charging the task */
+    vTaskMlfqSetLevel(taskHandle, (UBaseType_t)MLFQ_QUEUE_HIGH, 0U);
+#endif
+
+#if (configUSE_MLFQ_EDF == 1)
+    /* It keeps its priority, but no longer its place in the EDF order */
+    vTaskMlfqSetDeadline(taskHandle, 0U);
+#endif
+
+    (void)removeTaskStats(taskHandle);
+}
+
+/*
+ * Description : Pins a task at a fixed priority outside the MLFQ band.
+ *               The task gives up its profiler slot, so the tick hook,
+ *               the demotion path and the boost never see it again.
+ */
+bool pinTask(TaskHandle_t taskHandle, UBaseType_t priority)
+{
+    if ((taskHandle == NULL) || !isPinnablePriority(priority))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if (findPinned(taskHandle) < 0)
+        {
+            int32_t entry = -1;
+
+            for (uint32_t i = 0U; (entry < 0) && (i < MLFQ_MAX_PINNED_TASKS); i++)
+            {
+                if (g_pinnedTasks[i] == NULL)
+                {
+                    entry = (int32_t)i;
+                }
+            }
+
+            if (entry < 0)
+            {
+                taskEXIT_CRITICAL();
+                return false;
+            }
+
+            g_pinnedTasks[entry] = taskHandle;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    unregisterTask(taskHandle);
+    vTaskPrioritySet(taskHandle, priority);
+
+    return true;
+}
+
+/*
+ * Description : Releases the pinned entry of a task.
+ */
+void unpinTask(TaskHandle_t taskHandle)
+{
+    taskENTER_CRITICAL();
+    {
+        int32_t entry = findPinned(taskHandle);
+
+        if (entry >= 0)
+        {
+            g_pinnedTasks[entry] = NULL;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Checks whether a task is pinned.
+ */
+bool schedulerIsTaskPinned(TaskHandle_t taskHandle)
+{
+    bool pinned;
+
+    taskENTER_CRITICAL();
+    {
+        pinned = (findPinned(taskHandle) >= 0);
+    }
+    taskEXIT_CRITICAL();
+
+    return pinned;
+}
+
+#if (MLFQ_AUTO_REGISTER_ENABLED == 1U)
+/*
+ * Description : Kernel task-create hook (traceTASK_CREATE). A task created
+ *               at the High level priority (MLFQ_TOP_PRIORITY_NUMBER with
+ *               the default table) joins the MLFQ; anything else, such as
+ *               the idle, logger and supervisor tasks, is left alone.
+ *               Runs inside a kernel critical section.
+ */
+void schedulerTaskCreated(void *task, uint32_t priority)
+{
+    if (priority == (uint32_t)MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH))
+    {
+        (void)admitTask((TaskHandle_t)task);
+    }
+}
+
+/*
+ * Description : Kernel task-delete hook (traceTASK_DELETE). Frees the slot
+ *               of a registered or pinned task before its TCB is released.
+ *               Runs inside a kernel critical section.
+ */
+void schedulerTaskDeleted(void *task)
+{
+    unregisterTask((TaskHandle_t)task);
+    unpinTask((TaskHandle_t)task);
+}
+#endif
+
+#if (TASK_POOL_ENABLED == 1U)
+/*
+ * Description : Takes a TCB and stack from the pool and creates the task
+ *               on them. Both the take and the slot allocation done by
+ *               the create hook are constant time.
+ */
+TaskHandle_t schedulerSpawnTask(TaskFunction_t code, const char *name,
+                                uint32_t stackWords, void *parameters)
+{
+    void *tcb;
+    void *stack;
+    uint32_t depth;
+
+    if (!taskPoolTake(stackWords, &tcb, &stack, &depth))
+    {
+        return NULL;
+    }
+
+    return xTaskCreateStatic(code, name, depth, parameters,
+                             MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH),
+                             (StackType_t *)stack, (StaticTask_t *)tcb);
+}
+#endif
+
+/*
+ * Description : Updates the scheduling level of a task.
+ *               This includes updating the shared task record,
+ *               adjusting the FreeRTOS priority, resetting runtime
+ *               statistics, assigning a new time quantum, and
+ *               reflecting the change using system LEDs.
+ */
+void updateTaskPriority(TaskHandle_t task, MLFQ_QueueLevel_t newLevel)
+{
+    int32_t slot = tickProfilerGetSlot(task);
+
+    if (slot >= 0)
+    {
+        setSlotLevel((uint32_t)slot, newLevel);
+    }
+}
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+/*
+ * Description : Ends the Low round of a task that has used its quantum:
+ *               the task is parked below Low, and once no unparked Low
+ *               task is ready every parked one goes back to Low for the
+ *               next round. Over a round each CPU-bound Low task runs for
+ *               its weighted quantum, so the Low level is shared by
+ *               weight. Left alone while the reservation is served.
+ */
+static void parkLowTask(uint32_t slot)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+    bool roundOpen = false;
+
+#if (MLFQ_RESERVE_ENABLED == 1U)
+    if (g_reserveServing)
+    {
+        return;
+    }
+#endif
+
+    if ((record == NULL) || (record->level != (uint8_t)MLFQ_QUEUE_LOW))
+    {
+        return;
+    }
+
+    vTaskSuspendAll();
+    {
+        vTaskPrioritySet(record->task, MLFQ_WEIGHT_PARK_PRIORITY);
+        g_weightParked[slot] = true;
+
+        for (uint32_t word = 0U; (word < TICK_PROFILER_SLOT_MASK_WORDS) && !roundOpen; word++)
+        {
+            uint32_t members = tickProfilerGetLevelMask((uint8_t)MLFQ_QUEUE_LOW, word);
+
+            while (members != 0U)
+            {
+                uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+                uint32_t member = (word * 32U) + bit;
+                TickProfilerTaskInfo_t *other = tickProfilerGetRecord(member);
+
+                members &= ~(1UL << bit);
+
+                if ((other != NULL) && !g_weightParked[member] &&
+                    (eTaskGetState(other->task) == eReady))
+                {
+                    roundOpen = true;
+                    break;
+                }
+            }
+        }
+
+        if (!roundOpen)
+        {
+            for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+            {
+                uint32_t members = tickProfilerGetLevelMask((uint8_t)MLFQ_QUEUE_LOW, word);
+
+                while (members != 0U)
+                {
+                    uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+                    uint32_t member = (word * 32U) + bit;
+                    TickProfilerTaskInfo_t *other = tickProfilerGetRecord(member);
+
+                    members &= ~(1UL << bit);
+
+                    if ((other != NULL) && g_weightParked[member])
+                    {
+                        vTaskPrioritySet(other->task, levelPriority(MLFQ_QUEUE_LOW));
+                        g_weightParked[member] = false;
+                    }
+                }
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+}
+#endif
+
+/*
+ * Description : Demotes a task to a lower priority queue
+ *               when it exhausts its assigned time quantum.
+ *               Tasks at the lowest level, or at the floor of
+ *               their latency target, remain there.
+ */
+void checkForDemotion(uint8_t table_index)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(table_index);
+
+    if (record == NULL)
+    {
+        return;
+    }
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    /* Only a quantum used at Low ends a Low round */
+    bool wasLow = (record->level == (uint8_t)MLFQ_QUEUE_LOW);
+#endif
+
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+    /* The score, not the expiry itself, decides the level */
+    placeByScore(table_index, true);
+#else
+    MLFQ_QueueLevel_t currentLevel = (MLFQ_QueueLevel_t)record->level;
+    MLFQ_QueueLevel_t floorLevel = (MLFQ_QueueLevel_t)g_levelFloor[table_index];
+
+    if(currentLevel < floorLevel)
+    {
+        setSlotLevel(table_index, (MLFQ_QueueLevel_t)(currentLevel + 1));
+    }
+    else
+    {
+        setSlotLevel(table_index, floorLevel);
+    }
+#endif
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    if (wasLow)
+    {
+        parkLowTask(table_index);
+    }
+#endif
+}
+
+/*
+ * Description : Performs a global priority boost.
+ *               Periodically elevates all tasks back to
+ *               the highest priority queue to prevent starvation.
+ *               The kernel scheduler is suspended once for the whole
+ *               batch so priority changes cannot trigger a context
+ *               switch each, profiler counters are re-armed under a
+ *               single critical section, and the LED is written once.
+ */
+void performGlobalBoost(void)
+{
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    /* The other partitions' members keep their levels and quanta */
+    if (g_partitionsCreated != 0U)
+    {
+        boostPartition(MLFQ_PARTITION_DEFAULT);
+        return;
+    }
+#endif
+
+    uint32_t start = cycleCounterGet();
+
+    GPIO_PROBE_HIGH(GPIO_PROBE_PIN_BOOST);
+
+#if (EVENT_TRACE_ENABLED == 1U)
+    eventTraceRecord(EVENT_TRACE_BOOST_START, NULL, 0U, 0U);
+#endif
+
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+    uint32_t quantumCycles = TICK_PROFILER_US_TO_CYCLES(g_tunables.quantum_us[MLFQ_QUEUE_HIGH]);
+    uint32_t quantumTicks  = (quantumCycles + TICK_PROFILER_CYCLES_PER_TICK - 1U) /
+                             TICK_PROFILER_CYCLES_PER_TICK;
+#else
+    uint32_t quantumTicks  = g_tunables.quantum_ticks[MLFQ_QUEUE_HIGH];
+    uint32_t quantumCycles = quantumTicks * TICK_PROFILER_CYCLES_PER_TICK;
+#endif
+
+    /* Tasks already in High keep their priority; only their quantum
+     * is re-armed below */
+    g_levelChanges.coalesced += tickProfilerGetLevelCount((uint8_t)MLFQ_QUEUE_HIGH);
+
+    vTaskSuspendAll();
+    {
+        /* Only the members of the levels below High change priority */
+        for (uint32_t level = (uint32_t)MLFQ_QUEUE_HIGH + 1U; level < MLFQ_NUM_LEVELS; level++)
+        {
+            for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+            {
+                uint32_t members = tickProfilerGetLevelMask((uint8_t)level, word);
+
+                while (members != 0U)
+                {
+                    uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+                    uint32_t slot = (word * 32U) + bit;
+                    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+                    members &= ~(1UL << bit);
+
+                    if (record != NULL)
+                    {
+                        tickProfilerSetLevel(slot, (uint8_t)MLFQ_QUEUE_HIGH);
+                        vTaskPrioritySet(record->task,
+                                         MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH));
+                        g_levelChanges.applied++;
+                    }
+                }
+            }
+        }
+
+#if (configUSE_MLFQ_NATIVE == 1)
+        /* The kernel's run count restarts for everyone, High included */
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(tickProfilerGetActiveSlot(i));
+
+            if (record != NULL)
+            {
+                vTaskMlfqSetLevel(record->task, (UBaseType_t)MLFQ_QUEUE_HIGH,
+                                  (UBaseType_t)quantumTicks);
+            }
+        }
+#endif
+
+        /* Fresh High quantum and zero runtime for everyone */
+        tickProfilerRearmAll(quantumTicks, quantumCycles);
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+        /* The round ends with the boost; weighted tasks get their own
+         * High quantum back */
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            uint32_t slot = tickProfilerGetActiveSlot(i);
+
+            g_weightParked[slot] = false;
+            if (g_taskWeight[slot] != MLFQ_WEIGHT_DEFAULT)
+            {
+                applyLevelQuantum(slot, MLFQ_QUEUE_HIGH);
+            }
+        }
+#endif
+    }
+    (void)xTaskResumeAll();
+
+    finishBoost(start);
+}
+
+/*
+ * Description : Maps the kernel's ready priority bitmap onto MLFQ levels,
+ *               visiting only the set bits of the band with CLZ, the way
+ *               the port selects the next task.
+ */
+uint32_t schedulerGetReadyLevels(void)
+{
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+    uint32_t ready = (uint32_t)uxTaskGetReadyPriorities() & g_levelPriorityMask;
+    uint32_t levels = 0U;
+
+    while (ready != 0U)
+    {
+        uint32_t priority = 31U - (uint32_t)TICK_PROFILER_CLZ(ready);
+
+        ready &= ~(1UL << priority);
+        levels |= (1UL << g_levelOfPriority[priority]);
+    }
+
+    return levels;
+#else
+    return (1UL << MLFQ_NUM_LEVELS) - 1U;
+#endif
+}
+
+/*
+ * Description : Returns the number of managed tasks currently at a level.
+ */
+uint32_t schedulerGetLevelPopulation(MLFQ_QueueLevel_t level)
+{
+    if ((uint32_t)level >= MLFQ_NUM_LEVELS)
+    {
+        return 0U;
+    }
+
+    return tickProfilerGetLevelCount((uint8_t)level);
+}
+
+/*
+ * Description : Copies the profiler slots of the tasks at a level, highest
+ *               slot of each word first, stopping after maxSlots entries. Returns the
+ *               number of slots written.
+ */
+uint32_t schedulerGetLevelMembers(MLFQ_QueueLevel_t level, uint32_t *slots,
+                                  uint32_t maxSlots)
+{
+    uint32_t written = 0U;
+
+    if (((uint32_t)level >= MLFQ_NUM_LEVELS) || (slots == NULL))
+    {
+        return 0U;
+    }
+
+    for (uint32_t word = 0U; (word < TICK_PROFILER_SLOT_MASK_WORDS) && (written < maxSlots); word++)
+    {
+        uint32_t members = tickProfilerGetLevelMask((uint8_t)level, word);
+
+        while ((members != 0U) && (written < maxSlots))
+        {
+            uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+
+            members &= ~(1UL << bit);
+            slots[written++] = (word * 32U) + bit;
+        }
+    }
+
+    return written;
+}
+
+/*
+ * Description : Copies the global boost cost metrics.
+ */
+void schedulerGetBoostStats(MLFQ_BoostStats_t *output)
+{
+    if (output != NULL)
+    {
+        *output = g_boostStats;
+        output->period_ms = g_boostPeriodMs;
+    }
+}
+
+/*
+ * Description : Copies the clock scaling counters.
+ */
+void schedulerGetClockStats(MLFQ_ClockStats_t *output)
+{
+    if (output != NULL)
+    {
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+        *output = g_clockStats;
+#else
+        output->slowdowns = 0U;
+        output->slow_ms   = 0U;
+#endif
+        output->clock_hz = (uint32_t)configCPU_CLOCK_HZ;
+    }
+}
+
+/*
+ * Description : Returns the number of demotions since init.
+ */
+uint32_t schedulerGetDemotionCount(void)
+{
+    return g_demotionCount;
+}
+
+/*
+ * Description : Returns the number of periodic tasks moved to High ahead
+ *               of their wake since init.
+ */
+uint32_t schedulerGetPrePromotionCount(void)
+{
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+    return g_prePromotions;
+#else
+    return 0U;
+#endif
+}
+
+/*
+ * Description : Returns the number of tasks moved to High by a bound
+ *               event since init.
+ */
+uint32_t schedulerGetEventBoostCount(void)
+{
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+    return g_eventBoosts;
+#else
+    return 0U;
+#endif
+}
+
+/*
+ * Description : Installs a task's level-change callback. The callback
+ *               and its argument are swapped in one critical section, so
+ *               the supervisor never pairs one with the other's argument.
+ */
+bool schedulerSetLevelCallback(TaskHandle_t task, MLFQ_LevelCallback_t callback, void *context)
+{
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+    int32_t slot = tickProfilerGetSlot(task);
+
+    if (slot < 0)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    g_levelCallback[slot] = callback;
+    g_levelCallbackContext[slot] = context;
+    taskEXIT_CRITICAL();
+
+    return true;
+#else
+    (void)task;
+    (void)callback;
+    (void)context;
+    return false;
+#endif
+}
+
+/*
+ * Description : Collects the scheduler's own counters with the expiry
+ *               counts of the tick hook and the supervisor's CPU time.
+ *               Each is read whole, the set not at one instant.
+ */
+void schedulerGetSelfMetrics(MLFQ_SelfMetrics_t *output)
+{
+    TickProfilerExpiryStats_t expiries;
+    TickProfilerCpuTime_t cpu;
+
+    if (output == NULL)
+    {
+        return;
+    }
+
+    tickProfilerGetExpiryStats(&expiries);
+    tickProfilerGetCpuTime(&cpu);
+
+    output->demotions          = g_demotionCount;
+    output->promotions         = g_promotionCount;
+    output->boosts             = g_boostStats.boost_count;
+    output->expiries_received  = expiries.reported;
+    output->expiries_coalesced = expiries.coalesced;
+    output->expiries_dropped   = expiries.dropped;
+    output->queue_high_water   = expiries.max_queued;
+    output->wakes              = g_supervisorPasses;
+    output->supervisor_time    = cpu.supervisor;
+}
+
+/*
+ * Description : Copies the applied and coalesced level change counts.
+ *               Only the supervisor writes them.
+ */
+void schedulerGetLevelChangeStats(MLFQ_LevelChangeStats_t *output)
+{
+    if (output != NULL)
+    {
+        taskENTER_CRITICAL();
+        *output = g_levelChanges;
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*
+ * Description : Copies the expiry latency metrics in one critical section.
+ */
+void schedulerGetExpiryLatencyStats(MLFQ_ExpiryLatencyStats_t *output)
+{
+    if (output != NULL)
+    {
+        taskENTER_CRITICAL();
+        *output = g_expiryLatency;
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*
+ * Description : Starts the expiry latency metrics from zero.
+ */
+void schedulerResetExpiryLatencyStats(void)
+{
+    taskENTER_CRITICAL();
+    g_expiryLatency.count        = 0U;
+    g_expiryLatency.last_cycles  = 0U;
+    g_expiryLatency.max_cycles   = 0U;
+    g_expiryLatency.total_cycles = 0U;
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Copies the overload state. Returns false when overload
+ *               detection is not built in.
+ */
+bool schedulerGetOverloadStatus(MLFQ_OverloadStatus_t *output)
+{
+#if (MLFQ_OVERLOAD_ENABLED == 1U)
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *output = g_overload;
+    taskEXIT_CRITICAL();
+
+    return true;
+#else
+    (void)output;
+    return false;
+#endif
+}
+
+/*
+ * Description : Installs the overload alarm hook; NULL removes it.
+ */
+void schedulerSetOverloadHook(MLFQ_OverloadHook_t hook)
+{
+#if (MLFQ_OVERLOAD_ENABLED == 1U)
+    g_overloadHook = hook;
+#else
+    (void)hook;
+#endif
+}
+
+/*
+ * Description : Copies the scheduler parameters currently in force.
+ */
+void schedulerGetTunables(MLFQ_Tunables_t *output)
+{
+    if (output == NULL)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *output = g_tunables;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Wakes the supervisor from task context so it picks up a
+ *               console request before its next timed pass.
+ */
+static void wakeSupervisor(void)
+{
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+    /* A full command queue only delays the request to the next pass */
+    (void)xTimerPendFunctionCall(supervisorDeferredPass, NULL, 0U, 0U);
+#else
+    xTaskNotifyGive(g_supervisorHandle);
+#endif
+}
+
+/*
+ * Description : Validates a parameter set and queues it for the
+ *               supervisor. A set queued before the previous one was
+ *               applied replaces it.
+ */
+bool schedulerSetTunables(const MLFQ_Tunables_t *input)
+{
+    if ((input == NULL) ||
+        (input->boost_period_ms < MLFQ_BOOST_PERIOD_MIN_MS) ||
+        (input->boost_period_ms > MLFQ_BOOST_PERIOD_MAX_MS))
+    {
+        return false;
+    }
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        if ((input->quantum_ticks[level] == 0U) ||
+            (input->quantum_ticks[level] > MLFQ_QUANTUM_MAX_TICKS) ||
+            (input->quantum_us[level] == 0U) ||
+            (input->quantum_us[level] > MLFQ_QUANTUM_MAX_US))
+        {
+            return false;
+        }
+    }
+
+    if (g_supervisorHandle == NULL)
+    {
+        /* Kernel not running yet: nothing can observe a partial update */
+        g_tunables = *input;
+        return true;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        g_pendingTunables = *input;
+        g_tunablesPending = true;
+    }
+    taskEXIT_CRITICAL();
+
+    wakeSupervisor();
+    return true;
+}
+
+/*
+ * Description : Queues a level count for the supervisor, like a
+ *               parameter set.
+ */
+bool schedulerSetLevelCount(uint32_t levels)
+{
+    if ((levels == 0U) || (levels > MLFQ_NUM_LEVELS))
+    {
+        return false;
+    }
+
+    if (g_supervisorHandle == NULL)
+    {
+        g_levelCount = levels;
+        return true;
+    }
+
+    g_pendingLevelCount = levels;
+    wakeSupervisor();
+    return true;
+}
+
+/*
+ * Description : Returns the levels in use in the default partition.
+ */
+uint32_t schedulerGetLevelCount(void)
+{
+    return g_levelCount;
+}
+
+/*
+ * Description : Builds the table from the registered tasks first, each
+ *               with the deepest level it reached in the window, then
+ *               keeps the saved classes of tasks not running now while
+ *               there is room. The deepest level is used because a
+ *               boost lifts every task to High for a while; a CPU-bound
+ *               task sampled then would be saved as interactive. Two
+ *               tasks of one name share the first one's class.
+ */
+TickType_t schedulerWarmStartService(void)
+{
+#if (MLFQ_WARM_START_ENABLED == 1U)
+    const TickType_t period = pdMS_TO_TICKS(MLFQ_WARM_START_SAVE_MS);
+    TickType_t elapsed = xTaskGetTickCount() - g_warmLastSave;
+    ParamStoreClass_t table[PARAM_STORE_CLASS_ENTRIES];
+    uint32_t count = 0U;
+    bool changed = false;
+
+    if (elapsed < period)
+    {
+        return period - elapsed;
+    }
+    g_warmLastSave += elapsed;
+
+    for (uint32_t i = 0U; (i < tickProfilerGetActiveCount()) &&
+                          (count < PARAM_STORE_CLASS_ENTRIES); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+        ParamStoreClass_t entry;
+        bool duplicate = false;
+
+        if (record == NULL)
+        {
+            continue;
+        }
+
+        entry.name_hash = warmNameHash(pcTaskGetName(record->task));
+        entry.level     = g_warmDeepest[slot];
+        g_warmDeepest[slot] = record->level;
+#if (MLFQ_SCORE_CLASSIFIER_ENABLED == 1U)
+        entry.score     = (uint8_t)interactivityGetScore(slot);
+#else
+        entry.score     = (uint8_t)(INTERACTIVITY_SCORE_MAX / 2U);
+#endif
+
+        for (uint32_t j = 0U; j < count; j++)
+        {
+            duplicate = duplicate || (table[j].name_hash == entry.name_hash);
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+
+        const ParamStoreClass_t *saved = warmFindClass(entry.name_hash);
+
+        if ((saved != NULL) && (saved->level == entry.level) &&
+            ((uint32_t)abs((int32_t)saved->score - (int32_t)entry.score) <= WARM_START_SCORE_SLACK))
+        {
+            entry.score = saved->score;
+        }
+        else
+        {
+            changed = true;
+        }
+
+        table[count++] = entry;
+    }
+
+    for (uint32_t i = 0U; (i < g_warmClassCount) && (count < PARAM_STORE_CLASS_ENTRIES); i++)
+    {
+        bool present = false;
+
+        for (uint32_t j = 0U; j < count; j++)
+        {
+            present = present || (table[j].name_hash == g_warmClasses[i].name_hash);
+        }
+        if (!present)
+        {
+            table[count++] = g_warmClasses[i];
+        }
+    }
+
+    /* Same classes in the same order: nothing to program */
+    changed = changed || (count != g_warmClassCount);
+    for (uint32_t i = 0U; !changed && (i < count); i++)
+    {
+        changed = (table[i].name_hash != g_warmClasses[i].name_hash);
+    }
+
+    if (changed && paramStoreSaveClasses(table, count))
+    {
+        /* admitTask() reads the table from the create hook */
+        taskENTER_CRITICAL();
+        for (uint32_t i = 0U; i < count; i++)
+        {
+            g_warmClasses[i] = table[i];
+        }
+        g_warmClassCount = count;
+        taskEXIT_CRITICAL();
+    }
+
+    return period;
+#else
+    return portMAX_DELAY;
+#endif
+}
+
+/*
+ * Description : Opens, renews or (with 0) ends the host report lease.
+ */
+void schedulerWatchReports(uint32_t leaseMs)
+{
+#if (MLFQ_REPORT_ON_DEMAND_ENABLED == 1U)
+    taskENTER_CRITICAL();
+    {
+        g_reportLeaseStart = xTaskGetTickCount();
+        g_reportLeaseTicks = pdMS_TO_TICKS(leaseMs);
+    }
+    taskEXIT_CRITICAL();
+
+    /* A new reader gets its first report now, not a period later */
+    if ((leaseMs > 0U) && (g_supervisorHandle != NULL))
+    {
+        wakeSupervisor();
+    }
+#else
+    (void)leaseMs;
+#endif
+}
+
+/*
+ * Description : Flags an out-of-period queue report for the supervisor.
+ */
+void schedulerRequestReport(void)
+{
+    g_reportRequested = true;
+
+    if (g_supervisorHandle != NULL)
+    {
+        wakeSupervisor();
+    }
+}
+
+/*
+ * Description : Returns the name of the compiled-in scheduling policy.
+ */
+const char *schedulerPolicyName(void)
+{
+    return g_policy->name;
+}
+
+/*
+ * Description : Sets the tickets of a task under stride or lottery
+ *               scheduling. Always fails under the MLFQ.
+ */
+bool schedulerSetTickets(TaskHandle_t task, uint32_t tickets)
+{
+#if (SCHED_POLICY != SCHED_POLICY_MLFQ)
+    int32_t slot = tickProfilerGetSlot(task);
+
+    return (slot >= 0) && schedPolicySetTickets((uint32_t)slot, tickets);
+#else
+    (void)task;
+    (void)tickets;
+    return false;
+#endif
+}
+
+/*
+ * Description : Sets the weight of a task and re-arms its quantum at its
+ *               current level with it.
+ */
+bool schedulerSetTaskWeight(TaskHandle_t task, uint32_t weight)
+{
+#if (MLFQ_WEIGHTS_ENABLED == 1U) && (SCHED_POLICY == SCHED_POLICY_MLFQ)
+    int32_t slot = tickProfilerGetSlot(task);
+    TickProfilerTaskInfo_t *record = (slot >= 0) ? tickProfilerGetRecord((uint32_t)slot) : NULL;
+
+    if ((record == NULL) || (weight == 0U) || (weight > MLFQ_WEIGHT_MAX))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    g_groupWeight[g_slotGroup[slot]] += weight - g_taskWeight[slot];
+    g_totalWeight += weight - g_taskWeight[slot];
+#endif
+    g_taskWeight[slot] = (uint8_t)weight;
+    taskEXIT_CRITICAL();
+
+    applyLevelQuantum((uint32_t)slot, (MLFQ_QueueLevel_t)record->level);
+
+    return true;
+#else
+    (void)task;
+    (void)weight;
+    return false;
+#endif
+}
+
+/*
+ * Description : Returns the weight of a task.
+ */
+uint32_t schedulerGetTaskWeight(TaskHandle_t task)
+{
+    int32_t slot = tickProfilerGetSlot(task);
+
+    if (slot < 0)
+    {
+        return 0U;
+    }
+
+#if (MLFQ_WEIGHTS_ENABLED == 1U)
+    return g_taskWeight[slot];
+#else
+    return MLFQ_WEIGHT_DEFAULT;
+#endif
+}
+
+/*
+ * Description : Takes the next free group entry. The shares of the
+ *               created groups come out of the default group's.
+ */
+int32_t schedulerCreateGroup(const char *name, uint32_t sharePercent)
+{
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    int32_t group = -1;
+
+    if ((name == NULL) || (sharePercent == 0U))
+    {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if (sharePercent <= g_groups[MLFQ_GROUP_DEFAULT].share_percent)
+        {
+            for (uint32_t i = MLFQ_GROUP_DEFAULT + 1U; i < MLFQ_MAX_GROUPS; i++)
+            {
+                if (g_groups[i].name == NULL)
+                {
+                    g_groups[i].name          = name;
+                    g_groups[i].share_percent = sharePercent;
+                    g_groups[i].tasks         = 0U;
+                    g_groups[MLFQ_GROUP_DEFAULT].share_percent -= sharePercent;
+                    group = (int32_t)i;
+                    break;
+                }
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return group;
+#else
+    (void)name;
+    (void)sharePercent;
+    return -1;
+#endif
+}
+
+/*
+ * Description : Moves a task between groups. The new Low quantum applies
+ *               from the task's next quantum, as it does for every
+ *               member of both groups.
+ */
+bool schedulerSetTaskGroup(TaskHandle_t task, uint32_t group)
+{
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    int32_t slot = tickProfilerGetSlot(task);
+
+    if ((slot < 0) || (group >= MLFQ_MAX_GROUPS) || (g_groups[group].name == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        uint32_t old = g_slotGroup[slot];
+
+        g_groups[old].tasks--;
+        g_groupWeight[old] -= g_taskWeight[slot];
+        g_groups[group].tasks++;
+        g_groupWeight[group] += g_taskWeight[slot];
+        g_slotGroup[slot] = (uint8_t)group;
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+#else
+    (void)task;
+    (void)group;
+    return false;
+#endif
+}
+
+/*
+ * Description : Returns the group of a slot; the default group when
+ *               groups are not built in.
+ */
+uint32_t schedulerGetSlotGroup(uint32_t slot)
+{
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    return (slot < TICK_PROFILER_MAX_TASKS) ? g_slotGroup[slot] : MLFQ_GROUP_DEFAULT;
+#else
+    (void)slot;
+    return MLFQ_GROUP_DEFAULT;
+#endif
+}
+
+/*
+ * Description : Copies a group entry.
+ */
+bool schedulerGetGroupInfo(uint32_t group, MLFQ_GroupInfo_t *output)
+{
+#if (MLFQ_GROUPS_ENABLED == 1U)
+    if ((output == NULL) || (group >= MLFQ_MAX_GROUPS))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *output = g_groups[group];
+    taskEXIT_CRITICAL();
+
+    return true;
+#else
+    (void)group;
+    (void)output;
+    return false;
+#endif
+}
+
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+/*
+ * Description : True if the priorities low..high meet the band of the
+ *               default partition or of a created one. Must be called
+ *               inside a critical section.
+ */
+static bool partitionBandTaken(uint32_t low, uint32_t high)
+{
+    if ((high >= (uint32_t)MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_NUM_LEVELS - 1U)) &&
+        (low <= (uint32_t)MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH)))
+    {
+        return true;
+    }
+
+    for (uint32_t i = MLFQ_PARTITION_DEFAULT + 1U; i < MLFQ_MAX_PARTITIONS; i++)
+    {
+        uint32_t top = g_partitions[i].top_priority;
+
+        if ((g_partitions[i].name != NULL) &&
+            (high >= (top + 1U - g_partitions[i].levels)) && (low <= top))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+#endif
+
+/*
+ * Description : Takes the next free partition entry. Its band joins the
+ *               priorities whose ready tasks count towards the ready
+ *               levels; its boost period starts now.
+ */
+int32_t schedulerCreatePartition(const char *name, uint32_t topPriority, uint32_t levels,
+                                 uint32_t quantumPercent, uint32_t boostPeriodMs)
+{
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    int32_t partition = -1;
+
+    if ((name == NULL) || (levels == 0U) || (levels > MLFQ_NUM_LEVELS) ||
+        (quantumPercent == 0U) || (topPriority > MLFQ_TOP_PRIORITY_NUMBER) ||
+        (topPriority < (levels + METRICS_LOGGER_PRIORITY)) ||
+        ((boostPeriodMs != 0U) && (boostPeriodMs < MLFQ_BOOST_PERIOD_MIN_MS)))
+    {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if (!partitionBandTaken(topPriority + 1U - levels, topPriority))
+        {
+            for (uint32_t i = MLFQ_PARTITION_DEFAULT + 1U; i < MLFQ_MAX_PARTITIONS; i++)
+            {
+                if (g_partitions[i].name == NULL)
+                {
+                    g_partitions[i].name            = name;
+                    g_partitions[i].top_priority    = topPriority;
+                    g_partitions[i].levels          = levels;
+                    g_partitions[i].quantum_percent = quantumPercent;
+                    g_partitions[i].boost_period_ms = boostPeriodMs;
+                    g_partitions[i].tasks           = 0U;
+                    g_partitions[i].boosts          = 0U;
+                    g_partitionBoostTick[i]         = xTaskGetTickCount();
+                    g_partitionsCreated++;
+
+#if (configUSE_PORT_OPTIMISED_TASK_SELECTION == 1)
+                    for (uint32_t level = 0U; level < levels; level++)
+                    {
+                        g_levelPriorityMask |= (1UL << (topPriority - level));
+                        g_levelOfPriority[topPriority - level] = (uint8_t)level;
+                    }
+#endif
+                    partition = (int32_t)i;
+                    break;
+                }
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return partition;
+#else
+    (void)name;
+    (void)topPriority;
+    (void)levels;
+    (void)quantumPercent;
+    (void)boostPeriodMs;
+    return -1;
+#endif
+}
+
+/*
+ * Description : Moves a task between partitions. It starts again at
+ *               High, with the new partition's priority and quantum.
+ */
+bool schedulerSetTaskPartition(TaskHandle_t task, uint32_t partition)
+{
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    int32_t slot = tickProfilerGetSlot(task);
+    TickProfilerTaskInfo_t *record = (slot < 0) ? NULL : tickProfilerGetRecord((uint32_t)slot);
+
+    if ((record == NULL) || (partition >= MLFQ_MAX_PARTITIONS) ||
+        (g_partitions[partition].name == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        g_partitions[g_slotPartition[slot]].tasks--;
+        g_partitions[partition].tasks++;
+        g_slotPartition[slot] = (uint8_t)partition;
+    }
+    taskEXIT_CRITICAL();
+
+    vTaskSuspendAll();
+    {
+        boostSlot((uint32_t)slot, record);
+    }
+    (void)xTaskResumeAll();
+
+    return true;
+#else
+    (void)task;
+    (void)partition;
+    return false;
+#endif
+}
+
+/*
+ * Description : Returns the partition of a slot; the default partition
+ *               when partitions are not built in.
+ */
+uint32_t schedulerGetSlotPartition(uint32_t slot)
+{
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    return (slot < TICK_PROFILER_MAX_TASKS) ? g_slotPartition[slot] : MLFQ_PARTITION_DEFAULT;
+#else
+    (void)slot;
+    return MLFQ_PARTITION_DEFAULT;
+#endif
+}
+
+/*
+ * Description : Copies a partition entry. The default partition's band,
+ *               levels, boost period and boosts are the live ones of the
+ *               level table, the level count, the tunables and the global
+ *               boost.
+ */
+bool schedulerGetPartitionInfo(uint32_t partition, MLFQ_PartitionInfo_t *output)
+{
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    if ((output == NULL) || (partition >= MLFQ_MAX_PARTITIONS))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *output = g_partitions[partition];
+    if (partition == MLFQ_PARTITION_DEFAULT)
+    {
+        output->top_priority    = MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_HIGH);
+        output->levels          = g_levelCount;
+        output->boost_period_ms = g_boostPeriodMs;
+        output->boosts          = g_boostStats.boost_count;
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+#else
+    (void)partition;
+    (void)output;
+    return false;
+#endif
+}
+
+/*
+ * Description : Copies the runqueue of a core: the busy share from the
+ *               last balance check and the tasks homed on it now.
+ */
+bool schedulerGetCoreStats(uint32_t core, MLFQ_CoreStats_t *output)
+{
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+    if ((output == NULL) || (core >= TICK_PROFILER_CORES))
+    {
+        return false;
+    }
+
+    MLFQ_CoreStats_t stats = { 0U };
+
+    stats.busy_permille = g_coreBusy[core];
+    stats.steals = g_coreSteals[core];
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if ((record != NULL) && (g_homeCore[slot] == core) &&
+            (record->level < MLFQ_NUM_LEVELS))
+        {
+            stats.tasks++;
+            stats.level_tasks[record->level]++;
+        }
+    }
+
+    *output = stats;
+    return true;
+#else
+    (void)core;
+    (void)output;
+    return false;
+#endif
+}
+
+/*
+ * Description : Returns the number of tasks moved between cores.
+ */
+uint32_t schedulerGetMigrationCount(void)
+{
+#if (MLFQ_CORE_BALANCE_ENABLED == 1U)
+    return g_migrations;
+#else
+    return 0U;
+#endif
+}
+
+/*
+ * Description : Sets the wake-to-run latency target of a task. The
+ *               floor is the deepest level whose response bound, the
+ *               sum of the quanta from High down to it, fits in the
+ *               target: a woken task waits only for tasks at its level
+ *               or above, and each of those levels gives the CPU away
+ *               after at most one quantum. A target tighter than the
+ *               High quantum keeps the task at High for good. Quanta
+ *               changed later from the console do not move the floor.
+ */
+bool schedulerSetLatencyTarget(TaskHandle_t task, uint32_t targetUs)
+{
+#if (SCHED_POLICY == SCHED_POLICY_MLFQ)
+    int32_t slot = tickProfilerGetSlot(task);
+
+    if ((slot < 0) || (targetUs > MLFQ_LATENCY_TARGET_MAX_US))
+    {
+        return false;
+    }
+
+    uint32_t floorLevel = (uint32_t)MLFQ_QUEUE_LOW;
+
+    if (targetUs != 0U)
+    {
+        uint32_t boundUs = 0U;
+
+        for (floorLevel = 0U; floorLevel < MLFQ_NUM_LEVELS; floorLevel++)
+        {
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+            boundUs += g_tunables.quantum_us[floorLevel];
+#else
+            boundUs += MLFQ_TICKS_TO_US(g_tunables.quantum_ticks[floorLevel]);
+#endif
+            if (boundUs > targetUs)
+            {
+                break;
+            }
+        }
+        floorLevel = (floorLevel > 0U) ? (floorLevel - 1U) : 0U;
+    }
+
+    g_levelFloor[slot] = (uint8_t)floorLevel;
+
+#if (LATENCY_STATS_ENABLED == 1U)
+    latencySetTarget((uint32_t)slot, TICK_PROFILER_US_TO_CYCLES(targetUs));
+#endif
+
+    /* The task enters at its floor: a tight target starts it at a high
+     * level, a loose one leaves the higher levels to tasks that need them */
+    if (targetUs != 0U)
+    {
+        setSlotLevel((uint32_t)slot, (MLFQ_QueueLevel_t)floorLevel);
+    }
+
+    return true;
+#else
+    (void)task;
+    (void)targetUs;
+    return false;
+#endif
+}
+
+/*
+ * Description : Hands the deadline of a task to the kernel, which orders
+ *               the High ready list by it (see vTaskMlfqSetDeadline).
+ *               A deadline shorter than one tick is rounded up to one.
+ */
+bool schedulerSetDeadline(TaskHandle_t task, uint32_t deadlineMs)
+{
+#if (configUSE_MLFQ_EDF == 1)
+    if (tickProfilerGetSlot(task) < 0)
+    {
+        return false;
+    }
+
+    TickType_t xDeadline = pdMS_TO_TICKS(deadlineMs);
+
+    if ((xDeadline == 0U) && (deadlineMs != 0U))
+    {
+        xDeadline = 1U;
+    }
+
+    vTaskMlfqSetDeadline(task, xDeadline);
+    return true;
+#else
+    (void)task;
+    (void)deadlineMs;
+    return false;
+#endif
+}
+
+/*
+ * Description : Sets or clears the bottom-half budget of a task. A new
+ *               bottom half starts its first activation at High on the
+ *               budget; a cleared one gets the quantum of its level back.
+ */
+bool schedulerSetBottomHalf(TaskHandle_t task, uint32_t budgetUs)
+{
+#if (MLFQ_BOTTOM_HALF_ENABLED == 1U) && (SCHED_POLICY == SCHED_POLICY_MLFQ)
+    int32_t slot = tickProfilerGetSlot(task);
+    TickProfilerTaskInfo_t *record = (slot >= 0) ? tickProfilerGetRecord((uint32_t)slot) : NULL;
+
+    if ((record == NULL) || (budgetUs > g_tunables.quantum_us[MLFQ_QUEUE_HIGH]))
+    {
+        return false;
+    }
+
+    vTaskSuspendAll();
+    {
+        g_bottomHalfBudgetUs[slot] = budgetUs;
+        g_bottomHalfStrikes[slot]  = 0U;
+
+        if (budgetUs != 0U)
+        {
+            setSlotLevel((uint32_t)slot, MLFQ_QUEUE_HIGH);
+        }
+        applyLevelQuantum((uint32_t)slot, (MLFQ_QueueLevel_t)record->level);
+    }
+    (void)xTaskResumeAll();
+
+    return true;
+#else
+    (void)task;
+    (void)budgetUs;
+    return false;
+#endif
+}
+
+/*
+ * Description : Closes an activation of the calling bottom half, then
+ *               waits for its notification. A bottom half found below
+ *               High was demoted by its budget: that is a strike. Below
+ *               MLFQ_BOTTOM_HALF_STRIKES strikes in a row it goes back to
+ *               High with a full budget; finishing at High clears them.
+ */
+uint32_t schedulerBottomHalfWait(TickType_t xTicksToWait)
+{
+#if (MLFQ_BOTTOM_HALF_ENABLED == 1U) && (SCHED_POLICY == SCHED_POLICY_MLFQ)
+    int32_t slot = tickProfilerGetSlot(xTaskGetCurrentTaskHandle());
+    TickProfilerTaskInfo_t *record = (slot >= 0) ? tickProfilerGetRecord((uint32_t)slot) : NULL;
+
+    if ((record != NULL) && (g_bottomHalfBudgetUs[slot] != 0U))
+    {
+        vTaskSuspendAll();
+        {
+            if (record->level == (uint8_t)MLFQ_QUEUE_HIGH)
+            {
+                g_bottomHalfStrikes[slot] = 0U;
+            }
+            else if (g_bottomHalfStrikes[slot] < MLFQ_BOTTOM_HALF_STRIKES)
+            {
+                g_bottomHalfStrikes[slot]++;
+            }
+
+            if (g_bottomHalfStrikes[slot] < MLFQ_BOTTOM_HALF_STRIKES)
+            {
+                /* Same level: only the runtime is reset, which refills */
+                setSlotLevel((uint32_t)slot, MLFQ_QUEUE_HIGH);
+            }
+        }
+        (void)xTaskResumeAll();
+    }
+#endif
+
+    return ulTaskNotifyTake(pdTRUE, xTicksToWait);
+}
+
+/*
+ * Description : Marks the burst over and yields in one critical section,
+ *               so the switch-out that reads the mark is the one the
+ *               yield asks for, not an interrupt preemption before it.
+ *               On Cortex-M the switch is taken on leaving the section.
+ */
+void schedulerYieldBurst(void)
+{
+#if (MLFQ_YIELD_BURST_HOOKED == 1U)
+    taskENTER_CRITICAL();
+    {
+        tickProfilerEndBurst();
+        taskYIELD();
+    }
+    taskEXIT_CRITICAL();
+#else
+    taskYIELD();
+#endif
+}
+
+#if (SCHED_POLICY != SCHED_POLICY_MLFQ)
+/*
+ * Description : Called from traceTASK_SWITCHED_OUT. Passes blocking
+ *               switch-outs of registered tasks to the policy.
+ */
+void schedPolicyTaskSwitchedOut(void *task, bool stillReady)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot >= 0) && !stillReady && (g_policy->on_block != NULL))
+    {
+        g_policy->on_block((uint32_t)slot);
+    }
+}
+#endif
+
+#if (MLFQ_WATCHDOG_ENABLED == 1U)
+/*
+ * Description : Starvation watchdog pass, every MLFQ_WATCHDOG_CHECK_MS. A
+ *               registered task has made progress when its CPU time
+ *               moved since the last pass or it is not ready (blocked or
+ *               suspended tasks are waiting, not starved). The watchdog
+ *               is fed while every task has made progress within
+ *               MLFQ_WATCHDOG_PROGRESS_MS; the longest-starved task is
+ *               logged once when feeding stops. Returns the ticks until
+ *               the next pass.
+ */
+static uint32_t serviceWatchdog(TickType_t xNow)
+{
+    const TickType_t xCheckPeriod = pdMS_TO_TICKS(MLFQ_WATCHDOG_CHECK_MS);
+    const TickType_t xBound = pdMS_TO_TICKS(MLFQ_WATCHDOG_PROGRESS_MS);
+
+    if ((xNow - g_lastWatchdogTick) < xCheckPeriod)
+    {
+        return (uint32_t)(xCheckPeriod - (xNow - g_lastWatchdogTick));
+    }
+    g_lastWatchdogTick = xNow;
+
+    uint32_t starvedSlot = TICK_PROFILER_MAX_TASKS;
+    TickType_t xLongest = 0U;
+
+    for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+    {
+        uint32_t slot = tickProfilerGetActiveSlot(i);
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+        if (record == NULL)
+        {
+            continue;
+        }
+
+        uint64_t total = tickProfilerGetTotalTime(slot);
+
+        if ((record->task != g_watchTask[slot]) || (total != g_watchTime[slot]) ||
+            (eTaskGetState(record->task) != eReady))
+        {
+            g_watchTask[slot]     = record->task;
+            g_watchTime[slot]     = total;
+            g_watchProgress[slot] = xNow;
+        }
+        else if ((xNow - g_watchProgress[slot]) >= xBound)
+        {
+            if ((xNow - g_watchProgress[slot]) > xLongest)
+            {
+                xLongest    = xNow - g_watchProgress[slot];
+                starvedSlot = slot;
+            }
+        }
+    }
+
+    if (starvedSlot == TICK_PROFILER_MAX_TASKS)
+    {
+        feedWatchdog();
+        g_watchdogStarved = false;
+    }
+    else if (!g_watchdogStarved)
+    {
+        g_watchdogStarved = true;
+        logWatchdog(METRICS_WATCHDOG_STARVED, starvedSlot,
+                    (uint32_t)xLongest * portTICK_PERIOD_MS);
+    }
+
+    return (uint32_t)xCheckPeriod;
+}
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+/*
+ * Description : True if a registered task above the Low level is ready
+ *               or running.
+ */
+static bool taskAboveLowReady(void)
+{
+    for (uint32_t level = 0U; level < (uint32_t)MLFQ_QUEUE_LOW; level++)
+    {
+        for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+        {
+            uint32_t members = tickProfilerGetLevelMask((uint8_t)level, word);
+
+            while (members != 0U)
+            {
+                uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(members);
+                members &= ~(1UL << bit);
+
+                eTaskState state = eTaskGetState(tickProfilerGetRecord((word * 32U) + bit)->task);
+                if ((state == eReady) || (state == eRunning))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Description : Supervisor clock pass. A slow core goes back to full
+ *               speed as soon as a task above Low is ready, registered
+ *               or not (the ready hook's request); a fast one goes slow
+ *               once none is, after the hold time. The decision to go
+ *               slow is taken with the kernel suspended and g_clockSlow
+ *               already set, so a task readied meanwhile, even from an
+ *               interrupt, asks for full speed back through the hook.
+ */
+static void scaleClock(TickType_t xNow)
+{
+    if (g_clockSlow)
+    {
+        taskENTER_CRITICAL();
+        bool wanted = g_clockRestoreWanted;
+        g_clockRestoreWanted = false;
+        taskEXIT_CRITICAL();
+
+        if (wanted || taskAboveLowReady())
+        {
+            (void)setClockSlow(false);
+            g_clockSlow = false;
+            g_clockStats.slow_ms += (uint32_t)(xNow - g_clockChangeTick) * portTICK_PERIOD_MS;
+            g_clockChangeTick = xNow;
+        }
+    }
+    else if ((xNow - g_clockChangeTick) >= pdMS_TO_TICKS(MLFQ_CLOCK_HOLD_MS))
+    {
+        vTaskSuspendAll();
+        {
+            g_clockSlow = true;
+            g_clockRestoreWanted = false;
+
+            if (taskAboveLowReady())
+            {
+                g_clockSlow = false;
+            }
+        }
+        (void)xTaskResumeAll();
+
+        if (g_clockSlow)
+        {
+            (void)setClockSlow(true);
+            g_clockStats.slowdowns++;
+            g_clockChangeTick = xNow;
+        }
+    }
+}
+
+/*
+ * Description : Called from traceMOVED_TASK_TO_READY_STATE, inside the
+ *               kernel. Only notes the request; the tick hook wakes the
+ *               supervisor, which changes the clock. The supervisor and
+ *               the Low tasks served at the reservation priority do not
+ *               count.
+ */
+void schedulerClockTaskReady(uint32_t priority)
+{
+    if (g_clockSlow &&
+        (priority > (uint32_t)MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_LOW)) &&
+#if (MLFQ_RESERVE_ENABLED == 1U)
+        (priority != (uint32_t)MLFQ_RESERVE_PRIORITY) &&
+#endif
+        (priority != (uint32_t)MLFQ_SUPERVISOR_PRIORITY))
+    {
+        g_clockRestoreWanted = true;
+    }
+}
+
+/*
+ * Description : Read by the tick hook on every tick.
+ */
+bool schedulerClockRestoreWanted(void)
+{
+    return g_clockRestoreWanted;
+}
+#endif
+
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+/*
+ * Description : Called from traceQUEUE_SEND, traceQUEUE_SEND_FROM_ISR
+ *               and traceEVENT_GROUP_SET_BITS, inside the kernel, on
+ *               every send, give and set of any object. Only notes the
+ *               fired bindings; the tick hook wakes the supervisor,
+ *               which changes the priorities. Costs one load while
+ *               nothing is bound.
+ */
+void schedulerEventBoostFired(const void *object, uint32_t bits)
+{
+    if (g_eventBindings == 0U)
+    {
+        return;
+    }
+
+    UBaseType_t uxSaved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        for (uint32_t i = 0U; i < MLFQ_EVENT_BOOST_MAX_BINDINGS; i++)
+        {
+            if ((g_eventObject[i] == object) &&
+                ((g_eventBits[i] == 0U) || ((g_eventBits[i] & bits) != 0U)))
+            {
+                g_eventBoostPending |= (1UL << i);
+            }
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSaved);
+}
+
+/*
+ * Description : Read by the tick hook on every tick.
+ */
+bool schedulerEventBoostPending(void)
+{
+    return (g_eventBoostPending != 0U);
+}
+
+/*
+ * Description : Supervisor event boost pass, in the expiry batch. Moves
+ *               the tasks of every binding fired since the last pass that
+ *               are below High back to High, with a fresh quantum. A task
+ *               readied by the event has run at its old level for at most
+ *               the tick it took to get here.
+ */
+static void serveEventBoosts(void)
+{
+    taskENTER_CRITICAL();
+    uint32_t fired = g_eventBoostPending;
+    g_eventBoostPending = 0U;
+    taskEXIT_CRITICAL();
+
+    uint32_t slots[TICK_PROFILER_SLOT_MASK_WORDS] = { 0U };
+
+    while (fired != 0U)
+    {
+        uint32_t binding = 31U - (uint32_t)TICK_PROFILER_CLZ(fired);
+        fired &= ~(1UL << binding);
+
+        for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+        {
+            slots[word] |= g_eventSlots[binding][word];
+        }
+    }
+
+    for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+    {
+        while (slots[word] != 0U)
+        {
+            uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(slots[word]);
+            slots[word] &= ~(1UL << bit);
+
+            uint32_t slot = (word * 32U) + bit;
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+            if ((record != NULL) && (record->level != (uint8_t)MLFQ_QUEUE_HIGH) &&
+                (record->level < MLFQ_NUM_LEVELS))
+            {
+                setSlotLevel(slot, MLFQ_QUEUE_HIGH);
+                g_eventBoosts++;
+            }
+        }
+    }
+}
+#endif
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+/*
+ * Description : Read by the tick hook on every tick.
+ */
+bool schedulerLevelCallbackPending(void)
+{
+    for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+    {
+        if (g_levelCallbackPending[word] != 0U)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Description : Supervisor pass, with the kernel running. Calls the
+ *               callback of every slot whose level changed since the
+ *               last pass, from the level it had before the first change
+ *               to the level it has now; a slot back where it started is
+ *               skipped.
+ */
+static void serveLevelCallbacks(void)
+{
+    for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+    {
+        taskENTER_CRITICAL();
+        uint32_t changed = g_levelCallbackPending[word];
+        g_levelCallbackPending[word] = 0U;
+        taskEXIT_CRITICAL();
+
+        while (changed != 0U)
+        {
+            uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(changed);
+            changed &= ~(1UL << bit);
+
+            uint32_t slot = (word * 32U) + bit;
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+            MLFQ_LevelCallback_t callback;
+            void *context;
+
+            taskENTER_CRITICAL();
+            callback = g_levelCallback[slot];
+            context = g_levelCallbackContext[slot];
+            taskEXIT_CRITICAL();
+
+            if ((record != NULL) && (callback != NULL) &&
+                (record->level != g_levelCallbackFrom[slot]))
+            {
+                callback(record->task, (MLFQ_QueueLevel_t)g_levelCallbackFrom[slot],
+                         (MLFQ_QueueLevel_t)record->level, context);
+            }
+        }
+    }
+}
+#endif
+
+/*
+ * Description : Adds a task to the binding of an object and bits, taking
+ *               a free entry for a new one.
+ */
+bool schedulerBindEventBoost(const void *object, uint32_t bits, TaskHandle_t task)
+{
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+    int32_t slot = tickProfilerGetSlot(task);
+    bool bound = false;
+
+    if ((object == NULL) || (slot < 0))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        int32_t binding = -1;
+
+        for (uint32_t i = 0U; i < MLFQ_EVENT_BOOST_MAX_BINDINGS; i++)
+        {
+            if ((g_eventObject[i] == object) && (g_eventBits[i] == bits))
+            {
+                binding = (int32_t)i;
+                break;
+            }
+            if ((binding < 0) && (g_eventObject[i] == NULL))
+            {
+                binding = (int32_t)i;
+            }
+        }
+
+        if (binding >= 0)
+        {
+            if (g_eventObject[binding] == NULL)
+            {
+                g_eventObject[binding] = object;
+                g_eventBits[binding]   = bits;
+                g_eventBindings++;
+            }
+            g_eventSlots[binding][(uint32_t)slot / 32U] |= (1UL << ((uint32_t)slot % 32U));
+            bound = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return bound;
+#else
+    (void)object;
+    (void)bits;
+    (void)task;
+    return false;
+#endif
+}
+
+/*
+ * Description : Frees every binding of an object, and drops any of them
+ *               still pending.
+ */
+void schedulerUnbindEventBoost(const void *object)
+{
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+    taskENTER_CRITICAL();
+    {
+        for (uint32_t i = 0U; i < MLFQ_EVENT_BOOST_MAX_BINDINGS; i++)
+        {
+            if ((object != NULL) && (g_eventObject[i] == object))
+            {
+                g_eventObject[i] = NULL;
+                g_eventBits[i]   = 0U;
+                for (uint32_t word = 0U; word < TICK_PROFILER_SLOT_MASK_WORDS; word++)
+                {
+                    g_eventSlots[i][word] = 0U;
+                }
+                g_eventBoostPending &= ~(1UL << i);
+                g_eventBindings--;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+#else
+    (void)object;
+#endif
+}
+
+/*
+ * Description : Supervisor start-up, once the kernel runs: registers the
+ *               task the passes run in and starts the watchdog.
+ */
+static void supervisorStart(TaskHandle_t supervisor)
+{
+    /* Register scheduler task with profiler */
+    tickProfilerSetSchedulerTaskHandle(supervisor);
+    g_supervisorHandle = supervisor;
+
+#if (MLFQ_WATCHDOG_ENABLED == 1U)
+    /* Report why the last boot ended before the watchdog starts */
+    if (takeWatchdogReset())
+    {
+        logWatchdog(METRICS_WATCHDOG_RESET, TICK_PROFILER_MAX_TASKS, 0U);
+    }
+    g_lastWatchdogTick = xTaskGetTickCount();
+    initWatchdog(MLFQ_WATCHDOG_TIMEOUT_MS);
+#endif
+
+    /* Reporting runs on the boost period, whatever the policy */
+    g_lastReportTick = xTaskGetTickCount();
+    g_reportPeriod = pdMS_TO_TICKS(g_tunables.boost_period_ms);
+
+    /* The first pass asks the policy when it next wants to run */
+    g_timeToPolicy = 0U;
+}
+
+#if (MLFQ_REPORT_ON_DEMAND_ENABLED == 1U)
+/*
+ * Description : True while someone reads the periodic reports: reporting
+ *               is on, a host lease runs, or the flight recorder keeps the
+ *               snapshots. Supervisor only.
+ */
+static bool reportReaderPresent(TickType_t xNow)
+{
+    bool leased;
+
+    taskENTER_CRITICAL();
+    {
+        leased = ((TickType_t)(xNow - g_reportLeaseStart) < g_reportLeaseTicks);
+    }
+    taskEXIT_CRITICAL();
+
+    return g_tunables.reporting_enabled || leased || (FLIGHT_RECORDER_ENABLED == 1U);
+}
+#endif
+
+/*
+ * Description : One supervisor pass. Hands quantum expiries and periodic
+ *               passes to the scheduling policy and produces the periodic
+ *               reports. Returns the time until the policy's next periodic
+ *               pass, the next report or the next watchdog pass, whichever
+ *               comes first.
+ */
+static TickType_t supervisorPass(void)
+{
+    g_supervisorPasses++;
+
+    /* 1. Console changes are applied here, between scheduling passes */
+    if (g_tunablesPending)
+    {
+        applyPendingTunables();
+        g_reportPeriod = pdMS_TO_TICKS(g_tunables.boost_period_ms);
+    }
+    if (g_pendingLevelCount != 0U)
+    {
+        applyPendingLevelCount();
+    }
+
+    /* 2. Hand quantum expiries to the policy. The kernel is
+     *    suspended over the whole batch, so the priority changes of
+     *    one wake cost a single reschedule when it resumes */
+    vTaskSuspendAll();
+#if (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U)
+    for (uint32_t word = 0U; word < TICK_PROFILER_EXPIRED_MASK_WORDS; word++)
+    {
+        uint32_t expired = tickProfilerTakeExpiredMask(word);
+
+        /* Visit only the set bits, highest slot first */
+        while (expired != 0U)
+        {
+            uint32_t bit = 31U - (uint32_t)TICK_PROFILER_CLZ(expired);
+            expired &= ~(1UL << bit);
+
+            handleExpiry((word * 32U) + bit);
+        }
+    }
+#else
+    /* Retrieve expired-quantum notification queue */
+    QueueHandle_t expiredQueue = tickProfilerGetExpiredQueue();
+    TaskHandle_t xExpiredHandle = NULL;
+
+    while (xQueueReceive(expiredQueue, &xExpiredHandle, 0) == pdTRUE)
+    {
+        int32_t slot = tickProfilerGetSlot(xExpiredHandle);
+
+        if (slot >= 0)
+        {
+            handleExpiry((uint32_t)slot);
+        }
+    }
+#endif
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+    /* Tasks bound to an event fired since the last pass go back to
+     * High in the same batch */
+    serveEventBoosts();
+#endif
+    (void)xTaskResumeAll();
+
+    TickType_t xNow = xTaskGetTickCount();
+
+    /* 3. Periodic and requested reports, taken before the policy's
+     *    periodic pass so they show the levels a boost is about to reset.
+     *    On demand, the periodic ones only while someone reads them */
+#if (MLFQ_REPORT_ON_DEMAND_ENABLED == 1U)
+    g_reportReader = reportReaderPresent(xNow);
+    bool periodic = g_reportReader;
+#else
+    bool periodic = g_tunables.reporting_enabled;
+#endif
+
+    if ((xNow - g_lastReportTick) >= g_reportPeriod)
+    {
+        if (periodic || g_reportRequested)
+        {
+            g_reportRequested = false;
+            printQueueReport();
+        }
+#if (MLFQ_REPORT_ON_DEMAND_ENABLED == 1U)
+        /* With no reader the report stays due, for the next one to get
+         * at once */
+        if (g_reportReader)
+        {
+            g_lastReportTick = xNow;
+        }
+#else
+        g_lastReportTick = xNow;
+#endif
+    }
+    else if (g_reportRequested)
+    {
+        g_reportRequested = false;
+        printQueueReport();
+    }
+
+    /* 4. Policy periodic work (MLFQ: policy scan and global boost).
+     *    Called on every pass; the policy runs what is due and says
+     *    how long it can sleep */
+    g_timeToPolicy = (TickType_t)g_policy->on_periodic((uint32_t)xNow);
+
+#if (MLFQ_WATCHDOG_ENABLED == 1U)
+    /* 5. Feed the watchdog while no registered task is starved */
+    TickType_t xToWatchdog = (TickType_t)serviceWatchdog(xNow);
+    if (xToWatchdog < g_timeToPolicy)
+    {
+        g_timeToPolicy = xToWatchdog;
+    }
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+    /* 6. Core speed from the levels the pass leaves ready */
+    scaleClock(xTaskGetTickCount());
+#endif
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+    /* 7. Tell the tasks that asked about their level changes */
+    serveLevelCallbacks();
+#endif
+
+    /* Label tasks registered since the last pass */
+    flushPendingNames();
+
+    /* Sleep until a quantum expires, the policy's next pass or the
+     * next report, whichever comes first */
+    TickType_t xElapsed = xTaskGetTickCount() - g_lastReportTick;
+    TickType_t xTimeout = (xElapsed >= g_reportPeriod) ?
+                          0U : (g_reportPeriod - xElapsed);
+#if (MLFQ_REPORT_ON_DEMAND_ENABLED == 1U)
+    /* With no reader the next report is no reason to wake; a console
+     * change or a new lease wakes the supervisor */
+    if (!g_reportReader)
+    {
+        xTimeout = portMAX_DELAY;
+    }
+#endif
+    if (g_timeToPolicy < xTimeout)
+    {
+        xTimeout = g_timeToPolicy;
+    }
+
+    return xTimeout;
+}
+
+/*
+ * Description : Dedicated scheduler task.
+ *               Runs the supervisor passes. Blocks on its task
+ *               notification (given by the tick hook on quantum expiry)
+ *               with the timeout the last pass returned, so it never
+ *               polls.
+ */
+void schedulerTask(void *pvParameters)
+{
+    (void)pvParameters;
+
+    supervisorStart(xTaskGetCurrentTaskHandle());
+
+    /* Label the tasks registered before the kernel started */
+    flushPendingNames();
+
+    /* The first pass asks the policy when it next wants to run */
+    TickType_t xTimeout = 0U;
+
+    for (;;)
+    {
+        GPIO_PROBE_LOW(GPIO_PROBE_PIN_SUPERVISOR);
+        (void)ulTaskNotifyTake(pdTRUE, xTimeout);
+        GPIO_PROBE_HIGH(GPIO_PROBE_PIN_SUPERVISOR);
+
+        xTimeout = supervisorPass();
+    }
+}
+
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+/*
+ * Description : Runs a pass in the timer service task and re-arms the
+ *               supervisor timer with the timeout it returns. The timer
+ *               auto-reloads, so the periodic work carries on at the last
+ *               period should the timer command queue be full.
+ */
+static void timerSupervisorPass(void)
+{
+    GPIO_PROBE_HIGH(GPIO_PROBE_PIN_SUPERVISOR);
+
+    if (g_supervisorHandle == NULL)
+    {
+        supervisorStart(xTimerGetTimerDaemonTaskHandle());
+    }
+
+    g_passPending = false;
+    TickType_t xTimeout = supervisorPass();
+
+    (void)xTimerChangePeriod(g_supervisorTimer, (xTimeout > 0U) ? xTimeout : 1U, 0U);
+
+    GPIO_PROBE_LOW(GPIO_PROBE_PIN_SUPERVISOR);
+}
+
+/*
+ * Description : Supervisor timer callback: the policy's next pass, the
+ *               next report or the next watchdog pass is due.
+ */
+static void supervisorTimerCallback(TimerHandle_t xTimer)
+{
+    (void)xTimer;
+    timerSupervisorPass();
+}
+
+/*
+ * Description : Function deferred to the timer service task by
+ *               schedulerWakeFromISR() and wakeSupervisor().
+ */
+static void supervisorDeferredPass(void *pvParameter1, uint32_t ulParameter2)
+{
+    (void)pvParameter1;
+    (void)ulParameter2;
+    timerSupervisorPass();
+}
+#endif
+
+/*
+ * Description : Creates the supervisor timer. Its first expiry, one tick
+ *               after the kernel starts, runs the start-up and the first
+ *               pass in the timer service task.
+ */
+bool schedulerStartTimerSupervisor(void)
+{
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    static StaticTimer_t timerBuffer;
+
+    g_supervisorTimer = xTimerCreateStatic("Supervisor", 1U, pdTRUE, NULL,
+                                           supervisorTimerCallback, &timerBuffer);
+#else
+    g_supervisorTimer = xTimerCreate("Supervisor", 1U, pdTRUE, NULL,
+                                     supervisorTimerCallback);
+#endif
+
+    return (g_supervisorTimer != NULL) &&
+           (xTimerStart(g_supervisorTimer, 0U) == pdPASS);
+#else
+    return false;
+#endif
+}
+
+/*
+ * Description : Wakes the supervisor from an interrupt: a notification to
+ *               the supervisor task, or a pass deferred to the timer
+ *               service task. A pass already pending is not queued again.
+ */
+void schedulerWakeFromISR(BaseType_t *pxHigherPriorityTaskWoken)
+{
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+    if ((g_supervisorTimer != NULL) && !g_passPending)
+    {
+        g_passPending = true;
+        if (xTimerPendFunctionCallFromISR(supervisorDeferredPass, NULL, 0U,
+                                          pxHigherPriorityTaskWoken) != pdPASS)
+        {
+            /* Queue full: the next expiry retries */
+            g_passPending = false;
+        }
+    }
+#else
+    if (g_supervisorHandle != NULL)
+    {
+        vTaskNotifyGiveFromISR(g_supervisorHandle, pxHigherPriorityTaskWoken);
+    }
+#endif
+}
+
+/*
+ * Description : Level of the task an interrupt preempted, read from its
+ *               record without a lookup or a lock. A level change the
+ *               supervisor is making at that moment shows either way.
+ */
+MLFQ_QueueLevel_t schedulerGetCurrentLevelFromISR(void)
+{
+    const TickProfilerTaskInfo_t *record = tickProfilerGetCurrentRecord();
+
+    if ((record == NULL) || (record->level >= MLFQ_NUM_LEVELS))
+    {
+        return MLFQ_NUMBER_QUEUES;
+    }
+
+    return (MLFQ_QueueLevel_t)record->level;
+}
+
+/*
+ * Description : Quantum left to the task an interrupt preempted, in
+ *               microseconds, rounded down.
+ */
+uint32_t schedulerGetRemainingBudgetFromISR(void)
+{
+    uint32_t cycles = tickProfilerGetRemainingCycles();
+
+    if (cycles == UINT32_MAX)
+    {
+        return UINT32_MAX;
+    }
+
+    return cycles / (uint32_t)(configCPU_CLOCK_HZ / 1000000U);
+}
+
+#if (configUSE_MLFQ_NATIVE == 1)
+/*
+ * Description : Kernel-native demotion, called by xTaskIncrementTick
+ *               once a managed task has used its quantum. Runs in the
+ *               tick interrupt with the kernel lists locked, so the slot
+ *               record is updated in place and the change is neither
+ *               logged nor shown on the LEDs; the next report has it.
+ */
+BaseType_t xApplicationMlfqQuantumExpired(TaskHandle_t xTask,
+                                          UBaseType_t *puxLevel,
+                                          UBaseType_t *puxPriority,
+                                          UBaseType_t *puxQuantumTicks)
+{
+    int32_t slot = tickProfilerGetSlot(xTask);
+
+    if (slot < 0)
+    {
+        /* Unregistered behind the kernel's back: release it */
+        *puxQuantumTicks = 0U;
+        return pdFALSE;
+    }
+
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord((uint32_t)slot);
+    uint32_t oldLevel = *puxLevel;
+    uint32_t newLevel = (oldLevel < (uint32_t)g_levelFloor[slot]) ? (oldLevel + 1U) : oldLevel;
+
+    newLevel = (uint32_t)partitionLevel((uint32_t)slot, (MLFQ_QueueLevel_t)newLevel);
+
+    uint32_t quantum = partitionQuantum((uint32_t)slot, g_tunables.quantum_ticks[newLevel]);
+
+#if (EVENT_TRACE_ENABLED == 1U)
+    eventTraceRecord(EVENT_TRACE_QUANTUM_EXPIRY, (void *)xTask, (uint8_t)oldLevel, 0U);
+    if (newLevel != oldLevel)
+    {
+        eventTraceRecord(EVENT_TRACE_DEMOTION, (void *)xTask,
+                         (uint8_t)oldLevel, (uint8_t)newLevel);
+    }
+#endif
+
+    if (newLevel != oldLevel)
+    {
+        GPIO_PROBE_PULSE(GPIO_PROBE_PIN_DEMOTION);
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+        markLevelChange((uint32_t)slot, (MLFQ_QueueLevel_t)oldLevel);
+#endif
+#if (MLFQ_WARM_START_ENABLED == 1U)
+        warmNoteLevel((uint32_t)slot, (MLFQ_QueueLevel_t)newLevel);
+#endif
+    }
+
+    tickProfilerSetLevel((uint32_t)slot, (uint8_t)newLevel);
+    tickProfilerWriteBegin();
+    record->quantum_ticks = (TickProfilerTicks_t)quantum;
+    record->run_ticks     = 0U;
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    record->quantum_cycles = record->quantum_ticks * TICK_PROFILER_CYCLES_PER_TICK;
+    record->run_cycles     = 0U;
+#endif
+    tickProfilerWriteEnd();
+
+    *puxLevel        = (UBaseType_t)newLevel;
+#if (MLFQ_PARTITIONS_ENABLED == 1U)
+    *puxPriority     = (g_slotPartition[slot] != MLFQ_PARTITION_DEFAULT) ?
+                       slotLevelPriority((uint32_t)slot, (MLFQ_QueueLevel_t)newLevel) :
+                       MLFQ_TO_RTOS_LEVEL_SETTER((MLFQ_QueueLevel_t)newLevel);
+#else
+    *puxPriority     = MLFQ_TO_RTOS_LEVEL_SETTER((MLFQ_QueueLevel_t)newLevel);
+#endif
+    *puxQuantumTicks = (UBaseType_t)quantum;
+
+    return pdTRUE;
+}
+#endif
+
+/*
+ * Description : Retrieves MLFQ and runtime profiling information
+ *               for a task indexed by its slot in the shared table.
+ */
+bool schedulerGetTaskStats(uint32_t index, MLFQ_Task_Profiler_t *output)
+{
+    TickProfilerTaskInfo_t *record;
+    uint32_t sequence;
+
+    do
+    {
+        sequence = tickProfilerReadBegin();
+        record = tickProfilerGetRecord(index);
+
+        if (record != NULL)
+        {
+            /* Copy scheduler metadata */
+            output->task_info.task  = record->task;
+            output->task_level      = (MLFQ_QueueLevel_t)record->level;
+            output->arrival_tick    = record->arrival_tick;
+
+            /* Copy live profiler statistics */
+            output->task_info.run_ticks     = record->run_ticks;
+            output->task_info.quantum_ticks = record->quantum_ticks;
+        }
+    } while (tickProfilerReadRetry(sequence));
+
+    return (record != NULL);
+}
+
+/*
+ * Description : Copies the stats of every registered task as one
+ *               consistent view, retrying while the tick hook or the
+ *               supervisor changes the table. The read side never
+ *               masks interrupts.
+ */
+void schedulerGetStatsSnapshot(MLFQ_StatsSnapshot_t *output)
+{
+    uint32_t sequence;
+
+    if (output == NULL)
+    {
+        return;
+    }
+
+    do
+    {
+        sequence = tickProfilerReadBegin();
+        output->timestamp = xTaskGetTickCount();
+        output->count = 0U;
+
+        for (uint32_t i = 0U; i < tickProfilerGetActiveCount(); i++)
+        {
+            uint32_t slot = tickProfilerGetActiveSlot(i);
+            TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+            MLFQ_Task_Profiler_t *entry = &output->task[output->count];
+
+            if (record == NULL)
+            {
+                continue;
+            }
+
+            entry->task_info.task          = record->task;
+            entry->task_info.run_ticks     = record->run_ticks;
+            entry->task_info.quantum_ticks = record->quantum_ticks;
+            entry->task_level              = (MLFQ_QueueLevel_t)record->level;
+            entry->arrival_tick            = record->arrival_tick;
+            output->slot[output->count]    = (uint8_t)slot;
+            output->count++;
+        }
+    } while (tickProfilerReadRetry(sequence));
+}
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/*
+ * Description : Kernel callback supplying the idle task's TCB and stack
+ *               in a static allocation build. Defined here rather than in
+ *               main.c so the test and benchmark runners link it too.
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+                                   StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idleTcb;
+    static StackType_t idleStack[configMINIMAL_STACK_SIZE];
+
+    *ppxIdleTaskTCBBuffer   = &idleTcb;
+    *ppxIdleTaskStackBuffer = idleStack;
+    *pulIdleTaskStackSize   = configMINIMAL_STACK_SIZE;
+}
+
+#if (configUSE_TIMERS == 1)
+/*
+ * Description : Same for the timer service task.
+ */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+                                    StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    static StaticTask_t timerTcb;
+    static StackType_t timerStack[configTIMER_TASK_STACK_DEPTH];
+
+    *ppxTimerTaskTCBBuffer   = &timerTcb;
+    *ppxTimerTaskStackBuffer = timerStack;
+    *pulTimerTaskStackSize   = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+#endif
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *  MODULE NAME  : Stack Statistics
+ *  FILE         : stack_stats.c
+ *  DESCRIPTION  : Keeps the creation depth of every task in a dense table
+ *                 filled by the kernel create and delete hooks, and turns
+ *                 uxTaskGetStackHighWaterMark() into a suggested depth.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "stack_stats.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <string.h>
+
+#if (STACK_STATS_ENABLED == 1U)
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Dense table, changed by the create and delete hooks inside kernel
+ * critical sections */
+static void *g_stackTask[STACK_STATS_MAX_TASKS];
+static uint32_t g_stackDepth[STACK_STATS_MAX_TASKS];
+static uint32_t g_stackCount = 0U;
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from traceTASK_CREATE. Tasks beyond the table size
+ *               are not reported.
+ */
+void stackStatsTaskCreated(void *task, uint32_t depthWords)
+{
+    if (g_stackCount < STACK_STATS_MAX_TASKS)
+    {
+        g_stackTask[g_stackCount]  = task;
+        g_stackDepth[g_stackCount] = depthWords;
+        g_stackCount++;
+    }
+}
+
+/*
+ * Description : Called from traceTASK_DELETE. The last entry takes the
+ *               place of the deleted one.
+ */
+void stackStatsTaskDeleted(void *task)
+{
+    for (uint32_t i = 0U; i < g_stackCount; i++)
+    {
+        if (g_stackTask[i] == task)
+        {
+            g_stackCount--;
+            g_stackTask[i]  = g_stackTask[g_stackCount];
+            g_stackDepth[i] = g_stackDepth[g_stackCount];
+            return;
+        }
+    }
+}
+
+/*
+ * Description : Returns the number of tracked tasks.
+ */
+uint32_t stackStatsGetCount(void)
+{
+    return g_stackCount;
+}
+
+/*
+ * Description : Samples one task. The scheduler stays suspended across
+ *               the lookup, the stack walk and the name copy, so the idle
+ *               task cannot free a deleted task underneath it.
+ */
+bool stackStatsSample(uint32_t index, StackStats_t *output)
+{
+    bool found = false;
+
+    vTaskSuspendAll();
+    if ((output != NULL) && (index < g_stackCount))
+    {
+        uint32_t used;
+        uint32_t suggested;
+
+        output->task           = g_stackTask[index];
+        output->size_words     = g_stackDepth[index];
+        output->min_free_words = (uint32_t)uxTaskGetStackHighWaterMark((TaskHandle_t)output->task);
+        strncpy(output->name, pcTaskGetName((TaskHandle_t)output->task), STACK_STATS_NAME_LENGTH - 1U);
+        output->name[STACK_STATS_NAME_LENGTH - 1U] = '\0';
+
+        used = (output->min_free_words < output->size_words) ?
+               (output->size_words - output->min_free_words) : 0U;
+        suggested = used + ((used * STACK_STATS_MARGIN_PERCENT) + 99U) / 100U;
+        suggested = ((suggested + STACK_STATS_ROUND_WORDS - 1U) / STACK_STATS_ROUND_WORDS) *
+                    STACK_STATS_ROUND_WORDS;
+        output->suggested_words = (suggested > configMINIMAL_STACK_SIZE) ?
+                                  suggested : configMINIMAL_STACK_SIZE;
+        found = true;
+    }
+    (void)xTaskResumeAll();
+
+    return found;
+}
+
+#endif /* STACK_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *  MODULE NAME  : Task State Time
+ *  FILE         : state_time.c
+ *  DESCRIPTION  : Keeps, per profiler slot, the state the task is in,
+ *                 when it entered it, and the cycles spent in each state.
+ *                 Every transition charges the state being left.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "state_time.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if (STATE_TIME_ENABLED == 1U)
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Totals and current state per profiler slot */
+static StateTimeSummary_t g_states[TICK_PROFILER_MAX_TASKS];
+
+/* Cycle stamp of the last transition (or read) per profiler slot */
+static uint32_t g_since[TICK_PROFILER_MAX_TASKS];
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Charges the state being left up to now and enters the
+ *               new one. Called from the kernel hooks, which run with
+ *               interrupts masked or from the PendSV handler.
+ */
+static void enterState(uint32_t slot, uint8_t state)
+{
+    uint32_t now = cycleCounterGet();
+
+    g_states[slot].cycles[g_states[slot].state] += (uint32_t)(now - g_since[slot]);
+    g_states[slot].state = state;
+    g_since[slot] = now;
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from traceTASK_SWITCHED_IN.
+ */
+void stateTimeSwitchedIn(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot >= 0)
+    {
+        enterState((uint32_t)slot, STATE_TIME_RUNNING);
+    }
+}
+
+/*
+ * Description : Called from traceTASK_SWITCHED_OUT. A task still in a
+ *               ready list was preempted or yielded; any other has
+ *               blocked, delayed or suspended itself.
+ */
+void stateTimeSwitchedOut(void *task, bool stillReady)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot >= 0)
+    {
+        enterState((uint32_t)slot, stillReady ? STATE_TIME_READY : STATE_TIME_BLOCKED);
+    }
+}
+
+/*
+ * Description : Called from traceMOVED_TASK_TO_READY_STATE. Priority
+ *               changes also move running and ready tasks between ready
+ *               lists; only a blocked task changes state here.
+ */
+void stateTimeTaskReady(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot >= 0) && (g_states[slot].state == STATE_TIME_BLOCKED))
+    {
+        enterState((uint32_t)slot, STATE_TIME_READY);
+    }
+}
+
+/*
+ * Description : Folds the time in the current state into the totals
+ *               before copying them. The stamp is 32 bits, so a task
+ *               that stays in one state longer than the cycle counter
+ *               takes to wrap is only counted right if its slot is read
+ *               at least once per wrap; the metrics report does.
+ */
+bool stateTimeGetTask(uint32_t slot, StateTimeSummary_t *output)
+{
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (output == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        enterState(slot, g_states[slot].state);
+        *output = g_states[slot];
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+/*
+ * Description : Called when a task takes the slot. A task registered
+ *               from its creation hook is not in any list yet, which
+ *               the kernel reports as deleted; it is about to be made
+ *               ready.
+ */
+void stateTimeResetTask(uint32_t slot, void *task)
+{
+    uint8_t state;
+
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    switch (eTaskGetState((TaskHandle_t)task))
+    {
+        case eRunning:
+            state = STATE_TIME_RUNNING;
+            break;
+
+        case eBlocked:
+        case eSuspended:
+            state = STATE_TIME_BLOCKED;
+            break;
+
+        default:
+            state = STATE_TIME_READY;
+            break;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        memset(&g_states[slot], 0, sizeof(g_states[slot]));
+        g_states[slot].state = state;
+        g_since[slot] = cycleCounterGet();
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* STATE_TIME_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,208 @@
+/******************************************************************************
+ *  MODULE NAME  : Task Pool
+ *  FILE         : task_pool.c
+ *  DESCRIPTION  : Statically reserved TCB and stack blocks kept on one
+ *                 free list per size class, so spawning and tearing down a
+ *                 worker never walks or fragments the heap.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "task_pool.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (TASK_POOL_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* End of a free list */
+#define TASK_POOL_NONE           0xFFU
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : One size class: its storage, the free list threaded
+ *               through 'next' by block index, and its counters.
+ */
+typedef struct
+{
+    StaticTask_t    *tcbs;
+    StackType_t     *stacks;
+    uint8_t         *next;
+    uint8_t          head;
+    TaskPoolStats_t  stats;
+} TaskPoolClass_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Block storage; each stack row belongs to the TCB at the same index */
+static StaticTask_t g_smallTcb[TASK_POOL_SMALL_BLOCKS];
+static StackType_t  g_smallStack[TASK_POOL_SMALL_BLOCKS][TASK_POOL_SMALL_WORDS];
+static uint8_t      g_smallNext[TASK_POOL_SMALL_BLOCKS];
+
+static StaticTask_t g_largeTcb[TASK_POOL_LARGE_BLOCKS];
+static StackType_t  g_largeStack[TASK_POOL_LARGE_BLOCKS][TASK_POOL_LARGE_WORDS];
+static uint8_t      g_largeNext[TASK_POOL_LARGE_BLOCKS];
+
+/* Classes, smallest first; 'head' is TASK_POOL_NONE until the first take
+ * builds the lists */
+static TaskPoolClass_t g_class[TASK_POOL_CLASSES] =
+{
+    { g_smallTcb, &g_smallStack[0][0], g_smallNext, TASK_POOL_NONE,
+      { TASK_POOL_SMALL_WORDS, TASK_POOL_SMALL_BLOCKS, 0U, 0U, 0U, 0U } },
+    { g_largeTcb, &g_largeStack[0][0], g_largeNext, TASK_POOL_NONE,
+      { TASK_POOL_LARGE_WORDS, TASK_POOL_LARGE_BLOCKS, 0U, 0U, 0U, 0U } },
+};
+
+static bool g_poolReady = false;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Threads every block of every class onto its free list.
+ *               Must be called inside a critical section.
+ */
+static void buildFreeLists(void)
+{
+    for (uint32_t c = 0U; c < TASK_POOL_CLASSES; c++)
+    {
+        TaskPoolClass_t *pool = &g_class[c];
+
+        for (uint32_t i = 0U; i < pool->stats.blocks; i++)
+        {
+            pool->next[i] = (uint8_t)(((i + 1U) < pool->stats.blocks) ? (i + 1U) : TASK_POOL_NONE);
+        }
+        pool->head = (pool->stats.blocks > 0U) ? 0U : TASK_POOL_NONE;
+    }
+
+    g_poolReady = true;
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Pops the head of the first class large enough. A full
+ *               class does not fall through to the next one, so small
+ *               workers cannot starve the large class.
+ */
+bool taskPoolTake(uint32_t stackWords, void **tcb, void **stack, uint32_t *depthWords)
+{
+    bool taken = false;
+
+    if ((tcb == NULL) || (stack == NULL) || (depthWords == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if (!g_poolReady)
+        {
+            buildFreeLists();
+        }
+
+        for (uint32_t c = 0U; c < TASK_POOL_CLASSES; c++)
+        {
+            TaskPoolClass_t *pool = &g_class[c];
+
+            if (stackWords > pool->stats.stack_words)
+            {
+                continue;
+            }
+
+            if (pool->head == TASK_POOL_NONE)
+            {
+                pool->stats.failures++;
+                break;
+            }
+
+            uint32_t index = pool->head;
+            pool->head = pool->next[index];
+
+            pool->stats.in_use++;
+            pool->stats.takes++;
+            if (pool->stats.in_use > pool->stats.peak)
+            {
+                pool->stats.peak = pool->stats.in_use;
+            }
+
+            *tcb        = &pool->tcbs[index];
+            *stack      = &pool->stacks[index * pool->stats.stack_words];
+            *depthWords = pool->stats.stack_words;
+            taken = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return taken;
+}
+
+/*
+ * Description : Pushes the block back onto its class's free list. The
+ *               kernel calls this for every deleted task, pooled or not,
+ *               after the TCB has left all kernel lists: from the idle
+ *               task for a task that deleted itself, or from the deleting
+ *               task otherwise.
+ */
+void taskPoolRelease(void *tcb)
+{
+    taskENTER_CRITICAL();
+    {
+        for (uint32_t c = 0U; c < TASK_POOL_CLASSES; c++)
+        {
+            TaskPoolClass_t *pool = &g_class[c];
+            StaticTask_t *block = (StaticTask_t *)tcb;
+
+            if ((block >= pool->tcbs) && (block < &pool->tcbs[pool->stats.blocks]))
+            {
+                uint32_t index = (uint32_t)(block - pool->tcbs);
+
+                pool->next[index] = pool->head;
+                pool->head = (uint8_t)index;
+                pool->stats.in_use--;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Copies the counters of one class.
+ */
+bool taskPoolGetStats(uint32_t sizeClass, TaskPoolStats_t *output)
+{
+    if ((output == NULL) || (sizeClass >= TASK_POOL_CLASSES))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *output = g_class[sizeClass].stats;
+    }
+    taskEXIT_CRITICAL();
+
+    return true;
+}
+
+#endif /* TASK_POOL_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
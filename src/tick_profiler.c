@@ -12,6 +12,13 @@
  *  INCLUDES
  ******************************************************************************/
 #include "tick_profiler.h"
+#include "cycle_counter.h"
+#include "drivers.h"
+#include "event_trace.h"
+#include "gpio_probe.h"
+#include "irq_stats.h"
+#include "pc_sampler.h"
+#include "timer_wheel.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -19,54 +26,564 @@
 #include "portmacro.h"
 #include <string.h>
 
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+#if (TICK_PROFILER_CORES > 1U)
+#if (IRQ_STATS_ENABLED == 1U) && (IRQ_STATS_EXCLUDE_ENABLED == 1U)
+#error "IRQ_STATS_EXCLUDE_ENABLED keeps one interrupt total for a single core"
+#endif
+
+/* Core running the caller, the task each core runs and its idle task */
+#define TICK_PROFILER_CORE_ID()             ((uint32_t)portGET_CORE_ID())
+#define TICK_PROFILER_CORE_TASK(core)       xTaskGetCurrentTaskHandleForCore((BaseType_t)(core))
+#define TICK_PROFILER_CORE_IDLE(core)       xTaskGetIdleTaskHandleForCore((BaseType_t)(core))
+#else
+#define TICK_PROFILER_CORE_ID()             0U
+#define TICK_PROFILER_CORE_TASK(core)       xTaskGetCurrentTaskHandle()
+#define TICK_PROFILER_CORE_IDLE(core)       xTaskGetIdleTaskHandle()
+#endif
+
 /******************************************************************************
  *  STATIC (PRIVATE) VARIABLES
  ******************************************************************************/
 /* Table holding runtime statistics for all tracked tasks */
 static TickProfilerTaskInfo_t g_taskTable[TICK_PROFILER_MAX_TASKS];
 
+/* Slot permutation: the first g_activeCount entries are the registered
+ * slots (dense active list), the rest are free. g_slotPosition is the
+ * inverse, so allocation and release are O(1) swaps. */
+static uint8_t g_slotOrder[TICK_PROFILER_MAX_TASKS];
+static uint8_t g_slotPosition[TICK_PROFILER_MAX_TASKS];
+static volatile uint32_t g_activeCount = 0U;
+
+/* Bit per slot for each scheduler level, and the population of each set */
+static volatile uint32_t g_levelMask[TICK_PROFILER_MAX_LEVELS][TICK_PROFILER_SLOT_MASK_WORDS];
+static volatile uint32_t g_levelCount[TICK_PROFILER_MAX_LEVELS];
+
+/* Odd while a record or the active list is being changed */
+static volatile uint32_t g_tableSequence = 0U;
+
 /* Queue used to notify scheduler of expired task quanta (optional) */
 #if (TICK_PROFILER_EXPIRED_QUEUE_ENABLED == 1U)
 static QueueHandle_t g_expiredQueue = NULL;
+
+#if (TICK_PROFILER_EXPIRED_QUEUE_ENABLED == 1U) && (configSUPPORT_STATIC_ALLOCATION == 1)
+/* Queue control block and storage, so the queue needs no heap */
+static StaticQueue_t g_expiredQueueControl;
+static uint8_t g_expiredQueueStorage[TICK_PROFILER_EXPIRED_QUEUE_LENGTH * sizeof(TaskHandle_t)];
+#endif
+#endif
+
+/* Bit per profiler slot set by the tick hook on quantum expiry (optional) */
+#if (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U)
+static volatile uint32_t g_expiredMask[TICK_PROFILER_EXPIRED_MASK_WORDS];
 #endif
 
 /* Handle of the scheduler task to be notified from ISR */
 static TaskHandle_t g_schedulerTaskHandle = NULL;
 
+/* Idle task of each core, told apart from the other unmanaged tasks for
+ * the CPU split */
+static TaskHandle_t g_idleTaskHandle[TICK_PROFILER_CORES];
+
+/* CPU time of every consumer, managed or not, on each core */
+static TickProfilerCpuTime_t g_cpuTime[TICK_PROFILER_CORES];
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 0U)
+/* Sleep cycles short of a whole tick, carried to the next sleep of the
+ * same core */
+static uint32_t g_asleepCarryCycles[TICK_PROFILER_CORES];
+#endif
+
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+/* Budget window of every level in ticks (or TICK_PROFILER_BUDGET_ON_BLOCK) */
+static uint32_t g_budgetWindow[TICK_PROFILER_MAX_LEVELS];
+#endif
+
+/* Expiry notification counters (written from the tick ISR only) */
+static TickProfilerExpiryStats_t g_expiryStats;
+
+/* Tickless idle counters, updated from vTaskStepTick() */
+#if (configUSE_TICKLESS_IDLE == 1)
+static TickProfilerSleepStats_t g_sleepStats;
+#endif
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+/* Record of the task currently being charged (NULL if not profiled) */
+static TickProfilerTaskInfo_t *g_runningRecord = NULL;
+static TaskHandle_t g_runningTask = NULL;
+
+/* Cycle count at which the running task was last charged */
+static uint32_t g_chargeStartCycles = 0U;
+
+/* Tasks that crossed their quantum at switch-out, reported on next tick */
+static TickProfilerTaskInfo_t *g_pendingExpiries[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_pendingExpiryCount = 0U;
+#endif
+
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+/* Set by a taskYIELD() until the switch-out it causes, per core */
+static volatile bool g_yieldPending[TICK_PROFILER_CORES];
+
+/* Outgoing task of the switch in progress on each core, and how it left */
+static TickProfilerTaskInfo_t *g_countOutRecord[TICK_PROFILER_CORES];
+static TaskHandle_t g_countOutTask[TICK_PROFILER_CORES];
+static bool g_countOutVoluntary[TICK_PROFILER_CORES];
+#endif
+
+#if (MLFQ_YIELD_BURST_HOOKED == 1U)
+/* Task that ended its burst with schedulerYieldBurst(), until it is out,
+ * per core */
+static volatile TaskHandle_t g_burstEndTask[TICK_PROFILER_CORES];
+#endif
+
+#if (IRQ_STATS_ENABLED == 1U) && (IRQ_STATS_EXCLUDE_ENABLED == 1U)
+/* Interrupt cycles already taken out of a task's time */
+static uint32_t g_irqSeenCycles = 0U;
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 0U)
+/* Interrupt cycles not yet worth a whole tick */
+static uint32_t g_irqCarryCycles = 0U;
+#endif
+#endif
+
+/* Cycle count at tickProfilerBootStart(), and the boot time once
+ * tickProfilerBootEnd() has run */
+static uint32_t g_bootStartCycles = 0U;
+static uint32_t g_bootCycles = 0U;
+
 /******************************************************************************
  *  STATIC (PRIVATE) FUNCTION DEFINITIONS
  ******************************************************************************/
 
+#if (IRQ_STATS_ENABLED == 1U) && (IRQ_STATS_EXCLUDE_ENABLED == 1U)
+/*
+ * Description : Returns the interrupt cycles since the previous call.
+ *               Called only from the tick hook, the switch hooks and
+ *               the quantum timer, which never nest with each other.
+ */
+static uint32_t takeIrqCycles(void)
+{
+    uint32_t total = irqStatsGetCycles();
+    uint32_t cycles = total - g_irqSeenCycles;
+
+    g_irqSeenCycles = total;
+    return cycles;
+}
+#endif
+
+#if (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U) && (TICK_PROFILER_CORES > 1U) && !defined(TICK_PROFILER_ATOMIC_TAKE)
+/*
+ * Description : Swaps a word with zero under the kernel's ISR spinlock.
+ *               The tick hook sets expiry bits under the same lock, and
+ *               on SMP it may run on another core than the supervisor, so
+ *               the exclusive monitor of one core does not cover it.
+ */
+static uint32_t lockedTake(volatile uint32_t *word)
+{
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    uint32_t value = *word;
+
+    *word = 0U;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return value;
+}
+
+#define TICK_PROFILER_ATOMIC_TAKE(word)   lockedTake(word)
+#endif
+
+#if (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U) && !defined(TICK_PROFILER_ATOMIC_TAKE)
+/*
+ * Description : Swaps a word with zero and returns its old value using
+ *               LDREX/STREX. Exception entry clears the exclusive monitor,
+ *               so if the tick hook sets a bit in between the store fails
+ *               and the loop reloads; interrupts are never masked.
+ */
+static uint32_t atomicTake(volatile uint32_t *word)
+{
+    uint32_t value;
+
+    do {
+        value = (uint32_t)__ldrex((void *)word);
+    } while (__strex(0U, (void *)word) != 0);
+
+    return value;
+}
+
+#define TICK_PROFILER_ATOMIC_TAKE(word)   atomicTake(word)
+#endif
+
 /*
- * Description : Finds the index of a task inside the profiler table.
- *               Returns -1 if the task is not found or invalid.
+ * Description : Returns the profiler record of a task in constant time.
+ *               The record pointer is cached in the task's thread local
+ *               storage slot at registration; the back-reference check
+ *               rejects stale or foreign TLS values.
+ *               Returns NULL if the task is not found or invalid.
  */
-static int32_t findTaskIndex(TaskHandle_t task)
+static TickProfilerTaskInfo_t *findTaskRecord(TaskHandle_t task)
 {
     if (task == NULL) {
+        return NULL;
+    }
+
+    TickProfilerTaskInfo_t *record = (TickProfilerTaskInfo_t *)
+        pvTaskGetThreadLocalStoragePointer(task, TICK_PROFILER_TLS_INDEX);
+
+    if ((record == NULL) || (record->task != task)) {
+        return NULL;
+    }
+    return record;
+}
+
+/*
+ * Description : Takes the first free slot of the permutation and moves
+ *               it to the end of the active list. Returns -1 if the
+ *               table is full. Must be called inside a critical section.
+ */
+static int32_t allocateSlot(void)
+{
+    if (g_activeCount >= TICK_PROFILER_MAX_TASKS) {
         return -1;
     }
+    return (int32_t)g_slotOrder[g_activeCount++];
+}
+
+/*
+ * Description : Swaps a slot with the last active entry and shrinks the
+ *               active list over it. Must be called inside a critical
+ *               section.
+ */
+static void releaseSlot(uint32_t slot)
+{
+    uint32_t position = g_slotPosition[slot];
+    uint32_t last = g_slotOrder[g_activeCount - 1U];
+
+    g_slotOrder[position] = (uint8_t)last;
+    g_slotPosition[last] = (uint8_t)position;
+    g_slotOrder[g_activeCount - 1U] = (uint8_t)slot;
+    g_slotPosition[slot] = (uint8_t)(g_activeCount - 1U);
+    g_activeCount--;
+}
+
+/*
+ * Description : Adds a slot to, or removes it from, the set of a level
+ *               and keeps the level population in step. Levels outside
+ *               the sets are ignored. Must be called with interrupts masked.
+ */
+static void updateLevelMask(uint32_t slot, uint8_t level, bool member)
+{
+    if (level >= TICK_PROFILER_MAX_LEVELS) {
+        return;
+    }
+
+    uint32_t bit = 1UL << (slot & 31U);
+    bool present = ((g_levelMask[level][slot >> 5] & bit) != 0U);
+
+    if (member && !present) {
+        g_levelMask[level][slot >> 5] |= bit;
+        g_levelCount[level]++;
+    } else if (!member && present) {
+        g_levelMask[level][slot >> 5] &= ~bit;
+        g_levelCount[level]--;
+    }
+}
+
+/*
+ * Description : Returns true if the task is the idle task of any core.
+ */
+static bool isIdleTask(TaskHandle_t task)
+{
+    for (uint32_t core = 0U; core < TICK_PROFILER_CORES; core++) {
+        if (task == g_idleTaskHandle[core]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Description : Adds CPU time used on a core to a managed task and its
+ *               level, or to the unmanaged consumer the task belongs to.
+ *               Must be called inside a table write.
+ */
+static void chargeTime(uint32_t core, TickProfilerTaskInfo_t *record,
+                       TaskHandle_t task, uint32_t amount)
+{
+    TickProfilerCpuTime_t *cpu = &g_cpuTime[core];
+
+    if (record != NULL) {
+#if (configGENERATE_RUN_TIME_STATS == 0)
+        record->total_time += amount;
+#endif
+        if (record->level < TICK_PROFILER_MAX_LEVELS) {
+            cpu->level[record->level] += amount;
+        }
+    } else if (task == NULL) {
+        /* Between switch-out and switch-in: kernel time, not charged */
+    } else if (isIdleTask(task)) {
+        cpu->idle += amount;
+    } else if (task == g_schedulerTaskHandle) {
+        cpu->supervisor += amount;
+    } else {
+        cpu->other += amount;
+    }
+}
+
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+/*
+ * Description : Halves the used budget of a task once per budget window
+ *               of its level that has passed, so only recent CPU use
+ *               counts against the quantum. Windows are caught up when
+ *               the task next runs. Called from the tick or switch hook.
+ */
+static void decayBudget(TickProfilerTaskInfo_t *record)
+{
+    uint32_t window = g_budgetWindow[record->level];
+
+    if ((window == 0U) || (window == TICK_PROFILER_BUDGET_ON_BLOCK)) {
+        return;
+    }
+
+    uint32_t elapsed = (uint32_t)(xTaskGetTickCountFromISR() - record->budget_tick);
+    if (elapsed < window) {
+        return;
+    }
+
+    uint32_t halvings = elapsed / window;
+
+    tickProfilerWriteBegin();
+    record->budget_tick += (TickType_t)(halvings * window);
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    record->run_cycles = (halvings < 32U) ? (record->run_cycles >> halvings) : 0U;
+    record->run_ticks = record->run_cycles / TICK_PROFILER_CYCLES_PER_TICK;
+#else
+    record->run_ticks = (halvings < 32U) ? (record->run_ticks >> halvings) : 0U;
+#endif
+    tickProfilerWriteEnd();
+}
+#endif
+
+/*
+ * Description : Returns true once the task has used up its quantum.
+ *               Measured in cycles when cycle accounting is enabled,
+ *               in ticks otherwise. With kernel-native MLFQ the kernel
+ *               enforces the quantum and the profiler only accounts.
+ */
+static bool quantumExhausted(const TickProfilerTaskInfo_t *record)
+{
+#if (configUSE_MLFQ_NATIVE == 1)
+    (void)record;
+    return false;
+#elif (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    return (record->quantum_cycles != 0U) &&
+           (record->run_cycles >= record->quantum_cycles);
+#else
+    return (record->quantum_ticks != 0U) &&
+           (record->run_ticks >= record->quantum_ticks);
+#endif
+}
+
+/*
+ * Description : Delivers one quantum expiry to the scheduler from ISR
+ *               context. Repeats are coalesced by the per-task latch,
+ *               which setTaskQuantum()/resetTaskRuntime() clear.
+ */
+static void reportExpiry(TickProfilerTaskInfo_t *record,
+                         BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (record->expiry_reported) {
+        /* Already reported for this quantum */
+        g_expiryStats.coalesced++;
+        return;
+    }
+
+    bool delivered = true;
+
+#if (TICK_PROFILER_EXPIRED_QUEUE_ENABLED == 1U)
+    /* Notify scheduler via queue */
+    if (g_expiredQueue != NULL) {
+        delivered = (xQueueSendFromISR(
+                         g_expiredQueue,
+                         &record->task,
+                         pxHigherPriorityTaskWoken) == pdTRUE);
 
-    for (uint32_t i = 0U; i < TICK_PROFILER_MAX_TASKS; ++i) {
-        if (g_taskTable[i].task == task) {
-            return (int32_t)i;
+        UBaseType_t queued = uxQueueMessagesWaitingFromISR(g_expiredQueue);
+        if (queued > g_expiryStats.max_queued) {
+            g_expiryStats.max_queued = (uint32_t)queued;
         }
     }
-    return -1;
+#elif (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U)
+    /* Flag the slot; the supervisor collects it */
+    uint32_t slot = (uint32_t)(record - g_taskTable);
+#if (TICK_PROFILER_CORES > 1U)
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    g_expiredMask[slot >> 5] |= (1UL << (slot & 31U));
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+#else
+    g_expiredMask[slot >> 5] |= (1UL << (slot & 31U));
+#endif
+#endif
+
+    if (delivered) {
+        /* Latch until the quantum is re-armed */
+        record->expiry_reported = true;
+#if (TICK_PROFILER_COMPACT_ENABLED == 0U)
+        record->expiry_cycle = cycleCounterGet();
+#endif
+        g_expiryStats.reported++;
+#if (EVENT_TRACE_ENABLED == 1U)
+        eventTraceRecord(EVENT_TRACE_QUANTUM_EXPIRY, (void *)record->task,
+                         record->level, 0U);
+#endif
+    } else {
+        /* Queue full: retried on the next tick */
+        g_expiryStats.dropped++;
+    }
+
+    /* Direct scheduler notification (or a pass deferred to the timer
+     * service task when the supervisor runs there) */
+    if (g_schedulerTaskHandle != NULL) {
+        schedulerWakeFromISR(pxHigherPriorityTaskWoken);
+    }
+}
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+/*
+ * Description : Charges the cycles elapsed since the last charge point
+ *               to the running task and restarts the charge window.
+ *               Must be called with the tick interrupt masked.
+ */
+static void chargeRunningTask(uint32_t now)
+{
+    TickProfilerTaskInfo_t *record = g_runningRecord;
+    uint32_t elapsed = now - g_chargeStartCycles;
+
+#if (IRQ_STATS_ENABLED == 1U) && (IRQ_STATS_EXCLUDE_ENABLED == 1U)
+    /* Handlers that ran inside the window are not the task's time */
+    uint32_t interrupts = takeIrqCycles();
+    elapsed = (interrupts < elapsed) ? (elapsed - interrupts) : 0U;
+#endif
+
+    tickProfilerWriteBegin();
+    if (record != NULL) {
+        record->run_cycles += elapsed;
+        record->run_ticks = record->run_cycles / TICK_PROFILER_CYCLES_PER_TICK;
+    }
+    chargeTime(TICK_PROFILER_CORE_ID(), record, g_runningTask, elapsed);
+    tickProfilerWriteEnd();
+
+    g_chargeStartCycles = now;
 }
+#endif
 
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 0U)
 /*
- * Description : Finds the first available empty slot in the task table.
- *               Returns -1 if the table is full.
+ * Description : Charges one tick to the task running on a core and
+ *               reports its expiry once the quantum is used up. Called
+ *               from the tick hook for every core.
  */
-static int32_t findEmptySlot(void)
+static void chargeCoreTick(uint32_t core, BaseType_t *pxHigherPriorityTaskWoken)
 {
-    for (uint32_t i = 0U; i < TICK_PROFILER_MAX_TASKS; ++i) {
-        if (g_taskTable[i].task == NULL) {
-            return (int32_t)i;
+    TaskHandle_t current = TICK_PROFILER_CORE_TASK(core);
+
+    if (current == NULL) {
+        return;
+    }
+
+    TickProfilerTaskInfo_t *record = findTaskRecord(current);
+    bool charge = true;
+
+#if (IRQ_STATS_ENABLED == 1U) && (IRQ_STATS_EXCLUDE_ENABLED == 1U)
+    /* Each tick's worth of interrupt time spares the running task one
+     * tick, so a task caught under an interrupt storm is not demoted */
+    g_irqCarryCycles += takeIrqCycles();
+    if (g_irqCarryCycles >= TICK_PROFILER_CYCLES_PER_TICK) {
+        g_irqCarryCycles -= TICK_PROFILER_CYCLES_PER_TICK;
+        charge = false;
+    }
+#endif
+
+    /* Increment runtime counter; unmanaged tasks only add to the split */
+    if (charge) {
+        tickProfilerWriteBegin();
+        if ((record != NULL) && (record->run_ticks < TICK_PROFILER_TICKS_MAX)) {
+            record->run_ticks++;
         }
+        chargeTime(core, record, current, 1U);
+        tickProfilerWriteEnd();
+    }
+
+    if (record == NULL) {
+        return;
+    }
+
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+    decayBudget(record);
+#endif
+
+    /* Check for quantum expiration */
+    if (quantumExhausted(record)) {
+        reportExpiry(record, pxHigherPriorityTaskWoken);
+    }
+}
+#endif
+
+/*
+ * Description : Converts core cycles to ticks, rounding up.
+ */
+static uint32_t cyclesToTicksCeil(uint32_t cycles)
+{
+    return (cycles + TICK_PROFILER_CYCLES_PER_TICK - 1U) / TICK_PROFILER_CYCLES_PER_TICK;
+}
+
+/*
+ * Description : Stores a new quantum and re-arms the expiry latch.
+ *               Needs no critical section: every field is an aligned
+ *               word (or byte) written with one store, and the latch is
+ *               cleared last, so a tick in between at worst coalesces an
+ *               expiry against the new quantum that is reported again
+ *               on the following tick.
+ */
+static void applyQuantum(TickProfilerTaskInfo_t *record,
+                         uint32_t quantumTicks, uint32_t quantumCycles)
+{
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    record->quantum_cycles = quantumCycles;
+#else
+    (void)quantumCycles;
+#endif
+#if (TICK_PROFILER_COMPACT_ENABLED == 1U)
+    if (quantumTicks > TICK_PROFILER_TICKS_MAX) {
+        quantumTicks = TICK_PROFILER_TICKS_MAX;
+    }
+#endif
+    record->quantum_ticks = (TickProfilerTicks_t)quantumTicks;
+    TICK_PROFILER_MEMORY_BARRIER();
+    record->expiry_reported = false;
+}
+
+/*
+ * Description : Clears the runtime of a record and re-arms the expiry
+ *               latch without a critical section. The counters the tick
+ *               interrupt advances are cleared source first (charge
+ *               window, cycles, then ticks), so a charge landing in
+ *               between only adds the few cycles since the reset.
+ */
+static void clearRuntime(TickProfilerTaskInfo_t *record)
+{
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    if (record == g_runningRecord) {
+        /* Restart the charge window of a task resetting itself */
+        g_chargeStartCycles = cycleCounterGet();
     }
-    return -1;
+    record->run_cycles = 0U;
+#endif
+    record->run_ticks = 0U;
+    TICK_PROFILER_MEMORY_BARRIER();
+    record->expiry_reported = false;
 }
 
 /******************************************************************************
@@ -84,15 +601,57 @@ bool tickProfilerInit(void)
     taskENTER_CRITICAL();
     {
         memset(g_taskTable, 0, sizeof(g_taskTable));
+        memset(&g_expiryStats, 0, sizeof(g_expiryStats));
+        memset(g_cpuTime, 0, sizeof(g_cpuTime));
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+        memset(g_budgetWindow, 0, sizeof(g_budgetWindow));
+#endif
+#if (configUSE_TICKLESS_IDLE == 1)
+        memset(&g_sleepStats, 0, sizeof(g_sleepStats));
+#endif
+        memset((void *)g_levelMask, 0, sizeof(g_levelMask));
+        memset((void *)g_levelCount, 0, sizeof(g_levelCount));
+        for (uint32_t i = 0U; i < TICK_PROFILER_MAX_TASKS; ++i) {
+            g_slotOrder[i] = (uint8_t)i;
+            g_slotPosition[i] = (uint8_t)i;
+        }
+        g_activeCount = 0U;
+#if (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U)
+        for (uint32_t w = 0U; w < TICK_PROFILER_EXPIRED_MASK_WORDS; ++w) {
+            g_expiredMask[w] = 0U;
+        }
+#endif
         g_schedulerTaskHandle = NULL;
+        memset(g_idleTaskHandle, 0, sizeof(g_idleTaskHandle));
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+        g_runningRecord = NULL;
+        g_runningTask = NULL;
+        g_pendingExpiryCount = 0U;
+        cycleCounterInit();
+        g_chargeStartCycles = cycleCounterGet();
+#endif
     }
     taskEXIT_CRITICAL();
 
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+    /* One-shot GPTM used to enforce sub-tick quanta */
+    initQuantumTimer();
+#endif
+
 #if (TICK_PROFILER_EXPIRED_QUEUE_ENABLED == 1U)
     /* Create queue for expired task notifications */
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    g_expiredQueue = xQueueCreateStatic(
+        (UBaseType_t)TICK_PROFILER_EXPIRED_QUEUE_LENGTH,
+        (UBaseType_t)sizeof(TaskHandle_t),
+        g_expiredQueueStorage,
+        &g_expiredQueueControl);
+#else
     g_expiredQueue = xQueueCreate(
         (UBaseType_t)TICK_PROFILER_EXPIRED_QUEUE_LENGTH,
         (UBaseType_t)sizeof(TaskHandle_t));
+#endif
 
     if (g_expiredQueue == NULL) {
         return false;
@@ -105,7 +664,8 @@ bool tickProfilerInit(void)
 /*
  * Description : Registers a task with the profiler.
  *               Allocates a table entry and initializes
- *               runtime and quantum counters.
+ *               runtime and quantum counters and the
+ *               arrival timestamp.
  */
 bool setupTaskStats(TaskHandle_t task)
 {
@@ -116,22 +676,65 @@ bool setupTaskStats(TaskHandle_t task)
     taskENTER_CRITICAL();
     {
         /* Prevent duplicate registration */
-        if (findTaskIndex(task) >= 0) {
+        if (findTaskRecord(task) != NULL) {
             taskEXIT_CRITICAL();
             return false;
         }
 
-        /* Find empty slot */
-        int32_t slot = findEmptySlot();
+        /* Take a free slot */
+        int32_t slot = allocateSlot();
         if (slot < 0) {
             taskEXIT_CRITICAL();
             return false;
         }
 
+        tickProfilerWriteBegin();
+
         /* Initialize task statistics */
         g_taskTable[slot].task = task;
         g_taskTable[slot].run_ticks = 0U;
         g_taskTable[slot].quantum_ticks = 0U;
+        g_taskTable[slot].arrival_tick = xTaskGetTickCount();
+        g_taskTable[slot].level = 0U;
+        updateLevelMask((uint32_t)slot, 0U, true);
+        g_taskTable[slot].expiry_reported = false;
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U)
+        g_taskTable[slot].block_reason = TICK_PROFILER_BLOCK_NONE;
+#endif
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+        g_taskTable[slot].expiry_pending = false;
+        g_taskTable[slot].run_cycles = 0U;
+        g_taskTable[slot].quantum_cycles = 0U;
+#endif
+#if (configGENERATE_RUN_TIME_STATS == 1)
+        /* The kernel counts from creation; totals count from here */
+        g_taskTable[slot].total_time = ulTaskGetRunTimeCounter(task);
+#else
+        g_taskTable[slot].total_time = 0U;
+#endif
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+        g_taskTable[slot].budget_tick = g_taskTable[slot].arrival_tick;
+#endif
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+        g_taskTable[slot].switch_ins = 0U;
+        g_taskTable[slot].voluntary_switches = 0U;
+        g_taskTable[slot].involuntary_switches = 0U;
+#endif
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+        g_taskTable[slot].context_saves = 0U;
+        g_taskTable[slot].fpu_saves = 0U;
+#endif
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+        g_taskTable[slot].level_tick = g_taskTable[slot].arrival_tick;
+        g_taskTable[slot].level_changes = 0U;
+        memset(g_taskTable[slot].level_ticks, 0, sizeof(g_taskTable[slot].level_ticks));
+#endif
+
+        tickProfilerWriteEnd();
+
+        /* Cache the record in the TCB for O(1) lookup */
+        vTaskSetThreadLocalStoragePointer(task, TICK_PROFILER_TLS_INDEX,
+                                          &g_taskTable[slot]);
     }
     taskEXIT_CRITICAL();
 
@@ -139,23 +742,48 @@ bool setupTaskStats(TaskHandle_t task)
 }
 
 /*
- * Description : Assigns a time quantum (in ticks) to a task.
+ * Description : Releases the profiler slot of a task. Drops any expiry
+ *               still in flight for it and clears the TLS cache, so
+ *               the slot can be reused at once. Safe to call from the
+ *               kernel task-delete hook.
  */
-bool setTaskQuantum(TaskHandle_t task, uint32_t quantumTicks)
+bool removeTaskStats(TaskHandle_t task)
 {
-    if (task == NULL || quantumTicks == 0U) {
-        return false;
-    }
-
     taskENTER_CRITICAL();
     {
-        int32_t idx = findTaskIndex(task);
-        if (idx < 0) {
+        TickProfilerTaskInfo_t *record = findTaskRecord(task);
+        if (record == NULL) {
             taskEXIT_CRITICAL();
             return false;
         }
 
-        g_taskTable[idx].quantum_ticks = quantumTicks;
+#if (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U)
+        uint32_t slot = (uint32_t)(record - g_taskTable);
+        g_expiredMask[slot >> 5] &= ~(1UL << (slot & 31U));
+#endif
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+        /* A task deleting itself is still being charged */
+        if (record == g_runningRecord) {
+            g_runningRecord = NULL;
+        }
+
+        for (uint32_t i = 0U; i < g_pendingExpiryCount; ++i) {
+            if (g_pendingExpiries[i] == record) {
+                g_pendingExpiries[i] = g_pendingExpiries[--g_pendingExpiryCount];
+                break;
+            }
+        }
+#endif
+
+        uint32_t released = (uint32_t)(record - g_taskTable);
+        tickProfilerWriteBegin();
+        updateLevelMask(released, record->level, false);
+        releaseSlot(released);
+
+        vTaskSetThreadLocalStoragePointer(task, TICK_PROFILER_TLS_INDEX, NULL);
+        memset(record, 0, sizeof(*record));
+        tickProfilerWriteEnd();
     }
     taskEXIT_CRITICAL();
 
@@ -163,53 +791,294 @@ bool setTaskQuantum(TaskHandle_t task, uint32_t quantumTicks)
 }
 
 /*
- * Description : Returns the accumulated runtime (in ticks)
- *               of the specified task.
+ * Description : Assigns a time quantum (in ticks) to a task.
  */
-uint32_t getTaskRuntime(TaskHandle_t task)
+bool setTaskQuantum(TaskHandle_t task, uint32_t quantumTicks)
 {
-    if (task == NULL) {
-        return 0U;
+    if (task == NULL || quantumTicks == 0U) {
+        return false;
     }
 
-    uint32_t runtime = 0U;
-
-    taskENTER_CRITICAL();
-    {
-        int32_t idx = findTaskIndex(task);
-        if (idx >= 0) {
-            runtime = g_taskTable[idx].run_ticks;
-        }
+    TickProfilerTaskInfo_t *record = findTaskRecord(task);
+    if (record == NULL) {
+        return false;
     }
-    taskEXIT_CRITICAL();
 
-    return runtime;
+    applyQuantum(record, quantumTicks, quantumTicks * TICK_PROFILER_CYCLES_PER_TICK);
+
+    return true;
 }
 
 /*
- * Description : Resets the runtime counter of a task.
+ * Description : Assigns a time quantum in core cycles. Gives slices
+ *               finer than one RTOS tick when cycle accounting is
+ *               enabled; otherwise it is rounded up to whole ticks.
  */
-bool resetTaskRuntime(TaskHandle_t task)
+bool setTaskQuantumCycles(TaskHandle_t task, uint32_t quantumCycles)
 {
-    if (task == NULL) {
+    if (task == NULL || quantumCycles == 0U) {
         return false;
     }
 
-    taskENTER_CRITICAL();
-    {
-        int32_t idx = findTaskIndex(task);
-        if (idx < 0) {
-            taskEXIT_CRITICAL();
-            return false;
-        }
+    TickProfilerTaskInfo_t *record = findTaskRecord(task);
+    if (record == NULL) {
+        return false;
+    }
+
+    applyQuantum(record, cyclesToTicksCeil(quantumCycles), quantumCycles);
+
+    return true;
+}
+
+/*
+ * Description : Returns the accumulated runtime (in ticks)
+ *               of the specified task.
+ */
+uint32_t getTaskRuntime(TaskHandle_t task)
+{
+    if (task == NULL) {
+        return 0U;
+    }
+
+    /* One aligned word: the load is atomic on Cortex-M */
+    TickProfilerTaskInfo_t *record = findTaskRecord(task);
 
-        g_taskTable[idx].run_ticks = 0U;
+    return (record != NULL) ? record->run_ticks : 0U;
+}
+
+/*
+ * Description : Resets the runtime counter of a task.
+ */
+bool resetTaskRuntime(TaskHandle_t task)
+{
+    if (task == NULL) {
+        return false;
+    }
+
+    TickProfilerTaskInfo_t *record = findTaskRecord(task);
+    if (record == NULL) {
+        return false;
+    }
+
+    clearRuntime(record);
+
+    return true;
+}
+
+/*
+ * Description : Returns the record held in a profiler slot.
+ *               The scheduler keeps its per-task state in the same
+ *               record and addresses it by slot end-to-end.
+ *               Returns NULL if the slot is out of range or empty.
+ */
+TickProfilerTaskInfo_t *tickProfilerGetRecord(uint32_t slot)
+{
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (g_taskTable[slot].task == NULL)) {
+        return NULL;
+    }
+    return &g_taskTable[slot];
+}
+
+/*
+ * Description : Assigns a time quantum (in ticks) to a slot.
+ */
+bool setSlotQuantum(uint32_t slot, uint32_t quantumTicks)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if ((record == NULL) || (quantumTicks == 0U)) {
+        return false;
+    }
+
+    applyQuantum(record, quantumTicks, quantumTicks * TICK_PROFILER_CYCLES_PER_TICK);
+
+    return true;
+}
+
+/*
+ * Description : Assigns a time quantum in core cycles to a slot.
+ */
+bool setSlotQuantumCycles(uint32_t slot, uint32_t quantumCycles)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if ((record == NULL) || (quantumCycles == 0U)) {
+        return false;
     }
-    taskEXIT_CRITICAL();
+
+    applyQuantum(record, cyclesToTicksCeil(quantumCycles), quantumCycles);
 
     return true;
 }
 
+/*
+ * Description : Resets the runtime counter of a slot.
+ */
+bool resetSlotRuntime(uint32_t slot)
+{
+    TickProfilerTaskInfo_t *record = tickProfilerGetRecord(slot);
+
+    if (record == NULL) {
+        return false;
+    }
+
+    clearRuntime(record);
+
+    return true;
+}
+
+/*
+ * Description : Applies one quantum to every registered slot and
+ *               clears its runtime, all inside a single critical
+ *               section, so snapshot readers see the boost whole.
+ *               Used by the batched global boost.
+ */
+void tickProfilerRearmAll(uint32_t quantumTicks, uint32_t quantumCycles)
+{
+    taskENTER_CRITICAL();
+    {
+        tickProfilerWriteBegin();
+        for (uint32_t i = 0U; i < g_activeCount; ++i) {
+            TickProfilerTaskInfo_t *record = &g_taskTable[g_slotOrder[i]];
+
+            applyQuantum(record, quantumTicks, quantumCycles);
+            clearRuntime(record);
+        }
+        tickProfilerWriteEnd();
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Returns the number of registered slots.
+ */
+uint32_t tickProfilerGetActiveCount(void)
+{
+    return g_activeCount;
+}
+
+/*
+ * Description : Returns the slot at a position of the active list, or
+ *               TICK_PROFILER_MAX_TASKS past its end. Loop with
+ *               for (i = 0; i < tickProfilerGetActiveCount(); i++).
+ *               A release during the loop swaps the last entry into the
+ *               freed position, so that entry may be skipped once; the
+ *               periodic passes pick it up next time.
+ */
+uint32_t tickProfilerGetActiveSlot(uint32_t index)
+{
+    if (index >= g_activeCount) {
+        return TICK_PROFILER_MAX_TASKS;
+    }
+    return g_slotOrder[index];
+}
+
+/*
+ * Description : Moves a registered slot to a level and updates the level
+ *               sets. Uses the ISR-safe interrupt mask so the kernel
+ *               tick (native MLFQ) can call it as well.
+ */
+void tickProfilerSetLevel(uint32_t slot, uint8_t level)
+{
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (g_taskTable[slot].task == NULL)) {
+        return;
+    }
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        tickProfilerWriteBegin();
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+        /* Close the stint at the old level */
+        uint8_t old = g_taskTable[slot].level;
+
+        if (level != old) {
+            TickType_t now = xTaskGetTickCountFromISR();
+
+            if (old < TICK_PROFILER_MAX_LEVELS) {
+                g_taskTable[slot].level_ticks[old] += now - g_taskTable[slot].level_tick;
+            }
+            g_taskTable[slot].level_tick = now;
+            g_taskTable[slot].level_changes++;
+        }
+#endif
+        updateLevelMask(slot, g_taskTable[slot].level, false);
+        g_taskTable[slot].level = level;
+        updateLevelMask(slot, level, true);
+        tickProfilerWriteEnd();
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/*
+ * Description : Returns one word of the membership set of a level.
+ *               Bit n of word w corresponds to slot (w * 32 + n).
+ */
+uint32_t tickProfilerGetLevelMask(uint8_t level, uint32_t word)
+{
+    if ((level >= TICK_PROFILER_MAX_LEVELS) || (word >= TICK_PROFILER_SLOT_MASK_WORDS)) {
+        return 0U;
+    }
+    return g_levelMask[level][word];
+}
+
+/*
+ * Description : Returns the number of slots in the set of a level.
+ */
+uint32_t tickProfilerGetLevelCount(uint8_t level)
+{
+    if (level >= TICK_PROFILER_MAX_LEVELS) {
+        return 0U;
+    }
+    return g_levelCount[level];
+}
+
+/*
+ * Description : Opens a change of the table. Must be called with
+ *               interrupts masked and closed by tickProfilerWriteEnd().
+ *               On SMP the writer must also hold the kernel's ISR lock
+ *               (the tick hook, the switch hooks and the critical
+ *               sections do), so writers on two cores never interleave.
+ */
+void tickProfilerWriteBegin(void)
+{
+    g_tableSequence = g_tableSequence + 1U;
+    TICK_PROFILER_MEMORY_BARRIER();
+}
+
+/*
+ * Description : Closes a change opened by tickProfilerWriteBegin().
+ */
+void tickProfilerWriteEnd(void)
+{
+    TICK_PROFILER_MEMORY_BARRIER();
+    g_tableSequence = g_tableSequence + 1U;
+}
+
+/*
+ * Description : Starts a lock-free read of the table and returns the
+ *               sequence to pass to tickProfilerReadRetry().
+ */
+uint32_t tickProfilerReadBegin(void)
+{
+    uint32_t sequence = g_tableSequence;
+
+    TICK_PROFILER_MEMORY_BARRIER();
+    return sequence;
+}
+
+/*
+ * Description : Returns true if the table changed since ReadBegin (or a
+ *               change was in progress then), so the copy must be redone.
+ *               Read from task context only: a writer always runs to
+ *               completion before the reader resumes, whereas a reader
+ *               in an interrupt above a writer would retry forever.
+ */
+bool tickProfilerReadRetry(uint32_t sequence)
+{
+    TICK_PROFILER_MEMORY_BARRIER();
+    return ((sequence & 1U) != 0U) || (g_tableSequence != sequence);
+}
+
 /*
  * Description : Registers the scheduler task handle.
  *               Used to notify the scheduler from ISR
@@ -217,11 +1086,12 @@ bool resetTaskRuntime(TaskHandle_t task)
  */
 void tickProfilerSetSchedulerTaskHandle(TaskHandle_t schedulerHandle)
 {
-    taskENTER_CRITICAL();
-    {
-        g_schedulerTaskHandle = schedulerHandle;
+    /* Single pointer stores; the tick hook sees the old or new handle.
+     * Called by the running scheduler task, so the idle tasks exist */
+    g_schedulerTaskHandle = schedulerHandle;
+    for (uint32_t core = 0U; core < TICK_PROFILER_CORES; core++) {
+        g_idleTaskHandle[core] = TICK_PROFILER_CORE_IDLE(core);
     }
-    taskEXIT_CRITICAL();
 }
 
 /*
@@ -237,57 +1107,735 @@ QueueHandle_t tickProfilerGetExpiredQueue(void)
 #endif
 }
 
+/*
+ * Description : Returns the profiler table slot of a task.
+ *               Returns -1 if the task is not registered.
+ */
+int32_t tickProfilerGetSlot(TaskHandle_t task)
+{
+    TickProfilerTaskInfo_t *record = findTaskRecord(task);
+
+    if (record == NULL) {
+        return -1;
+    }
+    return (int32_t)(record - g_taskTable);
+}
+
+/*
+ * Description : Returns the record of the task running on the calling
+ *               core, or NULL if it is not registered. With cycle
+ *               accounting that is the record being charged; otherwise
+ *               the running task's TLS pointer. No search, no lock.
+ */
+TickProfilerTaskInfo_t *tickProfilerGetCurrentRecord(void)
+{
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    return g_runningRecord;
+#else
+    return findTaskRecord(xTaskGetCurrentTaskHandle());
+#endif
+}
+
+/*
+ * Description : Returns the quantum left to the running task in core
+ *               cycles; whole ticks' worth in tick mode. With cycle
+ *               accounting the window not yet charged counts as used.
+ *               0 once the quantum is used up; UINT32_MAX for a task
+ *               that is not registered or has no quantum.
+ */
+uint32_t tickProfilerGetRemainingCycles(void)
+{
+    const TickProfilerTaskInfo_t *record = tickProfilerGetCurrentRecord();
+
+    if (record == NULL) {
+        return UINT32_MAX;
+    }
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    if (record->quantum_cycles == 0U) {
+        return UINT32_MAX;
+    }
+
+    uint32_t used = record->run_cycles + (cycleCounterGet() - g_chargeStartCycles);
+    return (used < record->quantum_cycles) ? (record->quantum_cycles - used) : 0U;
+#else
+    TickProfilerTicks_t quantum = record->quantum_ticks;
+    TickProfilerTicks_t used = record->run_ticks;
+
+    if (quantum == 0U) {
+        return UINT32_MAX;
+    }
+
+    return (used < quantum) ? ((uint32_t)(quantum - used) * TICK_PROFILER_CYCLES_PER_TICK) : 0U;
+#endif
+}
+
+/*
+ * Description : Fetches and clears one word of the expired-slot mask
+ *               with an atomic exchange, so a bit the tick hook sets
+ *               concurrently is either returned now or kept for the
+ *               next call. Bit n of word w corresponds to slot (w * 32 + n).
+ */
+uint32_t tickProfilerTakeExpiredMask(uint32_t word)
+{
+#if (TICK_PROFILER_EXPIRED_MASK_ENABLED == 1U)
+    if (word >= TICK_PROFILER_EXPIRED_MASK_WORDS) {
+        return 0U;
+    }
+
+    return TICK_PROFILER_ATOMIC_TAKE(&g_expiredMask[word]);
+#else
+    (void)word;
+    return 0U;
+#endif
+}
+
+/*
+ * Description : Copies the expiry notification counters.
+ */
+void tickProfilerGetExpiryStats(TickProfilerExpiryStats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *stats = g_expiryStats;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+/*
+ * Description : Returns the CPU time of a slot since registration from
+ *               the kernel's run-time counter, in core cycles, converted
+ *               to ticks without cycle accounting so it stays in the
+ *               unit of the CPU split. The critical section keeps the
+ *               task from being deleted while its TCB is read. The
+ *               running task's current slice is not included.
+ */
+uint64_t tickProfilerGetTotalTime(uint32_t slot)
+{
+    uint64_t total = 0U;
+
+    if (slot >= TICK_PROFILER_MAX_TASKS) {
+        return 0U;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        if (g_taskTable[slot].task != NULL) {
+            total = ulTaskGetRunTimeCounter(g_taskTable[slot].task) -
+                    g_taskTable[slot].total_time;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 0U)
+    total /= TICK_PROFILER_CYCLES_PER_TICK;
+#endif
+
+    return total;
+}
+#else
+/*
+ * Description : Reads the 64-bit lifetime CPU time of a slot, which the
+ *               tick interrupt updates in two halves, through the table
+ *               sequence counter.
+ */
+uint64_t tickProfilerGetTotalTime(uint32_t slot)
+{
+    uint32_t sequence;
+    uint64_t total;
+
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (g_taskTable[slot].task == NULL)) {
+        return 0U;
+    }
+
+    do {
+        sequence = tickProfilerReadBegin();
+        total = g_taskTable[slot].total_time;
+    } while (tickProfilerReadRetry(sequence));
+
+    return total;
+}
+#endif
+
+#if (TICK_PROFILER_LEVEL_TIME_ENABLED == 1U)
+/*
+ * Description : Copies the time at each level of a slot, with the open
+ *               stint at its current level counted up to now.
+ */
+bool tickProfilerGetLevelTime(uint32_t slot, TickProfilerLevelTime_t *output)
+{
+    bool found = false;
+
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (output == NULL)) {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        const TickProfilerTaskInfo_t *record = &g_taskTable[slot];
+
+        if (record->task != NULL) {
+            memcpy(output->ticks, record->level_ticks, sizeof(output->ticks));
+            output->changes = record->level_changes;
+            if (record->level < TICK_PROFILER_MAX_LEVELS) {
+                output->ticks[record->level] += xTaskGetTickCount() - record->level_tick;
+            }
+            found = true;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return found;
+}
+#endif
+
+/*
+ * Description : Copies the CPU time of every consumer, summed over the
+ *               cores, as one consistent view, through the table
+ *               sequence counter.
+ */
+void tickProfilerGetCpuTime(TickProfilerCpuTime_t *output)
+{
+    TickProfilerCpuTime_t cores[TICK_PROFILER_CORES];
+    uint32_t sequence;
+
+    if (output == NULL) {
+        return;
+    }
+
+    do {
+        sequence = tickProfilerReadBegin();
+        memcpy(cores, g_cpuTime, sizeof(cores));
+    } while (tickProfilerReadRetry(sequence));
+
+    *output = cores[0];
+    for (uint32_t core = 1U; core < TICK_PROFILER_CORES; core++) {
+        for (uint32_t level = 0U; level < TICK_PROFILER_MAX_LEVELS; level++) {
+            output->level[level] += cores[core].level[level];
+        }
+        output->supervisor += cores[core].supervisor;
+        output->idle += cores[core].idle;
+        output->other += cores[core].other;
+        output->asleep += cores[core].asleep;
+    }
+}
+
+/*
+ * Description : Copies the CPU time of every consumer on one core, through
+ *               the table sequence counter.
+ */
+bool tickProfilerGetCoreCpuTime(uint32_t core, TickProfilerCpuTime_t *output)
+{
+    uint32_t sequence;
+
+    if ((core >= TICK_PROFILER_CORES) || (output == NULL)) {
+        return false;
+    }
+
+    do {
+        sequence = tickProfilerReadBegin();
+        *output = g_cpuTime[core];
+    } while (tickProfilerReadRetry(sequence));
+
+    return true;
+}
+
+/*
+ * Description : Copies the tickless idle counters.
+ */
+void tickProfilerGetSleepStats(TickProfilerSleepStats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+#if (configUSE_TICKLESS_IDLE == 1)
+    taskENTER_CRITICAL();
+    {
+        *stats = g_sleepStats;
+    }
+    taskEXIT_CRITICAL();
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/*
+ * Description : Called by the idle hook with interrupts masked, once the
+ *               cycle counter has been moved over the sleep, and after a
+ *               tickless sleep. The cycles are already part of the idle
+ *               task's time; this only records how much of it was asleep,
+ *               in ticks when the profiler counts ticks.
+ */
+void tickProfilerIdleSlept(uint32_t cycles)
+{
+    TickProfilerCpuTime_t *cpu = &g_cpuTime[TICK_PROFILER_CORE_ID()];
+
+#if (TICK_PROFILER_CORES > 1U)
+    /* Masking stops this core only; the lock keeps the tick hook's writes
+     * on another core out of the sequence */
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+#endif
+    tickProfilerWriteBegin();
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    cpu->asleep += cycles;
+#else
+    uint32_t *carry = &g_asleepCarryCycles[TICK_PROFILER_CORE_ID()];
+
+    *carry += cycles;
+    cpu->asleep += *carry / TICK_PROFILER_CYCLES_PER_TICK;
+    *carry %= TICK_PROFILER_CYCLES_PER_TICK;
+#endif
+    tickProfilerWriteEnd();
+#if (TICK_PROFILER_CORES > 1U)
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+#endif
+}
+
+#if (configUSE_TICKLESS_IDLE == 1)
+/*
+ * Description : Kernel tick-step hook (traceINCREASE_TICK_COUNT), called
+ *               with interrupts disabled after a tickless sleep. Moves the
+ *               cycle counter over the sleep, so cycle accounting charges
+ *               it to the task that slept (the idle task, which is not
+ *               managed), and in tick mode charges the skipped ticks to
+ *               the current task as the tick hook would have. An expiry
+ *               this crosses is reported by the next tick hook.
+ */
+void tickProfilerTicksStepped(uint32_t ticks)
+{
+    cycleCounterAdvance(ticks * TICK_PROFILER_CYCLES_PER_TICK);
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 0U)
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    TickProfilerTaskInfo_t *record = findTaskRecord(current);
+
+    tickProfilerWriteBegin();
+    if (record != NULL) {
+        /* Saturate rather than wrap in the compact record */
+        record->run_ticks = (ticks < TICK_PROFILER_TICKS_MAX - record->run_ticks) ?
+                            (TickProfilerTicks_t)(record->run_ticks + ticks) :
+                            (TickProfilerTicks_t)TICK_PROFILER_TICKS_MAX;
+    }
+    chargeTime(0U, record, current, ticks);
+    tickProfilerWriteEnd();
+#endif
+
+    tickProfilerIdleSlept(ticks * TICK_PROFILER_CYCLES_PER_TICK);
+
+    g_sleepStats.sleeps++;
+    g_sleepStats.stepped_ticks += ticks;
+    if (ticks > g_sleepStats.longest_ticks) {
+        g_sleepStats.longest_ticks = ticks;
+    }
+}
+#endif
+
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+/*
+ * Description : Sets the budget window of a level. Called by the
+ *               scheduler at start-up, before tasks are registered.
+ */
+void tickProfilerSetBudgetWindow(uint8_t level, uint32_t windowTicks)
+{
+    if (level < TICK_PROFILER_MAX_LEVELS) {
+        g_budgetWindow[level] = windowTicks;
+    }
+}
+
+/*
+ * Description : Kernel switch-out hook (traceTASK_SWITCHED_OUT), after
+ *               the cycle charge. A task that blocks at a refunding
+ *               level starts its next burst with the whole quantum,
+ *               unless the quantum already ran out: that expiry is on
+ *               its way to the scheduler and is not taken back. With
+ *               block reasons, a delay only refunds if
+ *               TICK_PROFILER_DELAY_REFUND_ENABLED is set.
+ */
+void tickProfilerBudgetSwitchedOut(void *task, bool stillReady)
+{
+    if (stillReady) {
+        return;
+    }
+
+    TickProfilerTaskInfo_t *record = findTaskRecord((TaskHandle_t)task);
+
+    if ((record == NULL) || record->expiry_reported ||
+        (g_budgetWindow[record->level] != TICK_PROFILER_BUDGET_ON_BLOCK)) {
+        return;
+    }
+
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U) && (TICK_PROFILER_DELAY_REFUND_ENABLED == 0U)
+    if (record->block_reason == TICK_PROFILER_BLOCK_DELAY) {
+        return;
+    }
+#endif
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    if (record->expiry_pending) {
+        return;
+    }
+#endif
+
+    tickProfilerWriteBegin();
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    record->run_cycles = 0U;
+#endif
+    record->run_ticks = 0U;
+    tickProfilerWriteEnd();
+}
+#endif
+
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U)
+/*
+ * Description : Kernel blocking hooks (traceTASK_DELAY,
+ *               traceBLOCKING_ON_QUEUE_RECEIVE, ...) and traceTASK_SUSPEND.
+ *               Runs with the scheduler suspended or inside a critical
+ *               section, just before the task leaves the ready list, so
+ *               the reason is in place for the switch-out and ready hooks
+ *               that read it. Unmanaged tasks are ignored.
+ */
+void tickProfilerSetBlockReason(void *task, uint8_t reason)
+{
+    TickProfilerTaskInfo_t *record = findTaskRecord(
+        (task != NULL) ? (TaskHandle_t)task : xTaskGetCurrentTaskHandle());
+
+    if (record != NULL) {
+        record->block_reason = reason;
+    }
+}
+#endif
+
+#if (TICK_PROFILER_SWITCH_COUNTS_ENABLED == 1U)
+/*
+ * Description : Kernel yield hook (traceTASK_YIELD), run by the task
+ *               calling taskYIELD() just before it pends the switch.
+ */
+void tickProfilerTaskYielded(void)
+{
+    g_yieldPending[TICK_PROFILER_CORE_ID()] = true;
+}
+
+/*
+ * Description : Kernel switch-out hook (traceTASK_SWITCHED_OUT). Only
+ *               notes the outgoing task: the switch is counted on the
+ *               way in, once it is known that another task was picked.
+ *               A task no longer ready blocked, slept or suspended; one
+ *               still ready was preempted, unless it yielded.
+ */
+void tickProfilerCountSwitchedOut(void *task, bool stillReady)
+{
+    uint32_t core = TICK_PROFILER_CORE_ID();
+
+    g_countOutRecord[core] = findTaskRecord((TaskHandle_t)task);
+    g_countOutTask[core] = (TaskHandle_t)task;
+    g_countOutVoluntary[core] = !stillReady || g_yieldPending[core];
+    g_yieldPending[core] = false;
+}
+
+/*
+ * Description : Kernel switch-in hook (traceTASK_SWITCHED_IN). A yield
+ *               or a tick with no other ready task of that priority
+ *               selects the same task again, which is not a switch.
+ */
+void tickProfilerCountSwitchedIn(void *task)
+{
+    uint32_t core = TICK_PROFILER_CORE_ID();
+
+    if ((TaskHandle_t)task == g_countOutTask[core]) {
+        return;
+    }
+
+    if (g_countOutRecord[core] != NULL) {
+        if (g_countOutVoluntary[core]) {
+            g_countOutRecord[core]->voluntary_switches++;
+        } else {
+            g_countOutRecord[core]->involuntary_switches++;
+        }
+    }
+
+    TickProfilerTaskInfo_t *record = findTaskRecord((TaskHandle_t)task);
+    if (record != NULL) {
+        record->switch_ins++;
+    }
+
+    g_countOutRecord[core] = NULL;
+    g_countOutTask[core] = NULL;
+}
+#endif
+
+#if (TICK_PROFILER_FPU_STATS_ENABLED == 1U)
+/*
+ * Description : Kernel switch-out hook (traceTASK_SWITCHED_OUT). PendSV
+ *               saves the context even when the same task is selected
+ *               again, so every switch-out is a save.
+ */
+void tickProfilerFpuSwitchedOut(void *task, bool fpuFrame)
+{
+    TickProfilerTaskInfo_t *record = findTaskRecord((TaskHandle_t)task);
+
+    if (record != NULL) {
+        record->context_saves++;
+        if (fpuFrame) {
+            record->fpu_saves++;
+        }
+    }
+}
+#endif
+
+#if (MLFQ_YIELD_BURST_HOOKED == 1U)
+/*
+ * Description : Called by schedulerYieldBurst() in a critical section,
+ *               just before its yield. The reason replaces that of the
+ *               last block, so an old delay does not hold back the
+ *               budget refund.
+ */
+void tickProfilerEndBurst(void)
+{
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+
+#if (TICK_PROFILER_BLOCK_REASON_ENABLED == 1U)
+    TickProfilerTaskInfo_t *record = findTaskRecord(task);
+    if (record != NULL) {
+        record->block_reason = TICK_PROFILER_BLOCK_YIELD;
+    }
+#endif
+
+    g_burstEndTask[TICK_PROFILER_CORE_ID()] = task;
+}
+
+/*
+ * Description : Kernel switch-out hook (traceTASK_SWITCHED_OUT), for the
+ *               burst and budget hooks. A task that ended its burst is
+ *               handed to them as blocked although it is still ready.
+ */
+bool tickProfilerBurstOpen(void *task, bool stillReady)
+{
+    return stillReady && ((TaskHandle_t)task != g_burstEndTask[TICK_PROFILER_CORE_ID()]);
+}
+
+/*
+ * Description : Kernel switch-out hook (traceTASK_SWITCHED_OUT), last in
+ *               the chain. The mark holds for one switch-out only.
+ */
+void tickProfilerBurstSwitchedOut(void)
+{
+    g_burstEndTask[TICK_PROFILER_CORE_ID()] = NULL;
+}
+#endif
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+/*
+ * Description : Kernel switch-in hook (traceTASK_SWITCHED_IN).
+ *               Starts a new charge window for the incoming task.
+ */
+void tickProfilerTaskSwitchedIn(void *task)
+{
+    TickProfilerTaskInfo_t *record = findTaskRecord((TaskHandle_t)task);
+
+    g_runningRecord = record;
+    g_runningTask = (TaskHandle_t)task;
+    g_chargeStartCycles = cycleCounterGet();
+#if (IRQ_STATS_ENABLED == 1U) && (IRQ_STATS_EXCLUDE_ENABLED == 1U)
+    /* Handlers that ran during the switch itself belong to no task */
+    (void)takeIrqCycles();
+#endif
+
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+    /* Decay before the timer is armed with the remaining budget */
+    if (record != NULL) {
+        decayBudget(record);
+    }
+#endif
+
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+    /* Arm the quantum timer with whatever budget is left */
+    if ((record != NULL) && (record->quantum_cycles != 0U) &&
+        !record->expiry_reported)
+    {
+        uint32_t remaining = (record->run_cycles < record->quantum_cycles) ?
+                             (record->quantum_cycles - record->run_cycles) : 1U;
+        armQuantumTimer(remaining);
+    }
+#endif
+}
+
+/*
+ * Description : Kernel switch-out hook (traceTASK_SWITCHED_OUT).
+ *               Charges the outgoing task for the cycles it consumed.
+ *               Kernel APIs cannot be called from inside the context
+ *               switch, so an expiry found here is queued and reported
+ *               by the next tick hook.
+ */
+void tickProfilerTaskSwitchedOut(void *task)
+{
+    (void)task;
+
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+    disarmQuantumTimer();
+#endif
+
+    chargeRunningTask(cycleCounterGet());
+
+    TickProfilerTaskInfo_t *record = g_runningRecord;
+    if ((record != NULL) && !record->expiry_reported &&
+        !record->expiry_pending && quantumExhausted(record))
+    {
+        record->expiry_pending = true;
+        g_pendingExpiries[g_pendingExpiryCount++] = record;
+    }
+    g_runningRecord = NULL;
+    g_runningTask = NULL;
+}
+#endif
+
+/*
+ * Description : Quantum timer expiry, called from the GPTM ISR.
+ *               Charges the running task up to now and reports its
+ *               expiry if the budget is really used up. The timer runs
+ *               at the kernel interrupt priority so it never nests
+ *               with the tick hook or the context switch.
+ */
+void tickProfilerQuantumTimerExpired(void)
+{
+#if (TICK_PROFILER_TIMER_ENFORCEMENT_ENABLED == 1U)
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    chargeRunningTask(cycleCounterGet());
+
+    TickProfilerTaskInfo_t *record = g_runningRecord;
+    if ((record != NULL) && quantumExhausted(record)) {
+        reportExpiry(record, &xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+#endif
+}
+
 /*
  * Description : FreeRTOS tick hook.
  *               Executes on every system tick interrupt.
  *               Updates runtime counters, checks for quantum
- *               expiration, and notifies the scheduler.
+ *               expiration, and notifies the scheduler once per
+ *               quantum; repeats are latched until the quantum or
+ *               runtime is reset. In cycle accounting mode the
+ *               running task is charged up to now and expiries
+ *               detected at switch-out are delivered here. In tick
+ *               mode the task running on every core is charged.
  */
 void vApplicationTickHook(void)
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    TaskHandle_t current = xTaskGetCurrentTaskHandle();
 
-    if (current == NULL) {
-        return;
+    GPIO_PROBE_HIGH(GPIO_PROBE_PIN_TICK);
+
+#if (PC_SAMPLER_ENABLED == 1U)
+    /* Before anything here can switch tasks */
+    pcSamplerTick();
+#endif
+
+#if (TICK_PROFILER_CYCLE_ACCOUNTING_ENABLED == 1U)
+    /* Deliver expiries found while switching tasks out */
+    for (uint32_t i = 0U; i < g_pendingExpiryCount; ++i) {
+        g_pendingExpiries[i]->expiry_pending = false;
+        reportExpiry(g_pendingExpiries[i], &xHigherPriorityTaskWoken);
     }
+    g_pendingExpiryCount = 0U;
 
-    for (uint32_t i = 0U; i < TICK_PROFILER_MAX_TASKS; ++i) {
-        if (g_taskTable[i].task == current) {
+    chargeRunningTask(cycleCounterGet());
 
-            /* Increment runtime counter */
-            g_taskTable[i].run_ticks++;
+    TickProfilerTaskInfo_t *record = g_runningRecord;
 
-            /* Check for quantum expiration */
-            if ((g_taskTable[i].quantum_ticks != 0U) &&
-                (g_taskTable[i].run_ticks >= g_taskTable[i].quantum_ticks))
-            {
-#if (TICK_PROFILER_EXPIRED_QUEUE_ENABLED == 1U)
-                /* Notify scheduler via queue */
-                if (g_expiredQueue != NULL) {
-                    (void)xQueueSendFromISR(
-                        g_expiredQueue,
-                        &current,
-                        &xHigherPriorityTaskWoken);
-                }
-#endif
-
-                /* Direct scheduler notification */
-                if (g_schedulerTaskHandle != NULL) {
-                    (void)vTaskNotifyGiveFromISR(
-                        g_schedulerTaskHandle,
-                        &xHigherPriorityTaskWoken);
-                }
-            }
+#if (TICK_PROFILER_BUDGET_WINDOW_ENABLED == 1U)
+    if (record != NULL) {
+        decayBudget(record);
+    }
+#endif
 
-            break;
-        }
+    /* Check for quantum expiration */
+    if ((record != NULL) && quantumExhausted(record)) {
+        reportExpiry(record, &xHigherPriorityTaskWoken);
     }
+#else
+    /* The kernel calls the hook on one core; it charges every core */
+    for (uint32_t core = 0U; core < TICK_PROFILER_CORES; core++) {
+        chargeCoreTick(core, &xHigherPriorityTaskWoken);
+    }
+#endif
+
+#if (MLFQ_CLOCK_SCALING_ENABLED == 1U)
+    /* A task above Low is waiting for the supervisor to restore the clock */
+    if (schedulerClockRestoreWanted() && (g_schedulerTaskHandle != NULL)) {
+        schedulerWakeFromISR(&xHigherPriorityTaskWoken);
+    }
+#endif
+
+#if (MLFQ_EVENT_BOOST_ENABLED == 1U)
+    /* A bound event fired; its tasks wait for the supervisor */
+    if (schedulerEventBoostPending() && (g_schedulerTaskHandle != NULL)) {
+        schedulerWakeFromISR(&xHigherPriorityTaskWoken);
+    }
+#endif
+
+#if (MLFQ_LEVEL_CALLBACKS_ENABLED == 1U)
+    /* A level change made outside the supervisor (the kernel-native
+       demotion, a task's own API call) waits for its callback */
+    if (schedulerLevelCallbackPending() && (g_schedulerTaskHandle != NULL)) {
+        schedulerWakeFromISR(&xHigherPriorityTaskWoken);
+    }
+#endif
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U)
+    /* An aging or pre-promotion timer of the supervisor is due */
+    if (timerWheelTickDue((uint32_t)xTaskGetTickCountFromISR()) && (g_schedulerTaskHandle != NULL)) {
+        schedulerWakeFromISR(&xHigherPriorityTaskWoken);
+    }
+#endif
+
+    GPIO_PROBE_LOW(GPIO_PROBE_PIN_TICK);
 
     /* Perform context switch if required */
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
+/*
+ * Description : Starts the cycle counter and stamps the start of the
+ *               boot. The PLL has locked by now, so every cycle counted
+ *               from here is at the final clock; the C startup and the
+ *               lock itself come before and are not included.
+ */
+void tickProfilerBootStart(void)
+{
+    cycleCounterInit();
+    g_bootStartCycles = cycleCounterGet();
+}
+
+/*
+ * Description : Stamps the end of the boot. What is left before the
+ *               first task runs is the kernel creating the idle task and
+ *               starting the SysTick, a few microseconds. At least one
+ *               cycle is stored, 0 meaning not booted.
+ */
+void tickProfilerBootEnd(void)
+{
+    uint32_t cycles = cycleCounterGet() - g_bootStartCycles;
+
+    g_bootCycles = (cycles != 0U) ? cycles : 1U;
+}
+
+/*
+ * Description : Returns the boot time in core cycles.
+ */
+uint32_t tickProfilerGetBootCycles(void)
+{
+    return g_bootCycles;
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
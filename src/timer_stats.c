@@ -0,0 +1,196 @@
+/******************************************************************************
+ *  MODULE NAME  : Timer Daemon Statistics
+ *  FILE         : timer_stats.c
+ *  DESCRIPTION  : Keeps one entry per callback the timer service task has
+ *                 run, found by a linear search of a small table. Only
+ *                 the timer service task writes the table, one callback at
+ *                 a time; the report copies it in a critical section.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "timer_stats.h"
+#include "cycle_counter.h"
+#include "event_trace.h"
+#include "irq_stats.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include <string.h>
+
+#if (TIMER_STATS_ENABLED == 1U)
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* One entry per callback, then the overflow entry */
+static TimerStats_t g_timers[TIMER_STATS_MAX_CALLBACKS + 1U];
+
+/* Entries in use, not counting the overflow entry */
+static uint32_t g_timerCount = 0U;
+
+/* Cycle stamp of the callback running now */
+static uint32_t g_startCycles;
+
+#if (IRQ_STATS_ENABLED == 1U)
+/* Interrupt cycles at the start of the callback running now */
+static uint32_t g_startIrqCycles;
+#endif
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Returns the entry of a callback, taking a free one the
+ *               first time it runs, or the overflow entry once all are
+ *               taken.
+ */
+static uint32_t findEntry(const void *callback, bool pended)
+{
+    uint32_t index;
+
+    for (index = 0U; index < g_timerCount; index++)
+    {
+        if (g_timers[index].callback == callback)
+        {
+            return index;
+        }
+    }
+
+    if (g_timerCount < TIMER_STATS_MAX_CALLBACKS)
+    {
+        g_timers[g_timerCount].callback = callback;
+        g_timers[g_timerCount].pended = pended;
+        g_timerCount++;
+    }
+
+    return index;
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from traceTIMER_CALLBACK_START, in the timer
+ *               service task. Callbacks never nest.
+ */
+void timerStatsStart(void)
+{
+#if (IRQ_STATS_ENABLED == 1U)
+    g_startIrqCycles = irqStatsGetCycles();
+#endif
+    g_startCycles = cycleCounterGet();
+}
+
+/*
+ * Description : Called from traceTIMER_CALLBACK_END. The service task
+ *               runs at configTIMER_TASK_PRIORITY, above the MLFQ levels,
+ *               so only interrupts can land inside a run; with
+ *               IRQ_STATS_ENABLED their time is taken back out.
+ */
+void timerStatsEnd(const void *callback, bool pended)
+{
+    uint32_t cycles = cycleCounterGet() - g_startCycles;
+    uint32_t index;
+    bool overrun = false;
+
+#if (IRQ_STATS_ENABLED == 1U)
+    uint32_t irqCycles = irqStatsGetCycles() - g_startIrqCycles;
+
+    cycles = (irqCycles < cycles) ? (cycles - irqCycles) : 0U;
+#endif
+
+    taskENTER_CRITICAL();
+    {
+        index = findEntry(callback, pended);
+        g_timers[index].runs++;
+        g_timers[index].total_cycles += cycles;
+        if (cycles > g_timers[index].max_cycles)
+        {
+            g_timers[index].max_cycles = cycles;
+        }
+#if (TIMER_STATS_ALERT_US > 0U)
+        if (cycles > (TIMER_STATS_ALERT_US * (configCPU_CLOCK_HZ / 1000000U)))
+        {
+            g_timers[index].overruns++;
+            overrun = true;
+        }
+#endif
+    }
+    taskEXIT_CRITICAL();
+
+#if (EVENT_TRACE_ENABLED == 1U)
+    if (overrun)
+    {
+        uint32_t ms = cycles / (configCPU_CLOCK_HZ / 1000U);
+
+        eventTraceRecord(EVENT_TRACE_TIMER_OVERRUN, xTimerGetTimerDaemonTaskHandle(),
+                         (uint8_t)index, (uint8_t)((ms > 255U) ? 255U : ms));
+    }
+#else
+    (void)overrun;
+#endif
+}
+
+/*
+ * Description : Insertion sort of the copy by total time; the table is
+ *               at most TIMER_STATS_MAX_CALLBACKS + 1 entries.
+ */
+uint32_t timerStatsGetTop(TimerStats_t *output, uint32_t max)
+{
+    TimerStats_t copy[TIMER_STATS_MAX_CALLBACKS + 1U];
+    uint32_t count;
+    uint32_t index;
+
+    if (output == NULL)
+    {
+        return 0U;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        count = g_timerCount;
+        memcpy(copy, g_timers, sizeof(copy));
+    }
+    taskEXIT_CRITICAL();
+
+    /* The overflow entry only runs once every other one is taken, so it
+     * follows them directly */
+    if (copy[TIMER_STATS_MAX_CALLBACKS].runs > 0U)
+    {
+        count++;
+    }
+
+    for (index = 1U; index < count; index++)
+    {
+        TimerStats_t entry = copy[index];
+        uint32_t at = index;
+
+        while ((at > 0U) && (copy[at - 1U].total_cycles < entry.total_cycles))
+        {
+            copy[at] = copy[at - 1U];
+            at--;
+        }
+        copy[at] = entry;
+    }
+
+    if (count > max)
+    {
+        count = max;
+    }
+    memcpy(output, copy, count * sizeof(TimerStats_t));
+
+    return count;
+}
+
+#endif /* TIMER_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,489 @@
+/******************************************************************************
+ *  MODULE NAME  : Timer Wheel
+ *  FILE         : timer_wheel.c
+ *  DESCRIPTION  : Hashed timer wheel of bit sets. Each bucket is a set of
+ *                 timers; a busy mask per wheel level finds the next
+ *                 non-empty bucket with one count-leading-zeros. The
+ *                 cursor is the first tick not yet expired.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "timer_wheel.h"
+#include "tick_profiler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Timers, and the words of a set of them */
+#define TIMER_WHEEL_ENTRIES     (TICK_PROFILER_MAX_TASKS * TIMER_WHEEL_KINDS)
+#define TIMER_WHEEL_WORDS       ((TIMER_WHEEL_ENTRIES + 31U) / 32U)
+
+/* Ticks of a block (one level-0 turn) and of a level-1 turn */
+#define TIMER_WHEEL_BLOCK_MASK  (TIMER_WHEEL_BUCKETS - 1UL)
+#define TIMER_WHEEL_TURN_MASK   ((TIMER_WHEEL_BUCKETS * TIMER_WHEEL_BUCKETS) - 1UL)
+
+/* Sets: the level-0 buckets, the level-1 buckets, then the timers beyond
+ * level 1 and the timers due but not yet taken */
+#define TIMER_WHEEL_SET_LEVEL1  TIMER_WHEEL_BUCKETS
+#define TIMER_WHEEL_SET_BEYOND  (2U * TIMER_WHEEL_BUCKETS)
+#define TIMER_WHEEL_SET_DUE     (TIMER_WHEEL_SET_BEYOND + 1U)
+#define TIMER_WHEEL_SETS        (TIMER_WHEEL_SET_DUE + 1U)
+
+/* g_where of a timer not armed; an armed one holds its set + 1 */
+#define TIMER_WHEEL_UNARMED     0U
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Timers in each set, and the non-empty buckets of each wheel level */
+static uint32_t g_sets[TIMER_WHEEL_SETS][TIMER_WHEEL_WORDS];
+static uint32_t g_busy[2];
+
+/* Due tick and set of each timer */
+static uint32_t g_due[TIMER_WHEEL_ENTRIES];
+static uint8_t g_where[TIMER_WHEEL_ENTRIES];
+
+/* First tick not yet expired */
+static uint32_t g_cursor = 0U;
+
+/* Tick at which the tick hook wakes the supervisor */
+static volatile uint32_t g_wakeTick = 0U;
+static volatile bool g_wakeArmed = false;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ *  All of them run with interrupts masked.
+ ******************************************************************************/
+
+/*
+ * Description : Index of the lowest set bit of a non-zero word.
+ */
+static uint32_t lowestBit(uint32_t bits)
+{
+    return 31U - (uint32_t)TICK_PROFILER_CLZ(bits & (0U - bits));
+}
+
+/*
+ * Description : True if a set holds no timer.
+ */
+static bool setEmpty(uint32_t set)
+{
+    for (uint32_t word = 0U; word < TIMER_WHEEL_WORDS; word++)
+    {
+        if (g_sets[set][word] != 0U)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Description : Earliest due tick of a non-empty set, compared relative
+ *               to the cursor so the tick counter may wrap.
+ */
+static uint32_t earliestIn(uint32_t set)
+{
+    uint32_t earliest = g_cursor + 0x7FFFFFFFUL;
+
+    for (uint32_t word = 0U; word < TIMER_WHEEL_WORDS; word++)
+    {
+        uint32_t bits = g_sets[set][word];
+
+        while (bits != 0U)
+        {
+            uint32_t bit = lowestBit(bits);
+            uint32_t due = g_due[(word * 32U) + bit];
+
+            bits &= ~(1UL << bit);
+
+            if ((int32_t)(due - earliest) < 0)
+            {
+                earliest = due;
+            }
+        }
+    }
+
+    return earliest;
+}
+
+/*
+ * Description : Removes a timer from its set, if it is in one.
+ */
+static void unlinkEntry(uint32_t entry)
+{
+    uint32_t where = g_where[entry];
+
+    if (where == TIMER_WHEEL_UNARMED)
+    {
+        return;
+    }
+
+    uint32_t set = where - 1U;
+
+    g_sets[set][entry / 32U] &= ~(1UL << (entry % 32U));
+
+    if ((set < TIMER_WHEEL_SET_BEYOND) && setEmpty(set))
+    {
+        g_busy[set / TIMER_WHEEL_BUCKETS] &= ~(1UL << (set % TIMER_WHEEL_BUCKETS));
+    }
+
+    g_where[entry] = TIMER_WHEEL_UNARMED;
+}
+
+/*
+ * Description : Puts a timer in the set its due tick falls in, seen from
+ *               the cursor: level 0 for the current block, level 1 for
+ *               the next 31, beyond after that, due if already past.
+ */
+static void linkEntry(uint32_t entry)
+{
+    uint32_t due = g_due[entry];
+    uint32_t blocks = (due >> TIMER_WHEEL_BITS) - (g_cursor >> TIMER_WHEEL_BITS);
+    uint32_t set;
+
+    if ((int32_t)(due - g_cursor) < 0)
+    {
+        set = TIMER_WHEEL_SET_DUE;
+    }
+    else if (blocks == 0U)
+    {
+        set = due & TIMER_WHEEL_BLOCK_MASK;
+        g_busy[0] |= 1UL << set;
+    }
+    else if (blocks < TIMER_WHEEL_BUCKETS)
+    {
+        uint32_t bucket = (due >> TIMER_WHEEL_BITS) & TIMER_WHEEL_BLOCK_MASK;
+
+        set = TIMER_WHEEL_SET_LEVEL1 + bucket;
+        g_busy[1] |= 1UL << bucket;
+    }
+    else
+    {
+        set = TIMER_WHEEL_SET_BEYOND;
+    }
+
+    g_sets[set][entry / 32U] |= 1UL << (entry % 32U);
+    g_where[entry] = (uint8_t)(set + 1U);
+}
+
+/*
+ * Description : Empties a set and places each of its timers again.
+ */
+static void relinkSet(uint32_t set)
+{
+    for (uint32_t word = 0U; word < TIMER_WHEEL_WORDS; word++)
+    {
+        uint32_t bits = g_sets[set][word];
+
+        g_sets[set][word] = 0U;
+
+        while (bits != 0U)
+        {
+            uint32_t bit = lowestBit(bits);
+
+            bits &= ~(1UL << bit);
+            linkEntry((word * 32U) + bit);
+        }
+    }
+}
+
+/*
+ * Description : Moves a level-0 bucket, whose tick has come, to the due
+ *               set.
+ */
+static void expireBucket(uint32_t bucket)
+{
+    for (uint32_t word = 0U; word < TIMER_WHEEL_WORDS; word++)
+    {
+        uint32_t bits = g_sets[bucket][word];
+
+        g_sets[TIMER_WHEEL_SET_DUE][word] |= bits;
+        g_sets[bucket][word] = 0U;
+
+        while (bits != 0U)
+        {
+            uint32_t bit = lowestBit(bits);
+
+            bits &= ~(1UL << bit);
+            g_where[(word * 32U) + bit] = (uint8_t)(TIMER_WHEEL_SET_DUE + 1U);
+        }
+    }
+
+    g_busy[0] &= ~(1UL << bucket);
+}
+
+/*
+ * Description : Moves the cursor. Entering a block cascades its level-1
+ *               bucket into level 0; entering a level-1 turn first
+ *               places the timers beyond level 1 again, some of which
+ *               are now within it.
+ */
+static void setCursor(uint32_t tick)
+{
+    g_cursor = tick;
+
+    if ((tick & TIMER_WHEEL_BLOCK_MASK) != 0U)
+    {
+        return;
+    }
+
+    if ((tick & TIMER_WHEEL_TURN_MASK) == 0U)
+    {
+        relinkSet(TIMER_WHEEL_SET_BEYOND);
+    }
+
+    uint32_t bucket = (tick >> TIMER_WHEEL_BITS) & TIMER_WHEEL_BLOCK_MASK;
+
+    if ((g_busy[1] & (1UL << bucket)) != 0U)
+    {
+        g_busy[1] &= ~(1UL << bucket);
+        relinkSet(TIMER_WHEEL_SET_LEVEL1 + bucket);
+    }
+}
+
+/*
+ * Description : One step of the cursor towards a tick: to just past the
+ *               next busy level-0 bucket, expiring it, else to the next
+ *               block, else (both levels empty) to the next level-1 turn.
+ *               Never past the tick itself. True while it is not reached.
+ */
+static bool advanceStep(uint32_t nowTick)
+{
+    if ((int32_t)(nowTick - g_cursor) < 0)
+    {
+        return false;
+    }
+
+    uint32_t index = g_cursor & TIMER_WHEEL_BLOCK_MASK;
+    uint32_t block = g_cursor - index;
+    uint32_t pending = g_busy[0] & (0xFFFFFFFFUL << index);
+    uint32_t next;
+
+    if (pending != 0U)
+    {
+        uint32_t bucket = lowestBit(pending);
+
+        if ((int32_t)(nowTick - (block + bucket)) >= 0)
+        {
+            expireBucket(bucket);
+        }
+        next = block + bucket + 1U;
+    }
+    else if (g_busy[1] != 0U)
+    {
+        next = block + TIMER_WHEEL_BUCKETS;
+    }
+    else
+    {
+        next = (g_cursor | TIMER_WHEEL_TURN_MASK) + 1U;
+    }
+
+    if ((int32_t)(nowTick - next) < 0)
+    {
+        next = nowTick + 1U;
+    }
+
+    setCursor(next);
+
+    return ((int32_t)(nowTick - next) >= 0);
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Runs from the kernel's switch hook as well as the
+ *               supervisor, hence the ISR-safe critical section. Also
+ *               brings the tick hook's wake point forward.
+ */
+void timerWheelArm(uint32_t entry, uint32_t dueTick)
+{
+    if (entry >= TIMER_WHEEL_ENTRIES)
+    {
+        return;
+    }
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        unlinkEntry(entry);
+        g_due[entry] = dueTick;
+        linkEntry(entry);
+
+        if (!g_wakeArmed || ((int32_t)(dueTick - g_wakeTick) < 0))
+        {
+            g_wakeTick  = dueTick;
+            g_wakeArmed = true;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/*
+ * Description : The wake point is left alone; at worst it costs one
+ *               early pass that finds nothing due.
+ */
+void timerWheelCancel(uint32_t entry)
+{
+    if (entry >= TIMER_WHEEL_ENTRIES)
+    {
+        return;
+    }
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        unlinkEntry(entry);
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/*
+ * Description : The cursor advances one step per critical section, so a
+ *               long sleep of the supervisor does not hold interrupts
+ *               off; a step is at most a cascade of one bucket.
+ */
+uint32_t timerWheelTakeDue(uint32_t nowTick)
+{
+    uint32_t entry = TIMER_WHEEL_NONE;
+    bool more = true;
+
+    while (more)
+    {
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        {
+            more = advanceStep(nowTick);
+        }
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+    }
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        for (uint32_t word = 0U; word < TIMER_WHEEL_WORDS; word++)
+        {
+            uint32_t bits = g_sets[TIMER_WHEEL_SET_DUE][word];
+
+            if (bits != 0U)
+            {
+                uint32_t bit = lowestBit(bits);
+
+                entry = (word * 32U) + bit;
+                g_sets[TIMER_WHEEL_SET_DUE][word] &= ~(1UL << bit);
+                g_where[entry] = TIMER_WHEEL_UNARMED;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return entry;
+}
+
+/*
+ * Description : The earliest timer is in the first non-empty of: the
+ *               due set, the rest of the current block, the next busy
+ *               level-1 bucket, the timers beyond. A timer beyond was
+ *               placed from an older cursor and may still come before
+ *               the level-1 bucket, so both are searched then.
+ */
+uint32_t timerWheelTicksToNext(uint32_t nowTick, uint32_t limit)
+{
+    uint32_t ticks = limit;
+
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    {
+        uint32_t index = g_cursor & TIMER_WHEEL_BLOCK_MASK;
+        uint32_t pending = g_busy[0] & (0xFFFFFFFFUL << index);
+        uint32_t cursorBlock = g_cursor >> TIMER_WHEEL_BITS;
+        uint32_t shift = (cursorBlock + 1U) & TIMER_WHEEL_BLOCK_MASK;
+        uint32_t wake;
+
+        /* Level-1 buckets in block order from the next block on */
+        uint32_t ahead = (shift == 0U) ? g_busy[1] :
+                         ((g_busy[1] >> shift) | (g_busy[1] << (32U - shift)));
+
+        g_wakeArmed = true;
+
+        if (!setEmpty(TIMER_WHEEL_SET_DUE))
+        {
+            wake = nowTick;
+        }
+        else if (pending != 0U)
+        {
+            wake = (g_cursor - index) + lowestBit(pending);
+        }
+        else if (ahead != 0U)
+        {
+            wake = earliestIn(TIMER_WHEEL_SET_LEVEL1 +
+                              ((cursorBlock + 1U + lowestBit(ahead)) & TIMER_WHEEL_BLOCK_MASK));
+
+            if (!setEmpty(TIMER_WHEEL_SET_BEYOND))
+            {
+                uint32_t beyond = earliestIn(TIMER_WHEEL_SET_BEYOND);
+
+                if ((int32_t)(beyond - wake) < 0)
+                {
+                    wake = beyond;
+                }
+            }
+        }
+        else if (!setEmpty(TIMER_WHEEL_SET_BEYOND))
+        {
+            wake = earliestIn(TIMER_WHEEL_SET_BEYOND);
+        }
+        else
+        {
+            g_wakeArmed = false;
+            wake = nowTick;
+        }
+
+        if (g_wakeArmed)
+        {
+            g_wakeTick = wake;
+
+            if ((int32_t)(wake - nowTick) <= 0)
+            {
+                ticks = 0U;
+            }
+            else if ((wake - nowTick) < limit)
+            {
+                ticks = wake - nowTick;
+            }
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    return ticks;
+}
+
+/*
+ * Description : Disarms the wake point as it reports it; the pass it
+ *               starts sets the next one.
+ */
+bool timerWheelTickDue(uint32_t tick)
+{
+    if (g_wakeArmed && ((int32_t)(tick - g_wakeTick) >= 0))
+    {
+        g_wakeArmed = false;
+        return true;
+    }
+
+    return false;
+}
+
+#endif /* MLFQ_TIMER_WHEEL_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
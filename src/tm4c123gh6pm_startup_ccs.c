@@ -23,6 +23,7 @@
 //*****************************************************************************
 
 #include <stdint.h>
+#include "flight_recorder.h"
 
 //*****************************************************************************
 //
@@ -44,6 +45,14 @@ extern void _c_int00(void);
 extern void vPortSVCHandler(void);
 extern void xPortPendSVHandler(void);
 extern void xPortSysTickHandler(void);
+
+// The tick, timed by irq_stats.c when built with IRQ_STATS_TICK_ENABLED
+#if defined(IRQ_STATS_TICK_ENABLED) && (IRQ_STATS_TICK_ENABLED == 1U)
+extern void SysTickIntHandler(void);
+#define SYSTICK_HANDLER SysTickIntHandler
+#else
+#define SYSTICK_HANDLER xPortSysTickHandler
+#endif
 //*****************************************************************************
 //
 // Linker variable that marks the top of the stack.
@@ -57,6 +66,15 @@ extern uint32_t __STACK_TOP;
 //
 //*****************************************************************************
 // To be added by user
+extern void QuantumTimerIntHandler(void);
+extern void UART0IntHandler(void);
+extern void LatencyTimerIntHandler(void);
+extern void UART1IntHandler(void);
+extern void GPIOFIntHandler(void);
+extern void RunTimeTimerIntHandler(void);
+extern void WatchdogIntHandler(void);
+extern void uDMASoftwareIntHandler(void);
+extern void ADC0SS3IntHandler(void);
 
 //*****************************************************************************
 //
@@ -84,14 +102,14 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // Debug monitor handler
     0,                                      // Reserved
     xPortPendSVHandler,                      // The PendSV handler
-    xPortSysTickHandler,                      // The SysTick handler
+    SYSTICK_HANDLER,                        // The SysTick handler
     IntDefaultHandler,                      // GPIO Port A
     IntDefaultHandler,                      // GPIO Port B
     IntDefaultHandler,                      // GPIO Port C
     IntDefaultHandler,                      // GPIO Port D
     IntDefaultHandler,                      // GPIO Port E
-    IntDefaultHandler,                      // UART0 Rx and Tx
-    IntDefaultHandler,                      // UART1 Rx and Tx
+    UART0IntHandler,                        // UART0 Rx and Tx
+    UART1IntHandler,                        // UART1 Rx and Tx
     IntDefaultHandler,                      // SSI0 Rx and Tx
     IntDefaultHandler,                      // I2C0 Master and Slave
     IntDefaultHandler,                      // PWM Fault
@@ -102,20 +120,20 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // ADC Sequence 0
     IntDefaultHandler,                      // ADC Sequence 1
     IntDefaultHandler,                      // ADC Sequence 2
-    IntDefaultHandler,                      // ADC Sequence 3
-    IntDefaultHandler,                      // Watchdog timer
-    IntDefaultHandler,                      // Timer 0 subtimer A
+    ADC0SS3IntHandler,                      // ADC Sequence 3
+    WatchdogIntHandler,                     // Watchdog timer
+    QuantumTimerIntHandler,                 // Timer 0 subtimer A
     IntDefaultHandler,                      // Timer 0 subtimer B
-    IntDefaultHandler,                      // Timer 1 subtimer A
+    LatencyTimerIntHandler,                 // Timer 1 subtimer A
     IntDefaultHandler,                      // Timer 1 subtimer B
-    IntDefaultHandler,                      // Timer 2 subtimer A
+    RunTimeTimerIntHandler,                 // Timer 2 subtimer A
     IntDefaultHandler,                      // Timer 2 subtimer B
     IntDefaultHandler,                      // Analog Comparator 0
     IntDefaultHandler,                      // Analog Comparator 1
     IntDefaultHandler,                      // Analog Comparator 2
     IntDefaultHandler,                      // System Control (PLL, OSC, BO)
     IntDefaultHandler,                      // FLASH Control
-    IntDefaultHandler,                      // GPIO Port F
+    GPIOFIntHandler,                        // GPIO Port F
     IntDefaultHandler,                      // GPIO Port G
     IntDefaultHandler,                      // GPIO Port H
     IntDefaultHandler,                      // UART2 Rx and Tx
@@ -131,7 +149,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // Hibernate
     IntDefaultHandler,                      // USB0
     IntDefaultHandler,                      // PWM Generator 3
-    IntDefaultHandler,                      // uDMA Software Transfer
+    uDMASoftwareIntHandler,                 // uDMA Software Transfer
     IntDefaultHandler,                      // uDMA Error
     IntDefaultHandler,                      // ADC1 Sequence 0
     IntDefaultHandler,                      // ADC1 Sequence 1
@@ -250,13 +268,17 @@ ResetISR(void)
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives a NMI.  This
-// simply enters an infinite loop, preserving the system state for examination
-// by a debugger.
+// seals the flight recorder and enters an infinite loop, preserving the system
+// state for examination by a debugger.
 //
 //*****************************************************************************
 static void
 NmiSR(void)
 {
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    flightRecorderSeal(FLIGHT_RECORDER_CAUSE_NMI);
+#endif
+
     //
     // Enter an infinite loop.
     //
@@ -268,13 +290,17 @@ NmiSR(void)
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives a fault
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  This seals the flight recorder and enters an infinite loop,
+// preserving the system state for examination by a debugger.
 //
 //*****************************************************************************
 static void
 FaultISR(void)
 {
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    flightRecorderSeal(FLIGHT_RECORDER_CAUSE_FAULT);
+#endif
+
     //
     // Enter an infinite loop.
     //
@@ -286,13 +312,18 @@ FaultISR(void)
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives an unexpected
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  This seals the flight recorder, which notes the exception
+// number, and enters an infinite loop, preserving the system state for
+// examination by a debugger.
 //
 //*****************************************************************************
 static void
 IntDefaultHandler(void)
 {
+#if (FLIGHT_RECORDER_ENABLED == 1U)
+    flightRecorderSeal(FLIGHT_RECORDER_CAUSE_UNHANDLED);
+#endif
+
     //
     // Go into an infinite loop.
     //
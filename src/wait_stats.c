@@ -0,0 +1,202 @@
+/******************************************************************************
+ *  MODULE NAME  : Blocking Wait Statistics
+ *  FILE         : wait_stats.c
+ *  DESCRIPTION  : Keeps, per registered task and queue object, the number
+ *                 of times the task blocked on it and the total and worst
+ *                 time until it was ready again.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "wait_stats.h"
+#include "cycle_counter.h"
+#include "tick_profiler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if (WAIT_STATS_ENABLED == 1U)
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* No wait in progress */
+#define WAIT_STATS_NONE     0xFFU
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Task and object pairs; an entry is free while its object is NULL */
+static WaitStatsEntry_t g_entries[WAIT_STATS_MAX_ENTRIES];
+static uint32_t g_dropped = 0U;
+
+/* Wait in progress per profiler slot: its entry and when it began.
+ * Set to WAIT_STATS_NONE by waitStatsResetTask() at registration */
+static uint8_t g_pending[TICK_PROFILER_MAX_TASKS];
+static uint32_t g_startCycles[TICK_PROFILER_MAX_TASKS];
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Returns the entry of a pair, taking a free one for a new
+ *               pair, or WAIT_STATS_NONE if the table is full. Must be
+ *               called with interrupts masked.
+ */
+static uint8_t findEntry(uint32_t slot, const void *object, uint32_t direction)
+{
+    uint8_t freeEntry = WAIT_STATS_NONE;
+
+    for (uint32_t i = 0U; i < WAIT_STATS_MAX_ENTRIES; i++)
+    {
+        if (g_entries[i].object == NULL)
+        {
+            if (freeEntry == WAIT_STATS_NONE)
+            {
+                freeEntry = (uint8_t)i;
+            }
+        }
+        else if ((g_entries[i].object == object) && (g_entries[i].slot == slot) &&
+                 (g_entries[i].direction == direction))
+        {
+            return (uint8_t)i;
+        }
+    }
+
+    if (freeEntry != WAIT_STATS_NONE)
+    {
+        memset(&g_entries[freeEntry], 0, sizeof(g_entries[freeEntry]));
+        g_entries[freeEntry].object    = object;
+        g_entries[freeEntry].slot      = (uint8_t)slot;
+        g_entries[freeEntry].direction = (uint8_t)direction;
+    }
+
+    return freeEntry;
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from the traceBLOCKING_ON_QUEUE_* hooks in
+ *               queue.c, in the blocking task with the scheduler
+ *               suspended; an interrupt may still end another task's
+ *               wait, so the table is changed with interrupts masked.
+ */
+void waitStatsBlocking(const void *object, uint32_t direction)
+{
+    int32_t slot = tickProfilerGetSlot(xTaskGetCurrentTaskHandle());
+
+    if (slot < 0)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        g_pending[slot] = findEntry((uint32_t)slot, object, direction);
+        if (g_pending[slot] == WAIT_STATS_NONE)
+        {
+            g_dropped++;
+        }
+        g_startCycles[slot] = cycleCounterGet();
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Called from traceMOVED_TASK_TO_READY_STATE, in the tick
+ *               interrupt, an ISR or a kernel critical section. Priority
+ *               changes also move tasks between ready lists; only the
+ *               first move after a block ends a wait.
+ */
+void waitStatsTaskReady(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+    WaitStatsEntry_t *entry;
+
+    if ((slot < 0) || (g_pending[slot] == WAIT_STATS_NONE))
+    {
+        return;
+    }
+
+    uint32_t cycles = cycleCounterGet() - g_startCycles[slot];
+
+    entry = &g_entries[g_pending[slot]];
+    g_pending[slot] = WAIT_STATS_NONE;
+
+    entry->waits++;
+    entry->total_cycles += cycles;
+    if (cycles > entry->max_cycles)
+    {
+        entry->max_cycles = cycles;
+    }
+}
+
+/*
+ * Description : Takes a consistent copy of one entry.
+ */
+bool waitStatsGetEntry(uint32_t index, WaitStatsEntry_t *output)
+{
+    bool used;
+
+    if ((index >= WAIT_STATS_MAX_ENTRIES) || (output == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        *output = g_entries[index];
+        used = (output->object != NULL);
+    }
+    taskEXIT_CRITICAL();
+
+    return used;
+}
+
+/*
+ * Description : Returns the blocks that found the table full.
+ */
+uint32_t waitStatsGetDropped(void)
+{
+    return g_dropped;
+}
+
+/*
+ * Description : Frees the entries of a profiler slot and drops its wait
+ *               in progress, so a new task in the slot starts clean.
+ */
+void waitStatsResetTask(uint32_t slot)
+{
+    if (slot >= TICK_PROFILER_MAX_TASKS)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        for (uint32_t i = 0U; i < WAIT_STATS_MAX_ENTRIES; i++)
+        {
+            if ((g_entries[i].object != NULL) && (g_entries[i].slot == slot))
+            {
+                g_entries[i].object = NULL;
+            }
+        }
+        g_pending[slot] = WAIT_STATS_NONE;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* WAIT_STATS_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,161 @@
+/******************************************************************************
+ *  MODULE NAME  : Wake Period Detection
+ *  FILE         : wake_period.c
+ *  DESCRIPTION  : Stamps the tick at which a registered task that blocked
+ *                 is made ready again and compares each interval between
+ *                 wakes with the period learnt so far. The supervisor
+ *                 reads the next expected wake.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include "wake_period.h"
+#include "tick_profiler.h"
+#include "timer_wheel.h"
+#include "scheduler.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (MLFQ_PREPROMOTE_ENABLED == 1U)
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Tick of the last wake, the period learnt and the intervals in a row
+ * that matched it, per profiler slot */
+static volatile uint32_t g_lastWake[TICK_PROFILER_MAX_TASKS];
+static volatile uint32_t g_period[TICK_PROFILER_MAX_TASKS];
+static volatile uint8_t g_matches[TICK_PROFILER_MAX_TASKS];
+
+/* Blocked since its last switch-out, and woken at least once */
+static volatile bool g_blocked[TICK_PROFILER_MAX_TASKS];
+static volatile bool g_seen[TICK_PROFILER_MAX_TASKS];
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Called from traceTASK_SWITCHED_OUT. Only a task that left
+ *               the ready list can wake later; a preempted one cannot.
+ *               With the timer wheel, a task that blocks below High with
+ *               a trusted period arms its pre-promotion here.
+ */
+void wakePeriodTaskSwitchedOut(void *task, bool stillReady)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if (slot >= 0)
+    {
+        g_blocked[slot] = !stillReady;
+
+#if (MLFQ_TIMER_WHEEL_ENABLED == 1U)
+        TickProfilerTaskInfo_t *record = tickProfilerGetRecord((uint32_t)slot);
+
+        if (!stillReady && (g_matches[slot] >= MLFQ_PREPROMOTE_CONFIRM) &&
+            (record != NULL) && (record->level != (uint8_t)MLFQ_QUEUE_HIGH))
+        {
+            timerWheelArm(TIMER_WHEEL_ENTRY(slot, TIMER_WHEEL_PREPROMOTE),
+                          g_lastWake[slot] + g_period[slot] - MLFQ_PREPROMOTE_LEAD_TICKS);
+        }
+#endif
+    }
+}
+
+/*
+ * Description : Called from traceMOVED_TASK_TO_READY_STATE, in the tick
+ *               interrupt or a kernel critical section. Priority changes
+ *               also move tasks between ready lists; only the first move
+ *               after a block is a wake.
+ */
+void wakePeriodTaskReady(void *task)
+{
+    int32_t slot = tickProfilerGetSlot((TaskHandle_t)task);
+
+    if ((slot < 0) || !g_blocked[slot])
+    {
+        return;
+    }
+
+    uint32_t now = (uint32_t)xTaskGetTickCountFromISR();
+    uint32_t interval = now - g_lastWake[slot];
+    uint32_t period = g_period[slot];
+    uint32_t jitter = (period * MLFQ_PREPROMOTE_JITTER_PERCENT) / 100U;
+
+    g_blocked[slot] = false;
+
+    if (jitter == 0U)
+    {
+        jitter = 1U;
+    }
+
+    if (g_seen[slot] && (period >= MLFQ_PREPROMOTE_MIN_PERIOD_TICKS) &&
+        (interval + jitter >= period) && (interval <= period + jitter))
+    {
+        if (g_matches[slot] < MLFQ_PREPROMOTE_CONFIRM)
+        {
+            g_matches[slot]++;
+        }
+    }
+    else
+    {
+        /* A new candidate period; the first interval only sets it */
+        g_period[slot]  = g_seen[slot] ? interval : 0U;
+        g_matches[slot] = 0U;
+    }
+
+    g_lastWake[slot] = now;
+    g_seen[slot]     = true;
+}
+
+/*
+ * Description : Reads the state of a slot under a critical section so
+ *               the stamp, the period and the flags belong together.
+ */
+bool wakePeriodGetNextWake(uint32_t slot, uint32_t *wakeTick, uint32_t *period)
+{
+    bool trusted;
+
+    if ((slot >= TICK_PROFILER_MAX_TASKS) || (wakeTick == NULL) || (period == NULL))
+    {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        trusted   = g_blocked[slot] && (g_matches[slot] >= MLFQ_PREPROMOTE_CONFIRM);
+        *wakeTick = g_lastWake[slot] + g_period[slot];
+        *period   = g_period[slot];
+    }
+    taskEXIT_CRITICAL();
+
+    return trusted;
+}
+
+/*
+ * Description : Clears the period of a profiler slot.
+ */
+void wakePeriodResetTask(uint32_t slot)
+{
+    if (slot < TICK_PROFILER_MAX_TASKS)
+    {
+        taskENTER_CRITICAL();
+        {
+            g_blocked[slot] = false;
+            g_seen[slot]    = false;
+            g_matches[slot] = 0U;
+            g_period[slot]  = 0U;
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+
+#endif /* MLFQ_PREPROMOTE_ENABLED */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -2,7 +2,9 @@
  *  MODULE NAME  : Workload Tasks
  *  FILE         : workloads.c
  *  DESCRIPTION  : Implements simulated workloads used to test scheduler
- *                 behavior, including interactive and CPU-heavy tasks.
+ *                 behavior, including interactive and CPU-heavy tasks, a
+ *                 descriptor-driven generator for mixed workloads and DSP
+ *                 kernels for throughput benchmarking.
  *  AUTHOR       : Ahmed Alaa
  *  Date         : December 2025
  ******************************************************************************/
@@ -16,23 +18,767 @@
 /* FreeRTOS task management */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "queue.h"
 
+/* Cycle counter used to calibrate the busy loop */
+#include "cycle_counter.h"
+
+/* Burst-ending yield of the batch generators */
+#include "scheduler.h"
+
+/* Echo UART of the I/O-bound workload, uDMA of the copy benchmark, ADC
+ * of the sampling pipeline */
+#include "drivers.h"
+
+/* Crc32() of the CRC benchmark */
+#include "TivaWare/driverlib/sw_crc.h"
 
 /* Standard integer types */
 #include <stdint.h>
 
+/* memcpy() of the CPU copy benchmark */
+#include <string.h>
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+/* Iterations timed by the calibration */
+#define WORKLOAD_CALIBRATION_LOOPS   4096U
+
+/* Fixed-point scale of the calibrated loop cost */
+#define WORKLOAD_LOOP_SCALE          1024U
+
+/* Dual 16-bit multiplies of the Cortex-M4 DSP extension on packed
+ * (low, high) halfwords: SMUSD gives lo * lo - hi * hi and SMUADX
+ * lo * hi + hi * lo. The host simulator gets plain C versions */
+#if defined(MLFQ_HOST_SIM)
+#define WORKLOAD_SMUSD(x, y)         dualMulSub((x), (y))
+#define WORKLOAD_SMUADX(x, y)        dualMulAddCross((x), (y))
+#else
+#define WORKLOAD_SMUSD(x, y)         _smusd((int32_t)(x), (int32_t)(y))
+#define WORKLOAD_SMUADX(x, y)        _smuadx((int32_t)(x), (int32_t)(y))
+#endif
+
+/* Largest Q15 value, and the butterflies of one FFT stage */
+#define WORKLOAD_Q15_ONE             32767
+#define WORKLOAD_FFT_HALF            (WORKLOAD_FFT_POINTS / 2U)
+
+/* Seed of the DSP input signals */
+#define WORKLOAD_DSP_SEED            0x2545F491U
+
+/* Smoothing of the ADC handler's low-pass filter: each sample moves the
+ * output 1/2^shift of the way towards it */
+#define WORKLOAD_ADC_FILTER_SHIFT    3U
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/* One half-buffer reduced by the ADC handler, on its way to aggregation */
+typedef struct
+{
+    uint32_t stamp;          /* Cycle count the half filled at */
+    uint16_t mean;           /* Of the filtered samples */
+    uint16_t min;            /* Of the raw samples */
+    uint16_t max;
+} WorkloadAdcResult_t;
+
+/* One item on its way down the queue pipeline */
+typedef struct
+{
+    uint32_t made;           /* Cycle count stage 0 made it at */
+    uint32_t queued;         /* Cycle count it was offered to the current queue */
+} WorkloadPipelineItem_t;
+
+/******************************************************************************
+ *  GLOBAL VARIABLES
+ ******************************************************************************/
+volatile uint32_t g_cpu_work_counter = 0U;
+volatile uint32_t g_interactive_work_counter = 0U;
+
+/* Short, regular bursts on a fixed period */
+const WorkloadDescriptor_t g_workloadPeriodicSensor =
+{
+    "Sensor", 1U,
+    {
+        { 200U, 50U, 10U, 10U, 0U },
+    },
+};
+
+/* Packet storms of short bursts, then quiet spells */
+const WorkloadDescriptor_t g_workloadBurstyNetwork =
+{
+    "Network", 2U,
+    {
+        { 500U, 1500U, 1U,  5U,   2000U },
+        { 100U, 0U,    50U, 200U, 3000U },
+    },
+};
+
+/* Long CPU-bound chunks that only yield between them, each ending a burst */
+const WorkloadDescriptor_t g_workloadBackgroundCompression =
+{
+    "Compress", 1U,
+    {
+        { 500000U, 0U, 0U, 0U, 0U },
+    },
+};
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+/* Core cycles per WORKLOAD_LOOP_SCALE busy-loop iterations, 0 = not measured */
+static uint32_t g_cyclesPerScaledLoops = 0U;
+
+/* Per-task work counters, claimed in order and never released */
+static WorkloadCounter_t g_counters[WORKLOAD_MAX_COUNTERS];
+static volatile uint32_t g_counterCount = 0U;
+
+/* Echo timing, written by the echo task and taken by the monitor */
+static WorkloadEchoStats_t g_echoStats = { 0U, UINT32_MAX, 0U, 0U };
+
+/* Told of every request the interactive tasks answer, NULL = nobody */
+static volatile WorkloadResponseHook_t g_responseHook = NULL;
+
+/* FIR filter: taps, the last WORKLOAD_FIR_TAPS - 1 inputs followed by
+ * the new block, and the filtered block */
+static float g_firTaps[WORKLOAD_FIR_TAPS];
+static float g_firState[WORKLOAD_FIR_TAPS - 1U + WORKLOAD_FIR_BLOCK];
+static float g_firOutput[WORKLOAD_FIR_BLOCK];
+
+/* FFT: twiddle factors and data, each a packed (real, imaginary) Q15
+ * pair with the real part in the low halfword */
+static uint32_t g_fftTwiddle[WORKLOAD_FFT_HALF];
+static uint32_t g_fftData[WORKLOAD_FFT_POINTS];
+
+/* CRC input */
+static uint8_t g_crcData[WORKLOAD_CRC_BYTES];
+
+/* Results of the DSP kernels end up here, so no kernel is optimised away */
+static volatile uint32_t g_dspSink = 0U;
+
+/* ADC pipeline: both halves of the sample buffer, the handler's filter
+ * output (scaled by 2^WORKLOAD_ADC_FILTER_SHIFT), the queue to the
+ * aggregate task, its timing, and the driver's overrun count when the
+ * timing was last taken */
+static uint16_t g_adcSamples[2U * WORKLOAD_ADC_BATCH];
+static uint32_t g_adcFilter = 0U;
+static QueueHandle_t g_adcQueue = NULL;
+static WorkloadAdcStats_t g_adcStats =
+{
+    { { 0U, UINT32_MAX, 0U, 0U }, { 0U, UINT32_MAX, 0U, 0U } }, 0U, 0U
+};
+static uint32_t g_adcOverrunsTaken = 0U;
+
+/* Queue pipeline: the CPU time of each stage per item, the queue into
+ * every stage after the first, the work counter names, and the figures */
+static const uint32_t g_pipelineCostUs[WORKLOAD_PIPELINE_STAGES] = WORKLOAD_PIPELINE_COSTS_US;
+static QueueHandle_t g_pipelineQueues[WORKLOAD_PIPELINE_STAGES - 1U];
+static const char *const g_pipelineNames[8] =
+{
+    "Pipe0", "Pipe1", "Pipe2", "Pipe3", "Pipe4", "Pipe5", "Pipe6", "Pipe7"
+};
+static WorkloadPipelineStats_t g_pipelineStats;
+
+/* Copy benchmark: one source, and a destination for each variant */
+static uint32_t g_copySource[WORKLOAD_COPY_BYTES / 4U];
+static uint32_t g_copyCpuDestination[WORKLOAD_COPY_BYTES / 4U];
+static uint32_t g_copyDmaDestination[WORKLOAD_COPY_BYTES / 4U];
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : The busy loop every burst is made of.
+ */
+static void spin(uint32_t loops)
+{
+    volatile uint32_t mathCalculation = 0U;
+
+    for (uint32_t i = 0U; i < loops; i++)
+    {
+        mathCalculation++;
+    }
+}
+
+/*
+ * Description : Returns the next value of a per-task xorshift32 stream.
+ */
+static uint32_t nextRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+#if defined(MLFQ_HOST_SIM)
+/*
+ * Description : C version of SMUSD: product of the low halfwords minus
+ *               product of the high halfwords.
+ */
+static int32_t dualMulSub(uint32_t x, uint32_t y)
+{
+    return ((int32_t)(int16_t)x * (int16_t)y) -
+           ((int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16));
+}
+
+/*
+ * Description : C version of SMUADX: the halfwords multiplied crosswise
+ *               and added.
+ */
+static int32_t dualMulAddCross(uint32_t x, uint32_t y)
+{
+    return ((int32_t)(int16_t)x * (int16_t)(y >> 16)) +
+           ((int32_t)(int16_t)(x >> 16) * (int16_t)y);
+}
+#endif
+
+/*
+ * Description : Packs a Q15 complex value, real part in the low halfword.
+ */
+static uint32_t packQ15(int32_t real, int32_t imaginary)
+{
+    return ((uint32_t)(uint16_t)real) | ((uint32_t)(uint16_t)imaginary << 16);
+}
+
+/*
+ * Description : Converts a value in -1..1 to Q15, saturating at +1.
+ */
+static int32_t toQ15(double value)
+{
+    int32_t q = (int32_t)(value * 32768.0);
+
+    return (q > WORKLOAD_Q15_ONE) ? WORKLOAD_Q15_ONE : q;
+}
+
+/*
+ * Description : Counts a burst of a generator task in whole work units,
+ *               carrying the remainder over to the next burst.
+ */
+static void countBurst(WorkloadTask_t *task, uint32_t *carryUs, uint32_t burstUs)
+{
+    *carryUs += burstUs;
+    workloadCountWork(task->counter, *carryUs / WORKLOAD_WORK_UNIT_US);
+    *carryUs %= WORKLOAD_WORK_UNIT_US;
+}
+
+/*
+ * Description : Sleeps for the given time; 0 ms only yields, closing the
+ *               burst as if the task had blocked.
+ */
+static void sleepMs(uint32_t milliseconds)
+{
+    if (milliseconds == 0U)
+    {
+        schedulerYieldBurst();
+        return;
+    }
+
+    TickType_t ticks = pdMS_TO_TICKS(milliseconds);
+    vTaskDelay((ticks == 0U) ? 1U : ticks);
+}
+
+/*
+ * Description : Replays recorded steps forever. Only the tick rounding of
+ *               the block times differs from the capture; phase counts
+ *               the completed passes over the recording.
+ */
+static void runReplay(WorkloadTask_t *task)
+{
+    const WorkloadReplay_t *replay = task->replay;
+    const uint32_t tickUs = 1000000U / configTICK_RATE_HZ;
+    uint32_t carryUs = 0U;
+
+    configASSERT(replay->step_count > 0U);
+
+    task->phase = 0U;
+
+    for (;;)
+    {
+        for (uint32_t step = 0U; step < replay->step_count; step++)
+        {
+            const WorkloadStep_t *current = &replay->steps[step];
+
+            if (current->burst_us != 0U)
+            {
+                runBurst(current->burst_us);
+            }
+            task->bursts++;
+            countBurst(task, &carryUs, current->burst_us);
+
+            TickType_t ticks = (TickType_t)((current->block_us + (tickUs / 2U)) / tickUs);
+            /* A block shorter than half a tick still ends the burst */
+            if (ticks == 0U)
+            {
+                schedulerYieldBurst();
+            }
+            else
+            {
+                vTaskDelay(ticks);
+            }
+        }
+
+        task->phase++;
+    }
+}
+
+/*
+ * Description : Sets the FIR taps to a normalised triangle, a plain
+ *               low-pass, and clears the filter history.
+ */
+static void initFir(void)
+{
+    float sum = 0.0f;
+
+    for (uint32_t k = 0U; k < WORKLOAD_FIR_TAPS; k++)
+    {
+        uint32_t rank = ((k + 1U) < (WORKLOAD_FIR_TAPS - k)) ? (k + 1U) : (WORKLOAD_FIR_TAPS - k);
+
+        g_firTaps[k] = (float)rank;
+        sum += g_firTaps[k];
+    }
+    for (uint32_t k = 0U; k < WORKLOAD_FIR_TAPS; k++)
+    {
+        g_firTaps[k] /= sum;
+    }
+    for (uint32_t i = 0U; i < (WORKLOAD_FIR_TAPS - 1U); i++)
+    {
+        g_firState[i] = 0.0f;
+    }
+}
+
+/*
+ * Description : Filters one block of white noise in -1..1, then keeps
+ *               the last WORKLOAD_FIR_TAPS - 1 inputs for the next block.
+ */
+static void firBlock(uint32_t *seed)
+{
+    float *input = &g_firState[WORKLOAD_FIR_TAPS - 1U];
+
+    for (uint32_t n = 0U; n < WORKLOAD_FIR_BLOCK; n++)
+    {
+        input[n] = ((float)(nextRandom(seed) >> 16) * (1.0f / 32768.0f)) - 1.0f;
+    }
+
+    for (uint32_t n = 0U; n < WORKLOAD_FIR_BLOCK; n++)
+    {
+        const float *window = &g_firState[n];
+        float acc = 0.0f;
+
+        for (uint32_t k = 0U; k < WORKLOAD_FIR_TAPS; k++)
+        {
+            acc += g_firTaps[k] * window[WORKLOAD_FIR_TAPS - 1U - k];
+        }
+        g_firOutput[n] = acc;
+    }
+
+    for (uint32_t i = 0U; i < (WORKLOAD_FIR_TAPS - 1U); i++)
+    {
+        g_firState[i] = g_firState[WORKLOAD_FIR_BLOCK + i];
+    }
+
+    g_dspSink += (uint32_t)(int32_t)(g_firOutput[WORKLOAD_FIR_BLOCK - 1U] * 32768.0f);
+}
+
+/*
+ * Description : Fills the FFT twiddle table with e^(-j 2 pi k / N) in
+ *               Q15. The first factor comes from its Taylor series and
+ *               the rest by rotation, in double, so no maths library is
+ *               needed. Runs once, before the task's first block.
+ */
+static void initFft(void)
+{
+    const double angle = 6.283185307179586 / (double)WORKLOAD_FFT_POINTS;
+    double stepCos = 0.0;
+    double stepSin = 0.0;
+    double term = 1.0;
+    double c = 1.0;
+    double s = 0.0;
+
+    /* angle^k / k!, added to cos and sin with the signs of the series */
+    for (uint32_t k = 0U; k < 18U; k++)
+    {
+        switch (k % 4U)
+        {
+            case 0U:
+                stepCos += term;
+                break;
+
+            case 1U:
+                stepSin += term;
+                break;
+
+            case 2U:
+                stepCos -= term;
+                break;
+
+            default:
+                stepSin -= term;
+                break;
+        }
+        term *= angle / (double)(k + 1U);
+    }
+
+    for (uint32_t k = 0U; k < WORKLOAD_FFT_HALF; k++)
+    {
+        double next = (c * stepCos) - (s * stepSin);
+
+        g_fftTwiddle[k] = packQ15(toQ15(c), toQ15(-s));
+        s = (s * stepCos) + (c * stepSin);
+        c = next;
+    }
+}
+
+/*
+ * Description : Returns an FFT index with its bits reversed.
+ */
+static uint32_t reverseIndex(uint32_t index)
+{
+    uint32_t reversed = 0U;
+
+    for (uint32_t bit = 1U; bit < WORKLOAD_FFT_POINTS; bit <<= 1)
+    {
+        reversed = (reversed << 1) | (index & 1U);
+        index >>= 1;
+    }
+
+    return reversed;
+}
+
+/*
+ * Description : One radix-2 decimation-in-time FFT of a real noise frame
+ *               in Q15. The input is written in bit-reversed order so the
+ *               butterflies run in place. Each twiddle product is two
+ *               dual multiplies (SMUSD for the real part, SMUADX for the
+ *               imaginary part), and every stage halves its outputs so
+ *               no value overflows Q15.
+ */
+static void fftBlock(uint32_t *seed)
+{
+    for (uint32_t i = 0U; i < WORKLOAD_FFT_POINTS; i++)
+    {
+        g_fftData[reverseIndex(i)] = packQ15((int32_t)(nextRandom(seed) >> 17) - 16384, 0);
+    }
+
+    for (uint32_t half = 1U; half < WORKLOAD_FFT_POINTS; half <<= 1)
+    {
+        uint32_t stride = WORKLOAD_FFT_HALF / half;
+
+        for (uint32_t start = 0U; start < WORKLOAD_FFT_POINTS; start += 2U * half)
+        {
+            for (uint32_t k = 0U; k < half; k++)
+            {
+                uint32_t *a = &g_fftData[start + k];
+                uint32_t *b = &g_fftData[start + k + half];
+                uint32_t w = g_fftTwiddle[k * stride];
+                int32_t tr = WORKLOAD_SMUSD(*b, w) >> 15;
+                int32_t ti = WORKLOAD_SMUADX(*b, w) >> 15;
+                int32_t ar = (int16_t)*a;
+                int32_t ai = (int16_t)(*a >> 16);
+
+                *a = packQ15((ar + tr) >> 1, (ai + ti) >> 1);
+                *b = packQ15((ar - tr) >> 1, (ai - ti) >> 1);
+            }
+        }
+    }
+
+    g_dspSink += g_fftData[1];
+}
+
+/*
+ * Description : CRC-32 of the whole buffer, after changing its first
+ *               word as a freshly received buffer would.
+ */
+static void crcBlock(uint32_t *seed)
+{
+    uint32_t word = nextRandom(seed);
+
+    for (uint32_t i = 0U; (i < 4U) && (i < WORKLOAD_CRC_BYTES); i++)
+    {
+        g_crcData[i] = (uint8_t)(word >> (i * 8U));
+    }
+
+    g_dspSink += Crc32(0xFFFFFFFFU, g_crcData, WORKLOAD_CRC_BYTES);
+}
+
+/*
+ * Description : Loop of the DSP tasks: WORKLOAD_DSP_BURST_BLOCKS blocks,
+ *               one work unit each, then a short block.
+ */
+static void runDspLoop(const char *name, void (*processBlock)(uint32_t *seed))
+{
+    WorkloadCounter_t *counter = workloadClaimCounter(name);
+    uint32_t seed = WORKLOAD_DSP_SEED;
+
+    for (;;)
+    {
+        for (uint32_t block = 0U; block < WORKLOAD_DSP_BURST_BLOCKS; block++)
+        {
+            processBlock(&seed);
+            workloadCountWork(counter, 1U);
+        }
+
+        simulateBlocking();
+    }
+}
+
+/*
+ * Description : Adds one latency to the timing of an ADC or queue
+ *               pipeline stage. Called inside a critical section.
+ */
+static void addLatency(WorkloadEchoStats_t *stats, uint32_t cycles)
+{
+    stats->samples++;
+    stats->total_cycles += cycles;
+    if (cycles < stats->min_cycles)
+    {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles)
+    {
+        stats->max_cycles = cycles;
+    }
+}
+
+/*
+ * Description : Returns the queue between the two ADC tasks, creating it
+ *               on first use. The scheduler is suspended around the
+ *               check so the two tasks cannot both create one. NULL if
+ *               the heap had no room.
+ */
+static QueueHandle_t adcResultQueue(void)
+{
+    vTaskSuspendAll();
+    if (g_adcQueue == NULL)
+    {
+        g_adcQueue = xQueueCreate((UBaseType_t)WORKLOAD_ADC_QUEUE_LENGTH,
+                                  (UBaseType_t)sizeof(WorkloadAdcResult_t));
+    }
+    (void)xTaskResumeAll();
+
+    return g_adcQueue;
+}
+
+/*
+ * Description : Reduces one half-buffer: every sample goes through the
+ *               low-pass filter, which carries on from the last half,
+ *               so the work grows with the batch.
+ */
+static void reduceAdcHalf(const uint16_t *samples, WorkloadAdcResult_t *result)
+{
+    uint32_t sum = 0U;
+    uint16_t low = UINT16_MAX;
+    uint16_t high = 0U;
+
+    for (uint32_t i = 0U; i < WORKLOAD_ADC_BATCH; i++)
+    {
+        uint32_t sample = samples[i];
+
+        g_adcFilter += sample - (g_adcFilter >> WORKLOAD_ADC_FILTER_SHIFT);
+        sum += g_adcFilter >> WORKLOAD_ADC_FILTER_SHIFT;
+
+        if (sample < low)
+        {
+            low = (uint16_t)sample;
+        }
+        if (sample > high)
+        {
+            high = (uint16_t)sample;
+        }
+    }
+
+    result->mean = (uint16_t)(sum / WORKLOAD_ADC_BATCH);
+    result->min = low;
+    result->max = high;
+}
+
+/*
+ * Description : Starts the queue pipeline figures over. Called inside a
+ *               critical section, or before the stages run.
+ */
+static void resetPipelineStats(void)
+{
+    memset(&g_pipelineStats, 0, sizeof(g_pipelineStats));
+    g_pipelineStats.end_to_end.min_cycles = UINT32_MAX;
+    for (uint32_t stage = 0U; stage < WORKLOAD_PIPELINE_STAGES; stage++)
+    {
+        g_pipelineStats.stage[stage].latency.min_cycles = UINT32_MAX;
+    }
+}
+
 /******************************************************************************
  *  FUNCTION DEFINITIONS
  ******************************************************************************/
 
+/*
+ * Description : Times the busy loop with the DWT cycle counter. Runs
+ *               before the kernel starts, so nothing preempts it.
+ */
+void initWorkloads(void)
+{
+    uint32_t start = cycleCounterGet();
+    spin(WORKLOAD_CALIBRATION_LOOPS);
+    uint32_t cycles = cycleCounterGet() - start;
+
+    g_cyclesPerScaledLoops = (uint32_t)(((uint64_t)cycles * WORKLOAD_LOOP_SCALE) /
+                                        WORKLOAD_CALIBRATION_LOOPS);
+    if (g_cyclesPerScaledLoops == 0U)
+    {
+        g_cyclesPerScaledLoops = 1U;
+    }
+}
+
+/*
+ * Description : Burns burstUs of CPU time. The loop count comes from the
+ *               calibration, so time spent preempted is not counted and
+ *               the burst does not depend on compiler or clock settings.
+ */
+void runBurst(uint32_t burstUs)
+{
+    if (g_cyclesPerScaledLoops == 0U)
+    {
+        /* Not calibrated before the kernel started */
+        initWorkloads();
+    }
+
+    uint64_t cycles = ((uint64_t)burstUs * configCPU_CLOCK_HZ) / 1000000ULL;
+    uint64_t loops  = (cycles * WORKLOAD_LOOP_SCALE) / g_cyclesPerScaledLoops;
+
+    while (loops > UINT32_MAX)
+    {
+        spin(UINT32_MAX);
+        loops -= UINT32_MAX;
+    }
+    spin((uint32_t)loops);
+}
+
 /*
  * Description : Simulates a blocking operation by delaying the
  *               currently running task for a short duration.
  */
 void simulateBlocking(void)
 {
-    /* Yield CPU execution for one tick */
-    vTaskDelay(5);
+    /* Yield CPU execution for the interactive wait */
+    vTaskDelay(pdMS_TO_TICKS(INTERACTIVE_BLOCK_MS));
+}
+
+/*
+ * Description : Hands the next free counter to the calling task. The
+ *               counter is filled in before the count is published, so
+ *               readers never see a half-claimed entry.
+ */
+WorkloadCounter_t *workloadClaimCounter(const char *name)
+{
+    WorkloadCounter_t *counter = NULL;
+
+    taskENTER_CRITICAL();
+    if (g_counterCount < WORKLOAD_MAX_COUNTERS)
+    {
+        counter = &g_counters[g_counterCount];
+        counter->name  = name;
+        counter->task  = (void *)xTaskGetCurrentTaskHandle();
+        counter->units = 0U;
+        g_counterCount++;
+    }
+    taskEXIT_CRITICAL();
+
+    return counter;
+}
+
+/*
+ * Description : Adds work to the caller's own counter. The owner is the
+ *               only writer, so the increment cannot race.
+ */
+void workloadCountWork(WorkloadCounter_t *counter, uint32_t units)
+{
+    if (counter != NULL)
+    {
+        counter->units += units;
+    }
+}
+
+/*
+ * Description : Returns the number of claimed counters.
+ */
+uint32_t workloadGetCounterCount(void)
+{
+    return g_counterCount;
+}
+
+/*
+ * Description : Returns a claimed counter, or NULL past the last one.
+ */
+const WorkloadCounter_t *workloadGetCounter(uint32_t index)
+{
+    return (index < g_counterCount) ? &g_counters[index] : NULL;
+}
+
+/*
+ * Description : Generator task. Runs the phases of its descriptor in
+ *               order, each for its duration_ms, with bursts and block
+ *               times drawn from the phase parameters. A task with a
+ *               replay table replays it instead.
+ */
+void runWorkloadTask(void *pvParameters)
+{
+    WorkloadTask_t *task = (WorkloadTask_t *)pvParameters;
+    const WorkloadDescriptor_t *descriptor = task->descriptor;
+
+    task->counter = workloadClaimCounter(pcTaskGetName(NULL));
+
+    if (task->replay != NULL)
+    {
+        runReplay(task);
+    }
+
+    configASSERT((descriptor->phase_count > 0U) &&
+                 (descriptor->phase_count <= WORKLOAD_MAX_PHASES));
+
+    uint32_t seed = (task->seed != 0U) ? task->seed : ((uint32_t)(uintptr_t)task | 1U);
+    uint32_t phase = 0U;
+    TickType_t phaseStart = xTaskGetTickCount();
+    uint32_t carryUs = 0U;
+
+    task->phase = phase;
+
+    for (;;)
+    {
+        const WorkloadPhase_t *current = &descriptor->phases[phase];
+
+        if ((current->duration_ms != 0U) &&
+            ((xTaskGetTickCount() - phaseStart) >= pdMS_TO_TICKS(current->duration_ms)))
+        {
+            phase = (phase + 1U) % descriptor->phase_count;
+            phaseStart = xTaskGetTickCount();
+            task->phase = phase;
+            continue;
+        }
+
+        uint32_t burstUs = current->burst_us;
+        if (current->burst_jitter_us != 0U)
+        {
+            burstUs += nextRandom(&seed) % (current->burst_jitter_us + 1U);
+        }
+
+        runBurst(burstUs);
+        task->bursts++;
+        countBurst(task, &carryUs, burstUs);
+
+        uint32_t blockMs = current->block_min_ms;
+        if (current->block_max_ms > current->block_min_ms)
+        {
+            blockMs += nextRandom(&seed) %
+                       (current->block_max_ms - current->block_min_ms + 1U);
+        }
+
+        sleepMs(blockMs);
+    }
 }
 
 /*
@@ -42,25 +788,45 @@ void simulateBlocking(void)
  */
 void runInteractiveTask(void *pvParameters)
 {
-    /* Variable used to simulate computation */
-    volatile uint8_t mathCalculation = 0;
+    /* Task name passed as parameter, used to label its work counter */
+    WorkloadCounter_t *counter = workloadClaimCounter((const char *)pvParameters);
 
-    /* Task name passed as parameter (unused except for identification) */
-    volatile const char *taskName = (char *)pvParameters;
+    /* Tick the request being served arrived at */
+    TickType_t request = xTaskGetTickCount();
 
     /* Task execution loop */
     for (;;)
     {
         /* Simulated short computation workload */
-        for (uint16_t task_loop = 0; task_loop < INTERACTIVE_TASK_TIME; task_loop++)
+        runBurst(INTERACTIVE_BURST_US);
+
+        /* Several tasks may share the counter */
+        taskENTER_CRITICAL();
+        g_interactive_work_counter += INTERACTIVE_BURST_US / WORKLOAD_WORK_UNIT_US;
+        taskEXIT_CRITICAL();
+        workloadCountWork(counter, INTERACTIVE_BURST_US / WORKLOAD_WORK_UNIT_US);
+
+        WorkloadResponseHook_t hook = g_responseHook;
+        if (hook != NULL)
         {
-            mathCalculation++;
+            hook((uint32_t)request);
         }
-        /* Simulate blocking behavior */
-        simulateBlocking();
+
+        /* Simulate blocking behavior. Timed from the stamp, so 'request'
+         * becomes the wake-up tick even if the task is preempted first */
+        request = xTaskGetTickCount();
+        vTaskDelayUntil(&request, pdMS_TO_TICKS(INTERACTIVE_BLOCK_MS));
     }
 }
 
+/*
+ * Description : Installs the response hook of the interactive tasks.
+ */
+void workloadSetResponseHook(WorkloadResponseHook_t hook)
+{
+    g_responseHook = hook;
+}
+
 /*
  * Description : Represents a CPU-intensive task that performs
  *               long computations before yielding execution,
@@ -68,28 +834,400 @@ void runInteractiveTask(void *pvParameters)
  */
 void runCPUHeavyTask(void *pvParameters)
 {
-    /* Variable used to simulate computation */
-    volatile uint8_t mathCalculation = 0;
-
-    /* Task name passed as parameter (unused except for identification) */
-    const char *taskName = (char*) pvParameters;
+    /* Task name passed as parameter, used to label its work counter */
+    WorkloadCounter_t *counter = workloadClaimCounter((const char *)pvParameters);
 
     /* Task execution loop */
     for (;;)
     {
-        for (uint16_t i = 0; i < 1000; i++)
+        /* Counted unit by unit so throughput shows up every second */
+        for (uint32_t unit = 0U; unit < (HEAVY_BURST_US / WORKLOAD_WORK_UNIT_US); unit++)
+        {
+            runBurst(WORKLOAD_WORK_UNIT_US);
+
+            taskENTER_CRITICAL();
+            g_cpu_work_counter++;
+            taskEXIT_CRITICAL();
+            workloadCountWork(counter, 1U);
+        }
+
+        /* Now yield */
+        simulateBlocking();
+    }
+}
+
+/*
+ * Description : Echo task. Each byte waits in the driver with the cycle
+ *               count its interrupt took it at, so the time measured
+ *               covers the wake-up, any wait behind other tasks and the
+ *               processing, up to the byte going back out.
+ */
+void runEchoTask(void *pvParameters)
+{
+    WorkloadCounter_t *counter = workloadClaimCounter((const char *)pvParameters);
+    uint8_t bytes[8];
+    uint32_t stamps[8];
+    uint32_t carryUs = 0U;
+
+    initEchoUART(ECHO_BAUD, xTaskGetCurrentTaskHandle());
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        uint32_t count;
+        while ((count = receiveEchoBytes(bytes, stamps, sizeof(bytes))) > 0U)
         {
-            for (uint16_t task_loop = 0; task_loop < HEAVY_TASK_TIME; task_loop++)
+            for (uint32_t i = 0U; i < count; i++)
             {
-                mathCalculation++;
+                runBurst(ECHO_BURST_US);
+                sendEchoByte(bytes[i]);
+
+                uint32_t cycles = cycleCounterGet() - stamps[i];
+
+                taskENTER_CRITICAL();
+                g_echoStats.samples++;
+                g_echoStats.total_cycles += cycles;
+                if (cycles < g_echoStats.min_cycles)
+                {
+                    g_echoStats.min_cycles = cycles;
+                }
+                if (cycles > g_echoStats.max_cycles)
+                {
+                    g_echoStats.max_cycles = cycles;
+                }
+                taskEXIT_CRITICAL();
+
+                carryUs += ECHO_BURST_US;
+                workloadCountWork(counter, carryUs / WORKLOAD_WORK_UNIT_US);
+                carryUs %= WORKLOAD_WORK_UNIT_US;
             }
         }
+    }
+}
+
+/*
+ * Description : Hands over the echo timing and resets it.
+ */
+void workloadTakeEchoStats(WorkloadEchoStats_t *output)
+{
+    taskENTER_CRITICAL();
+    *output = g_echoStats;
+    g_echoStats.samples = 0U;
+    g_echoStats.min_cycles = UINT32_MAX;
+    g_echoStats.max_cycles = 0U;
+    g_echoStats.total_cycles = 0U;
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : FIR benchmark task, one block of WORKLOAD_FIR_BLOCK
+ *               samples per work unit.
+ */
+void runFirTask(void *pvParameters)
+{
+    initFir();
+    runDspLoop((const char *)pvParameters, firBlock);
+}
+
+/*
+ * Description : FFT benchmark task, one WORKLOAD_FFT_POINTS-point
+ *               transform per work unit.
+ */
+void runFftTask(void *pvParameters)
+{
+    initFft();
+    runDspLoop((const char *)pvParameters, fftBlock);
+}
+
+/*
+ * Description : CRC benchmark task, one CRC of WORKLOAD_CRC_BYTES bytes
+ *               per work unit.
+ */
+void runCrcTask(void *pvParameters)
+{
+    uint32_t seed = WORKLOAD_DSP_SEED;
+
+    for (uint32_t i = 0U; i < WORKLOAD_CRC_BYTES; i++)
+    {
+        g_crcData[i] = (uint8_t)nextRandom(&seed);
+    }
+
+    runDspLoop((const char *)pvParameters, crcBlock);
+}
+
+/*
+ * Description : CPU copy benchmark task. The core does every load and
+ *               store, so the task burns its quantum like the Hog.
+ */
+void runCpuCopyTask(void *pvParameters)
+{
+    WorkloadCounter_t *counter = workloadClaimCounter((const char *)pvParameters);
+
+    for (;;)
+    {
+        for (uint32_t copy = 0U; copy < WORKLOAD_COPY_BURST_COPIES; copy++)
+        {
+            (void)memcpy(g_copyCpuDestination, g_copySource, WORKLOAD_COPY_BYTES);
+            workloadCountWork(counter, 1U);
+        }
 
-        /* Now yield */
         simulateBlocking();
     }
 }
 
+/*
+ * Description : uDMA copy benchmark task. It only starts each copy and
+ *               sleeps until the completion interrupt, so its bursts are
+ *               a few microseconds and it keeps the level of an
+ *               interactive task while the copy runs beside the others.
+ */
+void runDmaCopyTask(void *pvParameters)
+{
+    WorkloadCounter_t *counter = workloadClaimCounter((const char *)pvParameters);
+
+    initDmaCopy(xTaskGetCurrentTaskHandle());
+
+    for (;;)
+    {
+        startDmaCopy(g_copyDmaDestination, g_copySource, WORKLOAD_COPY_BYTES / 4U);
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        workloadCountWork(counter, 1U);
+    }
+}
+
+/*
+ * Description : ADC handler task. Each half is stamped by the interrupt
+ *               that found it full, so its latency covers the wake-up,
+ *               any wait behind other tasks and the reduction. A result
+ *               the queue has no room for is counted and dropped; the
+ *               handler never waits on the aggregate task.
+ */
+void runAdcHandlerTask(void *pvParameters)
+{
+    WorkloadCounter_t *counter = workloadClaimCounter((const char *)pvParameters);
+    QueueHandle_t queue = adcResultQueue();
+
+    initAdcSampling(WORKLOAD_ADC_SAMPLE_HZ, g_adcSamples, WORKLOAD_ADC_BATCH,
+                    xTaskGetCurrentTaskHandle());
+
+    for (;;)
+    {
+        uint32_t half;
+        uint32_t stamp;
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (takeAdcHalf(&half, &stamp))
+        {
+            WorkloadAdcResult_t result;
+
+            reduceAdcHalf(&g_adcSamples[half * WORKLOAD_ADC_BATCH], &result);
+            result.stamp = stamp;
+
+            bool queued = (queue != NULL) && (xQueueSend(queue, &result, 0U) == pdPASS);
+            uint32_t cycles = cycleCounterGet() - stamp;
+
+            taskENTER_CRITICAL();
+            addLatency(&g_adcStats.stage[WORKLOAD_ADC_STAGE_HANDLER], cycles);
+            if (!queued)
+            {
+                g_adcStats.dropped++;
+            }
+            taskEXIT_CRITICAL();
+
+            workloadCountWork(counter, 1U);
+        }
+    }
+}
+
+/*
+ * Description : ADC aggregate task. Collects WORKLOAD_ADC_AGGREGATE_BATCHES
+ *               results, then folds them into their spread and spends
+ *               WORKLOAD_ADC_AGGREGATE_US on the aggregation in one
+ *               burst. Every half of the group is timed to the end of
+ *               that burst.
+ */
+void runAdcAggregateTask(void *pvParameters)
+{
+    WorkloadCounter_t *counter = workloadClaimCounter((const char *)pvParameters);
+    QueueHandle_t queue = adcResultQueue();
+    uint32_t stamps[WORKLOAD_ADC_AGGREGATE_BATCHES];
+    uint32_t count = 0U;
+    uint32_t sum = 0U;
+    uint64_t sumSquares = 0U;
+    uint16_t low = UINT16_MAX;
+    uint16_t high = 0U;
+
+    if (queue == NULL)
+    {
+        vTaskSuspend(NULL);
+    }
+
+    for (;;)
+    {
+        WorkloadAdcResult_t result;
+
+        (void)xQueueReceive(queue, &result, portMAX_DELAY);
+
+        stamps[count++] = result.stamp;
+        sum += result.mean;
+        sumSquares += (uint64_t)result.mean * result.mean;
+        low = (result.min < low) ? result.min : low;
+        high = (result.max > high) ? result.max : high;
+
+        if (count < WORKLOAD_ADC_AGGREGATE_BATCHES)
+        {
+            continue;
+        }
+
+        uint32_t mean = sum / WORKLOAD_ADC_AGGREGATE_BATCHES;
+        g_dspSink += (uint32_t)(sumSquares / WORKLOAD_ADC_AGGREGATE_BATCHES) -
+                     (mean * mean) + (uint32_t)(high - low);
+        runBurst(WORKLOAD_ADC_AGGREGATE_US);
+
+        uint32_t now = cycleCounterGet();
+
+        taskENTER_CRITICAL();
+        for (uint32_t i = 0U; i < count; i++)
+        {
+            addLatency(&g_adcStats.stage[WORKLOAD_ADC_STAGE_AGGREGATE], now - stamps[i]);
+        }
+        taskEXIT_CRITICAL();
+
+        workloadCountWork(counter, count);
+        count = 0U;
+        sum = 0U;
+        sumSquares = 0U;
+        low = UINT16_MAX;
+        high = 0U;
+    }
+}
+
+/*
+ * Description : Hands over the pipeline timing and resets it. The
+ *               driver's overrun count only grows; the window gets the
+ *               difference.
+ */
+void workloadTakeAdcStats(WorkloadAdcStats_t *output)
+{
+    uint32_t overruns = getAdcOverruns();
+
+    taskENTER_CRITICAL();
+    *output = g_adcStats;
+    output->overruns = overruns - g_adcOverrunsTaken;
+    g_adcOverrunsTaken = overruns;
+    for (uint32_t stage = 0U; stage < WORKLOAD_ADC_STAGES; stage++)
+    {
+        g_adcStats.stage[stage].samples = 0U;
+        g_adcStats.stage[stage].min_cycles = UINT32_MAX;
+        g_adcStats.stage[stage].max_cycles = 0U;
+        g_adcStats.stage[stage].total_cycles = 0U;
+    }
+    g_adcStats.dropped = 0U;
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Creates one queue per stage after the first.
+ */
+bool workloadInitPipeline(void)
+{
+    resetPipelineStats();
+
+    for (uint32_t queue = 0U; queue < (WORKLOAD_PIPELINE_STAGES - 1U); queue++)
+    {
+        if (g_pipelineQueues[queue] == NULL)
+        {
+            g_pipelineQueues[queue] = xQueueCreate((UBaseType_t)WORKLOAD_PIPELINE_QUEUE_LENGTH,
+                                                   (UBaseType_t)sizeof(WorkloadPipelineItem_t));
+        }
+        if (g_pipelineQueues[queue] == NULL)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Description : Queue pipeline stage task. Takes an item from its input
+ *               queue (stage 0 makes one), spends the stage's cost on it
+ *               and offers it to the next queue, waiting while that one
+ *               is full. A full queue holds the stage up, so a stage the
+ *               scheduler starves backs the whole chain up behind it.
+ *               The time an item waits on a full queue counts towards
+ *               the stage it waits for.
+ */
+void runPipelineStageTask(void *pvParameters)
+{
+    uint32_t stage = (uint32_t)(uintptr_t)pvParameters;
+    WorkloadCounter_t *counter = workloadClaimCounter(g_pipelineNames[stage]);
+    QueueHandle_t input = (stage > 0U) ? g_pipelineQueues[stage - 1U] : NULL;
+    QueueHandle_t output = ((stage + 1U) < WORKLOAD_PIPELINE_STAGES) ? g_pipelineQueues[stage] : NULL;
+
+    /* Queues missing: workloadInitPipeline() was not called or failed */
+    if (((stage > 0U) && (input == NULL)) || (((stage + 1U) < WORKLOAD_PIPELINE_STAGES) && (output == NULL)))
+    {
+        vTaskSuspend(NULL);
+    }
+
+    for (;;)
+    {
+        WorkloadPipelineItem_t item;
+        uint32_t depth = 0U;
+
+        if (input == NULL)
+        {
+            item.made = cycleCounterGet();
+            item.queued = item.made;
+        }
+        else
+        {
+            depth = (uint32_t)uxQueueMessagesWaiting(input);
+            (void)xQueueReceive(input, &item, portMAX_DELAY);
+        }
+
+        runBurst(g_pipelineCostUs[stage]);
+
+        uint32_t now = cycleCounterGet();
+        WorkloadPipelineStage_t *stats = &g_pipelineStats.stage[stage];
+
+        taskENTER_CRITICAL();
+        addLatency(&stats->latency, now - item.queued);
+        stats->depth_total += depth;
+        if (depth > stats->depth_max)
+        {
+            stats->depth_max = depth;
+        }
+        if (output == NULL)
+        {
+            addLatency(&g_pipelineStats.end_to_end, now - item.made);
+        }
+        taskEXIT_CRITICAL();
+
+        workloadCountWork(counter, 1U);
+
+        if (output != NULL)
+        {
+            item.queued = cycleCounterGet();
+            (void)xQueueSend(output, &item, portMAX_DELAY);
+        }
+    }
+}
+
+/*
+ * Description : Hands over the queue pipeline figures and resets them.
+ */
+void workloadTakePipelineStats(WorkloadPipelineStats_t *output)
+{
+    taskENTER_CRITICAL();
+    *output = g_pipelineStats;
+    resetPipelineStats();
+    taskEXIT_CRITICAL();
+}
+
 /******************************************************************************
  *  END OF FILE
  ******************************************************************************/
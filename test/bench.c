@@ -0,0 +1,385 @@
+/******************************************************************************
+ *  MODULE NAME  : Scheduler Overhead Benchmark
+ *  FILE         : bench.c
+ *  DESCRIPTION  : Alternative entry point that times the MLFQ's own code
+ *                 with the DWT cycle counter for a growing number of
+ *                 registered tasks and prints min/mean/max as CSV.
+ *                 Build it instead of src/main.c, like test/test.c.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS Includes */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Project Includes */
+#include "scheduler.h"
+#include "metrics_logger.h"
+#include "cycle_counter.h"
+#include "switch_stats.h"
+#include "drivers.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Calls timed per function and task count */
+#ifndef BENCH_ROUNDS
+#define BENCH_ROUNDS              64U
+#endif
+
+/* printQueueReport() fills the snapshot ring, so it gets fewer rounds
+ * and the logger is given time to drain the ring after each one */
+#ifndef BENCH_REPORT_ROUNDS
+#define BENCH_REPORT_ROUNDS       8U
+#endif
+
+#ifndef BENCH_DRAIN_MS
+#define BENCH_DRAIN_MS            250U
+#endif
+
+/* Registered task counts to measure (the bench task is one of them) */
+#define BENCH_TASK_COUNTS         { 1U, 4U, 8U, 16U, TICK_PROFILER_MAX_TASKS }
+
+#define BENCH_STACK_SIZE          512U
+#define BENCH_WORKER_STACK_SIZE   configMINIMAL_STACK_SIZE
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+typedef struct
+{
+    uint32_t samples;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} BenchStats_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+static TaskHandle_t g_benchHandle = NULL;
+
+/* Workers, registered one by one as the task count grows */
+static TaskHandle_t g_workers[TICK_PROFILER_MAX_TASKS - 1U];
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+static void statsReset(BenchStats_t *stats)
+{
+    stats->samples      = 0U;
+    stats->min_cycles   = UINT32_MAX;
+    stats->max_cycles   = 0U;
+    stats->total_cycles = 0U;
+}
+
+static void statsAdd(BenchStats_t *stats, uint32_t cycles)
+{
+    stats->samples++;
+    stats->total_cycles += cycles;
+    if (cycles < stats->min_cycles)
+    {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles)
+    {
+        stats->max_cycles = cycles;
+    }
+}
+
+/*
+ * Description : Sends text on the CSV channel.
+ */
+static void sendCsv(const char *text)
+{
+    (void)sendLogChannel(LOG_CHANNEL_CSV, text, (uint32_t)strlen(text));
+}
+
+/*
+ * Description : Prints one CSV row: name, tasks, samples, min, mean, max.
+ */
+static void printRow(const char *name, uint32_t tasks, uint32_t samples,
+                     uint32_t minCycles, uint32_t meanCycles, uint32_t maxCycles)
+{
+    char line[96];
+
+    snprintf(line, sizeof(line), "BENCH, %s, %lu, %lu, %lu, %lu, %lu\r\n", name,
+             (unsigned long)tasks, (unsigned long)samples,
+             (unsigned long)((samples == 0U) ? 0U : minCycles),
+             (unsigned long)meanCycles, (unsigned long)maxCycles);
+    sendCsv(line);
+}
+
+static void printStats(const char *name, uint32_t tasks, const BenchStats_t *stats)
+{
+    uint32_t mean = (stats->samples == 0U) ? 0U :
+                    (uint32_t)(stats->total_cycles / stats->samples);
+
+    printRow(name, tasks, stats->samples, stats->min_cycles, mean, stats->max_cycles);
+}
+
+/*
+ * Description : Worker body. Answers every notification from the bench
+ *               task, which makes two context switches per round.
+ */
+static void benchWorker(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xTaskNotifyGive(g_benchHandle);
+    }
+}
+
+/*
+ * Description : Times the tick hook on the registered bench task. The
+ *               runtime is reset first so every call takes the
+ *               no-expiry path the hook takes on most ticks.
+ */
+static void benchTickHook(uint32_t tasks)
+{
+    BenchStats_t stats;
+    int32_t slot = tickProfilerGetSlot(g_benchHandle);
+
+    statsReset(&stats);
+
+    for (uint32_t round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        (void)resetSlotRuntime((uint32_t)slot);
+
+        taskENTER_CRITICAL();
+        {
+            uint32_t start = cycleCounterGet();
+            vApplicationTickHook();
+            statsAdd(&stats, cycleCounterGet() - start);
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    printStats("vApplicationTickHook", tasks, &stats);
+}
+
+/*
+ * Description : Times level changes, walking every registered task down
+ *               one level per call and back to High once at Low.
+ */
+static void benchLevelChange(uint32_t tasks)
+{
+    BenchStats_t stats;
+    MLFQ_Task_Profiler_t task;
+
+    statsReset(&stats);
+
+    for (uint32_t round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        if (!schedulerGetTaskStats(round % TICK_PROFILER_MAX_TASKS, &task))
+        {
+            continue;
+        }
+
+        MLFQ_QueueLevel_t level = (task.task_level >= MLFQ_QUEUE_LOW) ?
+                                  MLFQ_QUEUE_HIGH : (MLFQ_QueueLevel_t)(task.task_level + 1);
+
+        uint32_t start = cycleCounterGet();
+        updateTaskPriority(task.task_info.task, level);
+        statsAdd(&stats, cycleCounterGet() - start);
+    }
+
+    printStats("updateTaskPriority", tasks, &stats);
+}
+
+/*
+ * Description : Times the global boost with every task demoted to Low
+ *               beforehand, so each boost moves all of them.
+ */
+static void benchBoost(uint32_t tasks)
+{
+    BenchStats_t stats;
+    MLFQ_Task_Profiler_t task;
+
+    statsReset(&stats);
+
+    for (uint32_t round = 0U; round < BENCH_ROUNDS; round++)
+    {
+        for (uint32_t slot = 0U; slot < TICK_PROFILER_MAX_TASKS; slot++)
+        {
+            if (schedulerGetTaskStats(slot, &task))
+            {
+                updateTaskPriority(task.task_info.task, MLFQ_QUEUE_LOW);
+            }
+        }
+
+        uint32_t start = cycleCounterGet();
+        performGlobalBoost();
+        statsAdd(&stats, cycleCounterGet() - start);
+
+        /* Let the logger take the level change records */
+        vTaskDelay(pdMS_TO_TICKS(BENCH_DRAIN_MS / 10U));
+    }
+
+    printStats("performGlobalBoost", tasks, &stats);
+}
+
+/*
+ * Description : Times the supervisor's share of a report (the snapshot
+ *               copies); the logger formats them later at low priority.
+ */
+static void benchReport(uint32_t tasks)
+{
+    BenchStats_t stats;
+
+    statsReset(&stats);
+
+    for (uint32_t round = 0U; round < BENCH_REPORT_ROUNDS; round++)
+    {
+        uint32_t start = cycleCounterGet();
+        printQueueReport();
+        statsAdd(&stats, cycleCounterGet() - start);
+
+        vTaskDelay(pdMS_TO_TICKS(BENCH_DRAIN_MS));
+    }
+
+    printStats("printQueueReport", tasks, &stats);
+}
+
+/*
+ * Description : Measures context switches by ping-ponging with the
+ *               workers. Needs SWITCH_STATS_ENABLED in the build.
+ */
+static void benchContextSwitch(uint32_t tasks)
+{
+#if (SWITCH_STATS_ENABLED == 1U)
+    SwitchStatsSummary_t summary;
+    uint32_t workers = tasks - 1U;
+
+    if (workers == 0U)
+    {
+        /* A yield with nothing else ready still runs the selection */
+        switchStatsReset();
+        for (uint32_t round = 0U; round < BENCH_ROUNDS; round++)
+        {
+            taskYIELD();
+        }
+    }
+    else
+    {
+        switchStatsReset();
+        for (uint32_t round = 0U; round < BENCH_ROUNDS; round++)
+        {
+            xTaskNotifyGive(g_workers[round % workers]);
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+    }
+
+    switchStatsGetSummary(&summary);
+    printRow("contextSwitch", tasks, summary.samples, summary.min_cycles,
+             summary.mean_cycles, summary.max_cycles);
+#else
+    (void)tasks;
+#endif
+}
+
+/*
+ * Description : Bench task. Registers itself, then for each task count
+ *               registers workers up to that count and runs every
+ *               measurement. Sleeps between steps so the logger can
+ *               empty the UART buffer.
+ */
+static void benchTask(void *pvParameters)
+{
+    static const uint32_t counts[] = BENCH_TASK_COUNTS;
+    uint32_t registered = 1U;
+
+    (void)pvParameters;
+
+    registerTask(g_benchHandle);
+
+    sendCsv("\r\n--- BENCH STARTED ---\r\n");
+    sendCsv("BENCH, Function, Tasks, Samples, Min_Cycles, Mean_Cycles, Max_Cycles\r\n");
+
+    for (uint32_t step = 0U; step < (sizeof(counts) / sizeof(counts[0])); step++)
+    {
+        uint32_t tasks = counts[step];
+
+        /* Skip counts the table cannot hold or that were already done */
+        if ((tasks > TICK_PROFILER_MAX_TASKS) || (tasks < registered) ||
+            ((step > 0U) && (tasks == counts[step - 1U])))
+        {
+            continue;
+        }
+
+        while (registered < tasks)
+        {
+            registerTask(g_workers[registered - 1U]);
+            registered++;
+        }
+
+        benchTickHook(tasks);
+        benchLevelChange(tasks);
+        vTaskDelay(pdMS_TO_TICKS(BENCH_DRAIN_MS));
+        benchBoost(tasks);
+        benchReport(tasks);
+        benchContextSwitch(tasks);
+        vTaskDelay(pdMS_TO_TICKS(BENCH_DRAIN_MS));
+    }
+
+    sendCsv("--- BENCH DONE ---\r\n");
+    vTaskSuspend(NULL);
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * MAIN FUNCTION
+ * Entry point for the benchmark build. No supervisor task is created:
+ * the bench task calls the scheduler's entry points itself, so quantum
+ * expiries of the bench task are latched and never acted on.
+ */
+int main(void)
+{
+    initClock();
+    initUART();
+    initGPIO();
+
+    initScheduler();
+
+    /* Workers start below the High level, so MLFQ_AUTO_REGISTER_ENABLED
+     * leaves them alone; each blocks on its first notification wait */
+    for (uint32_t i = 0U; i < (TICK_PROFILER_MAX_TASKS - 1U); i++)
+    {
+        xTaskCreate(benchWorker, "Worker", BENCH_WORKER_STACK_SIZE, NULL,
+                    MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_LOW), &g_workers[i]);
+    }
+
+    xTaskCreate(benchTask, "Bench", BENCH_STACK_SIZE, NULL,
+                MLFQ_SUPERVISOR_PRIORITY, &g_benchHandle);
+
+#if (METRICS_REPORT_ENABLED == 1U)
+    xTaskCreate(metricsLoggerTask, "Logger", METRICS_LOGGER_STACK_SIZE, NULL,
+                METRICS_LOGGER_PRIORITY, NULL);
+#endif
+
+    vTaskStartScheduler();
+
+    /* Should never reach here */
+    while(1);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,578 @@
+/******************************************************************************
+ *  MODULE NAME  : Regression Benchmark Suite
+ *  FILE         : regress.c
+ *  DESCRIPTION  : Alternative entry point that runs a fixed battery of
+ *                 scenarios (scheduler overhead, scalability, A/B
+ *                 throughput, response latency and release jitter),
+ *                 checks every figure against the limits in
+ *                 regress_golden.h and prints one PASS/FAIL row per check
+ *                 and a summary row as CSV. Build it instead of
+ *                 src/main.c, like test/test.c and test/bench.c.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* FreeRTOS Includes */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Project Includes */
+#include "scheduler.h"
+#include "metrics_logger.h"
+#include "cycle_counter.h"
+#include "workloads.h"
+#include "drivers.h"
+#include "log_format.h"
+#include "tm4c123gh6pm.h"
+#include "regress_golden.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Calls timed per overhead figure */
+#ifndef REGRESS_ROUNDS
+#define REGRESS_ROUNDS            64U
+#endif
+
+/* Time for the logger to drain the level change records of the boosts */
+#ifndef REGRESS_DRAIN_MS
+#define REGRESS_DRAIN_MS          250U
+#endif
+
+/* Each A/B phase settles, then is measured for REGRESS_PHASE_MS */
+#ifndef REGRESS_SETTLE_MS
+#define REGRESS_SETTLE_MS         1000U
+#endif
+
+#ifndef REGRESS_PHASE_MS
+#define REGRESS_PHASE_MS          5000U
+#endif
+
+/* Periodic probe of the jitter scenario */
+#ifndef REGRESS_PROBE_PERIOD_MS
+#define REGRESS_PROBE_PERIOD_MS   10U
+#endif
+
+#ifndef REGRESS_PROBE_WORK_US
+#define REGRESS_PROBE_WORK_US     200U
+#endif
+
+/* Equal priority of the workload in the round robin phase, below High */
+#define REGRESS_CONTROL_PRIORITY  (MLFQ_TOP_PRIORITY_NUMBER - 1U)
+
+/* The suite task is pinned at the top of the real-time band once the
+ * overhead scenario is done, so it measures the workload from outside */
+#define REGRESS_PRIORITY          MLFQ_RT_PRIORITY_MAX
+
+#define REGRESS_STACK_SIZE        512U
+#define REGRESS_SUPERVISOR_STACK_SIZE 256U
+#define REGRESS_WORKLOAD_STACK_SIZE   256U
+#define REGRESS_WORKER_STACK_SIZE configMINIMAL_STACK_SIZE
+
+/* The round robin phase suspends the supervisor task */
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+#error "test/regress.c needs the supervisor task (configUSE_MLFQ_TIMER_SUPERVISOR 0)"
+#endif
+
+#if (MLFQ_RT_BAND_SIZE == 0U)
+#error "test/regress.c needs a real-time band (MLFQ_RT_BAND_SIZE > 0)"
+#endif
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+typedef struct
+{
+    uint32_t samples;
+    uint32_t max_us;
+    uint64_t total_us;
+} RegressTiming_t;
+
+/*
+ * Description : Figures of one A/B phase.
+ */
+typedef struct
+{
+    uint32_t heavy_ops;
+    uint32_t inter_ops;
+    RegressTiming_t response;
+    RegressTiming_t jitter;
+} RegressPhase_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+static TaskHandle_t g_regressHandle = NULL;
+static TaskHandle_t g_supervisorHandle = NULL;
+static TaskHandle_t g_heavyHandle = NULL;
+static TaskHandle_t g_interHandle = NULL;
+static TaskHandle_t g_probeHandle = NULL;
+
+/* Idle workers that fill the task table for the overhead scenario */
+static TaskHandle_t g_workers[TICK_PROFILER_MAX_TASKS - 1U];
+
+/* Response times and probe lateness of the running phase; written under
+ * a critical section, read and reset by the suite task */
+static RegressTiming_t g_response;
+static RegressTiming_t g_jitter;
+
+/* Checks run and failed so far */
+static uint32_t g_checks = 0U;
+static uint32_t g_failed = 0U;
+
+static char g_buffer[128];
+static LogLine_t g_line;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+static void timingReset(RegressTiming_t *timing)
+{
+    timing->samples  = 0U;
+    timing->max_us   = 0U;
+    timing->total_us = 0U;
+}
+
+static void timingAdd(RegressTiming_t *timing, uint32_t us)
+{
+    timing->samples++;
+    timing->total_us += us;
+    if (us > timing->max_us)
+    {
+        timing->max_us = us;
+    }
+}
+
+static uint32_t timingMean(const RegressTiming_t *timing)
+{
+    return (timing->samples == 0U) ? 0U :
+           (uint32_t)(timing->total_us / timing->samples);
+}
+
+/*
+ * Description : Returns the microseconds since 'tick' started, from the
+ *               tick count and the SysTick down-count, as the test runner
+ *               does. A tick that has fired but is still pending counts
+ *               as started.
+ */
+static uint32_t usSinceTick(TickType_t tick)
+{
+    uint32_t elapsed;
+
+    taskENTER_CRITICAL();
+    {
+        TickType_t now = xTaskGetTickCount();
+        uint32_t reload = NVIC_ST_RELOAD_R;
+        uint32_t current = NVIC_ST_CURRENT_R;
+
+        if ((NVIC_INT_CTRL_R & NVIC_INT_CTRL_PENDSTSET) != 0U)
+        {
+            /* The counter has reloaded; read it again past the wrap */
+            now++;
+            current = NVIC_ST_CURRENT_R;
+        }
+        elapsed = ((uint32_t)(now - tick) * (reload + 1U)) + (reload - current);
+    }
+    taskEXIT_CRITICAL();
+
+    return elapsed / (configCPU_CLOCK_HZ / 1000000U);
+}
+
+/*
+ * Description : Response hook of the interactive task (workloads.h).
+ */
+static void responseSample(uint32_t requestTick)
+{
+    uint32_t us = usSinceTick((TickType_t)requestTick);
+
+    taskENTER_CRITICAL();
+    timingAdd(&g_response, us);
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Periodic probe. Released with vTaskDelayUntil() next to
+ *               the workload and at its priority; records how late each
+ *               release started, then burns REGRESS_PROBE_WORK_US.
+ */
+static void regressProbe(void *pvParameters)
+{
+    const TickType_t period = pdMS_TO_TICKS(REGRESS_PROBE_PERIOD_MS);
+    TickType_t release = xTaskGetTickCount();
+
+    (void)pvParameters;
+
+    for (;;)
+    {
+        vTaskDelayUntil(&release, (period == 0U) ? 1U : period);
+
+        uint32_t late_us = usSinceTick(release);
+
+        taskENTER_CRITICAL();
+        timingAdd(&g_jitter, late_us);
+        taskEXIT_CRITICAL();
+
+        runBurst(REGRESS_PROBE_WORK_US);
+    }
+}
+
+/*
+ * Description : Idle worker; only fills a profiler slot.
+ */
+static void regressWorker(void *pvParameters)
+{
+    (void)pvParameters;
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, (TickType_t)portMAX_DELAY);
+    }
+}
+
+/*
+ * Description : Compares one figure with its limit and sends its row.
+ *               The delta is the figure minus the limit, so a failing
+ *               at-most check has a positive delta and a failing
+ *               at-least check a negative one.
+ */
+static void check(const char *scenario, const char *metric, uint32_t value,
+                  uint32_t limit, bool atMost)
+{
+    bool pass = atMost ? (value <= limit) : (value >= limit);
+
+    g_checks++;
+    if (!pass)
+    {
+        g_failed++;
+    }
+
+    logPutText(&g_line, "REGRESS, ");
+    logPutText(&g_line, scenario);
+    logPutText(&g_line, ", ");
+    logPutText(&g_line, metric);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, value, 0U);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, limit, 0U);
+    logPutText(&g_line, ", ");
+    logPutSigned(&g_line, (int32_t)(value - limit), 0U);
+    logPutText(&g_line, pass ? ", PASS\r\n" : ", FAIL\r\n");
+    (void)logLineSendChannel(&g_line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Mean cycles of the tick hook on the suite task, which is
+ *               registered. The runtime is reset first so every call
+ *               takes the no-expiry path the hook takes on most ticks.
+ */
+static uint32_t timeTickHook(void)
+{
+    int32_t slot = tickProfilerGetSlot(g_regressHandle);
+    uint64_t total = 0U;
+
+    for (uint32_t round = 0U; round < REGRESS_ROUNDS; round++)
+    {
+        (void)resetSlotRuntime((uint32_t)slot);
+
+        taskENTER_CRITICAL();
+        {
+            uint32_t start = cycleCounterGet();
+            vApplicationTickHook();
+            total += cycleCounterGet() - start;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return (uint32_t)(total / REGRESS_ROUNDS);
+}
+
+/*
+ * Description : Mean cycles of a level change, walking every registered
+ *               task down one level per call and back to High at Low.
+ */
+static uint32_t timeLevelChange(void)
+{
+    MLFQ_Task_Profiler_t task;
+    uint64_t total = 0U;
+    uint32_t samples = 0U;
+
+    for (uint32_t round = 0U; round < REGRESS_ROUNDS; round++)
+    {
+        if (!schedulerGetTaskStats(round % TICK_PROFILER_MAX_TASKS, &task))
+        {
+            continue;
+        }
+
+        MLFQ_QueueLevel_t level = (task.task_level >= MLFQ_QUEUE_LOW) ?
+                                  MLFQ_QUEUE_HIGH : (MLFQ_QueueLevel_t)(task.task_level + 1);
+
+        uint32_t start = cycleCounterGet();
+        updateTaskPriority(task.task_info.task, level);
+        total += cycleCounterGet() - start;
+        samples++;
+    }
+
+    return (samples == 0U) ? 0U : (uint32_t)(total / samples);
+}
+
+/*
+ * Description : Mean cycles of a global boost with every registered task
+ *               demoted to Low beforehand, so each boost moves all of
+ *               them.
+ */
+static uint32_t timeBoost(void)
+{
+    MLFQ_Task_Profiler_t task;
+    uint64_t total = 0U;
+
+    for (uint32_t round = 0U; round < REGRESS_ROUNDS; round++)
+    {
+        for (uint32_t slot = 0U; slot < TICK_PROFILER_MAX_TASKS; slot++)
+        {
+            if (schedulerGetTaskStats(slot, &task))
+            {
+                updateTaskPriority(task.task_info.task, MLFQ_QUEUE_LOW);
+            }
+        }
+
+        uint32_t start = cycleCounterGet();
+        performGlobalBoost();
+        total += cycleCounterGet() - start;
+
+        /* Let the logger take the level change records */
+        vTaskDelay(pdMS_TO_TICKS(REGRESS_DRAIN_MS / 10U));
+    }
+
+    return (uint32_t)(total / REGRESS_ROUNDS);
+}
+
+/*
+ * Description : Overhead and scalability scenarios. Times the scheduler's
+ *               entry points with the suite task alone in the table, then
+ *               with every slot taken, and frees the table again. No
+ *               supervisor runs yet, so quantum expiries are never acted
+ *               on.
+ */
+static void runOverhead(void)
+{
+    registerTask(g_regressHandle);
+
+    uint32_t hookOne = timeTickHook();
+
+    for (uint32_t i = 0U; i < (TICK_PROFILER_MAX_TASKS - 1U); i++)
+    {
+        registerTask(g_workers[i]);
+    }
+
+    uint32_t hookAll  = timeTickHook();
+    uint32_t level    = timeLevelChange();
+    uint32_t boostAll = timeBoost();
+
+    for (uint32_t i = 0U; i < (TICK_PROFILER_MAX_TASKS - 1U); i++)
+    {
+        unregisterTask(g_workers[i]);
+    }
+    vTaskDelay(pdMS_TO_TICKS(REGRESS_DRAIN_MS));
+
+    check("Overhead", "TickHook_Mean_Cycles", hookAll,
+          REGRESS_TICK_HOOK_CYCLES_MAX, true);
+    check("Overhead", "LevelChange_Mean_Cycles", level,
+          REGRESS_LEVEL_CHANGE_CYCLES_MAX, true);
+    check("Overhead", "Boost_Mean_Cycles", boostAll,
+          REGRESS_BOOST_CYCLES_MAX, true);
+    check("Scalability", "TickHook_Growth_Pct",
+          (hookOne == 0U) ? 0U : (uint32_t)(((uint64_t)hookAll * 100U) / hookOne),
+          REGRESS_TICK_HOOK_GROWTH_PCT_MAX, true);
+    check("Scalability", "Boost_Cycles_Per_Task", boostAll / TICK_PROFILER_MAX_TASKS,
+          REGRESS_BOOST_CYCLES_PER_TASK_MAX, true);
+}
+
+/*
+ * Description : Runs one A/B phase: round robin at the control priority
+ *               (mode 0) or the workload registered with the supervisor
+ *               running (mode 1). Settles, then takes every figure over
+ *               REGRESS_PHASE_MS and sends them in a PHASE row.
+ */
+static void runPhase(int mode, RegressPhase_t *phase)
+{
+    extern volatile uint32_t g_cpu_work_counter;
+    extern volatile uint32_t g_interactive_work_counter;
+    uint32_t heavy;
+    uint32_t inter;
+
+    if (mode == 1)
+    {
+        registerTask(g_heavyHandle);
+        registerTask(g_interHandle);
+        registerTask(g_probeHandle);
+        vTaskResume(g_supervisorHandle);
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(REGRESS_SETTLE_MS));
+
+    taskENTER_CRITICAL();
+    heavy = g_cpu_work_counter;
+    inter = g_interactive_work_counter;
+    timingReset(&g_response);
+    timingReset(&g_jitter);
+    taskEXIT_CRITICAL();
+
+    vTaskDelay(pdMS_TO_TICKS(REGRESS_PHASE_MS));
+
+    taskENTER_CRITICAL();
+    phase->heavy_ops = g_cpu_work_counter - heavy;
+    phase->inter_ops = g_interactive_work_counter - inter;
+    phase->response  = g_response;
+    phase->jitter    = g_jitter;
+    taskEXIT_CRITICAL();
+
+    logPutText(&g_line, "PHASE, ");
+    logPutSigned(&g_line, mode, 0U);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, phase->heavy_ops, 0U);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, phase->inter_ops, 0U);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, timingMean(&phase->response), 0U);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, phase->response.max_us, 0U);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, timingMean(&phase->jitter), 0U);
+    logPutText(&g_line, ", ");
+    logPutUnsigned(&g_line, phase->jitter.max_us, 0U);
+    logPutText(&g_line, "\r\n");
+    (void)logLineSendChannel(&g_line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Returns 'value' in percent of 'base'.
+ */
+static uint32_t percentOf(uint32_t value, uint32_t base)
+{
+    return (base == 0U) ? 0U : (uint32_t)(((uint64_t)value * 100U) / base);
+}
+
+/*
+ * Description : Suite task. Runs the overhead scenarios while registered,
+ *               then pins itself above the workload, runs the round robin
+ *               and scheduler phases, checks their figures and sends the
+ *               summary.
+ */
+static void regressTask(void *pvParameters)
+{
+    RegressPhase_t control;
+    RegressPhase_t policy;
+
+    (void)pvParameters;
+
+    logLineInit(&g_line, g_buffer, sizeof(g_buffer));
+    logPutText(&g_line, "\r\n--- REGRESS STARTED ---\r\n");
+    (void)logLineSendChannel(&g_line, LOG_CHANNEL_CSV);
+    logPutText(&g_line, "REGRESS, Scenario, Metric, Value, Limit, Delta, Result\r\n");
+    (void)logLineSendChannel(&g_line, LOG_CHANNEL_CSV);
+
+    runOverhead();
+
+    /* From here on the suite only observes */
+    (void)pinTask(g_regressHandle, REGRESS_PRIORITY);
+
+    if (xTaskCreate(schedulerTask, "Scheduler", REGRESS_SUPERVISOR_STACK_SIZE, NULL,
+                    MLFQ_SUPERVISOR_PRIORITY, &g_supervisorHandle) == pdPASS)
+    {
+        vTaskSuspend(g_supervisorHandle);
+    }
+
+    xTaskCreate(runCPUHeavyTask, "Hog", REGRESS_WORKLOAD_STACK_SIZE, "Hog",
+                REGRESS_CONTROL_PRIORITY, &g_heavyHandle);
+    xTaskCreate(runInteractiveTask, "User", REGRESS_WORKLOAD_STACK_SIZE, "User",
+                REGRESS_CONTROL_PRIORITY, &g_interHandle);
+    xTaskCreate(regressProbe, "Probe", REGRESS_WORKLOAD_STACK_SIZE, NULL,
+                REGRESS_CONTROL_PRIORITY, &g_probeHandle);
+
+    logPutText(&g_line, "PHASE, Mode, Heavy_Ops, Inter_Ops, Response_Mean_us, "
+                        "Response_Max_us, Jitter_Mean_us, Jitter_Max_us\r\n");
+    (void)logLineSendChannel(&g_line, LOG_CHANNEL_CSV);
+
+    runPhase(0, &control);
+    runPhase(1, &policy);
+
+    check("Throughput", "Inter_Ops_Pct", percentOf(policy.inter_ops, control.inter_ops),
+          REGRESS_INTER_OPS_PCT_MIN, false);
+    check("Throughput", "Heavy_Ops_Pct", percentOf(policy.heavy_ops, control.heavy_ops),
+          REGRESS_HEAVY_OPS_PCT_MIN, false);
+    check("Latency", "Response_Mean_us", timingMean(&policy.response),
+          REGRESS_RESPONSE_MEAN_US_MAX, true);
+    check("Latency", "Response_Max_us", policy.response.max_us,
+          REGRESS_RESPONSE_US_MAX, true);
+    check("Jitter", "Release_Max_us", policy.jitter.max_us,
+          REGRESS_JITTER_US_MAX, true);
+
+    /* Same columns as a check: failed checks against a limit of none */
+    logPutText(&g_line, "REGRESS, Summary, Failed, ");
+    logPutUnsigned(&g_line, g_failed, 0U);
+    logPutText(&g_line, ", 0, ");
+    logPutUnsigned(&g_line, g_failed, 0U);
+    logPutText(&g_line, (g_failed == 0U) ? ", PASS\r\n" : ", FAIL\r\n");
+    (void)logLineSendChannel(&g_line, LOG_CHANNEL_CSV);
+
+    logPutText(&g_line, "--- REGRESS DONE (");
+    logPutUnsigned(&g_line, g_checks, 0U);
+    logPutText(&g_line, " checks) ---\r\n");
+    (void)logLineSendChannel(&g_line, LOG_CHANNEL_CSV);
+    vTaskSuspend(NULL);
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * MAIN FUNCTION
+ * Entry point for the regression build. The suite task creates the
+ * supervisor and the workload itself once the overhead scenarios are
+ * done, so nothing else runs while the scheduler's code is timed.
+ */
+int main(void)
+{
+    initClock();
+    initUART();
+    initGPIO();
+
+    initScheduler();
+    initWorkloads();
+    workloadSetResponseHook(responseSample);
+
+    /* Workers start below the High level, so MLFQ_AUTO_REGISTER_ENABLED
+     * leaves them alone; each blocks for good on its first wait */
+    for (uint32_t i = 0U; i < (TICK_PROFILER_MAX_TASKS - 1U); i++)
+    {
+        xTaskCreate(regressWorker, "Worker", REGRESS_WORKER_STACK_SIZE, NULL,
+                    MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_LOW), &g_workers[i]);
+    }
+
+    xTaskCreate(regressTask, "Regress", REGRESS_STACK_SIZE, NULL,
+                MLFQ_SUPERVISOR_PRIORITY, &g_regressHandle);
+
+#if (METRICS_REPORT_ENABLED == 1U)
+    xTaskCreate(metricsLoggerTask, "Logger", METRICS_LOGGER_STACK_SIZE, NULL,
+                METRICS_LOGGER_PRIORITY, NULL);
+#endif
+
+    vTaskStartScheduler();
+
+    /* Should never reach here */
+    while(1);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
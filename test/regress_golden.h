@@ -0,0 +1,70 @@
+/******************************************************************************
+ *  MODULE NAME  : Regression Benchmark Limits
+ *  FILE         : regress_golden.h
+ *  DESCRIPTION  : Golden limits test/regress.c checks each figure
+ *                 against. Figures named _MAX must stay at or below their
+ *                 limit, figures named _MIN at or above it. The values
+ *                 are for the default build on the EK-TM4C123GXL at
+ *                 80 MHz with some headroom; when a release moves a
+ *                 figure on purpose, take the new value from a known-good
+ *                 run and update it here in the same commit.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+#ifndef REGRESS_GOLDEN_H_
+#define REGRESS_GOLDEN_H_
+
+/* Overhead, in core cycles, with TICK_PROFILER_MAX_TASKS registered */
+#ifndef REGRESS_TICK_HOOK_CYCLES_MAX
+#define REGRESS_TICK_HOOK_CYCLES_MAX        600U
+#endif
+
+#ifndef REGRESS_LEVEL_CHANGE_CYCLES_MAX
+#define REGRESS_LEVEL_CHANGE_CYCLES_MAX     2500U
+#endif
+
+#ifndef REGRESS_BOOST_CYCLES_MAX
+#define REGRESS_BOOST_CYCLES_MAX            40000U
+#endif
+
+/* Scalability: tick hook cost with every slot taken, in percent of its
+ * cost with one, and boost cost per registered task */
+#ifndef REGRESS_TICK_HOOK_GROWTH_PCT_MAX
+#define REGRESS_TICK_HOOK_GROWTH_PCT_MAX    150U
+#endif
+
+#ifndef REGRESS_BOOST_CYCLES_PER_TASK_MAX
+#define REGRESS_BOOST_CYCLES_PER_TASK_MAX   2500U
+#endif
+
+/* A/B throughput: ops under the scheduler in percent of the ops under
+ * round robin. The interactive task must not lose; the hog may give
+ * some of its share to it. */
+#ifndef REGRESS_INTER_OPS_PCT_MIN
+#define REGRESS_INTER_OPS_PCT_MIN           100U
+#endif
+
+#ifndef REGRESS_HEAVY_OPS_PCT_MIN
+#define REGRESS_HEAVY_OPS_PCT_MIN           70U
+#endif
+
+/* Response time of the interactive task under the scheduler, in us */
+#ifndef REGRESS_RESPONSE_MEAN_US_MAX
+#define REGRESS_RESPONSE_MEAN_US_MAX        2000U
+#endif
+
+#ifndef REGRESS_RESPONSE_US_MAX
+#define REGRESS_RESPONSE_US_MAX             10000U
+#endif
+
+/* Release lateness of the periodic probe under the scheduler, in us */
+#ifndef REGRESS_JITTER_US_MAX
+#define REGRESS_JITTER_US_MAX               1000U
+#endif
+
+#endif /* REGRESS_GOLDEN_H_ */
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
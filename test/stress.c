@@ -0,0 +1,384 @@
+/******************************************************************************
+ *  MODULE NAME  : Scheduler Scalability Stress Test
+ *  FILE         : stress.c
+ *  DESCRIPTION  : Alternative entry point that ramps a mixed workload from
+ *                 2 up to TICK_PROFILER_MAX_TASKS registered tasks while
+ *                 deleting and re-creating workers continuously, and
+ *                 prints the supervisor's CPU share, the expiry-to-policy
+ *                 latency, the tick hook cost and the work done at each
+ *                 step as CSV. Build it instead of src/main.c, like
+ *                 test/test.c and test/bench.c.
+ *  AUTHOR       : Hassan Darwish
+ *  Date         : October 2026
+ ******************************************************************************/
+
+/******************************************************************************
+ *  INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+
+/* FreeRTOS Includes */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Project Includes */
+#include "scheduler.h"
+#include "metrics_logger.h"
+#include "cycle_counter.h"
+#include "workloads.h"
+#include "drivers.h"
+#include "log_format.h"
+
+/******************************************************************************
+ *  MACRO DEFINITIONS AND CONFIGURATIONS
+ ******************************************************************************/
+
+/* Registered task counts to step through */
+#define STRESS_TASK_COUNTS        { 2U, 4U, 8U, 12U, TICK_PROFILER_MAX_TASKS }
+
+/* Time each step runs before and while it is measured */
+#ifndef STRESS_SETTLE_MS
+#define STRESS_SETTLE_MS          1000U
+#endif
+
+#ifndef STRESS_STEP_MS
+#define STRESS_STEP_MS            5000U
+#endif
+
+/* One worker is deleted and re-created every STRESS_CHURN_MS */
+#ifndef STRESS_CHURN_MS
+#define STRESS_CHURN_MS           50U
+#endif
+
+/* Tick hook calls timed at the end of each step */
+#ifndef STRESS_HOOK_ROUNDS
+#define STRESS_HOOK_ROUNDS        64U
+#endif
+
+/* TICK_PROFILER_MAX_TASKS workers of this size fit in the default heap
+ * next to the supervisor, logger and stress tasks */
+#define STRESS_STACK_SIZE         384U
+#define STRESS_SUPERVISOR_STACK_SIZE 256U
+#define STRESS_WORKER_STACK_SIZE  configMINIMAL_STACK_SIZE
+
+/******************************************************************************
+ *  TYPE DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : One worker class: CPU time per round and the sleep after
+ *               it (0 = only yields).
+ */
+typedef struct
+{
+    uint32_t burst_us;
+    uint32_t block_ms;
+} StressKind_t;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) VARIABLES
+ ******************************************************************************/
+
+/* Workers take the classes in turn: interactive, periodic, CPU hog */
+static const StressKind_t g_kinds[] =
+{
+    { 500U,   5U  },
+    { 2000U,  20U },
+    { 20000U, 0U  },
+};
+
+static TaskHandle_t g_workers[TICK_PROFILER_MAX_TASKS];
+
+/* CPU time of finished bursts per worker position. Only the worker at
+ * that position writes it; a re-created worker carries on counting */
+static volatile uint32_t g_workUs[TICK_PROFILER_MAX_TASKS];
+
+/* Workers alive, and the position replaced next */
+static uint32_t g_live = 0U;
+static uint32_t g_churnNext = 0U;
+
+/******************************************************************************
+ *  STATIC (PRIVATE) FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * Description : Worker body. Runs its class forever; the parameter is its
+ *               position, which also picks the class.
+ */
+static void stressWorker(void *pvParameters)
+{
+    uint32_t index = (uint32_t)(uintptr_t)pvParameters;
+    const StressKind_t *kind = &g_kinds[index % (sizeof(g_kinds) / sizeof(g_kinds[0]))];
+
+    for (;;)
+    {
+        runBurst(kind->burst_us);
+        g_workUs[index] += kind->burst_us;
+
+        if (kind->block_ms == 0U)
+        {
+            taskYIELD();
+        }
+        else
+        {
+            vTaskDelay(pdMS_TO_TICKS(kind->block_ms));
+        }
+    }
+}
+
+/*
+ * Description : Creates the worker at a position and registers it.
+ *               Workers start at the Low priority, so
+ *               MLFQ_AUTO_REGISTER_ENABLED leaves them to registerTask().
+ */
+static bool spawnWorker(uint32_t index)
+{
+    g_workers[index] = NULL;
+
+    if (xTaskCreate(stressWorker, "Worker", STRESS_WORKER_STACK_SIZE,
+                    (void *)(uintptr_t)index,
+                    MLFQ_TO_RTOS_LEVEL_SETTER(MLFQ_QUEUE_LOW), &g_workers[index]) != pdPASS)
+    {
+        g_workers[index] = NULL;
+        return false;
+    }
+
+    registerTask(g_workers[index]);
+    return true;
+}
+
+/*
+ * Description : Deletes the worker at a position and creates a new one in
+ *               its place. Deleting another task frees it at once, so the
+ *               churn does not wait for the idle task.
+ */
+static bool replaceWorker(uint32_t index)
+{
+    if (g_workers[index] != NULL)
+    {
+        unregisterTask(g_workers[index]);
+        vTaskDelete(g_workers[index]);
+    }
+
+    return spawnWorker(index);
+}
+
+/*
+ * Description : Returns the CPU time of all finished bursts; wraps.
+ */
+static uint32_t totalWork(void)
+{
+    uint32_t total = 0U;
+
+    for (uint32_t i = 0U; i < TICK_PROFILER_MAX_TASKS; i++)
+    {
+        total += g_workUs[i];
+    }
+
+    return total;
+}
+
+/*
+ * Description : Returns the sum of every consumer in a CPU time record.
+ */
+static uint64_t cpuTotal(const TickProfilerCpuTime_t *cpu)
+{
+    uint64_t total = cpu->supervisor + cpu->idle + cpu->other;
+
+    for (uint32_t level = 0U; level < MLFQ_NUM_LEVELS; level++)
+    {
+        total += cpu->level[level];
+    }
+
+    return total;
+}
+
+/*
+ * Description : Times the tick hook on the stress task, which is not
+ *               registered, so every call takes the path of a tick that
+ *               lands on an unmanaged task.
+ */
+static void timeTickHook(uint32_t *meanCycles, uint32_t *maxCycles)
+{
+    uint64_t total = 0U;
+
+    *maxCycles = 0U;
+
+    for (uint32_t round = 0U; round < STRESS_HOOK_ROUNDS; round++)
+    {
+        taskENTER_CRITICAL();
+        {
+            uint32_t start = cycleCounterGet();
+            vApplicationTickHook();
+            uint32_t cycles = cycleCounterGet() - start;
+
+            total += cycles;
+            if (cycles > *maxCycles)
+            {
+                *maxCycles = cycles;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    *meanCycles = (uint32_t)(total / STRESS_HOOK_ROUNDS);
+}
+
+/*
+ * Description : Runs one measured step with churn and prints its row.
+ */
+static void measureStep(uint32_t tasks)
+{
+    TickProfilerCpuTime_t before;
+    TickProfilerCpuTime_t after;
+    MLFQ_ExpiryLatencyStats_t expiry;
+    uint32_t churned = 0U;
+    uint32_t failed = 0U;
+    uint32_t hookMean;
+    uint32_t hookMax;
+    char buffer[128];
+    LogLine_t line;
+
+    uint32_t workBefore = totalWork();
+    tickProfilerGetCpuTime(&before);
+    schedulerResetExpiryLatencyStats();
+
+    TickType_t start = xTaskGetTickCount();
+    while ((xTaskGetTickCount() - start) < pdMS_TO_TICKS(STRESS_STEP_MS))
+    {
+        vTaskDelay(pdMS_TO_TICKS(STRESS_CHURN_MS));
+
+        if (!replaceWorker(g_churnNext))
+        {
+            failed++;
+        }
+        churned++;
+        g_churnNext = (g_churnNext + 1U) % tasks;
+    }
+
+    tickProfilerGetCpuTime(&after);
+    schedulerGetExpiryLatencyStats(&expiry);
+    uint32_t work = totalWork() - workBefore;
+
+    /* After the window, so the extra calls are not in the figures above */
+    timeTickHook(&hookMean, &hookMax);
+
+    uint64_t cpu = cpuTotal(&after) - cpuTotal(&before);
+    uint64_t supervisor = after.supervisor - before.supervisor;
+
+    logLineInit(&line, buffer, sizeof(buffer));
+    logPutText(&line, "STRESS, ");
+    logPutUnsigned(&line, tasks, 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, churned, 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, failed, 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, (cpu == 0U) ? 0U : (uint32_t)((supervisor * 1000U) / cpu), 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, expiry.count, 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, (expiry.count == 0U) ? 0U :
+                   (uint32_t)(expiry.total_cycles / expiry.count), 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, expiry.max_cycles, 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, hookMean, 0U);
+    logPutText(&line, ", ");
+    logPutUnsigned(&line, hookMax, 0U);
+    logPutText(&line, ", ");
+    /* Share of the CPU spent in workload bursts: us of work per ms */
+    logPutUnsigned(&line, work / STRESS_STEP_MS, 0U);
+    logPutText(&line, "\r\n");
+    (void)logLineSendChannel(&line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Stress task. Grows the worker set to each task count,
+ *               lets it settle, then measures a step with churn.
+ */
+static void stressTask(void *pvParameters)
+{
+    static const uint32_t counts[] = STRESS_TASK_COUNTS;
+    char buffer[128];
+    LogLine_t line;
+
+    (void)pvParameters;
+
+    logLineInit(&line, buffer, sizeof(buffer));
+    logPutText(&line, "\r\n--- STRESS STARTED ---\r\n");
+    (void)logLineSendChannel(&line, LOG_CHANNEL_CSV);
+    logPutText(&line, "STRESS, Tasks, Churned, Failed, Supervisor_Permille, Expiries, "
+                      "Expiry_Mean_Cycles, Expiry_Max_Cycles, Hook_Mean_Cycles, "
+                      "Hook_Max_Cycles, Work_Permille\r\n");
+    (void)logLineSendChannel(&line, LOG_CHANNEL_CSV);
+
+    for (uint32_t step = 0U; step < (sizeof(counts) / sizeof(counts[0])); step++)
+    {
+        uint32_t tasks = counts[step];
+
+        /* Skip counts the table cannot hold or that were already done */
+        if ((tasks > TICK_PROFILER_MAX_TASKS) || (tasks <= g_live))
+        {
+            continue;
+        }
+
+        while (g_live < tasks)
+        {
+            (void)spawnWorker(g_live);
+            g_live++;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(STRESS_SETTLE_MS));
+        measureStep(tasks);
+    }
+
+    logPutText(&line, "--- STRESS DONE ---\r\n");
+    (void)logLineSendChannel(&line, LOG_CHANNEL_CSV);
+    vTaskSuspend(NULL);
+}
+
+/******************************************************************************
+ *  FUNCTION DEFINITIONS
+ ******************************************************************************/
+
+/*
+ * MAIN FUNCTION
+ * Entry point for the stress build. Unlike the bench, the supervisor runs
+ * as usual, so demotions, boosts and reports cost what they cost in the
+ * field. The stress task shares the supervisor's priority and sleeps
+ * between churn events.
+ */
+int main(void)
+{
+    initClock();
+    initUART();
+    initGPIO();
+
+    initScheduler();
+    initWorkloads();
+
+#if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+    (void)schedulerStartTimerSupervisor();
+#else
+    xTaskCreate(schedulerTask, "Scheduler", STRESS_SUPERVISOR_STACK_SIZE, NULL,
+                MLFQ_SUPERVISOR_PRIORITY, NULL);
+#endif
+
+    xTaskCreate(stressTask, "Stress", STRESS_STACK_SIZE, NULL,
+                MLFQ_SUPERVISOR_PRIORITY, NULL);
+
+#if (METRICS_REPORT_ENABLED == 1U)
+    xTaskCreate(metricsLoggerTask, "Logger", METRICS_LOGGER_STACK_SIZE, NULL,
+                METRICS_LOGGER_PRIORITY, NULL);
+#endif
+
+    vTaskStartScheduler();
+
+    /* Should never reach here */
+    while(1);
+}
+
+/******************************************************************************
+ *  END OF FILE
+ ******************************************************************************/
@@ -5,7 +5,6 @@
  ******************************************************************************/
 
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 
 /* FreeRTOS Includes */
@@ -17,17 +16,1585 @@
 #include "workloads.h"    // CPU Heavy & Interactive Tasks
 #include "test_config.h"  // Switches between Test Modes (0 or 1)
 #include "drivers.h"      // Tiva-C UART & GPIO Drivers
+#include "switch_stats.h" // Context switch cost (SWITCH_STATS_ENABLED)
+#include "log_format.h"   // CSV lines without snprintf()
+#if (TEST_JITTER_ENABLED == 1) || (TEST_SOAK_ENABLED == 1) || (TEST_RESPONSE_ENABLED == 1)
+#include "tm4c123gh6pm.h" // SysTick registers for the release timing
+#endif
+#include "cycle_counter.h" // Monitor run time and interrupt latencies
+#include "irq_stats.h"     // Tick interrupt time (TEST_TICK_BENCH_ENABLED)
+
+/* Stack sizes in words. Lines are built with log_format.h rather than
+ * snprintf(), and the supervisor does no formatting at all */
+#define TEST_MONITOR_STACK_SIZE     256
+#define TEST_SCHEDULER_STACK_SIZE   256
 
 /* Task Handles */
 TaskHandle_t xHeavyHandle = NULL;
 TaskHandle_t xInteractHandle = NULL;
 TaskHandle_t hSchedulerTask     = NULL;
+#if (TEST_ECHO_ENABLED == 1)
+TaskHandle_t xEchoHandle = NULL;
+#endif
+#if (TEST_BUTTON_ENABLED == 1)
+TaskHandle_t xButtonHandle = NULL;
+#endif
+#if (TEST_SOAK_ENABLED == 1)
+TaskHandle_t xProbeHandle = NULL;
+#endif
+TaskHandle_t xMonitorHandle = NULL;
+
+/* Mode the CSV lines are tagged with; changes at run time in A/B builds */
+static volatile int g_activeMode = TEST_MODE;
+
+#if ((TEST_WORKLOAD_REPLAY == 1) && (TEST_WORKLOAD_MIX != 1))
+#error "TEST_WORKLOAD_REPLAY needs TEST_WORKLOAD_MIX"
+#endif
+
+/* The sweep changes the scheduler's parameters under one steady mode */
+#if (TEST_SWEEP_ENABLED == 1) && ((TEST_MODE != 1) || (TEST_AB_SWITCH_ENABLED == 1) || (TEST_SOAK_ENABLED == 1))
+#error "TEST_SWEEP_ENABLED needs TEST_MODE 1 without A/B switching or soak"
+#endif
+#if (TEST_SWEEP_ENABLED == 1) && ((TEST_SWEEP_SETTLE_S < 1U) || (TEST_SWEEP_WINDOW_S < 1U))
+#error "TEST_SWEEP_SETTLE_S and TEST_SWEEP_WINDOW_S must be at least 1"
+#endif
+
+/* The tick-rate benchmark reads the tick interrupt and switch counters */
+#if (TEST_TICK_BENCH_ENABLED == 1)
+#if (TEST_AB_SWITCH_ENABLED == 1) || (TEST_SOAK_ENABLED == 1) || (TEST_SWEEP_ENABLED == 1)
+#error "TEST_TICK_BENCH_ENABLED needs one steady mode, without soak or sweep"
+#endif
+#if (IRQ_STATS_TICK_ENABLED == 0U) || (SWITCH_STATS_ENABLED == 0U)
+#error "TEST_TICK_BENCH_ENABLED needs IRQ_STATS_TICK_ENABLED and SWITCH_STATS_ENABLED"
+#endif
+#if (TEST_TICK_BENCH_SETTLE_S < 1U) || (TEST_TICK_BENCH_WINDOW_S < 1U)
+#error "TEST_TICK_BENCH_SETTLE_S and TEST_TICK_BENCH_WINDOW_S must be at least 1"
+#endif
+#endif
+
+/* The monitor must sit in the real-time band, where pinTask() accepts it
+ * and no MLFQ level or control group task runs */
+#if (TEST_MONITOR_PRIORITY < MLFQ_RT_PRIORITY_MIN) || (TEST_MONITOR_PRIORITY > MLFQ_RT_PRIORITY_MAX)
+#error "TEST_MONITOR_PRIORITY must be in the real-time band (MLFQ_RT_BAND_SIZE > 0)"
+#endif
+
+#if (TEST_ECHO_ENABLED == 1) && LOG_SINK_USED(LOG_SINK_UART1)
+#error "TEST_ECHO_ENABLED needs UART1, which a LOG_ROUTE_x gives to the log"
+#endif
+
+/* The A/B switch suspends the supervisor task, which the timer service
+ * task cannot stand in for */
+#if (TEST_AB_SWITCH_ENABLED == 1) && (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+#error "TEST_AB_SWITCH_ENABLED needs the supervisor task (configUSE_MLFQ_TIMER_SUPERVISOR 0)"
+#endif
+
+#if (TEST_WORKLOAD_MIX == 1)
+#if (TEST_WORKLOAD_REPLAY == 1)
+/* Recorded tasks, one generator task each */
+#include "replay_trace.h"
+#define TEST_MIX_TASKS REPLAY_TRACE_TASKS
+#else
+/* Generator tasks of the mix, one class after the other */
+#define TEST_MIX_TASKS (TEST_MIX_SENSORS + TEST_MIX_NETWORK + TEST_MIX_COMPRESSION)
+#endif
+static WorkloadTask_t g_mix[TEST_MIX_TASKS];
+static TaskHandle_t g_mixHandles[TEST_MIX_TASKS];
+
+/*
+ * Description : Creates the generator tasks of the mix at one priority
+ *               and optionally registers them with the scheduler.
+ */
+static void createMix(UBaseType_t priority, int registerTasks)
+{
+    for (uint32_t i = 0; i < TEST_MIX_TASKS; i++)
+    {
+        TaskHandle_t handle = NULL;
+        const char *name;
+
+        #if (TEST_WORKLOAD_REPLAY == 1)
+        g_mix[i].replay = &g_replayTrace[i];
+        name = g_replayTrace[i].name;
+        #else
+        if (i < TEST_MIX_SENSORS)
+            g_mix[i].descriptor = &g_workloadPeriodicSensor;
+        else if (i < (TEST_MIX_SENSORS + TEST_MIX_NETWORK))
+            g_mix[i].descriptor = &g_workloadBurstyNetwork;
+        else
+            g_mix[i].descriptor = &g_workloadBackgroundCompression;
+
+        g_mix[i].seed = i + 1U;
+        name = g_mix[i].descriptor->name;
+        #endif
+
+        if ((xTaskCreate(runWorkloadTask, name, TEST_MIX_STACK_SIZE,
+                         &g_mix[i], priority, &handle) == pdPASS) && registerTasks)
+        {
+            registerTask(handle);
+        }
+        g_mixHandles[i] = handle;
+    }
+}
+
+/*
+ * Description : Returns the bursts completed by every task of a class,
+ *               or by every task of the mix for a NULL class.
+ */
+static uint32_t mixBursts(const WorkloadDescriptor_t *descriptor)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < TEST_MIX_TASKS; i++)
+    {
+        if ((descriptor == NULL) || (g_mix[i].descriptor == descriptor))
+            total += g_mix[i].bursts;
+    }
+    return total;
+}
+#endif
+
+#if (TEST_DSP_ENABLED == 1)
+/* DSP benchmark tasks, one per kernel */
+#define TEST_DSP_TASKS 3U
+static TaskHandle_t g_dspHandles[TEST_DSP_TASKS];
+
+/*
+ * Description : Creates the DSP benchmark tasks at one priority and
+ *               optionally registers them with the scheduler. Each task
+ *               is named after its kernel, which labels its counter.
+ */
+static void createDspTasks(UBaseType_t priority, int registerTasks)
+{
+    static const TaskFunction_t code[TEST_DSP_TASKS] = { runFirTask, runFftTask, runCrcTask };
+    static const char *const names[TEST_DSP_TASKS] = { "FIR", "FFT", "CRC" };
+
+    for (uint32_t i = 0; i < TEST_DSP_TASKS; i++)
+    {
+        if ((xTaskCreate(code[i], names[i], TEST_DSP_STACK_SIZE, (void *)names[i],
+                         priority, &g_dspHandles[i]) == pdPASS) && registerTasks)
+        {
+            registerTask(g_dspHandles[i]);
+        }
+    }
+}
+#endif
+
+#if (TEST_ADC_ENABLED == 1)
+static TaskHandle_t g_adcHandles[WORKLOAD_ADC_STAGES];
+
+/*
+ * Description : Creates both tasks of the ADC sampling pipeline and
+ *               optionally registers them with the scheduler.
+ */
+static void createAdcTasks(UBaseType_t priority, int registerTasks)
+{
+    static const char *const names[WORKLOAD_ADC_STAGES] = { "AdcHandler", "AdcAggregate" };
+    static const TaskFunction_t code[WORKLOAD_ADC_STAGES] = { runAdcHandlerTask, runAdcAggregateTask };
+
+    for (uint32_t i = 0; i < WORKLOAD_ADC_STAGES; i++) {
+        if ((xTaskCreate(code[i], names[i], TEST_ADC_STACK_SIZE, (void *)names[i],
+                         priority, &g_adcHandles[i]) == pdPASS) && registerTasks)
+        {
+            registerTask(g_adcHandles[i]);
+        }
+    }
+}
+#endif
+
+#if (TEST_PIPELINE_ENABLED == 1)
+static TaskHandle_t g_pipelineHandles[WORKLOAD_PIPELINE_STAGES];
+
+/*
+ * Description : Creates the queues and one task per stage of the queue
+ *               pipeline and optionally registers the tasks with the
+ *               scheduler.
+ */
+static void createPipelineTasks(UBaseType_t priority, int registerTasks)
+{
+    if (!workloadInitPipeline())
+        return;
+
+    for (uint32_t i = 0; i < WORKLOAD_PIPELINE_STAGES; i++) {
+        if ((xTaskCreate(runPipelineStageTask, "Pipe", TEST_PIPELINE_STACK_SIZE,
+                         (void *)(uintptr_t)i, priority, &g_pipelineHandles[i]) == pdPASS) &&
+            registerTasks)
+        {
+            registerTask(g_pipelineHandles[i]);
+        }
+    }
+}
+#endif
+
+#if (TEST_COPY_ENABLED == 1)
+static TaskHandle_t g_copyHandle = NULL;
+
+/*
+ * Description : Creates the copy benchmark task of the TEST_COPY_DMA
+ *               variant and optionally registers it with the scheduler.
+ */
+static void createCopyTask(UBaseType_t priority, int registerTasks)
+{
+    #if (TEST_COPY_DMA == 1)
+    static const char name[] = "DmaCopy";
+    TaskFunction_t code = runDmaCopyTask;
+    #else
+    static const char name[] = "CpuCopy";
+    TaskFunction_t code = runCpuCopyTask;
+    #endif
+
+    if ((xTaskCreate(code, name, TEST_COPY_STACK_SIZE, (void *)name,
+                     priority, &g_copyHandle) == pdPASS) && registerTasks)
+    {
+        registerTask(g_copyHandle);
+    }
+}
+#endif
+
+/*
+ * Description : Returns the MLFQ level a task's priority belongs to, or
+ *               MLFQ_NUM_LEVELS when it is outside the levels (control
+ *               group, pinned or inheriting a priority).
+ */
+static uint32_t levelOfTask(void *task)
+{
+    UBaseType_t priority = uxTaskPriorityGet((TaskHandle_t)task);
+
+    for (uint32_t level = 0; level < MLFQ_NUM_LEVELS; level++)
+    {
+        if (MLFQ_TO_RTOS_LEVEL_SETTER(level) == priority)
+            return level;
+    }
+    #if (MLFQ_RESERVE_ENABLED == 1U)
+    if (priority == MLFQ_RESERVE_PRIORITY)
+        return MLFQ_QUEUE_LOW;
+    #endif
+    return MLFQ_NUM_LEVELS;
+}
+
+/*
+ * Description : Sends one CSV row per task with its work units over the
+ *               last second, from the monitor's snapshot, then one row
+ *               with the units of each level. A task's units go to the
+ *               level it is at when sampled.
+ */
+static void reportTaskWork(LogLine_t *line, int mode, uint32_t count,
+                           const uint32_t *units, uint32_t *last_units)
+{
+    uint32_t level_ops[MLFQ_NUM_LEVELS] = { 0 };
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const WorkloadCounter_t *counter = workloadGetCounter(i);
+        uint32_t ops = units[i] - last_units[i];
+        uint32_t level = levelOfTask(counter->task);
+
+        last_units[i] = units[i];
+
+        logPutText(line, "Task, ");
+        logPutSigned(line, mode, 0);
+        logPutText(line, ", ");
+        logPutText(line, counter->name);
+        logPutText(line, ", ");
+        if (level < MLFQ_NUM_LEVELS) {
+            logPutUnsigned(line, level, 0);
+            level_ops[level] += ops;
+        } else {
+            logPutText(line, "-");
+        }
+        logPutText(line, ", ");
+        logPutUnsigned(line, ops, 0);
+        logPutText(line, "\r\n");
+        logLineSendChannel(line, LOG_CHANNEL_CSV);
+    }
+
+    logPutText(line, "Level, ");
+    logPutSigned(line, mode, 0);
+    for (uint32_t level = 0; level < MLFQ_NUM_LEVELS; level++)
+    {
+        logPutText(line, ", ");
+        logPutUnsigned(line, level_ops[level], 0);
+    }
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+
+#if (TEST_JITTER_ENABLED == 1) || (TEST_SOAK_ENABLED == 1) || (TEST_RESPONSE_ENABLED == 1)
+/*
+ * Description : Returns the cycles since 'tick' started. SysTick counts
+ *               each tick down from its reload value, so whole ticks
+ *               since then plus the part of the current one gives the
+ *               time at cycle resolution. A tick that has fired but is
+ *               still pending counts as started.
+ */
+static uint32_t cyclesSinceTick(TickType_t tick)
+{
+    uint32_t elapsed;
+
+    taskENTER_CRITICAL();
+    {
+        TickType_t now = xTaskGetTickCount();
+        uint32_t reload = NVIC_ST_RELOAD_R;
+        uint32_t current = NVIC_ST_CURRENT_R;
+
+        if ((NVIC_INT_CTRL_R & NVIC_INT_CTRL_PENDSTSET) != 0U) {
+            /* The counter has reloaded; read it again past the wrap */
+            now++;
+            current = NVIC_ST_CURRENT_R;
+        }
+        elapsed = ((uint32_t)(now - tick) * (reload + 1U)) + (reload - current);
+    }
+    taskEXIT_CRITICAL();
+
+    return elapsed;
+}
+#endif
+
+#if (TEST_JITTER_ENABLED == 1)
+/* Buckets of the release jitter histogram; each holds the releases up to
+ * its edge in microseconds, the last one everything later */
+#define TEST_JITTER_BUCKETS 10U
+static const uint32_t g_jitterEdgesUs[TEST_JITTER_BUCKETS - 1U] =
+    { 10U, 20U, 50U, 100U, 200U, 500U, 1000U, 2000U, 5000U };
+
+/*
+ * Description : Release timing of one periodic task since the monitor
+ *               last read it.
+ */
+typedef struct
+{
+    TaskHandle_t handle;
+    uint32_t period_ms;
+    uint32_t samples;
+    uint32_t max_us;
+    uint32_t buckets[TEST_JITTER_BUCKETS];
+} JitterStats_t;
+
+static const uint32_t g_jitterPeriodsMs[TEST_JITTER_TASKS] = TEST_JITTER_PERIODS_MS;
+static JitterStats_t g_jitter[TEST_JITTER_TASKS];
+
+/*
+ * Description : Periodic task. After each vTaskDelayUntil() the nominal
+ *               release is the tick it returns in 'release', so the
+ *               lateness is the time since that tick began.
+ */
+static void vJitterTask(void *pvParameters)
+{
+    JitterStats_t *stats = (JitterStats_t *)pvParameters;
+    const TickType_t period = pdMS_TO_TICKS(stats->period_ms);
+    TickType_t release = xTaskGetTickCount();
+
+    for (;;)
+    {
+        vTaskDelayUntil(&release, (period == 0U) ? 1U : period);
+
+        uint32_t late_us = cyclesSinceTick(release) / (configCPU_CLOCK_HZ / 1000000U);
+        uint32_t bucket = 0;
+
+        while ((bucket < (TEST_JITTER_BUCKETS - 1U)) && (late_us > g_jitterEdgesUs[bucket]))
+            bucket++;
+
+        taskENTER_CRITICAL();
+        stats->samples++;
+        stats->buckets[bucket]++;
+        if (late_us > stats->max_us)
+            stats->max_us = late_us;
+        taskEXIT_CRITICAL();
+
+        runBurst(TEST_JITTER_WORK_US);
+    }
+}
+
+/*
+ * Description : Creates the periodic tasks at one priority and optionally
+ *               registers them with the scheduler.
+ */
+static void createJitterTasks(UBaseType_t priority, int registerTasks)
+{
+    for (uint32_t i = 0; i < TEST_JITTER_TASKS; i++)
+    {
+        g_jitter[i].period_ms = g_jitterPeriodsMs[i];
+
+        if ((xTaskCreate(vJitterTask, "Periodic", TEST_JITTER_STACK_SIZE,
+                         &g_jitter[i], priority, &g_jitter[i].handle) == pdPASS) && registerTasks)
+        {
+            registerTask(g_jitter[i].handle);
+        }
+    }
+}
+
+/*
+ * Description : Sends one CSV row per periodic task with the releases of
+ *               the last second: period, level, samples, worst lateness
+ *               and the histogram. Starts the next window from empty.
+ */
+static void reportJitter(LogLine_t *line, int mode)
+{
+    for (uint32_t i = 0; i < TEST_JITTER_TASKS; i++)
+    {
+        JitterStats_t window;
+
+        taskENTER_CRITICAL();
+        window = g_jitter[i];
+        g_jitter[i].samples = 0;
+        g_jitter[i].max_us = 0;
+        memset(g_jitter[i].buckets, 0, sizeof(g_jitter[i].buckets));
+        taskEXIT_CRITICAL();
+
+        uint32_t level = (window.handle != NULL) ? levelOfTask(window.handle) : MLFQ_NUM_LEVELS;
+
+        logPutText(line, "Jitter, ");
+        logPutSigned(line, mode, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.period_ms, 0);
+        logPutText(line, ", ");
+        if (level < MLFQ_NUM_LEVELS)
+            logPutUnsigned(line, level, 0);
+        else
+            logPutText(line, "-");
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.samples, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.max_us, 0);
+        for (uint32_t bucket = 0; bucket < TEST_JITTER_BUCKETS; bucket++)
+        {
+            logPutText(line, ", ");
+            logPutUnsigned(line, window.buckets[bucket], 0);
+        }
+        logPutText(line, "\r\n");
+        logLineSendChannel(line, LOG_CHANNEL_CSV);
+    }
+}
+#endif
+
+#if (TEST_ECHO_ENABLED == 1)
+/*
+ * Description : Sends one CSV row with the echo workload's receive-to-
+ *               answer times over the last second, in microseconds.
+ */
+static void reportEcho(LogLine_t *line, int mode)
+{
+    const uint32_t cyclesPerUs = configCPU_CLOCK_HZ / 1000000U;
+    WorkloadEchoStats_t window;
+
+    workloadTakeEchoStats(&window);
+
+    uint32_t level = (xEchoHandle != NULL) ? levelOfTask(xEchoHandle) : MLFQ_NUM_LEVELS;
+
+    logPutText(line, "Echo, ");
+    logPutSigned(line, mode, 0);
+    logPutText(line, ", ");
+    if (level < MLFQ_NUM_LEVELS)
+        logPutUnsigned(line, level, 0);
+    else
+        logPutText(line, "-");
+    logPutText(line, ", ");
+    logPutUnsigned(line, window.samples, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (window.samples == 0U) ? 0U : (window.min_cycles / cyclesPerUs), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (window.samples == 0U) ? 0U :
+                   (uint32_t)(window.total_cycles / window.samples / cyclesPerUs), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, window.max_cycles / cyclesPerUs, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, getEchoDroppedBytes(), 0);
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+#endif
+
+#if (TEST_ADC_ENABLED == 1)
+/*
+ * Description : Sends one CSV row per stage of the ADC pipeline with the
+ *               half-buffers it finished over the last second and their
+ *               latency from the half filling, in microseconds.
+ */
+static void reportAdc(LogLine_t *line, int mode)
+{
+    static const char *const stages[WORKLOAD_ADC_STAGES] = { "Handler", "Aggregate" };
+    const uint32_t cyclesPerUs = configCPU_CLOCK_HZ / 1000000U;
+    WorkloadAdcStats_t window;
+
+    workloadTakeAdcStats(&window);
+
+    for (uint32_t stage = 0; stage < WORKLOAD_ADC_STAGES; stage++) {
+        const WorkloadEchoStats_t *times = &window.stage[stage];
+        uint32_t level = (g_adcHandles[stage] != NULL) ? levelOfTask(g_adcHandles[stage])
+                                                       : MLFQ_NUM_LEVELS;
+
+        logPutText(line, "Adc, ");
+        logPutSigned(line, mode, 0);
+        logPutText(line, ", ");
+        logPutText(line, stages[stage]);
+        logPutText(line, ", ");
+        if (level < MLFQ_NUM_LEVELS)
+            logPutUnsigned(line, level, 0);
+        else
+            logPutText(line, "-");
+        logPutText(line, ", ");
+        logPutUnsigned(line, WORKLOAD_ADC_BATCH, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, times->samples, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, (times->samples == 0U) ? 0U : (times->min_cycles / cyclesPerUs), 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, (times->samples == 0U) ? 0U :
+                       (uint32_t)(times->total_cycles / times->samples / cyclesPerUs), 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, times->max_cycles / cyclesPerUs, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.overruns, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.dropped, 0);
+        logPutText(line, "\r\n");
+        logLineSendChannel(line, LOG_CHANNEL_CSV);
+    }
+}
+#endif
+
+#if (TEST_PIPELINE_ENABLED == 1)
+/*
+ * Description : Sends the latency fields of one queue pipeline row,
+ *               from core cycles to microseconds.
+ */
+static void putPipelineLatency(LogLine_t *line, const WorkloadEchoStats_t *times)
+{
+    const uint32_t cyclesPerUs = configCPU_CLOCK_HZ / 1000000U;
+
+    logPutUnsigned(line, (times->samples == 0U) ? 0U : (times->min_cycles / cyclesPerUs), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (times->samples == 0U) ? 0U :
+                   (uint32_t)(times->total_cycles / times->samples / cyclesPerUs), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, times->max_cycles / cyclesPerUs, 0);
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Sends one CSV row per stage of the queue pipeline with
+ *               the items it passed on over the last second, the mean
+ *               and peak depth of its input queue, and its item latency,
+ *               then an "End" row with the items retired and their time
+ *               from being made.
+ */
+static void reportPipeline(LogLine_t *line, int mode)
+{
+    WorkloadPipelineStats_t window;
+
+    workloadTakePipelineStats(&window);
+
+    for (uint32_t stage = 0; stage < WORKLOAD_PIPELINE_STAGES; stage++) {
+        const WorkloadPipelineStage_t *stats = &window.stage[stage];
+        uint32_t items = stats->latency.samples;
+        uint32_t depth = (items == 0U) ? 0U : ((stats->depth_total * 100U) / items);
+        uint32_t level = (g_pipelineHandles[stage] != NULL) ? levelOfTask(g_pipelineHandles[stage])
+                                                            : MLFQ_NUM_LEVELS;
+
+        logPutText(line, "Pipeline, ");
+        logPutSigned(line, mode, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, stage, 0);
+        logPutText(line, ", ");
+        if (level < MLFQ_NUM_LEVELS)
+            logPutUnsigned(line, level, 0);
+        else
+            logPutText(line, "-");
+        logPutText(line, ", ");
+        logPutUnsigned(line, items, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, depth / 100U, 0);
+        logPutText(line, ".");
+        logPutUnsignedZero(line, depth % 100U, 2);
+        logPutText(line, ", ");
+        logPutUnsigned(line, stats->depth_max, 0);
+        logPutText(line, ", ");
+        putPipelineLatency(line, &stats->latency);
+    }
+
+    logPutText(line, "Pipeline, ");
+    logPutSigned(line, mode, 0);
+    logPutText(line, ", End, -, ");
+    logPutUnsigned(line, window.end_to_end.samples, 0);
+    logPutText(line, ", -, -, ");
+    putPipelineLatency(line, &window.end_to_end);
+}
+#endif
+
+#if (TEST_BUTTON_ENABLED == 1)
+/*
+ * Description : Interrupt-to-handler latency of the switch presses
+ *               handled at one level since the monitor last read it.
+ */
+typedef struct
+{
+    uint32_t presses;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+} ButtonStats_t;
+
+/* One entry per level, the last for presses handled outside the levels */
+static ButtonStats_t g_button[MLFQ_NUM_LEVELS + 1U];
+
+/*
+ * Description : Resets the figures of one level for the next window.
+ */
+static void resetButtonStats(ButtonStats_t *stats)
+{
+    stats->presses = 0;
+    stats->min_us = UINT32_MAX;
+    stats->max_us = 0;
+    stats->total_us = 0;
+}
+
+/*
+ * Description : Button handler task. Sleeps until the Port F interrupt
+ *               takes a press, then charges the time since that
+ *               interrupt to the level the task is at as it runs, and
+ *               handles the press for TEST_BUTTON_WORK_US.
+ */
+static void vButtonTask(void *pvParameters)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    uint32_t pin;
+    uint32_t stamp;
+
+    (void)pvParameters;
+
+    for (uint32_t level = 0; level <= MLFQ_NUM_LEVELS; level++)
+        resetButtonStats(&g_button[level]);
+
+    initButtons(self);
+
+    for (;;)
+    {
+        /* A plain notification wait unless the task is a bottom half */
+        (void)schedulerBottomHalfWait(portMAX_DELAY);
+
+        while (takeButtonEvent(&pin, &stamp))
+        {
+            uint32_t late_us = (cycleCounterGet() - stamp) / (configCPU_CLOCK_HZ / 1000000U);
+            ButtonStats_t *stats = &g_button[levelOfTask(self)];
+
+            taskENTER_CRITICAL();
+            stats->presses++;
+            stats->total_us += late_us;
+            if (late_us < stats->min_us)
+                stats->min_us = late_us;
+            if (late_us > stats->max_us)
+                stats->max_us = late_us;
+            taskEXIT_CRITICAL();
+
+            runBurst(TEST_BUTTON_WORK_US);
+        }
+    }
+}
+
+/*
+ * Description : Sends one CSV row per level that handled presses in the
+ *               last second, and starts the next window from empty.
+ */
+static void reportButtons(LogLine_t *line, int mode)
+{
+    for (uint32_t level = 0; level <= MLFQ_NUM_LEVELS; level++)
+    {
+        ButtonStats_t window;
+
+        taskENTER_CRITICAL();
+        window = g_button[level];
+        resetButtonStats(&g_button[level]);
+        taskEXIT_CRITICAL();
+
+        if (window.presses == 0U)
+            continue;
+
+        logPutText(line, "Button, ");
+        logPutSigned(line, mode, 0);
+        logPutText(line, ", ");
+        if (level < MLFQ_NUM_LEVELS)
+            logPutUnsigned(line, level, 0);
+        else
+            logPutText(line, "-");
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.presses, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.min_us, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, (uint32_t)(window.total_us / window.presses), 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.max_us, 0);
+        logPutText(line, ", ");
+        logPutUnsigned(line, getButtonDroppedEvents(), 0);
+        logPutText(line, "\r\n");
+        logLineSendChannel(line, LOG_CHANNEL_CSV);
+    }
+}
+#endif
+
+#if (TEST_IRQ_LATENCY_ENABLED == 1)
+/* Buckets of the interrupt latency histogram in core cycles, like the
+ * jitter buckets: up to each edge, the last one everything later */
+#define TEST_IRQ_BUCKETS 8U
+static const uint32_t g_irqEdgesCycles[TEST_IRQ_BUCKETS - 1U] =
+    { 50U, 100U, 200U, 500U, 1000U, 2000U, 4000U };
+
+#define TEST_IRQ_PERIOD_CYCLES (configCPU_CLOCK_HZ / TEST_IRQ_LATENCY_HZ)
+
+/*
+ * Description : Trigger-to-handler latency of the benchmark interrupt
+ *               since the monitor last read it.
+ */
+typedef struct
+{
+    uint32_t samples;
+    uint32_t missed;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t buckets[TEST_IRQ_BUCKETS];
+} IrqLatencyStats_t;
+
+static IrqLatencyStats_t g_irqLatency = { 0U, 0U, UINT32_MAX, 0U, 0U, { 0U } };
+
+/* Cycle count at the previous timeout, to spot timeouts that merged */
+static uint32_t g_irqLastTrigger = 0U;
+static int g_irqTriggerValid = 0;
+
+/*
+ * Description : Latency timer hook, in the interrupt. A handler held off
+ *               for longer than a period merges two timeouts and reads
+ *               the counter past its second reload, so the sample is
+ *               wrong; such timeouts show up as a gap of more than one
+ *               period between triggers and are counted as missed.
+ */
+static void irqLatencySample(uint32_t lateCycles)
+{
+    uint32_t trigger = cycleCounterGet() - lateCycles;
+    uint32_t bucket = 0;
+
+    if (g_irqTriggerValid) {
+        uint32_t gap = trigger - g_irqLastTrigger;
+
+        if (gap > (TEST_IRQ_PERIOD_CYCLES + (TEST_IRQ_PERIOD_CYCLES / 2U)))
+            g_irqLatency.missed += ((gap + (TEST_IRQ_PERIOD_CYCLES / 2U)) / TEST_IRQ_PERIOD_CYCLES) - 1U;
+    }
+    g_irqLastTrigger = trigger;
+    g_irqTriggerValid = 1;
+
+    while ((bucket < (TEST_IRQ_BUCKETS - 1U)) && (lateCycles > g_irqEdgesCycles[bucket]))
+        bucket++;
+
+    g_irqLatency.samples++;
+    g_irqLatency.total_cycles += lateCycles;
+    g_irqLatency.buckets[bucket]++;
+    if (lateCycles < g_irqLatency.min_cycles)
+        g_irqLatency.min_cycles = lateCycles;
+    if (lateCycles > g_irqLatency.max_cycles)
+        g_irqLatency.max_cycles = lateCycles;
+}
+
+/*
+ * Description : Sends one CSV row with the interrupt latency of the last
+ *               second and starts the next window from empty. The
+ *               critical section masks the benchmark interrupt, so the
+ *               copy is consistent.
+ */
+static void reportIrqLatency(LogLine_t *line, int mode)
+{
+    IrqLatencyStats_t window;
+
+    taskENTER_CRITICAL();
+    window = g_irqLatency;
+    memset(&g_irqLatency, 0, sizeof(g_irqLatency));
+    g_irqLatency.min_cycles = UINT32_MAX;
+    taskEXIT_CRITICAL();
+
+    logPutText(line, "IrqLatency, ");
+    logPutSigned(line, mode, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, window.samples, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, window.missed, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (window.samples == 0U) ? 0U : window.min_cycles, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (window.samples == 0U) ? 0U :
+                   (uint32_t)(window.total_cycles / window.samples), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, window.max_cycles, 0);
+    for (uint32_t bucket = 0; bucket < TEST_IRQ_BUCKETS; bucket++)
+    {
+        logPutText(line, ", ");
+        logPutUnsigned(line, window.buckets[bucket], 0);
+    }
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+#endif
+
+#if (TEST_SOAK_ENABLED == 1) || (TEST_RESPONSE_ENABLED == 1)
+/* Soak and response histograms: values below 8 exactly, then four
+ * buckets per power of two up to 2^24, so a percentile is within 25 % of
+ * the true value. The last bucket also collects everything above its
+ * range. */
+#define TEST_HIST_EXACT       8U
+#define TEST_HIST_TOP_OCTAVE  23U
+#define TEST_HIST_BUCKETS     (TEST_HIST_EXACT + ((TEST_HIST_TOP_OCTAVE - 2U) * 4U))
+
+/*
+ * Description : One metric over a window. The sum is 64 bits, so no
+ *               window length can overflow the mean.
+ */
+typedef struct
+{
+    uint32_t samples;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[TEST_HIST_BUCKETS];
+} HistStats_t;
+
+/*
+ * Description : Starts a metric from empty.
+ */
+static void histReset(HistStats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->min = UINT32_MAX;
+}
+
+/*
+ * Description : Returns the histogram bucket of a value.
+ */
+static uint32_t histBucket(uint32_t value)
+{
+    if (value < TEST_HIST_EXACT)
+        return value;
+
+    uint32_t octave = 31U - (uint32_t)TICK_PROFILER_CLZ(value);
+
+    if (octave > TEST_HIST_TOP_OCTAVE)
+        return TEST_HIST_BUCKETS - 1U;
+
+    return TEST_HIST_EXACT + ((octave - 3U) * 4U) + ((value >> (octave - 2U)) & 3U);
+}
+
+/*
+ * Description : Returns the largest value a histogram bucket holds.
+ */
+static uint32_t histBucketTop(uint32_t bucket)
+{
+    if (bucket < TEST_HIST_EXACT)
+        return bucket;
+
+    uint32_t octave = 3U + ((bucket - TEST_HIST_EXACT) / 4U);
+    uint32_t step = 1UL << (octave - 2U);
+
+    return ((4U + ((bucket - TEST_HIST_EXACT) % 4U)) * step) + step - 1U;
+}
+
+/*
+ * Description : Adds one sample to a metric.
+ */
+static void histAdd(HistStats_t *stats, uint32_t value)
+{
+    stats->samples++;
+    stats->total += value;
+    stats->buckets[histBucket(value)]++;
+    if (value < stats->min)
+        stats->min = value;
+    if (value > stats->max)
+        stats->max = value;
+}
+
+/*
+ * Description : Returns a percentile of a metric: the top of the bucket
+ *               holding that rank, capped at the maximum, so it never
+ *               under-states the value.
+ */
+static uint32_t histPercentile(const HistStats_t *stats, uint32_t percent)
+{
+    uint32_t rank = (uint32_t)((((uint64_t)stats->samples * percent) + 99U) / 100U);
+    uint32_t seen = 0;
+
+    for (uint32_t bucket = 0; bucket < TEST_HIST_BUCKETS; bucket++)
+    {
+        seen += stats->buckets[bucket];
+        if (seen >= rank) {
+            uint32_t top = (bucket == (TEST_HIST_BUCKETS - 1U)) ? stats->max : histBucketTop(bucket);
+            return (top < stats->max) ? top : stats->max;
+        }
+    }
+    return stats->max;
+}
+#endif
+
+#if (TEST_RESPONSE_ENABLED == 1)
+/* Response times of the interactive task in microseconds, from the tick
+ * a request arrived at to its answer. The task fills one buffer while
+ * the monitor drains the other; they swap every second. The run figures
+ * add up the seconds since the mode started and belong to the monitor */
+static HistStats_t g_responseWindow[2];
+static volatile uint32_t g_responseFill = 0U;
+static HistStats_t g_responseRun;
+
+/*
+ * Description : Response hook of the interactive task (workloads.h).
+ *               The request arrived when its tick began, so the response
+ *               time is the time since then.
+ */
+static void responseSample(uint32_t requestTick)
+{
+    uint32_t response_us = cyclesSinceTick((TickType_t)requestTick) / (configCPU_CLOCK_HZ / 1000000U);
+
+    taskENTER_CRITICAL();
+    histAdd(&g_responseWindow[g_responseFill], response_us);
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Description : Starts the response figures from empty and installs the
+ *               hook. Called before the kernel starts.
+ */
+static void initResponse(void)
+{
+    histReset(&g_responseWindow[0]);
+    histReset(&g_responseWindow[1]);
+    histReset(&g_responseRun);
+    workloadSetResponseHook(responseSample);
+}
+
+/*
+ * Description : Adds the samples of one metric to another.
+ */
+static void histMerge(HistStats_t *into, const HistStats_t *from)
+{
+    into->samples += from->samples;
+    into->total += from->total;
+    for (uint32_t bucket = 0; bucket < TEST_HIST_BUCKETS; bucket++)
+        into->buckets[bucket] += from->buckets[bucket];
+    if (from->min < into->min)
+        into->min = from->min;
+    if (from->max > into->max)
+        into->max = from->max;
+}
+
+/*
+ * Description : Swaps the response buffers and returns the one holding
+ *               the second just ended. The caller empties it with
+ *               histReset() once read.
+ */
+static HistStats_t *swapResponse(void)
+{
+    uint32_t done = g_responseFill;
+
+    taskENTER_CRITICAL();
+    g_responseFill = done ^ 1U;
+    taskEXIT_CRITICAL();
+
+    return &g_responseWindow[done];
+}
+
+/*
+ * Description : Sends one Response row: samples, then the minimum, mean,
+ *               median, p90, p99 and maximum in microseconds.
+ */
+static void reportResponseRow(LogLine_t *line, int mode, const char *scope,
+                              const HistStats_t *stats)
+{
+    logPutText(line, "Response, ");
+    logPutSigned(line, mode, 0);
+    logPutText(line, ", ");
+    logPutText(line, scope);
+    logPutText(line, ", ");
+    logPutUnsigned(line, stats->samples, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (stats->samples == 0U) ? 0U : stats->min, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (stats->samples == 0U) ? 0U :
+                   (uint32_t)(stats->total / stats->samples), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, histPercentile(stats, 50U), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, histPercentile(stats, 90U), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, histPercentile(stats, 99U), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, stats->max, 0);
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Sends the Response rows of the last second and of the
+ *               run so far.
+ */
+static void reportResponse(LogLine_t *line, int mode)
+{
+    HistStats_t *second = swapResponse();
+
+    histMerge(&g_responseRun, second);
+    reportResponseRow(line, mode, "Second", second);
+    reportResponseRow(line, mode, "Run", &g_responseRun);
+    histReset(second);
+}
+#endif
+
+#if (TEST_SOAK_ENABLED == 1)
+/* Ops per second of the heavy and interactive tasks, written by the
+ * monitor only */
+static HistStats_t g_soakHeavy;
+static HistStats_t g_soakInter;
+#if (TEST_RESPONSE_ENABLED == 1)
+/* Interactive response times over the window, written by the monitor */
+static HistStats_t g_soakResponse;
+#endif
+/* Run time of each monitor pass in microseconds, written by the monitor */
+static HistStats_t g_soakMonitor;
+
+/* Probe lateness in microseconds. The probe fills one buffer while the
+ * monitor reports the other; they swap at the end of each window, so no
+ * window is copied inside a critical section */
+static HistStats_t g_soakLatency[2];
+static volatile uint32_t g_soakLatencyFill = 0U;
+
+/*
+ * Description : Probe task. Released every TEST_SOAK_PROBE_MS with
+ *               vTaskDelayUntil() and timed as the jitter tasks are; the
+ *               lateness goes into the buffer being filled.
+ */
+static void vSoakProbeTask(void *pvParameters)
+{
+    const TickType_t period = pdMS_TO_TICKS(TEST_SOAK_PROBE_MS);
+    TickType_t release = xTaskGetTickCount();
+
+    (void)pvParameters;
+
+    for (;;)
+    {
+        vTaskDelayUntil(&release, (period == 0U) ? 1U : period);
+
+        uint32_t late_us = cyclesSinceTick(release) / (configCPU_CLOCK_HZ / 1000000U);
+
+        taskENTER_CRITICAL();
+        histAdd(&g_soakLatency[g_soakLatencyFill], late_us);
+        taskEXIT_CRITICAL();
+
+        runBurst(TEST_SOAK_PROBE_WORK_US);
+    }
+}
+
+/*
+ * Description : Creates the probe task at one priority and optionally
+ *               registers it with the scheduler.
+ */
+static void createSoakProbe(UBaseType_t priority, int registerTasks)
+{
+    histReset(&g_soakHeavy);
+    histReset(&g_soakInter);
+    histReset(&g_soakLatency[0]);
+    histReset(&g_soakLatency[1]);
+    histReset(&g_soakMonitor);
+    #if (TEST_RESPONSE_ENABLED == 1)
+    histReset(&g_soakResponse);
+    #endif
+
+    if ((xTaskCreate(vSoakProbeTask, "Probe", TEST_SOAK_STACK_SIZE, NULL,
+                     priority, &xProbeHandle) == pdPASS) && registerTasks)
+    {
+        registerTask(xProbeHandle);
+    }
+}
+
+/*
+ * Description : Sends the Soak row of one metric.
+ */
+static void reportSoakMetric(LogLine_t *line, int mode, uint32_t uptime_s,
+                             const char *metric, const HistStats_t *stats)
+{
+    logPutText(line, "Soak, ");
+    logPutSigned(line, mode, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, uptime_s, 0);
+    logPutText(line, ", ");
+    logPutText(line, metric);
+    logPutText(line, ", ");
+    logPutUnsigned(line, stats->samples, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (stats->samples == 0U) ? 0U : stats->min, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, (stats->samples == 0U) ? 0U :
+                   (uint32_t)(stats->total / stats->samples), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, stats->max, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, histPercentile(stats, 99U), 0);
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Ends the soak window: sends its rows and starts
+ *               every metric from empty. Also called at a mode switch, so
+ *               a window never mixes the two modes.
+ */
+static void reportSoak(LogLine_t *line, int mode, uint32_t uptime_s)
+{
+    uint32_t done = g_soakLatencyFill;
+
+    taskENTER_CRITICAL();
+    g_soakLatencyFill = done ^ 1U;
+    taskEXIT_CRITICAL();
+
+    reportSoakMetric(line, mode, uptime_s, "Heavy", &g_soakHeavy);
+    reportSoakMetric(line, mode, uptime_s, "Inter", &g_soakInter);
+    reportSoakMetric(line, mode, uptime_s, "Latency_us", &g_soakLatency[done]);
+    #if (TEST_RESPONSE_ENABLED == 1)
+    reportSoakMetric(line, mode, uptime_s, "Response_us", &g_soakResponse);
+    histReset(&g_soakResponse);
+    #endif
+    reportSoakMetric(line, mode, uptime_s, "Monitor_us", &g_soakMonitor);
+    histReset(&g_soakMonitor);
+
+    histReset(&g_soakHeavy);
+    histReset(&g_soakInter);
+    histReset(&g_soakLatency[done]);
+}
+#endif
+
+#if (TEST_SWEEP_ENABLED == 1)
+/* Sweep grid; point i takes quantum i % Q, boost (i / Q) % B and level
+ * count i / (Q * B) */
+static const uint32_t g_sweepQuanta[] = TEST_SWEEP_QUANTA_TICKS;
+static const uint32_t g_sweepBoosts[] = TEST_SWEEP_BOOSTS_MS;
+static const uint32_t g_sweepLevels[] = TEST_SWEEP_LEVELS;
+
+#define SWEEP_COUNT(array)  (sizeof(array) / sizeof((array)[0]))
+#define SWEEP_POINTS        (SWEEP_COUNT(g_sweepQuanta) * SWEEP_COUNT(g_sweepBoosts) * \
+                             SWEEP_COUNT(g_sweepLevels))
+
+/* Boot parameters, restored after the last point */
+static MLFQ_Tunables_t g_sweepBase;
+static uint32_t g_sweepBaseLevels;
+
+/* Point running, seconds since it was applied, and the measured window
+ * so far: ops summed per second and the counters at its start. All
+ * belong to the monitor */
+static uint32_t g_sweepIndex;
+static uint32_t g_sweepSeconds;
+static uint32_t g_sweepHeavy;
+static uint32_t g_sweepInter;
+static MLFQ_SelfMetrics_t g_sweepMetrics;
+static TickProfilerCpuTime_t g_sweepCpu;
+
+/*
+ * Description : Returns the CPU time of every consumer together.
+ */
+static uint64_t sweepCpuTotal(const TickProfilerCpuTime_t *cpu)
+{
+    uint64_t total = cpu->supervisor + cpu->idle + cpu->other;
+
+    for (uint32_t level = 0; level < TICK_PROFILER_MAX_LEVELS; level++)
+        total += cpu->level[level];
+
+    return total;
+}
+
+/*
+ * Description : Scales a boot quantum by the sweep's High quantum over
+ *               the boot High quantum, within the accepted range.
+ */
+static uint32_t sweepScale(uint32_t base, uint32_t quantum, uint32_t limit)
+{
+    uint64_t scaled = ((uint64_t)base * quantum) / g_sweepBase.quantum_ticks[MLFQ_QUEUE_HIGH];
+
+    if (scaled == 0U)
+        return 1U;
+    return (scaled > limit) ? limit : (uint32_t)scaled;
+}
+
+/*
+ * Description : Applies the point at g_sweepIndex, skipping any the
+ *               scheduler rejects; after the last one, restores the boot
+ *               parameters. The supervisor installs them on its next
+ *               pass, inside the settle time.
+ */
+static void applySweepPoint(LogLine_t *line)
+{
+    for (; g_sweepIndex < SWEEP_POINTS; g_sweepIndex++) {
+        uint32_t quantum = g_sweepQuanta[g_sweepIndex % SWEEP_COUNT(g_sweepQuanta)];
+        uint32_t levels = g_sweepLevels[g_sweepIndex /
+                          (SWEEP_COUNT(g_sweepQuanta) * SWEEP_COUNT(g_sweepBoosts))];
+        MLFQ_Tunables_t point = g_sweepBase;
+
+        point.boost_period_ms = g_sweepBoosts[(g_sweepIndex / SWEEP_COUNT(g_sweepQuanta)) %
+                                              SWEEP_COUNT(g_sweepBoosts)];
+        for (uint32_t level = 0; level < MLFQ_NUM_LEVELS; level++) {
+            point.quantum_ticks[level] = sweepScale(g_sweepBase.quantum_ticks[level], quantum,
+                                                    MLFQ_QUANTUM_MAX_TICKS);
+            point.quantum_us[level] = sweepScale(g_sweepBase.quantum_us[level], quantum,
+                                                 MLFQ_QUANTUM_MAX_US);
+        }
+
+        if ((levels >= 1U) && (levels <= MLFQ_NUM_LEVELS) && schedulerSetTunables(&point)) {
+            (void)schedulerSetLevelCount(levels);
+            g_sweepSeconds = 0;
+            return;
+        }
+
+        logPutText(line, "[WARN] Sweep point ");
+        logPutUnsigned(line, g_sweepIndex, 0);
+        logPutText(line, " rejected\r\n");
+        logLineSendChannel(line, LOG_CHANNEL_CSV);
+    }
+
+    (void)schedulerSetTunables(&g_sweepBase);
+    (void)schedulerSetLevelCount(g_sweepBaseLevels);
+    logPutText(line, "[INFO] Sweep done\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Saves the boot parameters and applies the first point.
+ *               Called by the monitor before its first pass.
+ */
+static void initSweep(LogLine_t *line)
+{
+    schedulerGetTunables(&g_sweepBase);
+    g_sweepBaseLevels = schedulerGetLevelCount();
+    g_sweepIndex = 0;
+    applySweepPoint(line);
+}
+
+/*
+ * Description : Sends the Sweep row of the point that just ended:
+ *               mean ops per second, response percentiles of the
+ *               window, demotions and boosts in it, and the supervisor's
+ *               share of the CPU in per mille.
+ */
+static void reportSweep(LogLine_t *line)
+{
+    MLFQ_SelfMetrics_t metrics;
+    TickProfilerCpuTime_t cpu;
+    uint64_t total;
+    uint32_t permille = 0;
+
+    schedulerGetSelfMetrics(&metrics);
+    tickProfilerGetCpuTime(&cpu);
+    total = sweepCpuTotal(&cpu) - sweepCpuTotal(&g_sweepCpu);
+    if (total > 0U)
+        permille = (uint32_t)(((metrics.supervisor_time - g_sweepMetrics.supervisor_time) * 1000U) / total);
+
+    logPutText(line, "Sweep, ");
+    logPutUnsigned(line, g_sweepIndex, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, g_sweepQuanta[g_sweepIndex % SWEEP_COUNT(g_sweepQuanta)], 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, g_sweepBoosts[(g_sweepIndex / SWEEP_COUNT(g_sweepQuanta)) %
+                                       SWEEP_COUNT(g_sweepBoosts)], 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, schedulerGetLevelCount(), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, g_sweepHeavy / TEST_SWEEP_WINDOW_S, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, g_sweepInter / TEST_SWEEP_WINDOW_S, 0);
+    logPutText(line, ", ");
+    #if (TEST_RESPONSE_ENABLED == 1)
+    logPutUnsigned(line, histPercentile(&g_responseRun, 50U), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, histPercentile(&g_responseRun, 99U), 0);
+    #else
+    logPutText(line, "0, 0");
+    #endif
+    logPutText(line, ", ");
+    logPutUnsigned(line, metrics.demotions - g_sweepMetrics.demotions, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, metrics.boosts - g_sweepMetrics.boosts, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, permille, 0);
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Advances the sweep by one monitor second. The window
+ *               opens once the settle time is over, with every counter
+ *               taken as its zero; when it closes, the point's row goes
+ *               out and the next point is applied.
+ */
+static void sweepSecond(LogLine_t *line, uint32_t heavy, uint32_t inter)
+{
+    if (g_sweepIndex >= SWEEP_POINTS)
+        return;
+
+    g_sweepSeconds++;
+    if (g_sweepSeconds <= TEST_SWEEP_SETTLE_S) {
+        if (g_sweepSeconds == TEST_SWEEP_SETTLE_S) {
+            g_sweepHeavy = 0;
+            g_sweepInter = 0;
+            schedulerGetSelfMetrics(&g_sweepMetrics);
+            tickProfilerGetCpuTime(&g_sweepCpu);
+            #if (TEST_RESPONSE_ENABLED == 1)
+            histReset(&g_responseRun);
+            #endif
+        }
+        return;
+    }
+
+    g_sweepHeavy += heavy;
+    g_sweepInter += inter;
+
+    if (g_sweepSeconds >= (TEST_SWEEP_SETTLE_S + TEST_SWEEP_WINDOW_S)) {
+        reportSweep(line);
+        g_sweepIndex++;
+        applySweepPoint(line);
+    }
+}
+#endif
+
+#if (TEST_TICK_BENCH_ENABLED == 1)
+/* Seconds since the run started, and the window so far: ops and context
+ * switches summed per second, its first tick, and the tick interrupt
+ * figures at its start. All belong to the monitor */
+static uint32_t g_tickBenchSeconds;
+static uint32_t g_tickBenchHeavy;
+static uint32_t g_tickBenchInter;
+static uint32_t g_tickBenchSwitches;
+static TickType_t g_tickBenchStart;
+static IrqStats_t g_tickBenchIrq;
+
+/*
+ * Description : Takes every counter as the zero of a new window.
+ */
+static void openTickBenchWindow(void)
+{
+    g_tickBenchHeavy = 0;
+    g_tickBenchInter = 0;
+    g_tickBenchSwitches = 0;
+    g_tickBenchStart = xTaskGetTickCount();
+    (void)irqStatsGet(IRQ_STATS_SOURCE_TICK, &g_tickBenchIrq);
+    #if (TEST_RESPONSE_ENABLED == 1)
+    histReset(&g_responseRun);
+    #endif
+}
+
+/*
+ * Description : Sends the TickRate row of the window that just ended:
+ *               the tick rate, tick interrupts taken, their mean cost in
+ *               cycles and share of the CPU in parts per million, the
+ *               context switches, ops per second and the response
+ *               percentiles of the window.
+ */
+static void reportTickBench(LogLine_t *line, int mode)
+{
+    IrqStats_t tick;
+    uint32_t count;
+    uint64_t cycles;
+    uint64_t window;
+    uint32_t mean = 0;
+    uint32_t ppm = 0;
+
+    (void)irqStatsGet(IRQ_STATS_SOURCE_TICK, &tick);
+    count = tick.count - g_tickBenchIrq.count;
+    cycles = tick.total_cycles - g_tickBenchIrq.total_cycles;
+    window = (uint64_t)(TickType_t)(xTaskGetTickCount() - g_tickBenchStart) *
+             TICK_PROFILER_CYCLES_PER_TICK;
+    if (count > 0U)
+        mean = (uint32_t)(cycles / count);
+    if (window > 0U)
+        ppm = (uint32_t)((cycles * 1000000U) / window);
+
+    logPutText(line, "TickRate, ");
+    logPutSigned(line, mode, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, configTICK_RATE_HZ, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, count, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, mean, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, ppm, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, g_tickBenchSwitches / TEST_TICK_BENCH_WINDOW_S, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, g_tickBenchHeavy / TEST_TICK_BENCH_WINDOW_S, 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, g_tickBenchInter / TEST_TICK_BENCH_WINDOW_S, 0);
+    logPutText(line, ", ");
+    #if (TEST_RESPONSE_ENABLED == 1)
+    logPutUnsigned(line, histPercentile(&g_responseRun, 50U), 0);
+    logPutText(line, ", ");
+    logPutUnsigned(line, histPercentile(&g_responseRun, 99U), 0);
+    #else
+    logPutText(line, "0, 0");
+    #endif
+    logPutText(line, "\r\n");
+    logLineSendChannel(line, LOG_CHANNEL_CSV);
+}
+
+/*
+ * Description : Advances the benchmark by one monitor second. The first
+ *               window opens once the settle time is over; each one that
+ *               closes sends its row and opens the next.
+ */
+static void tickBenchSecond(LogLine_t *line, int mode, uint32_t heavy, uint32_t inter,
+                            uint32_t switches)
+{
+    g_tickBenchSeconds++;
+    if (g_tickBenchSeconds <= TEST_TICK_BENCH_SETTLE_S) {
+        if (g_tickBenchSeconds == TEST_TICK_BENCH_SETTLE_S)
+            openTickBenchWindow();
+        return;
+    }
+
+    g_tickBenchHeavy += heavy;
+    g_tickBenchInter += inter;
+    g_tickBenchSwitches += switches;
+
+    if (g_tickBenchSeconds >= (TEST_TICK_BENCH_SETTLE_S + TEST_TICK_BENCH_WINDOW_S)) {
+        reportTickBench(line, mode);
+        g_tickBenchSeconds = TEST_TICK_BENCH_SETTLE_S;
+        openTickBenchWindow();
+    }
+}
+#endif
+
+#if (TEST_AB_SWITCH_ENABLED == 1)
+/*
+ * Description : Hands one workload task to the active mode: registered
+ *               with the scheduler, or at the equal control priority.
+ */
+static void applyModeToTask(TaskHandle_t handle, int mode)
+{
+    if (handle == NULL)
+        return;
+
+    if (mode == 1) {
+        registerTask(handle);
+    } else {
+        unregisterTask(handle);
+        vTaskPrioritySet(handle, TEST_CONTROL_PRIORITY);
+    }
+}
+
+/*
+ * Description : Switches every workload task and the supervisor to a
+ *               mode and restarts the throughput counters, so each CSV
+ *               line only counts work done under one mode.
+ */
+static void applyMode(int mode)
+{
+    extern volatile uint32_t g_cpu_work_counter;
+    extern volatile uint32_t g_interactive_work_counter;
+
+    #if (TEST_WORKLOAD_MIX == 1)
+        for (uint32_t i = 0; i < TEST_MIX_TASKS; i++)
+            applyModeToTask(g_mixHandles[i], mode);
+    #else
+        applyModeToTask(xHeavyHandle, mode);
+        applyModeToTask(xInteractHandle, mode);
+    #endif
+    #if (TEST_JITTER_ENABLED == 1)
+        for (uint32_t i = 0; i < TEST_JITTER_TASKS; i++)
+            applyModeToTask(g_jitter[i].handle, mode);
+    #endif
+    #if (TEST_ECHO_ENABLED == 1)
+        applyModeToTask(xEchoHandle, mode);
+    #endif
+    #if (TEST_DSP_ENABLED == 1)
+        for (uint32_t i = 0; i < TEST_DSP_TASKS; i++)
+            applyModeToTask(g_dspHandles[i], mode);
+    #endif
+    #if (TEST_COPY_ENABLED == 1)
+        applyModeToTask(g_copyHandle, mode);
+    #endif
+    #if (TEST_ADC_ENABLED == 1)
+        for (uint32_t i = 0; i < WORKLOAD_ADC_STAGES; i++)
+            applyModeToTask(g_adcHandles[i], mode);
+    #endif
+    #if (TEST_PIPELINE_ENABLED == 1)
+        for (uint32_t i = 0; i < WORKLOAD_PIPELINE_STAGES; i++)
+            applyModeToTask(g_pipelineHandles[i], mode);
+    #endif
+    #if (TEST_BUTTON_ENABLED == 1)
+        applyModeToTask(xButtonHandle, mode);
+        if (mode == 1)
+            (void)schedulerSetBottomHalf(xButtonHandle, TEST_BUTTON_BUDGET_US);
+    #endif
+    #if (TEST_SOAK_ENABLED == 1)
+        applyModeToTask(xProbeHandle, mode);
+    #endif
+
+    /* The monitor preempts the supervisor, which may be in the middle
+       of a pass; let it finish before parking it */
+    if (hSchedulerTask != NULL) {
+        while (eTaskGetState(hSchedulerTask) == eReady)
+            vTaskDelay(1);
+
+        if (mode == 1)
+            vTaskResume(hSchedulerTask);
+        else
+            vTaskSuspend(hSchedulerTask);
+    }
+
+    taskENTER_CRITICAL();
+    g_cpu_work_counter = 0;
+    g_interactive_work_counter = 0;
+    #if (TEST_WORKLOAD_MIX == 1)
+        for (uint32_t i = 0; i < TEST_MIX_TASKS; i++)
+            g_mix[i].bursts = 0;
+    #endif
+    taskEXIT_CRITICAL();
+
+    g_activeMode = mode;
+}
+#endif
 
 
 /* * MONITOR TASK
- * Description : Runs every 1 second. Calculates the "Loop Count" (Throughput)
- * of the other tasks and sends a CSV line over UART.
+ * Description : Runs every 1 second at TEST_MONITOR_PRIORITY, above every
+ * task it measures. Snapshots all counters at once, calculates the "Loop
+ * Count" (Throughput) of the other tasks and sends a CSV line over UART.
  * * CSV Format  : Time(ms), TestMode, CpuHeavy_Ops/Sec, Interactive_Ops/Sec
+ * followed by "Task, Mode, Name, Level, Ops/Sec" for every task with a
+ * work counter and "Level, Mode, Ops/Sec per level". With
+ * TEST_JITTER_ENABLED, "Jitter, Mode, Period_ms, Level, Samples, Max_us,
+ * then releases per bucket up to 10/20/50/100/200/500/1000/2000/5000 us
+ * and later" for each periodic task. With TEST_IRQ_LATENCY_ENABLED,
+ * "IrqLatency, Mode, Samples, Missed, Min, Mean and Max cycles, then
+ * interrupts per bucket up to 50/100/200/500/1000/2000/4000 cycles and
+ * later" for the benchmark interrupt. With TEST_RESPONSE_ENABLED,
+ * "Response, Mode, Scope, Samples, Min_us, Mean_us, P50_us, P90_us,
+ * P99_us, Max_us" for the requests the interactive task answered, with
+ * Scope "Second" for the last second and "Run" for all of the current
+ * mode. With TEST_ECHO_ENABLED, "Echo,
+ * Mode, Level, Samples, Min_us, Mean_us, Max_us, Dropped" for the echo
+ * workload on UART1. With TEST_BUTTON_ENABLED, "Button, Mode, Level,
+ * Presses, Min_us, Mean_us, Max_us, Dropped" for each level that handled
+ * a switch press in the last second. With TEST_ADC_ENABLED, "Adc, Mode,
+ * Stage, Level, Batch, Halves, Min_us, Mean_us, Max_us, Overruns,
+ * Dropped" for the Handler and Aggregate stages of the ADC pipeline.
+ * With TEST_PIPELINE_ENABLED, "Pipeline, Mode, Stage, Level, Items,
+ * Depth_mean, Depth_max, Min_us, Mean_us, Max_us" for each stage of the
+ * queue pipeline, and one with Stage "End" for the items retired.
+ * Then "Monitor, Mode, Busy_us, Permille" for its own run time in the
+ * previous pass.
+ * With TEST_SOAK_ENABLED the rows above are not sent; every
+ * TEST_SOAK_WINDOW_S it sends "Soak, Mode, Uptime_s, Metric, Samples, Min,
+ * Mean, Max, P99" for Heavy and Inter (ops per second), Latency_us (probe
+ * lateness), Monitor_us (run time of each pass) and, with
+ * TEST_RESPONSE_ENABLED, Response_us instead.
+ * With TEST_SWEEP_ENABLED it also sends, at the end of each sweep point,
+ * "Sweep, Index, Quantum_ticks, Boost_ms, Levels, Heavy_Ops, Inter_Ops,
+ * P50_us, P99_us, Demotions, Boosts, Supervisor_permille": mean ops per
+ * second, response percentiles (0 without TEST_RESPONSE_ENABLED) and
+ * the scheduler's activity over the measured window.
+ * With TEST_TICK_BENCH_ENABLED it also sends, every TEST_TICK_BENCH_WINDOW_S,
+ * "TickRate, Mode, Hz, Ticks, Tick_cycles, Tick_ppm, Switches, Heavy_Ops,
+ * Inter_Ops, P50_us, P99_us": the tick interrupt's mean cost and CPU
+ * share, and context switches and ops per second, over the window.
+ * In A/B builds it also switches mode every TEST_AB_SWITCH_SECONDS, or
+ * when 'm' (scheduler policy) or 's' (standard) arrives on the UART.
  */
 void vMonitorTask(void *pvParameters)
 {
@@ -37,44 +1604,287 @@ void vMonitorTask(void *pvParameters)
 
     static uint32_t last_cpu_count = 0;
     static uint32_t last_inter_count = 0;
-    char buffer[128];
+    #if (TEST_SOAK_ENABLED == 0)
+    /* Per-task counters are never reset, so the deltas need no resync */
+    static uint32_t units[WORKLOAD_MAX_COUNTERS];
+    static uint32_t last_units[WORKLOAD_MAX_COUNTERS];
+    #endif
+    /* Cycles the last pass ran for, reported with the next one */
+    uint32_t busy_cycles = 0;
+    #if (TEST_WORKLOAD_MIX == 1)
+    static uint32_t last_sensor = 0, last_network = 0, last_compress = 0;
+    static uint32_t last_replayed = 0;
+    #endif
+    #if (TEST_AB_SWITCH_ENABLED == 1)
+    uint32_t seconds_in_mode = 0;
+    #endif
+    #if (TEST_SOAK_ENABLED == 1)
+    /* Uptime in 64 bits, summed from tick deltas, so neither the tick
+       count nor the millisecond count wrapping disturbs it */
+    uint64_t uptime_ticks = 0;
+    TickType_t last_tick = xTaskGetTickCount();
+    uint32_t seconds_in_window = 0;
+    #endif
+    char buffer[96];
+    LogLine_t line;
+
+    logLineInit(&line, buffer, sizeof(buffer));
+
+    /* Send CSV Header for Excel/Python, on the CSV channel like the rows */
+    logPutText(&line, "\r\n--- TEST STARTED ---\r\n");
+    logLineSendChannel(&line, LOG_CHANNEL_CSV);
+    #if (TEST_SOAK_ENABLED == 1)
+    logPutText(&line, "Soak, Mode, Uptime_s, Metric, Samples, Min, Mean, Max, P99\r\n");
+    #else
+    logPutText(&line, "Time_MS, Mode, Heavy_Ops, Inter_Ops\r\n");
+    #endif
+    logLineSendChannel(&line, LOG_CHANNEL_CSV);
 
-    /* Send CSV Header for Excel/Python */
-    sendLog("\r\n--- TEST STARTED ---\r\n");
-    sendLog("Time_MS, Mode, Heavy_Ops, Inter_Ops\r\n");
+    #if (TEST_IRQ_LATENCY_ENABLED == 1)
+    /* Started here rather than in main() so no sample waits for the
+       kernel to unmask interrupts at start-up */
+    initLatencyTimer(TEST_IRQ_PERIOD_CYCLES, irqLatencySample);
+    #endif
+
+    #if (TEST_SWEEP_ENABLED == 1)
+    initSweep(&line);
+    #endif
 
     for(;;)
     {
         /* Wait 1 second */
         vTaskDelay(pdMS_TO_TICKS(1000));
 
-        /* Snapshot current counters */
-        uint32_t current_cpu = g_cpu_work_counter;
-        uint32_t current_inter = g_interactive_work_counter;
+        uint32_t busy_start = cycleCounterGet();
+        uint32_t busy_us = busy_cycles / (configCPU_CLOCK_HZ / 1000000U);
+
+        /* Snapshot every counter in one critical section, so they all
+           end at the same instant. Sending the rows may block on the
+           log and let the workload run again before they are read. */
+        uint32_t current_cpu, current_inter;
+        TickType_t now;
+        #if (TEST_SOAK_ENABLED == 0)
+        uint32_t counters;
+        #if (TEST_WORKLOAD_REPLAY == 1)
+        uint32_t replayed;
+        #elif (TEST_WORKLOAD_MIX == 1)
+        uint32_t sensor, network, compress;
+        #endif
+        #endif
+
+        taskENTER_CRITICAL();
+        current_cpu = g_cpu_work_counter;
+        current_inter = g_interactive_work_counter;
+        now = xTaskGetTickCount();
+        #if (TEST_SOAK_ENABLED == 0)
+        counters = workloadGetCounterCount();
+        for (uint32_t i = 0; i < counters; i++)
+            units[i] = workloadGetCounter(i)->units;
+        #if (TEST_WORKLOAD_REPLAY == 1)
+        replayed = mixBursts(NULL);
+        #elif (TEST_WORKLOAD_MIX == 1)
+        sensor   = mixBursts(&g_workloadPeriodicSensor);
+        network  = mixBursts(&g_workloadBurstyNetwork);
+        compress = mixBursts(&g_workloadBackgroundCompression);
+        #endif
+        #endif
+        taskEXIT_CRITICAL();
 
         /* Calculate delta (Operations per Second) */
         uint32_t cpu_speed = (current_cpu - last_cpu_count);
         uint32_t inter_speed = (current_inter - last_inter_count);
 
-        TickType_t now = xTaskGetTickCount();
+        /* Note: the mode starts as TEST_MODE from test_config.h */
+        int mode = g_activeMode;
+
+        #if (TEST_SOAK_ENABLED == 1)
+        uptime_ticks += (TickType_t)(now - last_tick);
+        last_tick = now;
+        uint32_t uptime_s = (uint32_t)(uptime_ticks / configTICK_RATE_HZ);
+
+        histAdd(&g_soakHeavy, cpu_speed);
+        histAdd(&g_soakInter, inter_speed);
+        histAdd(&g_soakMonitor, busy_us);
+        #if (TEST_RESPONSE_ENABLED == 1)
+        HistStats_t *second = swapResponse();
+        histMerge(&g_soakResponse, second);
+        histReset(second);
+        #endif
 
+        if (++seconds_in_window >= TEST_SOAK_WINDOW_S) {
+            reportSoak(&line, mode, uptime_s);
+            seconds_in_window = 0;
+        }
+        #else
         /* Format Data: Time, Mode, CPU_Speed, User_Speed */
-        /* Note: TEST_MODE comes from test_config.h */
-        snprintf(buffer, sizeof(buffer), "%lu, %d, %lu, %lu\r\n",
-                 now, TEST_MODE, cpu_speed, inter_speed);
+        logPutUnsigned(&line, now, 0);
+        logPutText(&line, ", ");
+        logPutSigned(&line, mode, 0);
+        logPutText(&line, ", ");
+        logPutUnsigned(&line, cpu_speed, 0);
+        logPutText(&line, ", ");
+        logPutUnsigned(&line, inter_speed, 0);
+        logPutText(&line, "\r\n");
+
+        /* Send to PC on the CSV channel */
+        logLineSendChannel(&line, LOG_CHANNEL_CSV);
+
+        /* Fairness between tasks, not just the totals above */
+        reportTaskWork(&line, mode, counters, units, last_units);
+
+        #if (TEST_JITTER_ENABLED == 1)
+             reportJitter(&line, mode);
+        #endif
+
+        #if (TEST_IRQ_LATENCY_ENABLED == 1)
+             reportIrqLatency(&line, mode);
+        #endif
+
+        #if (TEST_RESPONSE_ENABLED == 1)
+             reportResponse(&line, mode);
+        #endif
+
+        #if (TEST_ECHO_ENABLED == 1)
+             reportEcho(&line, mode);
+        #endif
 
-        /* Send to PC via UART */
-        sendLog(buffer);
+        #if (TEST_BUTTON_ENABLED == 1)
+             reportButtons(&line, mode);
+        #endif
+
+        #if (TEST_ADC_ENABLED == 1)
+             reportAdc(&line, mode);
+        #endif
+
+        #if (TEST_PIPELINE_ENABLED == 1)
+             reportPipeline(&line, mode);
+        #endif
+
+        #if (TEST_WORKLOAD_REPLAY == 1)
+             /* Bursts per second of all the replayed tasks; the demand
+                is the same in every run, so this compares directly */
+             logPutText(&line, "Replay, ");
+             logPutSigned(&line, mode, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, replayed - last_replayed, 0);
+             logPutText(&line, "\r\n");
+             logLineSendChannel(&line, LOG_CHANNEL_CSV);
+
+             last_replayed = replayed;
+        #elif (TEST_WORKLOAD_MIX == 1)
+             /* Bursts per second of each class in the mix */
+             logPutText(&line, "Mix, ");
+             logPutSigned(&line, mode, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, sensor - last_sensor, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, network - last_network, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, compress - last_compress, 0);
+             logPutText(&line, "\r\n");
+             logLineSendChannel(&line, LOG_CHANNEL_CSV);
+
+             last_sensor   = sensor;
+             last_network  = network;
+             last_compress = compress;
+        #endif
+
+        #if (SWITCH_STATS_ENABLED == 1U)
+             /* Task selection cost over the last second, in cycles.
+                Compare builds with configUSE_PORT_OPTIMISED_TASK_SELECTION
+                set to 1 and to 0. */
+             SwitchStatsSummary_t switches;
+             switchStatsGetSummary(&switches);
+             switchStatsReset();
+             logPutText(&line, "Switch, ");
+             logPutSigned(&line, mode, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, switches.samples, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, switches.min_cycles, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, switches.mean_cycles, 0);
+             logPutText(&line, ", ");
+             logPutUnsigned(&line, switches.max_cycles, 0);
+             logPutText(&line, "\r\n");
+             logLineSendChannel(&line, LOG_CHANNEL_CSV);
+        #endif
+
+        /* The observer's own cost: run time of the last pass and its
+           share of the second, in per mille */
+        logPutText(&line, "Monitor, ");
+        logPutSigned(&line, mode, 0);
+        logPutText(&line, ", ");
+        logPutUnsigned(&line, busy_us, 0);
+        logPutText(&line, ", ");
+        logPutUnsigned(&line, busy_us / 1000U, 0);
+        logPutText(&line, ".");
+        logPutUnsignedZero(&line, (busy_us / 100U) % 10U, 1);
+        logPutText(&line, "\r\n");
+        logLineSendChannel(&line, LOG_CHANNEL_CSV);
+
+        #if (TEST_SWEEP_ENABLED == 1)
+             /* After the Response rows, which fold this second into the
+                run percentiles the Sweep row reads */
+             sweepSecond(&line, cpu_speed, inter_speed);
+        #endif
+
+        #if (TEST_TICK_BENCH_ENABLED == 1)
+             /* Likewise after the Response and Switch rows */
+             tickBenchSecond(&line, mode, cpu_speed, inter_speed, switches.samples);
+        #endif
 
         #if (TEST_MODE == 1)
              /* Optional: If in MLFQ mode, you can also print the queue report
                 to see tasks moving between queues. */
              // printQueueReport();
         #endif
+        #endif /* TEST_SOAK_ENABLED */
 
         /* Update history */
         last_cpu_count = current_cpu;
         last_inter_count = current_inter;
+
+        #if (TEST_AB_SWITCH_ENABLED == 1)
+             /* Switch on a UART command or when the period is up */
+             uint8_t command[8];
+             uint32_t received = receiveBytes(command, sizeof(command));
+             int next = mode;
+
+             for (uint32_t i = 0; i < received; i++) {
+                 if (command[i] == 'm') next = 1;
+                 if (command[i] == 's') next = 0;
+             }
+
+             seconds_in_mode++;
+             if ((TEST_AB_SWITCH_SECONDS > 0) && (seconds_in_mode >= TEST_AB_SWITCH_SECONDS))
+                 next = !mode;
+
+             if (next != mode) {
+                 #if (TEST_SOAK_ENABLED == 1)
+                 /* Close the window so it holds one mode only */
+                 reportSoak(&line, mode, uptime_s);
+                 seconds_in_window = 0;
+                 #endif
+                 applyMode(next);
+                 seconds_in_mode = 0;
+                 #if (TEST_RESPONSE_ENABLED == 1)
+                 histReset(&g_responseRun);
+                 #endif
+                 last_cpu_count = 0;
+                 last_inter_count = 0;
+                 #if (TEST_WORKLOAD_MIX == 1)
+                 last_sensor = last_network = last_compress = 0;
+                 last_replayed = 0;
+                 #endif
+                 logPutText(&line, "[INFO] Switched to mode ");
+                 logPutSigned(&line, next, 0);
+                 logPutText(&line, "\r\n");
+                 logLineSendChannel(&line, LOG_CHANNEL_CSV);
+             }
+        #endif
+
+        busy_cycles = cycleCounterGet() - busy_start;
     }
 }
 
@@ -84,32 +1894,104 @@ void vMonitorTask(void *pvParameters)
  */
 int main(void)
 {
-    /* 1. Initialize Tiva-C Hardware */
+    /* 1. Initialize Tiva-C Hardware (80 MHz PLL first) */
+    initClock();
     initUART();
     initGPIO();
 
     /* 2. Initialize Scheduler Internal Structures */
     initScheduler();
 
+    /* Calibrate the workload busy loop against the cycle counter */
+    initWorkloads();
+
     /* 3. Create the Monitor Task (The Observer) */
-    /* Priority 5 ensures it always runs to print stats, regardless of CPU load */
-    xTaskCreate(vMonitorTask, "Monitor", 1024, NULL, 5, NULL);
+    /* Pinned in the real-time band, above every task it measures in both
+       modes, so it neither competes with them nor depends on the policy */
+    if (xTaskCreate(vMonitorTask, "Monitor", TEST_MONITOR_STACK_SIZE, NULL,
+                    TEST_MONITOR_PRIORITY, &xMonitorHandle) == pdPASS)
+        (void)pinTask(xMonitorHandle, TEST_MONITOR_PRIORITY);
 
     /* 4. Configure the Scheduler based on Test Mode */
-    #if (TEST_MODE == 1)
+    #if (TEST_AB_SWITCH_ENABLED == 1)
+        /* ---------------------------------------------------------
+         * MODE: A/B AT RUN TIME (starts in TEST_MODE, the monitor
+         * switches between the policy and the control group)
+         * --------------------------------------------------------- */
+        sendLog("[INFO] System Mode: A/B (switched at run time)\r\n");
+
+        xTaskCreate(schedulerTask,
+                    "Scheduler",
+                    TEST_SCHEDULER_STACK_SIZE,
+                    NULL,
+                    MLFQ_SUPERVISOR_PRIORITY,
+                    &hSchedulerTask);
+
+        /* Same stacks in both modes, so only the policy differs */
+        #if (TEST_WORKLOAD_MIX == 1)
+            createMix(TEST_CONTROL_PRIORITY, 0);
+        #else
+        xTaskCreate(runCPUHeavyTask, "Hog", 256, "Hog", TEST_CONTROL_PRIORITY, &xHeavyHandle);
+        xTaskCreate(runInteractiveTask, "User", 256, "User", TEST_CONTROL_PRIORITY, &xInteractHandle);
+        #endif
+        #if (TEST_JITTER_ENABLED == 1)
+            createJitterTasks(TEST_CONTROL_PRIORITY, 0);
+        #endif
+        #if (TEST_ECHO_ENABLED == 1)
+            xTaskCreate(runEchoTask, "Echo", TEST_ECHO_STACK_SIZE, "Echo",
+                        TEST_CONTROL_PRIORITY, &xEchoHandle);
+        #endif
+        #if (TEST_DSP_ENABLED == 1)
+            createDspTasks(TEST_CONTROL_PRIORITY, 0);
+        #endif
+        #if (TEST_COPY_ENABLED == 1)
+            createCopyTask(TEST_CONTROL_PRIORITY, 0);
+        #endif
+        #if (TEST_ADC_ENABLED == 1)
+            createAdcTasks(TEST_CONTROL_PRIORITY, 0);
+        #endif
+        #if (TEST_PIPELINE_ENABLED == 1)
+            createPipelineTasks(TEST_CONTROL_PRIORITY, 0);
+        #endif
+        #if (TEST_BUTTON_ENABLED == 1)
+            xTaskCreate(vButtonTask, "Button", TEST_BUTTON_STACK_SIZE, NULL,
+                        TEST_CONTROL_PRIORITY, &xButtonHandle);
+        #endif
+        #if (TEST_SOAK_ENABLED == 1)
+            createSoakProbe(TEST_CONTROL_PRIORITY, 0);
+        #endif
+
+        applyMode(TEST_MODE);
+
+    #elif (TEST_MODE == 1)
         /* ---------------------------------------------------------
-         * MODE: MLFQ SCHEDULER (Experimental)
+         * MODE: SCHEDULER POLICY (MLFQ, Stride or Lottery, selected
+         * with SCHED_POLICY in sched_policy.h)
          * --------------------------------------------------------- */
-        sendLog("[INFO] System Mode: MLFQ (Dynamic Priority)\r\n");
+        char modeLine[64];
+        LogLine_t line;
+
+        logLineInit(&line, modeLine, sizeof(modeLine));
+        logPutText(&line, "[INFO] System Mode: ");
+        logPutText(&line, schedulerPolicyName());
+        logPutText(&line, " (Dynamic Priority)\r\n");
+        logLineSend(&line);
 
         /* Create the Supervisor Task (The MLFQ Manager) */
+        #if (configUSE_MLFQ_TIMER_SUPERVISOR == 1)
+        (void)schedulerStartTimerSupervisor();
+        #else
         xTaskCreate(schedulerTask,
                     "Scheduler",
-                    1024,                       /* Stack size increased for safe printing */
+                    TEST_SCHEDULER_STACK_SIZE,
                     NULL,
-                    MLFQ_TOP_PRIORITY_NUMBER + 1, /* Highest priority in system */
+                    MLFQ_SUPERVISOR_PRIORITY, /* Highest priority in system */
                     &hSchedulerTask);
+        #endif
         /* Create Workloads */
+        #if (TEST_WORKLOAD_MIX == 1)
+            createMix(4, 1);
+        #else
         /* 256 is plenty for these simple tasks */
         xTaskCreate(runCPUHeavyTask, "Hog", 256, "Hog", 4, &xHeavyHandle);
         xTaskCreate(runInteractiveTask, "User", 256, "User", 4, &xInteractHandle);
@@ -118,6 +2000,38 @@ int main(void)
             registerTask(xHeavyHandle);
             registerTask(xInteractHandle);
         }
+        #endif
+        #if (TEST_JITTER_ENABLED == 1)
+            createJitterTasks(4, 1);
+        #endif
+        #if (TEST_ECHO_ENABLED == 1)
+            if (xTaskCreate(runEchoTask, "Echo", TEST_ECHO_STACK_SIZE, "Echo",
+                            4, &xEchoHandle) == pdPASS)
+                registerTask(xEchoHandle);
+        #endif
+        #if (TEST_DSP_ENABLED == 1)
+            createDspTasks(4, 1);
+        #endif
+        #if (TEST_COPY_ENABLED == 1)
+            createCopyTask(4, 1);
+        #endif
+        #if (TEST_ADC_ENABLED == 1)
+            createAdcTasks(4, 1);
+        #endif
+        #if (TEST_PIPELINE_ENABLED == 1)
+            createPipelineTasks(4, 1);
+        #endif
+        #if (TEST_BUTTON_ENABLED == 1)
+            if (xTaskCreate(vButtonTask, "Button", TEST_BUTTON_STACK_SIZE, NULL,
+                            4, &xButtonHandle) == pdPASS)
+            {
+                registerTask(xButtonHandle);
+                (void)schedulerSetBottomHalf(xButtonHandle, TEST_BUTTON_BUDGET_US);
+            }
+        #endif
+        #if (TEST_SOAK_ENABLED == 1)
+            createSoakProbe(4, 1);
+        #endif
 
 
     #else
@@ -127,12 +2041,44 @@ int main(void)
         sendLog("[INFO] System Mode: STANDARD (Round Robin)\r\n");
 
         /* Create Workloads at EQUAL Priority (4) to simulate contention */
+        #if (TEST_WORKLOAD_MIX == 1)
+            createMix(4, 0);
+        #else
         xTaskCreate(runCPUHeavyTask, "Hog", 1024, "Hog", 4, &xHeavyHandle);
         xTaskCreate(runInteractiveTask, "User", 1024, "User", 4, &xInteractHandle);
+        #endif
+        #if (TEST_JITTER_ENABLED == 1)
+            createJitterTasks(4, 0);
+        #endif
+        #if (TEST_ECHO_ENABLED == 1)
+            xTaskCreate(runEchoTask, "Echo", TEST_ECHO_STACK_SIZE, "Echo", 4, &xEchoHandle);
+        #endif
+        #if (TEST_DSP_ENABLED == 1)
+            createDspTasks(4, 0);
+        #endif
+        #if (TEST_COPY_ENABLED == 1)
+            createCopyTask(4, 0);
+        #endif
+        #if (TEST_ADC_ENABLED == 1)
+            createAdcTasks(4, 0);
+        #endif
+        #if (TEST_PIPELINE_ENABLED == 1)
+            createPipelineTasks(4, 0);
+        #endif
+        #if (TEST_BUTTON_ENABLED == 1)
+            xTaskCreate(vButtonTask, "Button", TEST_BUTTON_STACK_SIZE, NULL, 4, &xButtonHandle);
+        #endif
+        #if (TEST_SOAK_ENABLED == 1)
+            createSoakProbe(4, 0);
+        #endif
 
         /* DO NOT Register them. Standard FreeRTOS handles them naturally. */
     #endif
 
+    #if (TEST_RESPONSE_ENABLED == 1)
+    initResponse();
+    #endif
+
     /* 5. Start the Kernel */
     sendLog("[INFO] Starting Scheduler...\r\n");
     vTaskStartScheduler();
@@ -1,6 +1,149 @@
 #ifndef TEST_CONFIG_H_
 #define TEST_CONFIG_H_
 
+/* 1 = the scheduler policy chosen by SCHED_POLICY (MLFQ by default),
+ * 0 = plain FreeRTOS round robin */
 #define TEST_MODE 1
 
+/* 1 = switch between the two modes at run time, starting in TEST_MODE.
+ * The monitor switches every TEST_AB_SWITCH_SECONDS (0 = never on its
+ * own) and on 'm' (scheduler policy) or 's' (standard) from the UART. */
+#define TEST_AB_SWITCH_ENABLED 0
+#define TEST_AB_SWITCH_SECONDS 10
+
+/* Equal priority of the workload tasks in the control group */
+#define TEST_CONTROL_PRIORITY  4
+
+/* Priority of the monitor task, pinned with pinTask(). The top of the
+ * real-time band above the supervisor (scheduler.h) is outside the MLFQ
+ * levels and above the control priority, so the observer preempts the
+ * measured tasks the same way in both modes. */
+#define TEST_MONITOR_PRIORITY  MLFQ_RT_PRIORITY_MAX
+
+/* 1 = replace Hog/User with a mix of generator tasks (workloads.h) */
+#define TEST_WORKLOAD_MIX 0
+
+/* Generator tasks per class in the mix; dozens need a larger
+ * configTOTAL_HEAP_SIZE */
+#define TEST_MIX_SENSORS      4U
+#define TEST_MIX_NETWORK      3U
+#define TEST_MIX_COMPRESSION  1U
+#define TEST_MIX_STACK_SIZE   128U
+
+/* 1 = the mix replays the tasks recorded in test/replay_trace.h
+ * (tools/trace_decode.py --replay) instead of the synthetic classes.
+ * Needs TEST_WORKLOAD_MIX. */
+#define TEST_WORKLOAD_REPLAY  0
+
+/* 1 = add periodic tasks released with vTaskDelayUntil(), one per period
+ * below, next to the workload and at its priority. Each burns
+ * TEST_JITTER_WORK_US per release; the monitor prints a histogram of how
+ * late each release started, in both modes. */
+#define TEST_JITTER_ENABLED   0
+#define TEST_JITTER_TASKS     3U
+#define TEST_JITTER_PERIODS_MS { 10U, 20U, 50U }
+#define TEST_JITTER_WORK_US   200U
+#define TEST_JITTER_STACK_SIZE 128U
+
+/* 1 = fire Timer 1A every 1/TEST_IRQ_LATENCY_HZ s at the highest priority
+ * the kernel masks and time each trigger-to-handler delay with the cycle
+ * counter; the monitor prints the distribution in both modes. A delay
+ * longer than one period loses the timeout and is counted as missed. */
+#define TEST_IRQ_LATENCY_ENABLED 0
+#define TEST_IRQ_LATENCY_HZ      10000U
+
+/* 1 = time every request of the interactive task (User) from the tick it
+ * arrived at to its answer; the monitor prints the percentiles of the
+ * last second and of the run so far, in both modes */
+#define TEST_RESPONSE_ENABLED    1
+
+/* 1 = add the echo workload (runEchoTask() in workloads.h) next to the
+ * others and at their priority. It echoes every byte received on UART1
+ * (PC4 = RX, PC5 = TX); the monitor prints its receive-to-answer time and
+ * tools/echo_latency.py measures the round trip from the PC. */
+#define TEST_ECHO_ENABLED        0
+#define TEST_ECHO_STACK_SIZE     128U
+
+/* 1 = add the DSP benchmark tasks FIR, FFT and CRC (runFirTask() and
+ * the others in workloads.h) next to the workload and at its priority.
+ * Their blocks per second show up in the per-task Task rows. The stack
+ * leaves room for the FPU context of the FIR task */
+#define TEST_DSP_ENABLED         0
+#define TEST_DSP_STACK_SIZE      256U
+
+/* 1 = add the memory copy benchmark task (runCpuCopyTask() or
+ * runDmaCopyTask() in workloads.h) next to the workload and at its
+ * priority. TEST_COPY_DMA picks the variant: 0 copies with memcpy(), 1
+ * with the uDMA software channel. Its copies per second show up in the
+ * per-task Task rows, the interactive task's response times beside it */
+#define TEST_COPY_ENABLED        0
+#define TEST_COPY_DMA            0
+#define TEST_COPY_STACK_SIZE     128U
+
+/* 1 = add the ADC sampling pipeline (runAdcHandlerTask() and
+ * runAdcAggregateTask() in workloads.h) next to the workload and at its
+ * priority. The monitor prints the half-buffers each stage got through
+ * and their latency from the half filling; rebuild with another
+ * WORKLOAD_ADC_BATCH to trade wake-ups per sample against latency. The
+ * stack holds the aggregate task's stamps of one group */
+#define TEST_ADC_ENABLED         0
+#define TEST_ADC_STACK_SIZE      256U
+
+/* 1 = add the queue pipeline benchmark (runPipelineStageTask() in
+ * workloads.h), one task per stage, next to the workload and at its
+ * priority. The monitor prints each stage's items, input queue depth and
+ * item latency, and the items retired end to end, in both modes. Run it
+ * with and without MLFQ_AGING_ENABLED to see whether aging keeps a
+ * demoted bottleneck stage from stalling the chain */
+#define TEST_PIPELINE_ENABLED    0
+#define TEST_PIPELINE_STACK_SIZE 128U
+
+/* 1 = add a task that handles presses of the LaunchPad switches SW1/SW2
+ * (PF4/PF0), next to the workload and at its priority. Each press is
+ * timed from its edge interrupt to the task running and then handled for
+ * TEST_BUTTON_WORK_US; the monitor prints the latency per MLFQ level. */
+#define TEST_BUTTON_ENABLED      0
+#define TEST_BUTTON_WORK_US      2000U
+#define TEST_BUTTON_STACK_SIZE   128U
+
+/* Non-zero with MLFQ_BOTTOM_HALF_ENABLED: the button task is a bottom
+ * half with this High budget per press, in us (0 = ordinary task) */
+#define TEST_BUTTON_BUDGET_US    0U
+
+/* 1 = soak mode for burn-in runs of hours or days. The per-second rows
+ * are folded into windows of TEST_SOAK_WINDOW_S, and each window ends in
+ * three Soak rows (heavy and interactive ops per second, probe lateness)
+ * with samples, min, mean, max and p99. A probe task next to the workload
+ * and at its priority is released every TEST_SOAK_PROBE_MS and burns
+ * TEST_SOAK_PROBE_WORK_US per release; its lateness is the latency. */
+#define TEST_SOAK_ENABLED        0
+#define TEST_SOAK_WINDOW_S       600U
+#define TEST_SOAK_PROBE_MS       50U
+#define TEST_SOAK_PROBE_WORK_US  200U
+#define TEST_SOAK_STACK_SIZE     128U
+
+/* 1 = parameter sweep with the standard workload (TEST_MODE 1, no A/B
+ * switching, no soak). The monitor steps through every combination of
+ * the High quantum, boost period and level count below, the quanta of
+ * the lower levels scaled with High as in the level table. Each point
+ * runs TEST_SWEEP_SETTLE_S to settle, then TEST_SWEEP_WINDOW_S measured,
+ * and ends in one Sweep row; the boot parameters return at the end */
+#define TEST_SWEEP_ENABLED       0
+#define TEST_SWEEP_QUANTA_TICKS  { 5U, 10U, 20U, 50U }
+#define TEST_SWEEP_BOOSTS_MS     { 100U, 500U, 2000U }
+#define TEST_SWEEP_LEVELS        { 2U, 3U }
+#define TEST_SWEEP_WINDOW_S      10U
+#define TEST_SWEEP_SETTLE_S      2U
+
+/* 1 = tick-rate benchmark with the standard workload (no A/B switching,
+ * no soak, no sweep). Build it once per rate with -DMLFQ_TICK_RATE_HZ=n
+ * (100, 250, 500, 1000, 2000), -DIRQ_STATS_ENABLED=1U,
+ * -DIRQ_STATS_TICK_ENABLED=1U and -DSWITCH_STATS_ENABLED=1U; the quanta
+ * are in milliseconds and keep their length. After TEST_TICK_BENCH_SETTLE_S
+ * the monitor ends every TEST_TICK_BENCH_WINDOW_S in one TickRate row;
+ * tools/tick_sweep.py compares the captures of the rates */
+#define TEST_TICK_BENCH_ENABLED  0
+#define TEST_TICK_BENCH_WINDOW_S 10U
+#define TEST_TICK_BENCH_SETTLE_S 2U
+
 #endif //TEST_CONFIG_H_
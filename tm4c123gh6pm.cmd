@@ -10,7 +10,9 @@
 
 MEMORY
 {
-    FLASH (RX) : origin = 0x00000000, length = 0x00040000
+    FLASH (RX) : origin = 0x00000000, length = 0x00038000
+    /* Flash history ring (flash_log.h), never linked into */
+    FLASHLOG (R) : origin = 0x00038000, length = 0x00008000
     SRAM (RWX) : origin = 0x20000000, length = 0x00008000
 }
 
@@ -24,22 +26,71 @@ MEMORY
 /* --stack_size=256                                                          */
 /* --library=rtsv7M4_T_le_eabi.lib                                           */
 
+/* Scheduling hot path, copied from flash to SRAM by the boot routine      */
+/* (BINIT table) so the tick, context switch and expiry handling run with   */
+/* no flash wait states or prefetch misses. Relies on function subsections  */
+/* (--gen_func_subsections, on by default), which name each function's      */
+/* code .text:<name>; calls back into flash go through linker trampolines.  */
+/* Link with --define=MLFQ_HOT_PATH_IN_FLASH to keep everything in flash.   */
+
 /* Section allocation in memory */
 
 SECTIONS
 {
     .intvecs:   > 0x00000000
+
+#ifndef MLFQ_HOT_PATH_IN_FLASH
+    .TI.ramfunc :
+    {
+        /* Kernel tick and context switch */
+        *(.text:xPortSysTickHandler)
+        *(.text:xTaskIncrementTick)
+        *(.text:vTaskSwitchContext)
+
+        /* Profiler tick hook, switch hooks and quantum timer */
+        *(.text:vApplicationTickHook)
+        *(.text:findTaskRecord)
+        *(.text:quantumExhausted)
+        *(.text:reportExpiry)
+        *(.text:chargeRunningTask)
+        *(.text:tickProfilerTaskSwitchedIn)
+        *(.text:tickProfilerTaskSwitchedOut)
+        *(.text:tickProfilerQuantumTimerExpired)
+        *(.text:tickProfilerWriteBegin)
+        *(.text:tickProfilerWriteEnd)
+        *(.text:schedPolicyTaskSwitchedOut)
+
+        /* Supervisor expiry handling */
+        *(.text:checkForDemotion)
+        *(.text:mlfqOnQuantumExpired)
+        *(.text:setSlotLevel)
+        *(.text:applyLevelQuantum)
+        *(.text:getQuantumForLevel)
+        *(.text:tickProfilerSetLevel)
+        *(.text:updateLevelMask)
+        *(.text:tickProfilerTakeExpiredMask)
+        *(.text:atomicTake)
+        *(.text:setSlotQuantum)
+        *(.text:setSlotQuantumCycles)
+        *(.text:resetSlotRuntime)
+        *(.text:applyQuantum)
+        *(.text:clearRuntime)
+    } load = FLASH, run = SRAM, table(BINIT)
+#endif
+
     .text   :   > FLASH
     .const  :   > FLASH
     .cinit  :   > FLASH
     .pinit  :   > FLASH
     .init_array : > FLASH
+    .binit  :   > FLASH
 
     .vtable :   > 0x20000000
     .data   :   > SRAM
     .bss    :   > SRAM
     .sysmem :   > SRAM
     .stack  :   > SRAM
+    .noinit :   > SRAM, type = NOINIT   /* Flight recorder, kept across resets */
 }
 
 __STACK_TOP = __stack + 512;
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""
+MODULE NAME  : UART Echo Latency
+FILE         : echo_latency.py
+DESCRIPTION  : Host side of the echo workload (TEST_ECHO_ENABLED in
+               test/test_config.h). Sends single bytes to UART1 of the
+               board at a fixed interval, waits for each one to come back
+               and prints the round-trip percentiles, so the scheduler
+               policy and plain round robin can be compared on the delay
+               a user would see.
+AUTHOR       : Hassan Darwish
+Date         : October 2026
+
+Usage:
+    python3 echo_latency.py --port /dev/ttyUSB0
+    python3 echo_latency.py --port /dev/ttyUSB0 --count 2000 --label mlfq \
+        --csv echo.csv
+
+The USB serial adapter adds its own delay, often a millisecond or more of
+polling. Run once with the board idle to get the floor of the setup; the
+firmware's own share is printed on the board's Echo rows.
+"""
+
+import argparse
+import csv
+import sys
+import time
+
+
+def percentile(sorted_values, fraction):
+    """Returns the nearest-rank percentile of an ascending list."""
+    if not sorted_values:
+        return 0.0
+    rank = max(0, min(len(sorted_values) - 1,
+                      int(round(fraction * len(sorted_values))) - 1))
+    return sorted_values[rank]
+
+
+def measure(port, count, interval, timeout):
+    """Returns the round trips in ms and the number of lost bytes."""
+    samples = []
+    lost = 0
+
+    port.timeout = timeout
+    port.reset_input_buffer()
+
+    for index in range(count):
+        byte = bytes([0x21 + (index % 94)])   # printable, never a command
+        start = time.perf_counter()
+        port.write(byte)
+        port.flush()
+        answer = port.read(1)
+        elapsed = (time.perf_counter() - start) * 1000.0
+
+        if answer == byte:
+            samples.append(elapsed)
+        else:
+            lost += 1
+            port.reset_input_buffer()
+
+        remaining = interval - (time.perf_counter() - start)
+        if remaining > 0:
+            time.sleep(remaining)
+
+    return samples, lost
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--port", required=True, help="serial port of UART1")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--count", type=int, default=500, help="bytes to send")
+    parser.add_argument("--interval-ms", type=float, default=20.0,
+                        help="time between bytes")
+    parser.add_argument("--timeout-ms", type=float, default=500.0,
+                        help="wait for an echo before counting it lost")
+    parser.add_argument("--label", default="", help="tag of the run, e.g. mlfq")
+    parser.add_argument("--csv", help="append a summary row to this file")
+    args = parser.parse_args()
+
+    import serial  # pyserial
+    port = serial.Serial(args.port, args.baud)
+
+    try:
+        samples, lost = measure(port, args.count, args.interval_ms / 1000.0,
+                                args.timeout_ms / 1000.0)
+    except KeyboardInterrupt:
+        sys.exit(1)
+    finally:
+        port.close()
+
+    samples.sort()
+    row = {
+        "label": args.label,
+        "samples": len(samples),
+        "lost": lost,
+        "min_ms": samples[0] if samples else 0.0,
+        "p50_ms": percentile(samples, 0.50),
+        "p90_ms": percentile(samples, 0.90),
+        "p99_ms": percentile(samples, 0.99),
+        "max_ms": samples[-1] if samples else 0.0,
+    }
+
+    print("Echo %s: %d samples, %d lost" % (args.label or "run", row["samples"], lost))
+    print("  min %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f ms" %
+          (row["min_ms"], row["p50_ms"], row["p90_ms"], row["p99_ms"], row["max_ms"]))
+
+    if args.csv:
+        with open(args.csv, "a", newline="") as handle:
+            writer = csv.DictWriter(handle, fieldnames=list(row))
+            if handle.tell() == 0:
+                writer.writeheader()
+            writer.writerow(row)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,412 @@
+#!/usr/bin/env python3
+"""
+MODULE NAME  : MLFQ Capture Analyzer
+FILE         : mlfq_analyze.py
+DESCRIPTION  : Host-side analysis of a whole UART or SWO capture. Rebuilds
+               per-task timelines from the event trace dumps
+               (eventTraceDump) and the binary level records
+               (METRICS_BINARY_LOG_ENABLED), prints latency, throughput
+               and fairness figures, renders a Gantt chart of the running
+               task and its level as SVG, and compares two runs, e.g. the
+               MLFQ and round robin modes of test/test.c.
+AUTHOR       : Hassan Darwish
+Date         : October 2026
+
+Usage:
+    python3 mlfq_analyze.py mlfq.txt
+    python3 mlfq_analyze.py mlfq.txt --gantt mlfq.svg
+    python3 mlfq_analyze.py mlfq.txt --diff rr.txt --labels mlfq,rr
+    python3 mlfq_analyze.py capture.swo --swo
+
+A capture may hold any mix of text and binary output: trace dumps, the
+CSV rows of the test entry points and COBS frames are each picked out of
+the same byte stream, and whatever is not recognised is skipped. Several
+trace dumps in one capture are laid end to end on the timeline.
+"""
+
+import argparse
+import io
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import mlfq_decode    # noqa: E402  COBS framing and binary record layouts
+import trace_decode   # noqa: E402  Trace dump parser
+
+# Event identifiers (keep in sync with event_trace.h)
+EVENT_DEMOTION = 2
+EVENT_PROMOTION = 3
+EVENT_BOOST_START = 4
+EVENT_SWITCH_IN = 6
+EVENT_SWITCH_OUT = 7
+EVENT_BLOCK = 8
+EVENT_UNBLOCK = 9
+
+# Tasks register at High, so that is the level until the first change
+LEVEL_HIGH = 0
+
+# Gantt colours per level, as on the LaunchPad LED where it has one
+LEVEL_COLOURS = {0: "#d62728", 1: "#1f77b4", 2: "#2ca02c"}
+OTHER_COLOUR = "#7f7f7f"
+
+# Gantt layout in pixels
+GANTT_WIDTH = 1200
+GANTT_LABEL = 110
+GANTT_ROW = 20
+
+
+class Run:
+    """Everything recovered from one capture."""
+
+    def __init__(self, label):
+        self.label = label
+        self.running = {}        # task key -> [(start_us, end_us, level)]
+        self.levels = {}         # task key -> [(time_us, level)]
+        self.waits = {}          # task key -> [ready-to-run us]
+        self.preempted = {}      # task key -> switch-outs while still ready
+        self.duration_us = 0.0
+        self.throughput = {}     # mode -> [(heavy_ops, inter_ops)]
+        self.task_ops = {}       # mode -> {task name: [ops per second]}
+
+
+def percentile(sorted_values, fraction):
+    """Returns the nearest-rank percentile of an ascending list."""
+    if not sorted_values:
+        return 0.0
+    rank = max(0, min(len(sorted_values) - 1,
+                      int(round(fraction * len(sorted_values))) - 1))
+    return sorted_values[rank]
+
+
+def jain(values):
+    """Jain's fairness index: 1.0 when all shares are equal, 1/n at worst."""
+    values = [v for v in values if v >= 0]
+    if not values or sum(values) == 0:
+        return 0.0
+    return sum(values) ** 2 / (len(values) * sum(v * v for v in values))
+
+
+def demux_swo(data):
+    """Splits raw SWO bytes into per-port streams of ITM software packets.
+
+    Sync, overflow, timestamp and hardware source packets are skipped."""
+    ports = {}
+    i = 0
+    while i < len(data):
+        header = data[i]
+        i += 1
+        if header == 0x00 or header == 0x80 or header == 0x70:
+            continue
+        size = {1: 1, 2: 2, 3: 4}.get(header & 0x03, 0)
+        if size == 0:
+            # Timestamp or extension: continuation bytes have bit 7 set
+            if header & 0x80:
+                while i < len(data) and data[i] & 0x80:
+                    i += 1
+                i += 1
+            continue
+        if header & 0x04 == 0:
+            ports.setdefault(header >> 3, bytearray()).extend(data[i:i + size])
+        i += size
+    return ports
+
+
+def load_capture(path, swo):
+    """Returns the text lines and the byte stream holding binary frames."""
+    with open(path, "rb") as handle:
+        data = handle.read()
+    if swo:
+        ports = demux_swo(data)
+        binary = bytes(ports.get(0, b""))
+        data = b"".join(bytes(ports[port]) for port in sorted(ports))
+    else:
+        binary = data
+    text = data.decode("latin-1").replace("\r", "").split("\n")
+    return text, binary
+
+
+def add_level(run, key, time_us, level):
+    changes = run.levels.setdefault(key, [(0.0, LEVEL_HIGH)])
+    if changes[-1][1] != level:
+        changes.append((time_us, level))
+
+
+def level_at(run, key, time_us):
+    level = LEVEL_HIGH
+    for stamp, value in run.levels.get(key, ()):
+        if stamp > time_us:
+            break
+        level = value
+    return level
+
+
+def read_trace(run, lines):
+    """Rebuilds running intervals, levels and waits from the trace dumps."""
+    offset = 0.0
+    for dump in trace_decode.read_dumps(lines):
+        events = trace_decode.unwrap(dump.events)
+        if not events:
+            continue
+        start = events[0][0]
+        scale = 1e6 / dump.cpu_hz
+        for name in dump.names.values():
+            run.levels.setdefault(name, [(0.0, LEVEL_HIGH)])
+
+        current = None
+        since = 0.0
+        ready = {}
+        blocking = set()
+        for stamp, event, task, slot, arg0, arg1 in events:
+            key = dump.names.get(task, "0x%08x" % task) if task else None
+            now = offset + (stamp - start) * scale
+            if event in (EVENT_DEMOTION, EVENT_PROMOTION) and key:
+                add_level(run, key, now, arg1)
+            elif event == EVENT_BOOST_START:
+                for other in list(run.levels):
+                    add_level(run, other, now, LEVEL_HIGH)
+            elif event == EVENT_SWITCH_IN and key:
+                current, since = key, now
+                if key in ready:
+                    run.waits.setdefault(key, []).append(now - ready.pop(key))
+            elif event == EVENT_SWITCH_OUT and key:
+                if current == key:
+                    run.running.setdefault(key, []).append(
+                        (since, now, level_at(run, key, since)))
+                    current = None
+                if key in blocking:
+                    blocking.discard(key)
+                else:
+                    ready[key] = now
+                    run.preempted[key] = run.preempted.get(key, 0) + 1
+            elif event == EVENT_BLOCK and key:
+                blocking.add(key)
+            elif event == EVENT_UNBLOCK and key:
+                ready.setdefault(key, now)
+
+        end = offset + (events[-1][0] - start) * scale
+        if current is not None:
+            run.running.setdefault(current, []).append(
+                (since, end, level_at(run, current, since)))
+        offset = end
+    run.duration_us = max(run.duration_us, offset)
+
+
+def read_binary(run, binary, tick_hz):
+    """Adds the level changes and boosts of the binary records, which keep
+    running for as long as the capture, unlike the trace ring."""
+    names = {}
+    first = None
+    last = 0.0
+    for payload in mlfq_decode.frames(io.BytesIO(binary)):
+        kind = payload[0]
+        if kind == mlfq_decode.RECORD_TASK_NAME:
+            names[payload[1]] = payload[4:].decode("ascii", "replace")
+            continue
+        if len(payload) != mlfq_decode.RECORD_SIZE:
+            continue
+        (kind, task_id, level, prev_level, timestamp,
+         _, _, _, _) = struct.unpack(mlfq_decode.RECORD_FORMAT, payload)
+        if first is None:
+            first = timestamp
+        now = (timestamp - first) * 1e6 / tick_hz
+        last = max(last, now)
+        key = names.get(task_id, "task%d" % task_id)
+        if kind == mlfq_decode.RECORD_LEVEL_CHANGE:
+            add_level(run, key, now, level)
+        elif kind == mlfq_decode.RECORD_BOOST:
+            for other in list(run.levels):
+                add_level(run, other, now, LEVEL_HIGH)
+        elif kind == mlfq_decode.RECORD_TASK_STATS:
+            add_level(run, key, now, level)
+    run.duration_us = max(run.duration_us, last)
+
+
+def read_csv(run, lines):
+    """Collects the per-second rows of test/test.c by mode."""
+    for line in lines:
+        fields = [field.strip() for field in line.split(",")]
+        try:
+            if len(fields) == 4 and fields[0].isdigit():
+                mode = int(fields[1])
+                run.throughput.setdefault(mode, []).append((int(fields[2]), int(fields[3])))
+            elif len(fields) == 5 and fields[0] == "Task":
+                mode = int(fields[1])
+                per_task = run.task_ops.setdefault(mode, {})
+                per_task.setdefault(fields[2], []).append(int(fields[4]))
+        except ValueError:
+            continue
+
+
+def analyze(path, label, swo, tick_hz):
+    run = Run(label)
+    text, binary = load_capture(path, swo)
+    read_trace(run, text)
+    if not run.running:
+        read_binary(run, binary, tick_hz)
+    read_csv(run, text)
+    return run
+
+
+def summarize(run, mode=None):
+    """Returns the figures compared between runs, as name -> value. The
+    test rows are taken from one mode: the given one, or the only one in
+    the capture. The trace figures cover the whole capture."""
+    figures = {}
+    cpu = {key: sum(end - start for start, end, _ in spans)
+           for key, spans in run.running.items()}
+    waits = sorted(w for samples in run.waits.values() for w in samples)
+
+    if cpu:
+        figures["traced_ms"] = run.duration_us / 1000.0
+        figures["switches"] = sum(len(spans) for spans in run.running.values())
+        figures["preemptions"] = sum(run.preempted.values())
+        figures["wait_p50_us"] = percentile(waits, 0.50)
+        figures["wait_p99_us"] = percentile(waits, 0.99)
+        figures["wait_max_us"] = waits[-1] if waits else 0.0
+        figures["cpu_fairness"] = jain(list(cpu.values()))
+
+    modes = set(run.throughput) | set(run.task_ops)
+    if mode is None and len(modes) == 1:
+        mode = modes.pop()
+
+    rows = run.throughput.get(mode)
+    if rows:
+        figures["heavy_ops"] = sum(r[0] for r in rows) / len(rows)
+        figures["inter_ops"] = sum(r[1] for r in rows) / len(rows)
+
+    per_task = run.task_ops.get(mode)
+    if per_task:
+        means = [sum(ops) / len(ops) for ops in per_task.values() if ops]
+        figures["task_fairness"] = jain(means)
+
+    return figures
+
+
+def print_run(run):
+    print("== %s" % run.label)
+    keys = sorted(set(run.running) | set(run.levels))
+    if run.running:
+        print("%-12s %10s %7s %9s %9s %9s %9s  %s" %
+              ("Task", "CPU (ms)", "CPU %", "Switches", "Preempted",
+               "Wait p50", "Wait p99", "Time per level (ms)"))
+    elif keys:
+        print("%-12s  %s" % ("Task", "Time per level (ms)"))
+    for key in keys:
+        spans = run.running.get(key, [])
+        busy = sum(end - start for start, end, _ in spans)
+        share = (100.0 * busy / run.duration_us) if run.duration_us else 0.0
+        waits = sorted(run.waits.get(key, []))
+        changes = run.levels.get(key, [(0.0, LEVEL_HIGH)])
+        per_level = {}
+        for index, (stamp, level) in enumerate(changes):
+            until = changes[index + 1][0] if index + 1 < len(changes) else run.duration_us
+            per_level[level] = per_level.get(level, 0.0) + max(0.0, until - stamp)
+        levels = " ".join("%s %.0f" % (mlfq_decode.LEVEL_NAMES.get(level, level), t / 1000.0)
+                          for level, t in sorted(per_level.items()))
+        if run.running:
+            print("%-12s %10.2f %7.1f %9d %9d %9.1f %9.1f  %s" %
+                  (key, busy / 1000.0, share, len(spans), run.preempted.get(key, 0),
+                   percentile(waits, 0.50), percentile(waits, 0.99), levels))
+        else:
+            print("%-12s  %s" % (key, levels))
+
+    for mode, per_task in sorted(run.task_ops.items()):
+        print("Mode %d work per task (ops/s, mean)" % mode)
+        for name, ops in sorted(per_task.items()):
+            print("  %-12s %10.1f" % (name, sum(ops) / len(ops)))
+
+    modes = sorted(set(run.throughput) | set(run.task_ops))
+    if len(modes) > 1:
+        # An A/B capture (TEST_AB_SWITCH_ENABLED): one mode against the other
+        print_diff("mode %d" % modes[-1], "mode %d" % modes[0],
+                   summarize(run, modes[-1]), summarize(run, modes[0]))
+    else:
+        for name, value in summarize(run).items():
+            print("%-22s %12.3f" % (name, value))
+        print()
+
+
+def print_diff(first, second, a, b):
+    print("%-22s %12s %12s %9s" % ("Figure", first, second, "Change"))
+    print("-" * 58)
+    for name in [n for n in a if n in b] + [n for n in b if n not in a]:
+        left = a.get(name)
+        right = b.get(name)
+        if left is None or right is None:
+            print("%-22s %12s %12s %9s" % (name, "-" if left is None else "%.3f" % left,
+                                            "-" if right is None else "%.3f" % right, ""))
+            continue
+        change = ("%+8.1f%%" % (100.0 * (right - left) / left)) if left else ""
+        print("%-22s %12.3f %12.3f %9s" % (name, left, right, change))
+    print()
+
+
+def write_gantt(run, path):
+    """Draws one row per task: running spans in the colour of their level,
+    and a thin strip above them with the level the task was at."""
+    keys = sorted(set(run.running) | set(run.levels))
+    span = run.duration_us or 1.0
+    plot = GANTT_WIDTH - GANTT_LABEL - 10
+    height = (len(keys) + 2) * GANTT_ROW
+
+    def x(time_us):
+        return GANTT_LABEL + plot * time_us / span
+
+    out = ['<svg xmlns="http://www.w3.org/2000/svg" width="%d" height="%d" '
+           'font-family="monospace" font-size="11">' % (GANTT_WIDTH, height)]
+    for row, key in enumerate(keys):
+        top = (row + 1) * GANTT_ROW
+        out.append('<text x="4" y="%d">%s</text>' % (top + 14, key))
+        changes = run.levels.get(key, [(0.0, LEVEL_HIGH)])
+        for index, (stamp, level) in enumerate(changes):
+            until = changes[index + 1][0] if index + 1 < len(changes) else span
+            out.append('<rect x="%.2f" y="%d" width="%.2f" height="3" fill="%s"/>' %
+                       (x(stamp), top + 1, max(0.5, x(until) - x(stamp)),
+                        LEVEL_COLOURS.get(level, OTHER_COLOUR)))
+        for start, end, level in run.running.get(key, ()):
+            out.append('<rect x="%.2f" y="%d" width="%.2f" height="%d" fill="%s">'
+                       '<title>%s %.1f-%.1f us</title></rect>' %
+                       (x(start), top + 5, max(0.5, x(end) - x(start)), GANTT_ROW - 7,
+                        LEVEL_COLOURS.get(level, OTHER_COLOUR), key, start, end))
+
+    axis = (len(keys) + 1) * GANTT_ROW + 14
+    for tick in range(11):
+        time_us = span * tick / 10
+        out.append('<text x="%.0f" y="%d">%.0f ms</text>' % (x(time_us) - 10, axis,
+                                                            time_us / 1000.0))
+    out.append("</svg>")
+    with open(path, "w") as handle:
+        handle.write("\n".join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("capture", help="captured UART or SWO bytes")
+    parser.add_argument("--diff", help="second capture to compare with")
+    parser.add_argument("--labels", default="first,second",
+                        help="comma-separated names of the two runs")
+    parser.add_argument("--gantt", help="write the first run's Gantt chart (SVG)")
+    parser.add_argument("--swo", action="store_true",
+                        help="captures are raw SWO (ITM packets, LOG_ITM_ENABLED)")
+    parser.add_argument("--tick-hz", type=int, default=100,
+                        help="configTICK_RATE_HZ, for binary record stamps")
+    args = parser.parse_args()
+
+    labels = (args.labels.split(",") + ["first", "second"])[:2]
+    first = analyze(args.capture, labels[0], args.swo, args.tick_hz)
+    print_run(first)
+
+    if args.gantt:
+        write_gantt(first, args.gantt)
+        print("Gantt chart written to %s" % args.gantt)
+
+    if args.diff:
+        second = analyze(args.diff, labels[1], args.swo, args.tick_hz)
+        print_run(second)
+        print_diff(first.label, second.label, summarize(first), summarize(second))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,827 @@
+#!/usr/bin/env python3
+"""
+MODULE NAME  : MLFQ Binary Log Decoder
+FILE         : mlfq_decode.py
+DESCRIPTION  : Host-side decoder for the COBS-framed binary records produced
+               by metrics_logger.c when METRICS_BINARY_LOG_ENABLED is set.
+               Prints the queue report table, or CSV with --csv.
+               Delta reports (METRICS_DIFF_REPORT_ENABLED) are merged
+               into the rows of the last keyframe before printing, and
+               TASK_DELTA frames (METRICS_DELTA_LOG_ENABLED) are restored
+               to whole rows.
+AUTHOR       : Hassan Darwish
+Date         : October 2026
+
+Usage:
+    python3 mlfq_decode.py capture.bin
+    python3 mlfq_decode.py --port /dev/ttyACM0 [--baud 115200] [--csv] [--watch]
+    python3 mlfq_decode.py capture.bin --map Debug/MLFQ.map
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+# Record types (keep in sync with metrics_logger.h)
+RECORD_TASK_STATS = 0x01
+RECORD_LEVEL_CHANGE = 0x02
+RECORD_BOOST = 0x03
+RECORD_TASK_NAME = 0x04
+RECORD_REPORT_END = 0x05
+RECORD_LATENCY = 0x06
+RECORD_INVERSION = 0x07
+RECORD_POPULATION = 0x08
+RECORD_CPU = 0x09
+RECORD_STACK = 0x0A
+RECORD_HEAP = 0x0B
+RECORD_OVERLOAD = 0x0C
+RECORD_WATCHDOG = 0x0D
+RECORD_SWITCHES = 0x0E
+RECORD_TASK_DELTA = 0x0F
+RECORD_CORE = 0x10
+RECORD_SELF = 0x11
+RECORD_LEVEL_TIME = 0x12
+RECORD_DEGRADED = 0x13
+RECORD_FPU = 0x14
+RECORD_WAIT = 0x15
+RECORD_PC_SAMPLES = 0x16
+RECORD_STATE_TIME = 0x17
+RECORD_TIMER = 0x18
+
+# Task delta frames: type, task_id, flags, sequence, then one zigzag varint
+# per flagged field of RECORD_FORMAT after the task id
+DELTA_FIELDS = 7
+DELTA_LEVEL_CHANGE = 0x80
+
+# Watchdog events (METRICS_WATCHDOG_x in metrics_logger.h)
+WATCHDOG_STARVED = 1
+
+# Level of a REPORT_END record (METRICS_REPORT_x in metrics_logger.h)
+REPORT_DELTA = 1
+
+# Overload causes (MLFQ_OVERLOAD_CAUSE_x in scheduler.h)
+OVERLOAD_CAUSES = ((0x01, "demand"), (0x02, "starvation"))
+
+TASK_ID_NONE = 0xFF
+
+# Little-endian MetricsRecord_t
+RECORD_FORMAT = "<BBBBIIIII"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+# Little-endian MetricsLatencyRecord_t
+LATENCY_FORMAT = "<BBBBIIII"
+LATENCY_SIZE = struct.calcsize(LATENCY_FORMAT)
+
+# Little-endian MetricsInversionRecord_t
+INVERSION_FORMAT = "<BBBBIII"
+INVERSION_SIZE = struct.calcsize(INVERSION_FORMAT)
+
+# Little-endian MetricsPopulationRecord_t
+POPULATION_FORMAT = "<BBBBI"
+POPULATION_SIZE = struct.calcsize(POPULATION_FORMAT)
+
+# Little-endian MetricsCpuRecord_t
+CPU_FORMAT = "<BBBBIQ"
+CPU_SIZE = struct.calcsize(CPU_FORMAT)
+
+# Little-endian MetricsSwitchRecord_t
+SWITCH_FORMAT = "<BBBBIII"
+SWITCH_SIZE = struct.calcsize(SWITCH_FORMAT)
+
+# Little-endian MetricsFpuRecord_t
+FPU_FORMAT = "<BBBBIII"
+FPU_SIZE = struct.calcsize(FPU_FORMAT)
+
+# Little-endian MetricsWaitRecord_t
+WAIT_FORMAT = "<BBBBIIII"
+WAIT_SIZE = struct.calcsize(WAIT_FORMAT)
+
+# Little-endian MetricsPcSampleRecord_t; start is PC_OUTSIDE for the
+# samples outside the sampled range
+PC_FORMAT = "<BBBBIII"
+PC_SIZE = struct.calcsize(PC_FORMAT)
+PC_OUTSIDE = 0xFFFFFFFF
+
+# Little-endian MetricsStateTimeRecord_t
+STATE_FORMAT = "<BBBBIII"
+STATE_SIZE = struct.calcsize(STATE_FORMAT)
+
+# Little-endian MetricsTimerRecord_t; callback is 0 for the overflow entry
+TIMER_FORMAT = "<BBBBIIIII"
+TIMER_SIZE = struct.calcsize(TIMER_FORMAT)
+
+# Little-endian MetricsLevelTimeRecord_t header; one uint32 per level follows
+LEVEL_TIME_FORMAT = "<BBBBI"
+LEVEL_TIME_SIZE = struct.calcsize(LEVEL_TIME_FORMAT)
+
+# Little-endian MetricsStackRecord_t, followed by the task name
+STACK_FORMAT = "<BBBBIII"
+STACK_SIZE = struct.calcsize(STACK_FORMAT)
+
+# Little-endian MetricsHeapRecord_t
+HEAP_FORMAT = "<BBBBIIIIIII"
+HEAP_SIZE = struct.calcsize(HEAP_FORMAT)
+
+# Little-endian MetricsCoreRecord_t
+CORE_FORMAT = "<BBBBIII"
+CORE_SIZE = struct.calcsize(CORE_FORMAT)
+
+# Little-endian MetricsSelfRecord_t
+SELF_FORMAT = "<BBBBIIIIIIIIIQ"
+SELF_SIZE = struct.calcsize(SELF_FORMAT)
+
+# MetricsCpuRecord_t kinds 2..4 and 6 (0 is a task, 1 a level, 5 an interrupt,
+# 7 the idle share of the core in the level field)
+CPU_KIND_NAMES = {2: "Supervisor", 3: "Other", 4: "Idle", 6: "Asleep"}
+CPU_KIND_IRQ = 5
+CPU_KIND_CORE_IDLE = 7
+
+# Built-in interrupt sources (irq_stats.h); application ones print by id
+IRQ_NAMES = {0: "IRQ UART0", 1: "IRQ Timer"}
+
+LEVEL_NAMES = {0: "High", 1: "Medium", 2: "Low"}
+
+# Latency rows (type 6) reuse the last four columns for samples,p50,p99,max;
+# inversion rows (type 7) use the last three for episodes,total,max;
+# population rows (type 8) put the task count in the run column;
+# CPU rows (type 9) put the share in 0.1 % in the run column and the
+# lifetime CPU time in ms in the quantum column;
+# stack rows (type 10) use the last three for size,min_free,suggested words;
+# switch rows (type 14) use the last three for switch_ins,voluntary,involuntary;
+# FPU rows (type 20) use the last three for saves,fpu_saves,fpu_kcycles;
+# wait rows (type 21) put direction@object in the run column and use the
+# last three for waits,total_us,max_us;
+# PC sample rows (type 22) put the address range in the run column,
+# samples and task_samples in the next two, and the mapped symbols in wait;
+# state time rows (type 23) use the last three for running,ready,blocked ms;
+# the heap row (type 11) puts free,min_free,largest,blocks in the last four
+CSV_HEADER = "type,timestamp,task_id,name,level,prev_level,run,quantum,arrival,wait"
+
+
+def load_map(path):
+    """Reads the global symbols of a CCS (TI linker) map file, as a sorted
+    list of (address, name). The Thumb bit of function addresses is
+    cleared."""
+    symbols = []
+    in_table = False
+    with open(path, "r", errors="replace") as handle:
+        for line in handle:
+            if line.startswith("GLOBAL SYMBOLS: SORTED BY Symbol Address"):
+                in_table = True
+                continue
+            if not in_table:
+                continue
+            if line.startswith("["):  # "[N symbols]" closes the table
+                break
+            fields = line.split()
+            if len(fields) == 2:
+                try:
+                    address = int(fields[0], 16)
+                except ValueError:
+                    continue
+                symbols.append((address & ~1, fields[1]))
+    symbols.sort()
+    return symbols
+
+
+def symbols_in(symbols, start, end):
+    """Names of the symbols covering [start, end]: the one the range starts
+    in, then every one that starts inside it."""
+    names = []
+    for address, name in symbols:
+        if address <= start:
+            names = [name]
+        elif address <= end:
+            names.append(name)
+        else:
+            break
+    return names
+
+
+def crc16(data):
+    """CRC-16/ARC, identical to TivaWare sw_crc Crc16() with a zero seed."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0xA001 if crc & 1 else crc >> 1
+    return crc
+
+
+def cobs_decode(frame):
+    """Decodes one COBS frame (delimiter already stripped)."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame) + 1:
+            raise ValueError("bad COBS code")
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+class WatchedPort:
+    """Serial port that renews the board's report lease with the console
+    "watch" command while it is read. Boards built with
+    MLFQ_REPORT_ON_DEMAND_ENABLED only report while a lease runs; the
+    lease is MLFQ_REPORT_LEASE_MS (10 s by default)."""
+
+    RENEW_S = 4.0
+
+    def __init__(self, port):
+        self.port = port
+        self.renewed = None
+
+    def read(self, size):
+        now = time.monotonic()
+        if self.renewed is None or now - self.renewed >= self.RENEW_S:
+            self.port.write(b"watch\r")
+            self.renewed = now
+        return self.port.read(size)
+
+
+def frames(stream, live=False):
+    """Yields decoded, CRC-checked payloads from a byte stream."""
+    pending = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if live:
+                continue
+            break
+        for byte in chunk:
+            if byte != 0:
+                pending.append(byte)
+                continue
+            if pending:
+                try:
+                    raw = cobs_decode(bytes(pending))
+                except ValueError:
+                    raw = b""
+                if len(raw) > 2:
+                    payload, crc = raw[:-2], struct.unpack("<H", raw[-2:])[0]
+                    if crc16(payload) == crc:
+                        yield payload
+                    else:
+                        sys.stderr.write("dropped frame: CRC mismatch\n")
+            pending.clear()
+
+
+class Decoder:
+    def __init__(self, csv, symbols=None):
+        self.csv = csv
+        self.symbols = symbols or []
+        self.names = {}
+        self.rows = []
+        self.table = {}
+        self.bases = {}
+        self.latency_open = False
+        self.inversion_open = False
+        self.wait_open = False
+        self.pc_open = False
+        self.timer_open = False
+        self.state_open = False
+        self.population_open = False
+        self.cpu_open = False
+        self.stack_open = False
+        self.switch_open = False
+        self.fpu_open = False
+        self.core_open = False
+        self.self_metrics = None
+        self.self_last = None
+        self.level_time_open = False
+        self.level_time_last = {}
+        if csv:
+            print(CSV_HEADER)
+
+    def name(self, task_id):
+        return self.names.get(task_id, "task%d" % task_id)
+
+    def expand_delta(self, payload):
+        """Restores a TASK_DELTA frame to a whole record, or None when the
+        task has no base (a frame was lost) until its next whole row."""
+        if len(payload) < 4:
+            return None
+        task_id, flags, sequence = payload[1], payload[2], payload[3]
+        base = self.bases.get(task_id)
+        if base is None or sequence != base[1] + 1:
+            self.bases.pop(task_id, None)
+            sys.stderr.write("dropped delta: no base for task %d\n" % task_id)
+            return None
+
+        fields = list(base[0])
+        pos = 4
+        for i in range(DELTA_FIELDS):
+            if not flags & (1 << i):
+                continue
+            value, shift = 0, 0
+            while True:
+                if pos >= len(payload):
+                    self.bases.pop(task_id, None)
+                    return None
+                byte = payload[pos]
+                pos += 1
+                value |= (byte & 0x7F) << shift
+                shift += 7
+                if not byte & 0x80:
+                    break
+            diff = (value >> 1) ^ -(value & 1)
+            fields[i] = (fields[i] + diff) & 0xFFFFFFFF
+
+        self.bases[task_id] = (fields, sequence)
+        kind = RECORD_LEVEL_CHANGE if flags & DELTA_LEVEL_CHANGE else RECORD_TASK_STATS
+        return struct.pack(RECORD_FORMAT, kind, task_id, *fields)
+
+    def handle(self, payload):
+        kind = payload[0]
+
+        if kind == RECORD_TASK_DELTA:
+            payload = self.expand_delta(payload)
+            if payload is None:
+                return
+        elif kind in (RECORD_TASK_STATS, RECORD_LEVEL_CHANGE) and len(payload) == RECORD_SIZE:
+            # A whole row is the base of the task's next deltas
+            fields = struct.unpack(RECORD_FORMAT, payload)
+            self.bases[fields[1]] = (fields[2:], 0)
+
+        if kind == RECORD_TASK_NAME:
+            self.names[payload[1]] = payload[4:].decode("ascii", "replace")
+            return
+
+        if kind == RECORD_LATENCY and len(payload) == LATENCY_SIZE:
+            self.handle_latency(payload)
+            return
+
+        if kind == RECORD_INVERSION and len(payload) == INVERSION_SIZE:
+            self.handle_inversion(payload)
+            return
+
+        if kind == RECORD_WAIT and len(payload) == WAIT_SIZE:
+            self.handle_wait(payload)
+            return
+
+        if kind == RECORD_PC_SAMPLES and len(payload) == PC_SIZE:
+            self.handle_pc_samples(payload)
+            return
+
+        if kind == RECORD_STATE_TIME and len(payload) == STATE_SIZE:
+            self.handle_state_time(payload)
+            return
+
+        if kind == RECORD_TIMER and len(payload) == TIMER_SIZE:
+            self.handle_timer(payload)
+            return
+
+        if kind == RECORD_POPULATION and len(payload) == POPULATION_SIZE:
+            self.handle_population(payload)
+            return
+
+        if kind == RECORD_CPU and len(payload) == CPU_SIZE:
+            self.handle_cpu(payload)
+            return
+
+        if kind == RECORD_SWITCHES and len(payload) == SWITCH_SIZE:
+            self.handle_switches(payload)
+            return
+
+        if kind == RECORD_FPU and len(payload) == FPU_SIZE:
+            self.handle_fpu(payload)
+            return
+
+        if (kind == RECORD_LEVEL_TIME and len(payload) >= LEVEL_TIME_SIZE and
+                len(payload) == LEVEL_TIME_SIZE + 4 * payload[3]):
+            self.handle_level_time(payload)
+            return
+
+        if kind == RECORD_STACK and len(payload) >= STACK_SIZE:
+            self.handle_stack(payload)
+            return
+
+        if kind == RECORD_HEAP and len(payload) == HEAP_SIZE:
+            self.handle_heap(payload)
+            return
+
+        if kind == RECORD_CORE and len(payload) == CORE_SIZE:
+            self.handle_core(payload)
+            return
+
+        if kind == RECORD_SELF and len(payload) == SELF_SIZE:
+            self.handle_self(payload)
+            return
+
+        if len(payload) != RECORD_SIZE:
+            sys.stderr.write("dropped frame: bad length %d\n" % len(payload))
+            return
+
+        (kind, task_id, level, prev_level, timestamp,
+         run, quantum, arrival, wait) = struct.unpack(RECORD_FORMAT, payload)
+
+        if self.csv:
+            label = "" if task_id == TASK_ID_NONE else self.name(task_id)
+            print("%d,%u,%d,%s,%d,%d,%u,%u,%u,%u" %
+                  (kind, timestamp, task_id, label, level, prev_level,
+                   run, quantum, arrival, wait))
+            return
+
+        if kind == RECORD_TASK_STATS:
+            self.rows.append((task_id, (self.name(task_id), level, run, quantum, arrival, wait)))
+        elif kind == RECORD_REPORT_END:
+            self.print_report(level == REPORT_DELTA, run)
+        elif kind == RECORD_LEVEL_CHANGE:
+            print("[%8u] %-10s %s -> %s (run %u)" %
+                  (timestamp, self.name(task_id),
+                   LEVEL_NAMES.get(prev_level, prev_level),
+                   LEVEL_NAMES.get(level, level), run))
+        elif kind == RECORD_BOOST:
+            print("[%8u] global boost" % timestamp)
+        elif kind == RECORD_OVERLOAD:
+            causes = " ".join(name for bit, name in OVERLOAD_CAUSES if prev_level & bit)
+            waiter = "" if task_id == TASK_ID_NONE else " (%s)" % self.name(task_id)
+            print("[%8u] overload %s: upper levels %u.%u %%, Low wait %u ms%s, alarm %u" %
+                  (timestamp, causes, run // 10, run % 10, quantum, waiter, arrival))
+        elif kind == RECORD_DEGRADED:
+            print("[%8u] degraded mode %s: upper levels %u.%u %%, change %u" %
+                  (timestamp, "entered" if level else "left", run // 10, run % 10, arrival))
+        elif kind == RECORD_WATCHDOG:
+            if level == WATCHDOG_STARVED:
+                print("[%8u] watchdog: %s got no CPU for %u ms, feeding stopped" %
+                      (timestamp, self.name(task_id), quantum))
+            else:
+                print("[%8u] watchdog: last reset was a watchdog reset" % timestamp)
+
+    def handle_population(self, payload):
+        (_, task_id, level, _, tasks) = struct.unpack(POPULATION_FORMAT, payload)
+        label = LEVEL_NAMES.get(level, str(level))
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,%u,,," % (RECORD_POPULATION, task_id, label, level, tasks))
+            return
+
+        if not self.population_open:
+            print("Level      | Tasks")
+            print("---------------------------------------------------")
+            self.population_open = True
+        print("%-10s | %5u" % (label, tasks))
+
+    def handle_cpu(self, payload):
+        (_, task_id, level, cpu_kind, permille, total_ms) = struct.unpack(CPU_FORMAT, payload)
+        if cpu_kind == 0:
+            label = self.name(task_id)
+        elif cpu_kind == 1:
+            label = LEVEL_NAMES.get(level, str(level))
+        elif cpu_kind == CPU_KIND_IRQ:
+            label = IRQ_NAMES.get(level, "IRQ %u" % level)
+        elif cpu_kind == CPU_KIND_CORE_IDLE:
+            label = "Core %u idle" % level
+        else:
+            label = CPU_KIND_NAMES.get(cpu_kind, str(cpu_kind))
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,%u,%u,," % (RECORD_CPU, task_id, label, level, permille, total_ms))
+            return
+
+        if not self.cpu_open:
+            print("CPU usage since the last report")
+            print("Consumer   | CPU %  | Total (s)")
+            print("---------------------------------------------------")
+            self.cpu_open = True
+        print("%-10s | %3u.%u  | %8u.%03u" % (label, permille // 10, permille % 10,
+                                              total_ms // 1000, total_ms % 1000))
+
+    def handle_switches(self, payload):
+        (_, task_id, level, _, switch_ins, voluntary,
+         involuntary) = struct.unpack(SWITCH_FORMAT, payload)
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,,%u,%u,%u" % (RECORD_SWITCHES, task_id, self.name(task_id),
+                                              level, switch_ins, voluntary, involuntary))
+            return
+
+        if not self.switch_open:
+            print("Context switches since registration")
+            print("Task       | Lvl | Switch-ins | Voluntary | Preempted")
+            print("---------------------------------------------------")
+            self.switch_open = True
+        print("%-10s | %3u | %10u | %9u | %9u" % (self.name(task_id), level, switch_ins,
+                                                 voluntary, involuntary))
+
+    def handle_fpu(self, payload):
+        (_, task_id, level, _, saves, fpu_saves,
+         fpu_kcycles) = struct.unpack(FPU_FORMAT, payload)
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,,%u,%u,%u" % (RECORD_FPU, task_id, self.name(task_id),
+                                              level, saves, fpu_saves, fpu_kcycles))
+            return
+
+        if not self.fpu_open:
+            print("FPU context saves since registration")
+            print("Task       | Lvl | Saves      | FPU %% | FPU kcyc")
+            print("---------------------------------------------------")
+            self.fpu_open = True
+        share = fpu_saves * 100 // saves if saves else 0
+        print("%-10s | %3u | %10u | %5u | %8u" % (self.name(task_id), level, saves,
+                                                 share, fpu_kcycles))
+
+    def handle_level_time(self, payload):
+        (_, task_id, level, levels, changes) = struct.unpack(LEVEL_TIME_FORMAT,
+                                                             payload[:LEVEL_TIME_SIZE])
+        level_ms = struct.unpack("<%dI" % levels, payload[LEVEL_TIME_SIZE:])
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,%u,%s" % (RECORD_LEVEL_TIME, task_id, self.name(task_id), level,
+                                           changes, ",".join("%u" % ms for ms in level_ms)))
+            return
+
+        # Times only grow, so a smaller one means the slot was reused
+        last_changes, last_ms = self.level_time_last.get(task_id, (0, (0,) * levels))
+        if any(now < before for now, before in zip(level_ms, last_ms)):
+            last_changes, last_ms = 0, (0,) * levels
+        self.level_time_last[task_id] = (changes, level_ms)
+
+        def shares(times):
+            total = sum(times)
+            return "".join(" %3u" % (t * 100 // total if total else 0) for t in times)
+
+        if not self.level_time_open:
+            print("Time in level (% by level, High first)")
+            print("Task       | Interval | Since registration | Changes")
+            print("---------------------------------------------------")
+            self.level_time_open = True
+        interval = [now - before for now, before in zip(level_ms, last_ms)]
+        print("%-10s |%s |%s | %u (+%u)" % (self.name(task_id), shares(interval),
+                                           shares(level_ms), changes,
+                                           (changes - last_changes) & 0xFFFFFFFF))
+
+    def handle_core(self, payload):
+        (_, core, tasks, high_tasks, busy_permille, steals,
+         migrations) = struct.unpack(CORE_FORMAT, payload)
+
+        if self.csv:
+            print("%d,,%u,core%u,,,%u,%u,%u,%u" % (RECORD_CORE, core, core, busy_permille,
+                                                  tasks, high_tasks, steals))
+            return
+
+        if not self.core_open:
+            print("Per-core runqueues (%u migrations)" % migrations)
+            print("Core | Busy % | Tasks | High | Steals")
+            print("---------------------------------------------------")
+            self.core_open = True
+        print("%4u | %4u.%u | %5u | %4u | %6u" % (core, busy_permille // 10, busy_permille % 10,
+                                                 tasks, high_tasks, steals))
+
+    def handle_self(self, payload):
+        fields = struct.unpack(SELF_FORMAT, payload)
+
+        if self.csv:
+            print("%d,,,,,,%s" % (RECORD_SELF, ",".join("%u" % v for v in fields[4:])))
+            return
+
+        # Printed as the footer of the queue table that follows
+        self.self_metrics = fields[4:]
+
+    def print_self_footer(self):
+        high_water, share, supervisor_ms = (self.self_metrics[6], self.self_metrics[8],
+                                            self.self_metrics[9])
+        last = self.self_last or (0,) * len(self.self_metrics)
+
+        def counter(label, index):
+            total = self.self_metrics[index]
+            return "%s %u (+%u)" % (label, total, (total - last[index]) & 0xFFFFFFFF)
+
+        print("Sched: %s | %s | %s | %s" % (counter("demote", 0), counter("promote", 1),
+                                            counter("boost", 2), counter("wakes", 7)))
+        print("Expiry: %s | %s | %s | queue max %u" % (counter("got", 3), counter("coalesced", 4),
+                                                        counter("dropped", 5), high_water))
+        print("Supervisor CPU: %u.%u %% of the interval, %u ms since boot" %
+              (share // 10, share % 10, supervisor_ms))
+        self.self_last = self.self_metrics
+        self.self_metrics = None
+
+    def handle_stack(self, payload):
+        (_, task_id, _, _, size, free, suggested) = struct.unpack(STACK_FORMAT,
+                                                                  payload[:STACK_SIZE])
+        label = payload[STACK_SIZE:].decode("ascii", "replace")
+
+        if self.csv:
+            print("%d,,%d,%s,,,,%u,%u,%u" % (RECORD_STACK, task_id, label, size, free, suggested))
+            return
+
+        if not self.stack_open:
+            print("Stack usage (words)")
+            print("Task       |  Size | Min free | Suggest")
+            print("---------------------------------------------------")
+            self.stack_open = True
+        print("%-10s | %5u | %8u | %7u" % (label, size, free, suggested))
+
+    def handle_heap(self, payload):
+        (_, task_id, _, _, free, min_free, largest, blocks,
+         allocations, frees, failures) = struct.unpack(HEAP_FORMAT, payload)
+
+        if self.csv:
+            print("%d,,%d,,,,%u,%u,%u,%u" % (RECORD_HEAP, task_id, free, min_free, largest, blocks))
+            return
+
+        print("Heap (bytes)")
+        print("  Free  | Min ever | Largest | Blocks")
+        print("---------------------------------------------------")
+        print("%7u | %8u | %7u | %6u" % (free, min_free, largest, blocks))
+        print("Allocs: %u | Frees: %u | Failed: %u" % (allocations, frees, failures))
+        print("===================================================")
+
+    def handle_latency(self, payload):
+        (_, task_id, level, _, samples, p50, p99, worst) = struct.unpack(LATENCY_FORMAT, payload)
+        label = LEVEL_NAMES.get(level, str(level)) if task_id == TASK_ID_NONE else self.name(task_id)
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,%u,%u,%u,%u" %
+                  (RECORD_LATENCY, task_id, label, level, samples, p50, p99, worst))
+            return
+
+        if not self.latency_open:
+            print("Wake-to-run latency (us)")
+            print("Level/Task | Samples |  p50   |  p99   |  Max")
+            print("---------------------------------------------------")
+            self.latency_open = True
+        print("%-10s | %7u | %6u | %6u | %6u" % (label, samples, p50, p99, worst))
+
+    def handle_inversion(self, payload):
+        (_, task_id, level, _, episodes, total, worst) = struct.unpack(INVERSION_FORMAT, payload)
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,,%u,%u,%u" %
+                  (RECORD_INVERSION, task_id, self.name(task_id), level, episodes, total, worst))
+            return
+
+        if not self.inversion_open:
+            print("Priority inversion (us)")
+            print("Task       | Episodes |  Total   |  Max")
+            print("---------------------------------------------------")
+            self.inversion_open = True
+        print("%-10s | %8u | %8u | %6u" % (self.name(task_id), episodes, total, worst))
+
+    def handle_wait(self, payload):
+        (_, task_id, direction, _, obj, waits, total,
+         worst) = struct.unpack(WAIT_FORMAT, payload)
+        label = "TX" if direction == 1 else "RX"
+
+        if self.csv:
+            # The run column carries the direction and object address
+            print("%d,,%d,%s,,,%s@0x%08x,%u,%u,%u" %
+                  (RECORD_WAIT, task_id, self.name(task_id), label, obj, waits, total, worst))
+            return
+
+        if not self.wait_open:
+            print("Blocking waits (us)")
+            print("Task       | Object     | Dir | Waits  |  Total   | Max")
+            print("---------------------------------------------------")
+            self.wait_open = True
+        print("%-10s | 0x%08x | %-3s | %6u | %8u | %u" % (self.name(task_id), obj, label,
+                                                        waits, total, worst))
+
+    def handle_state_time(self, payload):
+        (_, task_id, level, _, running, ready,
+         blocked) = struct.unpack(STATE_FORMAT, payload)
+
+        if self.csv:
+            print("%d,,%d,%s,%d,,,%u,%u,%u" % (RECORD_STATE_TIME, task_id, self.name(task_id),
+                                              level, running, ready, blocked))
+            return
+
+        if not self.state_open:
+            print("Task state time since registration (ms)")
+            print("Task       | Running  | Ready    | Blocked  | Ready %")
+            print("---------------------------------------------------")
+            self.state_open = True
+        share = ready * 100 // (running + ready) if running + ready else 0
+        print("%-10s | %8u | %8u | %8u | %6u%%" % (self.name(task_id), running, ready,
+                                                   blocked, share))
+
+    def handle_pc_samples(self, payload):
+        (_, task_id, shift, _, start, samples,
+         task_samples) = struct.unpack(PC_FORMAT, payload)
+        name = "Unmanaged" if task_id == TASK_ID_NONE else self.name(task_id)
+        share = samples * 100 // task_samples if task_samples else 0
+
+        if start == PC_OUTSIDE:
+            span = "outside range"
+            names = []
+        else:
+            end = start + (1 << shift) - 1
+            span = "0x%08x-0x%08x" % (start, end)
+            names = symbols_in(self.symbols, start, end)
+
+        if self.csv:
+            print("%d,,%d,%s,,,%s,%u,%u,%s" % (RECORD_PC_SAMPLES, task_id, name, span,
+                                             samples, task_samples, ";".join(names)))
+            return
+
+        if not self.pc_open:
+            print("PC samples since registration")
+            print("Task       | Address range         | Samples | Share")
+            print("---------------------------------------------------")
+            self.pc_open = True
+        print("%-10s | %-21s | %7u | %4u%%" % (name, span, samples, share))
+        if names:
+            shown = ", ".join(names[:4])
+            more = " (+%d more)" % (len(names) - 4) if len(names) > 4 else ""
+            print("           |   %s%s" % (shown, more))
+
+    def handle_timer(self, payload):
+        (_, _, pended, _, callback, runs, total_ms, max_us,
+         overruns) = struct.unpack(TIMER_FORMAT, payload)
+        kind = "Pend" if pended else "Timer"
+        if callback == 0:
+            label = "Others"
+        else:
+            # Function pointers carry the Thumb bit
+            names = symbols_in(self.symbols, callback & ~1, callback & ~1)
+            label = names[0] if names else "0x%08x" % callback
+
+        if self.csv:
+            print("%d,,,%s,,,%s,%u,%u,%u,%u" % (RECORD_TIMER, label, kind, runs,
+                                              total_ms, max_us, overruns))
+            return
+
+        if not self.timer_open:
+            print("Timer daemon callbacks since boot")
+            print("Callback             | Kind  | Runs   | Total ms | Max us | Over")
+            print("---------------------------------------------------")
+            self.timer_open = True
+        print("%-20s | %-5s | %6u | %8u | %6u | %u" % (label[:20], kind, runs, total_ms,
+                                                      max_us, overruns))
+
+    def print_report(self, delta, unchanged):
+        # A keyframe replaces the table; a delta report only updates the
+        # rows it carries, so tasks deleted since the keyframe stay listed
+        # until the next one
+        if not delta:
+            self.table = {}
+        for task_id, row in self.rows:
+            self.table[task_id] = row
+
+        # Same layout as the text-mode printQueueReport()
+        print("\n================ MLFQ QUEUE REPORT ================")
+        print("Name       | Lvl | Run  | Qtm | Arr   | Wait")
+        print("---------------------------------------------------")
+        for name, level, run, quantum, arrival, wait in self.table.values():
+            print("%-10s | Lvl: %d | Run: %2u | Qtm: %2u | Arr: %1u | Wait: %2u" %
+                  (name, level, run, quantum, arrival, wait))
+        if delta:
+            print("(%u sent, %u carried over)" % (len(self.rows), unchanged))
+        if self.self_metrics is not None:
+            self.print_self_footer()
+        print("===================================================")
+        self.rows = []
+        self.latency_open = False
+        self.inversion_open = False
+        self.wait_open = False
+        self.pc_open = False
+        self.timer_open = False
+        self.state_open = False
+        self.population_open = False
+        self.cpu_open = False
+        self.stack_open = False
+        self.switch_open = False
+        self.fpu_open = False
+        self.level_time_open = False
+        self.core_open = False
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("capture", nargs="?", help="raw capture file")
+    parser.add_argument("--port", help="serial port to read live")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--csv", action="store_true", help="emit CSV rows")
+    parser.add_argument("--map", help="CCS linker map, to name PC sample ranges and timer callbacks")
+    parser.add_argument("--watch", action="store_true",
+                        help="keep the reports of an on-demand board coming (needs --port)")
+    args = parser.parse_args()
+
+    if args.port:
+        import serial  # pyserial
+        stream = serial.Serial(args.port, args.baud, timeout=1)
+        # Ask for every task name now instead of waiting for the next resend
+        stream.write(b"names\r")
+        if args.watch:
+            stream = WatchedPort(stream)
+    elif args.capture:
+        stream = open(args.capture, "rb")
+    else:
+        stream = sys.stdin.buffer
+
+    decoder = Decoder(args.csv, load_map(args.map) if args.map else None)
+    try:
+        for payload in frames(stream, live=bool(args.port)):
+            decoder.handle(payload)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
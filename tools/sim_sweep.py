@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""
+MODULE NAME  : MLFQ Simulator Sweep
+FILE         : sim_sweep.py
+DESCRIPTION  : Runs the host simulator (sim/) over a grid of High quanta,
+               boost periods and workload mixes and writes one CSV row per
+               run, built from the SIM summary line of each run.
+AUTHOR       : Hassan Darwish
+Date         : October 2026
+
+Usage:
+    python3 sim_sweep.py --quanta 5,10,20,40 --boosts 1000,3000 \
+        --mixes 4,3,1 8,2,2 --csv sweep.csv
+"""
+
+import argparse
+import csv
+import itertools
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+
+def parse_summary(output):
+    """Returns the key=value pairs of the SIM line as a dict."""
+    for line in output.splitlines():
+        if line.startswith("SIM,"):
+            return dict(field.split("=", 1) for field in line.split(",")[1:])
+    raise ValueError("no SIM summary line in simulator output")
+
+
+def run_point(binary, duration_ms, seed, quantum, boost, mix):
+    command = [binary, "--duration-ms", str(duration_ms), "--seed", str(seed),
+               "--quantum", "0", str(quantum), "--boost", str(boost)]
+    if mix != "replay":
+        command += ["--mix", mix]
+    result = subprocess.run(command, capture_output=True, text=True, check=True)
+    row = parse_summary(result.stdout)
+    row["mix"] = mix
+    return row
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--sim", default="../sim/build/mlfq_sim",
+                        help="simulator binary")
+    parser.add_argument("--quanta", default="20",
+                        help="comma-separated High quanta in ticks")
+    parser.add_argument("--boosts", default="3000",
+                        help="comma-separated boost periods in ms")
+    parser.add_argument("--mixes", nargs="+", default=["4,3,1"],
+                        help="SENSORS,NETWORK,COMPRESSION task counts, or "
+                             "'replay' for a simulator built with REPLAY=")
+    parser.add_argument("--duration-ms", type=int, default=10000,
+                        help="simulated time per run")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--jobs", type=int, default=4,
+                        help="simulator processes run at once")
+    parser.add_argument("--csv", help="output file (default stdout)")
+    args = parser.parse_args()
+
+    quanta = [int(q) for q in args.quanta.split(",")]
+    boosts = [int(b) for b in args.boosts.split(",")]
+    grid = list(itertools.product(quanta, boosts, args.mixes))
+
+    # Each run is its own process, so the points are independent
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        rows = list(pool.map(lambda point: run_point(args.sim, args.duration_ms,
+                                                     args.seed, *point), grid))
+
+    fields = ["mix"] + [key for key in rows[0] if key != "mix"]
+    handle = open(args.csv, "w", newline="") if args.csv else sys.stdout
+    writer = csv.DictWriter(handle, fieldnames=fields)
+    writer.writeheader()
+    writer.writerows(rows)
+    if args.csv:
+        handle.close()
+
+
+if __name__ == "__main__":
+    main()
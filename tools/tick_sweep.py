@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""
+MODULE NAME  : Tick-Rate Sweep Summary
+FILE         : tick_sweep.py
+DESCRIPTION  : Compares the captures of the tick-rate benchmark
+               (TEST_TICK_BENCH_ENABLED in test/test_config.h), one
+               capture per MLFQ_TICK_RATE_HZ build. Averages the TickRate
+               rows of each rate and prints one line per rate, then the
+               rate with the lowest p99 response whose tick interrupt
+               stays within the overhead budget.
+AUTHOR       : Hassan Darwish
+Date         : October 2026
+
+Usage:
+    python3 tick_sweep.py tick100.log tick250.log tick500.log \
+        tick1000.log tick2000.log --budget-ppm 10000 --csv ticks.csv
+"""
+
+import argparse
+import csv
+import sys
+
+FIELDS = ["mode", "hz", "ticks", "tick_cycles", "tick_ppm", "switches",
+          "heavy_ops", "inter_ops", "p50_us", "p99_us"]
+
+
+def read_rows(path):
+    """Returns the TickRate rows of a capture as dicts of ints. Binary
+    records in the capture are skipped with the other lines."""
+    with open(path, "rb") as handle:
+        text = handle.read().decode("latin-1")
+    rows = []
+    for line in text.splitlines():
+        fields = [field.strip() for field in line.split(",")]
+        if fields[0] != "TickRate" or len(fields) != len(FIELDS) + 1:
+            continue
+        try:
+            rows.append(dict(zip(FIELDS, (int(value) for value in fields[1:]))))
+        except ValueError:
+            continue
+    return rows
+
+
+def mean_by_rate(rows):
+    """Averages every column over the windows of each tick rate."""
+    rates = {}
+    for row in rows:
+        rates.setdefault(row["hz"], []).append(row)
+    summary = []
+    for hz in sorted(rates):
+        windows = rates[hz]
+        mean = {key: sum(row[key] for row in windows) / len(windows) for key in FIELDS}
+        mean["hz"] = hz
+        mean["windows"] = len(windows)
+        summary.append(mean)
+    return summary
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("captures", nargs="+",
+                        help="captured UART output, one per tick rate")
+    parser.add_argument("--budget-ppm", type=int, default=10000,
+                        help="most CPU the tick interrupt may take, in ppm")
+    parser.add_argument("--csv", help="also write the means to this file")
+    args = parser.parse_args()
+
+    rows = [row for path in args.captures for row in read_rows(path)]
+    if not rows:
+        sys.exit("no TickRate rows in the captures")
+    summary = mean_by_rate(rows)
+
+    print(f"{'Hz':>6} {'Win':>4} {'Tick_cyc':>9} {'Tick_ppm':>9} {'Switch/s':>9} "
+          f"{'Heavy':>7} {'Inter':>7} {'P50_us':>8} {'P99_us':>8}")
+    for rate in summary:
+        print(f"{rate['hz']:>6} {rate['windows']:>4} {rate['tick_cycles']:>9.0f} "
+              f"{rate['tick_ppm']:>9.0f} {rate['switches']:>9.0f} "
+              f"{rate['heavy_ops']:>7.0f} {rate['inter_ops']:>7.0f} "
+              f"{rate['p50_us']:>8.0f} {rate['p99_us']:>8.0f}")
+
+    # Lowest p99 within the budget; the lower rate wins a tie
+    within = [rate for rate in summary if rate["tick_ppm"] <= args.budget_ppm]
+    if within:
+        best = min(within, key=lambda rate: (rate["p99_us"], rate["hz"]))
+        print(f"\nChoice: {best['hz']} Hz (p99 {best['p99_us']:.0f} us, "
+              f"tick {best['tick_ppm']:.0f} ppm of the CPU)")
+    else:
+        print(f"\nNo rate keeps the tick within {args.budget_ppm} ppm")
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as handle:
+            writer = csv.DictWriter(handle, fieldnames=["windows"] + FIELDS)
+            writer.writeheader()
+            writer.writerows(summary)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+"""
+MODULE NAME  : MLFQ Event Trace Decoder
+FILE         : trace_decode.py
+DESCRIPTION  : Host-side decoder for the text dump printed by
+               eventTraceDump(). Prints a timeline in microseconds plus a
+               per-task summary, or writes a Chrome trace (chrome://tracing
+               or Perfetto) with --chrome. With --replay it extracts each
+               task's burst/block sequence into a replay table for the
+               workload generator (workloads.h).
+AUTHOR       : Hassan Darwish
+Date         : October 2026
+
+Usage:
+    python3 trace_decode.py capture.txt
+    python3 trace_decode.py capture.txt --chrome trace.json
+    python3 trace_decode.py --port /dev/ttyACM0
+    python3 trace_decode.py capture.txt --replay ../test/replay_trace.h
+"""
+
+import argparse
+import json
+import sys
+
+# Event identifiers (keep in sync with event_trace.h)
+EVENT_NAMES = {
+    1: "QUANTUM_EXPIRY",
+    2: "DEMOTION",
+    3: "PROMOTION",
+    4: "BOOST_START",
+    5: "BOOST_END",
+    6: "SWITCH_IN",
+    7: "SWITCH_OUT",
+    8: "BLOCK",
+    9: "UNBLOCK",
+    10: "TIMER_OVERRUN",
+}
+
+BLOCK_REASONS = {0: "delay", 1: "queue rx", 2: "queue tx", 3: "notify", 4: "event group"}
+
+LEVEL_NAMES = {0: "High", 1: "Medium", 2: "Low"}
+
+# Tasks of the test harness itself, left out of replay tables
+REPLAY_EXCLUDE = "IDLE,Tmr Svc,Scheduler,Logger,Console,Monitor"
+
+
+class Dump:
+    def __init__(self):
+        self.cpu_hz = 16000000
+        self.overwritten = 0
+        self.names = {}
+        self.events = []
+
+
+def read_dumps(lines):
+    """Yields one Dump per #TRACE BEGIN/END block; other lines are ignored."""
+    dump = None
+    for line in lines:
+        fields = line.strip().split()
+        if not fields:
+            continue
+        if fields[:2] == ["#TRACE", "BEGIN"]:
+            dump = Dump()
+            dump.overwritten = int(fields[3])
+            dump.cpu_hz = int(fields[4])
+        elif dump is None:
+            continue
+        elif fields[:2] == ["#TRACE", "END"]:
+            yield dump
+            dump = None
+        elif fields[0] == "N" and len(fields) >= 4:
+            dump.names[int(fields[2], 16)] = fields[3]
+        elif fields[0] == "E" and len(fields) == 7:
+            dump.events.append((int(fields[1], 16), int(fields[2]),
+                                int(fields[3], 16), int(fields[4]),
+                                int(fields[5]), int(fields[6])))
+
+
+def unwrap(events):
+    """Turns 32-bit cycle stamps into a monotonic count."""
+    out = []
+    base = 0
+    previous = None
+    for stamp, *rest in events:
+        if previous is not None and stamp < previous:
+            base += 1 << 32
+        previous = stamp
+        out.append((base + stamp, *rest))
+    return out
+
+
+def task_label(dump, task):
+    if task == 0:
+        return "-"
+    return dump.names.get(task, "0x%08x" % task)
+
+
+def describe(event, arg0, arg1):
+    if event in (2, 3):
+        return "%s -> %s" % (LEVEL_NAMES.get(arg0, arg0), LEVEL_NAMES.get(arg1, arg1))
+    if event == 1:
+        return "at %s" % LEVEL_NAMES.get(arg0, arg0)
+    if event == 8:
+        return BLOCK_REASONS.get(arg0, str(arg0))
+    if event == 10:
+        return "callback %d, %d ms" % (arg0, arg1)
+    return ""
+
+
+def print_timeline(dump):
+    events = unwrap(dump.events)
+    if not events:
+        print("empty trace")
+        return
+    start = events[0][0]
+    scale = 1e6 / dump.cpu_hz
+
+    print("# %d events, %d older events overwritten, %d Hz"
+          % (len(events), dump.overwritten, dump.cpu_hz))
+    for stamp, event, task, slot, arg0, arg1 in events:
+        print("%12.1f us  %-14s %-12s %s" %
+              ((stamp - start) * scale, EVENT_NAMES.get(event, event),
+               task_label(dump, task), describe(event, arg0, arg1)))
+
+    # Per-task CPU time and worst unblock-to-run latency
+    running = {}
+    ready = {}
+    cpu = {}
+    latency = {}
+    for stamp, event, task, slot, arg0, arg1 in events:
+        if event == 9:
+            ready.setdefault(task, stamp)
+        elif event == 6:
+            running[task] = stamp
+            if task in ready:
+                wait = stamp - ready.pop(task)
+                latency[task] = max(latency.get(task, 0), wait)
+        elif event == 7 and task in running:
+            cpu[task] = cpu.get(task, 0) + stamp - running.pop(task)
+
+    print("\n%-12s %12s %16s" % ("Task", "CPU (us)", "Max ready->run"))
+    for task in sorted(set(cpu) | set(latency)):
+        print("%-12s %12.1f %16.1f" % (task_label(dump, task),
+                                       cpu.get(task, 0) * scale,
+                                       latency.get(task, 0) * scale))
+
+
+def write_chrome(dump, path):
+    """Writes running intervals as complete events and the rest as instants."""
+    events = unwrap(dump.events)
+    if not events:
+        return
+    start = events[0][0]
+    scale = 1e6 / dump.cpu_hz
+    trace = []
+    running = {}
+    for stamp, event, task, slot, arg0, arg1 in events:
+        ts = (stamp - start) * scale
+        label = task_label(dump, task)
+        if event == 6:
+            running[task] = ts
+        elif event == 7 and task in running:
+            begin = running.pop(task)
+            trace.append({"name": label, "ph": "X", "ts": begin, "dur": ts - begin,
+                          "pid": 0, "tid": label})
+        else:
+            trace.append({"name": EVENT_NAMES.get(event, str(event)), "ph": "i",
+                          "ts": ts, "pid": 0, "tid": label, "s": "t",
+                          "args": {"detail": describe(event, arg0, arg1)}})
+    with open(path, "w") as handle:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ns"}, handle)
+
+
+def extract_steps(dump, steps):
+    """Appends each named task's (burst_us, block_us) steps to steps.
+
+    A burst is the CPU time a task used from waking up to blocking; the
+    block is the time from its switch-out to the next unblock. The first
+    burst of every task is cut by the start of the trace and is dropped.
+    A task that never blocks gets one step of all its CPU time and no
+    block, which replays as a CPU hog that only yields."""
+    scale = 1e6 / dump.cpu_hz
+    state = {}
+    for stamp, event, task, slot, arg0, arg1 in unwrap(dump.events):
+        if task not in dump.names:
+            continue
+        entry = state.setdefault(task, {"running": None, "cpu": 0, "blocking": False,
+                                        "started": False, "pending": None,
+                                        "blocked_at": None, "steps": []})
+        if event == 6:
+            entry["running"] = stamp
+        elif event == 7:
+            if entry["running"] is not None:
+                entry["cpu"] += stamp - entry["running"]
+                entry["running"] = None
+            if entry["blocking"]:
+                entry["pending"] = entry["cpu"] if entry["started"] else None
+                entry["started"] = True
+                entry["blocked_at"] = stamp
+                entry["blocking"] = False
+                entry["cpu"] = 0
+        elif event == 8:
+            entry["blocking"] = True
+        elif event == 9 and entry["blocked_at"] is not None:
+            if entry["pending"] is not None:
+                entry["steps"].append((round(entry["pending"] * scale),
+                                       round((stamp - entry["blocked_at"]) * scale)))
+            entry["pending"] = None
+            entry["blocked_at"] = None
+
+    for task, entry in state.items():
+        name = dump.names[task]
+        if not entry["steps"] and not entry["started"] and entry["cpu"] > 0:
+            entry["steps"].append((round(entry["cpu"] * scale), 0))
+        steps.setdefault(name, []).extend(entry["steps"])
+
+
+def write_replay(steps, path, source, exclude):
+    """Writes the steps as a C header of WorkloadReplay_t tables."""
+    tasks = [(name, sequence) for name, sequence in sorted(steps.items())
+             if sequence and name not in exclude]
+    with open(path, "w") as handle:
+        handle.write("/* Generated by tools/trace_decode.py --replay from %s.\n"
+                     " * Do not edit; capture and generate again instead. */\n\n"
+                     % source)
+        handle.write("#ifndef REPLAY_TRACE_H_\n#define REPLAY_TRACE_H_\n\n")
+        handle.write("#include \"workloads.h\"\n\n")
+        for index, (name, sequence) in enumerate(tasks):
+            handle.write("static const WorkloadStep_t g_replaySteps%d[] =\n{\n" % index)
+            for burst, block in sequence:
+                handle.write("    { %dU, %dU },\n" % (burst, block))
+            handle.write("};\n\n")
+        handle.write("static const WorkloadReplay_t g_replayTrace[] =\n{\n")
+        for index, (name, sequence) in enumerate(tasks):
+            handle.write("    { \"%s\", %dU, g_replaySteps%d },\n"
+                         % (name.replace("\\", "").replace("\"", ""), len(sequence), index))
+        handle.write("};\n\n")
+        handle.write("#define REPLAY_TRACE_TASKS  %dU\n\n" % len(tasks))
+        handle.write("#endif /* REPLAY_TRACE_H_ */\n")
+    return len(tasks)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("capture", nargs="?", help="captured UART text")
+    parser.add_argument("--port", help="serial port to read live")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--chrome", help="write a Chrome trace JSON file")
+    parser.add_argument("--replay", help="write a replay table header (C)")
+    parser.add_argument("--exclude", default=REPLAY_EXCLUDE,
+                        help="comma-separated task names left out of --replay")
+    args = parser.parse_args()
+
+    if args.port:
+        import serial  # pyserial
+        port = serial.Serial(args.port, args.baud)
+        lines = (raw.decode("ascii", "replace") for raw in iter(port.readline, b""))
+    elif args.capture:
+        lines = open(args.capture, "r", errors="replace")
+    else:
+        lines = sys.stdin
+
+    # Several dumps in one capture are joined per task name
+    steps = {}
+    for dump in read_dumps(lines):
+        print_timeline(dump)
+        if args.chrome:
+            write_chrome(dump, args.chrome)
+        if args.replay:
+            extract_steps(dump, steps)
+
+    if args.replay:
+        count = write_replay(steps, args.replay, args.capture or args.port or "stdin",
+                             set(args.exclude.split(",")))
+        print("\n%d tasks written to %s" % (count, args.replay))
+
+
+if __name__ == "__main__":
+    main()